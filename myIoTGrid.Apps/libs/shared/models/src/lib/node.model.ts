@@ -332,6 +332,9 @@ export interface NodeHardwareStatus {
   detectedDevices: DetectedDevice[];
   storage: StorageStatus;
   busStatus: BusStatus;
+  timing?: TimingReport;
+  stalls?: StallReport;
+  memory?: MemoryReport;
 }
 
 /**
@@ -387,6 +390,93 @@ export interface BusStatus {
   gpsDetected: boolean;
 }
 
+/**
+ * Firmware hot-path timing (per-stage latency histograms)
+ */
+export interface TimingReport {
+  windowMs: number;
+  stages: TimingStage[];
+  counters: Record<string, number>;
+}
+
+/**
+ * One timed stage; buckets are log2: [0] below 1 us, [i] 2^(i-1) to 2^i us
+ */
+export interface TimingStage {
+  name: string;
+  count: number;
+  totalUs: number;
+  maxUs: number;
+  p50Us: number;
+  p90Us: number;
+  p99Us: number;
+  buckets: number[];
+}
+
+/**
+ * Firmware loop stalls (main loop iterations over the threshold)
+ */
+export interface StallReport {
+  thresholdMs: number;
+  stallCount: number;
+  worst: LoopStall[];
+}
+
+/**
+ * One loop stall; stage lists the active stages, outermost first
+ */
+export interface LoopStall {
+  durationMs: number;
+  startMs: number;
+  stage: string;
+  backtrace: string[];
+}
+
+/**
+ * Firmware memory telemetry from the latest heartbeat
+ */
+export interface MemoryReport {
+  uptimeMs: number;
+  capabilities: HeapCapability[];
+  trend: HeapTrend;
+  failedAllocs: number;
+  lastFailedBytes: number;
+  lastFailedCaps: number;
+  tags?: MemoryTag[];
+}
+
+/**
+ * One heap capability ("8bit", "internal", "dma", "spiram"); fragmentation in %
+ */
+export interface HeapCapability {
+  name: string;
+  total: number;
+  free: number;
+  largestFree: number;
+  minFree: number;
+  fragmentation: number;
+}
+
+/**
+ * Internal heap trend, oldest sample first
+ */
+export interface HeapTrend {
+  intervalMs: number;
+  free: number[];
+  largestFree: number[];
+  minFree: number[];
+}
+
+/**
+ * Heap kept by a tagged allocation site (debug firmware builds)
+ */
+export interface MemoryTag {
+  name: string;
+  calls: number;
+  netBytes: number;
+  maxBytes: number;
+}
+
 // === Reading Date Range (for Expeditions) ===
 
 /**
@@ -42,6 +42,10 @@ export interface SensorCapability {
   matterClusterName?: string;
   sortOrder: number;
   isActive: boolean;
+  // ADC inputs (ADS1115)
+  adcChannel?: number;
+  adcGain?: number;
+  adcDataRate?: number;
 }
 
 /**
@@ -142,6 +146,9 @@ export interface CreateSensorCapabilityDto {
   matterClusterId?: number;
   matterClusterName?: string;
   sortOrder?: number;
+  adcChannel?: number;
+  adcGain?: number;
+  adcDataRate?: number;
 }
 
 /**
@@ -207,6 +214,9 @@ export interface UpdateSensorCapabilityDto {
   matterClusterName?: string;
   sortOrder?: number;
   isActive?: boolean;
+  adcChannel?: number;
+  adcGain?: number;
+  adcDataRate?: number;
 }
 
 /**
@@ -16,45 +16,121 @@ import struct
 from bleak import BleakScanner
 from datetime import datetime
 
-# myIoTGrid beacon constants (must match ESP32 config)
+# myIoTGrid beacon constants (must match ESP32 ble_beacon_mode.h)
 MYIOTGRID_COMPANY_ID = 0xFFFF
 MYIOTGRID_DEVICE_TYPE = 0x01
+BEACON_PROTOCOL_VERSION = 0x02
+FRAME_KEY, FRAME_DELTA, FRAME_GPS = 1, 2, 3
+
+# Channel type ids (must match ESP32 ble_sensor_payload.cpp): id -> (type, unit, decimals)
+CHANNEL_TYPES = {
+    1: ('temperature', '°C', 2), 2: ('humidity', '%', 2), 3: ('pressure', 'hPa', 2),
+    4: ('light', 'lux', 1), 5: ('co2', 'ppm', 0), 6: ('uv', 'UVI', 2),
+    7: ('water_level', 'cm', 1), 8: ('distance', 'cm', 1), 9: ('voltage', 'V', 3),
+    10: ('battery', '%', 0), 11: ('soil_moisture', '%', 1), 12: ('gas_resistance', 'kOhm', 2),
+}
+
+# Per-device key cycle state: node_hash -> {'key_cycle', 'values', 'seen'}
+device_state = {}
+
+
+def read_channels(data: bytes, offset: int) -> list:
+    """Read u8 typeId + zigzag varint pairs until the end of the frame."""
+    channels = []
+    while offset < len(data):
+        type_id = data[offset]
+        offset += 1
+        zigzag, shift = 0, 0
+        while True:
+            b = data[offset]
+            offset += 1
+            zigzag |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                break
+        channels.append((type_id, (zigzag >> 1) ^ -(zigzag & 1)))
+    return channels
+
 
 def parse_sensor_data(manufacturer_data: bytes) -> dict:
-    """Parse sensor data from manufacturer data bytes."""
-    if len(manufacturer_data) < 15:
+    """Parse one rotating beacon frame from manufacturer data bytes."""
+    if len(manufacturer_data) < 9:
         return None
 
     try:
-        # Unpack the BeaconSensorData structure
-        # Format: <HBB4shhHHB (little-endian)
-        # companyId(2) + deviceType(1) + version(1) + nodeIdHash(4) +
-        # temperature(2) + humidity(2) + pressure(2) + battery(2) + flags(1)
+        # Header: companyId(2) + deviceType(1) + version(1) + nodeIdHash(4) + frame(1)
+        # frame = type << 4 | cycle
         company_id, device_type, version = struct.unpack_from('<HBB', manufacturer_data, 0)
 
-        if company_id != MYIOTGRID_COMPANY_ID or device_type != MYIOTGRID_DEVICE_TYPE:
+        if (company_id != MYIOTGRID_COMPANY_ID or device_type != MYIOTGRID_DEVICE_TYPE
+                or version != BEACON_PROTOCOL_VERSION):
             return None
 
-        node_hash = manufacturer_data[4:8].hex().upper()
-        temp_raw, humidity_raw, pressure_raw, battery, flags = struct.unpack_from('<hhHHB', manufacturer_data, 8)
-
-        return {
+        frame = {
             'version': version,
-            'node_hash': node_hash,
-            'temperature': temp_raw / 100.0,
-            'humidity': humidity_raw / 100.0,
-            'pressure': (pressure_raw + 50000) / 100.0,  # Convert back to hPa
-            'battery_mv': battery,
-            'battery_pct': min(100, max(0, (battery - 3000) / 12)),  # Rough estimate
-            'has_gps': bool(flags & 0x01),
-            'low_battery': bool(flags & 0x02),
-            'error': bool(flags & 0x04),
+            'node_hash': manufacturer_data[4:8].hex().upper(),
+            'type': manufacturer_data[8] >> 4,
+            'cycle': manufacturer_data[8] & 0x0F,
         }
-    except Exception as e:
+
+        if frame['type'] == FRAME_KEY:
+            flags, battery = struct.unpack_from('<BH', manufacturer_data, 9)
+            frame.update({
+                'battery_mv': battery,
+                'battery_pct': min(100, max(0, (battery - 3000) / 12)),  # Rough estimate
+                'low_battery': bool(flags & 0x02),
+                'error': bool(flags & 0x04),
+                'channels': read_channels(manufacturer_data, 12),
+            })
+        elif frame['type'] == FRAME_DELTA:
+            flags, key_cycle = struct.unpack_from('<BB', manufacturer_data, 9)
+            frame.update({
+                'key_cycle': key_cycle & 0x0F,
+                'low_battery': bool(flags & 0x02),
+                'error': bool(flags & 0x04),
+                'channels': read_channels(manufacturer_data, 11),
+            })
+        elif frame['type'] == FRAME_GPS:
+            lat, lon, alt, sats = struct.unpack_from('<iihB', manufacturer_data, 9)
+            frame['gps'] = (lat / 1e7, lon / 1e7, alt, sats)
+        else:
+            return None
+        return frame
+    except (struct.error, IndexError) as e:
         print(f"Parse error: {e}")
         return None
 
 
+def resolve_readings(frame: dict) -> list:
+    """Resolve deltas against the key cycle; report each channel once per cycle."""
+    if frame['type'] == FRAME_GPS:
+        return []
+    state = device_state.setdefault(frame['node_hash'], {'key_cycle': -1, 'values': {}, 'seen': set()})
+
+    if frame['type'] == FRAME_KEY and frame['cycle'] != state['key_cycle']:
+        state['key_cycle'] = frame['cycle']
+        state['values'] = {}
+    if frame['type'] == FRAME_DELTA and frame['key_cycle'] != state['key_cycle']:
+        return []  # Key frame of this cycle not received yet
+
+    if state.get('cycle') != frame['cycle']:
+        state['cycle'] = frame['cycle']
+        state['seen'] = set()
+
+    readings = []
+    for type_id, value in frame.get('channels', []):
+        if frame['type'] == FRAME_KEY:
+            state['values'][type_id] = value
+        else:
+            value += state['values'].get(type_id, 0)
+        if type_id in state['seen'] or type_id not in CHANNEL_TYPES:
+            continue
+        state['seen'].add(type_id)
+        name, unit, decimals = CHANNEL_TYPES[type_id]
+        readings.append((name, value / 10 ** decimals, unit))
+    return readings
+
+
 def detection_callback(device, advertisement_data):
     """Called for each detected BLE device."""
     name = device.name or ""
@@ -71,21 +147,29 @@ def detection_callback(device, advertisement_data):
     for company_id, data in advertisement_data.manufacturer_data.items():
         # Reconstruct full data with company ID prefix
         full_data = struct.pack('<H', company_id) + bytes(data)
-        sensor_data = parse_sensor_data(full_data)
-
-        if sensor_data:
-            timestamp = datetime.now().strftime("%H:%M:%S")
-            print(f"\n[{timestamp}] {name} ({device.address})")
-            print(f"  Temperature: {sensor_data['temperature']:.2f} °C")
-            print(f"  Humidity:    {sensor_data['humidity']:.1f} %")
-            print(f"  Pressure:    {sensor_data['pressure']:.1f} hPa")
-            print(f"  Battery:     {sensor_data['battery_mv']} mV ({sensor_data['battery_pct']:.0f}%)")
-            print(f"  Node Hash:   {sensor_data['node_hash']}")
-            if sensor_data['low_battery']:
-                print(f"  ⚠️  LOW BATTERY!")
-            if sensor_data['error']:
-                print(f"  ❌ SENSOR ERROR!")
-            print(f"  RSSI:        {advertisement_data.rssi} dBm")
+        frame = parse_sensor_data(full_data)
+        if not frame:
+            continue
+
+        readings = resolve_readings(frame)
+        if not readings and 'gps' not in frame:
+            continue
+
+        timestamp = datetime.now().strftime("%H:%M:%S")
+        print(f"\n[{timestamp}] {name} ({device.address}) frame {frame['type']} cycle {frame['cycle']}")
+        for reading_type, value, unit in readings:
+            print(f"  {reading_type + ':':<16} {value:g} {unit}")
+        if 'gps' in frame:
+            lat, lon, alt, sats = frame['gps']
+            print(f"  GPS:             {lat:.6f}, {lon:.6f} ({alt} m, {sats} sats)")
+        if 'battery_mv' in frame:
+            print(f"  Battery:         {frame['battery_mv']} mV ({frame['battery_pct']:.0f}%)")
+        print(f"  Node Hash:       {frame['node_hash']}")
+        if frame.get('low_battery'):
+            print(f"  ⚠️  LOW BATTERY!")
+        if frame.get('error'):
+            print(f"  ❌ SENSOR ERROR!")
+        print(f"  RSSI:            {advertisement_data.rssi} dBm")
 
 
 async def main():
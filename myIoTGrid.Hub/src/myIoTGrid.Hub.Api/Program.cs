@@ -134,6 +134,7 @@ try
     builder.Services.AddScoped<IBluetoothHubService, BluetoothHubService>();
     builder.Services.AddScoped<IBluetoothPairingService, BluetoothPairingService>();
     builder.Services.AddSingleton<IBleGattClientService, BleGattClientService>();
+    builder.Services.AddSingleton<INodeChangeNotifier, NodeChangeNotifier>();
 
     // Memory Cache for Sensors
     builder.Services.AddMemoryCache();
@@ -0,0 +1,48 @@
+﻿using Microsoft.EntityFrameworkCore.Migrations;
+
+#nullable disable
+
+namespace myIoTGrid.Hub.Infrastructure.Migrations
+{
+    /// <inheritdoc />
+    public partial class AddSensorCapabilityAdcSettings : Migration
+    {
+        /// <inheritdoc />
+        protected override void Up(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.AddColumn<int>(
+                name: "AdcChannel",
+                table: "SensorCapabilities",
+                type: "INTEGER",
+                nullable: true);
+
+            migrationBuilder.AddColumn<int>(
+                name: "AdcDataRate",
+                table: "SensorCapabilities",
+                type: "INTEGER",
+                nullable: true);
+
+            migrationBuilder.AddColumn<double>(
+                name: "AdcGain",
+                table: "SensorCapabilities",
+                type: "REAL",
+                nullable: true);
+        }
+
+        /// <inheritdoc />
+        protected override void Down(MigrationBuilder migrationBuilder)
+        {
+            migrationBuilder.DropColumn(
+                name: "AdcChannel",
+                table: "SensorCapabilities");
+
+            migrationBuilder.DropColumn(
+                name: "AdcDataRate",
+                table: "SensorCapabilities");
+
+            migrationBuilder.DropColumn(
+                name: "AdcGain",
+                table: "SensorCapabilities");
+        }
+    }
+}
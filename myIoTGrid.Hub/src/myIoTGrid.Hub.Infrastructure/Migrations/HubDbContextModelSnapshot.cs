@@ -816,6 +816,15 @@ namespace myIoTGrid.Hub.Infrastructure.Migrations
                         .HasColumnType("REAL")
                         .HasDefaultValue(0.5);
 
+                    b.Property<int?>("AdcChannel")
+                        .HasColumnType("INTEGER");
+
+                    b.Property<int?>("AdcDataRate")
+                        .HasColumnType("INTEGER");
+
+                    b.Property<double?>("AdcGain")
+                        .HasColumnType("REAL");
+
                     b.Property<string>("DisplayName")
                         .IsRequired()
                         .HasMaxLength(100)
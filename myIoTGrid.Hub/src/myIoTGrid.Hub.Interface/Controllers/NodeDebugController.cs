@@ -1,6 +1,8 @@
 using Microsoft.AspNetCore.Mvc;
 using Microsoft.Extensions.Logging;
 using Microsoft.AspNetCore.SignalR;
+using System.Collections.Concurrent;
+using myIoTGrid.Hub.Service.Helpers;
 
 namespace myIoTGrid.Hub.Interface.Controllers;
 
@@ -19,6 +21,11 @@ public class NodeDebugController : ControllerBase
     private readonly INodeHardwareStatusService _hardwareStatusService;
     private readonly ILogger<NodeDebugController> _logger;
 
+    /// <summary>
+    /// Last received serial chunk per node (sequence + node timestamp) for gap/duplicate detection.
+    /// </summary>
+    private static readonly ConcurrentDictionary<string, (uint Sequence, uint NodeTimestamp)> LastSerialChunks = new();
+
     public NodeDebugController(
         INodeDebugLogService debugLogService,
         INodeHardwareStatusService hardwareStatusService,
@@ -339,4 +346,68 @@ public class NodeDebugController : ControllerBase
 
         return Ok(new { Received = count });
     }
+
+    /// <summary>
+    /// Receives a binary (optionally LZ4-compressed) serial output chunk from firmware.
+    /// Sequence numbers let the Hub detect lost chunks; a resent chunk is acknowledged but not stored twice.
+    /// </summary>
+    /// <param name="serialNumber">Node serial number</param>
+    /// <param name="ct">Cancellation Token</param>
+    /// <returns>Number of lines received</returns>
+    [HttpPost("by-serial/{serialNumber}/serial-chunk")]
+    [Consumes("application/octet-stream")]
+    [ProducesResponseType(typeof(object), StatusCodes.Status200OK)]
+    [ProducesResponseType(StatusCodes.Status400BadRequest)]
+    public async Task<IActionResult> ReceiveSerialChunk(string serialNumber, CancellationToken ct)
+    {
+        using var body = new MemoryStream();
+        await Request.Body.CopyToAsync(body, ct);
+
+        if (!SerialLogChunkDecoder.TryDecode(body.GetBuffer().AsSpan(0, (int)body.Length), out var chunk) || chunk == null)
+        {
+            return BadRequest(new { Message = "Invalid serial chunk" });
+        }
+
+        var logs = new List<CreateNodeDebugLogDto>(chunk.Lines.Count + 1);
+        if (LastSerialChunks.TryGetValue(serialNumber, out var last))
+        {
+            if (last.Sequence == chunk.Sequence && last.NodeTimestamp == chunk.NodeTimestamp)
+            {
+                return Ok(new { Received = 0, Duplicate = true });
+            }
+
+            // A lower sequence means the node restarted
+            if (chunk.Sequence > last.Sequence + 1)
+            {
+                var missing = chunk.Sequence - last.Sequence - 1;
+                _logger.LogWarning("Serial output from {SerialNumber}: {Missing} chunk(s) lost before #{Sequence}",
+                    serialNumber, missing, chunk.Sequence);
+                logs.Add(new CreateNodeDebugLogDto
+                {
+                    NodeTimestamp = chunk.NodeTimestamp,
+                    Level = DebugLevelDto.Normal,
+                    Category = LogCategoryDto.System,
+                    Message = $"[RemoteSerial] {missing} chunk(s) lost"
+                });
+            }
+        }
+        LastSerialChunks[serialNumber] = (chunk.Sequence, chunk.NodeTimestamp);
+
+        logs.AddRange(chunk.Lines.Select(line => new CreateNodeDebugLogDto
+        {
+            NodeTimestamp = chunk.NodeTimestamp,
+            Level = DebugLevelDto.Debug,
+            Category = LogCategoryDto.System,
+            Message = line
+        }));
+
+        var count = logs.Count > 0
+            ? await _debugLogService.CreateBatchAsync(serialNumber, logs, ct)
+            : 0;
+
+        _logger.LogDebug("Received serial chunk #{Sequence} ({Count} lines) from {SerialNumber}",
+            chunk.Sequence, chunk.Lines.Count, serialNumber);
+
+        return Ok(new { Received = count });
+    }
 }
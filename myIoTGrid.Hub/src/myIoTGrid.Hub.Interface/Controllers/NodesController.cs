@@ -3,6 +3,7 @@ using Microsoft.AspNetCore.SignalR;
 using Microsoft.Extensions.Configuration;
 using Microsoft.Extensions.Logging;
 using myIoTGrid.Hub.Interface.Hubs;
+using myIoTGrid.Hub.Service.Helpers;
 
 namespace myIoTGrid.Hub.Interface.Controllers;
 
@@ -21,10 +22,16 @@ public class NodesController : ControllerBase
     private readonly ISensorService _sensorService;
     private readonly IReadingService _readingService;
     private readonly INodeDebugLogService _debugLogService;
+    private readonly INodeChangeNotifier _changeNotifier;
     private readonly IHubContext<SensorHub> _hubContext;
     private readonly IConfiguration _configuration;
     private readonly ILogger<NodesController> _logger;
 
+    /// <summary>
+    /// Upper bound for the long-poll wait of the control endpoint.
+    /// </summary>
+    private const int MaxControlWaitSeconds = 60;
+
     public NodesController(
         INodeService nodeService,
         IHubService hubService,
@@ -32,6 +39,7 @@ public class NodesController : ControllerBase
         ISensorService sensorService,
         IReadingService readingService,
         INodeDebugLogService debugLogService,
+        INodeChangeNotifier changeNotifier,
         IHubContext<SensorHub> hubContext,
         IConfiguration configuration,
         ILogger<NodesController> logger)
@@ -42,6 +50,7 @@ public class NodesController : ControllerBase
         _sensorService = sensorService;
         _readingService = readingService;
         _debugLogService = debugLogService;
+        _changeNotifier = changeNotifier;
         _hubContext = hubContext;
         _configuration = configuration;
         _logger = logger;
@@ -455,7 +464,7 @@ public class NodesController : ControllerBase
     /// </summary>
     /// <param name="dto">Heartbeat data</param>
     /// <param name="ct">Cancellation Token</param>
-    /// <returns>Heartbeat response with server time</returns>
+    /// <returns>Heartbeat response with server time, configuration version and debug settings</returns>
     [HttpPost("heartbeat")]
     [ProducesResponseType(typeof(NodeHeartbeatResponseDto), StatusCodes.Status200OK)]
     [ProducesResponseType(typeof(ProblemDetails), StatusCodes.Status401Unauthorized)]
@@ -486,6 +495,18 @@ public class NodesController : ControllerBase
         }
 
         var response = await _nodeService.ProcessHeartbeatAsync(dto, ct);
+        if (response.Success)
+        {
+            // Control-plane sync: the node fetches configuration only when the version changed
+            var state = await BuildControlStateAsync(node, ct);
+            response = response with
+            {
+                UnixTimestamp = new DateTimeOffset(response.ServerTime, TimeSpan.Zero).ToUnixTimeSeconds(),
+                ConfigurationVersion = state.ConfigurationVersion,
+                DebugLevel = state.DebugLevel,
+                EnableRemoteLogging = state.EnableRemoteLogging
+            };
+        }
 
         // Notify clients about node heartbeat
         await _hubContext.Clients.Group($"node:{node.Id}")
@@ -581,12 +602,14 @@ public class NodesController : ControllerBase
     /// <summary>
     /// Gets the full sensor configuration for a node.
     /// Called by sensor devices to retrieve their assigned sensors and pin configurations.
+    /// Sensors poll with If-None-Match; an unchanged configuration returns 304 without a body.
     /// </summary>
     /// <param name="serialNumber">Serial number / NodeId of the sensor device</param>
     /// <param name="ct">Cancellation Token</param>
     /// <returns>Full sensor configuration for the node</returns>
     [HttpGet("{serialNumber}/configuration")]
     [ProducesResponseType(typeof(NodeSensorConfigurationDto), StatusCodes.Status200OK)]
+    [ProducesResponseType(StatusCodes.Status304NotModified)]
     [ProducesResponseType(StatusCodes.Status404NotFound)]
     public async Task<IActionResult> GetConfiguration(string serialNumber, CancellationToken ct)
     {
@@ -601,6 +624,87 @@ public class NodesController : ControllerBase
                 Detail = $"No node found with serial number '{serialNumber}'"
             });
 
+        var configuration = await BuildSensorConfigurationAsync(node, ct);
+
+        // ETag covers the content only; the timestamp is set per response
+        var etag = ContentETag.Compute(configuration);
+        Response.Headers.ETag = etag;
+        if (ContentETag.Matches(Request.Headers.IfNoneMatch, etag))
+            return StatusCode(StatusCodes.Status304NotModified);
+
+        return Ok(configuration with { ConfigurationTimestamp = DateTime.UtcNow });
+    }
+
+    /// <summary>
+    /// Long-poll control channel for a node (configuration version and debug settings).
+    /// With If-None-Match matching the current state the request is held up to
+    /// <paramref name="wait"/> seconds and answered as soon as the state changes;
+    /// 304 means nothing changed within the wait.
+    /// </summary>
+    /// <param name="serialNumber">Serial number / NodeId of the sensor device</param>
+    /// <param name="wait">Maximum seconds to hold the request (0 = answer immediately)</param>
+    /// <param name="ct">Cancellation Token</param>
+    /// <returns>Current control state of the node</returns>
+    [HttpGet("{serialNumber}/control")]
+    [ProducesResponseType(typeof(NodeControlStateDto), StatusCodes.Status200OK)]
+    [ProducesResponseType(StatusCodes.Status304NotModified)]
+    [ProducesResponseType(StatusCodes.Status404NotFound)]
+    public async Task<IActionResult> GetControlState(string serialNumber, [FromQuery] int wait, CancellationToken ct)
+    {
+        var nodes = await _nodeService.GetAllAsync(ct);
+        var node = nodes.FirstOrDefault(n => n.NodeId == serialNumber);
+
+        if (node == null)
+            return NotFound(new ProblemDetails
+            {
+                Title = "Node Not Found",
+                Detail = $"No node found with serial number '{serialNumber}'"
+            });
+
+        // Taken before reading the state so a change in between is not missed
+        var changed = _changeNotifier.WhenChanged(node.Id);
+        var state = await BuildControlStateAsync(node, ct);
+        var etag = ContentETag.Compute(state);
+
+        if (wait > 0 && ContentETag.Matches(Request.Headers.IfNoneMatch, etag))
+        {
+            var timeout = TimeSpan.FromSeconds(Math.Min(wait, MaxControlWaitSeconds));
+            await Task.WhenAny(changed, Task.Delay(timeout, ct));
+            if (ct.IsCancellationRequested)
+                return StatusCode(StatusCodes.Status304NotModified);
+
+            // Also picks up changes that were not signalled (e.g. sensor definition edits)
+            state = await BuildControlStateAsync(node, ct);
+            etag = ContentETag.Compute(state);
+        }
+
+        Response.Headers.ETag = etag;
+        if (ContentETag.Matches(Request.Headers.IfNoneMatch, etag))
+            return StatusCode(StatusCodes.Status304NotModified);
+
+        return Ok(state);
+    }
+
+    /// <summary>
+    /// Builds the control state of a node: configuration version and debug settings.
+    /// </summary>
+    private async Task<NodeControlStateDto> BuildControlStateAsync(NodeDto node, CancellationToken ct)
+    {
+        var configuration = await BuildSensorConfigurationAsync(node, ct);
+        var debugConfig = await _debugLogService.GetDebugConfigurationAsync(node.Id, ct);
+        return new NodeControlStateDto(
+            ConfigurationVersion: ContentETag.Compute(configuration),
+            DebugLevel: debugConfig?.DebugLevel ?? DebugLevelDto.Normal,
+            EnableRemoteLogging: debugConfig?.EnableRemoteLogging ?? false
+        );
+    }
+
+    /// <summary>
+    /// Builds the sensor configuration of a node (active assignments with capabilities).
+    /// ConfigurationTimestamp is left at default so the result can be hashed into an ETag.
+    /// </summary>
+    private async Task<NodeSensorConfigurationDto> BuildSensorConfigurationAsync(NodeDto node, CancellationToken ct)
+    {
         // Get sensor assignments for this node
         var assignments = await _assignmentService.GetByNodeAsync(node.Id, ct);
 
@@ -616,7 +720,10 @@ public class NodesController : ControllerBase
                 .Select(c => new SensorCapabilityConfigDto(
                     MeasurementType: c.MeasurementType,
                     DisplayName: c.DisplayName,
-                    Unit: c.Unit
+                    Unit: c.Unit,
+                    AdcChannel: c.AdcChannel,
+                    AdcGain: c.AdcGain,
+                    AdcDataRate: c.AdcDataRate
                 ))
                 .ToList() ?? new List<SensorCapabilityConfigDto>();
 
@@ -642,17 +749,15 @@ public class NodesController : ControllerBase
             ));
         }
 
-        var configuration = new NodeSensorConfigurationDto(
+        return new NodeSensorConfigurationDto(
             NodeId: node.Id,
             SerialNumber: node.NodeId,
             Name: node.Name,
             IsSimulation: node.IsSimulation,
             DefaultIntervalSeconds: 60,
             Sensors: sensorConfigs,
-            ConfigurationTimestamp: DateTime.UtcNow
+            ConfigurationTimestamp: default
         );
-
-        return Ok(configuration);
     }
 
     // === Debug Configuration (Sprint 8) ===
@@ -679,12 +784,14 @@ public class NodesController : ControllerBase
 
     /// <summary>
     /// Gets debug configuration for a node.
+    /// Sensors poll with If-None-Match; unchanged settings return 304 without a body.
     /// </summary>
     /// <param name="id">Node ID</param>
     /// <param name="ct">Cancellation Token</param>
     /// <returns>Debug configuration</returns>
     [HttpGet("{id:guid}/debug")]
     [ProducesResponseType(typeof(NodeDebugConfigurationDto), StatusCodes.Status200OK)]
+    [ProducesResponseType(StatusCodes.Status304NotModified)]
     [ProducesResponseType(StatusCodes.Status404NotFound)]
     public async Task<IActionResult> GetDebugConfiguration(Guid id, CancellationToken ct)
     {
@@ -693,6 +800,12 @@ public class NodesController : ControllerBase
         {
             return NotFound(new { Message = $"Node {id} not found" });
         }
+
+        var etag = ContentETag.Compute(config);
+        Response.Headers.ETag = etag;
+        if (ContentETag.Matches(Request.Headers.IfNoneMatch, etag))
+            return StatusCode(StatusCodes.Status304NotModified);
+
         return Ok(config);
     }
 
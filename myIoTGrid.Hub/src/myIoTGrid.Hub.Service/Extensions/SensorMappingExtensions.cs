@@ -89,7 +89,10 @@ public static class SensorMappingExtensions
             MatterClusterId: capability.MatterClusterId,
             MatterClusterName: capability.MatterClusterName,
             SortOrder: capability.SortOrder,
-            IsActive: capability.IsActive
+            IsActive: capability.IsActive,
+            AdcChannel: capability.AdcChannel,
+            AdcGain: capability.AdcGain,
+            AdcDataRate: capability.AdcDataRate
         );
     }
 
@@ -171,7 +174,10 @@ public static class SensorMappingExtensions
                     MatterClusterId = cap.MatterClusterId,
                     MatterClusterName = cap.MatterClusterName,
                     SortOrder = cap.SortOrder != 0 ? cap.SortOrder : sortOrder++,
-                    IsActive = true
+                    IsActive = true,
+                    AdcChannel = cap.AdcChannel,
+                    AdcGain = cap.AdcGain,
+                    AdcDataRate = cap.AdcDataRate
                 });
             }
         }
@@ -317,7 +323,10 @@ public static class SensorMappingExtensions
                     MatterClusterId = capDto.MatterClusterId,
                     MatterClusterName = capDto.MatterClusterName,
                     SortOrder = capDto.SortOrder ?? sortOrder++,
-                    IsActive = capDto.IsActive ?? true
+                    IsActive = capDto.IsActive ?? true,
+                    AdcChannel = capDto.AdcChannel,
+                    AdcGain = capDto.AdcGain,
+                    AdcDataRate = capDto.AdcDataRate
                 };
                 sensor.Capabilities.Add(newCapability);
             }
@@ -365,6 +374,15 @@ public static class SensorMappingExtensions
 
         if (dto.IsActive.HasValue)
             capability.IsActive = dto.IsActive.Value;
+
+        if (dto.AdcChannel.HasValue)
+            capability.AdcChannel = dto.AdcChannel;
+
+        if (dto.AdcGain.HasValue)
+            capability.AdcGain = dto.AdcGain;
+
+        if (dto.AdcDataRate.HasValue)
+            capability.AdcDataRate = dto.AdcDataRate;
     }
 
     /// <summary>
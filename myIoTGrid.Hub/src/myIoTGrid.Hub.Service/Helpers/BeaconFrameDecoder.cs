@@ -0,0 +1,258 @@
+using System.Buffers.Binary;
+
+namespace myIoTGrid.Hub.Service.Helpers;
+
+/// <summary>
+/// One channel value from a beacon frame (scaled integer, absolute or delta).
+/// </summary>
+public readonly record struct BeaconChannel(byte TypeId, int Value);
+
+/// <summary>
+/// GPS position from a beacon GPS frame.
+/// </summary>
+public sealed record BeaconGpsFix(double Latitude, double Longitude, int Altitude, int Satellites);
+
+/// <summary>
+/// Parsed beacon manufacturer data frame.
+/// </summary>
+public sealed record BeaconFrame(
+    byte FrameType,
+    int Cycle,
+    uint NodeIdHash,
+    byte Flags,
+    ushort? BatteryMv,
+    int? KeyCycle,
+    IReadOnlyList<BeaconChannel> Channels,
+    BeaconGpsFix? Gps
+);
+
+/// <summary>
+/// Decodes the rotating beacon frames broadcast by the firmware (ble_beacon_mode.h).
+/// Input is the manufacturer data without the company ID:
+/// u8 deviceType | u8 version | u8 nodeIdHash[4] | u8 frame (type &lt;&lt; 4 | cycle) | body.
+/// KEY: u8 flags | u16 battery mV | channels; DELTA: u8 flags | u8 key cycle | channels;
+/// channels are u8 typeId + zigzag varint. GPS: i32 lat*1e7 | i32 lon*1e7 | i16 alt m | u8 sats.
+/// </summary>
+public static class BeaconFrameDecoder
+{
+    public const byte DeviceType = 0x01;
+    public const byte Version = 0x02;
+    public const byte FrameKey = 0x1;
+    public const byte FrameDelta = 0x2;
+    public const byte FrameGps = 0x3;
+    public const int HeaderSize = 7;
+
+    /// <summary>
+    /// Parses a frame. Returns false for other devices, other versions or malformed data.
+    /// </summary>
+    public static bool TryParse(ReadOnlySpan<byte> data, out BeaconFrame? frame)
+    {
+        frame = null;
+        if (data.Length < HeaderSize || data[0] != DeviceType || data[1] != Version)
+            return false;
+
+        var nodeIdHash = BinaryPrimitives.ReadUInt32BigEndian(data[2..]);
+        var frameType = (byte)(data[6] >> 4);
+        var cycle = data[6] & 0x0F;
+        var body = data[HeaderSize..];
+
+        switch (frameType)
+        {
+            case FrameKey when body.Length >= 3:
+                if (!TryReadChannels(body[3..], out var keyChannels))
+                    return false;
+                frame = new BeaconFrame(frameType, cycle, nodeIdHash, body[0],
+                    BinaryPrimitives.ReadUInt16LittleEndian(body[1..]), null, keyChannels, null);
+                return true;
+
+            case FrameDelta when body.Length >= 2:
+                if (!TryReadChannels(body[2..], out var deltaChannels))
+                    return false;
+                frame = new BeaconFrame(frameType, cycle, nodeIdHash, body[0],
+                    null, body[1] & 0x0F, deltaChannels, null);
+                return true;
+
+            case FrameGps when body.Length >= 11:
+                var gps = new BeaconGpsFix(
+                    BinaryPrimitives.ReadInt32LittleEndian(body) / 1e7,
+                    BinaryPrimitives.ReadInt32LittleEndian(body[4..]) / 1e7,
+                    BinaryPrimitives.ReadInt16LittleEndian(body[8..]),
+                    body[10]);
+                frame = new BeaconFrame(frameType, cycle, nodeIdHash, 0, null, null,
+                    Array.Empty<BeaconChannel>(), gps);
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    private static bool TryReadChannels(ReadOnlySpan<byte> data, out IReadOnlyList<BeaconChannel> channels)
+    {
+        var result = new List<BeaconChannel>();
+        channels = result;
+        var position = 0;
+
+        while (position < data.Length)
+        {
+            var typeId = data[position++];
+            uint zigzag = 0;
+            var shift = 0;
+            byte b;
+            do
+            {
+                if (position >= data.Length || shift > 28)
+                    return false;
+                b = data[position++];
+                zigzag |= (uint)(b & 0x7F) << shift;
+                shift += 7;
+            } while ((b & 0x80) != 0);
+
+            result.Add(new BeaconChannel(typeId, (int)(zigzag >> 1) ^ -(int)(zigzag & 1)));
+        }
+
+        return true;
+    }
+}
+
+/// <summary>
+/// Per-device beacon state: resolves delta frames against the last key cycle and
+/// reports each channel (and the GPS fix) once per cycle, since frames are
+/// re-broadcast while rotating.
+/// Channels omitted from a delta cycle are unchanged and are not reported again.
+/// Cycle numbers are 4 bits and wrap after 16 cycles, so state is only matched
+/// while it is younger than 16 cycle periods; the period is measured from
+/// consecutive cycles.
+/// </summary>
+public sealed class BeaconChannelTracker
+{
+    private const int CycleModulo = 16;
+
+    /// <summary>
+    /// Shortest cycle period assumed (the firmware publishes at most once per second).
+    /// Also used until a period has been measured.
+    /// </summary>
+    public static readonly TimeSpan MinCyclePeriod = TimeSpan.FromSeconds(1);
+
+    private readonly Dictionary<byte, int> _keyValues = new();
+    private readonly HashSet<byte> _reported = new();
+    private int _keyCycle = -1;
+    private DateTime _keySeenAt;
+    private int _cycle = -1;
+    private DateTime _cycleSeenAt;
+    private int _gpsCycle = -1;
+    private DateTime _gpsSeenAt;
+
+    // Cycle period measurement
+    private int _lastCycle = -1;
+    private DateTime _lastCycleStart;
+    private TimeSpan _cyclePeriod = MinCyclePeriod;
+    private bool _periodMeasured;
+
+    /// <summary>
+    /// Measured time between two cycles (MinCyclePeriod until measured).
+    /// </summary>
+    public TimeSpan CyclePeriod => _cyclePeriod;
+
+    /// <summary>
+    /// Applies a frame and returns the readings not reported yet in its cycle.
+    /// Delta frames are ignored until their key cycle has been seen.
+    /// </summary>
+    public IReadOnlyList<BleSensorReadingValue> Apply(BeaconFrame frame,
+        IReadOnlyDictionary<byte, BleSensorSchemaEntry> schema, DateTime receivedAt)
+    {
+        var readings = new List<BleSensorReadingValue>();
+        TrackCyclePeriod(frame.Cycle, receivedAt);
+
+        if (frame.Gps != null)
+        {
+            if (!IsCurrent(_gpsCycle, _gpsSeenAt, frame.Cycle, receivedAt))
+            {
+                _gpsCycle = frame.Cycle;
+                readings.Add(new BleSensorReadingValue("latitude", frame.Gps.Latitude, "°"));
+                readings.Add(new BleSensorReadingValue("longitude", frame.Gps.Longitude, "°"));
+                readings.Add(new BleSensorReadingValue("altitude", frame.Gps.Altitude, "m"));
+            }
+            _gpsSeenAt = receivedAt;
+            return readings;
+        }
+
+        if (frame.FrameType == BeaconFrameDecoder.FrameKey)
+        {
+            if (!IsCurrent(_keyCycle, _keySeenAt, frame.Cycle, receivedAt))
+            {
+                _keyValues.Clear();
+                _keyCycle = frame.Cycle;
+            }
+            _keySeenAt = receivedAt;
+            foreach (var channel in frame.Channels)
+                _keyValues[channel.TypeId] = channel.Value;
+        }
+        else if (frame.FrameType != BeaconFrameDecoder.FrameDelta ||
+                 !IsCurrent(_keyCycle, _keySeenAt, frame.KeyCycle ?? -1, receivedAt))
+        {
+            return readings;
+        }
+
+        if (!IsCurrent(_cycle, _cycleSeenAt, frame.Cycle, receivedAt))
+        {
+            _reported.Clear();
+            _cycle = frame.Cycle;
+        }
+        _cycleSeenAt = receivedAt;
+
+        foreach (var channel in frame.Channels)
+        {
+            if (!_reported.Add(channel.TypeId) || !schema.TryGetValue(channel.TypeId, out var entry))
+                continue;
+
+            var value = frame.FrameType == BeaconFrameDecoder.FrameKey
+                ? channel.Value
+                : _keyValues.GetValueOrDefault(channel.TypeId) + channel.Value;
+            readings.Add(new BleSensorReadingValue(entry.Type, value / Math.Pow(10, entry.Decimals), entry.Unit));
+        }
+
+        return readings;
+    }
+
+    /// <summary>
+    /// True if the state of a cycle matches the frame's cycle and cannot stem from an earlier wrap.
+    /// </summary>
+    private bool IsCurrent(int stateCycle, DateTime seenAt, int frameCycle, DateTime receivedAt)
+    {
+        return stateCycle == frameCycle && receivedAt - seenAt < _cyclePeriod * CycleModulo;
+    }
+
+    /// <summary>
+    /// Measures the cycle period from the first frames of consecutive cycles.
+    /// Until two consecutive cycles have been seen, a gap over several cycles
+    /// gives an upper bound.
+    /// </summary>
+    private void TrackCyclePeriod(int cycle, DateTime receivedAt)
+    {
+        if (cycle == _lastCycle)
+            return;
+
+        if (_lastCycle >= 0)
+        {
+            var cycles = (cycle - _lastCycle + CycleModulo) % CycleModulo;
+            var estimate = (receivedAt - _lastCycleStart) / cycles;
+            if (estimate < MinCyclePeriod)
+                estimate = MinCyclePeriod;
+
+            if (cycles == 1 || !_periodMeasured)
+            {
+                _cyclePeriod = estimate;
+                _periodMeasured = cycles == 1;
+            }
+        }
+
+        _lastCycle = cycle;
+        _lastCycleStart = receivedAt;
+    }
+}
+
+/// <summary>
+/// Decoded reading value (type, unscaled value, unit).
+/// </summary>
+public sealed record BleSensorReadingValue(string Type, double Value, string Unit);
@@ -0,0 +1,86 @@
+using System.Buffers.Binary;
+
+namespace myIoTGrid.Hub.Service.Helpers;
+
+/// <summary>
+/// One stored sample from a history batch (scaled value, node uptime seconds).
+/// </summary>
+public readonly record struct BleHistorySample(uint Sequence, byte TypeId, uint Seconds, int Value);
+
+/// <summary>
+/// Parsed history batch notification.
+/// </summary>
+public sealed record BleHistoryBatch(
+    uint FirstSequence,
+    uint NowSeconds,
+    bool Last,
+    IReadOnlyList<BleHistorySample> Samples
+)
+{
+    /// <summary>
+    /// Cursor for the next READ request.
+    /// </summary>
+    public uint NextSequence => FirstSequence + (uint)Samples.Count;
+}
+
+/// <summary>
+/// Store-and-forward history protocol of the beacon firmware (ble_history.h).
+/// Request (write without response): u8 opcode | u32 cursor | u8 window.
+/// Batch: u8 version | u8 flags (bit 0 = last) | u32 first sequence | u32 node seconds now |
+/// n x (u8 typeId | u32 node seconds | i32 scaled value).
+/// </summary>
+public static class BleHistoryDecoder
+{
+    public const byte Version = 1;
+    public const byte OpRead = 0x01;
+    public const byte OpStop = 0x02;
+    public const byte BatchLast = 0x01;
+    public const int HeaderSize = 10;
+    public const int SampleSize = 9;
+
+    /// <summary>
+    /// Builds a READ request for up to <paramref name="window"/> batches starting at <paramref name="cursor"/>.
+    /// </summary>
+    public static byte[] BuildReadRequest(uint cursor, byte window)
+    {
+        var request = new byte[6];
+        request[0] = OpRead;
+        BinaryPrimitives.WriteUInt32LittleEndian(request.AsSpan(1), cursor);
+        request[5] = window;
+        return request;
+    }
+
+    /// <summary>
+    /// Parses a batch notification. Returns false for other versions or malformed data.
+    /// </summary>
+    public static bool TryParseBatch(ReadOnlySpan<byte> data, out BleHistoryBatch? batch)
+    {
+        batch = null;
+        if (data.Length < HeaderSize || data[0] != Version || (data.Length - HeaderSize) % SampleSize != 0)
+            return false;
+
+        var firstSequence = BinaryPrimitives.ReadUInt32LittleEndian(data[2..]);
+        var samples = new List<BleHistorySample>((data.Length - HeaderSize) / SampleSize);
+        for (var position = HeaderSize; position < data.Length; position += SampleSize)
+        {
+            samples.Add(new BleHistorySample(
+                firstSequence + (uint)samples.Count,
+                data[position],
+                BinaryPrimitives.ReadUInt32LittleEndian(data[(position + 1)..]),
+                BinaryPrimitives.ReadInt32LittleEndian(data[(position + 5)..])));
+        }
+
+        batch = new BleHistoryBatch(
+            firstSequence,
+            BinaryPrimitives.ReadUInt32LittleEndian(data[6..]),
+            (data[1] & BatchLast) != 0,
+            samples);
+        return true;
+    }
+
+    /// <summary>
+    /// Converts a sample's node uptime to wall-clock time using the batch's "now".
+    /// </summary>
+    public static DateTimeOffset ToTimestamp(BleHistorySample sample, uint nowSeconds, DateTimeOffset receivedAt)
+        => receivedAt.AddSeconds(-(double)(nowSeconds - sample.Seconds));
+}
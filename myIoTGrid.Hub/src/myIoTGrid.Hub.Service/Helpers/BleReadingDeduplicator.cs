@@ -0,0 +1,129 @@
+namespace myIoTGrid.Hub.Service.Helpers;
+
+/// <summary>
+/// Keeps a beacon's readings from being stored twice.
+/// Every reading a beacon publishes is advertised live and also pushed into its
+/// history ring, so the history pull returns copies of readings already stored
+/// from advertisements (and a later advertisement may repeat a pulled sample).
+/// A history sample and a live reading are the same reading when the sample is
+/// the newest of its type up to the live receive time and has the same value;
+/// for a live reading this only holds once a pull started after it.
+/// </summary>
+public sealed class BleReadingDeduplicator
+{
+    /// <summary>
+    /// Tolerated offset between live and history timestamps (node seconds are truncated).
+    /// </summary>
+    public static readonly TimeSpan Slack = TimeSpan.FromSeconds(2);
+
+    /// <summary>
+    /// Stored readings older than this are forgotten (the ring holds about 5 h).
+    /// </summary>
+    public static readonly TimeSpan MaxAge = TimeSpan.FromHours(6);
+
+    private sealed class NodeLog
+    {
+        public readonly List<CreateSensorReadingDto> Live = new();
+        public readonly List<CreateSensorReadingDto> History = new();
+        public long PulledAt;       // Start of the last pull (Unix ms)
+    }
+
+    private readonly Dictionary<string, NodeLog> _nodes = new();
+
+    /// <summary>
+    /// Records a live reading before it is stored.
+    /// Returns false if it was already stored from the history.
+    /// </summary>
+    public bool TryAddLive(CreateSensorReadingDto reading)
+    {
+        lock (_nodes)
+        {
+            var log = GetLog(reading.DeviceId);
+            var sample = log.PulledAt >= Timestamp(reading)
+                ? NewestAtOrBefore(log.History, reading.Type, Timestamp(reading) + (long)Slack.TotalMilliseconds)
+                : -1;
+            if (sample >= 0 && SameValue(log.History[sample], reading))
+            {
+                log.History.RemoveAt(sample);
+                return false;
+            }
+
+            log.Live.Add(reading);
+            Prune(log, Timestamp(reading));
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Returns the pulled history readings of a node that were not stored live,
+    /// and records them as stored.
+    /// </summary>
+    /// <param name="pullStartedAt">Start of the pull: samples published before it are complete</param>
+    public List<CreateSensorReadingDto> FilterHistory(string nodeId, IReadOnlyList<CreateSensorReadingDto> history,
+        DateTimeOffset pullStartedAt)
+    {
+        lock (_nodes)
+        {
+            var log = GetLog(nodeId);
+            log.PulledAt = Math.Max(log.PulledAt, pullStartedAt.ToUnixTimeMilliseconds());
+            var skip = new bool[history.Count];
+
+            for (var i = log.Live.Count - 1; i >= 0; i--)
+            {
+                var live = log.Live[i];
+                var sample = NewestAtOrBefore(history, live.Type, Timestamp(live) + (long)Slack.TotalMilliseconds);
+                if (sample < 0 || skip[sample] || !SameValue(history[sample], live))
+                    continue;
+
+                skip[sample] = true;
+                log.Live.RemoveAt(i);
+            }
+
+            var kept = new List<CreateSensorReadingDto>(history.Count);
+            for (var i = 0; i < history.Count; i++)
+            {
+                if (!skip[i])
+                    kept.Add(history[i]);
+            }
+
+            log.History.AddRange(kept);
+            if (kept.Count > 0)
+                Prune(log, kept.Max(Timestamp));
+            return kept;
+        }
+    }
+
+    private NodeLog GetLog(string nodeId)
+    {
+        if (!_nodes.TryGetValue(nodeId, out var log))
+        {
+            log = new NodeLog();
+            _nodes[nodeId] = log;
+        }
+        return log;
+    }
+
+    private static int NewestAtOrBefore(IReadOnlyList<CreateSensorReadingDto> readings, string type, long timestamp)
+    {
+        var newest = -1;
+        for (var i = 0; i < readings.Count; i++)
+        {
+            var ts = Timestamp(readings[i]);
+            if (readings[i].Type == type && ts <= timestamp && (newest < 0 || ts > Timestamp(readings[newest])))
+                newest = i;
+        }
+        return newest;
+    }
+
+    private static bool SameValue(CreateSensorReadingDto a, CreateSensorReadingDto b)
+        => Math.Abs(a.Value - b.Value) < 1e-9;
+
+    private static long Timestamp(CreateSensorReadingDto reading) => reading.Timestamp ?? 0;
+
+    private static void Prune(NodeLog log, long now)
+    {
+        var oldest = now - (long)MaxAge.TotalMilliseconds;
+        log.Live.RemoveAll(r => Timestamp(r) < oldest);
+        log.History.RemoveAll(r => Timestamp(r) < oldest);
+    }
+}
@@ -0,0 +1,211 @@
+using System.Buffers.Binary;
+using System.Text;
+using myIoTGrid.Hub.Service.Services;
+
+namespace myIoTGrid.Hub.Service.Helpers;
+
+/// <summary>
+/// Schema entry from the BLE schema characteristic: type id -> type, unit and decimal scale.
+/// </summary>
+public sealed record BleSensorSchemaEntry(string Type, string Unit, int Decimals);
+
+/// <summary>
+/// Decodes the binary BLE GATT sensor payload sent by the firmware (ble_sensor_payload.h).
+/// Message = TLV records (u8 tag | u8 length | value, little-endian):
+/// 0x01 timestamp (u32 node millis), 0x02 reading (u8 typeId | i16/i32 scaled value),
+/// 0x03 named reading (u8 decimals | i32 | u8 typeLength | type | unit),
+/// 0x04 GPS (i32 lat*1e7 | i32 lon*1e7 | i32 alt cm | u16 speed*100 | u16 course*100 | u8 sats).
+/// Unknown tags are skipped.
+/// </summary>
+public static class BleSensorPayloadDecoder
+{
+    public const byte Version = 1;
+    public const byte TagTimestamp = 0x01;
+    public const byte TagReading = 0x02;
+    public const byte TagNamed = 0x03;
+    public const byte TagGps = 0x04;
+
+    /// <summary>
+    /// Type table compiled into the firmware (ble_sensor_payload.cpp). Beacon frames use the
+    /// same ids but are received without a connection, so the schema cannot be read.
+    /// </summary>
+    public static readonly IReadOnlyDictionary<byte, BleSensorSchemaEntry> DefaultSchema =
+        new Dictionary<byte, BleSensorSchemaEntry>
+        {
+            [1] = new("temperature", "°C", 2),
+            [2] = new("humidity", "%", 2),
+            [3] = new("pressure", "hPa", 2),
+            [4] = new("light", "lux", 1),
+            [5] = new("co2", "ppm", 0),
+            [6] = new("uv", "UVI", 2),
+            [7] = new("water_level", "cm", 1),
+            [8] = new("distance", "cm", 1),
+            [9] = new("voltage", "V", 3),
+            [10] = new("battery", "%", 0),
+            [11] = new("soil_moisture", "%", 1),
+            [12] = new("gas_resistance", "kOhm", 2)
+        };
+
+    /// <summary>
+    /// Parses the schema characteristic: u8 version | u8 count |
+    /// count x (u8 typeId | u8 decimals | u8 typeLength | type | u8 unitLength | unit).
+    /// </summary>
+    public static bool TryParseSchema(ReadOnlySpan<byte> data,
+        out IReadOnlyDictionary<byte, BleSensorSchemaEntry>? schema)
+    {
+        schema = null;
+        if (data.Length < 2 || data[0] != Version)
+            return false;
+
+        var entries = new Dictionary<byte, BleSensorSchemaEntry>();
+        var position = 2;
+        for (var i = 0; i < data[1]; i++)
+        {
+            if (position + 3 > data.Length)
+                return false;
+            var typeId = data[position];
+            var decimals = data[position + 1];
+            var typeLength = data[position + 2];
+            position += 3;
+            if (position + typeLength + 1 > data.Length)
+                return false;
+            var type = Encoding.UTF8.GetString(data.Slice(position, typeLength));
+            position += typeLength;
+            var unitLength = data[position++];
+            if (position + unitLength > data.Length)
+                return false;
+            var unit = Encoding.UTF8.GetString(data.Slice(position, unitLength));
+            position += unitLength;
+            entries[typeId] = new BleSensorSchemaEntry(type, unit, decimals);
+        }
+
+        schema = entries;
+        return true;
+    }
+
+    /// <summary>
+    /// Decodes a reassembled message. Readings with a type id missing from the schema are skipped.
+    /// NodeId is left empty; it comes from the device info characteristic.
+    /// </summary>
+    public static bool TryDecode(ReadOnlySpan<byte> message,
+        IReadOnlyDictionary<byte, BleSensorSchemaEntry> schema, out BleSensorDataPayload? payload)
+    {
+        payload = null;
+        var result = new BleSensorDataPayload();
+        var position = 0;
+
+        while (position < message.Length)
+        {
+            if (position + 2 > message.Length)
+                return false;
+            var tag = message[position];
+            var length = message[position + 1];
+            position += 2;
+            if (position + length > message.Length)
+                return false;
+            var value = message.Slice(position, length);
+            position += length;
+
+            switch (tag)
+            {
+                case TagTimestamp when length == 4:
+                    result.Timestamp = BinaryPrimitives.ReadUInt32LittleEndian(value);
+                    break;
+                case TagReading when length is 3 or 5:
+                    var scaled = length == 3
+                        ? BinaryPrimitives.ReadInt16LittleEndian(value[1..])
+                        : BinaryPrimitives.ReadInt32LittleEndian(value[1..]);
+                    if (schema.TryGetValue(value[0], out var entry))
+                    {
+                        result.Sensors.Add(new BleSensorReading
+                        {
+                            Type = entry.Type,
+                            Value = Unscale(scaled, entry.Decimals),
+                            Unit = entry.Unit
+                        });
+                    }
+                    break;
+                case TagNamed when length >= 6 && 6 + value[5] <= length:
+                    var typeLength = value[5];
+                    result.Sensors.Add(new BleSensorReading
+                    {
+                        Type = Encoding.UTF8.GetString(value.Slice(6, typeLength)),
+                        Value = Unscale(BinaryPrimitives.ReadInt32LittleEndian(value[1..]), value[0]),
+                        Unit = Encoding.UTF8.GetString(value[(6 + typeLength)..])
+                    });
+                    break;
+                case TagGps when length == 17:
+                    result.Gps = new BleSensorGps
+                    {
+                        Latitude = BinaryPrimitives.ReadInt32LittleEndian(value) / 1e7,
+                        Longitude = BinaryPrimitives.ReadInt32LittleEndian(value[4..]) / 1e7,
+                        Altitude = BinaryPrimitives.ReadInt32LittleEndian(value[8..]) / 100.0,
+                        Speed = BinaryPrimitives.ReadUInt16LittleEndian(value[12..]) / 100f,
+                        Satellites = value[16]
+                    };
+                    break;
+                case TagTimestamp or TagReading or TagNamed or TagGps:
+                    return false;
+                default:
+                    // Newer record type - skipped by length
+                    break;
+            }
+        }
+
+        payload = result;
+        return true;
+    }
+
+    private static double Unscale(int scaled, int decimals) => scaled / Math.Pow(10, decimals);
+}
+
+/// <summary>
+/// Reassembles notification fragments: u8 version | u8 message sequence |
+/// u8 fragment index (bit 7 = last) | chunk. A missing fragment drops the whole message.
+/// </summary>
+public sealed class BleFragmentAssembler
+{
+    public const int HeaderSize = 3;
+    public const byte FragmentLast = 0x80;
+
+    private readonly List<byte> _buffer = new();
+    private int _sequence = -1;
+    private int _nextIndex;
+
+    /// <summary>
+    /// Adds a fragment. Returns true with the message once the last fragment arrives.
+    /// </summary>
+    public bool TryAdd(ReadOnlySpan<byte> fragment, out byte[]? message)
+    {
+        message = null;
+        if (fragment.Length < HeaderSize || fragment[0] != BleSensorPayloadDecoder.Version)
+            return false;
+
+        var sequence = fragment[1];
+        var index = fragment[2] & ~FragmentLast;
+
+        if (index == 0)
+        {
+            _buffer.Clear();
+            _sequence = sequence;
+            _nextIndex = 0;
+        }
+
+        if (sequence != _sequence || index != _nextIndex)
+        {
+            _sequence = -1;
+            return false;
+        }
+
+        _buffer.AddRange(fragment[HeaderSize..].ToArray());
+        _nextIndex++;
+
+        if ((fragment[2] & FragmentLast) == 0)
+            return false;
+
+        message = _buffer.ToArray();
+        _buffer.Clear();
+        _sequence = -1;
+        return true;
+    }
+}
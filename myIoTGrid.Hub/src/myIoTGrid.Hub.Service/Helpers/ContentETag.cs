@@ -0,0 +1,43 @@
+using System.Security.Cryptography;
+using System.Text.Json;
+
+namespace myIoTGrid.Hub.Service.Helpers;
+
+/// <summary>
+/// Content-based ETags for polled node endpoints (configuration, debug settings).
+/// Sensors send the last ETag as If-None-Match and get 304 without a body while nothing changed.
+/// </summary>
+public static class ContentETag
+{
+    /// <summary>
+    /// Computes a strong ETag from the JSON serialization of a value.
+    /// Fields that change on every request (e.g. generation timestamps) must be reset by the caller.
+    /// </summary>
+    public static string Compute<T>(T value)
+    {
+        var json = JsonSerializer.SerializeToUtf8Bytes(value);
+        var hash = SHA256.HashData(json);
+        return $"\"{Convert.ToHexString(hash, 0, 8).ToLowerInvariant()}\"";
+    }
+
+    /// <summary>
+    /// Checks an If-None-Match header value (single tag, list or "*") against an ETag.
+    /// Weak tags compare by their opaque value.
+    /// </summary>
+    public static bool Matches(string? ifNoneMatch, string etag)
+    {
+        if (string.IsNullOrWhiteSpace(ifNoneMatch))
+            return false;
+
+        foreach (var candidate in ifNoneMatch.Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries))
+        {
+            if (candidate == "*")
+                return true;
+            var tag = candidate.StartsWith("W/", StringComparison.Ordinal) ? candidate[2..] : candidate;
+            if (tag == etag)
+                return true;
+        }
+
+        return false;
+    }
+}
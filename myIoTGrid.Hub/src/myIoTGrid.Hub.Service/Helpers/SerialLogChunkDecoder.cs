@@ -0,0 +1,146 @@
+using System.Buffers.Binary;
+using System.Text;
+
+namespace myIoTGrid.Hub.Service.Helpers;
+
+/// <summary>
+/// Decoded binary serial-output chunk (Remote Serial Monitor).
+/// </summary>
+public sealed record SerialLogChunk(
+    uint Sequence,
+    uint NodeTimestamp,
+    uint DroppedLines,
+    IReadOnlyList<string> Lines
+);
+
+/// <summary>
+/// Decodes the binary serial-output chunks uploaded by the firmware.
+/// Format (little-endian):
+/// "MLG1" | u32 sequence | u32 nodeMillis | u32 droppedLines | u16 lineCount |
+/// u8 flags | u8 reserved | u32 rawLength | u32 payloadLength | payload.
+/// The raw payload is lineCount x (u16 length + UTF-8 bytes); flag bit 0 marks an LZ4 block.
+/// </summary>
+public static class SerialLogChunkDecoder
+{
+    public const int HeaderSize = 28;
+    public const byte FlagLz4 = 0x01;
+    public const int MaxRawLength = 65535;
+
+    private static ReadOnlySpan<byte> Magic => "MLG1"u8;
+
+    /// <summary>
+    /// Decodes a chunk. Returns false for malformed or truncated data.
+    /// </summary>
+    public static bool TryDecode(ReadOnlySpan<byte> data, out SerialLogChunk? chunk)
+    {
+        chunk = null;
+        if (data.Length < HeaderSize || !data[..4].SequenceEqual(Magic))
+            return false;
+
+        var sequence = BinaryPrimitives.ReadUInt32LittleEndian(data[4..]);
+        var nodeTimestamp = BinaryPrimitives.ReadUInt32LittleEndian(data[8..]);
+        var droppedLines = BinaryPrimitives.ReadUInt32LittleEndian(data[12..]);
+        var lineCount = BinaryPrimitives.ReadUInt16LittleEndian(data[16..]);
+        var flags = data[18];
+        var rawLength = BinaryPrimitives.ReadUInt32LittleEndian(data[20..]);
+        var payloadLength = BinaryPrimitives.ReadUInt32LittleEndian(data[24..]);
+
+        if (rawLength > MaxRawLength || payloadLength != data.Length - HeaderSize)
+            return false;
+
+        var payload = data[HeaderSize..];
+        byte[] raw;
+        if ((flags & FlagLz4) != 0)
+        {
+            raw = new byte[rawLength];
+            if (!TryDecompressLz4Block(payload, raw))
+                return false;
+        }
+        else
+        {
+            if (payloadLength != rawLength)
+                return false;
+            raw = payload.ToArray();
+        }
+
+        var lines = new List<string>(lineCount);
+        var position = 0;
+        for (var i = 0; i < lineCount; i++)
+        {
+            if (position + 2 > raw.Length)
+                return false;
+            var length = BinaryPrimitives.ReadUInt16LittleEndian(raw.AsSpan(position));
+            position += 2;
+            if (position + length > raw.Length)
+                return false;
+            lines.Add(Encoding.UTF8.GetString(raw, position, length));
+            position += length;
+        }
+
+        if (position != raw.Length)
+            return false;
+
+        chunk = new SerialLogChunk(sequence, nodeTimestamp, droppedLines, lines);
+        return true;
+    }
+
+    /// <summary>
+    /// Decompresses an LZ4 block that must expand to exactly output.Length bytes.
+    /// </summary>
+    public static bool TryDecompressLz4Block(ReadOnlySpan<byte> input, Span<byte> output)
+    {
+        var ip = 0;
+        var op = 0;
+
+        while (ip < input.Length)
+        {
+            var token = input[ip++];
+
+            var literalLength = token >> 4;
+            if (literalLength == 15 && !TryReadLengthTail(input, ref ip, ref literalLength))
+                return false;
+            if (literalLength > input.Length - ip || literalLength > output.Length - op)
+                return false;
+            input.Slice(ip, literalLength).CopyTo(output[op..]);
+            ip += literalLength;
+            op += literalLength;
+
+            // Last sequence has no match part
+            if (ip == input.Length)
+                break;
+
+            if (input.Length - ip < 2)
+                return false;
+            var offset = input[ip] | (input[ip + 1] << 8);
+            ip += 2;
+            if (offset == 0 || offset > op)
+                return false;
+
+            var matchLength = token & 0x0F;
+            if (matchLength == 15 && !TryReadLengthTail(input, ref ip, ref matchLength))
+                return false;
+            matchLength += 4;
+            if (matchLength > output.Length - op)
+                return false;
+
+            // Byte-wise copy: matches may overlap their own output
+            for (var i = 0; i < matchLength; i++, op++)
+                output[op] = output[op - offset];
+        }
+
+        return op == output.Length;
+    }
+
+    private static bool TryReadLengthTail(ReadOnlySpan<byte> input, ref int ip, ref int length)
+    {
+        byte b;
+        do
+        {
+            if (ip >= input.Length || length > MaxRawLength)
+                return false;
+            b = input[ip++];
+            length += b;
+        } while (b == 255);
+        return true;
+    }
+}
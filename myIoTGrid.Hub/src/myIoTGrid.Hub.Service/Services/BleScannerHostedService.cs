@@ -1,5 +1,6 @@
 using System.Text;
 using System.Text.Json;
+using System.Threading.Channels;
 using InTheHand.Bluetooth;
 using Microsoft.EntityFrameworkCore;
 using Microsoft.Extensions.Configuration;
@@ -7,6 +8,7 @@ using Microsoft.Extensions.DependencyInjection;
 using Microsoft.Extensions.Hosting;
 using Microsoft.Extensions.Logging;
 using myIoTGrid.Hub.Infrastructure.Data;
+using myIoTGrid.Hub.Service.Helpers;
 using myIoTGrid.Shared.Common.Enums;
 
 namespace myIoTGrid.Hub.Service.Services;
@@ -26,10 +28,23 @@ public class BleScannerHostedService : BackgroundService
     private readonly Guid _serviceUuid;
     private readonly Guid _sensorDataUuid;
     private readonly Guid _deviceInfoUuid;
+    private readonly Guid _schemaUuid;
 
     // Connected devices
     private readonly Dictionary<string, BluetoothDevice> _connectedDevices = new();
     private readonly Dictionary<string, GattCharacteristic> _sensorDataCharacteristics = new();
+    private readonly Dictionary<string, BleSensorConnection> _sensorConnections = new();
+
+    // Beacon key-cycle state per node (survives between scans)
+    private readonly Dictionary<string, BeaconChannelTracker> _beaconTrackers = new();
+
+    // History cursor per node: next sequence to pull (in memory, restarts at the oldest sample)
+    private readonly Dictionary<string, uint> _historyCursors = new();
+    private const byte HistoryWindow = 8;
+    private const int HistoryBatchTimeoutMs = 3000;
+
+    // Readings arrive both live and from the history ring; each is stored once
+    private readonly BleReadingDeduplicator _readingDeduplicator = new();
 
     // Configuration
     private readonly int _scanIntervalMs;
@@ -55,10 +70,12 @@ public class BleScannerHostedService : BackgroundService
         var serviceUuidStr = bleConfig.GetValue("ServiceUuid", "4d494f54-4752-4944-434f-4e4649470000");
         var sensorDataUuidStr = bleConfig.GetValue("SensorDataUuid", "4d494f54-4752-4944-434f-4e4649470003");
         var deviceInfoUuidStr = bleConfig.GetValue("DeviceInfoUuid", "4d494f54-4752-4944-434f-4e4649470002");
+        var schemaUuidStr = bleConfig.GetValue("SchemaUuid", "12345678-1234-5678-1234-56789abcdef3");
 
         _serviceUuid = Guid.Parse(serviceUuidStr!);
         _sensorDataUuid = Guid.Parse(sensorDataUuidStr!);
         _deviceInfoUuid = Guid.Parse(deviceInfoUuidStr!);
+        _schemaUuid = Guid.Parse(schemaUuidStr!);
     }
 
     protected override async Task ExecuteAsync(CancellationToken stoppingToken)
@@ -127,36 +144,25 @@ public class BleScannerHostedService : BackgroundService
                 try
                 {
                     if (!IsMyIoTGridDevice(e.Name)) return;
-                    if (foundDevices.ContainsKey(e.Device.Id)) return;
-                    foundDevices[e.Device.Id] = true;
-
-                    _logger.LogInformation("Found myIoTGrid beacon: {Name} ({Id})", e.Name, e.Device.Id);
+                    if (foundDevices.TryAdd(e.Device.Id, true))
+                        _logger.LogInformation("Found myIoTGrid beacon: {Name} ({Id})", e.Name, e.Device.Id);
 
-                    // Try to read manufacturer data from advertising packet
+                    // Beacons rotate several frames, so every advertisement is decoded
                     if (e.ManufacturerData != null && e.ManufacturerData.Count > 0)
                     {
                         foreach (var mfgData in e.ManufacturerData)
                         {
-                            _logger.LogInformation("Manufacturer data from {Name}: CompanyId=0x{CompanyId:X4}, {Length} bytes",
-                                e.Name, mfgData.Key, mfgData.Value.Length);
-
-                            // Parse sensor data from manufacturer data
-                            // Format: [temp:2][humidity:2][pressure:2][battery:2] = 8 bytes
-                            if (mfgData.Value.Length >= 8)
+                            if (!BeaconFrameDecoder.TryParse(mfgData.Value, out var frame))
                             {
-                                var data = mfgData.Value;
-                                var temp = BitConverter.ToInt16(data, 0) / 100.0;
-                                var humidity = BitConverter.ToUInt16(data, 2) / 100.0;
-                                var pressureRaw = BitConverter.ToUInt16(data, 4);
-                                var pressure = (pressureRaw + 50000) / 100.0;
-                                var battery = BitConverter.ToUInt16(data, 6);
-
-                                _logger.LogInformation("Beacon sensor data from {Name}: T={Temp:F1}°C H={Humidity:F0}% P={Pressure:F0}hPa Bat={Battery}mV",
-                                    e.Name, temp, humidity, pressure, battery);
-
-                                // Process the sensor data
-                                _ = ProcessBeaconManufacturerDataAsync(e.Name ?? e.Device.Id, temp, humidity, pressure);
+                                _logger.LogDebug("Unrecognized manufacturer data from {Name}: CompanyId=0x{CompanyId:X4}, {Length} bytes",
+                                    e.Name, mfgData.Key, mfgData.Value.Length);
+                                continue;
                             }
+
+                            var nodeId = e.Name ?? e.Device.Id;
+                            var readings = ApplyBeaconFrame(nodeId, frame!);
+                            if (readings.Count > 0)
+                                _ = ProcessBeaconManufacturerDataAsync(nodeId, readings);
                         }
                     }
                     else
@@ -204,10 +210,27 @@ public class BleScannerHostedService : BackgroundService
         }
     }
 
+    /// <summary>
+    /// Resolves a beacon frame against the device's key cycle.
+    /// Returns readings not yet reported in the frame's cycle.
+    /// </summary>
+    private IReadOnlyList<BleSensorReadingValue> ApplyBeaconFrame(string nodeId, BeaconFrame frame)
+    {
+        lock (_beaconTrackers)
+        {
+            if (!_beaconTrackers.TryGetValue(nodeId, out var tracker))
+            {
+                tracker = new BeaconChannelTracker();
+                _beaconTrackers[nodeId] = tracker;
+            }
+            return tracker.Apply(frame, BleSensorPayloadDecoder.DefaultSchema, DateTime.UtcNow);
+        }
+    }
+
     /// <summary>
     /// Processes sensor data from beacon manufacturer data
     /// </summary>
-    private async Task ProcessBeaconManufacturerDataAsync(string deviceName, double temperature, double humidity, double pressure)
+    private async Task ProcessBeaconManufacturerDataAsync(string deviceName, IReadOnlyList<BleSensorReadingValue> readings)
     {
         try
         {
@@ -219,42 +242,23 @@ public class BleScannerHostedService : BackgroundService
 
             var timestamp = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
 
-            // Create readings for each sensor value (skip zeros)
-            if (temperature != 0)
-            {
-                await readingService.CreateFromSensorAsync(new CreateSensorReadingDto(
-                    DeviceId: nodeId,
-                    Type: "temperature",
-                    Value: temperature,
-                    Unit: "°C",
-                    Timestamp: timestamp
-                ));
-            }
-
-            if (humidity != 0)
+            foreach (var reading in readings)
             {
-                await readingService.CreateFromSensorAsync(new CreateSensorReadingDto(
+                var dto = new CreateSensorReadingDto(
                     DeviceId: nodeId,
-                    Type: "humidity",
-                    Value: humidity,
-                    Unit: "%",
+                    Type: reading.Type,
+                    Value: reading.Value,
+                    Unit: reading.Unit,
                     Timestamp: timestamp
-                ));
-            }
+                );
+                if (!_readingDeduplicator.TryAddLive(dto))
+                    continue;   // Already stored from the history
 
-            if (pressure != 0 && pressure > 800 && pressure < 1200)  // Valid pressure range
-            {
-                await readingService.CreateFromSensorAsync(new CreateSensorReadingDto(
-                    DeviceId: nodeId,
-                    Type: "pressure",
-                    Value: pressure,
-                    Unit: "hPa",
-                    Timestamp: timestamp
-                ));
+                await readingService.CreateFromSensorAsync(dto);
             }
 
-            _logger.LogInformation("Processed beacon data from {NodeId}: T={Temp:F1}°C H={Humidity:F0}% P={Pressure:F0}hPa",
-                nodeId, temperature, humidity, pressure);
+            _logger.LogInformation("Processed beacon data from {NodeId}: {Readings}",
+                nodeId, string.Join(", ", readings.Select(r => $"{r.Type}={r.Value}{r.Unit}")));
         }
         catch (Exception ex)
         {
@@ -312,6 +316,7 @@ public class BleScannerHostedService : BackgroundService
             var beaconServiceUuid = Guid.Parse("4d494f54-4752-4944-434f-4e4649470000");
             var sensorDataCharUuid = Guid.Parse("4d494f54-4752-4944-434f-4e4649470003");
             var configReadCharUuid = Guid.Parse("4d494f54-4752-4944-434f-4e4649470002");
+            var historyCharUuid = Guid.Parse("4d494f54-4752-4944-434f-4e4649470004");
 
             var service = await gatt.GetPrimaryServiceAsync(BluetoothUuid.FromGuid(beaconServiceUuid));
             if (service == null)
@@ -372,6 +377,13 @@ public class BleScannerHostedService : BackgroundService
                 }
             }
 
+            // Pull readings stored while no Hub was listening
+            var historyChar = await service.GetCharacteristicAsync(BluetoothUuid.FromGuid(historyCharUuid));
+            if (historyChar != null)
+            {
+                await PullBeaconHistoryAsync(historyChar, nodeId, stoppingToken);
+            }
+
             gatt.Disconnect();
         }
         catch (Exception ex)
@@ -380,6 +392,113 @@ public class BleScannerHostedService : BackgroundService
         }
     }
 
+    /// <summary>
+    /// Bulk-reads the node's history ring from the stored cursor.
+    /// Requests windows of batches (write without response) until the node reports the newest sample.
+    /// </summary>
+    private async Task PullBeaconHistoryAsync(GattCharacteristic historyChar, string nodeId, CancellationToken stoppingToken)
+    {
+        var batches = Channel.CreateUnbounded<byte[]>();
+        void OnBatch(object? sender, GattCharacteristicValueChangedEventArgs e)
+        {
+            if (e.Value != null) batches.Writer.TryWrite(e.Value);
+        }
+
+        uint cursor;
+        lock (_historyCursors)
+        {
+            cursor = _historyCursors.GetValueOrDefault(nodeId);
+        }
+
+        var readings = new List<CreateSensorReadingDto>();
+        var startCursor = cursor;
+        var pullStartedAt = DateTimeOffset.UtcNow;
+        historyChar.CharacteristicValueChanged += OnBatch;
+        try
+        {
+            await historyChar.StartNotificationsAsync();
+
+            var last = false;
+            while (!last)
+            {
+                await historyChar.WriteValueWithoutResponseAsync(BleHistoryDecoder.BuildReadRequest(cursor, HistoryWindow));
+
+                for (var i = 0; i < HistoryWindow && !last; i++)
+                {
+                    using var timeout = CancellationTokenSource.CreateLinkedTokenSource(stoppingToken);
+                    timeout.CancelAfter(HistoryBatchTimeoutMs);
+                    var data = await batches.Reader.ReadAsync(timeout.Token);
+
+                    if (!BleHistoryDecoder.TryParseBatch(data, out var batch))
+                    {
+                        _logger.LogWarning("Invalid history batch from {NodeId} ({Length} bytes)", nodeId, data.Length);
+                        last = true;
+                        break;
+                    }
+
+                    if (batch!.FirstSequence != cursor)
+                    {
+                        _logger.LogWarning("History of {NodeId} restarted at sequence {First} (cursor {Cursor})",
+                            nodeId, batch.FirstSequence, cursor);
+                    }
+
+                    var receivedAt = DateTimeOffset.UtcNow;
+                    foreach (var sample in batch.Samples)
+                    {
+                        if (!BleSensorPayloadDecoder.DefaultSchema.TryGetValue(sample.TypeId, out var entry))
+                            continue;
+                        readings.Add(new CreateSensorReadingDto(
+                            DeviceId: nodeId,
+                            Type: entry.Type,
+                            Value: sample.Value / Math.Pow(10, entry.Decimals),
+                            Unit: entry.Unit,
+                            Timestamp: BleHistoryDecoder.ToTimestamp(sample, batch.NowSeconds, receivedAt).ToUnixTimeMilliseconds()
+                        ));
+                    }
+
+                    cursor = batch.NextSequence;
+                    last = batch.Last;
+                }
+            }
+        }
+        catch (OperationCanceledException) when (!stoppingToken.IsCancellationRequested)
+        {
+            _logger.LogWarning("History read from {NodeId} timed out at sequence {Cursor}", nodeId, cursor);
+        }
+        catch (Exception ex)
+        {
+            _logger.LogWarning(ex, "History read from {NodeId} failed at sequence {Cursor}", nodeId, cursor);
+        }
+        finally
+        {
+            historyChar.CharacteristicValueChanged -= OnBatch;
+            try { await historyChar.StopNotificationsAsync(); } catch { /* Disconnecting anyway */ }
+        }
+
+        if (readings.Count == 0 && cursor == startCursor)
+            return;
+
+        // Samples that were also advertised are already stored
+        var pulled = readings.Count;
+        readings = _readingDeduplicator.FilterHistory(nodeId, readings, pullStartedAt);
+
+        using var scope = _scopeFactory.CreateScope();
+        var readingService = scope.ServiceProvider.GetRequiredService<IReadingService>();
+        foreach (var reading in readings)
+        {
+            await readingService.CreateFromSensorAsync(reading);
+        }
+
+        // Advance only after the readings are stored
+        lock (_historyCursors)
+        {
+            _historyCursors[nodeId] = cursor;
+        }
+
+        _logger.LogInformation("Pulled {Count} history readings from {NodeId} (sequence {First}..{Cursor}), {Skipped} already stored",
+            readings.Count, nodeId, startCursor, cursor, pulled - readings.Count);
+    }
+
     /// <summary>
     /// Processes sensor data from beacon JSON format
     /// </summary>
@@ -601,13 +720,34 @@ public class BleScannerHostedService : BackgroundService
                 return;
             }
 
-            // Subscribe to notifications
-            sensorDataChar.CharacteristicValueChanged += OnSensorDataReceived;
-            await sensorDataChar.StartNotificationsAsync();
+            // Payload type table (binary payload v1) - read once per connection
+            var schemaChar = await service.GetCharacteristicAsync(BluetoothUuid.FromGuid(_schemaUuid));
+            var schemaData = schemaChar != null ? await schemaChar.ReadValueAsync() : null;
+            if (schemaData == null || !BleSensorPayloadDecoder.TryParseSchema(schemaData, out var schema))
+            {
+                _logger.LogWarning("Payload schema not readable on {DeviceName}", device.Name);
+                gatt.Disconnect();
+                return;
+            }
+
+            // Node ID is no longer repeated in every notification
+            var nodeId = device.Name ?? device.Id;
+            var deviceInfoChar = await service.GetCharacteristicAsync(BluetoothUuid.FromGuid(_deviceInfoUuid));
+            if (deviceInfoChar != null)
+            {
+                var deviceInfo = JsonSerializer.Deserialize<BeaconDeviceInfo>(await deviceInfoChar.ReadValueAsync());
+                if (!string.IsNullOrEmpty(deviceInfo?.NodeId))
+                    nodeId = deviceInfo.NodeId;
+            }
 
-            // Store connection
+            // Store connection before notifications can arrive
             _connectedDevices[device.Id] = device;
             _sensorDataCharacteristics[device.Id] = sensorDataChar;
+            _sensorConnections[device.Id] = new BleSensorConnection(nodeId, schema!, new BleFragmentAssembler());
+
+            // Subscribe to notifications
+            sensorDataChar.CharacteristicValueChanged += OnSensorDataReceived;
+            await sensorDataChar.StartNotificationsAsync();
 
             _logger.LogInformation("Successfully connected and subscribed to {DeviceName}", device.Name);
 
@@ -630,21 +770,28 @@ public class BleScannerHostedService : BackgroundService
                 return;
             }
 
-            var jsonData = Encoding.UTF8.GetString(e.Value);
-            _logger.LogDebug("Received BLE data: {Data}", jsonData);
-
-            // Parse the sensor data
-            var sensorData = JsonSerializer.Deserialize<BleSensorDataPayload>(jsonData, new JsonSerializerOptions
+            var deviceId = _sensorDataCharacteristics.FirstOrDefault(kvp => ReferenceEquals(kvp.Value, sender)).Key;
+            if (deviceId == null || !_sensorConnections.TryGetValue(deviceId, out var connection))
             {
-                PropertyNameCaseInsensitive = true
-            });
+                _logger.LogWarning("Received BLE data from unknown characteristic");
+                return;
+            }
 
-            if (sensorData == null)
+            // Wait for the remaining fragments of the message
+            if (!connection.Assembler.TryAdd(e.Value, out var message))
+                return;
+
+            if (!BleSensorPayloadDecoder.TryDecode(message!, connection.Schema, out var sensorData))
             {
-                _logger.LogWarning("Failed to parse sensor data");
+                _logger.LogWarning("Failed to parse sensor data from {NodeId} ({Length} bytes)",
+                    connection.NodeId, message!.Length);
                 return;
             }
 
+            // Payload carries node millis; readings are stamped with Hub time
+            sensorData!.NodeId = connection.NodeId;
+            sensorData.Timestamp = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
+
             // Process the sensor data using scoped services
             await ProcessSensorDataAsync(sensorData);
         }
@@ -759,6 +906,7 @@ public class BleScannerHostedService : BackgroundService
 
         _connectedDevices.Clear();
         _sensorDataCharacteristics.Clear();
+        _sensorConnections.Clear();
     }
 
     public override async Task StopAsync(CancellationToken cancellationToken)
@@ -770,7 +918,7 @@ public class BleScannerHostedService : BackgroundService
 }
 
 /// <summary>
-/// Payload structure for BLE sensor data (must match ESP32 firmware)
+/// Decoded BLE sensor data (see BleSensorPayloadDecoder for the wire format)
 /// </summary>
 public class BleSensorDataPayload
 {
@@ -796,6 +944,14 @@ public class BleSensorGps
     public int? Satellites { get; set; }
 }
 
+/// <summary>
+/// Per-connection state for the binary sensor payload
+/// </summary>
+internal sealed record BleSensorConnection(
+    string NodeId,
+    IReadOnlyDictionary<byte, BleSensorSchemaEntry> Schema,
+    BleFragmentAssembler Assembler);
+
 /// <summary>
 /// Internal class to hold registered BLE device info from database
 /// </summary>
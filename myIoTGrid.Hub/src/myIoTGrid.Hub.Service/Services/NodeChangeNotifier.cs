@@ -0,0 +1,24 @@
+using System.Collections.Concurrent;
+
+namespace myIoTGrid.Hub.Service.Services;
+
+/// <summary>
+/// Singleton <see cref="INodeChangeNotifier"/>: one pending completion source per node,
+/// replaced on every change.
+/// </summary>
+public class NodeChangeNotifier : INodeChangeNotifier
+{
+    private readonly ConcurrentDictionary<Guid, TaskCompletionSource> _pending = new();
+
+    /// <inheritdoc />
+    public Task WhenChanged(Guid nodeId)
+        => _pending.GetOrAdd(nodeId,
+            _ => new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously)).Task;
+
+    /// <inheritdoc />
+    public void NotifyChanged(Guid nodeId)
+    {
+        if (_pending.TryRemove(nodeId, out var changed))
+            changed.TrySetResult();
+    }
+}
@@ -12,15 +12,18 @@ public class NodeDebugLogService : INodeDebugLogService
 {
     private readonly HubDbContext _context;
     private readonly ISignalRNotificationService _signalRNotificationService;
+    private readonly INodeChangeNotifier _changeNotifier;
     private readonly ILogger<NodeDebugLogService> _logger;
 
     public NodeDebugLogService(
         HubDbContext context,
         ISignalRNotificationService signalRNotificationService,
+        INodeChangeNotifier changeNotifier,
         ILogger<NodeDebugLogService> logger)
     {
         _context = context;
         _signalRNotificationService = signalRNotificationService;
+        _changeNotifier = changeNotifier;
         _logger = logger;
     }
 
@@ -171,8 +174,9 @@ public class NodeDebugLogService : INodeDebugLogService
         _logger.LogInformation("Set debug level {Level} for node {NodeId}, remote logging: {RemoteLogging}",
             dto.DebugLevel, node.NodeId, dto.EnableRemoteLogging);
 
-        // Notify via SignalR
+        // Notify via SignalR and wake the node's control long-poll
         await _signalRNotificationService.NotifyDebugConfigChangedAsync(node.ToDebugConfigDto(), ct);
+        _changeNotifier.NotifyChanged(node.Id);
 
         return node.ToDebugConfigDto();
     }
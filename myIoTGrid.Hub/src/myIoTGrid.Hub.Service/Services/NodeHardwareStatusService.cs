@@ -1,4 +1,5 @@
 using System.Text.Json;
+using System.Text.Json.Nodes;
 using Microsoft.EntityFrameworkCore;
 using Microsoft.Extensions.Logging;
 using myIoTGrid.Hub.Infrastructure.Data;
@@ -41,12 +42,15 @@ public class NodeHardwareStatusService : INodeHardwareStatusService
         node.FirmwareVersion = dto.FirmwareVersion;
         node.HardwareStatusReportedAt = DateTime.UtcNow;
 
-        // Create the internal status object to store
+        // Create the internal status object to store (memory comes with the heartbeat: keep it)
         var internalStatus = new
         {
             dto.DetectedDevices,
             dto.Storage,
-            dto.BusStatus
+            dto.BusStatus,
+            dto.Timing,
+            dto.Stalls,
+            Memory = ReadMemoryReport(node.HardwareStatusJson)
         };
         node.HardwareStatusJson = JsonSerializer.Serialize(internalStatus, JsonOptions);
 
@@ -111,6 +115,9 @@ public class NodeHardwareStatusService : INodeHardwareStatusService
         List<DetectedDeviceDto> detectedDevices = new();
         StorageStatusDto storage = new(false, "REMOTE_ONLY", 0, 0, 0, 0, null, null);
         BusStatusDto busStatus = new(false, 0, new List<string>(), false, 0, false, false);
+        TimingReportDto? timing = null;
+        StallReportDto? stalls = null;
+        MemoryReportDto? memory = null;
 
         if (!string.IsNullOrEmpty(node.HardwareStatusJson))
         {
@@ -139,6 +146,30 @@ public class NodeHardwareStatusService : INodeHardwareStatusService
                     busStatus = JsonSerializer.Deserialize<BusStatusDto>(
                         busElement.GetRawText(), JsonOptions) ?? busStatus;
                 }
+
+                // Parse timing (firmware with hot-path instrumentation only)
+                if (root.TryGetProperty("timing", out var timingElement) &&
+                    timingElement.ValueKind == JsonValueKind.Object)
+                {
+                    timing = JsonSerializer.Deserialize<TimingReportDto>(
+                        timingElement.GetRawText(), JsonOptions);
+                }
+
+                // Parse loop stalls (firmware with the stall profiler only)
+                if (root.TryGetProperty("stalls", out var stallsElement) &&
+                    stallsElement.ValueKind == JsonValueKind.Object)
+                {
+                    stalls = JsonSerializer.Deserialize<StallReportDto>(
+                        stallsElement.GetRawText(), JsonOptions);
+                }
+
+                // Parse memory telemetry (stored by the heartbeat)
+                if (root.TryGetProperty("memory", out var memoryElement) &&
+                    memoryElement.ValueKind == JsonValueKind.Object)
+                {
+                    memory = JsonSerializer.Deserialize<MemoryReportDto>(
+                        memoryElement.GetRawText(), JsonOptions);
+                }
             }
             catch (JsonException ex)
             {
@@ -174,7 +205,54 @@ public class NodeHardwareStatusService : INodeHardwareStatusService
             Summary: summary,
             DetectedDevices: detectedDevices,
             Storage: storage,
-            BusStatus: busStatus
+            BusStatus: busStatus,
+            Timing: timing,
+            Stalls: stalls,
+            Memory: memory
         );
     }
+
+    /// <summary>
+    /// Stores a heartbeat's memory report in the hardware status JSON, keeping the rest of the status.
+    /// </summary>
+    public static string WithMemoryReport(string? hardwareStatusJson, MemoryReportDto memory)
+    {
+        JsonObject? status = null;
+        if (!string.IsNullOrEmpty(hardwareStatusJson))
+        {
+            try
+            {
+                status = JsonNode.Parse(hardwareStatusJson) as JsonObject;
+            }
+            catch (JsonException)
+            {
+                // Replaced below
+            }
+        }
+
+        status ??= new JsonObject();
+        status["memory"] = JsonSerializer.SerializeToNode(memory, JsonOptions);
+        return status.ToJsonString(JsonOptions);
+    }
+
+    private static MemoryReportDto? ReadMemoryReport(string? hardwareStatusJson)
+    {
+        if (string.IsNullOrEmpty(hardwareStatusJson))
+        {
+            return null;
+        }
+
+        try
+        {
+            using var doc = JsonDocument.Parse(hardwareStatusJson);
+            return doc.RootElement.TryGetProperty("memory", out var memoryElement) &&
+                   memoryElement.ValueKind == JsonValueKind.Object
+                ? JsonSerializer.Deserialize<MemoryReportDto>(memoryElement.GetRawText(), JsonOptions)
+                : null;
+        }
+        catch (JsonException)
+        {
+            return null;
+        }
+    }
 }
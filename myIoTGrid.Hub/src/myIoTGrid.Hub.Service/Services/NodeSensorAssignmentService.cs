@@ -15,17 +15,20 @@ public class NodeSensorAssignmentService : INodeSensorAssignmentService
     private readonly HubDbContext _context;
     private readonly IUnitOfWork _unitOfWork;
     private readonly IEffectiveConfigService _effectiveConfigService;
+    private readonly INodeChangeNotifier _changeNotifier;
     private readonly ILogger<NodeSensorAssignmentService> _logger;
 
     public NodeSensorAssignmentService(
         HubDbContext context,
         IUnitOfWork unitOfWork,
         IEffectiveConfigService effectiveConfigService,
+        INodeChangeNotifier changeNotifier,
         ILogger<NodeSensorAssignmentService> logger)
     {
         _context = context;
         _unitOfWork = unitOfWork;
         _effectiveConfigService = effectiveConfigService;
+        _changeNotifier = changeNotifier;
         _logger = logger;
     }
 
@@ -136,6 +139,7 @@ public class NodeSensorAssignmentService : INodeSensorAssignmentService
 
         _logger.LogInformation("Assignment created: Sensor {SensorId} -> Node {NodeId} (Endpoint {EndpointId})",
             dto.SensorId, nodeId, dto.EndpointId);
+        _changeNotifier.NotifyChanged(nodeId);
 
         return assignment.ToDto(_effectiveConfigService);
     }
@@ -157,6 +161,7 @@ public class NodeSensorAssignmentService : INodeSensorAssignmentService
         await _unitOfWork.SaveChangesAsync(ct);
 
         _logger.LogInformation("Assignment updated: {AssignmentId}", id);
+        _changeNotifier.NotifyChanged(assignment.NodeId);
 
         return assignment.ToDto(_effectiveConfigService);
     }
@@ -176,6 +181,7 @@ public class NodeSensorAssignmentService : INodeSensorAssignmentService
         await _unitOfWork.SaveChangesAsync(ct);
 
         _logger.LogInformation("Assignment deleted: {AssignmentId}", id);
+        _changeNotifier.NotifyChanged(assignment.NodeId);
     }
 
     /// <inheritdoc />
@@ -618,6 +618,10 @@ public class NodeService : INodeService
         if (dto.BatteryLevel.HasValue)
             node.BatteryLevel = dto.BatteryLevel;
 
+        // Latest memory telemetry, served with the hardware status
+        if (dto.Memory != null)
+            node.HardwareStatusJson = NodeHardwareStatusService.WithMemoryReport(node.HardwareStatusJson, dto.Memory);
+
         await _unitOfWork.SaveChangesAsync(ct);
 
         _logger.LogDebug("Heartbeat processed for node {NodeId}", dto.NodeId);
@@ -23,6 +23,7 @@ public class NodesControllerTests
     private readonly Mock<ISensorService> _sensorServiceMock;
     private readonly Mock<IReadingService> _readingServiceMock;
     private readonly Mock<INodeDebugLogService> _debugLogServiceMock;
+    private readonly Mock<INodeChangeNotifier> _changeNotifierMock;
     private readonly Mock<IHubContext<SensorHub>> _hubContextMock;
     private readonly Mock<IClientProxy> _clientProxyMock;
     private readonly Mock<IConfiguration> _configurationMock;
@@ -43,6 +44,7 @@ public class NodesControllerTests
         _sensorServiceMock = new Mock<ISensorService>();
         _readingServiceMock = new Mock<IReadingService>();
         _debugLogServiceMock = new Mock<INodeDebugLogService>();
+        _changeNotifierMock = new Mock<INodeChangeNotifier>();
         _hubContextMock = new Mock<IHubContext<SensorHub>>();
         _clientProxyMock = new Mock<IClientProxy>();
         _configurationMock = new Mock<IConfiguration>();
@@ -60,6 +62,7 @@ public class NodesControllerTests
             _sensorServiceMock.Object,
             _readingServiceMock.Object,
             _debugLogServiceMock.Object,
+            _changeNotifierMock.Object,
             _hubContextMock.Object,
             _configurationMock.Object,
             _loggerMock.Object);
@@ -704,6 +707,41 @@ public class NodesControllerTests
             Times.Once);
     }
 
+    [Fact]
+    public async Task Heartbeat_WithValidApiKey_ReturnsControlPlaneState()
+    {
+        // Arrange
+        var dto = new NodeHeartbeatDto(NodeId: "node-01");
+        var node = CreateNodeDto("node-01", "Test Node");
+        var serverTime = new DateTime(2025, 1, 1, 12, 0, 0, DateTimeKind.Utc);
+
+        SetAuthorizationHeader("Bearer mig_key_validkey");
+        _nodeServiceMock.Setup(s => s.ValidateApiKeyAsync("node-01", "mig_key_validkey", It.IsAny<CancellationToken>()))
+            .ReturnsAsync(node);
+        _nodeServiceMock.Setup(s => s.ProcessHeartbeatAsync(dto, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new NodeHeartbeatResponseDto(Success: true, ServerTime: serverTime, NextHeartbeatSeconds: 60));
+        _nodeServiceMock.Setup(s => s.GetAllAsync(It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new List<NodeDto> { node });
+        _assignmentServiceMock.Setup(s => s.GetByNodeAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new List<NodeSensorAssignmentDto> { CreateAssignmentDto(1, "temperature") });
+        _debugLogServiceMock.Setup(s => s.GetDebugConfigurationAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new NodeDebugConfigurationDto(_nodeId, "node-01", DebugLevelDto.Debug, true, null));
+
+        await _sut.GetConfiguration("node-01", CancellationToken.None);
+        var configurationEtag = _sut.Response.Headers.ETag.ToString();
+
+        // Act
+        var result = await _sut.Heartbeat(dto, CancellationToken.None);
+
+        // Assert
+        var okResult = result.Should().BeOfType<OkObjectResult>().Subject;
+        var response = okResult.Value.Should().BeOfType<NodeHeartbeatResponseDto>().Subject;
+        response.UnixTimestamp.Should().Be(1735732800);
+        response.ConfigurationVersion.Should().Be(configurationEtag);
+        response.DebugLevel.Should().Be(DebugLevelDto.Debug);
+        response.EnableRemoteLogging.Should().BeTrue();
+    }
+
     [Fact]
     public async Task Heartbeat_WithoutAuthHeader_ReturnsUnauthorized()
     {
@@ -920,6 +958,146 @@ public class NodesControllerTests
         result.Should().BeOfType<NotFoundObjectResult>();
     }
 
+    [Fact]
+    public async Task GetConfiguration_WithMatchingIfNoneMatch_ReturnsNotModified()
+    {
+        // Arrange
+        var nodes = new List<NodeDto> { CreateNodeDto("node-01", "Test Node") };
+        _nodeServiceMock.Setup(s => s.GetAllAsync(It.IsAny<CancellationToken>()))
+            .ReturnsAsync(nodes);
+        _assignmentServiceMock.Setup(s => s.GetByNodeAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new List<NodeSensorAssignmentDto> { CreateAssignmentDto(1, "temperature") });
+
+        await _sut.GetConfiguration("node-01", CancellationToken.None);
+        var etag = _sut.Response.Headers.ETag.ToString();
+        _sut.Request.Headers.IfNoneMatch = etag;
+
+        // Act
+        var result = await _sut.GetConfiguration("node-01", CancellationToken.None);
+
+        // Assert
+        etag.Should().NotBeNullOrEmpty();
+        result.Should().BeOfType<StatusCodeResult>()
+            .Which.StatusCode.Should().Be(StatusCodes.Status304NotModified);
+    }
+
+    [Fact]
+    public async Task GetConfiguration_WithStaleIfNoneMatch_ReturnsOk()
+    {
+        // Arrange
+        var nodes = new List<NodeDto> { CreateNodeDto("node-01", "Test Node") };
+        _nodeServiceMock.Setup(s => s.GetAllAsync(It.IsAny<CancellationToken>()))
+            .ReturnsAsync(nodes);
+        _assignmentServiceMock.Setup(s => s.GetByNodeAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new List<NodeSensorAssignmentDto> { CreateAssignmentDto(1, "temperature") });
+        _sut.Request.Headers.IfNoneMatch = "\"0000000000000000\"";
+
+        // Act
+        var result = await _sut.GetConfiguration("node-01", CancellationToken.None);
+
+        // Assert
+        result.Should().BeOfType<OkObjectResult>();
+    }
+
+    [Fact]
+    public async Task GetConfiguration_WithAdcCapabilities_IncludesChannelGainAndDataRate()
+    {
+        // Arrange
+        var nodes = new List<NodeDto> { CreateNodeDto("node-01", "Test Node") };
+        _nodeServiceMock.Setup(s => s.GetAllAsync(It.IsAny<CancellationToken>()))
+            .ReturnsAsync(nodes);
+        _assignmentServiceMock.Setup(s => s.GetByNodeAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new List<NodeSensorAssignmentDto> { CreateAssignmentDto(1, "voltage") });
+        _sensorServiceMock.Setup(s => s.GetByIdAsync(_sensorId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(CreateAdcSensorDto());
+
+        // Act
+        var result = await _sut.GetConfiguration("node-01", CancellationToken.None);
+
+        // Assert
+        var okResult = result.Should().BeOfType<OkObjectResult>().Subject;
+        var config = okResult.Value.Should().BeOfType<NodeSensorConfigurationDto>().Subject;
+        var capabilities = config.Sensors.Should().ContainSingle().Subject.Capabilities;
+        capabilities.Should().HaveCount(2);
+        capabilities[0].AdcChannel.Should().Be(2);
+        capabilities[0].AdcGain.Should().Be(4.0);
+        capabilities[0].AdcDataRate.Should().Be(250);
+        capabilities[1].AdcChannel.Should().BeNull();
+        capabilities[1].AdcGain.Should().BeNull();
+        capabilities[1].AdcDataRate.Should().BeNull();
+    }
+
+    #endregion
+
+    #region GetControlState Tests
+
+    [Fact]
+    public async Task GetControlState_WithoutIfNoneMatch_ReturnsStateWithETag()
+    {
+        // Arrange
+        SetupControlState();
+
+        // Act
+        var result = await _sut.GetControlState("node-01", 0, CancellationToken.None);
+
+        // Assert
+        var okResult = result.Should().BeOfType<OkObjectResult>().Subject;
+        var state = okResult.Value.Should().BeOfType<NodeControlStateDto>().Subject;
+        state.DebugLevel.Should().Be(DebugLevelDto.Normal);
+        _sut.Response.Headers.ETag.ToString().Should().NotBeNullOrEmpty();
+    }
+
+    [Fact]
+    public async Task GetControlState_WithMatchingIfNoneMatchAndNoChange_ReturnsNotModified()
+    {
+        // Arrange
+        SetupControlState();
+        await _sut.GetControlState("node-01", 0, CancellationToken.None);
+        _sut.Request.Headers.IfNoneMatch = _sut.Response.Headers.ETag.ToString();
+
+        // Act
+        var result = await _sut.GetControlState("node-01", 1, CancellationToken.None);
+
+        // Assert
+        result.Should().BeOfType<StatusCodeResult>()
+            .Which.StatusCode.Should().Be(StatusCodes.Status304NotModified);
+    }
+
+    [Fact]
+    public async Task GetControlState_WhenChangedWhileWaiting_ReturnsNewState()
+    {
+        // Arrange
+        SetupControlState();
+        await _sut.GetControlState("node-01", 0, CancellationToken.None);
+        _sut.Request.Headers.IfNoneMatch = _sut.Response.Headers.ETag.ToString();
+
+        var changed = new TaskCompletionSource();
+        _changeNotifierMock.Setup(n => n.WhenChanged(_nodeId)).Returns(changed.Task);
+
+        // Act
+        var pending = _sut.GetControlState("node-01", 30, CancellationToken.None);
+        _debugLogServiceMock.Setup(s => s.GetDebugConfigurationAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new NodeDebugConfigurationDto(_nodeId, "node-01", DebugLevelDto.Debug, true, null));
+        changed.SetResult();
+        var result = await pending.WaitAsync(TimeSpan.FromSeconds(5));
+
+        // Assert
+        var okResult = result.Should().BeOfType<OkObjectResult>().Subject;
+        var state = okResult.Value.Should().BeOfType<NodeControlStateDto>().Subject;
+        state.DebugLevel.Should().Be(DebugLevelDto.Debug);
+        state.EnableRemoteLogging.Should().BeTrue();
+    }
+
+    private void SetupControlState()
+    {
+        _nodeServiceMock.Setup(s => s.GetAllAsync(It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new List<NodeDto> { CreateNodeDto("node-01", "Test Node") });
+        _assignmentServiceMock.Setup(s => s.GetByNodeAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(new List<NodeSensorAssignmentDto> { CreateAssignmentDto(1, "temperature") });
+        _changeNotifierMock.Setup(n => n.WhenChanged(It.IsAny<Guid>()))
+            .Returns(new TaskCompletionSource().Task);
+    }
+
     #endregion
 
     #region GetGpsStatus Tests
@@ -1101,6 +1279,31 @@ public class NodesControllerTests
         result.Should().BeOfType<NotFoundObjectResult>();
     }
 
+    [Fact]
+    public async Task GetDebugConfiguration_WithMatchingIfNoneMatch_ReturnsNotModified()
+    {
+        // Arrange
+        var config = new NodeDebugConfigurationDto(
+            NodeId: _nodeId,
+            SerialNumber: "ESP32-0070078492CC",
+            DebugLevel: DebugLevelDto.Normal,
+            EnableRemoteLogging: false,
+            LastDebugChange: new DateTime(2025, 1, 1, 0, 0, 0, DateTimeKind.Utc)
+        );
+        _debugLogServiceMock.Setup(s => s.GetDebugConfigurationAsync(_nodeId, It.IsAny<CancellationToken>()))
+            .ReturnsAsync(config);
+
+        await _sut.GetDebugConfiguration(_nodeId, CancellationToken.None);
+        _sut.Request.Headers.IfNoneMatch = _sut.Response.Headers.ETag.ToString();
+
+        // Act
+        var result = await _sut.GetDebugConfiguration(_nodeId, CancellationToken.None);
+
+        // Assert
+        result.Should().BeOfType<StatusCodeResult>()
+            .Which.StatusCode.Should().Be(StatusCodes.Status304NotModified);
+    }
+
     [Fact]
     public async Task SetDebugLevel_WithExistingNode_ReturnsOk()
     {
@@ -1231,6 +1434,52 @@ public class NodesControllerTests
         );
     }
 
+    private SensorDto CreateAdcSensorDto()
+    {
+        return new SensorDto(
+            Id: _sensorId,
+            TenantId: _tenantId,
+            Code: "ads1115-01",
+            Name: "ADS1115 ADC",
+            Description: null,
+            SerialNumber: null,
+            Manufacturer: "Texas Instruments",
+            Model: "ADS1115",
+            DatasheetUrl: null,
+            Protocol: CommunicationProtocolDto.I2C,
+            I2CAddress: "0x48",
+            SdaPin: 21,
+            SclPin: 22,
+            OneWirePin: null,
+            AnalogPin: null,
+            DigitalPin: null,
+            TriggerPin: null,
+            EchoPin: null,
+            BaudRate: null,
+            IntervalSeconds: 60,
+            MinIntervalSeconds: 1,
+            WarmupTimeMs: 0,
+            OffsetCorrection: 0,
+            GainCorrection: 1,
+            LastCalibratedAt: null,
+            CalibrationNotes: null,
+            CalibrationDueAt: null,
+            Category: "analog",
+            Icon: null,
+            Color: null,
+            Capabilities: new List<SensorCapabilityDto>
+            {
+                new(Guid.NewGuid(), _sensorId, "voltage", "Voltage", "V", null, null, 0.001, 0.01,
+                    null, null, 0, true, AdcChannel: 2, AdcGain: 4.0, AdcDataRate: 250),
+                new(Guid.NewGuid(), _sensorId, "soil_moisture", "Soil Moisture", "%", null, null, 0.1, 1.0,
+                    null, null, 1, true)
+            },
+            IsActive: true,
+            CreatedAt: DateTime.UtcNow,
+            UpdatedAt: DateTime.UtcNow
+        );
+    }
+
     private ReadingDto CreateReadingDto(string measurementType, double value)
     {
         return new ReadingDto(
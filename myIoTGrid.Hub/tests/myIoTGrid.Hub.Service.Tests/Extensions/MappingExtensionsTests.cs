@@ -1679,6 +1679,31 @@ public class MappingExtensionsTests
         sortedCapabilities[2].SortOrder.Should().Be(5); // Explicit sort preserved
     }
 
+    [Fact]
+    public void CreateSensorDto_ToEntity_WithAdcCapability_KeepsAdcSettings()
+    {
+        // Arrange
+        var dto = new CreateSensorDto(
+            Code: "ADS1115",
+            Name: "ADS1115 ADC",
+            Category: "analog",
+            Protocol: CommunicationProtocolDto.I2C,
+            Capabilities: new List<CreateSensorCapabilityDto>
+            {
+                new CreateSensorCapabilityDto("voltage", "Voltage", "V",
+                    AdcChannel: 3, AdcGain: 2.0, AdcDataRate: 475)
+            }
+        );
+
+        // Act
+        var result = dto.ToEntity(Guid.NewGuid()).Capabilities.Single().ToDto();
+
+        // Assert
+        result.AdcChannel.Should().Be(3);
+        result.AdcGain.Should().Be(2.0);
+        result.AdcDataRate.Should().Be(475);
+    }
+
     [Fact]
     public void CreateSensorDto_ToEntity_WithoutCapabilities_ReturnsEmptyCollection()
     {
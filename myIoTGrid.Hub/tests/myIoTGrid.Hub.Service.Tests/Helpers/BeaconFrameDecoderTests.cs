@@ -0,0 +1,181 @@
+using FluentAssertions;
+using myIoTGrid.Hub.Service.Helpers;
+
+namespace myIoTGrid.Hub.Service.Tests.Helpers;
+
+/// <summary>
+/// Tests for BeaconFrameDecoder and BeaconChannelTracker helper classes.
+/// </summary>
+public class BeaconFrameDecoderTests
+{
+    // Manufacturer data without company ID, as produced by the firmware:
+    // key cycle 1 with temperature 21.53, humidity 45.20, pressure 1013.25 and co2 812
+    private static readonly byte[] KeyFrame = Convert.FromHexString("0102000000001100e40c01d22102d046039aaf0c05d80c");
+
+    // Delta cycle 2 against key cycle 1: temperature +7, pressure -5
+    private static readonly byte[] DeltaFrame = Convert.FromHexString("010200000000220001010e0309");
+
+    private static readonly IReadOnlyDictionary<byte, BleSensorSchemaEntry> Schema =
+        BleSensorPayloadDecoder.DefaultSchema;
+
+    private static readonly DateTime Start = new(2026, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+
+    #region TryParse Tests
+
+    [Fact]
+    public void TryParse_KeyFrame_ReturnsBatteryAndChannels()
+    {
+        // Act
+        var result = BeaconFrameDecoder.TryParse(KeyFrame, out var frame);
+
+        // Assert
+        result.Should().BeTrue();
+        frame!.FrameType.Should().Be(BeaconFrameDecoder.FrameKey);
+        frame.Cycle.Should().Be(1);
+        frame.BatteryMv.Should().Be(3300);
+        frame.Channels.Should().Equal(
+            new BeaconChannel(1, 2153),
+            new BeaconChannel(2, 4520),
+            new BeaconChannel(3, 101325),
+            new BeaconChannel(5, 812));
+    }
+
+    [Fact]
+    public void TryParse_DeltaFrame_ReturnsSignedDeltas()
+    {
+        // Act
+        var result = BeaconFrameDecoder.TryParse(DeltaFrame, out var frame);
+
+        // Assert
+        result.Should().BeTrue();
+        frame!.FrameType.Should().Be(BeaconFrameDecoder.FrameDelta);
+        frame.KeyCycle.Should().Be(1);
+        frame.Channels.Should().Equal(new BeaconChannel(1, 7), new BeaconChannel(3, -5));
+    }
+
+    [Fact]
+    public void TryParse_GpsFrame_ReturnsPosition()
+    {
+        // Arrange - 52.52, 13.405, 35 m, 7 satellites
+        var data = Convert.FromHexString("0102000000003180ea4d1fd070fd07230007");
+
+        // Act
+        var result = BeaconFrameDecoder.TryParse(data, out var frame);
+
+        // Assert
+        result.Should().BeTrue();
+        frame!.Gps!.Latitude.Should().BeApproximately(52.52, 1e-7);
+        frame.Gps.Longitude.Should().BeApproximately(13.405, 1e-7);
+        frame.Gps.Altitude.Should().Be(35);
+        frame.Gps.Satellites.Should().Be(7);
+    }
+
+    [Fact]
+    public void TryParse_LegacyVersion_ReturnsFalse()
+    {
+        // Arrange
+        var data = (byte[])KeyFrame.Clone();
+        data[1] = 0x01;
+
+        // Act & Assert
+        BeaconFrameDecoder.TryParse(data, out _).Should().BeFalse();
+    }
+
+    [Fact]
+    public void TryParse_TruncatedVarint_ReturnsFalse()
+    {
+        // Arrange - continuation bit set on the last byte
+        var data = Convert.FromHexString("0102000000001100e40c01d2");
+
+        // Act & Assert
+        BeaconFrameDecoder.TryParse(data, out _).Should().BeFalse();
+    }
+
+    #endregion
+
+    #region BeaconChannelTracker Tests
+
+    [Fact]
+    public void Apply_KeyThenDelta_ReturnsAbsoluteValues()
+    {
+        // Arrange
+        var tracker = new BeaconChannelTracker();
+        BeaconFrameDecoder.TryParse(KeyFrame, out var key);
+        BeaconFrameDecoder.TryParse(DeltaFrame, out var delta);
+
+        // Act
+        var keyReadings = tracker.Apply(key!, Schema, Start);
+        var deltaReadings = tracker.Apply(delta!, Schema, Start.AddSeconds(10));
+
+        // Assert
+        keyReadings.Should().HaveCount(4);
+        keyReadings[0].Should().Be(new BleSensorReadingValue("temperature", 21.53, "°C"));
+        deltaReadings.Should().HaveCount(2);
+        deltaReadings[0].Type.Should().Be("temperature");
+        deltaReadings[0].Value.Should().BeApproximately(21.60, 0.0001);
+        deltaReadings[1].Value.Should().BeApproximately(1013.20, 0.0001);
+    }
+
+    [Fact]
+    public void Apply_RepeatedFrameInSameCycle_ReportsOnce()
+    {
+        // Arrange
+        var tracker = new BeaconChannelTracker();
+        BeaconFrameDecoder.TryParse(KeyFrame, out var key);
+        tracker.Apply(key!, Schema, Start);
+
+        // Act
+        var repeated = tracker.Apply(key!, Schema, Start.AddSeconds(2));
+
+        // Assert
+        repeated.Should().BeEmpty();
+    }
+
+    [Fact]
+    public void Apply_DeltaWithoutKey_IsIgnored()
+    {
+        // Arrange
+        var tracker = new BeaconChannelTracker();
+        BeaconFrameDecoder.TryParse(DeltaFrame, out var delta);
+
+        // Act & Assert
+        tracker.Apply(delta!, Schema, Start).Should().BeEmpty();
+    }
+
+    [Fact]
+    public void Apply_SameCycleAfterWrap_ReportsAgain()
+    {
+        // Arrange: 10 s cycles, then the node is out of range for 16 cycles
+        var tracker = new BeaconChannelTracker();
+        BeaconFrameDecoder.TryParse(KeyFrame, out var key);
+        BeaconFrameDecoder.TryParse(DeltaFrame, out var delta);
+        tracker.Apply(key!, Schema, Start);
+        tracker.Apply(delta!, Schema, Start.AddSeconds(10));
+
+        // Act: cycle 1 again, one wrap later
+        var wrapped = tracker.Apply(key!, Schema, Start.AddSeconds(170));
+
+        // Assert
+        tracker.CyclePeriod.Should().Be(TimeSpan.FromSeconds(10));
+        wrapped.Should().HaveCount(4);
+    }
+
+    [Fact]
+    public void Apply_DeltaAgainstKeyFromEarlierWrap_IsIgnored()
+    {
+        // Arrange
+        var tracker = new BeaconChannelTracker();
+        BeaconFrameDecoder.TryParse(KeyFrame, out var key);
+        BeaconFrameDecoder.TryParse(DeltaFrame, out var delta);
+        tracker.Apply(key!, Schema, Start);
+        tracker.Apply(delta!, Schema, Start.AddSeconds(10)).Should().HaveCount(2);
+
+        // Act: key cycle 1 of this wrap was missed, its delta must not resolve against the old key
+        var stale = tracker.Apply(delta!, Schema, Start.AddSeconds(170));
+
+        // Assert
+        stale.Should().BeEmpty();
+    }
+
+    #endregion
+}
@@ -0,0 +1,105 @@
+using FluentAssertions;
+using myIoTGrid.Hub.Service.Helpers;
+
+namespace myIoTGrid.Hub.Service.Tests.Helpers;
+
+/// <summary>
+/// Tests for BleHistoryDecoder helper class.
+/// </summary>
+public class BleHistoryDecoderTests
+{
+    #region BuildReadRequest Tests
+
+    [Fact]
+    public void BuildReadRequest_EncodesCursorLittleEndian()
+    {
+        // Act
+        var request = BleHistoryDecoder.BuildReadRequest(0x01020304, 8);
+
+        // Assert
+        request.Should().Equal(0x01, 0x04, 0x03, 0x02, 0x01, 0x08);
+    }
+
+    #endregion
+
+    #region TryParseBatch Tests
+
+    [Fact]
+    public void TryParseBatch_TwoSamples_ReturnsSequencedSamples()
+    {
+        // Arrange - first sequence 952, now 9999 s, temperature 2153 at 100 s, pressure 101325 at 100 s
+        var data = Convert.FromHexString(
+            "0100b80300000f270000" +
+            "016400000069080000" +
+            "0364000000cd8b0100");
+
+        // Act
+        var result = BleHistoryDecoder.TryParseBatch(data, out var batch);
+
+        // Assert
+        result.Should().BeTrue();
+        batch!.FirstSequence.Should().Be(952);
+        batch.NowSeconds.Should().Be(9999);
+        batch.Last.Should().BeFalse();
+        batch.Samples.Should().Equal(
+            new BleHistorySample(952, 1, 100, 2153),
+            new BleHistorySample(953, 3, 100, 101325));
+        batch.NextSequence.Should().Be(954);
+    }
+
+    [Fact]
+    public void TryParseBatch_EmptyLastBatch_ReturnsNoSamples()
+    {
+        // Arrange - caught up: header only, last flag set
+        var data = Convert.FromHexString("01010a000000e8030000");
+
+        // Act
+        var result = BleHistoryDecoder.TryParseBatch(data, out var batch);
+
+        // Assert
+        result.Should().BeTrue();
+        batch!.Last.Should().BeTrue();
+        batch.Samples.Should().BeEmpty();
+        batch.NextSequence.Should().Be(10);
+    }
+
+    [Fact]
+    public void TryParseBatch_PartialSample_ReturnsFalse()
+    {
+        // Arrange - header plus 4 bytes
+        var data = Convert.FromHexString("01010a000000e803000001640000");
+
+        // Act & Assert
+        BleHistoryDecoder.TryParseBatch(data, out _).Should().BeFalse();
+    }
+
+    [Fact]
+    public void TryParseBatch_UnknownVersion_ReturnsFalse()
+    {
+        // Arrange
+        var data = Convert.FromHexString("02010a000000e8030000");
+
+        // Act & Assert
+        BleHistoryDecoder.TryParseBatch(data, out _).Should().BeFalse();
+    }
+
+    #endregion
+
+    #region ToTimestamp Tests
+
+    [Fact]
+    public void ToTimestamp_SampleAge_IsSubtractedFromReceiveTime()
+    {
+        // Arrange
+        var receivedAt = new DateTimeOffset(2025, 1, 1, 12, 0, 0, TimeSpan.Zero);
+        var sample = new BleHistorySample(0, 1, 400, 2153);
+
+        // Act
+        var timestamp = BleHistoryDecoder.ToTimestamp(sample, 1000, receivedAt);
+
+        // Assert
+        timestamp.Should().Be(receivedAt.AddMinutes(-10));
+    }
+
+    #endregion
+}
@@ -0,0 +1,82 @@
+using FluentAssertions;
+using myIoTGrid.Hub.Service.Helpers;
+
+namespace myIoTGrid.Hub.Service.Tests.Helpers;
+
+/// <summary>
+/// Tests for BleReadingDeduplicator helper class.
+/// </summary>
+public class BleReadingDeduplicatorTests
+{
+    private const string NodeId = "myIoTGrid-92CC";
+
+    private static readonly DateTimeOffset Start = new(2026, 1, 1, 0, 0, 0, TimeSpan.Zero);
+
+    private static CreateSensorReadingDto Reading(string type, double value, DateTimeOffset at)
+        => new(NodeId, type, value, "°C", at.ToUnixTimeMilliseconds());
+
+    [Fact]
+    public void FilterHistory_SampleStoredLive_IsStoredOnce()
+    {
+        // Arrange: advertised 5 s after it was published
+        var deduplicator = new BleReadingDeduplicator();
+        deduplicator.TryAddLive(Reading("temperature", 21.53, Start.AddSeconds(5))).Should().BeTrue();
+
+        // Act: history stamps the sample at its publish time (1 s truncation)
+        var history = new[]
+        {
+            Reading("temperature", 21.40, Start.AddSeconds(-60)),
+            Reading("temperature", 21.53, Start.AddSeconds(-1)),
+            Reading("temperature", 21.60, Start.AddSeconds(60))
+        };
+        var kept = deduplicator.FilterHistory(NodeId, history, Start.AddSeconds(90));
+
+        // Assert
+        kept.Select(r => r.Value).Should().Equal(21.40, 21.60);
+    }
+
+    [Fact]
+    public void TryAddLive_SamplePulledBefore_IsStoredOnce()
+    {
+        // Arrange: pulled while the cycle was still advertised
+        var deduplicator = new BleReadingDeduplicator();
+        var kept = deduplicator.FilterHistory(NodeId,
+            new[] { Reading("temperature", 21.53, Start) }, Start.AddSeconds(3));
+
+        // Act
+        var stored = deduplicator.TryAddLive(Reading("temperature", 21.53, Start.AddSeconds(2)));
+
+        // Assert
+        kept.Should().HaveCount(1);
+        stored.Should().BeFalse();
+    }
+
+    [Fact]
+    public void FilterHistory_LiveValueOfOtherCycle_KeepsSample()
+    {
+        // Arrange: the live reading belongs to the newer cycle with another value
+        var deduplicator = new BleReadingDeduplicator();
+        deduplicator.TryAddLive(Reading("temperature", 21.53, Start.AddSeconds(65)));
+
+        // Act
+        var kept = deduplicator.FilterHistory(NodeId, new[]
+        {
+            Reading("temperature", 21.53, Start),
+            Reading("temperature", 21.60, Start.AddSeconds(60))
+        }, Start.AddSeconds(90));
+
+        // Assert
+        kept.Should().HaveCount(2);
+    }
+
+    [Fact]
+    public void TryAddLive_PullOlderThanReading_IsStored()
+    {
+        // Arrange: the same value, but the pull ended before this cycle
+        var deduplicator = new BleReadingDeduplicator();
+        deduplicator.FilterHistory(NodeId, new[] { Reading("temperature", 21.53, Start) }, Start.AddSeconds(10));
+
+        // Act & Assert
+        deduplicator.TryAddLive(Reading("temperature", 21.53, Start.AddSeconds(70))).Should().BeTrue();
+    }
+}
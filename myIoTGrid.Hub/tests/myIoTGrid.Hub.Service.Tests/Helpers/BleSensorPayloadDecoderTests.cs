@@ -0,0 +1,199 @@
+using FluentAssertions;
+using myIoTGrid.Hub.Service.Helpers;
+
+namespace myIoTGrid.Hub.Service.Tests.Helpers;
+
+/// <summary>
+/// Tests for BleSensorPayloadDecoder and BleFragmentAssembler helper classes.
+/// </summary>
+public class BleSensorPayloadDecoderTests
+{
+    private static readonly IReadOnlyDictionary<byte, BleSensorSchemaEntry> Schema =
+        new Dictionary<byte, BleSensorSchemaEntry>
+        {
+            [1] = new("temperature", "°C", 2),
+            [3] = new("pressure", "hPa", 2)
+        };
+
+    #region TryParseSchema Tests
+
+    [Fact]
+    public void TryParseSchema_ValidDescriptor_ReturnsEntries()
+    {
+        // Arrange - version 1, one entry: id 2, 2 decimals, "humidity", "%"
+        var data = new List<byte> { 0x01, 0x01, 0x02, 0x02, 0x08 };
+        data.AddRange("humidity"u8.ToArray());
+        data.Add(0x01);
+        data.Add((byte)'%');
+
+        // Act
+        var result = BleSensorPayloadDecoder.TryParseSchema(data.ToArray(), out var schema);
+
+        // Assert
+        result.Should().BeTrue();
+        schema![2].Should().Be(new BleSensorSchemaEntry("humidity", "%", 2));
+    }
+
+    [Fact]
+    public void TryParseSchema_TruncatedEntry_ReturnsFalse()
+    {
+        // Arrange - entry announces 8 type bytes but only 3 follow
+        var data = new byte[] { 0x01, 0x01, 0x02, 0x02, 0x08, (byte)'h', (byte)'u', (byte)'m' };
+
+        // Act & Assert
+        BleSensorPayloadDecoder.TryParseSchema(data, out _).Should().BeFalse();
+    }
+
+    [Fact]
+    public void TryParseSchema_UnknownVersion_ReturnsFalse()
+    {
+        // Act & Assert
+        BleSensorPayloadDecoder.TryParseSchema(new byte[] { 0x02, 0x00 }, out _).Should().BeFalse();
+    }
+
+    #endregion
+
+    #region TryDecode Tests
+
+    [Fact]
+    public void TryDecode_ScaledReadings_ReturnsValuesWithSchemaUnits()
+    {
+        // Arrange - timestamp 123456, temperature 2153 (i16), pressure 101325 (i32)
+        var message = new byte[]
+        {
+            0x01, 0x04, 0x40, 0xE2, 0x01, 0x00,
+            0x02, 0x03, 0x01, 0x69, 0x08,
+            0x02, 0x05, 0x03, 0xCD, 0x8B, 0x01, 0x00
+        };
+
+        // Act
+        var result = BleSensorPayloadDecoder.TryDecode(message, Schema, out var payload);
+
+        // Assert
+        result.Should().BeTrue();
+        payload!.Timestamp.Should().Be(123456);
+        payload.Sensors.Should().HaveCount(2);
+        payload.Sensors[0].Type.Should().Be("temperature");
+        payload.Sensors[0].Value.Should().BeApproximately(21.53, 0.0001);
+        payload.Sensors[0].Unit.Should().Be("°C");
+        payload.Sensors[1].Value.Should().BeApproximately(1013.25, 0.0001);
+    }
+
+    [Fact]
+    public void TryDecode_NamedReading_UsesInlineTypeAndUnit()
+    {
+        // Arrange - 2 decimals, 150, "foo", "bar"
+        var message = new byte[]
+        {
+            0x03, 0x0C, 0x02, 0x96, 0x00, 0x00, 0x00, 0x03,
+            (byte)'f', (byte)'o', (byte)'o', (byte)'b', (byte)'a', (byte)'r'
+        };
+
+        // Act
+        var result = BleSensorPayloadDecoder.TryDecode(message, Schema, out var payload);
+
+        // Assert
+        result.Should().BeTrue();
+        payload!.Sensors.Should().ContainSingle();
+        payload.Sensors[0].Type.Should().Be("foo");
+        payload.Sensors[0].Value.Should().BeApproximately(1.5, 0.0001);
+        payload.Sensors[0].Unit.Should().Be("bar");
+    }
+
+    [Fact]
+    public void TryDecode_GpsRecord_ReturnsFixedPointPosition()
+    {
+        // Arrange - 52.52, 13.405, 34.5 m, 1.2, 90.0, 7 satellites
+        var message = new byte[]
+        {
+            0x04, 0x11, 0x80, 0xEA, 0x4D, 0x1F, 0xD0, 0x70, 0xFD, 0x07,
+            0x7A, 0x0D, 0x00, 0x00, 0x78, 0x00, 0x28, 0x23, 0x07
+        };
+
+        // Act
+        var result = BleSensorPayloadDecoder.TryDecode(message, Schema, out var payload);
+
+        // Assert
+        result.Should().BeTrue();
+        payload!.Gps!.Latitude.Should().BeApproximately(52.52, 1e-7);
+        payload.Gps.Longitude.Should().BeApproximately(13.405, 1e-7);
+        payload.Gps.Altitude.Should().BeApproximately(34.5, 0.001);
+        payload.Gps.Satellites.Should().Be(7);
+    }
+
+    [Fact]
+    public void TryDecode_UnknownTagAndTypeId_AreSkipped()
+    {
+        // Arrange - tag 0x7F with 2 bytes, then reading with type id 9 (not in schema)
+        var message = new byte[] { 0x7F, 0x02, 0xAA, 0xBB, 0x02, 0x03, 0x09, 0x01, 0x00 };
+
+        // Act
+        var result = BleSensorPayloadDecoder.TryDecode(message, Schema, out var payload);
+
+        // Assert
+        result.Should().BeTrue();
+        payload!.Sensors.Should().BeEmpty();
+    }
+
+    [Fact]
+    public void TryDecode_TruncatedRecord_ReturnsFalse()
+    {
+        // Arrange - reading announces 5 bytes, only 3 present
+        var message = new byte[] { 0x02, 0x05, 0x01, 0x69, 0x08 };
+
+        // Act & Assert
+        BleSensorPayloadDecoder.TryDecode(message, Schema, out _).Should().BeFalse();
+    }
+
+    #endregion
+
+    #region BleFragmentAssembler Tests
+
+    [Fact]
+    public void TryAdd_TwoFragments_ReturnsConcatenatedMessage()
+    {
+        // Arrange
+        var assembler = new BleFragmentAssembler();
+
+        // Act
+        var first = assembler.TryAdd(new byte[] { 0x01, 0x05, 0x00, 0xAA, 0xBB }, out _);
+        var last = assembler.TryAdd(new byte[] { 0x01, 0x05, 0x81, 0xCC }, out var message);
+
+        // Assert
+        first.Should().BeFalse();
+        last.Should().BeTrue();
+        message.Should().Equal(0xAA, 0xBB, 0xCC);
+    }
+
+    [Fact]
+    public void TryAdd_MissingFragment_DropsMessage()
+    {
+        // Arrange
+        var assembler = new BleFragmentAssembler();
+        assembler.TryAdd(new byte[] { 0x01, 0x05, 0x00, 0xAA }, out _);
+
+        // Act - fragment 1 lost, last fragment is index 2
+        var result = assembler.TryAdd(new byte[] { 0x01, 0x05, 0x82, 0xCC }, out var message);
+
+        // Assert
+        result.Should().BeFalse();
+        message.Should().BeNull();
+    }
+
+    [Fact]
+    public void TryAdd_NewSequenceAfterLoss_Recovers()
+    {
+        // Arrange
+        var assembler = new BleFragmentAssembler();
+        assembler.TryAdd(new byte[] { 0x01, 0x05, 0x00, 0xAA }, out _);
+
+        // Act
+        var result = assembler.TryAdd(new byte[] { 0x01, 0x06, 0x80, 0xDD }, out var message);
+
+        // Assert
+        result.Should().BeTrue();
+        message.Should().Equal(0xDD);
+    }
+
+    #endregion
+}
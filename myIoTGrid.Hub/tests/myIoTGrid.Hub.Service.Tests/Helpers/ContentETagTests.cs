@@ -0,0 +1,57 @@
+using FluentAssertions;
+using myIoTGrid.Hub.Service.Helpers;
+
+namespace myIoTGrid.Hub.Service.Tests.Helpers;
+
+/// <summary>
+/// Tests for ContentETag helper class.
+/// </summary>
+public class ContentETagTests
+{
+    private sealed record Sample(string Name, int Interval);
+
+    #region Compute Tests
+
+    [Fact]
+    public void Compute_SameContent_ReturnsSameQuotedTag()
+    {
+        // Act
+        var first = ContentETag.Compute(new Sample("bme280", 60));
+        var second = ContentETag.Compute(new Sample("bme280", 60));
+
+        // Assert
+        first.Should().Be(second);
+        first.Should().MatchRegex("^\"[0-9a-f]{16}\"$");
+    }
+
+    [Fact]
+    public void Compute_ChangedContent_ReturnsDifferentTag()
+    {
+        // Act
+        var first = ContentETag.Compute(new Sample("bme280", 60));
+        var second = ContentETag.Compute(new Sample("bme280", 30));
+
+        // Assert
+        first.Should().NotBe(second);
+    }
+
+    #endregion
+
+    #region Matches Tests
+
+    [Theory]
+    [InlineData("\"abc\"", true)]
+    [InlineData("W/\"abc\"", true)]
+    [InlineData("\"xyz\", \"abc\"", true)]
+    [InlineData("*", true)]
+    [InlineData("\"xyz\"", false)]
+    [InlineData("", false)]
+    [InlineData(null, false)]
+    public void Matches_IfNoneMatchHeader_ComparesTags(string? ifNoneMatch, bool expected)
+    {
+        // Act & Assert
+        ContentETag.Matches(ifNoneMatch, "\"abc\"").Should().Be(expected);
+    }
+
+    #endregion
+}
@@ -0,0 +1,143 @@
+using System.Buffers.Binary;
+using System.Text;
+using FluentAssertions;
+using myIoTGrid.Hub.Service.Helpers;
+
+namespace myIoTGrid.Hub.Service.Tests.Helpers;
+
+/// <summary>
+/// Tests for SerialLogChunkDecoder helper class.
+/// </summary>
+public class SerialLogChunkDecoderTests
+{
+    private static byte[] RawLines(params string[] lines)
+    {
+        var raw = new List<byte>();
+        foreach (var line in lines)
+        {
+            var bytes = Encoding.UTF8.GetBytes(line);
+            raw.Add((byte)bytes.Length);
+            raw.Add((byte)(bytes.Length >> 8));
+            raw.AddRange(bytes);
+        }
+        return raw.ToArray();
+    }
+
+    private static byte[] BuildChunk(uint sequence, ushort lineCount, byte flags, int rawLength, byte[] payload)
+    {
+        var chunk = new byte[SerialLogChunkDecoder.HeaderSize + payload.Length];
+        "MLG1"u8.CopyTo(chunk);
+        BinaryPrimitives.WriteUInt32LittleEndian(chunk.AsSpan(4), sequence);
+        BinaryPrimitives.WriteUInt32LittleEndian(chunk.AsSpan(8), 123456);
+        BinaryPrimitives.WriteUInt32LittleEndian(chunk.AsSpan(12), 7);
+        BinaryPrimitives.WriteUInt16LittleEndian(chunk.AsSpan(16), lineCount);
+        chunk[18] = flags;
+        BinaryPrimitives.WriteUInt32LittleEndian(chunk.AsSpan(20), (uint)rawLength);
+        BinaryPrimitives.WriteUInt32LittleEndian(chunk.AsSpan(24), (uint)payload.Length);
+        payload.CopyTo(chunk, SerialLogChunkDecoder.HeaderSize);
+        return chunk;
+    }
+
+    #region TryDecode Tests
+
+    [Fact]
+    public void TryDecode_StoredChunk_ReturnsLinesAndHeader()
+    {
+        // Arrange
+        var raw = RawLines("[Sensor] BME280 ok", "[API] 200");
+        var data = BuildChunk(42, 2, 0, raw.Length, raw);
+
+        // Act
+        var result = SerialLogChunkDecoder.TryDecode(data, out var chunk);
+
+        // Assert
+        result.Should().BeTrue();
+        chunk!.Sequence.Should().Be(42);
+        chunk.NodeTimestamp.Should().Be(123456);
+        chunk.DroppedLines.Should().Be(7);
+        chunk.Lines.Should().Equal("[Sensor] BME280 ok", "[API] 200");
+    }
+
+    [Fact]
+    public void TryDecode_Lz4Chunk_ReturnsDecompressedLines()
+    {
+        // Arrange - raw is [12, 0] "abababababab": 4 literals, match (offset 2, length 5), 5 last literals
+        var raw = RawLines("abababababab");
+        var payload = new byte[] { 0x41, 0x0C, 0x00, (byte)'a', (byte)'b', 0x02, 0x00,
+                                   0x50, (byte)'b', (byte)'a', (byte)'b', (byte)'a', (byte)'b' };
+        var data = BuildChunk(1, 1, SerialLogChunkDecoder.FlagLz4, raw.Length, payload);
+
+        // Act
+        var result = SerialLogChunkDecoder.TryDecode(data, out var chunk);
+
+        // Assert
+        result.Should().BeTrue();
+        chunk!.Lines.Should().Equal("abababababab");
+    }
+
+    [Fact]
+    public void TryDecode_InvalidMagic_ReturnsFalse()
+    {
+        // Arrange
+        var raw = RawLines("line");
+        var data = BuildChunk(1, 1, 0, raw.Length, raw);
+        data[0] = (byte)'X';
+
+        // Act & Assert
+        SerialLogChunkDecoder.TryDecode(data, out _).Should().BeFalse();
+    }
+
+    [Fact]
+    public void TryDecode_TruncatedPayload_ReturnsFalse()
+    {
+        // Arrange
+        var raw = RawLines("line");
+        var data = BuildChunk(1, 1, 0, raw.Length, raw);
+
+        // Act & Assert
+        SerialLogChunkDecoder.TryDecode(data.AsSpan(0, data.Length - 1), out _).Should().BeFalse();
+    }
+
+    [Fact]
+    public void TryDecode_LineCountExceedsPayload_ReturnsFalse()
+    {
+        // Arrange
+        var raw = RawLines("line");
+        var data = BuildChunk(1, 2, 0, raw.Length, raw);
+
+        // Act & Assert
+        SerialLogChunkDecoder.TryDecode(data, out _).Should().BeFalse();
+    }
+
+    #endregion
+
+    #region TryDecompressLz4Block Tests
+
+    [Fact]
+    public void TryDecompressLz4Block_OffsetBeforeStart_ReturnsFalse()
+    {
+        // Arrange - match offset 5 with only 1 byte decoded
+        var input = new byte[] { 0x10, (byte)'a', 0x05, 0x00, 0x10, (byte)'b' };
+        var output = new byte[10];
+
+        // Act & Assert
+        SerialLogChunkDecoder.TryDecompressLz4Block(input, output).Should().BeFalse();
+    }
+
+    [Fact]
+    public void TryDecompressLz4Block_LiteralsOnly_CopiesInput()
+    {
+        // Arrange
+        var input = new byte[] { 0x30, (byte)'a', (byte)'b', (byte)'c' };
+        var output = new byte[3];
+
+        // Act
+        var result = SerialLogChunkDecoder.TryDecompressLz4Block(input, output);
+
+        // Assert
+        result.Should().BeTrue();
+        Encoding.ASCII.GetString(output).Should().Be("abc");
+    }
+
+    #endregion
+}
@@ -0,0 +1,57 @@
+using FluentAssertions;
+using myIoTGrid.Hub.Service.Services;
+
+namespace myIoTGrid.Hub.Service.Tests.Services;
+
+/// <summary>
+/// Tests for NodeChangeNotifier.
+/// </summary>
+public class NodeChangeNotifierTests
+{
+    private readonly NodeChangeNotifier _sut = new();
+
+    #region WhenChanged / NotifyChanged Tests
+
+    [Fact]
+    public void WhenChanged_WithoutNotification_IsPending()
+    {
+        // Act
+        var changed = _sut.WhenChanged(Guid.NewGuid());
+
+        // Assert
+        changed.IsCompleted.Should().BeFalse();
+    }
+
+    [Fact]
+    public async Task NotifyChanged_CompletesWaitersOfThatNodeOnly()
+    {
+        // Arrange
+        var nodeId = Guid.NewGuid();
+        var changed = _sut.WhenChanged(nodeId);
+        var other = _sut.WhenChanged(Guid.NewGuid());
+
+        // Act
+        _sut.NotifyChanged(nodeId);
+
+        // Assert
+        await changed.WaitAsync(TimeSpan.FromSeconds(1));
+        other.IsCompleted.Should().BeFalse();
+    }
+
+    [Fact]
+    public void WhenChanged_AfterNotification_WaitsForNextChange()
+    {
+        // Arrange
+        var nodeId = Guid.NewGuid();
+        _sut.WhenChanged(nodeId);
+        _sut.NotifyChanged(nodeId);
+
+        // Act
+        var next = _sut.WhenChanged(nodeId);
+
+        // Assert
+        next.IsCompleted.Should().BeFalse();
+    }
+
+    #endregion
+}
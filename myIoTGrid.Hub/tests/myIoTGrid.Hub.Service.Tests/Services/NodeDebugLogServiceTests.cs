@@ -14,6 +14,7 @@ public class NodeDebugLogServiceTests : IDisposable
 {
     private readonly HubDbContext _context;
     private readonly Mock<ISignalRNotificationService> _signalRMock;
+    private readonly Mock<INodeChangeNotifier> _changeNotifierMock;
     private readonly Mock<ILogger<NodeDebugLogService>> _loggerMock;
     private readonly NodeDebugLogService _sut;
 
@@ -30,9 +31,10 @@ public class NodeDebugLogServiceTests : IDisposable
 
         _context = new HubDbContext(options);
         _signalRMock = new Mock<ISignalRNotificationService>();
+        _changeNotifierMock = new Mock<INodeChangeNotifier>();
         _loggerMock = new Mock<ILogger<NodeDebugLogService>>();
 
-        _sut = new NodeDebugLogService(_context, _signalRMock.Object, _loggerMock.Object);
+        _sut = new NodeDebugLogService(_context, _signalRMock.Object, _changeNotifierMock.Object, _loggerMock.Object);
 
         SeedTestData();
     }
@@ -403,6 +405,19 @@ public class NodeDebugLogServiceTests : IDisposable
             Times.Once);
     }
 
+    [Fact]
+    public async Task SetDebugLevelAsync_NotifiesNodeChange()
+    {
+        // Arrange
+        var dto = new SetNodeDebugLevelDto(DebugLevelDto.Debug, true);
+
+        // Act
+        await _sut.SetDebugLevelAsync(_nodeId, dto);
+
+        // Assert
+        _changeNotifierMock.Verify(n => n.NotifyChanged(_nodeId), Times.Once);
+    }
+
     [Fact]
     public async Task SetDebugLevelBySerialAsync_UpdatesNode()
     {
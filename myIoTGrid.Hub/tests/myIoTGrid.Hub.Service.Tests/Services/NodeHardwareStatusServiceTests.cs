@@ -350,6 +350,157 @@ public class NodeHardwareStatusServiceTests : IDisposable
         updatedNode!.LastSyncError.Should().Be("Connection timeout");
     }
 
+    [Fact]
+    public async Task ReportHardwareStatusAsync_WithTiming_ReturnsTiming()
+    {
+        // Arrange
+        var nodeId = Guid.NewGuid();
+        var macAddress = "AA:BB:CC:DD:EE:06";
+        var node = new Node
+        {
+            Id = nodeId,
+            HubId = _hubId,
+            NodeId = "timing-test-001",
+            Name = "Timing Node",
+            MacAddress = macAddress,
+            IsOnline = true,
+            CreatedAt = DateTime.UtcNow
+        };
+        _context.Nodes.Add(node);
+        await _context.SaveChangesAsync();
+
+        var timing = new TimingReportDto(
+            WindowMs: 900000,
+            Stages: new List<TimingStageDto>
+            {
+                new("loop", 90000, 45000000, 31000, 255, 1023, 16383, new List<long> { 0, 0, 10, 89000, 990 }),
+                new("sensor.BME280", 15, 120000, 9000, 8191, 8191, 8191, new List<long> { 0, 0, 0, 0, 15 })
+            },
+            Counters: new Dictionary<string, long> { ["http.errors"] = 2 }
+        );
+        var dto = CreateReportHardwareStatusDto(macAddress, timing: timing);
+
+        // Act
+        var result = await _service.ReportHardwareStatusAsync(dto);
+
+        // Assert
+        result!.Timing.Should().NotBeNull();
+        result.Timing!.WindowMs.Should().Be(900000);
+        result.Timing.Stages.Should().HaveCount(2);
+        result.Timing.Stages[1].Name.Should().Be("sensor.BME280");
+        result.Timing.Stages[0].Buckets.Should().Equal(0, 0, 10, 89000, 990);
+        result.Timing.Counters["http.errors"].Should().Be(2);
+    }
+
+    [Fact]
+    public async Task ReportHardwareStatusAsync_WithStalls_ReturnsStalls()
+    {
+        // Arrange
+        var macAddress = "AA:BB:CC:DD:EE:08";
+        var node = new Node
+        {
+            Id = Guid.NewGuid(),
+            HubId = _hubId,
+            NodeId = "stall-test-001",
+            Name = "Stalling Node",
+            MacAddress = macAddress,
+            IsOnline = true,
+            CreatedAt = DateTime.UtcNow
+        };
+        _context.Nodes.Add(node);
+        await _context.SaveChangesAsync();
+
+        var stalls = new StallReportDto(
+            ThresholdMs: 1000,
+            StallCount: 3,
+            Worst: new List<LoopStallDto>
+            {
+                new(30012, 125000, "http.request", new List<string> { "0x400d2f11", "0x400d1a4c" }),
+                new(1450, 61000, "sensor.batch > sensor.DS18B20", new List<string>())
+            }
+        );
+        var dto = CreateReportHardwareStatusDto(macAddress, stalls: stalls);
+
+        // Act
+        var result = await _service.ReportHardwareStatusAsync(dto);
+
+        // Assert
+        result!.Stalls.Should().NotBeNull();
+        result.Stalls!.StallCount.Should().Be(3);
+        result.Stalls.Worst.Should().HaveCount(2);
+        result.Stalls.Worst[0].DurationMs.Should().Be(30012);
+        result.Stalls.Worst[0].Backtrace.Should().Equal("0x400d2f11", "0x400d1a4c");
+        result.Stalls.Worst[1].Stage.Should().Be("sensor.batch > sensor.DS18B20");
+    }
+
+    [Fact]
+    public async Task ReportHardwareStatusAsync_WithoutTiming_ReturnsNullTiming()
+    {
+        // Arrange
+        var macAddress = "AA:BB:CC:DD:EE:07";
+        var node = new Node
+        {
+            Id = Guid.NewGuid(),
+            HubId = _hubId,
+            NodeId = "timing-test-002",
+            Name = "Node Without Timing",
+            MacAddress = macAddress,
+            IsOnline = true,
+            CreatedAt = DateTime.UtcNow
+        };
+        _context.Nodes.Add(node);
+        await _context.SaveChangesAsync();
+
+        // Act
+        var result = await _service.ReportHardwareStatusAsync(CreateReportHardwareStatusDto(macAddress));
+
+        // Assert
+        result!.Timing.Should().BeNull();
+        result.Stalls.Should().BeNull();
+        result.Memory.Should().BeNull();
+    }
+
+    [Fact]
+    public async Task ReportHardwareStatusAsync_AfterHeartbeatMemory_KeepsMemory()
+    {
+        // Arrange
+        var macAddress = "AA:BB:CC:DD:EE:09";
+        var memory = new MemoryReportDto(
+            UptimeMs: 120000,
+            Capabilities: new List<HeapCapabilityDto>
+            {
+                new("8bit", 300000, 90000, 60000, 80000, 33)
+            },
+            Trend: new HeapTrendDto(60000, new List<long> { 90000 }, new List<long> { 60000 }, new List<long> { 80000 }),
+            FailedAllocs: 0,
+            LastFailedBytes: 0,
+            LastFailedCaps: 0,
+            Tags: new List<MemoryTagDto> { new("http.request", 12, 4096, 4096) }
+        );
+        var node = new Node
+        {
+            Id = Guid.NewGuid(),
+            HubId = _hubId,
+            NodeId = "memory-test-001",
+            Name = "Node With Memory",
+            MacAddress = macAddress,
+            IsOnline = true,
+            CreatedAt = DateTime.UtcNow,
+            HardwareStatusJson = NodeHardwareStatusService.WithMemoryReport(null, memory)
+        };
+        _context.Nodes.Add(node);
+        await _context.SaveChangesAsync();
+
+        // Act
+        var result = await _service.ReportHardwareStatusAsync(CreateReportHardwareStatusDto(macAddress));
+
+        // Assert
+        result!.DetectedDevices.Should().NotBeNull();
+        result.Memory.Should().NotBeNull();
+        result.Memory!.Capabilities[0].LargestFree.Should().Be(60000);
+        result.Memory.Tags.Should().ContainSingle(t => t.Name == "http.request" && t.NetBytes == 4096);
+    }
+
     #endregion
 
     #region GetHardwareStatusAsync Tests
@@ -701,7 +852,9 @@ public class NodeHardwareStatusServiceTests : IDisposable
         string firmwareVersion = "1.0.0",
         StorageStatusDto? storage = null,
         List<DetectedDeviceDto>? devices = null,
-        BusStatusDto? busStatus = null)
+        BusStatusDto? busStatus = null,
+        TimingReportDto? timing = null,
+        StallReportDto? stalls = null)
     {
         var defaultStorage = new StorageStatusDto(
             Available: false,
@@ -743,7 +896,9 @@ public class NodeHardwareStatusServiceTests : IDisposable
             HardwareType: "ESP32",
             DetectedDevices: devices ?? defaultDevices,
             Storage: storage ?? defaultStorage,
-            BusStatus: busStatus ?? defaultBusStatus
+            BusStatus: busStatus ?? defaultBusStatus,
+            Timing: timing,
+            Stalls: stalls
         );
     }
 
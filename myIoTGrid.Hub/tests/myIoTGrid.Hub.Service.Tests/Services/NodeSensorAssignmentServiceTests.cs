@@ -15,6 +15,7 @@ public class NodeSensorAssignmentServiceTests : IDisposable
     private readonly Infrastructure.Data.HubDbContext _context;
     private readonly NodeSensorAssignmentService _sut;
     private readonly Mock<IEffectiveConfigService> _effectiveConfigMock;
+    private readonly Mock<INodeChangeNotifier> _changeNotifierMock;
     private readonly Mock<ILogger<NodeSensorAssignmentService>> _loggerMock;
     private readonly UnitOfWork _unitOfWork;
     private readonly Guid _tenantId = Guid.Parse("00000000-0000-0000-0000-000000000001");
@@ -26,6 +27,7 @@ public class NodeSensorAssignmentServiceTests : IDisposable
     {
         _context = TestDbContextFactory.Create();
         _effectiveConfigMock = new Mock<IEffectiveConfigService>();
+        _changeNotifierMock = new Mock<INodeChangeNotifier>();
         _loggerMock = new Mock<ILogger<NodeSensorAssignmentService>>();
         _unitOfWork = new UnitOfWork(_context);
 
@@ -76,7 +78,7 @@ public class NodeSensorAssignmentServiceTests : IDisposable
 
         _context.SaveChanges();
 
-        _sut = new NodeSensorAssignmentService(_context, _unitOfWork, _effectiveConfigMock.Object, _loggerMock.Object);
+        _sut = new NodeSensorAssignmentService(_context, _unitOfWork, _effectiveConfigMock.Object, _changeNotifierMock.Object, _loggerMock.Object);
     }
 
     public void Dispose()
@@ -399,6 +401,22 @@ public class NodeSensorAssignmentServiceTests : IDisposable
         result.IsActive.Should().BeTrue();
     }
 
+    [Fact]
+    public async Task CreateAsync_WithValidData_NotifiesNodeChange()
+    {
+        // Arrange
+        var dto = new CreateNodeSensorAssignmentDto(
+            SensorId: _sensorId,
+            EndpointId: 1
+        );
+
+        // Act
+        await _sut.CreateAsync(_nodeId, dto);
+
+        // Assert
+        _changeNotifierMock.Verify(n => n.NotifyChanged(_nodeId), Times.Once);
+    }
+
     [Fact]
     public async Task CreateAsync_WithNonExistingNode_ThrowsException()
     {
@@ -1213,6 +1213,50 @@ public class NodeServiceTests : IDisposable
         node.BatteryLevel.Should().Be(75);
     }
 
+    [Fact]
+    public async Task ProcessHeartbeatAsync_WithMemory_StoresMemoryReport()
+    {
+        // Arrange
+        var nodeId = Guid.NewGuid();
+        _context.Nodes.Add(new Node
+        {
+            Id = nodeId,
+            HubId = _hubId,
+            NodeId = "memory-node",
+            Name = "Memory Node",
+            CreatedAt = DateTime.UtcNow
+        });
+        await _context.SaveChangesAsync();
+
+        var memory = new MemoryReportDto(
+            UptimeMs: 3600000,
+            Capabilities: new List<HeapCapabilityDto>
+            {
+                new("internal", 295000, 41000, 12000, 23000, 71)
+            },
+            Trend: new HeapTrendDto(60000, new List<long> { 52000, 41000 },
+                new List<long> { 31000, 12000 }, new List<long> { 40000, 23000 }),
+            FailedAllocs: 1,
+            LastFailedBytes: 16717,
+            LastFailedCaps: 0x1800
+        );
+        var dto = new NodeHeartbeatDto(NodeId: "memory-node", Memory: memory);
+
+        // Act
+        var result = await _sut.ProcessHeartbeatAsync(dto);
+
+        // Assert
+        result.Success.Should().BeTrue();
+        var hardwareStatusService = new NodeHardwareStatusService(
+            _context, new Mock<ILogger<NodeHardwareStatusService>>().Object);
+        var status = await hardwareStatusService.GetHardwareStatusAsync(nodeId);
+        status!.Memory.Should().NotBeNull();
+        status.Memory!.Capabilities.Should().ContainSingle(c => c.Name == "internal" && c.Fragmentation == 71);
+        status.Memory.Trend.LargestFree.Should().Equal(31000, 12000);
+        status.Memory.FailedAllocs.Should().Be(1);
+        status.Memory.Tags.Should().BeNull();
+    }
+
     [Fact]
     public async Task ProcessHeartbeatAsync_WithUnknownNode_ReturnsFailure()
     {
@@ -14,6 +14,7 @@ where the .NET InTheHand.BluetoothLE library doesn't work properly.
 import asyncio
 import json
 import ssl
+import struct
 import aiohttp
 from bleak import BleakClient, BleakScanner
 from datetime import datetime
@@ -26,6 +27,15 @@ VERIFY_SSL = False  # Set to True in production
 SERVICE_UUID = "12345678-1234-5678-1234-56789abcdef0"
 SENSOR_DATA_UUID = "12345678-1234-5678-1234-56789abcdef1"
 DEVICE_INFO_UUID = "12345678-1234-5678-1234-56789abcdef2"
+SCHEMA_UUID = "12345678-1234-5678-1234-56789abcdef3"
+
+# Binary payload (must match ESP32 ble_sensor_payload.h)
+PAYLOAD_VERSION = 1
+FRAGMENT_LAST = 0x80
+TAG_TIMESTAMP = 0x01
+TAG_READING = 0x02
+TAG_NAMED = 0x03
+TAG_GPS = 0x04
 
 # Device name prefixes to scan for
 DEVICE_PREFIXES = ["myIoTGrid-", "ESP32-"]
@@ -60,13 +70,96 @@ async def send_to_hub(session: aiohttp.ClientSession, data: dict):
         print(f"  -> Error sending to Hub: {e}")
 
 
-def notification_handler(session: aiohttp.ClientSession, loop: asyncio.AbstractEventLoop):
-    """Create a notification handler for BLE sensor data"""
+def parse_schema(data: bytes) -> dict:
+    """Parse the schema characteristic into {typeId: (type, unit, decimals)}"""
+    if len(data) < 2 or data[0] != PAYLOAD_VERSION:
+        raise ValueError(f"unsupported schema version {data[0] if data else None}")
+
+    schema = {}
+    pos = 2
+    for _ in range(data[1]):
+        type_id, decimals, type_len = data[pos], data[pos + 1], data[pos + 2]
+        pos += 3
+        type_name = data[pos:pos + type_len].decode("utf-8")
+        pos += type_len
+        unit_len = data[pos]
+        pos += 1
+        unit = data[pos:pos + unit_len].decode("utf-8")
+        pos += unit_len
+        schema[type_id] = (type_name, unit, decimals)
+    return schema
+
+
+def decode_payload(payload: bytes, schema: dict, node_id: str) -> dict:
+    """Decode a reassembled TLV message into the bridge's reading dict"""
+    result = {"nodeId": node_id, "sensors": []}
+    pos = 0
+    while pos + 2 <= len(payload):
+        tag, length = payload[pos], payload[pos + 1]
+        value = payload[pos + 2:pos + 2 + length]
+        pos += 2 + length
+        if len(value) != length:
+            raise ValueError("truncated record")
+
+        if tag == TAG_TIMESTAMP:
+            result["timestamp"] = struct.unpack("<I", value)[0]
+        elif tag == TAG_READING:
+            type_id = value[0]
+            scaled = int.from_bytes(value[1:], "little", signed=True)
+            if type_id not in schema:
+                print(f"[BLE] Unknown type id {type_id} - schema out of date?")
+                continue
+            type_name, unit, decimals = schema[type_id]
+            result["sensors"].append({"type": type_name, "value": scaled / 10 ** decimals, "unit": unit})
+        elif tag == TAG_NAMED:
+            decimals = value[0]
+            scaled = struct.unpack("<i", value[1:5])[0]
+            type_len = value[5]
+            type_name = value[6:6 + type_len].decode("utf-8")
+            unit = value[6 + type_len:].decode("utf-8")
+            result["sensors"].append({"type": type_name, "value": scaled / 10 ** decimals, "unit": unit})
+        elif tag == TAG_GPS:
+            lat, lon, alt, speed, course, sats = struct.unpack("<iiiHHB", value)
+            result["gps"] = {
+                "latitude": lat / 1e7,
+                "longitude": lon / 1e7,
+                "altitude": alt / 100,
+                "speed": speed / 100,
+                "course": course / 100,
+                "satellites": sats,
+            }
+        # Unknown tags are skipped for forward compatibility
+    return result
+
+
+def notification_handler(session: aiohttp.ClientSession, loop: asyncio.AbstractEventLoop,
+                         schema: dict, node_id: str):
+    """Create a notification handler that reassembles and decodes binary sensor data"""
+    fragments = {"sequence": None, "next": 0, "data": bytearray()}
+
     def handler(sender, data: bytearray):
         try:
-            json_str = data.decode('utf-8')
-            sensor_data = json.loads(json_str)
-            print(f"\n[BLE] Received sensor data from {sensor_data.get('nodeId', 'unknown')}")
+            if len(data) < 3 or data[0] != PAYLOAD_VERSION:
+                print(f"[BLE] Unsupported payload version: {data[:1].hex()}")
+                return
+
+            sequence, index = data[1], data[2] & ~FRAGMENT_LAST
+            if index == 0:
+                fragments.update(sequence=sequence, next=0, data=bytearray())
+            if sequence != fragments["sequence"] or index != fragments["next"]:
+                print(f"[BLE] Lost fragment of message {sequence}, dropping it")
+                fragments["sequence"] = None
+                return
+
+            fragments["data"] += data[3:]
+            fragments["next"] += 1
+            if not data[2] & FRAGMENT_LAST:
+                return
+
+            sensor_data = decode_payload(bytes(fragments["data"]), schema, node_id)
+            fragments["sequence"] = None
+            print(f"\n[BLE] Received sensor data from {node_id} "
+                  f"({len(sensor_data['sensors'])} readings, {fragments['next']} fragment(s))")
 
             # Schedule the async send on the event loop
             asyncio.run_coroutine_threadsafe(
@@ -75,7 +168,7 @@ def notification_handler(session: aiohttp.ClientSession, loop: asyncio.AbstractE
             )
         except Exception as e:
             print(f"[BLE] Error parsing data: {e}")
-            print(f"[BLE] Raw data: {data}")
+            print(f"[BLE] Raw data: {data.hex()}")
 
     return handler
 
@@ -105,16 +198,26 @@ async def connect_and_subscribe(device, session: aiohttp.ClientSession):
         print(f"[BLE] Found myIoTGrid service")
 
         # Read device info
+        node_id = device.name
         try:
             device_info_data = await client.read_gatt_char(DEVICE_INFO_UUID)
             device_info = json.loads(device_info_data.decode('utf-8'))
+            node_id = device_info.get("nodeId", node_id)
             print(f"[BLE] Device Info: {device_info}")
         except Exception as e:
             print(f"[BLE] Could not read device info: {e}")
 
+        # Read payload schema (type id -> type, unit, decimals)
+        try:
+            schema = parse_schema(bytes(await client.read_gatt_char(SCHEMA_UUID)))
+            print(f"[BLE] Payload schema: {len(schema)} types")
+        except Exception as e:
+            print(f"[BLE] Could not read payload schema: {e}")
+            return
+
         # Subscribe to sensor data notifications
         print(f"[BLE] Subscribing to sensor data notifications...")
-        handler = notification_handler(session, loop)
+        handler = notification_handler(session, loop, schema, node_id)
         await client.start_notify(SENSOR_DATA_UUID, handler)
 
         print(f"[BLE] Listening for sensor data... (Press Ctrl+C to stop)")
@@ -0,0 +1,165 @@
+/**
+ * myIoTGrid.Sensor - ADS1115 Continuous Scanner
+ *
+ * Runs an ADS1115 in continuous-conversion mode and round-robins the
+ * enabled single-ended channels in a background task:
+ *
+ *   select channel -> discard first result -> average N conversions -> next
+ *
+ * The ALERT/RDY pin is configured as conversion-ready output and wakes the
+ * task from an interrupt, so no time is spent polling the I2C bus. Without
+ * an ALERT/RDY pin the task sleeps for one conversion period instead.
+ *
+ * Readers only copy the last averaged value per channel and never touch
+ * the bus, so reading all four channels costs no conversion latency.
+ * Gain (PGA) and data rate are configured per channel.
+ */
+
+#ifndef ADS1115_SCANNER_H
+#define ADS1115_SCANNER_H
+
+#include <Arduino.h>
+
+#ifdef PLATFORM_ESP32
+#include <Adafruit_ADS1X15.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+
+#define ADS1115_CHANNEL_COUNT 4
+
+/**
+ * Last averaged value of one channel
+ */
+struct ADS1115ChannelValue {
+    bool valid;
+    float voltage;            // Mean voltage of the last window
+    int16_t raw;              // Mean raw counts of the last window
+    uint16_t samples;         // Conversions averaged
+    unsigned long timestamp;  // millis() when the window completed
+};
+
+/**
+ * Background multi-channel scanner for one ADS1115
+ */
+class ADS1115Scanner {
+public:
+    /**
+     * @param ads Initialized driver (must outlive the scanner)
+     * @param busId I2C bus of the device (locked per transaction)
+     * @param alertPin GPIO wired to ALERT/RDY (-1 = timed wait)
+     */
+    ADS1115Scanner(Adafruit_ADS1115* ads, int busId, int alertPin);
+    ~ADS1115Scanner();
+
+    // Prevent copying
+    ADS1115Scanner(const ADS1115Scanner&) = delete;
+    ADS1115Scanner& operator=(const ADS1115Scanner&) = delete;
+
+    /**
+     * Enable a channel (or update its settings); takes effect on the next pass
+     * @param channel Single-ended channel 0-3
+     * @param gain PGA gain (see gainFromConfig)
+     * @param dataRateSps Data rate in samples per second (see dataRateFromConfig)
+     */
+    void configureChannel(int channel, adsGain_t gain, uint16_t dataRateSps);
+
+    /**
+     * Disable every channel not in a mask (after a reconfiguration)
+     * @param channelMask Bit n set = keep channel n
+     */
+    void retainChannels(uint8_t channelMask);
+
+    /**
+     * Start the scan task (no-op if running or no channel is enabled)
+     * @return true if scanning
+     */
+    bool start();
+
+    /**
+     * Stop the scan task and leave the device in single-shot mode
+     */
+    void stop();
+
+    bool isRunning() const { return _task != nullptr; }
+
+    /**
+     * Check if a channel is part of the scan
+     */
+    bool isChannelEnabled(int channel) const;
+
+    /**
+     * Get the last averaged value of a channel
+     * @return false if the channel has no value yet
+     */
+    bool getChannel(int channel, ADS1115ChannelValue& out) const;
+
+    /**
+     * Get number of completed channel windows (all channels)
+     */
+    uint32_t getWindowCount() const { return _windowCount; }
+
+    /**
+     * Get number of conversions that did not signal ready in time
+     */
+    uint32_t getTimeoutCount() const { return _timeoutCount; }
+
+    /**
+     * Map a Hub gain value (2/3, 1, 2, 4, 8, 16; <= 0 = default) to the nearest PGA setting
+     */
+    static adsGain_t gainFromConfig(double gain);
+
+    /**
+     * Map a Hub data rate (SPS; <= 0 = default) to the nearest supported rate at or above it
+     */
+    static uint16_t dataRateFromConfig(int sps);
+
+private:
+    struct Channel {
+        bool enabled;
+        adsGain_t gain;
+        uint16_t dataRateSps;
+    };
+
+    Adafruit_ADS1115* _ads;
+    int _busId;
+    int _alertPin;
+
+    Channel _channels[ADS1115_CHANNEL_COUNT];
+    ADS1115ChannelValue _values[ADS1115_CHANNEL_COUNT];
+    mutable portMUX_TYPE _mux;
+
+    TaskHandle_t _task;
+    volatile bool _stopRequested;
+    volatile uint32_t _windowCount;
+    volatile uint32_t _timeoutCount;
+
+    static void taskEntry(void* param);
+    static void IRAM_ATTR onAlert(void* arg);
+
+    void run();
+
+    /**
+     * Next enabled channel after `current` (-1 = first), -1 if none
+     */
+    int nextChannel(int current) const;
+
+    /**
+     * Apply a channel's MUX/PGA/rate and (re)start continuous conversion
+     */
+    bool selectChannel(int channel, const Channel& settings);
+
+    /**
+     * Wait for the next conversion-ready edge (or one conversion period)
+     */
+    bool waitForConversion(uint16_t dataRateSps);
+
+    /**
+     * Read the conversion register under the bus lock
+     */
+    bool readConversion(int16_t& raw);
+};
+
+#endif // PLATFORM_ESP32
+
+#endif // ADS1115_SCANNER_H
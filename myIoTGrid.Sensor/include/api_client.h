@@ -18,17 +18,25 @@ struct ApiResponse {
     String body;
     bool success;
     String error;
+    String etag;        // ETag response header (conditional GETs only)
 
     ApiResponse() : statusCode(0), success(false) {}
 };
 
 /**
  * Heartbeat response from Hub
+ * Doubles as control-plane sync: newer Hubs also return the configuration
+ * version, debug settings and server time
  */
 struct HeartbeatResponse {
     bool success;
     unsigned long serverTime;
     int nextHeartbeatSeconds;
+    long unixTimestamp;         // Server time (0 = not provided)
+    bool configChanged;         // Configuration version differs from the applied one (or unknown)
+    bool hasDebugConfig;        // debugLevel/enableRemoteLogging were provided
+    int debugLevel;             // 0=Production, 1=Normal, 2=Debug
+    bool enableRemoteLogging;
 };
 
 /**
@@ -54,6 +62,10 @@ struct SensorCapabilityConfig {
     String measurementType;
     String displayName;
     String unit;
+    // ADC settings (ADS1115): -1 / 0 = use defaults
+    int adcChannel;
+    double adcGain;
+    int adcDataRate;
 };
 
 /**
@@ -92,7 +104,6 @@ struct NodeConfigurationResponse {
     bool isSimulation;
     int defaultIntervalSeconds;
     std::vector<SensorAssignmentConfig> sensors;
-    unsigned long configurationTimestamp;
     String error;
     // Sprint OS-01: Offline Storage
     int storageMode;  // 0=RemoteOnly, 1=LocalAndRemote, 2=LocalOnly, 3=LocalAutoSync
@@ -107,9 +118,20 @@ struct DebugConfigurationResponse {
     int debugLevel;           // 0=Production, 1=Normal, 2=Debug
     bool enableRemoteLogging;
     String lastDebugChange;
+    bool notModified;         // 304: settings unchanged since the last fetch, fields not filled
     String error;
 };
 
+/**
+ * Result of a conditional configuration fetch
+ */
+enum class ConfigFetchResult {
+    FAILED,         // Request or parse failed, config untouched
+    NOT_MODIFIED,   // 304 - ETag matched, nothing downloaded
+    UNCHANGED,      // 200 but identical to the current config
+    UPDATED         // Config was changed in place
+};
+
 /**
  * Time response from Hub (for offline time sync)
  */
@@ -147,8 +169,11 @@ public:
 
     /**
      * Send heartbeat to Hub
+     * The response tells whether fetchConfiguration() is needed (configChanged)
+     * @param memoryJson Optional memory telemetry object (MemoryTelemetry::toJson())
      */
-    HeartbeatResponse sendHeartbeat(const String& firmwareVersion = "", int batteryLevel = -1);
+    HeartbeatResponse sendHeartbeat(const String& firmwareVersion = "", int batteryLevel = -1,
+                                    const String& memoryJson = "");
 
     /**
      * Send sensor reading to Hub
@@ -165,10 +190,20 @@ public:
     bool sendReadings(const String& readingsJson);
 
     /**
-     * Fetch sensor configuration for this node
-     * Returns assigned sensors with their pin configurations
+     * Fetch sensor configuration for this node into config
+     * Sends the ETag of the last applied configuration (If-None-Match); on 304
+     * nothing is parsed. On 200 the response is diffed against config and only
+     * differing fields and sensors are written, so existing Strings are reused.
+     */
+    ConfigFetchResult fetchConfiguration(const String& serialNumber, NodeConfigurationResponse& config);
+
+    /**
+     * Check a configuration version (ETag from heartbeat or control channel)
+     * against the last applied configuration
      */
-    NodeConfigurationResponse fetchConfiguration(const String& serialNumber);
+    bool isConfigurationCurrent(const char* version) const {
+        return version[0] != '\0' && _configEtag == version;
+    }
 
     /**
      * Send hardware status report to Hub (Sprint 8)
@@ -179,6 +214,8 @@ public:
      * @param detectedDevices JSON array of detected devices
      * @param storageJson Storage status JSON object
      * @param busStatusJson Bus status JSON object
+     * @param timingJson Hot-path timing JSON object (Instrumentation::toJson), omitted if empty
+     * @param stallsJson Loop stall JSON object (StallMonitor::toJson), omitted if empty
      * @return true if report was sent successfully
      */
     bool sendHardwareStatus(const String& serialNumber,
@@ -186,11 +223,14 @@ public:
                             const String& hardwareType,
                             const String& detectedDevicesJson,
                             const String& storageJson,
-                            const String& busStatusJson);
+                            const String& busStatusJson,
+                            const String& timingJson = "",
+                            const String& stallsJson = "");
 
     /**
      * Fetch debug configuration from Hub (Sprint 8: Remote Debug System)
      * Gets debug level and remote logging settings for this node
+     * Conditional like fetchConfiguration(): notModified is set on 304
      * @param serialNumber Node serial number (MAC address)
      * @return Debug configuration response
      */
@@ -229,11 +269,14 @@ private:
     String _apiKey;
     int _timeout;
     bool _configured;
+    String _configEtag;     // ETag of the last applied configuration
+    String _debugEtag;      // ETag of the last applied debug configuration
 
     /**
      * Make HTTP GET request
+     * @param ifNoneMatch ETag for a conditional request (nullptr/empty = unconditional)
      */
-    ApiResponse httpGet(const String& path);
+    ApiResponse httpGet(const String& path, const char* ifNoneMatch = nullptr);
 
     /**
      * Make HTTP POST request
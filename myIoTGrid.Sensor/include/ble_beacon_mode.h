@@ -12,6 +12,7 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "ble_history.h"
 #include <functional>
 
 #ifdef PLATFORM_ESP32
@@ -24,6 +25,7 @@ constexpr const char* CONFIG_SERVICE_UUID = "4d494f54-4752-4944-434f-4e464947000
 constexpr const char* CONFIG_WRITE_CHAR_UUID = "4d494f54-4752-4944-434f-4e4649470001"; // Hub writes config
 constexpr const char* CONFIG_READ_CHAR_UUID = "4d494f54-4752-4944-434f-4e4649470002";  // Hub reads device info
 constexpr const char* SENSOR_DATA_CHAR_UUID = "4d494f54-4752-4944-434f-4e4649470003";  // Hub reads sensor data
+constexpr const char* HISTORY_CHAR_UUID = "4d494f54-4752-4944-434f-4e4649470004";      // Hub bulk-reads history (ble_history.h)
 
 // Config command types
 constexpr uint8_t CMD_AUTH = 0x00;          // Authenticate Hub (send node ID hash)
@@ -42,25 +44,40 @@ constexpr uint8_t RESP_INVALID_DATA = 0x03;
 constexpr uint8_t RESP_NOT_AUTHENTICATED = 0x04;  // Hub must authenticate first
 
 /**
- * Sensor data structure for beacon transmission
- * Packed into BLE manufacturer data (max ~25 bytes in advertising packet)
+ * Beacon manufacturer data frames (little-endian)
+ *
+ * Header (9 bytes):
+ *   u16 companyId | u8 deviceType | u8 version | u8 nodeIdHash[4] |
+ *   u8 frame (type << 4 | cycle & 0x0F)
+ * Bodies:
+ *   KEY   u8 flags | u16 battery mV | channels (u8 typeId | zigzag varint value)
+ *   DELTA u8 flags | u8 key cycle   | channels (u8 typeId | zigzag varint value - key value)
+ *   GPS   i32 lat*1e7 | i32 lon*1e7 | i16 altitude m | u8 satellites
+ *
+ * Channel ids and decimal scales are the BLE payload type table
+ * (ble_sensor_payload.h), one channel per measurement type. A cycle starts
+ * with every publishReadings() call; every KEYFRAME_INTERVAL cycles the
+ * channels are sent absolute, in between as deltas against that key cycle.
+ * Channels that do not fit one frame continue in the next; the frames of a
+ * cycle are rotated in the advertising data at the rotation interval.
  */
-struct __attribute__((packed)) BeaconSensorData {
-    uint16_t companyId;      // 0xFFFF = test/development
-    uint8_t  deviceType;     // 0x01 = myIoTGrid sensor
-    uint8_t  version;        // Protocol version (1)
-    uint8_t  nodeIdHash[4];  // First 4 bytes of node ID hash
-    int16_t  temperature;    // Temperature * 100 (e.g., 2150 = 21.50°C)
-    uint16_t humidity;       // Humidity * 100 (e.g., 6500 = 65.00%)
-    uint16_t pressure;       // Pressure - 50000 (e.g., 51325 = 101325 hPa)
-    uint16_t battery;        // Battery mV (e.g., 3300 = 3.3V)
-    uint8_t  flags;          // Bit flags for additional info
-};
 
 // Company ID for manufacturer data (0xFFFF = reserved for testing)
 constexpr uint16_t MYIOTGRID_COMPANY_ID = 0xFFFF;
 constexpr uint8_t  MYIOTGRID_DEVICE_TYPE = 0x01;
-constexpr uint8_t  BEACON_PROTOCOL_VERSION = 0x01;
+constexpr uint8_t  BEACON_PROTOCOL_VERSION = 0x02;
+
+// Frame types (high nibble of the frame byte)
+constexpr uint8_t BEACON_FRAME_KEY = 0x1;
+constexpr uint8_t BEACON_FRAME_DELTA = 0x2;
+constexpr uint8_t BEACON_FRAME_GPS = 0x3;
+constexpr size_t BEACON_FRAME_HEADER_SIZE = 9;
+
+#if defined(PLATFORM_ESP32) && CONFIG_BT_NIMBLE_EXT_ADV
+constexpr size_t BEACON_FRAME_CAPACITY = config::ble_beacon::EXT_FRAME_SIZE;
+#else
+constexpr size_t BEACON_FRAME_CAPACITY = config::ble_beacon::LEGACY_FRAME_SIZE;
+#endif
 
 // Flags
 constexpr uint8_t FLAG_HAS_GPS = 0x01;
@@ -87,17 +104,40 @@ public:
     ~BleBeaconMode();
 
     /**
-     * Initialize hybrid mode (beacon + GATT)
+     * Initialize hybrid mode (beacon + GATT) and allocate the history ring
      * @param nodeId Node identifier for hashing
      * @return true if successful
      */
     bool init(const String& nodeId);
 
     /**
-     * Update sensor values and restart advertising with new data
-     * Call this periodically (e.g., every 60 seconds) with new readings
+     * Set the latest value of a measurement type
+     * latitude/longitude/altitude/satellites feed the GPS frame; types
+     * without a payload type id are not broadcast.
+     * @return true if the reading will be broadcast
+     */
+    bool setReading(const String& type, float value, const String& unit);
+
+    /**
+     * Start a new cycle with the readings set so far and restart rotation
+     * Call this after each sensor poll
+     */
+    void publishReadings(uint16_t batteryMv);
+
+    /**
+     * Set how long each frame stays in the advertising data
      */
-    void updateSensorData(float temperature, float humidity, float pressure, uint16_t batteryMv);
+    void setFrameRotationInterval(uint32_t intervalMs) { _rotationIntervalMs = intervalMs; }
+
+    /**
+     * Get number of frames in the current cycle
+     */
+    size_t getFrameCount() const { return _frameCount; }
+
+    /**
+     * Get number of samples in the history ring
+     */
+    size_t getHistorySize() const { return _history.size(); }
 
     /**
      * Start advertising (both beacon data and GATT services)
@@ -105,7 +145,7 @@ public:
     void startAdvertising();
 
     /**
-     * Stop advertising and disconnect clients
+     * Stop advertising, disconnect clients and free the history ring
      */
     void stop();
 
@@ -198,23 +238,65 @@ private:
     String _nodeId;
     String _deviceName;
     uint8_t _nodeIdHash[4];
-    BeaconSensorData _sensorData;
+    uint8_t _flags;
+    uint16_t _batteryMv;
     ConfigReceivedCallback _configCallback;
 
+    struct Channel {
+        uint8_t typeId;
+        int32_t value;      // Scaled by the type's decimals
+        int32_t keyValue;   // Value sent in the last key cycle
+        bool hasKey;
+        bool hasValue;
+        bool updated;       // Set since the last publish (goes to history)
+    };
+    Channel _channels[config::ble_beacon::MAX_CHANNELS];
+    size_t _channelCount;
+
+    double _gpsLatitude;
+    double _gpsLongitude;
+    double _gpsAltitude;
+    uint8_t _gpsSatellites;
+    uint8_t _gpsFields;     // Bits: latitude, longitude set this cycle
+
+    uint8_t _frames[config::ble_beacon::MAX_FRAMES][BEACON_FRAME_CAPACITY];
+    uint8_t _frameLengths[config::ble_beacon::MAX_FRAMES];
+    size_t _frameCount;
+    size_t _frameIndex;
+    uint8_t _cycle;
+    uint8_t _keyCycle;
+    uint8_t _cyclesSinceKey;
+    uint32_t _rotationIntervalMs;
+    unsigned long _lastRotationMs;
+
+    ble_history::Ring _history;
+    uint32_t _historyCursor;
+    uint8_t _historyWindow;     // Batches left in the running READ
+    uint16_t _historyConnHandle;
+    uint16_t _historyMtu;
+    uint8_t _historyBatch[config::ble_beacon::HISTORY_MTU - 3];
+
 #ifdef PLATFORM_ESP32
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    NimBLEExtAdvertising* _pAdvertising;
+#else
     NimBLEAdvertising* _pAdvertising;
+#endif
     NimBLEServer* _pServer;
     NimBLEService* _pConfigService;
     NimBLECharacteristic* _pConfigWriteChar;
     NimBLECharacteristic* _pConfigReadChar;
     NimBLECharacteristic* _pSensorDataChar;
+    NimBLECharacteristic* _pHistoryChar;
 
     // Server callbacks
     class ServerCallbacks;
     class ConfigWriteCallbacks;
     class SecurityCallbacks;
+    class HistoryWriteCallbacks;
     friend class ServerCallbacks;
     friend class ConfigWriteCallbacks;
+    friend class HistoryWriteCallbacks;
     friend class SecurityCallbacks;
 #endif
 
@@ -222,9 +304,15 @@ private:
     void updateBondedFlag();
 
     void computeNodeIdHash(const String& nodeId);
+    void buildFrames();
+    size_t beginFrame(uint8_t type);
     void updateAdvertisingData();
+    void startRadio();
+    void stopRadio();
     void setupGattServices();
     void updateSensorDataCharacteristic();
+    void handleHistoryRequest(const uint8_t* data, size_t len, uint16_t connHandle, uint16_t mtu);
+    void streamHistory();
 };
 
 #endif // BLE_BEACON_MODE_H
@@ -0,0 +1,105 @@
+/**
+ * myIoTGrid.Sensor - BLE Reading History
+ *
+ * Store-and-forward buffer for beacon mode: every published reading is kept
+ * in a fixed ring of compact samples, so a Hub that missed advertisements can
+ * connect later and bulk-read what it did not see. The ring is allocated
+ * while beacon mode runs; other modes do not pay for it.
+ *
+ * Samples carry a sequence number (monotonic since boot). The Hub keeps the
+ * next sequence it wants as its cursor and writes a request (write without
+ * response) to the history characteristic:
+ *   u8 opcode | u32 cursor | u8 window
+ *   0x01 READ  stream up to `window` batch notifications starting at cursor
+ *   0x02 STOP  abort the running read
+ * The Hub paces the transfer by writing the next READ once a window arrived.
+ *
+ * Batch notification (little-endian):
+ *   u8 version | u8 flags | u32 first sequence | u32 node seconds now |
+ *   n x (u8 typeId | u32 node seconds | i32 scaled value)
+ * flags bit 0 = LAST: the batch ends at the newest sample. n fills the MTU.
+ * A cursor older than the oldest sample (overwritten) or newer than the
+ * newest (node rebooted) restarts at the oldest sample; the Hub sees this
+ * in the first sequence. Timestamps are node uptime seconds; the Hub places
+ * them relative to "seconds now" of the same batch.
+ */
+
+#ifndef BLE_HISTORY_H
+#define BLE_HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+namespace ble_history {
+
+constexpr uint8_t VERSION = 1;
+constexpr uint8_t OP_READ = 0x01;
+constexpr uint8_t OP_STOP = 0x02;
+constexpr size_t REQUEST_SIZE = 6;
+constexpr uint8_t BATCH_LAST = 0x01;
+constexpr size_t BATCH_HEADER_SIZE = 10;
+constexpr size_t SAMPLE_SIZE = 9;
+
+/**
+ * Fixed-capacity ring of samples; the oldest sample is overwritten when full
+ * Samples are stored in their wire layout (SAMPLE_SIZE bytes each).
+ */
+class Ring {
+public:
+    Ring() : _samples(nullptr), _head(0), _count(0), _nextSequence(0) {}
+    ~Ring();
+
+    // Prevent copying
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    /**
+     * Allocate the sample storage (capacity() * SAMPLE_SIZE bytes)
+     * @return false if out of memory
+     */
+    bool allocate();
+
+    /**
+     * Free the sample storage and forget all samples
+     */
+    void deallocate();
+
+    bool isAllocated() const { return _samples != nullptr; }
+
+    /**
+     * Append a sample (value scaled by the type's decimals)
+     * Dropped while not allocated.
+     */
+    void push(uint32_t seconds, uint8_t typeId, int32_t value);
+
+    /**
+     * Sequence of the oldest sample kept
+     */
+    uint32_t firstSequence() const { return _nextSequence - (uint32_t)_count; }
+
+    /**
+     * Sequence the next pushed sample will get
+     */
+    uint32_t nextSequence() const { return _nextSequence; }
+
+    size_t size() const { return _count; }
+    static constexpr size_t capacity() { return config::ble_beacon::HISTORY_CAPACITY; }
+
+    /**
+     * Encode one batch notification starting at cursor
+     * @param cursor In: next sequence wanted, out: sequence after the batch
+     * @return Encoded length, 0 if outCapacity cannot hold the header
+     */
+    size_t encodeBatch(uint32_t& cursor, uint32_t nowSeconds, uint8_t* out, size_t outCapacity) const;
+
+private:
+    uint8_t* _samples;          // capacity() x (u8 typeId | u32 seconds | i32 value)
+    size_t _head;               // Slot of the next push
+    size_t _count;
+    uint32_t _nextSequence;
+};
+
+} // namespace ble_history
+
+#endif // BLE_HISTORY_H
@@ -0,0 +1,101 @@
+/**
+ * myIoTGrid.Sensor - Binary BLE Sensor Payload
+ *
+ * Compact replacement for the JSON notification of BluetoothSensorMode.
+ *
+ * Message = sequence of TLV records (u8 tag | u8 length | value, little-endian):
+ *   0x01 TIMESTAMP  u32 node millis
+ *   0x02 READING    u8 typeId | i16 or i32 scaled value (length 3 or 5)
+ *   0x03 NAMED      u8 decimals | i32 scaled value | u8 typeLength | type | unit
+ *   0x04 GPS        i32 lat*1e7 | i32 lon*1e7 | i32 alt cm | u16 speed*100 |
+ *                   u16 course*100 | u8 satellites
+ * Unknown tags are skipped by their length, so records can be added without
+ * breaking older centrals.
+ *
+ * Scaled value = round(value * 10^decimals); typeId, type name, unit and
+ * decimals come from the schema table, which centrals read once from the
+ * schema characteristic:
+ *   u8 version | u8 count | count x (u8 typeId | u8 decimals |
+ *   u8 typeLength | type | u8 unitLength | unit)
+ *
+ * Each notification carries a 3 byte fragment header:
+ *   u8 version | u8 message sequence | u8 fragment index (bit 7 = last)
+ */
+
+#ifndef BLE_SENSOR_PAYLOAD_H
+#define BLE_SENSOR_PAYLOAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ble_payload {
+
+constexpr uint8_t VERSION = 1;
+constexpr size_t FRAGMENT_HEADER_SIZE = 3;
+constexpr uint8_t FRAGMENT_LAST = 0x80;
+constexpr uint8_t MAX_FRAGMENTS = 0x7F;
+
+enum RecordTag : uint8_t {
+    TAG_TIMESTAMP = 0x01,
+    TAG_READING = 0x02,
+    TAG_NAMED = 0x03,
+    TAG_GPS = 0x04
+};
+
+/**
+ * Schema entry for a known measurement type
+ */
+struct TypeInfo {
+    uint8_t id;
+    const char* type;
+    const char* unit;
+    uint8_t decimals;
+};
+
+/**
+ * Look up a measurement type by name and unit
+ * @return Schema entry or nullptr if the pair has no id
+ */
+const TypeInfo* findType(const char* type, const char* unit);
+
+/**
+ * Look up a measurement type by wire id
+ * @return Schema entry or nullptr for unknown ids
+ */
+const TypeInfo* typeById(uint8_t id);
+
+/**
+ * Encode the schema descriptor served by the schema characteristic
+ * @return Encoded length, 0 if the buffer is too small
+ */
+size_t encodeSchema(uint8_t* out, size_t capacity);
+
+/**
+ * Appends TLV records to a caller-owned buffer.
+ * Once a record does not fit, the writer stops and overflowed() is true.
+ */
+class Writer {
+public:
+    Writer(uint8_t* buffer, size_t capacity)
+        : _buffer(buffer), _capacity(capacity), _length(0), _overflow(false) {}
+
+    void addTimestamp(uint32_t millis);
+    void addReading(const char* type, float value, const char* unit);
+    void addGps(double latitude, double longitude, double altitude,
+                float speed, float course, int satellites);
+
+    size_t length() const { return _length; }
+    bool overflowed() const { return _overflow; }
+
+private:
+    uint8_t* _buffer;
+    size_t _capacity;
+    size_t _length;
+    bool _overflow;
+
+    uint8_t* reserve(uint8_t tag, size_t valueLength);
+};
+
+} // namespace ble_payload
+
+#endif // BLE_SENSOR_PAYLOAD_H
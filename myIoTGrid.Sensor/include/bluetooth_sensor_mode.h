@@ -13,6 +13,7 @@
 
 #include <Arduino.h>
 #include <functional>
+#include <vector>
 #include "config.h"
 
 #ifdef PLATFORM_ESP32
@@ -88,9 +89,11 @@ public:
 
     /**
      * Send sensor readings via BLE GATT notification
+     * Encodes the binary payload (ble_sensor_payload.h) and splits it into
+     * MTU-sized fragments.
      * @param readings Vector of sensor readings
      * @param gps Optional GPS data
-     * @return true if data was queued for transmission
+     * @return true if all fragments were queued for transmission
      */
     bool sendSensorData(const std::vector<BleSensorReading>& readings,
                         const BleGpsData* gps = nullptr);
@@ -125,6 +128,16 @@ public:
      */
     uint32_t getTransmissionCount() const { return _transmissionCount; }
 
+    /**
+     * Get size of the last encoded payload (before fragment headers)
+     */
+    size_t getLastPayloadSize() const { return _lastPayloadSize; }
+
+    /**
+     * Get negotiated ATT MTU of the current connection
+     */
+    uint16_t getMtu() const { return _mtu; }
+
     /**
      * Set callback for connection event
      */
@@ -156,6 +169,7 @@ private:
     NimBLEService* _service;
     NimBLECharacteristic* _sensorDataChar;
     NimBLECharacteristic* _deviceInfoChar;
+    NimBLECharacteristic* _schemaChar;
     NimBLEAdvertising* _advertising;
 #endif
 
@@ -168,16 +182,26 @@ private:
     String _deviceName;
     uint32_t _connectionCount;
     uint32_t _transmissionCount;
+    uint16_t _mtu;
+    uint8_t _messageSequence;
+    size_t _lastPayloadSize;
+    uint8_t _payload[config::ble_sensor::BLE_PAYLOAD_MAX_SIZE];
 
     OnBleConnected _onConnected;
     OnBleDisconnected _onDisconnected;
     OnBleTransmitComplete _onTransmitComplete;
 
     /**
-     * Build JSON payload for sensor data
+     * Encode readings into _payload
+     * @return Encoded length, 0 if the readings do not fit
+     */
+    size_t encodeSensorData(const std::vector<BleSensorReading>& readings,
+                            const BleGpsData* gps);
+
+    /**
+     * Notify the payload as fragments of at most MTU - 3 bytes
      */
-    String buildSensorDataJson(const std::vector<BleSensorReading>& readings,
-                               const BleGpsData* gps);
+    bool notifyFragments(size_t length);
 
     /**
      * Build device info JSON
@@ -193,6 +217,7 @@ private:
         ServerCallbacks(BluetoothSensorMode* parent) : _parent(parent) {}
         void onConnect(NimBLEServer* server, NimBLEConnInfo& connInfo) override;
         void onDisconnect(NimBLEServer* server, NimBLEConnInfo& connInfo, int reason) override;
+        void onMTUChange(uint16_t MTU, NimBLEConnInfo& connInfo) override;
     private:
         BluetoothSensorMode* _parent;
     };
@@ -43,6 +43,10 @@ constexpr uint32_t DEFAULT_INTERVAL_SECONDS = 60;
 constexpr uint32_t REGISTRATION_RETRY_DELAY_MS = 5000;
 constexpr uint32_t HTTP_TIMEOUT_MS = 15000;  // 15s timeout (reduced to prevent hangs)
 constexpr int HTTP_RETRY_COUNT = 3;
+constexpr uint32_t HTTP_RETRY_DELAY_MS = 1000;
+constexpr size_t HTTP_ASYNC_MAX_IN_FLIGHT = 8;       // Outstanding reading POSTs per connection
+constexpr size_t HTTP_ASYNC_QUEUE_SIZE = 64;         // Queued + in-flight readings, more are rejected
+constexpr uint32_t HTTP_COMPLETION_POLL_MS = 10;     // poll() interval while responses are outstanding
 constexpr int MAX_REGISTRATION_FAILURES = 3;  // After 3 failures, go to BLE pairing
 
 // Discovery Configuration
@@ -83,6 +87,140 @@ constexpr int SD_CS_PIN = 5;              // SD Card CS (GPIO5)
 constexpr int SYNC_BUTTON_GPIO = 4;       // Sync button (GPIO4)
 constexpr int SYNC_LED_GPIO = 2;          // Sync status LED (GPIO2 = onboard LED)
 
+// ============================================================================
+// I2C Bus Configuration
+// ============================================================================
+constexpr int I2C_DEFAULT_SDA_PIN = 21;             // Controller 0 default SDA
+constexpr int I2C_DEFAULT_SCL_PIN = 22;             // Controller 0 default SCL
+constexpr uint32_t I2C_DEFAULT_FREQUENCY_HZ = 100000;
+constexpr int I2C_MAX_BUSES = 4;                    // Pin pairs tracked (2 dedicated + shared)
+constexpr uint32_t I2C_BUS_TASK_STACK_SIZE = 4096;  // Per-controller batch worker
+constexpr uint32_t I2C_BUS_LOCK_TIMEOUT_MS = 1000;
+
+// Driver instances reserved per I2C sensor type (addresses x controllers)
+constexpr size_t SENSOR_DRIVER_POOL_SLOTS = 4;
+
+// ADS1115 continuous scanning (per-channel gain/rate come from the Hub)
+constexpr uint16_t ADS1115_DEFAULT_DATA_RATE_SPS = 128;
+constexpr uint16_t ADS1115_OVERSAMPLE = 8;          // Conversions averaged per channel window
+constexpr uint32_t ADS1115_MAX_SAMPLE_AGE_MS = 5000; // Older averages are reported as stale
+constexpr uint32_t ADS1115_SCAN_TASK_STACK_SIZE = 3072;
+
+// ============================================================================
+// Remote Serial Capture
+// ============================================================================
+constexpr size_t SERIAL_CAPTURE_BUFFER_SIZE = 8192;      // Byte ring for captured lines
+constexpr size_t SERIAL_CAPTURE_MAX_LINES = 256;         // Line index entries
+constexpr size_t SERIAL_CAPTURE_MAX_LINE_LENGTH = 512;   // Longer lines are truncated
+constexpr size_t DEBUG_UPLOAD_CHUNK_SIZE = 4096;         // Raw line bytes per uploaded chunk
+constexpr uint8_t DEBUG_UPLOAD_HASH_BITS = 11;           // LZ4 match table (2^n uint16 entries)
+
+// ============================================================================
+// Deferred Debug Logging
+// ============================================================================
+constexpr size_t DEBUG_DEFERRED_LOG_SLOTS = 32;          // Records waiting to be formatted
+constexpr size_t DEBUG_DEFERRED_LOG_MAX_ARGS = 8;        // Arguments per record
+constexpr size_t DEBUG_DEFERRED_LOG_STRING_BYTES = 64;   // Copied %s arguments per record
+
+// SD logger record ring and writer task
+constexpr size_t SD_LOG_POOL_SLOTS = 32;                 // Fixed log records (no heap per entry)
+constexpr size_t SD_LOG_RECORD_TEXT_SIZE = 192;          // Message + stack trace per record
+constexpr size_t SD_LOG_WRITE_BUFFER_SIZE = 2048;        // Lines collected per file write
+constexpr size_t SD_LOG_BATCH_THRESHOLD = 8;             // Pending records that wake the writer
+constexpr uint32_t SD_LOG_TASK_STACK_SIZE = 4096;
+
+// ============================================================================
+// Control Push Channel (long-poll on /api/nodes/{serial}/control)
+// ============================================================================
+constexpr int CONTROL_PUSH_WAIT_SECONDS = 55;            // Hub holds each request up to this long (Hub max 60 s, proxies 60 s)
+constexpr uint32_t CONTROL_PUSH_RETRY_DELAY_MS = 15000;  // Pause after a failed long-poll
+constexpr uint32_t CONTROL_PUSH_TASK_STACK_SIZE = 8192;  // HTTP(S) client + JSON parse
+// HTTPS: the long-poll is a second TLS session next to ApiClient's requests.
+// It is only opened while the internal heap holds both sessions.
+constexpr uint32_t CONTROL_PUSH_TLS_SESSION_BYTES = 45 * 1024;   // mbedTLS session incl. handshake peak
+constexpr uint32_t CONTROL_PUSH_TLS_MIN_BLOCK_BYTES = 20 * 1024; // 16 KB record buffer in one block
+
+// ============================================================================
+// MQTT Connection (lib/connection, ConnectionConfig.mode = "mqtt")
+// Topics: myiotgrid/n/{serial}/r (readings), /c (config push), /s (online state)
+// ============================================================================
+constexpr uint16_t MQTT_DEFAULT_PORT = 1883;
+constexpr const char* MQTT_TOPIC_PREFIX = "myiotgrid/n/";
+constexpr uint16_t MQTT_KEEPALIVE_SECONDS = 60;
+constexpr size_t MQTT_BATCH_SIZE = 8;                    // Readings per QoS 1 PUBLISH
+constexpr uint32_t MQTT_BATCH_MAX_DELAY_MS = 2000;       // Partial batches are sent after this
+constexpr size_t MQTT_OFFLINE_QUEUE_SIZE = 256;          // Readings kept while disconnected (oldest dropped)
+constexpr size_t MQTT_MAX_INFLIGHT = 4;                  // Unacknowledged batches
+constexpr uint32_t MQTT_ACK_TIMEOUT_MS = 10000;          // CONNACK/PUBACK/PINGRESP wait before reconnect
+constexpr uint32_t MQTT_RECONNECT_INTERVAL_MS = 5000;
+constexpr size_t MQTT_MAX_PACKET_SIZE = 8192;            // Larger incoming packets drop the connection
+constexpr uint32_t MQTT_POLL_INTERVAL_MS = 250;          // Socket check for pushed config while connected
+
+// ============================================================================
+// Native HTTP Transport (lib/hal_native, shared curl multi handle)
+// ============================================================================
+constexpr size_t HTTP_TRANSPORT_MAX_IN_FLIGHT = 64;      // Concurrent transfers, more are queued
+constexpr size_t HTTP_TRANSPORT_MAX_HOST_CONNECTIONS = 8; // HTTP/1.1 parallelism per host (h2 multiplexes)
+constexpr size_t HTTP_TRANSPORT_HEADER_CACHE_SIZE = 32;  // Distinct header sets kept as curl lists
+constexpr int HTTP_TRANSPORT_IDLE_POLL_MS = 1000;        // Transport thread wait without activity
+
+// ============================================================================
+// Controller Event Loop (lib/controller TimerWheel)
+// ============================================================================
+constexpr uint32_t CONTROLLER_TIMER_RESOLUTION_MS = 10;  // Width of one wheel slot
+constexpr size_t CONTROLLER_TIMER_SLOTS = 256;           // One revolution = 2.56s
+constexpr uint32_t CONTROLLER_IDLE_WAIT_MS = 1000;       // loop() sleep with no timer pending
+
+// ============================================================================
+// Fleet Simulator (native_fleet env: many NodeControllers in one process)
+// ============================================================================
+constexpr size_t FLEET_DEFAULT_NODES = 100;
+constexpr uint32_t FLEET_DEFAULT_RAMP_UP_SECONDS = 60;   // Node starts are spread over this period
+constexpr uint32_t FLEET_DEFAULT_REPORT_SECONDS = 10;
+constexpr const char* FLEET_DEFAULT_ID = "FLEET001";     // Serials: SIM-{id}-{index}
+
+// ============================================================================
+// Session Trace (record a device session, replay it on native; see session_trace.h)
+// ============================================================================
+constexpr uint32_t SESSION_REPLAY_END_GRACE_MS = 60000;  // Replay keeps running this long past the last event
+
+// ============================================================================
+// Hot-Path Instrumentation (per-stage timing histograms; see instrumentation.h)
+// ============================================================================
+constexpr size_t INSTRUMENT_MAX_STAGES = 24;          // Named stages incl. one per sensor driver
+constexpr size_t INSTRUMENT_MAX_COUNTERS = 12;
+constexpr size_t INSTRUMENT_NAME_LENGTH = 24;         // Incl. terminator; longer names are truncated
+constexpr size_t INSTRUMENT_HISTOGRAM_BUCKETS = 27;   // log2 buckets up to 2^26 us (67 s, above HTTP timeout)
+constexpr size_t INSTRUMENT_SERIAL_LINE_LENGTH = 64;  // Serial console command buffer
+
+// ============================================================================
+// Loop Stall Profiler (see stall_monitor.h)
+// ============================================================================
+constexpr uint32_t STALL_THRESHOLD_MS = 1000;          // Loop iterations longer than this are stalls
+constexpr uint32_t STALL_SAMPLE_INTERVAL_MS = 50;
+constexpr size_t STALL_WORST_COUNT = 8;                // Longest stalls kept since boot / "stalls reset"
+constexpr size_t STALL_STAGE_DEPTH = 4;                // Nested stages recorded per stall
+constexpr size_t STALL_BACKTRACE_DEPTH = 12;
+constexpr uint32_t STALL_MONITOR_TASK_STACK_SIZE = 3072;
+constexpr uint32_t STALL_MONITOR_TASK_PRIORITY = 20;   // Above every firmware task; same core as loop()
+
+// ============================================================================
+// Memory Telemetry (heap per capability; see memory_telemetry.h)
+// ============================================================================
+constexpr uint32_t MEMORY_SAMPLE_INTERVAL_MS = 60000;  // One trend sample per heartbeat interval
+constexpr size_t MEMORY_TREND_SAMPLES = 16;            // Trend sent with every heartbeat (~16 min)
+constexpr size_t MEMORY_MAX_TAGS = 8;                  // Allocation sites (MEMORY_TAGGING builds only)
+
+// ============================================================================
+// UART Lease Configuration
+// ============================================================================
+constexpr size_t UART_DRIVER_RX_BUFFER_SIZE = 512;  // ESP-IDF driver buffer (> 128 byte HW FIFO)
+constexpr size_t UART_LEASE_RX_BUFFER_SIZE = 1024;  // Per-lease ring (~1s of NMEA at 9600 baud)
+constexpr size_t UART_TAP_BUFFER_SIZE = 512;        // Per diagnostics tap
+constexpr int UART_MAX_TAPS = 2;
+constexpr uint32_t UART_PUMP_INTERVAL_MS = 10;
+constexpr uint32_t UART_PUMP_TASK_STACK_SIZE = 3072;
+
 // Environment variable names
 constexpr const char* ENV_HUB_HOST = "HUB_HOST";
 constexpr const char* ENV_HUB_PORT = "HUB_PORT";
@@ -91,6 +229,21 @@ constexpr const char* ENV_WIFI_SSID = "WIFI_SSID";
 constexpr const char* ENV_WIFI_PASSWORD = "WIFI_PASSWORD";
 constexpr const char* ENV_DISCOVERY_ENABLED = "DISCOVERY_ENABLED";
 constexpr const char* ENV_DISCOVERY_PORT = "DISCOVERY_PORT";
+constexpr const char* ENV_MQTT_USERNAME = "MQTT_USERNAME";
+constexpr const char* ENV_MQTT_PASSWORD = "MQTT_PASSWORD";
+constexpr const char* ENV_FLEET_NODES = "FLEET_NODES";
+constexpr const char* ENV_FLEET_THREADS = "FLEET_THREADS";
+constexpr const char* ENV_FLEET_RAMP_UP_SECONDS = "FLEET_RAMP_UP_SECONDS";
+constexpr const char* ENV_FLEET_DURATION_SECONDS = "FLEET_DURATION_SECONDS";
+constexpr const char* ENV_FLEET_REPORT_SECONDS = "FLEET_REPORT_SECONDS";
+constexpr const char* ENV_FLEET_ID = "FLEET_ID";
+constexpr const char* ENV_FLEET_SIM_MODELS = "FLEET_SIM_MODELS";  // Signal models, ';'-separated, round-robin per node
+constexpr const char* ENV_LOG_LEVEL = "LOG_LEVEL";
+constexpr const char* ENV_SIM_SEED = "SIM_SEED";            // Reproducible simulated sensor data
+constexpr const char* ENV_SIM_MODEL = "SIM_MODEL";          // Signal model, see sensor::SignalProfile
+constexpr const char* ENV_SESSION_RECORD = "SESSION_RECORD";  // Record the session to this file
+constexpr const char* ENV_SESSION_RECORD_SECONDS = "SESSION_RECORD_SECONDS";  // End the recording after this long
+constexpr const char* ENV_SESSION_REPLAY = "SESSION_REPLAY";  // Replay a recorded session in virtual time
 
 // ============================================================================
 // Bluetooth Sensor Mode Configuration (Sprint BT-01)
@@ -104,6 +257,14 @@ constexpr const char* SERVICE_UUID = "12345678-1234-5678-1234-56789abcdef0";
 // Characteristic UUIDs for sensor data transmission
 constexpr const char* CHAR_SENSOR_DATA_UUID = "12345678-1234-5678-1234-56789abcdef1";   // NOTIFY
 constexpr const char* CHAR_DEVICE_INFO_UUID = "12345678-1234-5678-1234-56789abcdef2";   // READ
+constexpr const char* CHAR_SCHEMA_UUID = "12345678-1234-5678-1234-56789abcdef3";        // READ (payload type table)
+
+// Binary sensor payload (see ble_sensor_payload.h)
+constexpr size_t BLE_PAYLOAD_MAX_SIZE = 512;                 // Encoded message before fragmentation
+constexpr size_t BLE_PAYLOAD_SCHEMA_MAX_SIZE = 384;          // Encoded schema descriptor
+constexpr uint16_t BLE_DEFAULT_ATT_MTU = 23;                 // Until the central negotiates more
+constexpr size_t BLE_NOTIFY_MAX_SIZE = 244;                  // Cap per notification (DLE payload)
+constexpr int BLE_NOTIFY_RETRY_COUNT = 3;                    // Retries when the host is out of buffers
 
 // Timing for BLE Sensor Mode
 constexpr uint32_t BLE_SENSOR_TRANSMIT_INTERVAL_MS = 60000;  // Send data every 60 seconds
@@ -116,6 +277,26 @@ constexpr uint32_t BLE_ADVERTISING_INTERVAL_MS = 100;        // Fast advertising
 
 } // namespace ble_sensor
 
+// ============================================================================
+// BLE Beacon Frames (multi-frame manufacturer data rotation)
+// ============================================================================
+namespace ble_beacon {
+
+constexpr uint32_t FRAME_ROTATION_MS = 1000;    // Default time each frame stays on air
+constexpr uint8_t KEYFRAME_INTERVAL = 4;        // Reading updates per absolute (key) cycle
+constexpr size_t MAX_CHANNELS = 16;             // One channel per measurement type
+constexpr size_t MAX_FRAMES = 8;                // Frames rotated per cycle
+constexpr size_t LEGACY_FRAME_SIZE = 26;        // 31 - flags AD (3) - manufacturer AD header (2)
+constexpr size_t EXT_FRAME_SIZE = 200;          // BLE 5 extended advertising (name + flags fit too)
+
+// Store-and-forward history (see ble_history.h)
+constexpr size_t HISTORY_CAPACITY = 2048;       // Samples kept (9 bytes each, ~5h at 6 types/min)
+constexpr uint16_t HISTORY_MTU = 517;           // Requested ATT MTU (BLE maximum)
+constexpr uint8_t HISTORY_DEFAULT_WINDOW = 8;   // Batches per READ when the Hub sends window 0
+constexpr uint8_t HISTORY_BATCHES_PER_LOOP = 4; // Notifications queued per loop() pass
+
+} // namespace ble_beacon
+
 } // namespace config
 
 #endif // CONFIG_H
@@ -86,6 +86,10 @@ private:
     static constexpr const char* KEY_CONFIGURED = "configured";
 
     bool _initialized;
+
+#ifndef PLATFORM_ESP32
+    StoredConfig _simulated;    // Simulated NVS, kept for the lifetime of the process
+#endif
 };
 
 #endif // CONFIG_MANAGER_H
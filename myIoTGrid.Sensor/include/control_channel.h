@@ -0,0 +1,120 @@
+/**
+ * myIoTGrid.Sensor - Control Channel
+ * Server push of configuration and debug-level changes
+ *
+ * A background task keeps a long-poll request open on
+ * GET /api/nodes/{serial}/control?wait=N with the ETag of the last received
+ * state as If-None-Match. The Hub answers as soon as the node's sensor
+ * configuration or debug settings change (200 + new state) or after N
+ * seconds (304), and the task immediately re-arms the request.
+ *
+ * The main loop picks up new states with takeState(); the HTTP work never
+ * blocks it. Hubs without the endpoint (404) disable the channel and the
+ * firmware stays on heartbeat-driven polling.
+ *
+ * Over HTTPS the request is a TLS session of its own, open next to the ones
+ * ApiClient makes from the main loop (about 45 KB of internal heap each).
+ * A session is only opened while the heap has room for both
+ * (config::CONTROL_PUSH_TLS_*); otherwise the channel stays inactive and the
+ * main loop polls.
+ */
+
+#ifndef CONTROL_CHANNEL_H
+#define CONTROL_CHANNEL_H
+
+#include <Arduino.h>
+
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#elif defined(PLATFORM_NATIVE)
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
+
+/**
+ * Control state pushed by the Hub
+ */
+struct ControlState {
+    String configurationVersion;  // Compare with ApiClient::isConfigurationCurrent()
+    int debugLevel;               // 0=Production, 1=Normal, 2=Debug
+    bool enableRemoteLogging;
+};
+
+class ControlChannel {
+public:
+    ControlChannel();
+    ~ControlChannel();
+
+    // Prevent copying
+    ControlChannel(const ControlChannel&) = delete;
+    ControlChannel& operator=(const ControlChannel&) = delete;
+
+    /**
+     * Start (or retarget) the long-poll session
+     * @param baseUrl Hub API base URL
+     * @param serialNumber Node serial number (configuration key on the Hub)
+     */
+    void begin(const String& baseUrl, const String& serialNumber);
+
+    /**
+     * Pause the session (the worker idles until begin() is called again)
+     */
+    void stop();
+
+    /**
+     * True while the Hub answers the long-poll (200/304), i.e. changes are pushed
+     */
+    bool isActive() const { return _active; }
+
+    /**
+     * Take the latest pushed state
+     * @return false if nothing new arrived since the last call
+     */
+    bool takeState(ControlState& state);
+
+private:
+    enum class PollResult { CHANGED, NOT_MODIFIED, NOT_SUPPORTED, LOW_MEMORY, FAILED };
+
+    /**
+     * One long-poll request; on CHANGED body and etag hold the new state
+     */
+    PollResult poll(const String& url, const String& ifNoneMatch, String& etag, String& body);
+
+    /**
+     * Worker body: re-arms the long-poll while enabled
+     */
+    void run();
+
+    void lock();
+    void unlock();
+    void sleepMs(uint32_t ms);
+
+    // Shared with the worker (guarded by lock())
+    String _url;
+    String _etag;
+    ControlState _state;
+    bool _hasState;
+
+#ifdef PLATFORM_ESP32
+    static void workerTask(void* param);
+
+    SemaphoreHandle_t _mutex;
+    TaskHandle_t _worker;
+    volatile bool _enabled;
+    volatile bool _active;
+#elif defined(PLATFORM_NATIVE)
+    std::mutex _mutex;
+    std::thread _worker;
+    std::atomic<bool> _enabled;
+    std::atomic<bool> _active;
+    std::atomic<bool> _shutdown;
+#else
+    bool _enabled;
+    bool _active;
+#endif
+};
+
+#endif // CONTROL_CHANNEL_H
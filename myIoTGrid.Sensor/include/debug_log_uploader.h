@@ -3,6 +3,18 @@
  * Sprint 8: Remote Debug System
  *
  * Handles batch upload of debug logs to the Hub API.
+ *
+ * Captured serial lines are packed into binary chunks and POSTed as
+ * application/octet-stream (all integers little-endian):
+ *
+ *   "MLG1" | u32 sequence | u32 nodeMillis | u32 droppedLines |
+ *   u16 lineCount | u8 flags | u8 reserved | u32 rawLength |
+ *   u32 payloadLength | payload
+ *
+ * The raw payload is lineCount x (u16 length + bytes). With flag bit 0 set
+ * the payload is an LZ4 block of rawLength bytes. The sequence increments
+ * once per chunk; a retry resends the identical chunk, and a chunk dropped
+ * after maxRetries leaves a gap the Hub can detect.
  */
 
 #ifndef DEBUG_LOG_UPLOADER_H
@@ -12,6 +24,12 @@
 #include <vector>
 #include <functional>
 #include "debug_manager.h"
+#include "serial_capture.h"
+
+#ifdef PLATFORM_ESP32
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+#endif
 
 /**
  * Upload configuration
@@ -21,7 +39,7 @@ struct DebugLogUploaderConfig {
     unsigned long uploadIntervalMs = 10000;  // Upload every 10 seconds (was 60s)
     int maxRetries = 3;
     unsigned long retryDelayMs = 5000;
-    int batchSize = 50;                   // Max entries per upload
+    int batchSize = 50;                   // Max lines per chunk
 };
 
 /**
@@ -33,6 +51,10 @@ struct DebugLogUploaderStats {
     uint32_t uploadAttempts = 0;
     uint32_t uploadFailures = 0;
     unsigned long lastUploadTime = 0;
+    uint32_t chunksSent = 0;
+    uint32_t chunksDropped = 0;
+    uint32_t rawBytes = 0;                // Line bytes before compression
+    uint32_t sentBytes = 0;               // Chunk bytes on the wire
 };
 
 /**
@@ -106,6 +128,17 @@ private:
     bool uploadSerialLines();
     String buildUploadPayload();
 
+    /**
+     * Move the oldest captured lines into the pending chunk
+     * @return false if there were no lines
+     */
+    bool encodeChunk();
+
+    /**
+     * Finish the pending chunk (sent or given up) and advance the sequence
+     */
+    void completeChunk(bool delivered);
+
     String _baseUrl;
     String _serialNumber;
     String _apiKey;
@@ -116,8 +149,24 @@ private:
     DebugLogUploaderStats _stats;
 
     std::vector<LogEntry> _queue;
+    std::vector<SerialCaptureLine> _lineSlices;  // Reused peek buffer
     unsigned long _lastUploadTime;
     int _currentRetry;
+
+    // Chunk buffers (allocated once in begin)
+    uint8_t* _rawChunk;                   // Length-prefixed lines
+    uint8_t* _pendingChunk;               // Header + payload awaiting delivery
+    uint16_t* _hashTable;                 // LZ4 match table
+    size_t _pendingLength;                // 0 = no chunk pending
+    size_t _pendingLines;
+    uint32_t _sequence;
+
+#ifdef PLATFORM_ESP32
+    // Kept across uploads so the (TLS) connection can be reused
+    WiFiClient* _client;
+    HTTPClient* _http;
+    bool _clientIsSecure;
+#endif
 };
 
 #endif // DEBUG_LOG_UPLOADER_H
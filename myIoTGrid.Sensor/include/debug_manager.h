@@ -4,14 +4,48 @@
  *
  * Provides configurable debug levels and log categories
  * for remote troubleshooting without impacting production performance.
+ *
+ * The DBG_* category macros are filtered twice:
+ *  - at compile time by DEBUG_COMPILE_LEVEL / DEBUG_COMPILE_CATEGORIES
+ *    (build flags), which removes the call and its format string entirely
+ *  - at runtime by the NVS level and category mask
+ *
+ * Calls that pass the filters only store the format string pointer and the
+ * raw arguments in a ring (deferred logging). Formatting, Serial output and
+ * the log callbacks run later in processDeferred() from the main loop.
+ * DBG_ERROR is formatted immediately so errors are never delayed or lost.
+ *
+ * Log calls may come from any task (e.g. sensor reads on the I2C bus
+ * workers): the ring and the statistics are safe to update concurrently,
+ * formatting and output are serialized by a mutex.
  */
 
 #ifndef DEBUG_MANAGER_H
 #define DEBUG_MANAGER_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <functional>
+#include <type_traits>
 #include <vector>
+#include "config.h"
+
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#elif defined(PLATFORM_NATIVE)
+#include <mutex>
+#endif
+
+// Highest level compiled in (0 = PRODUCTION, 1 = NORMAL, 2 = DEBUG)
+#ifndef DEBUG_COMPILE_LEVEL
+#define DEBUG_COMPILE_LEVEL 2
+#endif
+
+// Bitmask of LogCategory values compiled in (ERROR is always compiled in)
+#ifndef DEBUG_COMPILE_CATEGORIES
+#define DEBUG_COMPILE_CATEGORIES 0xFF
+#endif
 
 /**
  * Debug Level Enum
@@ -40,6 +74,49 @@ enum class LogCategory : uint8_t {
     ERROR = 7       // Error conditions (always logged)
 };
 
+/**
+ * Lowest debug level at which a category is logged
+ */
+constexpr DebugLevel categoryMinLevel(LogCategory category) {
+    return category == LogCategory::ERROR ? DebugLevel::PRODUCTION
+         : (category == LogCategory::SYSTEM || category == LogCategory::NETWORK ||
+            category == LogCategory::API || category == LogCategory::STORAGE) ? DebugLevel::NORMAL
+         : DebugLevel::DEBUG;
+}
+
+/**
+ * Check if a category survives the compile-time filter
+ */
+constexpr bool isLogCompiledIn(LogCategory category) {
+    return category == LogCategory::ERROR ||
+           (static_cast<uint8_t>(categoryMinLevel(category)) <= DEBUG_COMPILE_LEVEL &&
+            ((DEBUG_COMPILE_CATEGORIES >> static_cast<uint8_t>(category)) & 1) != 0);
+}
+
+/**
+ * Deferred log record: format string + raw arguments, formatted on drain
+ */
+struct DeferredLogRecord {
+    enum ArgType : uint8_t { ARG_INT, ARG_UINT, ARG_DOUBLE, ARG_STRING, ARG_POINTER };
+
+    union Arg {
+        int64_t i;
+        uint64_t u;
+        double d;
+        uint8_t str;          // Offset into strings
+        const void* p;
+    };
+
+    unsigned long timestamp;
+    const char* format;       // String literal, doubles as message id
+    LogCategory category;
+    uint8_t argCount;
+    uint8_t stringLength;
+    uint8_t argTypes[config::DEBUG_DEFERRED_LOG_MAX_ARGS];
+    Arg args[config::DEBUG_DEFERRED_LOG_MAX_ARGS];
+    char strings[config::DEBUG_DEFERRED_LOG_STRING_BYTES];
+};
+
 /**
  * Log Entry structure for buffering
  */
@@ -127,6 +204,42 @@ public:
     void logError(const char* format, ...);
     void logDebug(LogCategory category, const char* format, ...);
 
+    /**
+     * Store a log call for deferred formatting (use the DBG_* macros)
+     * Only the format pointer and the arguments are copied; %s arguments are
+     * copied into the record (truncated when the record is full).
+     */
+    template<typename... Args>
+    void logDeferred(LogCategory category, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= config::DEBUG_DEFERRED_LOG_MAX_ARGS,
+                      "Too many arguments for a deferred log call");
+        if (!shouldLog(category)) return;
+
+        unsigned long startTime = micros();
+        DeferredLogRecord record;
+        record.timestamp = millis();
+        record.format = format;
+        record.category = category;
+        record.argCount = 0;
+        record.stringLength = 0;
+        (packArg(record, args), ...);
+        pushDeferred(record);
+        _totalLoggingTimeUs.fetch_add(micros() - startTime, std::memory_order_relaxed);
+    }
+
+    /**
+     * Format pending deferred records and pass them to Serial and the callbacks
+     * @param maxRecords Upper bound for this call (0 = all pending)
+     * @return Records processed
+     */
+    size_t processDeferred(size_t maxRecords = 0);
+
+    /**
+     * Deferred ring state
+     */
+    size_t getDeferredPending() const { return _deferredCount; }
+    uint32_t getDeferredDropped() const { return _deferredDropped; }
+
     /**
      * Register callback for log entries
      */
@@ -140,20 +253,53 @@ public:
     /**
      * Get statistics
      */
-    uint32_t getLogCount() const { return _logCount; }
-    uint32_t getErrorCount() const { return _errorCount; }
+    uint32_t getLogCount() const { return _logCount.load(std::memory_order_relaxed); }
+    uint32_t getErrorCount() const { return _errorCount.load(std::memory_order_relaxed); }
     void resetStatistics();
 
     /**
      * Performance measurement
      */
-    unsigned long getLoggingOverheadUs() const { return _totalLoggingTimeUs; }
+    unsigned long getLoggingOverheadUs() const { return _totalLoggingTimeUs.load(std::memory_order_relaxed); }
+    unsigned long getFormattingTimeUs() const { return _formattingTimeUs; }
     void resetOverheadMeasurement();
 
 private:
     DebugManager();
 
     void logInternal(LogCategory category, DebugLevel minLevel, const char* format, va_list args);
+    void emit(LogCategory category, DebugLevel minLevel, unsigned long timestamp, const char* message);
+
+    // Guards _logBuffer, Serial output and the callbacks (recursive: callbacks may log)
+    void lockOutput();
+    void unlockOutput();
+
+    template<typename T>
+    static void packArg(DeferredLogRecord& record, T value) {
+        uint8_t index = record.argCount++;
+        if constexpr (std::is_same<T, const char*>::value || std::is_same<T, char*>::value) {
+            record.argTypes[index] = DeferredLogRecord::ARG_STRING;
+            record.args[index].str = copyDeferredString(record, value);
+        } else if constexpr (std::is_floating_point<T>::value) {
+            record.argTypes[index] = DeferredLogRecord::ARG_DOUBLE;
+            record.args[index].d = value;
+        } else if constexpr (std::is_enum<T>::value || std::is_signed<T>::value) {
+            record.argTypes[index] = DeferredLogRecord::ARG_INT;
+            record.args[index].i = static_cast<int64_t>(value);
+        } else if constexpr (std::is_unsigned<T>::value) {
+            record.argTypes[index] = DeferredLogRecord::ARG_UINT;
+            record.args[index].u = static_cast<uint64_t>(value);
+        } else if constexpr (std::is_pointer<T>::value) {
+            record.argTypes[index] = DeferredLogRecord::ARG_POINTER;
+            record.args[index].p = value;
+        } else {
+            static_assert(sizeof(T) == 0, "Unsupported deferred log argument (use .c_str() for String)");
+        }
+    }
+
+    static uint8_t copyDeferredString(DeferredLogRecord& record, const char* str);
+    static size_t formatDeferred(const DeferredLogRecord& record, char* out, size_t size);
+    void pushDeferred(const DeferredLogRecord& record);
     void saveToNVS();
     void loadFromNVS();
     void notifyCallbacks(const LogEntry& entry);
@@ -165,9 +311,23 @@ private:
     std::vector<LogCallback> _callbacks;
 
     // Statistics
-    uint32_t _logCount;
-    uint32_t _errorCount;
-    unsigned long _totalLoggingTimeUs;
+    std::atomic<uint32_t> _logCount;
+    std::atomic<uint32_t> _errorCount;
+    std::atomic<unsigned long> _totalLoggingTimeUs;   // Time spent in log calls (hot path)
+    unsigned long _formattingTimeUs;     // Time spent formatting deferred records
+
+    // Deferred record ring
+    DeferredLogRecord _deferred[config::DEBUG_DEFERRED_LOG_SLOTS];
+    size_t _deferredHead;
+    size_t _deferredCount;
+    uint32_t _deferredDropped;
+    uint32_t _deferredDropsReported;
+#ifdef PLATFORM_ESP32
+    portMUX_TYPE _deferredMux;
+    SemaphoreHandle_t _outputMutex;
+#elif defined(PLATFORM_NATIVE)
+    std::recursive_mutex _outputMutex;
+#endif
 
     // Buffer for formatting
     static constexpr size_t LOG_BUFFER_SIZE = 512;
@@ -180,16 +340,22 @@ private:
     static constexpr const char* NVS_KEY_CATEGORIES = "cats";
 };
 
-// Convenience macros for logging
-#define DBG_SYSTEM(fmt, ...) DebugManager::getInstance().logSystem(fmt, ##__VA_ARGS__)
-#define DBG_HARDWARE(fmt, ...) DebugManager::getInstance().logHardware(fmt, ##__VA_ARGS__)
-#define DBG_NETWORK(fmt, ...) DebugManager::getInstance().logNetwork(fmt, ##__VA_ARGS__)
-#define DBG_SENSOR(fmt, ...) DebugManager::getInstance().logSensor(fmt, ##__VA_ARGS__)
-#define DBG_GPS(fmt, ...) DebugManager::getInstance().logGPS(fmt, ##__VA_ARGS__)
-#define DBG_API(fmt, ...) DebugManager::getInstance().logAPI(fmt, ##__VA_ARGS__)
-#define DBG_STORAGE(fmt, ...) DebugManager::getInstance().logStorage(fmt, ##__VA_ARGS__)
+// Convenience macros for logging (compiled out per DEBUG_COMPILE_LEVEL / DEBUG_COMPILE_CATEGORIES)
+#define DBG_DEFERRED(cat, fmt, ...) do { \
+        if constexpr (isLogCompiledIn(cat)) DebugManager::getInstance().logDeferred(cat, fmt, ##__VA_ARGS__); \
+    } while (0)
+#define DBG_SYSTEM(fmt, ...) DBG_DEFERRED(LogCategory::SYSTEM, fmt, ##__VA_ARGS__)
+#define DBG_HARDWARE(fmt, ...) DBG_DEFERRED(LogCategory::HARDWARE, fmt, ##__VA_ARGS__)
+#define DBG_NETWORK(fmt, ...) DBG_DEFERRED(LogCategory::NETWORK, fmt, ##__VA_ARGS__)
+#define DBG_SENSOR(fmt, ...) DBG_DEFERRED(LogCategory::SENSOR, fmt, ##__VA_ARGS__)
+#define DBG_GPS(fmt, ...) DBG_DEFERRED(LogCategory::GPS, fmt, ##__VA_ARGS__)
+#define DBG_API(fmt, ...) DBG_DEFERRED(LogCategory::API, fmt, ##__VA_ARGS__)
+#define DBG_STORAGE(fmt, ...) DBG_DEFERRED(LogCategory::STORAGE, fmt, ##__VA_ARGS__)
 #define DBG_ERROR(fmt, ...) DebugManager::getInstance().logError(fmt, ##__VA_ARGS__)
-#define DBG_DEBUG(cat, fmt, ...) DebugManager::getInstance().logDebug(cat, fmt, ##__VA_ARGS__)
+#define DBG_DEBUG(cat, fmt, ...) do { \
+        if constexpr (DEBUG_COMPILE_LEVEL >= 2 && isLogCompiledIn(cat)) \
+            DebugManager::getInstance().logDebug(cat, fmt, ##__VA_ARGS__); \
+    } while (0)
 
 // Check macros for early exit
 #define DBG_SHOULD_LOG(cat) DebugManager::getInstance().shouldLog(cat)
@@ -70,6 +70,11 @@ private:
                            const String& firmwareVersion,
                            const String& hardwareType);
 
+    /**
+     * Hub response as JSON (inverse of parseResponse, for session traces)
+     */
+    String buildResponseJson(const DiscoveryResponse& response);
+
     /**
      * Parse the discovery response JSON
      */
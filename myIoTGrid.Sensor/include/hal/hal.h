@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstdint>
+#include <functional>
 
 namespace hal {
 
@@ -38,6 +39,12 @@ void delay_ms(uint32_t ms);
  */
 uint32_t millis();
 
+/**
+ * Get microseconds since system start (wraps like Arduino micros())
+ * @return Microseconds elapsed
+ */
+uint32_t micros();
+
 /**
  * Get current Unix timestamp in seconds
  * @return Unix timestamp
@@ -135,6 +142,54 @@ HttpResponse http_post(const std::string& url, const std::string& json, uint32_t
  */
 HttpResponse http_get(const std::string& url, uint32_t timeoutMs = 10000);
 
+/**
+ * Completion callback of http_post_async()
+ */
+using HttpCallback = std::function<void(const HttpResponse&)>;
+
+/**
+ * Send HTTP POST request without waiting for the response
+ * Native: queued on the shared transport, callback runs on its thread.
+ * ESP32: no asynchronous client; the request runs and the callback is
+ * invoked before the function returns.
+ */
+void http_post_async(const std::string& url, const std::string& json, uint32_t timeoutMs,
+                     HttpCallback callback);
+
+// ============================================
+// TCP Client (MQTT transport)
+// ============================================
+
+/**
+ * Open a TCP connection
+ * @param host Hostname or IP address
+ * @param port TCP port
+ * @param timeoutMs Connect timeout in milliseconds
+ * @return Socket handle, or -1 on failure
+ */
+int tcp_connect(const std::string& host, uint16_t port, uint32_t timeoutMs = 10000);
+
+/**
+ * Write all bytes to a TCP connection
+ * @param socket Handle from tcp_connect()
+ * @return true if everything was written
+ */
+bool tcp_write(int socket, const uint8_t* data, size_t length);
+
+/**
+ * Read available bytes from a TCP connection
+ * @param socket Handle from tcp_connect()
+ * @param timeoutMs Time to wait for data (0 = don't wait)
+ * @return Bytes read, 0 if nothing arrived, -1 if the connection is closed
+ */
+int tcp_read(int socket, uint8_t* buffer, size_t length, uint32_t timeoutMs);
+
+/**
+ * Close a TCP connection
+ * @param socket Handle from tcp_connect()
+ */
+void tcp_close(int socket);
+
 // ============================================
 // Logging
 // ============================================
@@ -163,6 +218,13 @@ void log_error(const std::string& message);
  */
 void log_debug(const std::string& message);
 
+/**
+ * Set the minimum severity that is logged
+ * Used by the fleet simulator to keep thousands of nodes quiet
+ * @param level 0=error, 1=warn, 2=info (default), 3=debug
+ */
+void log_set_level(int level);
+
 // ============================================
 // System
 // ============================================
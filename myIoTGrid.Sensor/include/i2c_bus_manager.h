@@ -0,0 +1,209 @@
+/**
+ * myIoTGrid.Sensor - I2C Bus Manager
+ *
+ * Registry of I2C buses keyed by SDA/SCL pin pair.
+ * ESP32 has 2 I2C controllers with GPIO matrix routing:
+ *
+ * Controller 0 = Wire  (default pins 21/22)
+ * Controller 1 = Wire1 (any free pins)
+ *
+ * The first two pin pairs each get a dedicated controller that is started
+ * once and never re-pinned. Further pin pairs become shared buses that are
+ * multiplexed onto a controller; the controller is only re-pinned when a
+ * different shared bus takes the lock, so consecutive transactions on the
+ * same bus never pay the Wire.end()/Wire.begin() cost.
+ *
+ * Each controller owns a worker task with a transaction queue. runBatch()
+ * groups jobs by bus, runs each controller's group on its own worker and
+ * non-I2C jobs on the caller, so sensors on both controllers are read
+ * concurrently.
+ */
+
+#ifndef I2C_BUS_MANAGER_H
+#define I2C_BUS_MANAGER_H
+
+#include <Arduino.h>
+
+#ifdef PLATFORM_ESP32
+#include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+#include "config.h"
+
+#define I2C_CONTROLLER_COUNT 2
+
+/**
+ * I2C bus registry entry
+ */
+struct I2CBus {
+    int busId;                // Registry slot, -1 if unused
+    int sdaPin;               // SDA pin
+    int sclPin;               // SCL pin
+    uint32_t frequency;       // Clock frequency in Hz
+    int controller;           // Hardware controller (0 = Wire, 1 = Wire1)
+    bool shared;              // Multiplexed onto a controller owned by another bus
+    TwoWire* wire;            // Controller instance used by drivers
+};
+
+/**
+ * Job function executed by a bus worker
+ * @param ctx Caller-provided context
+ */
+typedef void (*I2CJobFn)(void* ctx);
+
+/**
+ * Queued I2C transaction (busId -1 = not an I2C job, runs on the caller)
+ */
+struct I2CJob {
+    int busId;
+    I2CJobFn fn;
+    void* ctx;
+};
+
+/**
+ * I2C Bus Manager - Singleton for managing ESP32 I2C controllers
+ */
+class I2CBusManager {
+public:
+    /**
+     * Get singleton instance
+     */
+    static I2CBusManager& getInstance();
+
+    /**
+     * Get (or register) the bus for a pin pair
+     * @param sdaPin SDA pin (-1 = default)
+     * @param sclPin SCL pin (-1 = default)
+     * @param requiredController Controller the caller's driver is hardwired to (-1 = any)
+     * @return Bus ID on success, -1 if the registry is full
+     */
+    int acquire(int sdaPin, int sclPin, int requiredController = -1);
+
+    /**
+     * Get bus ID for a pin pair without registering it
+     * @return Bus ID, -1 if not registered
+     */
+    int getBusForPins(int sdaPin, int sclPin) const;
+
+    /**
+     * Get registry entry for a bus
+     * @return Bus pointer or nullptr if invalid
+     */
+    const I2CBus* getBus(int busId) const;
+
+    /**
+     * Get the TwoWire instance for a bus
+     * @return TwoWire pointer or nullptr if invalid
+     */
+    TwoWire* getWire(int busId) const;
+
+    /**
+     * Take exclusive access to a bus (re-pins shared controllers if needed)
+     * @param busId Bus ID
+     * @param timeoutMs Lock timeout
+     * @return true if the lock was taken
+     */
+    bool lock(int busId, uint32_t timeoutMs = config::I2C_BUS_LOCK_TIMEOUT_MS);
+
+    /**
+     * Release a bus taken with lock()
+     */
+    void unlock(int busId);
+
+    /**
+     * Run a batch of jobs, one worker per controller in parallel
+     * Jobs on the same bus run back-to-back in submission order.
+     * Blocks until all jobs have completed.
+     * @param jobs Job array
+     * @param count Number of jobs
+     */
+    void runBatch(const I2CJob* jobs, size_t count);
+
+    /**
+     * Get number of registered buses
+     */
+    int getBusCount() const;
+
+    /**
+     * Get number of controller re-pins caused by shared buses
+     */
+    uint32_t getRepinCount() const { return _repinCount; }
+
+    /**
+     * Print current bus registry for debugging
+     */
+    void printBuses();
+
+private:
+    I2CBusManager();
+    ~I2CBusManager() = default;
+
+    // Prevent copying
+    I2CBusManager(const I2CBusManager&) = delete;
+    I2CBusManager& operator=(const I2CBusManager&) = delete;
+
+    /**
+     * Group of jobs for one controller, handed to its worker
+     */
+    struct Batch {
+        const I2CJob* jobs;
+        size_t count;
+        TaskHandle_t notify;
+    };
+
+    I2CBus _buses[config::I2C_MAX_BUSES];
+
+    // Per-controller state
+    SemaphoreHandle_t _controllerMutex[I2C_CONTROLLER_COUNT];
+    QueueHandle_t _controllerQueue[I2C_CONTROLLER_COUNT];
+    TaskHandle_t _controllerTask[I2C_CONTROLLER_COUNT];
+    int _controllerOwner[I2C_CONTROLLER_COUNT];    // Bus that owns the controller (-1 = free)
+    int _controllerPinnedBus[I2C_CONTROLLER_COUNT]; // Bus whose pins are currently applied
+
+    uint32_t _repinCount;
+
+    /**
+     * Get TwoWire instance for a controller
+     */
+    static TwoWire* controllerWire(int controller);
+
+    /**
+     * Start the worker task for a controller (once)
+     */
+    void startWorker(int controller);
+
+    /**
+     * Apply a bus' pins to its controller
+     */
+    void applyPins(const I2CBus& bus);
+
+    /**
+     * Worker task entry point
+     */
+    static void workerTask(void* param);
+
+    /**
+     * Run jobs sequentially
+     */
+    static void runJobs(const I2CJob* jobs, size_t count);
+};
+
+/**
+ * Scoped bus lock
+ */
+class I2CBusLock {
+public:
+    explicit I2CBusLock(int busId)
+        : _busId(busId), _locked(busId >= 0 && I2CBusManager::getInstance().lock(busId)) {}
+    ~I2CBusLock() { if (_locked) I2CBusManager::getInstance().unlock(_busId); }
+    bool locked() const { return _locked; }
+
+private:
+    int _busId;
+    bool _locked;
+};
+
+#endif // PLATFORM_ESP32
+
+#endif // I2C_BUS_MANAGER_H
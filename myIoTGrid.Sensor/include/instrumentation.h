@@ -0,0 +1,176 @@
+/**
+ * myIoTGrid.Sensor - Hot-Path Instrumentation
+ * Where the milliseconds of each loop iteration go
+ *
+ * Named stages collect durations in fixed log2 histograms: bucket 0 holds
+ * durations below 1 us, bucket i holds [2^(i-1), 2^i) us, the last bucket is
+ * open-ended. Recording is a few integer operations without allocation;
+ * percentiles are exact to a factor of two. Counters count events next to
+ * the timings.
+ *
+ *   TIMED_SCOPE("http.request");                          // Times the enclosing block
+ *   ScopedTimer timer(instrumentation.stageId("sensor.", code));   // Dynamic name (per driver)
+ *   instrumentation.count("http.errors");
+ *
+ * Stages: "loop", "sensor.<code>", "json.serialize", "http.request",
+ * "sd.append", "sync.batch". The results are printed by the "timing" serial
+ * command and at the end of a native replay, and sent to the Hub as the
+ * "timing" object of the hardware status report.
+ *
+ * Timers on the loop task are also the progress markers of the stall
+ * profiler (stall_monitor.h).
+ *
+ * Build with -DINSTRUMENTATION=0 to compile the TIMED_SCOPE timers out.
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "stall_monitor.h"
+
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#endif
+
+#ifndef INSTRUMENTATION
+#define INSTRUMENTATION 1
+#endif
+
+/**
+ * Fixed-size log2 latency histogram
+ */
+struct TimingHistogram {
+    uint32_t buckets[config::INSTRUMENT_HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint64_t totalUs;
+    uint32_t maxUs;
+
+    TimingHistogram() { reset(); }
+
+    void reset();
+    void add(uint32_t durationUs);
+
+    /**
+     * Upper bound of the bucket holding the given quantile (capped at maxUs)
+     * @param quantile 0.0 - 1.0
+     */
+    uint32_t percentileUs(float quantile) const;
+
+    static size_t bucketFor(uint32_t durationUs);
+};
+
+class Instrumentation {
+public:
+    static Instrumentation& getInstance();
+
+    /**
+     * Id of a stage, registered on first use
+     * @return -1 if the stage table is full (the stage is not recorded)
+     */
+    int stageId(const char* name);
+
+    /**
+     * Id of the stage "<prefix><name>" (e.g., "sensor." + sensor code)
+     */
+    int stageId(const char* prefix, const char* name);
+
+    /**
+     * Name of a registered stage ("" for unknown ids)
+     */
+    const char* stageName(int stageId) const;
+
+    void record(int stageId, uint32_t durationUs);
+
+    void count(const char* name, uint32_t amount = 1);
+
+    /**
+     * Clear all stages and counters and start a new measurement window
+     */
+    void reset();
+
+    /**
+     * Timing object of the hardware status report (ReportHardwareStatusDto.Timing)
+     * {"windowMs":..,"stages":[{"name","count","totalUs","maxUs","p50Us","p90Us","p99Us","buckets"}],"counters":{..}}
+     * Trailing empty buckets are omitted.
+     */
+    String toJson() const;
+
+    /**
+     * Print a stage table and the counters to Serial
+     */
+    void printReport() const;
+
+    unsigned long getWindowMs() const { return millis() - _windowStartMs; }
+
+private:
+    Instrumentation();
+
+    // Prevent copying
+    Instrumentation(const Instrumentation&) = delete;
+    Instrumentation& operator=(const Instrumentation&) = delete;
+
+    struct Stage {
+        char name[config::INSTRUMENT_NAME_LENGTH];
+        TimingHistogram histogram;
+    };
+
+    struct Counter {
+        char name[config::INSTRUMENT_NAME_LENGTH];
+        uint32_t value;
+    };
+
+    // Caller holds the lock
+    int findOrAddStage(const char* prefix, const char* name);
+
+    bool copyStage(size_t index, Stage& out) const;
+    size_t copyCounters(Counter* out) const;
+
+    Stage _stages[config::INSTRUMENT_MAX_STAGES];
+    size_t _stageCount;
+    Counter _counters[config::INSTRUMENT_MAX_COUNTERS];
+    size_t _counterCount;
+    unsigned long _windowStartMs;
+#ifdef PLATFORM_ESP32
+    // Sensor reads are recorded from the I2C bus tasks
+    mutable portMUX_TYPE _mux;
+#endif
+};
+
+/**
+ * Records the lifetime of the timer as one sample of a stage
+ * On the loop task the stage is also pushed as a stall profiler marker.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(int stageId)
+        : _stageId(stageId)
+        , _marked(StallMonitor::getInstance().enterStage(stageId))
+        , _startUs(micros()) {}
+    ~ScopedTimer() {
+        Instrumentation::getInstance().record(_stageId, (uint32_t)(micros() - _startUs));
+        StallMonitor::getInstance().exitStage(_marked);
+    }
+
+private:
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    int _stageId;
+    bool _marked;
+    unsigned long _startUs;
+};
+
+#if INSTRUMENTATION
+#define INSTRUMENT_CONCAT_(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_(a, b)
+// The stage id is looked up once per call site
+#define TIMED_SCOPE(name) \
+    static const int INSTRUMENT_CONCAT(_timedStage, __LINE__) = Instrumentation::getInstance().stageId(name); \
+    ScopedTimer INSTRUMENT_CONCAT(_timedScope, __LINE__)(INSTRUMENT_CONCAT(_timedStage, __LINE__))
+#else
+#define TIMED_SCOPE(name) do {} while (0)
+#endif
+
+#endif // INSTRUMENTATION_H
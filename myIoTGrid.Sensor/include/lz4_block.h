@@ -0,0 +1,32 @@
+/**
+ * myIoTGrid.Sensor - LZ4 Block Compressor
+ *
+ * Minimal single-pass compressor producing the standard LZ4 block format
+ * (no frame header, no checksum). Used for remote serial-monitor chunks,
+ * which are dominated by repeated tags like "[Sensor]" and "[API]".
+ *
+ * The caller owns all memory: a 2^hashBits uint16_t match table and the
+ * output buffer. Input is limited to 64 KB so table entries fit in 16 bits.
+ */
+
+#ifndef LZ4_BLOCK_H
+#define LZ4_BLOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Compress one block
+ * @param src Input bytes (at most 65535)
+ * @param srcLength Input length
+ * @param dst Output buffer
+ * @param dstCapacity Output capacity
+ * @param hashTable Scratch table with (1 << hashBits) entries
+ * @param hashBits Table size exponent (8-16)
+ * @return Compressed length, 0 if the output does not fit
+ */
+size_t lz4CompressBlock(const uint8_t* src, size_t srcLength,
+                        uint8_t* dst, size_t dstCapacity,
+                        uint16_t* hashTable, uint8_t hashBits);
+
+#endif // LZ4_BLOCK_H
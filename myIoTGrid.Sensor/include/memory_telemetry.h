@@ -0,0 +1,194 @@
+/**
+ * myIoTGrid.Sensor - Memory Telemetry
+ * Heap headroom and fragmentation per capability, over time
+ *
+ * A TLS handshake needs a few contiguous blocks of internal RAM; when the
+ * heap is fragmented it fails with TOO_LESS_RAM (-8) long before the free
+ * heap looks low. The free size alone does not show this, so each heap
+ * capability (8bit, internal, DMA, SPIRAM) reports:
+ *   free          Bytes free now
+ *   largestFree   Largest allocatable block
+ *   minFree       Low-water mark since boot
+ *   fragmentation 100 - largestFree * 100 / free (%)
+ * The internal heap is sampled every config::MEMORY_SAMPLE_INTERVAL_MS into
+ * a trend of config::MEMORY_TREND_SAMPLES samples, and failed allocations
+ * (size and capabilities) are counted as they happen.
+ *
+ * Debug builds with -DMEMORY_TAGGING=1 also account heap per allocation
+ * site: MEMORY_TAG("http") measures how much heap the enclosing block kept
+ * (calls, net bytes, largest single retention).
+ *
+ * Sent to the Hub as the "memory" object of every heartbeat and printed by
+ * the "memory" serial command. Native: no heap capabilities; tags measure
+ * the process heap in use (glibc).
+ */
+
+#ifndef MEMORY_TELEMETRY_H
+#define MEMORY_TELEMETRY_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#endif
+
+#ifndef MEMORY_TAGGING
+#define MEMORY_TAGGING 0
+#endif
+
+/**
+ * Heap regions by allocation capability (MALLOC_CAP_*); they overlap
+ */
+enum class HeapCapability : uint8_t {
+    BYTE_ADDRESSABLE,   // MALLOC_CAP_8BIT: malloc()/new
+    INTERNAL,           // MALLOC_CAP_INTERNAL: TLS, WiFi and task stacks
+    DMA,                // MALLOC_CAP_DMA
+    SPIRAM,             // MALLOC_CAP_SPIRAM (boards with PSRAM only)
+    COUNT
+};
+
+struct HeapStats {
+    uint32_t totalBytes;
+    uint32_t freeBytes;
+    uint32_t largestFreeBlock;
+    uint32_t minFreeBytes;
+
+    HeapStats() : totalBytes(0), freeBytes(0), largestFreeBlock(0), minFreeBytes(0) {}
+
+    uint8_t fragmentationPercent() const;
+};
+
+/**
+ * One trend sample of the internal heap
+ */
+struct HeapSample {
+    unsigned long uptimeMs;
+    uint32_t freeBytes;
+    uint32_t largestFreeBlock;
+    uint32_t minFreeBytes;
+};
+
+class MemoryTelemetry {
+public:
+    static MemoryTelemetry& getInstance();
+
+    /**
+     * Start counting failed allocations and take the first sample
+     */
+    void begin();
+
+    /**
+     * Take a trend sample when the interval has passed (call from loop())
+     */
+    void loop();
+
+    /**
+     * Current stats of a capability
+     * @return false if the capability does not exist on this device
+     */
+    bool read(HeapCapability capability, HeapStats& out) const;
+
+    static const char* getCapabilityName(HeapCapability capability);
+
+    /**
+     * Memory object of the heartbeat (NodeHeartbeatDto.Memory)
+     * {"uptimeMs":..,"capabilities":[{"name","total","free","largestFree","minFree","fragmentation"}],
+     *  "trend":{"intervalMs":..,"free":[..],"largestFree":[..],"minFree":[..]},
+     *  "failedAllocs":..,"lastFailedBytes":..,"lastFailedCaps":..,"tags":[{"name","calls","netBytes","maxBytes"}]}
+     * Trend oldest first; tags only in MEMORY_TAGGING builds.
+     */
+    String toJson() const;
+
+    void printReport() const;
+
+    uint32_t getFailedAllocCount() const { return _failedAllocs.load(std::memory_order_relaxed); }
+
+#if MEMORY_TAGGING
+    /**
+     * Id of an allocation site, registered on first use
+     * @return -1 if the tag table is full
+     */
+    int tagId(const char* name);
+
+    void recordTag(int tagId, int32_t retainedBytes);
+
+    /**
+     * Heap in use, the measure of MEMORY_TAG
+     */
+    static int32_t heapUsedBytes();
+#endif
+
+private:
+    MemoryTelemetry();
+
+    // Prevent copying
+    MemoryTelemetry(const MemoryTelemetry&) = delete;
+    MemoryTelemetry& operator=(const MemoryTelemetry&) = delete;
+
+    void sample();
+
+    static void onAllocFailed(size_t size, uint32_t caps, const char* functionName);
+
+    HeapSample _trend[config::MEMORY_TREND_SAMPLES];
+    size_t _trendHead;          // Next slot
+    size_t _trendCount;
+    unsigned long _lastSampleMs;
+    bool _started;
+
+    // Written by the allocator of any task
+    std::atomic<uint32_t> _failedAllocs;
+    std::atomic<uint32_t> _lastFailedBytes;
+    std::atomic<uint32_t> _lastFailedCaps;
+
+#if MEMORY_TAGGING
+    struct Tag {
+        char name[config::INSTRUMENT_NAME_LENGTH];
+        uint32_t calls;
+        int32_t netBytes;
+        int32_t maxBytes;
+    };
+
+    size_t copyTags(Tag* out) const;
+
+    Tag _tags[config::MEMORY_MAX_TAGS];
+    size_t _tagCount;
+#ifdef PLATFORM_ESP32
+    mutable portMUX_TYPE _mux;
+#endif
+#endif
+};
+
+#if MEMORY_TAGGING
+/**
+ * Records the heap kept by the lifetime of the tag
+ */
+class ScopedMemoryTag {
+public:
+    explicit ScopedMemoryTag(int tagId)
+        : _tagId(tagId)
+        , _usedBefore(MemoryTelemetry::heapUsedBytes()) {}
+    ~ScopedMemoryTag() {
+        MemoryTelemetry::getInstance().recordTag(_tagId, MemoryTelemetry::heapUsedBytes() - _usedBefore);
+    }
+
+private:
+    ScopedMemoryTag(const ScopedMemoryTag&) = delete;
+    ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+
+    int _tagId;
+    int32_t _usedBefore;
+};
+
+#define MEMORY_CONCAT_(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_(a, b)
+// The tag id is looked up once per call site
+#define MEMORY_TAG(name) \
+    static const int MEMORY_CONCAT(_memoryTagId, __LINE__) = MemoryTelemetry::getInstance().tagId(name); \
+    ScopedMemoryTag MEMORY_CONCAT(_memoryTag, __LINE__)(MEMORY_CONCAT(_memoryTagId, __LINE__))
+#else
+#define MEMORY_TAG(name) do {} while (0)
+#endif
+
+#endif // MEMORY_TELEMETRY_H
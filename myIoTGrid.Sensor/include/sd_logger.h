@@ -4,6 +4,11 @@
  *
  * Handles logging to SD card with circular file rotation
  * and JSON-Lines format for easy parsing.
+ *
+ * log() copies the entry into a fixed ring of log records (no heap
+ * allocation per entry). A low-priority writer task drains the ring in
+ * batches: all pending records are formatted into one write buffer and
+ * the file is flushed once per batch.
  */
 
 #ifndef SD_LOGGER_H
@@ -16,7 +21,8 @@
 #include <SD.h>
 #include <SPI.h>
 #include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 #endif
 
 /**
@@ -25,7 +31,7 @@
 struct SDLoggerConfig {
     size_t maxFileSize = 1024 * 1024;      // 1 MB per file
     int maxFiles = 10;                      // 10 files = 10 MB max
-    int maxQueueSize = 100;                 // Max entries in queue
+    int maxQueueSize = 100;                 // Max entries in queue (capped at SD_LOG_POOL_SLOTS)
     unsigned long flushIntervalMs = 5000;   // Flush every 5 seconds
     bool enabled = true;
 };
@@ -39,6 +45,10 @@ struct SDLoggerStats {
     uint32_t filesRotated = 0;
     uint64_t bytesWritten = 0;
     unsigned long lastFlushTime = 0;
+    uint32_t batchesWritten = 0;
+    uint32_t maxQueued = 0;                 // High-water mark of pending records
+    unsigned long maxLatencyMs = 0;         // Longest log() -> file delay
+    unsigned long lastLatencyMs = 0;        // Oldest record of the last batch
 };
 
 /**
@@ -85,12 +95,13 @@ public:
     void log(const LogEntry& entry);
 
     /**
-     * Process queued logs (call from main loop)
+     * Process queued logs (call from main loop; only writes when the
+     * writer task is not running)
      */
     void loop();
 
     /**
-     * Flush all pending logs to SD card
+     * Write pending records and flush the log file
      */
     void flush();
 
@@ -140,11 +151,40 @@ private:
     SDLogger();
     ~SDLogger();
 
+    /**
+     * Fixed-size copy of a LogEntry (message and stack share text)
+     */
+    struct Record {
+        unsigned long timestamp;
+        DebugLevel level;
+        LogCategory category;
+        uint16_t messageLength;
+        uint16_t stackLength;
+        char text[config::SD_LOG_RECORD_TEXT_SIZE];
+    };
+
     void rotateFileIfNeeded();
     void openCurrentFile();
     void closeCurrentFile();
-    void writeEntry(const LogEntry& entry);
-    String formatEntry(const LogEntry& entry) const;
+
+    /**
+     * Format and write all pending records, then flush
+     * @return Records written
+     */
+    size_t writePending();
+
+    /**
+     * Append one record as a JSON line to the write buffer
+     * @return false if it does not fit
+     */
+    bool formatRecord(const Record& record);
+
+    /**
+     * Write the write buffer to the current file
+     */
+    void writeBuffer();
+
+    static void writerTask(void* param);
     int getNextFileNumber() const;
     String getFilePath(int fileNumber) const;
 
@@ -156,9 +196,21 @@ private:
     size_t _currentFileSize;
     File _currentFile;
 
+    // Record ring (filled by log(), drained by the writer)
+    Record _records[config::SD_LOG_POOL_SLOTS];
+    size_t _recordHead;
+    size_t _recordCount;
+    size_t _recordCapacity;
+
+    // Batch buffer of formatted lines
+    char _writeBuffer[config::SD_LOG_WRITE_BUFFER_SIZE];
+    size_t _writeLength;
+    size_t _writeLines;
+
 #ifdef PLATFORM_ESP32
-    QueueHandle_t _logQueue;
+    portMUX_TYPE _recordMux;
     SemaphoreHandle_t _fileMutex;
+    TaskHandle_t _writerTask;
 #endif
 
     unsigned long _lastFlushTime;
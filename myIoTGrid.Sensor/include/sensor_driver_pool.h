@@ -0,0 +1,136 @@
+/**
+ * myIoTGrid.Sensor - Sensor Driver Pool
+ *
+ * Fixed-capacity pool of driver instances keyed by (I2C bus, address).
+ * Storage is reserved inside the owning object at build time; drivers are
+ * constructed in place during the init phase and never allocated on the
+ * read path.
+ */
+
+#ifndef SENSOR_DRIVER_POOL_H
+#define SENSOR_DRIVER_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <utility>
+
+template <typename T, size_t N>
+class SensorDriverPool {
+public:
+    /**
+     * Pool slot (driver is constructed on first use of a reserved slot)
+     */
+    struct Slot {
+        bool used;
+        int busId;
+        uint8_t address;
+        bool ready;
+        T* driver;
+    };
+
+    SensorDriverPool() {
+        for (size_t i = 0; i < N; i++) {
+            _slots[i] = { false, -1, 0, false, nullptr };
+        }
+    }
+
+    ~SensorDriverPool() { clear(); }
+
+    SensorDriverPool(const SensorDriverPool&) = delete;
+    SensorDriverPool& operator=(const SensorDriverPool&) = delete;
+
+    /**
+     * Get a ready driver
+     * @return Driver or nullptr if not initialized
+     */
+    T* find(int busId, uint8_t address) const {
+        for (size_t i = 0; i < N; i++) {
+            if (_slots[i].ready && _slots[i].busId == busId && _slots[i].address == address) {
+                return _slots[i].driver;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Get the slot for a device, reserving a free one if needed
+     * @return Slot or nullptr if the pool is exhausted
+     */
+    Slot* reserve(int busId, uint8_t address) {
+        Slot* freeSlot = nullptr;
+        for (size_t i = 0; i < N; i++) {
+            if (_slots[i].used && _slots[i].busId == busId && _slots[i].address == address) {
+                return &_slots[i];
+            }
+            if (!_slots[i].used && !freeSlot) {
+                freeSlot = &_slots[i];
+            }
+        }
+        if (freeSlot) {
+            freeSlot->used = true;
+            freeSlot->busId = busId;
+            freeSlot->address = address;
+            freeSlot->ready = false;
+        }
+        return freeSlot;
+    }
+
+    /**
+     * Construct the driver of a reserved slot in place (no-op if it exists)
+     */
+    template <typename... Args>
+    T* construct(Slot* slot, Args&&... args) {
+        if (!slot->driver) {
+            size_t index = slot - _slots;
+            slot->driver = new (_storage[index]) T(std::forward<Args>(args)...);
+        }
+        return slot->driver;
+    }
+
+    /**
+     * Destroy the drivers of devices that are no longer used
+     * @param inUse bool(int busId, uint8_t address)
+     * @return Number of slots released
+     */
+    template <typename InUse>
+    size_t releaseUnused(InUse inUse) {
+        size_t released = 0;
+        for (size_t i = 0; i < N; i++) {
+            if (_slots[i].used && !inUse(_slots[i].busId, _slots[i].address)) {
+                release(_slots[i]);
+                released++;
+            }
+        }
+        return released;
+    }
+
+    /**
+     * Destroy all drivers
+     */
+    void clear() {
+        for (size_t i = 0; i < N; i++) {
+            release(_slots[i]);
+        }
+    }
+
+    Slot* begin() { return _slots; }
+    Slot* end() { return _slots + N; }
+    const Slot* begin() const { return _slots; }
+    const Slot* end() const { return _slots + N; }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    void release(Slot& slot) {
+        if (slot.driver) {
+            slot.driver->~T();
+        }
+        slot = { false, -1, 0, false, nullptr };
+    }
+
+    alignas(T) uint8_t _storage[N][sizeof(T)];
+    Slot _slots[N];
+};
+
+#endif // SENSOR_DRIVER_POOL_H
@@ -12,7 +12,7 @@
  * - SGP30 (CO2/VOC)
  * - VL53L0X (Distance)
  * - JSN-SR04T (Ultrasonic Distance/Water Level)
- * - ADS1115 (Analog/ADC)
+ * - ADS1115 (Analog/ADC, continuous multi-channel scan)
  * - NEO-6M (GPS: Latitude/Longitude/Altitude/Speed)
  *
  * Uses Hub-provided configuration (i2cAddress, sdaPin, sclPin, etc.)
@@ -27,6 +27,12 @@
 
 #ifdef PLATFORM_ESP32
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "i2c_bus_manager.h"
+#include "sensor_driver_pool.h"
+#include "ads1115_scanner.h"
+#include "uart_manager.h"
 #include <Adafruit_Sensor.h>
 #include <Adafruit_BME280.h>
 #include <Adafruit_BME680.h>
@@ -45,6 +51,13 @@
 #include <TinyGPSPlus.h>
 #include <HardwareSerial.h>
 #include <driver/uart.h>  // ESP-IDF UART driver for SR04M-2
+#elif defined(PLATFORM_NATIVE)
+#include <map>
+#include <memory>
+
+namespace sensor {
+class SimulatedSensor;
+}
 #endif
 
 /**
@@ -60,6 +73,31 @@ struct SensorReading {
     SensorReading(const String& err) : success(false), value(0.0), error(err) {}
 };
 
+/**
+ * Single entry of a batched read (see SensorReader::readBatch)
+ */
+struct SensorBatchRequest {
+    const SensorAssignmentConfig* config;  // Sensor assignment (must outlive the batch)
+    String measurementType;                // Measurement type passed to readValue()
+    SensorReading result;                  // Filled by readBatch()
+
+    SensorBatchRequest() : config(nullptr) {}
+    SensorBatchRequest(const SensorAssignmentConfig* cfg, const String& type)
+        : config(cfg), measurementType(type) {}
+};
+
+/**
+ * Result of initializing one configured sensor (see SensorReader::initializeSensors)
+ */
+struct SensorInitResult {
+    int endpointId;
+    String sensorCode;
+    bool success;
+    String error;
+
+    SensorInitResult() : endpointId(0), success(false) {}
+};
+
 /**
  * Hardware sensor reader class
  * Manages initialization and reading of physical sensors based on Hub configuration
@@ -82,14 +120,40 @@ public:
      */
     bool initializeSensor(const SensorAssignmentConfig& config);
 
+    /**
+     * Init phase: set up drivers for every active sensor of a configuration
+     * Drivers come from fixed pools; the read path never allocates or
+     * initializes, so sensors that fail here report "not initialized" until
+     * the next init phase.
+     * @param sensors Sensor assignments from Hub
+     * @param results Optional per-sensor results (failures included)
+     * @return Number of sensors that failed to initialize
+     */
+    int initializeSensors(const std::vector<SensorAssignmentConfig>& sensors,
+                          std::vector<SensorInitResult>* results = nullptr);
+
     /**
      * Read a sensor value based on measurement type and sensor configuration
      * @param measurementType The type of measurement (temperature, humidity, pressure, etc.)
      * @param config Sensor assignment configuration from Hub
      * @return SensorReading with value or error
+     * Runs on the I2C bus workers during readBatch(), concurrently for
+     * sensors on different controllers: it may only use the sensor's own
+     * driver and must not change reader state.
      */
     SensorReading readValue(const String& measurementType, const SensorAssignmentConfig& config);
 
+    /**
+     * Read several values in one pass
+     * Requests are queued per I2C bus: devices on the same bus are read
+     * back-to-back, devices on different controllers are read concurrently.
+     * Sensors must have been set up with initializeSensors() beforehand.
+     * Native: values come from simulated stand-ins or a replayed session
+     * trace; every value read is recorded while a session trace records.
+     * @param requests Requests to read; results are written in place
+     */
+    void readBatch(std::vector<SensorBatchRequest>& requests);
+
     /**
      * Read temperature in Celsius
      */
@@ -136,7 +200,7 @@ public:
     SensorReading readWaterLevel(const SensorAssignmentConfig& config);
 
     /**
-     * Read analog value (ADS1115)
+     * Read analog value (ADS1115: last averaged value from the background scan)
      */
     SensorReading readAnalog(const SensorAssignmentConfig& config, int channel = 0);
 
@@ -290,23 +354,16 @@ public:
 
 private:
 #ifdef PLATFORM_ESP32
-    // BME280 sensor instances (indexed by I2C address for multi-sensor support)
-    Adafruit_BME280* _bme280_0x76;
-    Adafruit_BME280* _bme280_0x77;
-    bool _bme280_0x76_ready;
-    bool _bme280_0x77_ready;
-
-    // BME680 sensor instances
-    Adafruit_BME680* _bme680_0x76;
-    Adafruit_BME680* _bme680_0x77;
-    bool _bme680_0x76_ready;
-    bool _bme680_0x77_ready;
-
-    // SHT31 sensor instances
-    ClosedCube_SHT31D* _sht31_0x44;
-    ClosedCube_SHT31D* _sht31_0x45;
-    bool _sht31_0x44_ready;
-    bool _sht31_0x45_ready;
+    // Addressable I2C drivers, pooled per (bus, address) with build-time capacity
+    SensorDriverPool<Adafruit_BME280, config::SENSOR_DRIVER_POOL_SLOTS> _bme280Pool;
+    SensorDriverPool<Adafruit_BME680, config::SENSOR_DRIVER_POOL_SLOTS> _bme680Pool;
+    SensorDriverPool<ClosedCube_SHT31D, config::SENSOR_DRIVER_POOL_SLOTS> _sht31Pool;
+    SensorDriverPool<BH1750, config::SENSOR_DRIVER_POOL_SLOTS> _bh1750Pool;
+    SensorDriverPool<Adafruit_TSL2561_Unified, config::SENSOR_DRIVER_POOL_SLOTS> _tsl2561Pool;
+    SensorDriverPool<Adafruit_CCS811, config::SENSOR_DRIVER_POOL_SLOTS> _ccs811Pool;
+    SensorDriverPool<Adafruit_ADS1115, config::SENSOR_DRIVER_POOL_SLOTS> _ads1115Pool;
+    // Declared after _ads1115Pool so scanners stop before their drivers are destroyed
+    SensorDriverPool<ADS1115Scanner, config::SENSOR_DRIVER_POOL_SLOTS> _adsScannerPool;
 
     // DS18B20 (OneWire) support
     OneWire* _oneWire;
@@ -314,20 +371,6 @@ private:
     bool _ds18b20_ready;
     int _ds18b20_pin;
 
-    // BH1750 (GY-302) Light sensor
-    BH1750* _bh1750_0x23;
-    BH1750* _bh1750_0x5C;
-    bool _bh1750_0x23_ready;
-    bool _bh1750_0x5C_ready;
-
-    // TSL2561 Light sensor
-    Adafruit_TSL2561_Unified* _tsl2561_0x29;
-    Adafruit_TSL2561_Unified* _tsl2561_0x39;
-    Adafruit_TSL2561_Unified* _tsl2561_0x49;
-    bool _tsl2561_0x29_ready;
-    bool _tsl2561_0x39_ready;
-    bool _tsl2561_0x49_ready;
-
     // SCD30 CO2 sensor
     SCD30* _scd30;
     bool _scd30_ready;
@@ -336,12 +379,6 @@ private:
     SensirionI2CScd4x* _scd4x;
     bool _scd4x_ready;
 
-    // CCS811 CO2/VOC sensor
-    Adafruit_CCS811* _ccs811_0x5A;
-    Adafruit_CCS811* _ccs811_0x5B;
-    bool _ccs811_0x5A_ready;
-    bool _ccs811_0x5B_ready;
-
     // SGP30 CO2/VOC sensor
     Adafruit_SGP30* _sgp30;
     bool _sgp30_ready;
@@ -350,12 +387,6 @@ private:
     VL53L0X* _vl53l0x;
     bool _vl53l0x_ready;
 
-    // ADS1115 ADC
-    Adafruit_ADS1115* _ads1115_0x48;
-    Adafruit_ADS1115* _ads1115_0x49;
-    bool _ads1115_0x48_ready;
-    bool _ads1115_0x49_ready;
-
     // DHT22 sensor
     DHT* _dht22;
     bool _dht22_ready;
@@ -368,7 +399,7 @@ private:
 
     // NEO-6M GPS module
     TinyGPSPlus* _gps;
-    HardwareSerial* _gpsSerial;
+    UARTLease* _gpsLease;
     bool _gps_ready;
     int _gps_rx_pin;
     int _gps_tx_pin;
@@ -389,19 +420,74 @@ private:
     unsigned long _gps_last_valid_fix;
 
     // SR04M-2 Ultrasonic UART mode
-    HardwareSerial* _sr04m2Serial;
+    UARTLease* _sr04m2Lease;
     bool _sr04m2_ready;
     int _sr04m2_rx_pin;
     int _sr04m2_tx_pin;
 
-    // Current Wire/I2C instance pins
-    int _currentSdaPin;
-    int _currentSclPin;
+    // I2C bus selected by the last initI2C() call (drivers bind to _activeWire)
+    int _activeBus;
+    TwoWire* _activeWire;
+    int _bleBus;                 // Bus probed by initializeDetectedSensors()
+
+    // Keeps the init phase (drivers, _activeBus, _lastInitError) and batch
+    // reads apart; created in init()
+    SemaphoreHandle_t _stateMutex;
+    void lockState();
+    void unlockState();
+
+    /**
+     * initializeSensor() without taking _stateMutex
+     */
+    bool initSensor(const SensorAssignmentConfig& config);
 
     /**
-     * Initialize I2C bus with specific pins
+     * Select the I2C bus for a pin pair (registered once in I2CBusManager)
+     * @param requiredController Controller a Wire-only driver needs (-1 = any)
+     * @return Bus ID, -1 on failure
      */
-    void initI2C(int sdaPin = -1, int sclPin = -1);
+    int initI2C(int sdaPin = -1, int sclPin = -1, int requiredController = -1);
+
+    /**
+     * Get the I2C bus for a sensor configuration (-1 if not an I2C sensor)
+     */
+    int getBusForConfig(const SensorAssignmentConfig& config);
+
+    /**
+     * Check if a sensor code refers to an I2C device
+     */
+    static bool isI2CSensor(const String& upperSensorCode);
+
+    /**
+     * Get the registered I2C bus for a sensor's pins (-1 if never initialized)
+     */
+    int i2cBusFor(const SensorAssignmentConfig& config) const;
+
+    /**
+     * Default address of a pooled I2C driver (0 if the device has a fixed address)
+     */
+    static uint8_t defaultI2CAddress(const String& upperSensorCode);
+
+    /**
+     * Destroy pooled drivers whose bus and address no configured sensor uses
+     * Runs before the init phase so stale devices never hold pool slots.
+     */
+    void releaseUnusedDrivers(const std::vector<SensorAssignmentConfig>& sensors);
+
+    /**
+     * Reserve a pool slot for a driver on the active bus
+     * @return Slot or nullptr if the pool is exhausted
+     */
+    template <typename T, size_t N>
+    typename SensorDriverPool<T, N>::Slot* reserveSlot(SensorDriverPool<T, N>& pool,
+                                                       const char* name, uint8_t address) {
+        typename SensorDriverPool<T, N>::Slot* slot = pool.reserve(_activeBus, address);
+        if (!slot) {
+            Serial.printf("[SensorReader] %s driver pool exhausted (%u slots)\n", name, (unsigned)N);
+            _lastInitError = String(name) + " driver pool exhausted";
+        }
+        return slot;
+    }
 
     /**
      * Parse I2C address from string (e.g., "0x76" -> 0x76)
@@ -421,22 +507,41 @@ private:
     bool initCCS811(uint8_t address);
     bool initSGP30();
     bool initVL53L0X();
-    bool initADS1115(uint8_t address);
+    bool initADS1115(uint8_t address, const SensorAssignmentConfig& config);
     bool initUltrasonic(int triggerPin, int echoPin);
     bool initGPS(int rxPin, int txPin);
     bool initSR04M2(int rxPin, int txPin, int baudRate = 115200);
 
-    // Sensor getter functions
-    Adafruit_BME280* getBME280(uint8_t address);
-    Adafruit_BME680* getBME680(uint8_t address);
-    ClosedCube_SHT31D* getSHT31(uint8_t address);
-    BH1750* getBH1750(uint8_t address);
-    Adafruit_TSL2561_Unified* getTSL2561(uint8_t address);
-    Adafruit_CCS811* getCCS811(uint8_t address);
-    Adafruit_ADS1115* getADS1115(uint8_t address);
+    // Sensor getter functions (nullptr unless initialized on that bus)
+    Adafruit_BME280* getBME280(int busId, uint8_t address);
+    Adafruit_BME680* getBME680(int busId, uint8_t address);
+    ClosedCube_SHT31D* getSHT31(int busId, uint8_t address);
+    BH1750* getBH1750(int busId, uint8_t address);
+    Adafruit_TSL2561_Unified* getTSL2561(int busId, uint8_t address);
+    Adafruit_CCS811* getCCS811(int busId, uint8_t address);
+    Adafruit_ADS1115* getADS1115(int busId, uint8_t address);
+
+    /**
+     * Check if a sensor code refers to an ADS1115/ADS1015
+     */
+    static bool isADCSensor(const String& upperSensorCode);
+
+    /**
+     * ADC channel of a capability (adcChannel from the Hub, else its position)
+     */
+    static int adcChannelFor(const SensorAssignmentConfig& config, size_t capabilityIndex);
+#elif defined(PLATFORM_NATIVE)
+    // Hardware stand-ins: one simulated sensor (lib/sensor) per endpoint and type
+    std::map<String, std::unique_ptr<sensor::SimulatedSensor>> _simulated;
+
+    /**
+     * Read the stand-in (fails for types lib/sensor does not simulate)
+     */
+    SensorReading readSimulated(int endpointId, const String& measurementType);
 #endif
 
     bool _initialized;
+    String _lastInitError;  // Reason for the last initializeSensor() failure
 
     // BLE Sensor Mode: detected sensors with interval tracking
     std::vector<BleSensorInfo> _bleSensors;
@@ -5,14 +5,30 @@
  * Captures all Serial output for remote transmission.
  * Acts as a transparent proxy - forwards everything to real Serial
  * while also buffering for remote upload.
+ *
+ * Captured lines live in a fixed byte ring with a line index next to it;
+ * nothing is allocated per character or per line. Each line is stored
+ * contiguously so the uploader can read it in place. When the ring is full
+ * the oldest lines are overwritten and counted as dropped.
  */
 
 #ifndef SERIAL_CAPTURE_H
 #define SERIAL_CAPTURE_H
 
 #include <Arduino.h>
-#include <vector>
-#include <functional>
+#include "config.h"
+
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#endif
+
+/**
+ * Captured line, pointing into the capture ring (not NUL-terminated)
+ */
+struct SerialCaptureLine {
+    const char* data;
+    size_t length;
+};
 
 /**
  * SerialCapture - Captures Serial output for remote transmission
@@ -27,9 +43,9 @@ public:
 
     /**
      * Initialize capture
-     * @param bufferSize Max characters to buffer before forcing upload
+     * @param bufferSize Ring size in bytes (allocated once on first call)
      */
-    void begin(size_t bufferSize = 8192);
+    void begin(size_t bufferSize = config::SERIAL_CAPTURE_BUFFER_SIZE);
 
     /**
      * Enable/disable capture
@@ -49,43 +65,93 @@ public:
     void captureChar(char c);
 
     /**
-     * Get captured lines since last call
-     * Clears the internal buffer after returning
+     * Get the oldest captured lines without copying
+     * The lines stay valid (and are not overwritten) until consumeLines().
+     * A partial line idle for more than 500 ms is committed first.
+     * @param out Destination array
+     * @param maxLines Capacity of out
+     * @return Number of lines written to out
      */
-    std::vector<String> getAndClearLines();
+    size_t peekLines(SerialCaptureLine* out, size_t maxLines);
 
     /**
-     * Get current buffer as single string (for batch upload)
-     * Clears the internal buffer after returning
+     * Remove the oldest lines after peekLines() (0 = just release the peek)
      */
-    String getAndClearBuffer();
+    void consumeLines(size_t count);
+
+    /**
+     * Drop all captured lines
+     */
+    void clear();
 
     /**
      * Check if there's data to send
      */
-    bool hasData() const { return _lineBuffer.length() > 0 || !_completedLines.empty(); }
+    bool hasData() const { return _lineCount > 0 || _stagingLength > 0; }
 
     /**
      * Get line count waiting to be sent
      */
-    size_t getLineCount() const { return _completedLines.size(); }
+    size_t getLineCount() const { return _lineCount; }
+
+    /**
+     * Bytes/lines lost because the ring or line index was full
+     */
+    uint32_t getDroppedBytes() const { return _droppedBytes; }
+    uint32_t getDroppedLines() const { return _droppedLines; }
 
     /**
      * Check if a line should be captured (filter mode)
      * Only captures: [HW] hardware check, errors, warnings, critical
      */
-    bool shouldCaptureLine(const String& line) const;
+    bool shouldCaptureLine(const char* line) const;
 
 private:
     SerialCapture();
 
+    /**
+     * Line index entry (absolute ring position)
+     */
+    struct LineRecord {
+        uint32_t start;
+        uint16_t length;
+    };
+
+    /**
+     * Move the staged line into the ring (filter applied)
+     */
+    void commitStagedLine();
+
+    /**
+     * Drop the oldest line (caller holds the lock)
+     */
+    void dropOldestLine();
+
     bool _enabled;
     bool _initialized;
-    size_t _maxBufferSize;
 
-    String _lineBuffer;                    // Current line being built
-    std::vector<String> _completedLines;   // Completed lines ready for upload
-    unsigned long _lastCharTime;           // For detecting end of partial lines
+    // Byte ring: absolute positions grow monotonically, index = pos % capacity
+    char* _ring;
+    size_t _capacity;
+    uint32_t _writePos;
+
+    // Line index ring
+    LineRecord _lines[config::SERIAL_CAPTURE_MAX_LINES];
+    size_t _firstLine;
+    size_t _lineCount;
+    size_t _pinnedLines;               // Lines handed out by peekLines()
+
+    // Current line being built (fixed, NUL-terminated for the filter)
+    char _staging[config::SERIAL_CAPTURE_MAX_LINE_LENGTH + 1];
+    size_t _stagingLength;
+    unsigned long _lastCharTime;       // For detecting end of partial lines
+
+    uint32_t _droppedBytes;
+    uint32_t _droppedLines;
+
+#ifdef PLATFORM_ESP32
+    portMUX_TYPE _mux;
+#endif
 };
 
 // Global instance for easy access
@@ -0,0 +1,161 @@
+/**
+ * myIoTGrid.Sensor - Session Trace
+ * Record a device session, replay it deterministically on native
+ *
+ * Recording captures everything the firmware learns from outside: sensor
+ * values, the outcome and latency of every Hub request and UDP discovery.
+ * Replay (native only) answers the same calls from the trace instead of
+ * hardware and network and runs the firmware on a virtual clock
+ * (hal::native::Clock): delays cost nothing and recorded latencies move the
+ * clock, so hours of device time replay in seconds with the original
+ * schedule. The main loop profile of a replay is reproducible and can be
+ * compared between firmware builds.
+ *
+ * Trace format: one event per line, tab-separated, prefixed with "#T".
+ * Other lines are ignored, so a serial monitor log of an ESP32 built with
+ * -DSESSION_TRACE replays as it is.
+ *
+ *   #T V <version> <unix start time>
+ *   #T D <ms> <serial>                         (device serial, see setDeviceSerial)
+ *   #T S <ms> <endpointId> <type> <ok> <value|error>
+ *   #T N <ms> <method> <target> <latencyMs> <status> <ok> <etag> <body> <error>
+ *
+ * <ms> counts from begin(). Text fields escape \t, \n, \r and \\.
+ *
+ * Replay matches events by endpoint and type (S) or method and target (N)
+ * in recorded order; the device serial inside targets is mapped to the
+ * replaying device. Unmatched calls count as misses (divergence from the
+ * recorded session).
+ *
+ * A replay can record at the same time: the new trace holds what the
+ * firmware got during the replay (misses included) and matches the
+ * original apart from the <ms> column if the firmware behaved the same.
+ */
+
+#ifndef SESSION_TRACE_H
+#define SESSION_TRACE_H
+
+#include <Arduino.h>
+
+#ifdef PLATFORM_NATIVE
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#endif
+
+/**
+ * Outcome of one network exchange (Hub request or discovery)
+ */
+struct TraceExchange {
+    int statusCode;             // HTTP status, 0 = transport error
+    bool success;
+    String body;
+    String etag;
+    String error;
+    unsigned long latencyMs;
+
+    TraceExchange() : statusCode(0), success(false), latencyMs(0) {}
+};
+
+class SessionTrace {
+public:
+    enum class Mode { OFF, RECORD, REPLAY };
+
+    static SessionTrace& getInstance();
+
+    /**
+     * Select the mode and open the trace (repeated calls return the first result)
+     * Native: SESSION_RECORD=<file> and/or SESSION_REPLAY=<file>,
+     *         SESSION_RECORD_SECONDS limits a recording
+     * ESP32:  records to Serial when built with -DSESSION_TRACE
+     * @return false if the trace file cannot be opened or parsed
+     */
+    bool begin();
+
+    Mode getMode() const { return _mode; }
+    bool isRecording() const { return _recording; }    // Also while replaying (see begin())
+    bool isReplaying() const { return _mode == Mode::REPLAY; }
+    bool isActive() const { return _mode != Mode::OFF; }
+
+    /**
+     * Serial of this device (recorded; used to map targets during replay)
+     */
+    void setDeviceSerial(const String& serial);
+
+    void recordExchange(const char* method, const String& target, const TraceExchange& exchange);
+    void recordSensor(int endpointId, const String& type, bool success, double value, const String& error);
+
+    /**
+     * Answer a network call from the trace (replay only)
+     * Advances the virtual clock by the recorded latency. A call without a
+     * recorded counterpart is a miss and fails with status 0.
+     * @return false when not replaying
+     */
+    bool replayExchange(const char* method, const String& target, TraceExchange& exchange);
+
+    /**
+     * Answer a sensor read from the trace (replay only)
+     * @return false when not replaying or on a miss
+     */
+    bool replaySensor(int endpointId, const String& type, bool& success, double& value, String& error);
+
+    /**
+     * Replay done: all events used, or the virtual clock passed the last
+     * event by config::SESSION_REPLAY_END_GRACE_MS.
+     * Recording done: SESSION_RECORD_SECONDS elapsed (never without it)
+     */
+    bool isFinished();
+
+    // Replay statistics
+    size_t getEventCount() const { return _eventCount; }
+    size_t getReplayedCount() const { return _replayedCount; }
+    size_t getMissCount() const { return _missCount; }
+    unsigned long getMaxDriftMs() const { return _maxDriftMs; }    // Largest |replay time - recorded time|
+    unsigned long getSessionLengthMs() const { return _lastEventMs; }
+
+private:
+    SessionTrace();
+
+    // Prevent copying
+    SessionTrace(const SessionTrace&) = delete;
+    SessionTrace& operator=(const SessionTrace&) = delete;
+
+    unsigned long elapsedMs() const;
+    void writeLine(const String& line);
+    void countRecorded();
+    void noteReplayed(unsigned long recordedMs);
+
+    Mode _mode;
+    bool _started;
+    bool _ready;
+    bool _recording;
+    unsigned long _startMs;
+    unsigned long _recordLimitMs;   // 0 = until the process ends
+    String _deviceSerial;
+
+    size_t _eventCount;
+    size_t _replayedCount;
+    size_t _missCount;
+    unsigned long _maxDriftMs;
+    unsigned long _lastEventMs;
+
+#ifdef PLATFORM_NATIVE
+    struct Event {
+        unsigned long atMs;
+        TraceExchange exchange;     // N: outcome; S: success, error
+        double value;               // S only
+
+        Event() : atMs(0), value(0.0) {}
+    };
+
+    bool load(const char* path);
+    bool parseEvent(const std::vector<std::string>& fields, const String& recordedSerial);
+
+    std::ofstream _file;
+    std::map<std::string, std::deque<Event>> _queues;   // Key: "S <endpoint> <type>" / "N <method> <target>"
+#endif
+};
+
+#endif // SESSION_TRACE_H
@@ -0,0 +1,132 @@
+/**
+ * myIoTGrid.Sensor - Loop Stall Profiler
+ * Finds the blocking calls that stall loop()
+ *
+ * loop() publishes progress markers: the start and end of every iteration
+ * and the stack of instrumentation stages it is in (every TIMED_SCOPE and
+ * per-driver sensor read on the loop task pushes its stage). A monitor task
+ * samples them every config::STALL_SAMPLE_INTERVAL_MS. When an iteration
+ * passes config::STALL_THRESHOLD_MS, it captures the active stages and a
+ * backtrace of the loop task; the iteration's final duration is filled in
+ * when it ends. The config::STALL_WORST_COUNT longest stalls are kept.
+ *
+ * ESP32: the monitor runs on the loop task's core at a higher priority, so
+ * the loop task is never running while it is sampled. Backtraces (Xtensa
+ * only) are raw return addresses:
+ *   xtensa-esp32-elf-addr2line -pfiaC -e firmware.elf 0x400d1234 ...
+ * Native: a sampler thread on real time, stages only. Off during session
+ * replay, where the replay profile covers loop timing.
+ *
+ * Reported by the "stalls" serial command and as the "stalls" object of the
+ * hardware status report.
+ */
+
+#ifndef STALL_MONITOR_H
+#define STALL_MONITOR_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <mutex>
+#include <thread>
+#endif
+
+/**
+ * One stalled loop iteration
+ */
+struct LoopStall {
+    uint32_t iteration;
+    unsigned long startMs;                              // millis() at the start of the iteration
+    unsigned long durationMs;                           // Whole iteration
+    int stages[config::STALL_STAGE_DEPTH];              // Instrumentation stage ids, outermost first
+    uint8_t stageCount;
+    uint32_t backtrace[config::STALL_BACKTRACE_DEPTH];  // Innermost first
+    uint8_t backtraceDepth;
+
+    LoopStall() : iteration(0), startMs(0), durationMs(0), stageCount(0), backtraceDepth(0) {}
+};
+
+class StallMonitor {
+public:
+    static StallMonitor& getInstance();
+
+    /**
+     * Start the monitor; the calling task (loop()) is the one observed
+     */
+    void begin();
+
+    // Progress markers (loop task)
+    void beginIteration();
+    void endIteration();
+
+    /**
+     * Push an instrumentation stage (no effect outside the loop task)
+     * @return true if pushed; pass it to exitStage()
+     */
+    bool enterStage(int stageId);
+    void exitStage(bool entered);
+
+    void reset();
+
+    /**
+     * Stalls object of the hardware status report (ReportHardwareStatusDto.Stalls)
+     * {"thresholdMs":..,"stallCount":..,"worst":[{"durationMs","startMs","stage","backtrace"}]}
+     * Worst first; stage is "a > b" (outermost first), backtrace hex addresses.
+     */
+    String toJson() const;
+
+    void printReport() const;
+
+    uint32_t getStallCount() const { return _stallCount; }
+
+private:
+    StallMonitor();
+
+    // Prevent copying
+    StallMonitor(const StallMonitor&) = delete;
+    StallMonitor& operator=(const StallMonitor&) = delete;
+
+    bool onLoopTask() const;
+    void sample();
+    void captureBacktrace(LoopStall& stall);
+    void keepWorst(const LoopStall& stall);
+    size_t copyWorst(LoopStall* out) const;   // Sorted, longest first
+    String stageName(const LoopStall& stall) const;
+
+    // Written by the loop task, read by the monitor
+    std::atomic<uint32_t> _iteration;
+    std::atomic<unsigned long> _iterationStartMs;
+    std::atomic<bool> _inIteration;
+    std::atomic<int> _stageDepth;
+    std::atomic<int> _stageStack[config::STALL_STAGE_DEPTH];
+
+    // Guarded by the lock
+    LoopStall _open;              // Captured stall of the running iteration
+    bool _openValid;
+    LoopStall _worst[config::STALL_WORST_COUNT];
+    size_t _worstCount;
+    uint32_t _stallCount;
+
+    bool _started;
+    bool _active;                 // Monitor running: markers are recorded
+
+#ifdef PLATFORM_ESP32
+    static void monitorTask(void* param);
+
+    TaskHandle_t _loopTask;
+    TaskHandle_t _monitorTask;
+    mutable portMUX_TYPE _mux;
+#else
+    void monitorThread();
+
+    std::thread::id _loopThread;
+    mutable std::mutex _mutex;
+#endif
+};
+
+#endif // STALL_MONITOR_H
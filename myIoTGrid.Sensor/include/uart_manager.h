@@ -1,15 +1,19 @@
 /**
  * myIoTGrid.Sensor - UART Manager
  *
- * Dynamic UART port allocation for ESP32 based on pin configuration.
+ * Lease-based UART routing for ESP32 based on pin configuration.
  * ESP32 has 3 UARTs (0, 1, 2) with GPIO matrix allowing any UART on any pin.
  *
  * UART0 = Reserved for USB serial (pins 1/3)
  * UART1 = Available for sensors (default pins 9/10 are flash, but can remap)
  * UART2 = Available for sensors (default pins 16/17)
  *
- * This manager dynamically allocates UART1 or UART2 based on availability,
- * preventing conflicts when multiple UART devices are used.
+ * An owner acquires a lease on a pin pair and gets UART1 or UART2 with its
+ * own RX ring buffer. A pump task drains the hardware driver into the lease
+ * ring and into any diagnostics taps attached to the same port, so a tap
+ * can watch the raw byte stream without taking the port away from its
+ * owner. Re-acquiring with a different baud rate (or inverting RX) is done
+ * in place: the driver stays installed and buffered bytes are kept.
  */
 
 #ifndef UART_MANAGER_H
@@ -18,24 +22,138 @@
 #include <Arduino.h>
 
 #ifdef PLATFORM_ESP32
-#include <HardwareSerial.h>
 #include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "config.h"
+
+#define UART_LEASE_COUNT 2
+
+/**
+ * UART lease owners
+ */
+enum class UARTOwner : uint8_t {
+    NONE = 0,
+    GPS,             // NEO-6M GPS (SensorReader)
+    SR04M2,          // SR04M-2 ultrasonic UART mode (SensorReader)
+    GPS_SCAN,        // HardwareScanner NMEA probe
+    SR04M2_SCAN,     // HardwareScanner SR04M-2 probe
+    GPS_DEBUG        // HardwareScanner GPS diagnostics
+};
+
+/**
+ * Get display name of a lease owner
+ */
+const char* uartOwnerName(UARTOwner owner);
+
+/**
+ * Single-producer RX ring buffer (oldest bytes are overwritten when full)
+ */
+class UARTRxBuffer {
+public:
+    UARTRxBuffer();
+    ~UARTRxBuffer();
+
+    // Prevent copying
+    UARTRxBuffer(const UARTRxBuffer&) = delete;
+    UARTRxBuffer& operator=(const UARTRxBuffer&) = delete;
+
+    /**
+     * Number of buffered bytes
+     */
+    size_t available() const;
+
+    /**
+     * Read one byte
+     * @return Byte value or -1 if empty
+     */
+    int read();
+
+    /**
+     * Read up to len bytes
+     * @return Bytes copied
+     */
+    size_t read(uint8_t* buffer, size_t len);
+
+    /**
+     * Discard buffered bytes
+     */
+    void clear();
+
+    /**
+     * Bytes lost because the consumer did not keep up
+     */
+    uint32_t getOverrunCount() const { return _overruns; }
+
+protected:
+    friend class UARTManager;
+
+    bool allocate(size_t capacity);
+    void deallocate();
+    void push(const uint8_t* data, size_t len);
+
+private:
+    uint8_t* _buffer;
+    size_t _capacity;
+    size_t _head;
+    size_t _count;
+    uint32_t _overruns;
+    mutable portMUX_TYPE _mux;
+};
+
+/**
+ * Port lease: exclusive owner of a UART with its own RX ring
+ */
+class UARTLease : public UARTRxBuffer {
+public:
+    UARTLease();
+
+    UARTOwner getOwner() const { return _owner; }
+    int getUartNum() const { return _uartNum; }
+    int getRxPin() const { return _rxPin; }
+    int getTxPin() const { return _txPin; }
+    int getBaudRate() const { return _baudRate; }
+
+    /**
+     * Write bytes to TX (no-op in RX-only mode)
+     * @return Bytes queued
+     */
+    size_t write(const uint8_t* data, size_t len);
+    size_t write(uint8_t byte) { return write(&byte, 1); }
+
+    /**
+     * Drop pending bytes in the driver and the lease ring
+     */
+    void flushInput();
+
+private:
+    friend class UARTManager;
+
+    UARTOwner _owner;
+    int _uartNum;            // 1 or 2, -1 if free
+    int _rxPin;
+    int _txPin;              // -1 for RX-only mode
+    int _baudRate;
+    bool _rxInverted;
+};
 
 /**
- * UART allocation info
+ * Diagnostics tap: read-only mirror of a leased port's RX stream
  */
-struct UARTAllocation {
-    int uartNum;              // UART number (1 or 2), -1 if not allocated
-    int rxPin;                // RX pin
-    int txPin;                // TX pin (-1 if not used)
-    int baudRate;             // Baud rate
-    String owner;             // Owner identifier (e.g., "GPS", "SR04M2")
-    HardwareSerial* serial;   // Arduino serial instance
-    bool useEspIdf;           // Use ESP-IDF API instead of Arduino
+class UARTTap : public UARTRxBuffer {
+public:
+    UARTTap();
+
+    int getUartNum() const { return _uartNum; }
+
+private:
+    friend class UARTManager;
+
+    int _uartNum;            // Port being mirrored, -1 if closed
 };
 
 /**
- * UART Manager - Singleton for managing ESP32 UART allocations
+ * UART Manager - Singleton for managing ESP32 UART leases
  */
 class UARTManager {
 public:
@@ -45,56 +163,54 @@ public:
     static UARTManager& getInstance();
 
     /**
-     * Allocate a UART for the given pins and owner
+     * Acquire (or update) the lease of an owner
+     * Re-acquiring the same pins only changes the baud rate; the driver and
+     * the buffered RX bytes are kept.
+     * @param owner Lease owner
      * @param rxPin RX pin (required)
      * @param txPin TX pin (-1 for RX-only mode)
      * @param baudRate Baud rate
-     * @param owner Identifier string for debugging
-     * @param useEspIdf Use ESP-IDF API (for SR04M-2 etc) instead of Arduino
-     * @return UART number (1 or 2) on success, -1 on failure
+     * @return Lease or nullptr if the pins are leased by another owner or no UART is free
      */
-    int allocate(int rxPin, int txPin, int baudRate, const String& owner, bool useEspIdf = false);
+    UARTLease* acquire(UARTOwner owner, int rxPin, int txPin, int baudRate);
 
     /**
-     * Get HardwareSerial instance for a UART number
-     * @param uartNum UART number (1 or 2)
-     * @return HardwareSerial pointer or nullptr if not allocated or using ESP-IDF
+     * Get the lease of an owner
+     * @return Lease or nullptr if the owner holds none
      */
-    HardwareSerial* getSerial(int uartNum);
+    UARTLease* getLease(UARTOwner owner);
 
     /**
-     * Get UART number for a given owner
-     * @param owner Owner identifier
-     * @return UART number (1 or 2), -1 if not found
+     * Get the lease using an RX pin
+     * @return Lease or nullptr if the pin is not leased
      */
-    int getUartForOwner(const String& owner);
+    UARTLease* getLeaseForPin(int rxPin);
 
     /**
-     * Get UART number for given pins (checks if already allocated)
-     * @param rxPin RX pin
-     * @param txPin TX pin (-1 to ignore)
-     * @return UART number (1 or 2), -1 if not found
+     * Change the baud rate of a lease in place
      */
-    int getUartForPins(int rxPin, int txPin = -1);
+    bool setBaudRate(UARTLease* lease, int baudRate);
 
     /**
-     * Release a UART allocation by UART number
-     * @param uartNum UART number (1 or 2)
+     * Enable/disable RX signal inversion of a lease in place
+     */
+    bool setRxInverted(UARTLease* lease, bool inverted);
+
+    /**
+     * Release the lease of an owner (closes taps on that port)
      */
-    void release(int uartNum);
+    void release(UARTOwner owner);
 
     /**
-     * Release a UART allocation by owner
-     * @param owner Owner identifier
+     * Attach a diagnostics tap to the port leased on an RX pin
+     * @return Tap or nullptr if the pin is not leased or no tap is free
      */
-    void releaseByOwner(const String& owner);
+    UARTTap* openTap(int rxPin);
 
     /**
-     * Release a UART allocation by pins
-     * @param rxPin RX pin
-     * @param txPin TX pin (-1 to match any)
+     * Detach a tap
      */
-    void releaseByPins(int rxPin, int txPin = -1);
+    void closeTap(UARTTap* tap);
 
     /**
      * Check if a UART is available
@@ -104,18 +220,12 @@ public:
     bool isAvailable(int uartNum);
 
     /**
-     * Get first available UART number
-     * @return UART number (1 or 2), -1 if none available
-     */
-    int getFirstAvailable();
-
-    /**
-     * Print current UART allocations for debugging
+     * Print current UART leases for debugging
      */
     void printAllocations();
 
     /**
-     * End all UART allocations (cleanup)
+     * Release all leases (cleanup)
      */
     void releaseAll();
 
@@ -127,27 +237,67 @@ private:
     UARTManager(const UARTManager&) = delete;
     UARTManager& operator=(const UARTManager&) = delete;
 
-    // UART allocations (index 0 = UART1, index 1 = UART2)
-    UARTAllocation _allocations[2];
+    // Leases (index 0 = UART1, index 1 = UART2)
+    UARTLease _leases[UART_LEASE_COUNT];
+    UARTTap _taps[config::UART_MAX_TAPS];
 
-    // Arduino HardwareSerial instances (created on demand)
-    HardwareSerial* _serial1;
-    HardwareSerial* _serial2;
+    SemaphoreHandle_t _mutex;
+    TaskHandle_t _pumpTask;
 
     /**
-     * Initialize a UART using ESP-IDF API
+     * Get first available UART number (UART2 preferred)
+     * @return UART number (1 or 2), -1 if none available
      */
-    bool initEspIdf(int uartNum, int rxPin, int txPin, int baudRate);
+    int getFirstAvailable();
+
+    /**
+     * Install the ESP-IDF driver for a lease
+     */
+    bool initDriver(UARTLease& lease);
 
     /**
-     * Initialize a UART using Arduino API
+     * Remove a lease's driver and free its ring
      */
-    bool initArduino(int uartNum, int rxPin, int txPin, int baudRate);
+    void releaseLease(UARTLease& lease);
 
     /**
-     * End a UART
+     * Move driver RX data into lease rings and taps
      */
-    void endUart(int uartNum);
+    void pump();
+
+    static void pumpTask(void* param);
+};
+
+/**
+ * Scoped RX access for probes and diagnostics
+ * Taps the port if the RX pin is already leased (the owner keeps its data),
+ * otherwise takes a temporary lease that is released on destruction.
+ */
+class UARTProbe {
+public:
+    UARTProbe(UARTOwner owner, int rxPin, int txPin, int baudRate);
+    ~UARTProbe();
+
+    // Prevent copying
+    UARTProbe(const UARTProbe&) = delete;
+    UARTProbe& operator=(const UARTProbe&) = delete;
+
+    /**
+     * RX stream, nullptr if neither a tap nor a lease was available
+     */
+    UARTRxBuffer* rx() const;
+
+    /**
+     * Temporary lease (nullptr when tapping; taps cannot transmit)
+     */
+    UARTLease* lease() const { return _lease; }
+
+    bool isTap() const { return _tap != nullptr; }
+
+private:
+    UARTOwner _owner;
+    UARTLease* _lease;
+    UARTTap* _tap;
 };
 
 #endif // PLATFORM_ESP32
@@ -0,0 +1,144 @@
+#ifndef CONNECTION_INTERFACE_H
+#define CONNECTION_INTERFACE_H
+
+#include "data_types.h"
+#include "hal/hal.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace connection {
+
+/**
+ * Callback type for configuration updates
+ */
+using ConfigCallback = std::function<void(const data::NodeConfig&)>;
+
+/**
+ * Connection result structure
+ */
+struct ConnectionResult {
+    bool success;
+    std::string errorMessage;
+    int statusCode;
+
+    ConnectionResult() : success(false), statusCode(0) {}
+
+    static ConnectionResult ok() {
+        ConnectionResult r;
+        r.success = true;
+        r.statusCode = 200;
+        return r;
+    }
+
+    static ConnectionResult error(const std::string& msg, int code = 0) {
+        ConnectionResult r;
+        r.success = false;
+        r.errorMessage = msg;
+        r.statusCode = code;
+        return r;
+    }
+};
+
+/**
+ * Completion callback for IConnection::sendReadingsAsync()
+ * @param latencyUs Time from submission until the final result (queueing and retries included)
+ */
+using SendCallback = std::function<void(const data::Reading&, const ConnectionResult&, uint32_t latencyUs)>;
+
+/**
+ * Interface for connection implementations
+ *
+ * Supports different connection modes:
+ * - HTTP (REST API)
+ * - MQTT (broker, QoS 1 batches)
+ * - LoRaWAN (future Sprint S3)
+ */
+class IConnection {
+public:
+    virtual ~IConnection() = default;
+
+    /**
+     * Connect to the Hub
+     * @return true if connection successful
+     */
+    virtual bool connect() = 0;
+
+    /**
+     * Check if currently connected
+     * @return true if connected
+     */
+    virtual bool isConnected() const = 0;
+
+    /**
+     * Disconnect from the Hub
+     */
+    virtual void disconnect() = 0;
+
+    /**
+     * Register this node with the Hub
+     * Sends NodeInfo and receives NodeConfig
+     *
+     * @param info Node information to register
+     * @return Received NodeConfig (check isValid())
+     */
+    virtual data::NodeConfig registerNode(const data::NodeInfo& info) = 0;
+
+    /**
+     * Send a sensor reading to the Hub
+     *
+     * @param reading Reading to send
+     * @return ConnectionResult with status
+     */
+    virtual ConnectionResult sendReading(const data::Reading& reading) = 0;
+
+    /**
+     * Send readings without waiting for the Hub
+     * Transports with an asynchronous path queue the readings, keep a
+     * bounded number of requests in flight and invoke the callback from
+     * poll() on the caller's thread. Readings that do not fit the queue
+     * complete with an error immediately.
+     * Default: sendReading() for each reading, callback before returning.
+     *
+     * @param readings First reading
+     * @param count Number of readings
+     * @param callback Invoked once per reading
+     * @return Number of readings accepted
+     */
+    virtual size_t sendReadingsAsync(const data::Reading* readings, size_t count, SendCallback callback) {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t start = hal::micros();
+            ConnectionResult result = sendReading(readings[i]);
+            if (callback) {
+                callback(readings[i], result, hal::micros() - start);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Set callback for configuration updates
+     * Called when Hub pushes new configuration
+     *
+     * @param callback Function to call on config update
+     */
+    virtual void onConfigReceived(ConfigCallback callback) = 0;
+
+    /**
+     * Get the connection mode identifier
+     * @return Mode string ("http", "mqtt", "lorawan")
+     */
+    virtual std::string getMode() const = 0;
+
+    /**
+     * Service the connection from the main loop
+     * Stateful transports use it for keep-alive, reconnects, incoming
+     * messages and deferred sends. Default: nothing to do.
+     * @return Milliseconds until poll() needs to run again, UINT32_MAX if never
+     */
+    virtual uint32_t poll() { return UINT32_MAX; }
+};
+
+} // namespace connection
+
+#endif // CONNECTION_INTERFACE_H
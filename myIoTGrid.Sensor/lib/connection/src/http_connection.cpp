@@ -0,0 +1,288 @@
+#include "http_connection.h"
+#include "hal/hal.h"
+#include "config.h"
+
+namespace connection {
+
+HttpConnection::HttpConnection(const std::string& endpoint)
+    : endpoint_(endpoint)
+    , connected_(false)
+    , configCallback_(nullptr)
+    , queue_()
+    , retries_()
+    , inFlight_(0)
+    , completions_(std::make_shared<CompletionQueue>())
+{
+}
+
+bool HttpConnection::connect() {
+    // For HTTP, we just verify we can reach the endpoint
+    hal::log_info("HttpConnection: Connecting to " + endpoint_);
+
+    // Try a simple health check
+    std::string healthUrl = buildUrl("/health");
+    auto response = hal::http_get(healthUrl, config::HTTP_TIMEOUT_MS);
+
+    if (response.success) {
+        connected_ = true;
+        hal::log_info("HttpConnection: Connected successfully");
+        return true;
+    }
+
+    // Health endpoint might not exist, that's okay
+    // Just mark as "connected" since HTTP is stateless
+    connected_ = true;
+    hal::log_info("HttpConnection: Ready (health check skipped)");
+    return true;
+}
+
+bool HttpConnection::isConnected() const {
+    return connected_;
+}
+
+void HttpConnection::disconnect() {
+    connected_ = false;
+    hal::log_info("HttpConnection: Disconnected");
+}
+
+data::NodeConfig HttpConnection::registerNode(const data::NodeInfo& info) {
+    data::NodeConfig config;
+
+    std::string url = buildUrl(config::API_REGISTER);
+    std::string json = data::JsonSerializer::serializeNodeInfo(info);
+
+    hal::log_info("HttpConnection: Registering node at " + url);
+    hal::log_info("HttpConnection: Payload: " + json);
+
+    // Single attempt: NodeController retries registration on a timer
+    auto response = hal::http_post(url, json, config::HTTP_TIMEOUT_MS);
+
+    if (!response.success) {
+        hal::log_error("HttpConnection: Registration failed - " + response.errorMessage);
+        return config; // Return invalid config
+    }
+
+    if (response.statusCode < 200 || response.statusCode >= 300) {
+        hal::log_error("HttpConnection: Registration failed with status " +
+                      std::to_string(response.statusCode));
+        hal::log_error("HttpConnection: Response: " + response.body);
+        return config;
+    }
+
+    // Parse response
+    if (!data::JsonSerializer::deserializeNodeConfig(response.body, config)) {
+        hal::log_error("HttpConnection: Failed to parse config response");
+        hal::log_error("HttpConnection: Response body: " + response.body);
+        return config;
+    }
+
+    hal::log_info("HttpConnection: Registration successful");
+    hal::log_info("HttpConnection: Device ID: " + config.deviceId);
+    hal::log_info("HttpConnection: Interval: " + std::to_string(config.intervalSeconds) + "s");
+
+    // Notify callback if set
+    if (configCallback_) {
+        configCallback_(config);
+    }
+
+    return config;
+}
+
+ConnectionResult HttpConnection::sendReading(const data::Reading& reading) {
+    std::string url = buildUrl(config::API_READINGS);
+    std::string json = data::JsonSerializer::serializeReading(reading);
+
+    hal::log_debug("HttpConnection: Sending reading to " + url);
+    hal::log_debug("HttpConnection: Payload: " + json);
+
+    auto response = postWithRetry(url, json, config::HTTP_RETRY_COUNT);
+
+    ConnectionResult result = toResult(response);
+    if (result.success) {
+        hal::log_info("HttpConnection: Reading sent successfully (" +
+                     reading.type + " = " + std::to_string(reading.value) + " " + reading.unit + ")");
+    }
+    return result;
+}
+
+size_t HttpConnection::sendReadingsAsync(const data::Reading* readings, size_t count,
+                                         SendCallback callback) {
+    size_t accepted = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (queue_.size() + retries_.size() + inFlight_ >= config::HTTP_ASYNC_QUEUE_SIZE) {
+            if (callback) {
+                callback(readings[i], ConnectionResult::error("Send queue full"), 0);
+            }
+            continue;
+        }
+
+        AsyncSend send;
+        send.reading = readings[i];
+        send.json = data::JsonSerializer::serializeReading(readings[i]);
+        send.callback = callback;
+        send.startedUs = hal::micros();
+        send.attempt = 1;
+        send.retryAt = 0;
+        queue_.push_back(std::move(send));
+        accepted++;
+    }
+
+    startSends();
+    return accepted;
+}
+
+void HttpConnection::onConfigReceived(ConfigCallback callback) {
+    configCallback_ = callback;
+}
+
+std::string HttpConnection::getMode() const {
+    return "http";
+}
+
+uint32_t HttpConnection::poll() {
+    std::deque<Completion> done;
+    {
+        std::lock_guard<std::mutex> lock(completions_->mutex);
+        done.swap(completions_->done);
+    }
+
+    for (auto& completion : done) {
+        inFlight_--;
+        AsyncSend& send = completion.send;
+
+        if (!completion.response.success && send.attempt < config::HTTP_RETRY_COUNT) {
+            hal::log_warn("HttpConnection: Attempt " + std::to_string(send.attempt) +
+                         " failed, retrying in " +
+                         std::to_string(config::HTTP_RETRY_DELAY_MS / 1000) + "s...");
+            send.attempt++;
+            send.retryAt = hal::millis() + config::HTTP_RETRY_DELAY_MS;
+            retries_.push_back(std::move(send));
+            continue;
+        }
+
+        finishSend(send, completion.response);
+    }
+
+    startSends();
+
+    if (inFlight_ > 0) {
+        return config::HTTP_COMPLETION_POLL_MS;
+    }
+    if (!retries_.empty()) {
+        int32_t untilRetry = static_cast<int32_t>(retries_.front().retryAt - hal::millis());
+        return untilRetry > 0 ? static_cast<uint32_t>(untilRetry) : 0;
+    }
+    return UINT32_MAX;
+}
+
+size_t HttpConnection::getPendingCount() const {
+    return queue_.size() + retries_.size() + inFlight_;
+}
+
+void HttpConnection::setEndpoint(const std::string& endpoint) {
+    endpoint_ = endpoint;
+}
+
+std::string HttpConnection::getEndpoint() const {
+    return endpoint_;
+}
+
+std::string HttpConnection::buildUrl(const std::string& path) const {
+    std::string url = endpoint_;
+
+    // Remove trailing slash from endpoint
+    if (!url.empty() && url.back() == '/') {
+        url.pop_back();
+    }
+
+    // Ensure path starts with /
+    if (path.empty() || path[0] != '/') {
+        url += '/';
+    }
+
+    url += path;
+    return url;
+}
+
+void HttpConnection::startSends() {
+    uint32_t now = hal::millis();
+
+    while (inFlight_ < config::HTTP_ASYNC_MAX_IN_FLIGHT) {
+        AsyncSend send;
+        if (!retries_.empty() && static_cast<int32_t>(retries_.front().retryAt - now) <= 0) {
+            send = std::move(retries_.front());
+            retries_.pop_front();
+        } else if (!queue_.empty()) {
+            send = std::move(queue_.front());
+            queue_.pop_front();
+        } else {
+            break;
+        }
+
+        hal::log_debug("HttpConnection: Sending reading to " + buildUrl(config::API_READINGS));
+        hal::log_debug("HttpConnection: Payload: " + send.json);
+
+        inFlight_++;
+        std::string json = send.json;
+        std::shared_ptr<CompletionQueue> completions = completions_;
+        hal::http_post_async(buildUrl(config::API_READINGS), json, config::HTTP_TIMEOUT_MS,
+            [completions, send](const hal::HttpResponse& response) {
+                std::lock_guard<std::mutex> lock(completions->mutex);
+                completions->done.push_back({send, response});
+            });
+    }
+}
+
+void HttpConnection::finishSend(AsyncSend& send, const hal::HttpResponse& response) {
+    ConnectionResult result = toResult(response);
+
+    if (result.success) {
+        hal::log_info("HttpConnection: Reading sent successfully (" + send.reading.type + " = " +
+                     std::to_string(send.reading.value) + " " + send.reading.unit + ")");
+    } else if (send.attempt > 1) {
+        hal::log_error("HttpConnection: All " + std::to_string(send.attempt) + " attempts failed");
+    }
+
+    if (send.callback) {
+        send.callback(send.reading, result, hal::micros() - send.startedUs);
+    }
+}
+
+ConnectionResult HttpConnection::toResult(const hal::HttpResponse& response) {
+    if (response.statusCode >= 200 && response.statusCode < 300) {
+        return ConnectionResult::ok();
+    }
+    if (response.statusCode > 0) {
+        return ConnectionResult::error(
+            "HTTP " + std::to_string(response.statusCode) + ": " + response.body,
+            response.statusCode
+        );
+    }
+    return ConnectionResult::error(response.errorMessage, response.statusCode);
+}
+
+hal::HttpResponse HttpConnection::postWithRetry(const std::string& url,
+                                                const std::string& json,
+                                                int retries) {
+    hal::HttpResponse response;
+
+    for (int attempt = 1; attempt <= retries; ++attempt) {
+        response = hal::http_post(url, json, config::HTTP_TIMEOUT_MS);
+
+        if (response.success) {
+            return response;
+        }
+
+        if (attempt < retries) {
+            hal::log_warn("HttpConnection: Attempt " + std::to_string(attempt) +
+                         " failed, retrying in 1s...");
+            hal::delay_ms(config::HTTP_RETRY_DELAY_MS);
+        }
+    }
+
+    hal::log_error("HttpConnection: All " + std::to_string(retries) + " attempts failed");
+    return response;
+}
+
+} // namespace connection
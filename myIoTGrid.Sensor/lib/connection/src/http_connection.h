@@ -0,0 +1,131 @@
+#ifndef HTTP_CONNECTION_H
+#define HTTP_CONNECTION_H
+
+#include "connection_interface.h"
+#include "json_serializer.h"
+#include "hal/hal.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace connection {
+
+/**
+ * HTTP-based connection to Hub API
+ *
+ * Uses REST API endpoints:
+ * - POST /api/devices/register - Register node
+ * - POST /api/readings - Send sensor reading
+ *
+ * sendReadingsAsync() posts readings via hal::http_post_async() with at
+ * most HTTP_ASYNC_MAX_IN_FLIGHT requests outstanding; further readings wait
+ * in a bounded queue. Responses land in a completion queue that poll()
+ * drains: failed posts are retried after HTTP_RETRY_DELAY_MS (up to
+ * HTTP_RETRY_COUNT attempts) without blocking the caller.
+ */
+class HttpConnection : public IConnection {
+public:
+    /**
+     * Create HTTP connection
+     * @param endpoint Base URL of Hub API (e.g., "http://localhost:5000")
+     */
+    explicit HttpConnection(const std::string& endpoint);
+
+    ~HttpConnection() override = default;
+
+    // IConnection interface
+    bool connect() override;
+    bool isConnected() const override;
+    void disconnect() override;
+    data::NodeConfig registerNode(const data::NodeInfo& info) override;
+    ConnectionResult sendReading(const data::Reading& reading) override;
+    size_t sendReadingsAsync(const data::Reading* readings, size_t count, SendCallback callback) override;
+    void onConfigReceived(ConfigCallback callback) override;
+    std::string getMode() const override;
+    uint32_t poll() override;
+
+    /**
+     * Asynchronous sends not yet completed (queued, in flight or waiting for retry)
+     */
+    size_t getPendingCount() const;
+
+    /**
+     * Set the base endpoint URL
+     * @param endpoint Base URL (e.g., "http://localhost:5000")
+     */
+    void setEndpoint(const std::string& endpoint);
+
+    /**
+     * Get the current endpoint URL
+     */
+    std::string getEndpoint() const;
+
+private:
+    struct AsyncSend {
+        data::Reading reading;
+        std::string json;
+        SendCallback callback;
+        uint32_t startedUs;
+        int attempt;
+        uint32_t retryAt;               // hal::millis() of the next attempt
+    };
+
+    struct Completion {
+        AsyncSend send;
+        hal::HttpResponse response;
+    };
+
+    // Shared with transport callbacks, so responses arriving after the
+    // connection was destroyed have somewhere to go
+    struct CompletionQueue {
+        std::mutex mutex;
+        std::deque<Completion> done;
+    };
+
+    std::string endpoint_;
+    bool connected_;
+    ConfigCallback configCallback_;
+
+    std::deque<AsyncSend> queue_;       // Waiting for an in-flight slot
+    std::deque<AsyncSend> retries_;     // Failed attempts, ordered by retryAt
+    size_t inFlight_;
+    std::shared_ptr<CompletionQueue> completions_;
+
+    /**
+     * Start queued sends and due retries while in-flight slots are free
+     */
+    void startSends();
+
+    /**
+     * Deliver the final result of an asynchronous send
+     */
+    void finishSend(AsyncSend& send, const hal::HttpResponse& response);
+
+    /**
+     * Map an HTTP response to a ConnectionResult
+     */
+    static ConnectionResult toResult(const hal::HttpResponse& response);
+
+    /**
+     * Build full URL for an API path
+     * @param path API path (e.g., "/api/readings")
+     * @return Full URL
+     */
+    std::string buildUrl(const std::string& path) const;
+
+    /**
+     * Send HTTP POST with retry logic
+     * @param url Full URL
+     * @param json JSON body
+     * @param retries Number of retries
+     * @return HTTP response
+     */
+    hal::HttpResponse postWithRetry(const std::string& url,
+                                    const std::string& json,
+                                    int retries = 3);
+};
+
+} // namespace connection
+
+#endif // HTTP_CONNECTION_H
@@ -0,0 +1,438 @@
+#include "mqtt_connection.h"
+#include "json_serializer.h"
+#include "hal/hal.h"
+#include "config.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace connection {
+
+MqttConnection::MqttConnection(const std::string& endpoint, const std::string& serialNumber)
+    : port_(config::MQTT_DEFAULT_PORT)
+    , serial_(serialNumber.empty() ? hal::get_device_serial() : serialNumber)
+    , socket_(-1)
+    , connected_(false)
+    , autoReconnect_(true)
+    , configCallback_(nullptr)
+    , nextPacketId_(1)
+    , lastConnectAttempt_(0)
+    , lastSendAt_(0)
+    , pingSentAt_(0)
+    , pingOutstanding_(false)
+    , reader_(config::MQTT_MAX_PACKET_SIZE)
+{
+    parseEndpoint(endpoint);
+    topicPrefix_ = std::string(config::MQTT_TOPIC_PREFIX) + serial_ + "/";
+}
+
+MqttConnection::~MqttConnection() {
+    if (connected_) {
+        disconnect();
+    }
+}
+
+bool MqttConnection::connect() {
+    autoReconnect_ = true;
+    if (connected_) {
+        return true;
+    }
+
+    lastConnectAttempt_ = hal::millis();
+    if (!hal::network_is_connected()) {
+        return false;
+    }
+
+    hal::log_info("MqttConnection: Connecting to " + host_ + ":" + std::to_string(port_));
+
+    socket_ = hal::tcp_connect(host_, port_, config::MQTT_ACK_TIMEOUT_MS);
+    if (socket_ < 0) {
+        return false;
+    }
+    reader_.reset();
+
+    mqtt::ConnectOptions options;
+    options.clientId = serial_;
+    options.username = hal::get_env(config::ENV_MQTT_USERNAME);
+    options.password = hal::get_env(config::ENV_MQTT_PASSWORD);
+    options.keepAliveSeconds = config::MQTT_KEEPALIVE_SECONDS;
+    options.cleanSession = false;
+    options.willTopic = topic("s");
+    options.willPayload = "0";
+    options.willRetain = true;
+
+    bool sessionPresent = false;
+    if (!write(mqtt::encodeConnect(options)) || !awaitConnack(sessionPresent)) {
+        hal::tcp_close(socket_);
+        socket_ = -1;
+        return false;
+    }
+
+    connected_ = true;
+    pingOutstanding_ = false;
+
+    write(mqtt::encodePublish(topic("s"), "1", 0, true, false, 0));
+
+    // A resumed session still holds the config subscription
+    if (!sessionPresent) {
+        write(mqtt::encodeSubscribe(allocatePacketId(), topic("c"), 1));
+    }
+
+    resendInflight();
+
+    hal::log_info(std::string("MqttConnection: Connected (") +
+                 (sessionPresent ? "session resumed" : "new session") + ", " +
+                 std::to_string(queue_.size()) + " readings queued)");
+    return connected_;
+}
+
+bool MqttConnection::isConnected() const {
+    return connected_;
+}
+
+void MqttConnection::disconnect() {
+    autoReconnect_ = false;
+    if (!connected_) {
+        return;
+    }
+
+    flushQueue(true);
+    if (connected_) {
+        // A clean DISCONNECT suppresses the last will, so publish the offline state ourselves
+        write(mqtt::encodePublish(topic("s"), "0", 0, true, false, 0));
+        write(mqtt::encodeDisconnect());
+    }
+
+    hal::tcp_close(socket_);
+    socket_ = -1;
+    connected_ = false;
+    hal::log_info("MqttConnection: Disconnected");
+}
+
+data::NodeConfig MqttConnection::registerNode(const data::NodeInfo& info) {
+    (void)info;
+    hal::log_error("MqttConnection: Registration is only supported over HTTP");
+    return data::NodeConfig();
+}
+
+ConnectionResult MqttConnection::sendReading(const data::Reading& reading) {
+    if (queue_.size() >= config::MQTT_OFFLINE_QUEUE_SIZE) {
+        queue_.pop_front();
+        hal::log_warn("MqttConnection: Queue full, dropped oldest reading");
+    }
+
+    queue_.push_back(QueuedReading{reading, hal::millis()});
+
+    hal::log_debug("MqttConnection: Queued " + reading.type + " (" +
+                  std::to_string(queue_.size()) + " pending)");
+
+    if (connected_ && queue_.size() >= config::MQTT_BATCH_SIZE) {
+        flushQueue(false);
+    }
+
+    return ConnectionResult::ok();
+}
+
+void MqttConnection::onConfigReceived(ConfigCallback callback) {
+    configCallback_ = callback;
+}
+
+std::string MqttConnection::getMode() const {
+    return "mqtt";
+}
+
+uint32_t MqttConnection::poll() {
+    if (!connected_) {
+        if (!autoReconnect_) {
+            return UINT32_MAX;
+        }
+        uint32_t sinceAttempt = hal::millis() - lastConnectAttempt_;
+        if (lastConnectAttempt_ != 0 && sinceAttempt < config::MQTT_RECONNECT_INTERVAL_MS) {
+            return config::MQTT_RECONNECT_INTERVAL_MS - sinceAttempt;
+        }
+        if (!connect()) {
+            return config::MQTT_RECONNECT_INTERVAL_MS;
+        }
+    }
+
+    processIncoming();
+    if (!connected_) {
+        return config::MQTT_RECONNECT_INTERVAL_MS;
+    }
+
+    flushQueue(false);
+    if (!connected_) {
+        return config::MQTT_RECONNECT_INTERVAL_MS;
+    }
+
+    uint32_t now = hal::millis();
+
+    if (!inflight_.empty() && now - inflight_.front().sentAt >= config::MQTT_ACK_TIMEOUT_MS) {
+        dropConnection("PUBACK timeout");
+        return config::MQTT_RECONNECT_INTERVAL_MS;
+    }
+
+    if (pingOutstanding_) {
+        if (now - pingSentAt_ >= config::MQTT_ACK_TIMEOUT_MS) {
+            dropConnection("PINGRESP timeout");
+            return config::MQTT_RECONNECT_INTERVAL_MS;
+        }
+    } else if (now - lastSendAt_ >= config::MQTT_KEEPALIVE_SECONDS * 1000UL / 2) {
+        if (write(mqtt::encodePingreq())) {
+            pingOutstanding_ = true;
+            pingSentAt_ = now;
+        }
+    }
+
+    return nextPollDelay();
+}
+
+size_t MqttConnection::getQueuedCount() const {
+    return queue_.size();
+}
+
+void MqttConnection::parseEndpoint(const std::string& endpoint) {
+    std::string address = endpoint;
+
+    size_t scheme = address.find("://");
+    if (scheme != std::string::npos) {
+        address = address.substr(scheme + 3);
+    }
+
+    size_t path = address.find('/');
+    if (path != std::string::npos) {
+        address = address.substr(0, path);
+    }
+
+    size_t colon = address.rfind(':');
+    if (colon != std::string::npos) {
+        int port = std::atoi(address.substr(colon + 1).c_str());
+        if (port > 0 && port <= 65535) {
+            port_ = static_cast<uint16_t>(port);
+        }
+        address = address.substr(0, colon);
+    }
+
+    // No broker configured: assume it runs next to the Hub
+    host_ = address.empty()
+        ? hal::get_env(config::ENV_HUB_HOST, config::DEFAULT_HUB_HOST)
+        : address;
+}
+
+bool MqttConnection::awaitConnack(bool& sessionPresent) {
+    uint8_t buffer[64];
+    uint32_t start = hal::millis();
+
+    while (hal::millis() - start < config::MQTT_ACK_TIMEOUT_MS) {
+        int count = hal::tcp_read(socket_, buffer, sizeof(buffer), 100);
+        if (count < 0) {
+            hal::log_error("MqttConnection: Broker closed the connection");
+            return false;
+        }
+        reader_.feed(buffer, static_cast<size_t>(count));
+
+        mqtt::Packet packet;
+        if (!reader_.next(packet)) {
+            continue;
+        }
+
+        if (packet.type != mqtt::CONNACK || packet.body.size() < 2) {
+            hal::log_error("MqttConnection: Unexpected packet before CONNACK");
+            return false;
+        }
+        if (packet.body[1] != 0) {
+            hal::log_error("MqttConnection: Connection refused (code " +
+                          std::to_string(packet.body[1]) + ")");
+            return false;
+        }
+
+        sessionPresent = (packet.body[0] & 0x01) != 0;
+        return true;
+    }
+
+    hal::log_error("MqttConnection: CONNACK timeout");
+    return false;
+}
+
+void MqttConnection::processIncoming() {
+    uint8_t buffer[256];
+    bool closed = false;
+
+    for (;;) {
+        int count = hal::tcp_read(socket_, buffer, sizeof(buffer), 0);
+        if (count < 0) {
+            closed = true;
+            break;
+        }
+        if (count == 0) {
+            break;
+        }
+        reader_.feed(buffer, static_cast<size_t>(count));
+    }
+
+    // Packets received before a close are still handled (e.g. a config push)
+    mqtt::Packet packet;
+    while (connected_ && reader_.next(packet)) {
+        handlePacket(packet);
+    }
+
+    if (connected_ && closed) {
+        dropConnection("closed by broker");
+    } else if (connected_ && reader_.hasError()) {
+        dropConnection("malformed or oversized packet");
+    }
+}
+
+void MqttConnection::handlePacket(const mqtt::Packet& packet) {
+    switch (packet.type) {
+        case mqtt::PUBACK: {
+            uint16_t packetId = mqtt::decodePacketId(packet);
+            auto it = std::find_if(inflight_.begin(), inflight_.end(),
+                                   [packetId](const InflightBatch& batch) {
+                                       return batch.packetId == packetId;
+                                   });
+            if (it != inflight_.end()) {
+                hal::log_info("MqttConnection: Batch acknowledged (" +
+                             std::to_string(it->readingCount) + " readings)");
+                inflight_.erase(it);
+            }
+            break;
+        }
+
+        case mqtt::PINGRESP:
+            pingOutstanding_ = false;
+            break;
+
+        case mqtt::SUBACK:
+            if (packet.body.size() >= 3 && packet.body[2] == 0x80) {
+                hal::log_warn("MqttConnection: Config subscription rejected by broker");
+            }
+            break;
+
+        case mqtt::PUBLISH: {
+            mqtt::Message message;
+            if (!mqtt::decodePublish(packet, message)) {
+                hal::log_warn("MqttConnection: Malformed PUBLISH ignored");
+                break;
+            }
+
+            if (message.topic == topic("c")) {
+                data::NodeConfig config;
+                if (data::JsonSerializer::deserializeNodeConfig(message.payload, config)) {
+                    hal::log_info("MqttConnection: Configuration pushed by Hub");
+                    if (configCallback_) {
+                        configCallback_(config);
+                    }
+                } else {
+                    hal::log_error("MqttConnection: Invalid configuration push");
+                }
+            }
+
+            // Acknowledge after handling: a lost PUBACK only means a repeated push
+            if (message.qos > 0) {
+                write(mqtt::encodePuback(message.packetId));
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void MqttConnection::flushQueue(bool force) {
+    while (connected_ && !queue_.empty() && inflight_.size() < config::MQTT_MAX_INFLIGHT) {
+        bool full = queue_.size() >= config::MQTT_BATCH_SIZE;
+        bool due = hal::millis() - queue_.front().queuedAt >= config::MQTT_BATCH_MAX_DELAY_MS;
+        if (!full && !due && !force) {
+            return;
+        }
+
+        size_t count = std::min(queue_.size(), config::MQTT_BATCH_SIZE);
+        std::vector<data::Reading> batch;
+        batch.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            batch.push_back(queue_[i].reading);
+        }
+        queue_.erase(queue_.begin(), queue_.begin() + count);
+
+        // Tracked before writing: a failed write is re-sent after the reconnect
+        InflightBatch entry;
+        entry.packetId = allocatePacketId();
+        entry.payload = data::JsonSerializer::serializeReadingBatch(batch);
+        entry.readingCount = count;
+        entry.sentAt = hal::millis();
+        inflight_.push_back(entry);
+
+        if (!write(mqtt::encodePublish(topic("r"), entry.payload, 1, false, false, entry.packetId))) {
+            dropConnection("publish failed");
+            return;
+        }
+    }
+}
+
+void MqttConnection::resendInflight() {
+    for (auto& batch : inflight_) {
+        batch.sentAt = hal::millis();
+        if (!write(mqtt::encodePublish(topic("r"), batch.payload, 1, false, true, batch.packetId))) {
+            dropConnection("re-send failed");
+            return;
+        }
+    }
+}
+
+uint32_t MqttConnection::nextPollDelay() const {
+    uint32_t now = hal::millis();
+    uint32_t next = config::MQTT_POLL_INTERVAL_MS;
+
+    auto until = [now, &next](uint32_t since, uint32_t period) {
+        uint32_t elapsed = now - since;
+        next = std::min(next, elapsed >= period ? 0 : period - elapsed);
+    };
+
+    // With all in-flight slots taken the next PUBACK (read on the regular
+    // interval) is what frees the queue
+    if (!queue_.empty() && inflight_.size() < config::MQTT_MAX_INFLIGHT) {
+        until(queue_.front().queuedAt, config::MQTT_BATCH_MAX_DELAY_MS);
+    }
+    if (!inflight_.empty()) {
+        until(inflight_.front().sentAt, config::MQTT_ACK_TIMEOUT_MS);
+    }
+    if (pingOutstanding_) {
+        until(pingSentAt_, config::MQTT_ACK_TIMEOUT_MS);
+    } else {
+        until(lastSendAt_, config::MQTT_KEEPALIVE_SECONDS * 1000UL / 2);
+    }
+    return next;
+}
+
+bool MqttConnection::write(const std::vector<uint8_t>& packet) {
+    if (socket_ < 0 || !hal::tcp_write(socket_, packet.data(), packet.size())) {
+        return false;
+    }
+    lastSendAt_ = hal::millis();
+    return true;
+}
+
+void MqttConnection::dropConnection(const std::string& reason) {
+    hal::log_warn("MqttConnection: Connection lost - " + reason);
+    hal::tcp_close(socket_);
+    socket_ = -1;
+    connected_ = false;
+    pingOutstanding_ = false;
+    reader_.reset();
+    lastConnectAttempt_ = hal::millis();
+}
+
+uint16_t MqttConnection::allocatePacketId() {
+    uint16_t packetId = nextPacketId_++;
+    if (nextPacketId_ == 0) {
+        nextPacketId_ = 1;  // 0 is not a valid packet identifier
+    }
+    return packetId;
+}
+
+std::string MqttConnection::topic(const char* suffix) const {
+    return topicPrefix_ + suffix;
+}
+
+} // namespace connection
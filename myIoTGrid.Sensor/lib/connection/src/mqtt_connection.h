@@ -0,0 +1,133 @@
+#ifndef MQTT_CONNECTION_H
+#define MQTT_CONNECTION_H
+
+#include "connection_interface.h"
+#include "mqtt_packet.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace connection {
+
+/**
+ * MQTT 3.1.1 connection to a broker (e.g. Mosquitto next to the Hub)
+ *
+ * - Persistent session: client ID = node serial, clean session off, so the
+ *   broker keeps the config subscription and QoS 1 state across reconnects
+ * - Readings are queued and published as QoS 1 batches (MQTT_BATCH_SIZE or
+ *   MQTT_BATCH_MAX_DELAY_MS); unacknowledged batches are re-sent with DUP
+ *   after a reconnect
+ * - While the broker is unreachable readings stay queued (bounded, oldest
+ *   dropped) and poll() reconnects every MQTT_RECONNECT_INTERVAL_MS
+ * - poll() returns when it next needs to run (partial batch, ACK and
+ *   keep-alive deadlines, MQTT_POLL_INTERVAL_MS for pushed config)
+ *
+ * Topics (compact, keyed by serial):
+ * - myiotgrid/n/{serial}/r - reading batches (see JsonSerializer::serializeReadingBatch)
+ * - myiotgrid/n/{serial}/c - NodeConfig pushed by the Hub (subscribed, QoS 1)
+ * - myiotgrid/n/{serial}/s - "1" online / "0" offline (retained, last will)
+ *
+ * Registration stays on HTTP (NodeController registers before creating
+ * the configured connection).
+ */
+class MqttConnection : public IConnection {
+public:
+    /**
+     * Create MQTT connection
+     * @param endpoint Broker address ("mqtt://host:port", "host:port" or "host")
+     * @param serialNumber Node serial (client ID and topic key), empty = hal::get_device_serial()
+     */
+    explicit MqttConnection(const std::string& endpoint, const std::string& serialNumber = "");
+
+    ~MqttConnection() override;
+
+    // IConnection interface
+    bool connect() override;
+    bool isConnected() const override;
+    void disconnect() override;
+    data::NodeConfig registerNode(const data::NodeInfo& info) override;
+    ConnectionResult sendReading(const data::Reading& reading) override;
+    void onConfigReceived(ConfigCallback callback) override;
+    std::string getMode() const override;
+    uint32_t poll() override;
+
+    /**
+     * Readings waiting for a batch (not yet published)
+     */
+    size_t getQueuedCount() const;
+
+private:
+    struct QueuedReading {
+        data::Reading reading;
+        uint32_t queuedAt;          // Batch deadline counts from here
+    };
+
+    struct InflightBatch {
+        uint16_t packetId;
+        std::string payload;
+        size_t readingCount;
+        uint32_t sentAt;
+    };
+
+    std::string host_;
+    uint16_t port_;
+    std::string serial_;
+    std::string topicPrefix_;
+    int socket_;
+    bool connected_;
+    bool autoReconnect_;            // Cleared by disconnect(), set by connect()
+    ConfigCallback configCallback_;
+
+    std::deque<QueuedReading> queue_;
+    std::deque<InflightBatch> inflight_;
+    uint16_t nextPacketId_;
+    uint32_t lastConnectAttempt_;
+    uint32_t lastSendAt_;
+    uint32_t pingSentAt_;
+    bool pingOutstanding_;
+    mqtt::PacketReader reader_;
+
+    /**
+     * Parse host and port from the endpoint string
+     */
+    void parseEndpoint(const std::string& endpoint);
+
+    /**
+     * Wait for CONNACK after CONNECT
+     * @param sessionPresent Set from the CONNACK flags
+     * @return true if the broker accepted the connection
+     */
+    bool awaitConnack(bool& sessionPresent);
+
+    /**
+     * Read and dispatch everything the broker sent
+     */
+    void processIncoming();
+    void handlePacket(const mqtt::Packet& packet);
+
+    /**
+     * Publish queued readings as batches while in-flight slots are free
+     * @param force Send partial batches regardless of MQTT_BATCH_MAX_DELAY_MS
+     */
+    void flushQueue(bool force);
+
+    /**
+     * Re-send unacknowledged batches (DUP) after a reconnect
+     */
+    void resendInflight();
+
+    /**
+     * Milliseconds until the next batch, timeout or keep-alive deadline
+     */
+    uint32_t nextPollDelay() const;
+
+    bool write(const std::vector<uint8_t>& packet);
+    void dropConnection(const std::string& reason);
+    uint16_t allocatePacketId();
+    std::string topic(const char* suffix) const;
+};
+
+} // namespace connection
+
+#endif // MQTT_CONNECTION_H
@@ -0,0 +1,214 @@
+#include "mqtt_packet.h"
+
+namespace connection {
+namespace mqtt {
+
+namespace {
+
+void appendRemainingLength(std::vector<uint8_t>& out, size_t length) {
+    do {
+        uint8_t digit = length % 128;
+        length /= 128;
+        if (length > 0) {
+            digit |= 0x80;
+        }
+        out.push_back(digit);
+    } while (length > 0);
+}
+
+void appendUint16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value & 0xFF));
+}
+
+void appendString(std::vector<uint8_t>& out, const std::string& value) {
+    appendUint16(out, static_cast<uint16_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+std::vector<uint8_t> frame(uint8_t firstByte, const std::vector<uint8_t>& body) {
+    std::vector<uint8_t> out;
+    out.reserve(body.size() + 5);
+    out.push_back(firstByte);
+    appendRemainingLength(out, body.size());
+    out.insert(out.end(), body.begin(), body.end());
+    return out;
+}
+
+} // anonymous namespace
+
+std::vector<uint8_t> encodeConnect(const ConnectOptions& options) {
+    std::vector<uint8_t> body;
+    appendString(body, "MQTT");
+    body.push_back(4);  // Protocol level 3.1.1
+
+    uint8_t flags = 0;
+    if (options.cleanSession) {
+        flags |= 0x02;
+    }
+    if (!options.willTopic.empty()) {
+        flags |= 0x04;
+        flags |= 1 << 3;  // Will QoS 1
+        if (options.willRetain) {
+            flags |= 0x20;
+        }
+    }
+    if (!options.username.empty()) {
+        flags |= 0x80;
+        if (!options.password.empty()) {
+            flags |= 0x40;
+        }
+    }
+    body.push_back(flags);
+    appendUint16(body, options.keepAliveSeconds);
+
+    appendString(body, options.clientId);
+    if (!options.willTopic.empty()) {
+        appendString(body, options.willTopic);
+        appendString(body, options.willPayload);
+    }
+    if (!options.username.empty()) {
+        appendString(body, options.username);
+        if (!options.password.empty()) {
+            appendString(body, options.password);
+        }
+    }
+
+    return frame(CONNECT << 4, body);
+}
+
+std::vector<uint8_t> encodePublish(const std::string& topic, const std::string& payload,
+                                   uint8_t qos, bool retain, bool dup, uint16_t packetId) {
+    std::vector<uint8_t> body;
+    body.reserve(topic.size() + payload.size() + 4);
+    appendString(body, topic);
+    if (qos > 0) {
+        appendUint16(body, packetId);
+    }
+    body.insert(body.end(), payload.begin(), payload.end());
+
+    uint8_t firstByte = (PUBLISH << 4) | ((qos & 0x03) << 1);
+    if (retain) {
+        firstByte |= 0x01;
+    }
+    if (dup && qos > 0) {
+        firstByte |= 0x08;
+    }
+    return frame(firstByte, body);
+}
+
+std::vector<uint8_t> encodeSubscribe(uint16_t packetId, const std::string& topic, uint8_t qos) {
+    std::vector<uint8_t> body;
+    appendUint16(body, packetId);
+    appendString(body, topic);
+    body.push_back(qos & 0x03);
+    return frame((SUBSCRIBE << 4) | 0x02, body);  // Reserved flags 0010
+}
+
+std::vector<uint8_t> encodePuback(uint16_t packetId) {
+    std::vector<uint8_t> body;
+    appendUint16(body, packetId);
+    return frame(PUBACK << 4, body);
+}
+
+std::vector<uint8_t> encodePingreq() {
+    return { static_cast<uint8_t>(PINGREQ << 4), 0 };
+}
+
+std::vector<uint8_t> encodeDisconnect() {
+    return { static_cast<uint8_t>(DISCONNECT << 4), 0 };
+}
+
+bool decodePublish(const Packet& packet, Message& message) {
+    const std::vector<uint8_t>& body = packet.body;
+    if (packet.type != PUBLISH || body.size() < 2) {
+        return false;
+    }
+
+    size_t topicLength = (static_cast<size_t>(body[0]) << 8) | body[1];
+    size_t offset = 2 + topicLength;
+    if (offset > body.size()) {
+        return false;
+    }
+    message.topic.assign(body.begin() + 2, body.begin() + offset);
+
+    message.qos = (packet.flags >> 1) & 0x03;
+    message.packetId = 0;
+    if (message.qos > 0) {
+        if (offset + 2 > body.size()) {
+            return false;
+        }
+        message.packetId = static_cast<uint16_t>((body[offset] << 8) | body[offset + 1]);
+        offset += 2;
+    }
+
+    message.payload.assign(body.begin() + offset, body.end());
+    return true;
+}
+
+uint16_t decodePacketId(const Packet& packet) {
+    if (packet.body.size() < 2) {
+        return 0;
+    }
+    return static_cast<uint16_t>((packet.body[0] << 8) | packet.body[1]);
+}
+
+PacketReader::PacketReader(size_t maxPacketSize)
+    : maxPacketSize_(maxPacketSize)
+    , error_(false)
+{
+}
+
+void PacketReader::feed(const uint8_t* data, size_t length) {
+    if (!error_) {
+        buffer_.insert(buffer_.end(), data, data + length);
+    }
+}
+
+bool PacketReader::next(Packet& packet) {
+    if (error_ || buffer_.size() < 2) {
+        return false;
+    }
+
+    // Remaining length: 1-4 bytes, 7 bits each
+    size_t remaining = 0;
+    size_t multiplier = 1;
+    size_t index = 1;
+    for (;;) {
+        if (index >= buffer_.size()) {
+            return false;  // Length not complete yet
+        }
+        uint8_t digit = buffer_[index++];
+        remaining += (digit & 0x7F) * multiplier;
+        if ((digit & 0x80) == 0) {
+            break;
+        }
+        multiplier *= 128;
+        if (index > 4) {
+            error_ = true;
+            return false;
+        }
+    }
+
+    if (remaining > maxPacketSize_) {
+        error_ = true;
+        return false;
+    }
+    if (buffer_.size() < index + remaining) {
+        return false;
+    }
+
+    packet.type = buffer_[0] >> 4;
+    packet.flags = buffer_[0] & 0x0F;
+    packet.body.assign(buffer_.begin() + index, buffer_.begin() + index + remaining);
+    buffer_.erase(buffer_.begin(), buffer_.begin() + index + remaining);
+    return true;
+}
+
+void PacketReader::reset() {
+    buffer_.clear();
+    error_ = false;
+}
+
+} // namespace mqtt
+} // namespace connection
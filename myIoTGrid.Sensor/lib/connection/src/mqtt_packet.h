@@ -0,0 +1,109 @@
+#ifndef MQTT_PACKET_H
+#define MQTT_PACKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace connection {
+namespace mqtt {
+
+/**
+ * MQTT 3.1.1 control packet types (fixed header, upper nibble)
+ */
+enum PacketType : uint8_t {
+    CONNECT = 1,
+    CONNACK = 2,
+    PUBLISH = 3,
+    PUBACK = 4,
+    SUBSCRIBE = 8,
+    SUBACK = 9,
+    PINGREQ = 12,
+    PINGRESP = 13,
+    DISCONNECT = 14
+};
+
+/**
+ * CONNECT options
+ */
+struct ConnectOptions {
+    std::string clientId;
+    std::string username;           // Empty = no credentials
+    std::string password;
+    uint16_t keepAliveSeconds;
+    bool cleanSession;              // false = broker keeps subscriptions and QoS 1 state
+    std::string willTopic;          // Empty = no last will
+    std::string willPayload;
+    bool willRetain;
+
+    ConnectOptions() : keepAliveSeconds(60), cleanSession(false), willRetain(false) {}
+};
+
+/**
+ * Decoded control packet (fixed header + variable header/payload)
+ */
+struct Packet {
+    uint8_t type;
+    uint8_t flags;
+    std::vector<uint8_t> body;
+
+    Packet() : type(0), flags(0) {}
+};
+
+/**
+ * Incoming PUBLISH
+ */
+struct Message {
+    std::string topic;
+    std::string payload;
+    uint8_t qos;
+    uint16_t packetId;              // 0 for QoS 0
+
+    Message() : qos(0), packetId(0) {}
+};
+
+std::vector<uint8_t> encodeConnect(const ConnectOptions& options);
+std::vector<uint8_t> encodePublish(const std::string& topic, const std::string& payload,
+                                   uint8_t qos, bool retain, bool dup, uint16_t packetId);
+std::vector<uint8_t> encodeSubscribe(uint16_t packetId, const std::string& topic, uint8_t qos);
+std::vector<uint8_t> encodePuback(uint16_t packetId);
+std::vector<uint8_t> encodePingreq();
+std::vector<uint8_t> encodeDisconnect();
+
+/**
+ * Decode a PUBLISH packet
+ * @return false if the packet is malformed
+ */
+bool decodePublish(const Packet& packet, Message& message);
+
+/**
+ * Packet identifier of PUBACK/SUBACK (0 if malformed)
+ */
+uint16_t decodePacketId(const Packet& packet);
+
+/**
+ * Incremental decoder for the TCP byte stream
+ *
+ * Bytes are appended with feed(); next() returns complete packets in order.
+ * Packets larger than maxPacketSize put the reader into the error state.
+ */
+class PacketReader {
+public:
+    explicit PacketReader(size_t maxPacketSize);
+
+    void feed(const uint8_t* data, size_t length);
+    bool next(Packet& packet);
+    bool hasError() const { return error_; }
+    void reset();
+
+private:
+    std::vector<uint8_t> buffer_;
+    size_t maxPacketSize_;
+    bool error_;
+};
+
+} // namespace mqtt
+} // namespace connection
+
+#endif // MQTT_PACKET_H
@@ -0,0 +1,423 @@
+#include "node_controller.h"
+#include "http_connection.h"
+#include "mqtt_connection.h"
+#include "hal/hal.h"
+#include "config.h"
+#include <algorithm>
+#include <cmath>
+
+namespace controller {
+
+NodeController::NodeController()
+    : configManager_()
+    , connection_(nullptr)
+    , sensors_()
+    , signalEnvironment_()
+    , state_(State::IDLE)
+    , timers_()
+    , readingTimer_(TimerWheel::INVALID_TIMER)
+    , pollTimer_(TimerWheel::INVALID_TIMER)
+    , registrationTimer_(TimerWheel::INVALID_TIMER)
+    , nextReadingAt_(0)
+    , readingCount_(0)
+    , registrationFailures_(0)
+    , readingObserver_(nullptr)
+{
+}
+
+NodeController::NodeController(const std::string& serialNumber, const std::string& storageNamespace)
+    : configManager_(serialNumber, storageNamespace)
+    , connection_(nullptr)
+    , sensors_()
+    , signalEnvironment_()
+    , state_(State::IDLE)
+    , timers_()
+    , readingTimer_(TimerWheel::INVALID_TIMER)
+    , pollTimer_(TimerWheel::INVALID_TIMER)
+    , registrationTimer_(TimerWheel::INVALID_TIMER)
+    , nextReadingAt_(0)
+    , readingCount_(0)
+    , registrationFailures_(0)
+    , readingObserver_(nullptr)
+{
+}
+
+bool NodeController::setup() {
+    hal::log_info("===========================================");
+    hal::log_info("  myIoTGrid Sensor - Starting...");
+    hal::log_info("===========================================");
+    hal::log_info("Firmware Version: " FIRMWARE_VERSION);
+    hal::log_info("Hardware Type: " HARDWARE_TYPE);
+    hal::log_info("Simulation Mode: " + std::string(SIMULATE_SENSORS ? "ON" : "OFF"));
+    hal::log_info("-------------------------------------------");
+
+    // Initialize HAL
+    hal::init();
+    cancelTimers();
+
+    // Get serial number
+    std::string serial = configManager_.getSerialNumber();
+    hal::log_info("Serial Number: " + serial);
+
+    if (!signalEnvironment_) {
+        sensor::SignalProfile profile;
+        std::string error;
+        if (!sensor::SignalProfile::parse(hal::get_env(config::ENV_SIM_MODEL), profile, error)) {
+            hal::log_error("Invalid " + std::string(config::ENV_SIM_MODEL) + ": " + error);
+            return false;
+        }
+        setSignalProfile(profile);
+    }
+    hal::log_info("Signal Model: " + signalEnvironment_->getProfile().preset);
+
+    // Initialize network
+    if (!initNetwork()) {
+        hal::log_error("Failed to initialize network");
+        return false;
+    }
+
+    // Build endpoint from environment/defaults
+    std::string endpoint = buildHubEndpoint();
+    hal::log_info("Hub Endpoint: " + endpoint);
+
+    // Check for existing config
+    data::NodeConfig config;
+    if (configManager_.hasConfig()) {
+        hal::log_info("Loading saved configuration...");
+        config = configManager_.loadConfig();
+
+        if (config.isValid()) {
+            hal::log_info("Loaded config for device: " + config.deviceId);
+        } else {
+            hal::log_warn("Saved config invalid, will re-register");
+        }
+    }
+
+    // If no valid config, register with Hub (retried by a timer)
+    if (!config.isValid()) {
+        // Create temporary connection for registration
+        data::ConnectionConfig connConfig;
+        connConfig.mode = "http";
+        connConfig.endpoint = endpoint;
+        connection_ = createConnection(connConfig);
+
+        state_ = State::REGISTERING;
+        attemptRegistration();
+        return true;
+    }
+
+    startMeasuring();
+    return true;
+}
+
+void NodeController::loop() {
+    hal::delay_ms(tick());
+}
+
+uint32_t NodeController::tick() {
+    uint32_t next = timers_.advance(hal::millis());
+    return next == TimerWheel::NO_TIMER ? config::CONTROLLER_IDLE_WAIT_MS : next;
+}
+
+void NodeController::setReadingObserver(ReadingObserver observer) {
+    readingObserver_ = observer;
+}
+
+void NodeController::setSignalProfile(const sensor::SignalProfile& profile) {
+    signalEnvironment_ = std::make_shared<sensor::SignalEnvironment>(
+        profile, sensor::SignalEnvironment::nodeSeed(configManager_.getSerialNumber()));
+}
+
+bool NodeController::isRunning() const {
+    return state_ == State::RUNNING;
+}
+
+bool NodeController::isRegistering() const {
+    return state_ == State::REGISTERING;
+}
+
+uint32_t NodeController::getRegistrationFailures() const {
+    return registrationFailures_;
+}
+
+const data::NodeConfig& NodeController::getConfig() const {
+    return configManager_.getConfig();
+}
+
+bool NodeController::reregister() {
+    hal::log_info("Re-registration requested");
+    cancelTimers();
+    configManager_.deleteConfig();
+    state_ = State::IDLE;
+    sensors_.clear();
+    return setup();
+}
+
+void NodeController::attemptRegistration() {
+    registrationTimer_ = TimerWheel::INVALID_TIMER;
+
+    hal::log_info("Registering with Hub...");
+
+    data::NodeConfig config = connection_->registerNode(buildNodeInfo());
+
+    if (config.isValid()) {
+        configManager_.saveConfig(config);
+        hal::log_info("Registration successful!");
+        startMeasuring();
+        return;
+    }
+
+    registrationFailures_++;
+    hal::log_warn("Registration failed, retrying in " +
+                 std::to_string(config::REGISTRATION_RETRY_DELAY_MS / 1000) + "s...");
+    registrationTimer_ = timers_.schedule(hal::millis(), config::REGISTRATION_RETRY_DELAY_MS,
+                                          [this]() { attemptRegistration(); });
+}
+
+void NodeController::startMeasuring() {
+    const data::NodeConfig& config = configManager_.getConfig();
+
+    // Create connection based on config (always recreate if endpoint changed)
+    if (!connection_ || connection_->getMode() != config.connection.mode) {
+        connection_ = createConnection(config.connection);
+    }
+
+    // Hub-pushed configuration (MQTT): persist and apply sensor changes
+    connection_->onConfigReceived([this](const data::NodeConfig& pushed) {
+        applyPushedConfig(pushed);
+    });
+
+    // Initialize sensors
+    initSensors();
+
+    state_ = State::RUNNING;
+
+    // First reading right away, then on the fixed-rate grid
+    nextReadingAt_ = hal::millis() - intervalMs();
+    scheduleNextReading();
+
+    hal::log_info("-------------------------------------------");
+    hal::log_info("Setup complete. Starting measurement loop.");
+    hal::log_info("Interval: " + std::to_string(config.intervalSeconds) + " seconds");
+    hal::log_info("===========================================");
+}
+
+void NodeController::applyPushedConfig(const data::NodeConfig& pushed) {
+    if (!pushed.isValid()) {
+        return;
+    }
+
+    uint32_t previousIntervalMs = intervalMs();
+    configManager_.saveConfig(pushed);
+    if (state_ != State::RUNNING) {
+        return;
+    }
+
+    initSensors();
+
+    // New interval: restart the grid from the last reading
+    if (intervalMs() != previousIntervalMs && timers_.cancel(readingTimer_)) {
+        nextReadingAt_ -= previousIntervalMs;
+        scheduleNextReading();
+    }
+}
+
+void NodeController::scheduleNextReading() {
+    uint32_t now = hal::millis();
+    nextReadingAt_ += intervalMs();
+
+    // Cycle overran the interval (slow Hub): resync instead of bursting
+    if (static_cast<int32_t>(nextReadingAt_ - now) < 0) {
+        nextReadingAt_ = now;
+    }
+
+    readingTimer_ = timers_.schedule(now, nextReadingAt_ - now, [this]() {
+        readingTimer_ = TimerWheel::INVALID_TIMER;
+        executeReadingCycle();
+        scheduleNextReading();
+        pollConnection();
+    });
+}
+
+void NodeController::pollConnection() {
+    timers_.cancel(pollTimer_);
+    pollTimer_ = TimerWheel::INVALID_TIMER;
+
+    if (!connection_) {
+        return;
+    }
+
+    uint32_t next = connection_->poll();
+    if (next != UINT32_MAX) {
+        pollTimer_ = timers_.schedule(hal::millis(), next, [this]() { pollConnection(); });
+    }
+}
+
+void NodeController::cancelTimers() {
+    timers_.cancel(readingTimer_);
+    timers_.cancel(pollTimer_);
+    timers_.cancel(registrationTimer_);
+    readingTimer_ = TimerWheel::INVALID_TIMER;
+    pollTimer_ = TimerWheel::INVALID_TIMER;
+    registrationTimer_ = TimerWheel::INVALID_TIMER;
+}
+
+uint32_t NodeController::intervalMs() const {
+    return std::max<uint32_t>(configManager_.getConfig().intervalSeconds, 1) * 1000;
+}
+
+bool NodeController::initNetwork() {
+#ifdef PLATFORM_ESP32
+    // ESP32: Connect to WiFi
+    std::string ssid = hal::get_env(config::ENV_WIFI_SSID, config::DEFAULT_WIFI_SSID);
+    std::string password = hal::get_env(config::ENV_WIFI_PASSWORD, config::DEFAULT_WIFI_PASSWORD);
+
+    if (ssid.empty()) {
+        hal::log_error("WiFi SSID not configured");
+        return false;
+    }
+
+    hal::log_info("Connecting to WiFi: " + ssid);
+
+    if (!hal::network_connect(ssid, password)) {
+        hal::log_error("Failed to connect to WiFi");
+        return false;
+    }
+
+    hal::log_info("WiFi connected. IP: " + hal::network_get_ip());
+    return true;
+#else
+    // Native: Network always available
+    return hal::network_is_connected();
+#endif
+}
+
+std::string NodeController::buildHubEndpoint() {
+    std::string host = hal::get_env(config::ENV_HUB_HOST, config::DEFAULT_HUB_HOST);
+    std::string port = hal::get_env(config::ENV_HUB_PORT, std::to_string(config::DEFAULT_HUB_PORT));
+    std::string protocol = hal::get_env(config::ENV_HUB_PROTOCOL, config::DEFAULT_HUB_PROTOCOL);
+
+    return protocol + "://" + host + ":" + port;
+}
+
+std::unique_ptr<connection::IConnection> NodeController::createConnection(
+    const data::ConnectionConfig& connConfig
+) {
+    if (connConfig.mode == "http") {
+        return std::make_unique<connection::HttpConnection>(connConfig.endpoint);
+    }
+
+    if (connConfig.mode == "mqtt") {
+        return std::make_unique<connection::MqttConnection>(connConfig.endpoint,
+                                                             configManager_.getSerialNumber());
+    }
+
+    // TODO: Add LoRaWAN in future sprints
+    hal::log_warn("Unknown connection mode: " + connConfig.mode + ", using HTTP");
+    return std::make_unique<connection::HttpConnection>(connConfig.endpoint);
+}
+
+void NodeController::initSensors() {
+    sensors_.clear();
+
+    const data::NodeConfig& config = configManager_.getConfig();
+
+    hal::log_info("Initializing sensors...");
+
+    for (const auto& sensorConfig : config.sensors) {
+        if (!sensorConfig.enabled) {
+            hal::log_info("  Sensor " + sensorConfig.type + ": DISABLED");
+            continue;
+        }
+
+        auto sensor = sensor::SensorFactory::create(
+            sensorConfig.type,
+            sensorConfig.pin,
+            SIMULATE_SENSORS,
+            signalEnvironment_
+        );
+
+        if (!sensor) {
+            hal::log_error("  Sensor " + sensorConfig.type + ": FAILED (unknown type)");
+            continue;
+        }
+
+        if (!sensor->begin()) {
+            hal::log_error("  Sensor " + sensorConfig.type + ": FAILED (init error)");
+            continue;
+        }
+
+        hal::log_info("  Sensor " + sensorConfig.type + ": OK (" + sensor->getName() + ")");
+        sensors_[sensorConfig.type] = std::move(sensor);
+    }
+
+    hal::log_info("Initialized " + std::to_string(sensors_.size()) + " sensors");
+}
+
+data::NodeInfo NodeController::buildNodeInfo() {
+    data::NodeInfo info;
+
+    info.serialNumber = configManager_.getSerialNumber();
+    info.firmwareVersion = FIRMWARE_VERSION;
+    info.hardwareType = HARDWARE_TYPE;
+
+    // Get supported capabilities (all supported sensor types)
+    info.capabilities = sensor::SensorFactory::getSupportedTypes();
+
+    return info;
+}
+
+void NodeController::executeReadingCycle() {
+    readingCount_++;
+    hal::log_info("--- Reading cycle #" + std::to_string(readingCount_) + " ---");
+
+    if (sensors_.empty()) {
+        hal::log_warn("No sensors configured");
+        return;
+    }
+
+    std::vector<data::Reading> readings;
+    readings.reserve(sensors_.size());
+
+    for (auto& [type, sensor] : sensors_) {
+        data::Reading reading;
+        if (sensor && sensor->isReady() && readSensor(type, sensor.get(), reading)) {
+            readings.push_back(std::move(reading));
+        }
+    }
+
+    if (!connection_ || readings.empty()) {
+        return;
+    }
+
+    // Fire all readings; results arrive via the connection's poll()
+    connection_->sendReadingsAsync(readings.data(), readings.size(),
+        [this](const data::Reading& reading, const connection::ConnectionResult& result, uint32_t latencyUs) {
+            if (!result.success) {
+                hal::log_error("Failed to send reading: " + result.errorMessage);
+            }
+            if (readingObserver_) {
+                readingObserver_(reading, result, latencyUs);
+            }
+        });
+}
+
+bool NodeController::readSensor(const std::string& type, sensor::ISensor* sensor, data::Reading& reading) {
+    float value = sensor->read();
+
+    if (std::isnan(value)) {
+        hal::log_error("Sensor " + type + " returned NaN");
+        return false;
+    }
+
+    reading.deviceId = configManager_.getConfig().deviceId;
+    reading.type = type;
+    reading.value = value;
+    reading.unit = sensor->getUnit();
+    reading.timestamp = hal::timestamp();
+
+    hal::log_info("  " + type + ": " + std::to_string(value) + " " + reading.unit);
+    return true;
+}
+
+} // namespace controller
@@ -0,0 +1,210 @@
+#ifndef NODE_CONTROLLER_H
+#define NODE_CONTROLLER_H
+
+#include "config_manager.h"
+#include "connection_interface.h"
+#include "sensor_interface.h"
+#include "sensor_factory.h"
+#include "signal_model.h"
+#include "timer_wheel.h"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <map>
+
+namespace controller {
+
+/**
+ * NodeController - Main controller orchestrating all components
+ *
+ * Responsibilities:
+ * - Initialize HAL and components
+ * - Register with Hub or load saved config
+ * - Create sensors based on configuration
+ * - Execute measurement loop at configured interval
+ * - Send readings to Hub via connection
+ *
+ * Event loop: readings, registration retries and connection servicing are
+ * one-shot timers on a TimerWheel. tick() runs whatever is due and returns
+ * the time until the next timer, so loop() (or a fleet worker) sleeps
+ * exactly that long instead of polling.
+ */
+class NodeController {
+public:
+    /**
+     * Callback after each sent reading (fleet statistics)
+     * @param latencyUs Time from submission until the Hub answered
+     */
+    using ReadingObserver = std::function<void(const data::Reading&,
+                                               const connection::ConnectionResult&,
+                                               uint32_t latencyUs)>;
+
+    NodeController();
+
+    /**
+     * Create a controller with its own identity (fleet simulator)
+     * @param serialNumber Serial number used for registration
+     * @param storageNamespace Prefix for this node's storage keys
+     */
+    NodeController(const std::string& serialNumber, const std::string& storageNamespace);
+
+    ~NodeController() = default;
+
+    /**
+     * Initialize the controller
+     * Sets up HAL and loads config; without a saved config registration
+     * starts and is retried by a timer (see isRegistering())
+     * @return false if the network is unavailable
+     */
+    bool setup();
+
+    /**
+     * Main loop iteration
+     * Should be called repeatedly from main()
+     * Runs due timers and sleeps until the next one
+     */
+    void loop();
+
+    /**
+     * Non-blocking part of loop()
+     * Runs all timers that are due
+     * @return Milliseconds until the next timer (CONTROLLER_IDLE_WAIT_MS if none)
+     */
+    uint32_t tick();
+
+    /**
+     * Set callback for sent readings
+     */
+    void setReadingObserver(ReadingObserver observer);
+
+    /**
+     * Select the signal model of the simulated sensors
+     * Without a call, setup() reads it from SIM_MODEL. The node seed is
+     * derived from the serial number (reproducible with SIM_SEED).
+     * Applies to sensors created afterwards (setup() or a pushed config).
+     */
+    void setSignalProfile(const sensor::SignalProfile& profile);
+
+    /**
+     * Check if controller is running
+     * @return true if setup completed successfully
+     */
+    bool isRunning() const;
+
+    /**
+     * Check if registration with the Hub is pending (retried by a timer)
+     */
+    bool isRegistering() const;
+
+    /**
+     * Failed registration attempts since construction
+     */
+    uint32_t getRegistrationFailures() const;
+
+    /**
+     * Get current configuration
+     */
+    const data::NodeConfig& getConfig() const;
+
+    /**
+     * Force re-registration with Hub
+     * Deletes saved config, cancels all timers and registers fresh
+     */
+    bool reregister();
+
+private:
+    enum class State {
+        IDLE,           // setup() not called or failed
+        REGISTERING,    // Registration timer pending
+        RUNNING         // Reading timer active
+    };
+
+    ConfigManager configManager_;
+    std::unique_ptr<connection::IConnection> connection_;
+    std::map<std::string, std::unique_ptr<sensor::ISensor>> sensors_;
+    std::shared_ptr<sensor::SignalEnvironment> signalEnvironment_;
+
+    State state_;
+    TimerWheel timers_;
+    TimerWheel::TimerId readingTimer_;
+    TimerWheel::TimerId pollTimer_;
+    TimerWheel::TimerId registrationTimer_;
+    uint32_t nextReadingAt_;        // Fixed-rate schedule (hal::millis())
+    uint32_t readingCount_;
+    uint32_t registrationFailures_;
+    ReadingObserver readingObserver_;
+
+    /**
+     * Initialize network connection (WiFi for ESP32)
+     */
+    bool initNetwork();
+
+    /**
+     * Build Hub endpoint URL from environment or defaults
+     */
+    std::string buildHubEndpoint();
+
+    /**
+     * One registration attempt; schedules the next one on failure
+     */
+    void attemptRegistration();
+
+    /**
+     * Create the configured connection, sensors and the reading timer
+     */
+    void startMeasuring();
+
+    /**
+     * Apply a configuration pushed by the Hub (interval and sensors)
+     */
+    void applyPushedConfig(const data::NodeConfig& pushed);
+
+    /**
+     * Schedule the next reading cycle on the fixed-rate grid
+     */
+    void scheduleNextReading();
+
+    /**
+     * Service the connection and schedule the next poll it asked for
+     */
+    void pollConnection();
+
+    /**
+     * Cancel all pending timers
+     */
+    void cancelTimers();
+
+    uint32_t intervalMs() const;
+
+    /**
+     * Create connection based on config mode
+     */
+    std::unique_ptr<connection::IConnection> createConnection(const data::ConnectionConfig& connConfig);
+
+    /**
+     * Initialize sensors from configuration
+     */
+    void initSensors();
+
+    /**
+     * Build NodeInfo for registration
+     */
+    data::NodeInfo buildNodeInfo();
+
+    /**
+     * Execute one measurement cycle
+     * Reads all sensors and hands the readings to the connection without
+     * waiting for the Hub (see IConnection::sendReadingsAsync())
+     */
+    void executeReadingCycle();
+
+    /**
+     * Create a reading for a sensor
+     * @return false if the sensor returned NaN
+     */
+    bool readSensor(const std::string& type, sensor::ISensor* sensor, data::Reading& reading);
+};
+
+} // namespace controller
+
+#endif // NODE_CONTROLLER_H
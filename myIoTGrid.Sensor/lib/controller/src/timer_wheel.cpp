@@ -0,0 +1,138 @@
+#include "timer_wheel.h"
+#include "config.h"
+#include <algorithm>
+#include <iterator>
+
+namespace controller {
+
+namespace {
+
+// Signed distance so deadlines stay ordered across the millis() wrap
+inline int32_t msUntil(uint32_t deadline, uint32_t nowMs) {
+    return static_cast<int32_t>(deadline - nowMs);
+}
+
+} // anonymous namespace
+
+TimerWheel::TimerWheel()
+    : slots_(config::CONTROLLER_TIMER_SLOTS)
+    , deadlines_()
+    , lastTick_(0)
+    , started_(false)
+    , nextId_(1)
+{
+}
+
+TimerWheel::TimerId TimerWheel::schedule(uint32_t nowMs, uint32_t delayMs, Callback callback) {
+    if (!started_) {
+        lastTick_ = nowMs / config::CONTROLLER_TIMER_RESOLUTION_MS;
+        started_ = true;
+    }
+
+    TimerId id = nextId_++;
+    if (nextId_ == INVALID_TIMER) {
+        nextId_ = 1;
+    }
+
+    // Keep deadlines within the signed comparison range
+    delayMs = std::min<uint32_t>(delayMs, INT32_MAX);
+    uint32_t deadline = nowMs + delayMs;
+
+    slots_[slotFor(deadline)].push_back({id, deadline, std::move(callback)});
+    deadlines_[id] = deadline;
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    auto it = deadlines_.find(id);
+    if (it == deadlines_.end()) {
+        return false;
+    }
+
+    auto& slot = slots_[slotFor(it->second)];
+    slot.erase(std::remove_if(slot.begin(), slot.end(),
+                              [id](const Timer& timer) { return timer.id == id; }),
+               slot.end());
+
+    // A timer already collected by advance() is skipped once it is off the map
+    deadlines_.erase(it);
+    return true;
+}
+
+uint32_t TimerWheel::advance(uint32_t nowMs) {
+    if (!started_) {
+        return NO_TIMER;
+    }
+
+    uint32_t nowTick = nowMs / config::CONTROLLER_TIMER_RESOLUTION_MS;
+    uint32_t elapsedTicks = nowTick - lastTick_;
+
+    // Sweep every slot after a full revolution or when millis() wrapped
+    // (tick numbers are not continuous across the wrap)
+    if (nowTick < lastTick_ || elapsedTicks >= slots_.size()) {
+        for (size_t slot = 0; slot < slots_.size(); ++slot) {
+            fireSlot(slot, nowMs);
+        }
+    } else {
+        // Includes the current tick again: timers scheduled with a short
+        // delay since the last call land there
+        for (uint32_t tick = lastTick_; tick != nowTick + 1; ++tick) {
+            fireSlot(tick % slots_.size(), nowMs);
+        }
+    }
+    lastTick_ = nowTick;
+
+    return nextDelay(nowMs);
+}
+
+uint32_t TimerWheel::nextDelay(uint32_t nowMs) const {
+    // A controller holds a handful of timers; scanning them is cheaper than
+    // walking empty slots
+    uint32_t next = NO_TIMER;
+    for (const auto& entry : deadlines_) {
+        int32_t remaining = msUntil(entry.second, nowMs);
+        if (remaining <= 0) {
+            return 0;
+        }
+        next = std::min(next, static_cast<uint32_t>(remaining));
+    }
+    return next;
+}
+
+bool TimerWheel::isPending(TimerId id) const {
+    return deadlines_.count(id) > 0;
+}
+
+size_t TimerWheel::slotFor(uint32_t deadline) const {
+    return (deadline / config::CONTROLLER_TIMER_RESOLUTION_MS) % slots_.size();
+}
+
+void TimerWheel::fireSlot(size_t slot, uint32_t nowMs) {
+    auto& timers = slots_[slot];
+    if (timers.empty()) {
+        return;
+    }
+
+    // Collect first: callbacks schedule new timers into the same slots
+    std::vector<Timer> due;
+    auto split = std::stable_partition(timers.begin(), timers.end(),
+                                       [nowMs](const Timer& timer) {
+                                           return msUntil(timer.deadline, nowMs) > 0;
+                                       });
+    std::move(split, timers.end(), std::back_inserter(due));
+    timers.erase(split, timers.end());
+
+    std::stable_sort(due.begin(), due.end(), [nowMs](const Timer& a, const Timer& b) {
+        return msUntil(a.deadline, nowMs) < msUntil(b.deadline, nowMs);
+    });
+
+    for (auto& timer : due) {
+        // Cancelled by an earlier callback of this batch
+        if (deadlines_.erase(timer.id) == 0) {
+            continue;
+        }
+        timer.callback();
+    }
+}
+
+} // namespace controller
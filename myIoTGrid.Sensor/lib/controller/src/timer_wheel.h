@@ -0,0 +1,82 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace controller {
+
+/**
+ * TimerWheel - Hashed timing wheel for one-shot timers
+ *
+ * Timers are hashed into CONTROLLER_TIMER_SLOTS buckets of
+ * CONTROLLER_TIMER_RESOLUTION_MS each; timers further out than one
+ * revolution simply stay in their bucket until their deadline comes round.
+ * schedule() and cancel() are O(1), advance() only visits the buckets that
+ * elapsed since the last call, and nextDelay() tells the caller how long it
+ * may sleep.
+ *
+ * Not thread-safe: a wheel belongs to one controller/loop. Callbacks may
+ * schedule and cancel timers.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint32_t;
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId INVALID_TIMER = 0;
+    static constexpr uint32_t NO_TIMER = UINT32_MAX;
+
+    TimerWheel();
+
+    /**
+     * Schedule a one-shot timer
+     * @param nowMs Current time (hal::millis())
+     * @param delayMs Delay until the callback runs
+     * @return Timer ID for cancel()
+     */
+    TimerId schedule(uint32_t nowMs, uint32_t delayMs, Callback callback);
+
+    /**
+     * Cancel a pending timer
+     * @return false if the timer already fired or does not exist
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * Run all timers whose deadline is <= nowMs
+     * @return Milliseconds until the next timer, NO_TIMER if none is pending
+     */
+    uint32_t advance(uint32_t nowMs);
+
+    /**
+     * Milliseconds until the next timer (0 if overdue, NO_TIMER if none)
+     */
+    uint32_t nextDelay(uint32_t nowMs) const;
+
+    bool isPending(TimerId id) const;
+    size_t size() const { return deadlines_.size(); }
+
+private:
+    struct Timer {
+        TimerId id;
+        uint32_t deadline;
+        Callback callback;
+    };
+
+    std::vector<std::vector<Timer>> slots_;
+    std::unordered_map<TimerId, uint32_t> deadlines_;  // Pending timers (id -> deadline)
+    uint32_t lastTick_;                                // Last processed tick (ms / resolution)
+    bool started_;
+    TimerId nextId_;
+
+    size_t slotFor(uint32_t deadline) const;
+    void fireSlot(size_t slot, uint32_t nowMs);
+};
+
+} // namespace controller
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,248 @@
+#ifdef PLATFORM_NATIVE
+
+#include "fleet_simulator.h"
+#include "hal/hal.h"
+#include "config.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace fleet {
+
+FleetOptions::FleetOptions()
+    : nodeCount(config::FLEET_DEFAULT_NODES)
+    , threadCount(std::max(2u, std::thread::hardware_concurrency()))
+    , rampUpSeconds(config::FLEET_DEFAULT_RAMP_UP_SECONDS)
+    , durationSeconds(0)
+    , reportSeconds(config::FLEET_DEFAULT_REPORT_SECONDS)
+    , fleetId(config::FLEET_DEFAULT_ID)
+    , signalProfiles()
+{
+}
+
+FleetSimulator::FleetSimulator(const FleetOptions& options)
+    : options_(options)
+    , shuttingDown_(false)
+    , stopRequested_(false)
+    , nodesRunning_(0)
+{
+    if (options_.threadCount == 0) {
+        options_.threadCount = 1;
+    }
+    if (options_.reportSeconds == 0) {
+        options_.reportSeconds = config::FLEET_DEFAULT_REPORT_SECONDS;
+    }
+}
+
+FleetSimulator::~FleetSimulator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shuttingDown_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void FleetSimulator::run() {
+    hal::init();
+
+    std::printf("[Fleet] Starting %zu nodes on %zu threads (ramp-up %us, fleet %s)\n",
+                options_.nodeCount, options_.threadCount,
+                options_.rampUpSeconds, options_.fleetId.c_str());
+    for (size_t i = 0; i < options_.signalProfiles.size(); ++i) {
+        const sensor::SignalProfile& profile = options_.signalProfiles[i];
+        std::printf("[Fleet] Signal model %zu/%zu: %s%s%s\n", i + 1, options_.signalProfiles.size(),
+                    profile.preset.c_str(), profile.trace.empty() ? "" : " + trace ",
+                    profile.trace.c_str());
+    }
+    std::fflush(stdout);
+
+    Clock::time_point start = Clock::now();
+
+    nodes_.clear();
+    nodes_.reserve(options_.nodeCount);
+    for (size_t i = 0; i < options_.nodeCount; ++i) {
+        VirtualNode node;
+        node.controller = std::make_unique<controller::NodeController>(
+            buildSerial(i), "fleet_" + options_.fleetId + "_" + std::to_string(i));
+        if (!options_.signalProfiles.empty()) {
+            node.controller->setSignalProfile(options_.signalProfiles[i % options_.signalProfiles.size()]);
+        }
+        node.controller->setReadingObserver(
+            [this](const data::Reading&, const connection::ConnectionResult& result, uint32_t latencyUs) {
+                recordReading(result, latencyUs);
+            });
+        node.setupDone = false;
+        node.started = false;
+        node.registrationFailures = 0;
+        nodes_.push_back(std::move(node));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shuttingDown_ = false;
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            auto offset = std::chrono::milliseconds(
+                static_cast<uint64_t>(options_.rampUpSeconds) * 1000 * i / nodes_.size());
+            schedule_.push({start + offset, i});
+        }
+    }
+
+    for (size_t i = 0; i < options_.threadCount; ++i) {
+        workers_.emplace_back(&FleetSimulator::workerLoop, this);
+    }
+
+    // Report loop on the calling thread
+    Clock::time_point lastReport = start;
+    while (!stopRequested_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        Clock::time_point now = Clock::now();
+
+        double elapsed = std::chrono::duration<double>(now - start).count();
+        if (options_.durationSeconds > 0 && elapsed >= options_.durationSeconds) {
+            break;
+        }
+
+        double sinceReport = std::chrono::duration<double>(now - lastReport).count();
+        if (sinceReport >= options_.reportSeconds) {
+            printReport(elapsed, sinceReport);
+            lastReport = now;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shuttingDown_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    printSummary(std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+void FleetSimulator::stop() {
+    stopRequested_ = true;
+}
+
+void FleetSimulator::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!shuttingDown_) {
+        if (schedule_.empty()) {
+            wakeup_.wait(lock);
+            continue;
+        }
+
+        ScheduledNode next = schedule_.top();
+        if (next.dueAt > Clock::now()) {
+            wakeup_.wait_until(lock, next.dueAt);
+            continue;
+        }
+        schedule_.pop();
+
+        // A node is owned by exactly one worker while it runs
+        lock.unlock();
+        Clock::time_point dueAt = runNode(nodes_[next.index]);
+        lock.lock();
+
+        schedule_.push({dueAt, next.index});
+        wakeup_.notify_one();
+    }
+}
+
+FleetSimulator::Clock::time_point FleetSimulator::runNode(VirtualNode& node) {
+    if (!node.setupDone) {
+        if (!node.controller->setup()) {
+            total_.setupFailures++;
+            interval_.setupFailures++;
+            return Clock::now() + std::chrono::milliseconds(config::REGISTRATION_RETRY_DELAY_MS);
+        }
+        node.setupDone = true;
+    }
+
+    uint32_t waitMs = node.controller->tick();
+
+    // Registration retries run on the controller's own timers
+    uint32_t failures = node.controller->getRegistrationFailures();
+    if (failures != node.registrationFailures) {
+        total_.setupFailures += failures - node.registrationFailures;
+        interval_.setupFailures += failures - node.registrationFailures;
+        node.registrationFailures = failures;
+    }
+
+    if (!node.started && node.controller->isRunning()) {
+        node.started = true;
+        nodesRunning_++;
+    }
+
+    return Clock::now() + std::chrono::milliseconds(waitMs);
+}
+
+void FleetSimulator::recordReading(const connection::ConnectionResult& result, uint32_t latencyUs) {
+    if (result.success) {
+        total_.sent++;
+        interval_.sent++;
+    } else {
+        total_.failed++;
+        interval_.failed++;
+    }
+    totalLatency_.record(latencyUs);
+    intervalLatency_.record(latencyUs);
+}
+
+void FleetSimulator::printReport(double elapsedSeconds, double intervalSeconds) {
+    uint64_t sent = interval_.sent.exchange(0);
+    uint64_t failed = interval_.failed.exchange(0);
+    uint64_t setupFailures = interval_.setupFailures.exchange(0);
+    LatencySummary latency = intervalLatency_.summarize(true);
+
+    uint64_t attempts = sent + failed;
+    double errorRate = attempts > 0 ? 100.0 * failed / attempts : 0.0;
+
+    std::printf("[Fleet] %6.0fs | nodes %zu/%zu | %.1f readings/s | errors %.2f%% | "
+                "latency p50 %.1fms p90 %.1fms p99 %.1fms max %.1fms | setup failures %llu\n",
+                elapsedSeconds, nodesRunning_.load(), nodes_.size(),
+                sent / intervalSeconds, errorRate,
+                latency.p50 / 1000.0, latency.p90 / 1000.0, latency.p99 / 1000.0, latency.max / 1000.0,
+                static_cast<unsigned long long>(setupFailures));
+    std::fflush(stdout);
+}
+
+void FleetSimulator::printSummary(double elapsedSeconds) {
+    uint64_t sent = total_.sent.load();
+    uint64_t failed = total_.failed.load();
+    LatencySummary latency = totalLatency_.summarize(false);
+
+    uint64_t attempts = sent + failed;
+    double errorRate = attempts > 0 ? 100.0 * failed / attempts : 0.0;
+
+    std::printf("[Fleet] ===========================================\n");
+    std::printf("[Fleet] Duration:        %.0fs\n", elapsedSeconds);
+    std::printf("[Fleet] Nodes running:   %zu/%zu\n", nodesRunning_.load(), nodes_.size());
+    std::printf("[Fleet] Readings sent:   %llu (%.1f/s)\n",
+                static_cast<unsigned long long>(sent), elapsedSeconds > 0 ? sent / elapsedSeconds : 0.0);
+    std::printf("[Fleet] Readings failed: %llu (%.2f%%)\n",
+                static_cast<unsigned long long>(failed), errorRate);
+    std::printf("[Fleet] Setup failures:  %llu\n",
+                static_cast<unsigned long long>(total_.setupFailures.load()));
+    std::printf("[Fleet] Latency:         p50 %.1fms p90 %.1fms p99 %.1fms max %.1fms\n",
+                latency.p50 / 1000.0, latency.p90 / 1000.0, latency.p99 / 1000.0, latency.max / 1000.0);
+    std::printf("[Fleet] ===========================================\n");
+    std::fflush(stdout);
+}
+
+std::string FleetSimulator::buildSerial(size_t index) const {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "-%04zu", index + 1);
+    return std::string(config::SERIAL_PREFIX_SIM) + options_.fleetId + suffix;
+}
+
+} // namespace fleet
+
+#endif // PLATFORM_NATIVE
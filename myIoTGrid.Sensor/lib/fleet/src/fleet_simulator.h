@@ -0,0 +1,125 @@
+#ifndef FLEET_SIMULATOR_H
+#define FLEET_SIMULATOR_H
+
+#include "latency_histogram.h"
+#include "node_controller.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fleet {
+
+/**
+ * Fleet configuration
+ */
+struct FleetOptions {
+    size_t nodeCount;
+    size_t threadCount;             // Worker threads shared by all nodes
+    uint32_t rampUpSeconds;         // Node starts are spread evenly over this period
+    uint32_t durationSeconds;       // 0 = run until stop()
+    uint32_t reportSeconds;         // Interval of the aggregate report
+    std::string fleetId;            // Serial numbers: SIM-{fleetId}-{index}
+    std::vector<sensor::SignalProfile> signalProfiles;  // Round-robin per node; empty = SIM_MODEL
+
+    FleetOptions();
+};
+
+/**
+ * FleetSimulator - Runs many virtual nodes in one native process
+ *
+ * Every node is a regular controller::NodeController with its own serial
+ * number and storage namespace (so registrations survive restarts). Nodes
+ * are not given a thread each: a fixed pool of workers takes the node whose
+ * next timer is due from a shared queue, runs setup() or tick() and
+ * re-queues it for the delay tick() returned. Sent readings feed fleet-wide counters and latency
+ * histograms, reported every reportSeconds.
+ */
+class FleetSimulator {
+public:
+    explicit FleetSimulator(const FleetOptions& options);
+    ~FleetSimulator();
+
+    // Prevent copying
+    FleetSimulator(const FleetSimulator&) = delete;
+    FleetSimulator& operator=(const FleetSimulator&) = delete;
+
+    /**
+     * Start the nodes and block until durationSeconds elapsed or stop()
+     * Prints periodic reports and a final summary
+     */
+    void run();
+
+    /**
+     * Request the simulation to end (async-signal-safe)
+     */
+    void stop();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct VirtualNode {
+        std::unique_ptr<controller::NodeController> controller;
+        bool setupDone;                 // setup() returned true (may still be registering)
+        bool started;                   // Counted in nodesRunning_
+        uint32_t registrationFailures;  // Last value seen from the controller
+    };
+
+    struct ScheduledNode {
+        Clock::time_point dueAt;
+        size_t index;
+
+        bool operator>(const ScheduledNode& other) const { return dueAt > other.dueAt; }
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> sent;
+        std::atomic<uint64_t> failed;
+        std::atomic<uint64_t> setupFailures;
+
+        Counters() : sent(0), failed(0), setupFailures(0) {}
+    };
+
+    FleetOptions options_;
+    std::vector<VirtualNode> nodes_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::priority_queue<ScheduledNode, std::vector<ScheduledNode>, std::greater<ScheduledNode>> schedule_;
+    bool shuttingDown_;                 // Guarded by mutex_
+    std::atomic<bool> stopRequested_;
+
+    std::atomic<size_t> nodesRunning_;
+    Counters total_;
+    Counters interval_;
+    LatencyHistogram totalLatency_;
+    LatencyHistogram intervalLatency_;
+
+    /**
+     * Worker body: runs due nodes until shutdown
+     */
+    void workerLoop();
+
+    /**
+     * Run one step of a node
+     * @return When the node needs to run next
+     */
+    Clock::time_point runNode(VirtualNode& node);
+
+    void recordReading(const connection::ConnectionResult& result, uint32_t latencyUs);
+    void printReport(double elapsedSeconds, double intervalSeconds);
+    void printSummary(double elapsedSeconds);
+
+    std::string buildSerial(size_t index) const;
+};
+
+} // namespace fleet
+
+#endif // FLEET_SIMULATOR_H
@@ -0,0 +1,86 @@
+#include "latency_histogram.h"
+
+namespace fleet {
+
+LatencyHistogram::LatencyHistogram()
+    : max_(0)
+{
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::record(uint32_t latencyUs) {
+    buckets_[bucketIndex(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t current = max_.load(std::memory_order_relaxed);
+    while (latencyUs > current &&
+           !max_.compare_exchange_weak(current, latencyUs, std::memory_order_relaxed)) {
+    }
+}
+
+LatencySummary LatencyHistogram::summarize(bool reset) {
+    uint64_t counts[BUCKET_COUNT];
+    LatencySummary summary;
+
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = reset
+            ? buckets_[i].exchange(0, std::memory_order_relaxed)
+            : buckets_[i].load(std::memory_order_relaxed);
+        summary.count += counts[i];
+    }
+    summary.max = reset
+        ? max_.exchange(0, std::memory_order_relaxed)
+        : max_.load(std::memory_order_relaxed);
+
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    // Ranks of the requested percentiles (1-based)
+    uint64_t rank50 = (summary.count * 50 + 99) / 100;
+    uint64_t rank90 = (summary.count * 90 + 99) / 100;
+    uint64_t rank99 = (summary.count * 99 + 99) / 100;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT && seen < rank99; ++i) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        uint64_t before = seen;
+        seen += counts[i];
+        uint32_t bound = bucketUpperBound(i);
+        if (bound > summary.max) {
+            bound = summary.max;
+        }
+        if (before < rank50 && seen >= rank50) summary.p50 = bound;
+        if (before < rank90 && seen >= rank90) summary.p90 = bound;
+        if (seen >= rank99) summary.p99 = bound;
+    }
+
+    return summary;
+}
+
+size_t LatencyHistogram::bucketIndex(uint32_t value) {
+    if (value < 4) {
+        return value;
+    }
+
+    // Exponent e >= 2; 4 linear sub-buckets per power of two
+    unsigned exponent = 31 - static_cast<unsigned>(__builtin_clz(value));
+    unsigned sub = (value >> (exponent - 2)) & 0x03;
+    return 4 * (exponent - 1) + sub;
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < 4) {
+        return static_cast<uint32_t>(index);
+    }
+
+    unsigned exponent = static_cast<unsigned>(index / 4) + 1;
+    unsigned sub = static_cast<unsigned>(index % 4);
+    uint64_t upper = (static_cast<uint64_t>(4 + sub + 1) << (exponent - 2)) - 1;
+    return upper > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(upper);
+}
+
+} // namespace fleet
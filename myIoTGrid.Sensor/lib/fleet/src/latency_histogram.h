@@ -0,0 +1,54 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace fleet {
+
+/**
+ * Percentiles of a latency distribution (microseconds)
+ */
+struct LatencySummary {
+    uint64_t count;
+    uint32_t p50;
+    uint32_t p90;
+    uint32_t p99;
+    uint32_t max;
+
+    LatencySummary() : count(0), p50(0), p90(0), p99(0), max(0) {}
+};
+
+/**
+ * Lock-free log-linear latency histogram
+ *
+ * Values below 4 us get their own bucket, above that every power of two is
+ * split into 4 buckets, so percentiles are accurate to 25% over the whole
+ * uint32_t range. record() is safe to call from any number of threads.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 124;
+
+    LatencyHistogram();
+
+    void record(uint32_t latencyUs);
+
+    /**
+     * Compute percentiles (bucket upper bounds)
+     * @param reset Clear the histogram afterwards (per-interval statistics)
+     */
+    LatencySummary summarize(bool reset);
+
+private:
+    std::atomic<uint64_t> buckets_[BUCKET_COUNT];
+    std::atomic<uint32_t> max_;
+
+    static size_t bucketIndex(uint32_t value);
+    static uint32_t bucketUpperBound(size_t index);
+};
+
+} // namespace fleet
+
+#endif // LATENCY_HISTOGRAM_H
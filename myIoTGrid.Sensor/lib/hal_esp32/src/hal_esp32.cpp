@@ -0,0 +1,367 @@
+#ifdef PLATFORM_ESP32
+
+#include "hal/hal.h"
+#include "config.h"
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <Preferences.h>
+
+namespace {
+
+// Preferences for persistent storage
+Preferences preferences;
+const char* PREF_NAMESPACE = "myiotgrid";
+
+// WiFi connection status
+bool wifiConnected = false;
+
+// Serial number storage
+String deviceSerial;
+
+// Minimum logged severity (0=error ... 3=debug)
+int logLevel = 2;
+
+// TCP clients handed out by tcp_connect() (handle = index)
+constexpr int TCP_MAX_SOCKETS = 2;
+WiFiClient tcpClients[TCP_MAX_SOCKETS];
+bool tcpInUse[TCP_MAX_SOCKETS] = {};
+
+WiFiClient* tcpClient(int socket) {
+    if (socket < 0 || socket >= TCP_MAX_SOCKETS || !tcpInUse[socket]) {
+        return nullptr;
+    }
+    return &tcpClients[socket];
+}
+
+// Generate unique serial from ESP32 MAC address
+String generateSerial() {
+    uint64_t chipId = ESP.getEfuseMac();
+    char serialBuf[24];
+    snprintf(serialBuf, sizeof(serialBuf), "ESP-%08X-%04X",
+             (uint32_t)(chipId >> 16),
+             (uint16_t)(chipId & 0xFFFF));
+    return String(serialBuf);
+}
+
+} // anonymous namespace
+
+namespace hal {
+
+void init() {
+    // Initialize preferences
+    preferences.begin(PREF_NAMESPACE, false);
+
+    // Generate or load serial
+    if (preferences.isKey(config::STORAGE_KEY_SERIAL)) {
+        deviceSerial = preferences.getString(config::STORAGE_KEY_SERIAL, "");
+    }
+
+    if (deviceSerial.isEmpty()) {
+        deviceSerial = generateSerial();
+        preferences.putString(config::STORAGE_KEY_SERIAL, deviceSerial);
+    }
+
+    log_info("HAL ESP32 initialized");
+}
+
+// ============================================
+// Timing Functions
+// ============================================
+
+void delay_ms(uint32_t ms) {
+    delay(ms);
+}
+
+uint32_t millis() {
+    return ::millis();
+}
+
+uint32_t micros() {
+    return ::micros();
+}
+
+uint64_t timestamp() {
+    // Get time from NTP if available, otherwise use millis
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec;
+}
+
+// ============================================
+// Device Identification
+// ============================================
+
+std::string get_device_serial() {
+    if (deviceSerial.isEmpty()) {
+        deviceSerial = generateSerial();
+    }
+    return std::string(deviceSerial.c_str());
+}
+
+// ============================================
+// Persistent Storage
+// ============================================
+
+bool storage_save(const std::string& key, const std::string& value) {
+    return preferences.putString(key.c_str(), value.c_str()) > 0;
+}
+
+std::string storage_load(const std::string& key) {
+    String value = preferences.getString(key.c_str(), "");
+    return std::string(value.c_str());
+}
+
+bool storage_exists(const std::string& key) {
+    return preferences.isKey(key.c_str());
+}
+
+bool storage_delete(const std::string& key) {
+    return preferences.remove(key.c_str());
+}
+
+// ============================================
+// Network (WiFi)
+// ============================================
+
+bool network_connect(const std::string& ssid, const std::string& password) {
+    if (ssid.empty()) {
+        log_error("WiFi SSID is empty");
+        return false;
+    }
+
+    log_info("Connecting to WiFi: " + ssid);
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(ssid.c_str(), password.c_str());
+
+    // Wait for connection (max 30 seconds)
+    int attempts = 0;
+    while (WiFi.status() != WL_CONNECTED && attempts < 60) {
+        delay(500);
+        Serial.print(".");
+        attempts++;
+    }
+    Serial.println();
+
+    if (WiFi.status() == WL_CONNECTED) {
+        wifiConnected = true;
+        log_info("WiFi connected!");
+        log_info("IP address: " + network_get_ip());
+
+        // Configure NTP for accurate timestamps
+        configTime(0, 0, "pool.ntp.org", "time.nist.gov");
+
+        return true;
+    }
+
+    log_error("WiFi connection failed");
+    wifiConnected = false;
+    return false;
+}
+
+bool network_is_connected() {
+    return WiFi.status() == WL_CONNECTED;
+}
+
+std::string network_get_ip() {
+    if (WiFi.status() != WL_CONNECTED) {
+        return "";
+    }
+    return std::string(WiFi.localIP().toString().c_str());
+}
+
+// ============================================
+// HTTP Client
+// ============================================
+
+HttpResponse http_post(const std::string& url, const std::string& json, uint32_t timeoutMs) {
+    HttpResponse response;
+    response.success = false;
+    response.statusCode = 0;
+
+    if (!network_is_connected()) {
+        response.errorMessage = "WiFi not connected";
+        return response;
+    }
+
+    HTTPClient http;
+    http.setTimeout(timeoutMs);
+    http.begin(url.c_str());
+    http.addHeader("Content-Type", "application/json");
+    http.addHeader("Accept", "application/json");
+
+    int httpCode = http.POST(json.c_str());
+
+    if (httpCode > 0) {
+        response.statusCode = httpCode;
+        response.body = std::string(http.getString().c_str());
+        response.success = (httpCode >= 200 && httpCode < 300);
+    } else {
+        response.errorMessage = std::string(http.errorToString(httpCode).c_str());
+    }
+
+    http.end();
+    return response;
+}
+
+HttpResponse http_get(const std::string& url, uint32_t timeoutMs) {
+    HttpResponse response;
+    response.success = false;
+    response.statusCode = 0;
+
+    if (!network_is_connected()) {
+        response.errorMessage = "WiFi not connected";
+        return response;
+    }
+
+    HTTPClient http;
+    http.setTimeout(timeoutMs);
+    http.begin(url.c_str());
+    http.addHeader("Accept", "application/json");
+
+    int httpCode = http.GET();
+
+    if (httpCode > 0) {
+        response.statusCode = httpCode;
+        response.body = std::string(http.getString().c_str());
+        response.success = (httpCode >= 200 && httpCode < 300);
+    } else {
+        response.errorMessage = std::string(http.errorToString(httpCode).c_str());
+    }
+
+    http.end();
+    return response;
+}
+
+void http_post_async(const std::string& url, const std::string& json, uint32_t timeoutMs,
+                     HttpCallback callback) {
+    HttpResponse response = http_post(url, json, timeoutMs);
+    if (callback) {
+        callback(response);
+    }
+}
+
+// ============================================
+// TCP Client
+// ============================================
+
+int tcp_connect(const std::string& host, uint16_t port, uint32_t timeoutMs) {
+    if (!network_is_connected()) {
+        return -1;
+    }
+
+    for (int socket = 0; socket < TCP_MAX_SOCKETS; ++socket) {
+        if (tcpInUse[socket]) {
+            continue;
+        }
+        if (!tcpClients[socket].connect(host.c_str(), port, static_cast<int32_t>(timeoutMs))) {
+            log_error("TCP connect to " + host + ":" + std::to_string(port) + " failed");
+            return -1;
+        }
+        tcpClients[socket].setNoDelay(true);
+        tcpInUse[socket] = true;
+        return socket;
+    }
+
+    log_error("TCP connect failed: no free socket");
+    return -1;
+}
+
+bool tcp_write(int socket, const uint8_t* data, size_t length) {
+    WiFiClient* client = tcpClient(socket);
+    if (!client || !client->connected()) {
+        return false;
+    }
+    return client->write(data, length) == length;
+}
+
+int tcp_read(int socket, uint8_t* buffer, size_t length, uint32_t timeoutMs) {
+    WiFiClient* client = tcpClient(socket);
+    if (!client) {
+        return -1;
+    }
+
+    uint32_t start = ::millis();
+    while (client->available() == 0) {
+        if (!client->connected()) {
+            return -1;
+        }
+        if (::millis() - start >= timeoutMs) {
+            return 0;
+        }
+        delay(1);
+    }
+
+    int count = client->read(buffer, length);
+    return count < 0 ? 0 : count;
+}
+
+void tcp_close(int socket) {
+    WiFiClient* client = tcpClient(socket);
+    if (client) {
+        client->stop();
+        tcpInUse[socket] = false;
+    }
+}
+
+// ============================================
+// Logging
+// ============================================
+
+void log_info(const std::string& message) {
+    if (logLevel < 2) return;
+    Serial.print("[INFO]  ");
+    Serial.println(message.c_str());
+}
+
+void log_warn(const std::string& message) {
+    if (logLevel < 1) return;
+    Serial.print("[WARN]  ");
+    Serial.println(message.c_str());
+}
+
+void log_error(const std::string& message) {
+    Serial.print("[ERROR] ");
+    Serial.println(message.c_str());
+}
+
+void log_debug(const std::string& message) {
+#ifdef DEBUG
+    if (logLevel < 3) return;
+    Serial.print("[DEBUG] ");
+    Serial.println(message.c_str());
+#else
+    (void)message;
+#endif
+}
+
+void log_set_level(int level) {
+    logLevel = level;
+}
+
+// ============================================
+// System
+// ============================================
+
+uint32_t get_free_heap() {
+    return ESP.getFreeHeap();
+}
+
+void restart() {
+    log_info("Restarting...");
+    delay(100);
+    ESP.restart();
+}
+
+std::string get_env(const std::string& name, const std::string& defaultValue) {
+    // ESP32 doesn't have environment variables
+    // Could read from preferences or compile-time defines
+    (void)name;
+    return defaultValue;
+}
+
+} // namespace hal
+
+#endif // PLATFORM_ESP32
@@ -0,0 +1,12 @@
+/**
+ * Arduino.cpp - Implementation for Native Platform
+ */
+
+#ifdef PLATFORM_NATIVE
+
+#include "Arduino.h"
+
+// Global Serial instance
+SerialClass Serial;
+
+#endif // PLATFORM_NATIVE
@@ -0,0 +1,438 @@
+#ifdef PLATFORM_NATIVE
+
+#include "hal/hal.h"
+#include "http_transport.h"
+#include "virtual_clock.h"
+#include "config.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <ctime>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include <curl/curl.h>
+#include <atomic>
+#include <mutex>
+#include <random>
+
+namespace {
+
+// Minimum logged severity (0=error ... 3=debug), lines are written under logMutex
+std::atomic<int> logLevel(2);
+std::mutex logMutex;
+std::once_flag initOnce;
+
+// Get current timestamp string for logging
+std::string getTimestampStr() {
+    auto now = std::chrono::system_clock::now();
+    auto time = std::chrono::system_clock::to_time_t(now);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now.time_since_epoch()) % 1000;
+
+    struct tm local;
+    localtime_r(&time, &local);
+
+    std::stringstream ss;
+    ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
+    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
+    return ss.str();
+}
+
+// Get storage file path for a key
+std::string getStoragePath(const std::string& key) {
+    // In Docker container, use /data volume which is writable
+    // Otherwise fall back to config::DATA_DIR
+    const char* dataDir = std::getenv("DATA_DIR");
+    if (!dataDir || strlen(dataDir) == 0) {
+        dataDir = config::DATA_DIR;
+    }
+    return std::string(dataDir) + "/" + key + ".dat";
+}
+
+// Ensure data directory exists
+void ensureDataDir() {
+    const char* dataDir = std::getenv("DATA_DIR");
+    if (!dataDir || strlen(dataDir) == 0) {
+        dataDir = config::DATA_DIR;
+    }
+    struct stat st;
+    if (stat(dataDir, &st) != 0) {
+        mkdir(dataDir, 0755);
+    }
+}
+
+// Generate UUID string (simple random-based implementation)
+std::string generateUUID() {
+    static std::random_device rd;
+    static std::mt19937_64 gen(rd());
+    static std::uniform_int_distribution<uint64_t> dis;
+
+    uint64_t part1 = dis(gen);
+    uint64_t part2 = dis(gen);
+
+    char buffer[37];
+    snprintf(buffer, sizeof(buffer),
+             "%08X-%04X-%04X-%04X-%012llX",
+             static_cast<uint32_t>(part1 >> 32),
+             static_cast<uint16_t>((part1 >> 16) & 0xFFFF),
+             static_cast<uint16_t>((part1 & 0x0FFF) | 0x4000),  // Version 4
+             static_cast<uint16_t>((part2 >> 48) & 0x3FFF | 0x8000),  // Variant
+             static_cast<unsigned long long>(part2 & 0xFFFFFFFFFFFFULL));
+    return std::string(buffer);
+}
+
+} // anonymous namespace
+
+namespace hal {
+
+void init() {
+    // Every NodeController calls init(); in fleet mode many of them share the process
+    std::call_once(initOnce, []() {
+        ensureDataDir();
+        curl_global_init(CURL_GLOBAL_ALL);
+        log_info("HAL Native initialized");
+    });
+}
+
+// ============================================
+// Timing Functions
+// ============================================
+
+void delay_ms(uint32_t ms) {
+    native::Clock::sleepMicros(static_cast<uint64_t>(ms) * 1000);
+}
+
+uint32_t millis() {
+    return static_cast<uint32_t>(native::Clock::millis());
+}
+
+uint32_t micros() {
+    return static_cast<uint32_t>(native::Clock::micros());
+}
+
+uint64_t timestamp() {
+    return native::Clock::unixSeconds();
+}
+
+// ============================================
+// Device Identification
+// ============================================
+
+std::string get_device_serial() {
+    // Try to load existing serial
+    if (storage_exists(config::STORAGE_KEY_SERIAL)) {
+        std::string serial = storage_load(config::STORAGE_KEY_SERIAL);
+        if (!serial.empty()) {
+            return serial;
+        }
+    }
+
+    // Generate new serial
+    std::string uuid = generateUUID();
+    // Take first 8 chars of UUID and format as SIM-XXXXXXXX-0001
+    std::string shortUuid = uuid.substr(0, 8);
+    std::string serial = std::string(config::SERIAL_PREFIX_SIM) + shortUuid + "-0001";
+
+    // Save for persistence
+    storage_save(config::STORAGE_KEY_SERIAL, serial);
+
+    log_info("Generated new serial: " + serial);
+    return serial;
+}
+
+// ============================================
+// Persistent Storage
+// ============================================
+
+bool storage_save(const std::string& key, const std::string& value) {
+    ensureDataDir();
+    std::string path = getStoragePath(key);
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        log_error("Failed to open file for writing: " + path);
+        return false;
+    }
+    file << value;
+    file.close();
+    return true;
+}
+
+std::string storage_load(const std::string& key) {
+    std::string path = getStoragePath(key);
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return "";
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+bool storage_exists(const std::string& key) {
+    std::string path = getStoragePath(key);
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+bool storage_delete(const std::string& key) {
+    std::string path = getStoragePath(key);
+    return remove(path.c_str()) == 0 || !storage_exists(key);
+}
+
+// ============================================
+// Network
+// ============================================
+
+bool network_connect(const std::string& ssid, const std::string& password) {
+    // Native always has network available
+    (void)ssid;
+    (void)password;
+    log_info("Network: Native environment - network always available");
+    return true;
+}
+
+bool network_is_connected() {
+    // Native always has network
+    return true;
+}
+
+std::string network_get_ip() {
+    return "127.0.0.1";
+}
+
+// ============================================
+// HTTP Client
+// ============================================
+
+namespace {
+
+// HTTPS: Allow self-signed certificates (for development)
+bool insecureTls() {
+    const char* insecure = std::getenv("HUB_INSECURE");
+    return insecure && std::string(insecure) == "true";
+}
+
+HttpResponse toHttpResponse(native::HttpResult&& result, const char* method) {
+    HttpResponse response;
+    response.statusCode = result.statusCode;
+    response.body = std::move(result.body);
+    response.success = result.success && result.statusCode >= 200 && result.statusCode < 300;
+
+    if (!result.success) {
+        response.errorMessage = std::move(result.errorMessage);
+        log_error(std::string("HTTP ") + method + " failed: " + response.errorMessage);
+    }
+    return response;
+}
+
+} // anonymous namespace
+
+HttpResponse http_post(const std::string& url, const std::string& json, uint32_t timeoutMs) {
+    native::HttpRequest request;
+    request.method = "POST";
+    request.url = url;
+    request.body = json;
+    request.headers = {"Content-Type: application/json", "Accept: application/json"};
+    request.timeoutMs = timeoutMs;
+    request.insecure = insecureTls();
+
+    return toHttpResponse(native::HttpTransport::instance().perform(std::move(request)), "POST");
+}
+
+HttpResponse http_get(const std::string& url, uint32_t timeoutMs) {
+    native::HttpRequest request;
+    request.method = "GET";
+    request.url = url;
+    request.headers = {"Accept: application/json"};
+    request.timeoutMs = timeoutMs;
+    request.insecure = insecureTls();
+
+    return toHttpResponse(native::HttpTransport::instance().perform(std::move(request)), "GET");
+}
+
+void http_post_async(const std::string& url, const std::string& json, uint32_t timeoutMs,
+                     HttpCallback callback) {
+    native::HttpRequest request;
+    request.method = "POST";
+    request.url = url;
+    request.body = json;
+    request.headers = {"Content-Type: application/json", "Accept: application/json"};
+    request.timeoutMs = timeoutMs;
+    request.insecure = insecureTls();
+
+    native::HttpTransport::instance().submit(std::move(request),
+        [callback](native::HttpResult&& result) {
+            HttpResponse response = toHttpResponse(std::move(result), "POST");
+            if (callback) {
+                callback(response);
+            }
+        });
+}
+
+// ============================================
+// TCP Client
+// ============================================
+
+int tcp_connect(const std::string& host, uint16_t port, uint32_t timeoutMs) {
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* addresses = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0) {
+        log_error("TCP: Cannot resolve " + host);
+        return -1;
+    }
+
+    int fd = -1;
+    for (struct addrinfo* addr = addresses; addr != nullptr; addr = addr->ai_next) {
+        fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        // Non-blocking connect to honour the timeout
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+        bool connected = connect(fd, addr->ai_addr, addr->ai_addrlen) == 0;
+        if (!connected && errno == EINPROGRESS) {
+            struct pollfd pfd = { fd, POLLOUT, 0 };
+            int error = 0;
+            socklen_t errorLength = sizeof(error);
+            connected = poll(&pfd, 1, static_cast<int>(timeoutMs)) == 1 &&
+                        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &errorLength) == 0 &&
+                        error == 0;
+        }
+
+        if (connected) {
+            fcntl(fd, F_SETFL, flags);
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            break;
+        }
+
+        close(fd);
+        fd = -1;
+    }
+
+    freeaddrinfo(addresses);
+
+    if (fd < 0) {
+        log_error("TCP: Connect to " + host + ":" + service + " failed");
+    }
+    return fd;
+}
+
+bool tcp_write(int socket, const uint8_t* data, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        ssize_t count = send(socket, data + written, length - written, MSG_NOSIGNAL);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+int tcp_read(int socket, uint8_t* buffer, size_t length, uint32_t timeoutMs) {
+    struct pollfd pfd = { socket, POLLIN, 0 };
+    int ready = poll(&pfd, 1, static_cast<int>(timeoutMs));
+    if (ready < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    if (ready == 0) {
+        return 0;
+    }
+
+    ssize_t count = recv(socket, buffer, length, 0);
+    if (count <= 0) {
+        return -1;  // Closed by peer or error
+    }
+    return static_cast<int>(count);
+}
+
+void tcp_close(int socket) {
+    if (socket >= 0) {
+        close(socket);
+    }
+}
+
+// ============================================
+// Logging
+// ============================================
+
+void log_info(const std::string& message) {
+    if (logLevel < 2) return;
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::cout << "[" << getTimestampStr() << "] [INFO]  " << message << std::endl;
+}
+
+void log_warn(const std::string& message) {
+    if (logLevel < 1) return;
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::cout << "[" << getTimestampStr() << "] [WARN]  " << message << std::endl;
+}
+
+void log_error(const std::string& message) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::cerr << "[" << getTimestampStr() << "] [ERROR] " << message << std::endl;
+}
+
+void log_debug(const std::string& message) {
+#ifdef DEBUG
+    if (logLevel < 3) return;
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::cout << "[" << getTimestampStr() << "] [DEBUG] " << message << std::endl;
+#else
+    (void)message;
+#endif
+}
+
+void log_set_level(int level) {
+    logLevel = level;
+}
+
+// ============================================
+// System
+// ============================================
+
+uint32_t get_free_heap() {
+    // Not really meaningful on native, return a large value
+    return 1024 * 1024 * 100; // 100 MB
+}
+
+void restart() {
+    log_info("Restart requested - exiting process");
+    native::HttpTransport::instance().shutdown();
+    curl_global_cleanup();
+    exit(0);
+}
+
+std::string get_env(const std::string& name, const std::string& defaultValue) {
+    const char* value = std::getenv(name.c_str());
+    return value ? std::string(value) : defaultValue;
+}
+
+} // namespace hal
+
+#endif // PLATFORM_NATIVE
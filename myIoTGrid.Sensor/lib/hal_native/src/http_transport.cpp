@@ -0,0 +1,336 @@
+#ifdef PLATFORM_NATIVE
+
+#include "http_transport.h"
+#include "config.h"
+#include <algorithm>
+#include <future>
+#include <strings.h>
+
+namespace hal {
+namespace native {
+
+/**
+ * Pooled easy handle plus the request it currently runs
+ */
+struct HttpTransport::Transfer {
+    CURL* easy;
+    Pending pending;
+    HttpResult result;
+    curl_slist* ownedHeaders;           // Header list not kept in the cache
+    char errorBuffer[CURL_ERROR_SIZE];
+};
+
+namespace {
+
+size_t writeBody(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    static_cast<HttpResult*>(userdata)->body.append(ptr, size * nmemb);
+    return size * nmemb;
+}
+
+// Keeps the ETag header; with HTTP/2 header names arrive lower-case
+size_t readHeader(char* buffer, size_t size, size_t nitems, void* userdata) {
+    size_t length = size * nitems;
+    if (length > 5 && strncasecmp(buffer, "ETag:", 5) == 0) {
+        std::string value(buffer + 5, length - 5);
+        size_t start = value.find_first_not_of(" \t");
+        size_t end = value.find_last_not_of(" \t\r\n");
+        static_cast<HttpResult*>(userdata)->etag =
+            start == std::string::npos ? "" : value.substr(start, end - start + 1);
+    }
+    return length;
+}
+
+// Headers that change with every request (conditional GETs carry the last ETag)
+bool isPerRequestHeader(const std::string& header) {
+    return strncasecmp(header.c_str(), "If-None-Match:", 14) == 0;
+}
+
+} // anonymous namespace
+
+HttpTransport& HttpTransport::instance() {
+    // Never destroyed: requests may still complete during static destruction
+    static HttpTransport* transport = new HttpTransport();
+    return *transport;
+}
+
+HttpTransport::HttpTransport()
+    : multi_(nullptr)
+    , share_(nullptr)
+    , running_(true)
+    , inFlight_(0)
+{
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    share_ = curl_share_init();
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    multi_ = curl_multi_init();
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(config::HTTP_TRANSPORT_MAX_HOST_CONNECTIONS));
+    curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS,
+                      static_cast<long>(config::HTTP_TRANSPORT_MAX_HOST_CONNECTIONS * 2));
+
+    thread_ = std::thread(&HttpTransport::run, this);
+}
+
+void HttpTransport::submit(HttpRequest request, Callback callback) {
+    {
+        // Woken under the lock: once running_ is false the worker may free multi_
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            queue_.push_back({std::move(request), std::move(callback)});
+            curl_multi_wakeup(multi_);
+            return;
+        }
+    }
+
+    HttpResult result;
+    result.errorMessage = "HTTP transport stopped";
+    callback(std::move(result));
+}
+
+HttpResult HttpTransport::perform(HttpRequest request) {
+    if (std::this_thread::get_id() == thread_.get_id()) {
+        HttpResult result;
+        result.errorMessage = "Blocking request from the HTTP transport thread";
+        return result;
+    }
+
+    std::promise<HttpResult> promise;
+    std::future<HttpResult> future = promise.get_future();
+    submit(std::move(request), [&promise](HttpResult&& result) {
+        promise.set_value(std::move(result));
+    });
+    return future.get();
+}
+
+void HttpTransport::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        curl_multi_wakeup(multi_);
+    }
+
+    if (thread_.joinable() && std::this_thread::get_id() != thread_.get_id()) {
+        thread_.join();
+    }
+}
+
+size_t HttpTransport::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inFlight_;
+}
+
+void HttpTransport::run() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                break;
+            }
+        }
+
+        startTransfers();
+
+        int stillRunning = 0;
+        curl_multi_perform(multi_, &stillRunning);
+        finishTransfers();
+
+        // Sleeps until socket activity, a curl timeout or submit()/shutdown()
+        curl_multi_poll(multi_, nullptr, 0, config::HTTP_TRANSPORT_IDLE_POLL_MS, nullptr);
+    }
+
+    // running_ is false: submit() and shutdown() no longer touch multi_
+    failAll("HTTP transport stopped");
+
+    for (Transfer* transfer : idle_) {
+        curl_easy_cleanup(transfer->easy);
+        delete transfer;
+    }
+    idle_.clear();
+    for (auto& entry : headerLists_) {
+        curl_slist_free_all(entry.second);
+    }
+    headerLists_.clear();
+
+    curl_multi_cleanup(multi_);
+    curl_share_cleanup(share_);
+    multi_ = nullptr;
+    share_ = nullptr;
+}
+
+void HttpTransport::startTransfers() {
+    for (;;) {
+        Pending pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.empty() || inFlight_ >= config::HTTP_TRANSPORT_MAX_IN_FLIGHT) {
+                return;
+            }
+            pending = std::move(queue_.front());
+            queue_.pop_front();
+            inFlight_++;
+        }
+
+        Transfer* transfer;
+        if (idle_.empty()) {
+            transfer = new Transfer();
+            transfer->easy = curl_easy_init();
+        } else {
+            transfer = idle_.back();
+            idle_.pop_back();
+            curl_easy_reset(transfer->easy);
+        }
+        transfer->pending = std::move(pending);
+        transfer->result = HttpResult();
+        transfer->ownedHeaders = nullptr;
+        transfer->errorBuffer[0] = '\0';
+
+        const HttpRequest& request = transfer->pending.request;
+        CURL* easy = transfer->easy;
+
+        curl_easy_setopt(easy, CURLOPT_URL, request.url.c_str());
+        if (request.method == "POST") {
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.c_str());
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+        } else {
+            curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+        }
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, headerList(request.headers, transfer));
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeBody);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->result);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, readHeader);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, &transfer->result);
+        curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, transfer->errorBuffer);
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(request.timeoutMs));
+        curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(request.timeoutMs / 2));
+        curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy, CURLOPT_SHARE, share_);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+
+        // h2 via ALPN on HTTPS; wait for a multiplexed stream instead of
+        // opening another connection to the same Hub
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+
+        if (request.insecure) {
+            curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, 0L);
+        }
+
+        curl_multi_add_handle(multi_, easy);
+        active_.push_back(transfer);
+    }
+}
+
+void HttpTransport::finishTransfers() {
+    int remaining = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi_, &remaining)) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+
+        Transfer* transfer = nullptr;
+        curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+
+        HttpResult result = std::move(transfer->result);
+        if (message->data.result == CURLE_OK) {
+            long statusCode = 0;
+            curl_easy_getinfo(transfer->easy, CURLINFO_RESPONSE_CODE, &statusCode);
+            result.statusCode = static_cast<int>(statusCode);
+            result.success = true;
+        } else {
+            result.errorMessage = transfer->errorBuffer[0] != '\0'
+                ? transfer->errorBuffer
+                : curl_easy_strerror(message->data.result);
+        }
+
+        complete(transfer, std::move(result));
+    }
+}
+
+void HttpTransport::complete(Transfer* transfer, HttpResult&& result) {
+    curl_multi_remove_handle(multi_, transfer->easy);
+    active_.erase(std::find(active_.begin(), active_.end(), transfer));
+    curl_slist_free_all(transfer->ownedHeaders);
+    transfer->ownedHeaders = nullptr;
+
+    Callback callback = std::move(transfer->pending.callback);
+    transfer->pending = Pending();
+
+    if (idle_.size() < config::HTTP_TRANSPORT_MAX_IN_FLIGHT) {
+        idle_.push_back(transfer);
+    } else {
+        curl_easy_cleanup(transfer->easy);
+        delete transfer;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_--;
+    }
+
+    if (callback) {
+        callback(std::move(result));
+    }
+}
+
+void HttpTransport::failAll(const std::string& reason) {
+    while (!active_.empty()) {
+        HttpResult result;
+        result.errorMessage = reason;
+        complete(active_.back(), std::move(result));
+    }
+
+    std::deque<Pending> queued;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued.swap(queue_);
+    }
+    for (auto& pending : queued) {
+        HttpResult result;
+        result.errorMessage = reason;
+        pending.callback(std::move(result));
+    }
+}
+
+curl_slist* HttpTransport::headerList(const std::vector<std::string>& headers, Transfer* transfer) {
+    std::string key;
+    bool perRequest = false;
+    for (const auto& header : headers) {
+        key += header;
+        key += '\n';
+        perRequest = perRequest || isPerRequestHeader(header);
+    }
+
+    if (!perRequest) {
+        auto cached = headerLists_.find(key);
+        if (cached != headerLists_.end()) {
+            return cached->second;
+        }
+    }
+
+    curl_slist* list = nullptr;
+    for (const auto& header : headers) {
+        list = curl_slist_append(list, header.c_str());
+    }
+
+    // Per-request sets would fill the cache with stale entries; freed after the transfer
+    if (!perRequest && headerLists_.size() < config::HTTP_TRANSPORT_HEADER_CACHE_SIZE) {
+        headerLists_[key] = list;
+    } else {
+        transfer->ownedHeaders = list;
+    }
+    return list;
+}
+
+} // namespace native
+} // namespace hal
+
+#endif // PLATFORM_NATIVE
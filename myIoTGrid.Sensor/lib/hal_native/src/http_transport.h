@@ -0,0 +1,135 @@
+#ifndef HTTP_TRANSPORT_H
+#define HTTP_TRANSPORT_H
+
+#ifdef PLATFORM_NATIVE
+
+#include <curl/curl.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace hal {
+namespace native {
+
+/**
+ * One HTTP request for the shared transport
+ */
+struct HttpRequest {
+    std::string method;                 // "GET" or "POST"
+    std::string url;
+    std::string body;                   // POST payload
+    std::vector<std::string> headers;   // "Name: value"
+    uint32_t timeoutMs;
+    bool insecure;                      // Skip TLS verification (HUB_INSECURE=true)
+
+    HttpRequest() : method("GET"), timeoutMs(10000), insecure(false) {}
+};
+
+/**
+ * Result of an HTTP request
+ * success = transfer completed (any status code); errorMessage otherwise
+ */
+struct HttpResult {
+    bool success;
+    int statusCode;
+    std::string body;
+    std::string etag;                   // ETag response header, if any
+    std::string errorMessage;
+
+    HttpResult() : success(false), statusCode(0) {}
+};
+
+/**
+ * HttpTransport - Process-wide libcurl multi transport
+ *
+ * All native HTTP traffic (hal::http_post/http_get, ApiClient) goes through
+ * one curl multi handle driven by a single transport thread:
+ * - Connections are kept alive and reused from the multi connection cache
+ * - DNS results and TLS sessions are shared between all transfers
+ * - HTTP/2 is negotiated via ALPN on HTTPS and concurrent requests to the
+ *   same Hub are multiplexed over one connection
+ * - Up to HTTP_TRANSPORT_MAX_IN_FLIGHT transfers run at once; further
+ *   requests wait in a queue
+ *
+ * Easy handles and header lists are pooled, so a request does not allocate
+ * curl state once the transport is warm.
+ */
+class HttpTransport {
+public:
+    using Callback = std::function<void(HttpResult&&)>;
+
+    /**
+     * Shared instance (started on first use)
+     */
+    static HttpTransport& instance();
+
+    /**
+     * Queue a request
+     * @param callback Invoked on the transport thread when the transfer
+     *                 ends; must not block or call perform()
+     */
+    void submit(HttpRequest request, Callback callback);
+
+    /**
+     * Run a request and wait for its result (not from a callback)
+     */
+    HttpResult perform(HttpRequest request);
+
+    /**
+     * Fail pending requests and stop the transport thread
+     * Called before curl_global_cleanup()
+     */
+    void shutdown();
+
+    /**
+     * Transfers currently running on the multi handle
+     */
+    size_t inFlight() const;
+
+    HttpTransport(const HttpTransport&) = delete;
+    HttpTransport& operator=(const HttpTransport&) = delete;
+
+private:
+    struct Pending {
+        HttpRequest request;
+        Callback callback;
+    };
+
+    struct Transfer;
+
+    CURLM* multi_;                      // Freed by the worker after running_ clears; woken under mutex_
+    CURLSH* share_;                     // DNS cache and TLS sessions
+    std::thread thread_;
+
+    mutable std::mutex mutex_;
+    std::deque<Pending> queue_;         // Guarded by mutex_
+    bool running_;                      // Guarded by mutex_
+    size_t inFlight_;                   // Guarded by mutex_
+
+    // Transport thread only
+    std::vector<Transfer*> active_;     // Added to multi_
+    std::vector<Transfer*> idle_;       // Pooled easy handles
+    std::unordered_map<std::string, curl_slist*> headerLists_;  // Joined headers -> list
+
+    HttpTransport();
+    ~HttpTransport() = default;
+
+    void run();
+    void startTransfers();
+    void finishTransfers();
+    void complete(Transfer* transfer, HttpResult&& result);
+    void failAll(const std::string& reason);
+    curl_slist* headerList(const std::vector<std::string>& headers, Transfer* transfer);
+};
+
+} // namespace native
+} // namespace hal
+
+#endif // PLATFORM_NATIVE
+
+#endif // HTTP_TRANSPORT_H
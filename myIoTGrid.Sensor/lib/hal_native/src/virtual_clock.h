@@ -0,0 +1,132 @@
+/**
+ * Process clock for the native platform
+ * Backs millis()/micros()/delay() of the Arduino stub and the hal:: timing functions
+ */
+
+#ifndef VIRTUAL_CLOCK_H
+#define VIRTUAL_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace hal {
+namespace native {
+
+/**
+ * Clock - Real time by default, virtual time for session replay
+ *
+ * In virtual mode waits return immediately and move the clock forward
+ * instead, so a recorded session replays at full CPU speed with the
+ * original schedule. Every read advances virtual time by 1 us; loops that
+ * busy-wait on millis() still terminate.
+ */
+class Clock {
+public:
+    /**
+     * Microseconds since process start (real or virtual)
+     */
+    static uint64_t micros() {
+        State& s = state();
+        if (s.virtualTime.load(std::memory_order_acquire)) {
+            return s.virtualMicros.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+        return realMicros();
+    }
+
+    static uint64_t millis() {
+        return micros() / 1000;
+    }
+
+    /**
+     * Wait (real mode) or advance the clock (virtual mode)
+     */
+    static void sleepMicros(uint64_t us) {
+        State& s = state();
+        if (s.virtualTime.load(std::memory_order_acquire)) {
+            s.virtualMicros.fetch_add(us, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+
+    /**
+     * Account for time spent outside the process (e.g., replayed network latency)
+     * No effect in real mode, where that time has really passed.
+     */
+    static void advanceMicros(uint64_t us) {
+        State& s = state();
+        if (s.virtualTime.load(std::memory_order_acquire)) {
+            s.virtualMicros.fetch_add(us, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Switch to virtual time; the clock continues from its current value
+     * @param unixSeconds Wall-clock time at the switch (0 = current time)
+     */
+    static void useVirtualTime(uint64_t unixSeconds) {
+        State& s = state();
+        if (s.virtualTime.load(std::memory_order_acquire)) {
+            return;
+        }
+        uint64_t now = realMicros();
+        s.virtualMicros.store(now, std::memory_order_relaxed);
+        s.virtualStartMicros = now;
+        s.virtualUnixStart = unixSeconds ? unixSeconds : realUnixSeconds();
+        s.virtualTime.store(true, std::memory_order_release);
+    }
+
+    static bool isVirtual() {
+        return state().virtualTime.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Unix time in seconds (virtual mode: start time plus virtual elapsed time)
+     */
+    static uint64_t unixSeconds() {
+        State& s = state();
+        if (s.virtualTime.load(std::memory_order_acquire)) {
+            uint64_t elapsed = s.virtualMicros.load(std::memory_order_relaxed) - s.virtualStartMicros;
+            return s.virtualUnixStart + elapsed / 1000000;
+        }
+        return realUnixSeconds();
+    }
+
+private:
+    struct State {
+        std::chrono::steady_clock::time_point start;
+        std::atomic<bool> virtualTime;
+        std::atomic<uint64_t> virtualMicros;
+        uint64_t virtualStartMicros;
+        uint64_t virtualUnixStart;
+
+        State()
+            : start(std::chrono::steady_clock::now())
+            , virtualTime(false)
+            , virtualMicros(0)
+            , virtualStartMicros(0)
+            , virtualUnixStart(0) {}
+    };
+
+    static State& state() {
+        static State instance;
+        return instance;
+    }
+
+    static uint64_t realMicros() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - state().start).count());
+    }
+
+    static uint64_t realUnixSeconds() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+};
+
+} // namespace native
+} // namespace hal
+
+#endif // VIRTUAL_CLOCK_H
@@ -0,0 +1,103 @@
+#ifndef SIGNAL_MATH_H
+#define SIGNAL_MATH_H
+
+#include <cstdint>
+#include <string>
+
+namespace sensor {
+namespace signal {
+
+/**
+ * Helpers for synthetic sensor data
+ *
+ * Everything here is branch-free and works on one sample at a time without
+ * shared state, so loops over sample arrays auto-vectorize and threads
+ * never contend (unlike std::rand()).
+ */
+
+/**
+ * SplitMix64 step - expands a seed into well-mixed 64-bit values
+ */
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * FNV-1a hash of a string (stable seed component for type codes/serials)
+ */
+inline uint64_t hashString(const std::string& text) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (char c : text) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Counter-based 32-bit hash (lowbias32)
+ * Sample i of a stream is hash32(key ^ i * golden): no sequential state,
+ * so any slice of a stream can be generated independently.
+ */
+inline uint32_t hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352DU;
+    x ^= x >> 15;
+    x *= 0x846CA68BU;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * Uniform noise in [-1, 1) for sample `counter` of stream `key`
+ */
+inline float uniformNoise(uint32_t key, uint32_t counter) {
+    uint32_t bits = hash32(key ^ (counter * 0x9E3779B9U));
+    // 24 random bits -> [0, 1)
+    return static_cast<float>(bits >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+/**
+ * Approximately standard normal noise for sample `counter` of stream `key`
+ * Sum of four 16-bit uniforms (Irwin-Hall), scaled to unit variance;
+ * tails end at +-3.46, which is fine for sensor noise.
+ */
+inline float gaussianNoise(uint32_t key, uint32_t counter) {
+    uint32_t a = hash32(key ^ (counter * 0x9E3779B9U));
+    uint32_t b = hash32(a ^ 0x85EBCA6BU);
+    float sum = static_cast<float>((a & 0xFFFFU) + (a >> 16) + (b & 0xFFFFU) + (b >> 16));
+    // Mean 4 * 32767.5, variance 4 * 65536^2 / 12
+    return (sum - 131070.0f) * (1.7320508f / 65536.0f);
+}
+
+/**
+ * Uniform value in [0, 1) for sample `counter` of stream `key`
+ */
+inline float uniformUnit(uint32_t key, uint32_t counter) {
+    return static_cast<float>(hash32(key ^ (counter * 0x9E3779B9U)) >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * sin(2*pi*turns), max. error about 0.001
+ * Range reduction to [-0.5, 0.5) turns, parabola plus one refinement step.
+ */
+inline float fastSinTurns(float turns) {
+    // Truncation instead of floor() keeps this convertible to SIMD integer ops
+    float wrapped = turns - static_cast<float>(static_cast<int32_t>(turns));
+    wrapped += (wrapped < 0.0f) ? 1.0f : 0.0f;      // [0, 1)
+    float u = wrapped - 0.5f;                       // [-0.5, 0.5), sin(2*pi*u) = -sin(2*pi*turns)
+
+    float absU = u < 0.0f ? -u : u;
+    float y = 8.0f * u - 16.0f * u * absU;          // Parabola through the extremes
+    float absY = y < 0.0f ? -y : y;
+    y = 0.225f * (y * absY - y) + y;                // Error correction
+    return -y;
+}
+
+} // namespace signal
+} // namespace sensor
+
+#endif // SIGNAL_MATH_H
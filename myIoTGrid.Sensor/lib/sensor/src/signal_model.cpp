@@ -0,0 +1,424 @@
+#include "signal_model.h"
+#include "signal_math.h"
+#include "trace_replay.h"
+#include "hal/hal.h"
+#include "config.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace sensor {
+
+namespace {
+
+constexpr float SECONDS_PER_DAY = 86400.0f;
+constexpr float DAYS_PER_YEAR = 365.25f;
+
+// Day cycle peaks at 14:00, daylight at 12:00, the annual cycle mid-July
+constexpr float DAY_CYCLE_PHASE_TURNS = 1.0f / 3.0f;
+constexpr float DAYLIGHT_PHASE_TURNS = 0.25f;
+constexpr float SEASON_PHASE_TURNS = 0.29f;
+
+// Spikes are 10-20 times the type's noise range
+constexpr float SPIKE_MIN_NOISE_FACTOR = 10.0f;
+
+// Uniform draws per sample from the fault stream
+enum FaultDraw : uint32_t {
+    DRAW_GAP,
+    DRAW_GAP_LENGTH,
+    DRAW_STUCK,
+    DRAW_STUCK_LENGTH,
+    DRAW_SPIKE,
+    DRAW_SPIKE_SIZE,
+    FAULT_DRAWS
+};
+
+/**
+ * How a sensor type follows the shared components
+ * Loadings multiply the type amplitude; negative = opposite phase.
+ */
+struct ChannelShape {
+    const char* type;
+    float day;
+    float season;
+    float front;
+    bool daylight;          // Night = minimum, peak at noon (light, UV)
+    bool intermittent;      // Only active while the front exceeds 1 sigma (rain)
+};
+
+const ChannelShape CHANNEL_SHAPES[] = {
+    // type            day    season front  daylight intermittent
+    {"temperature",    1.0f,  1.0f,  0.5f,  false,   false},
+    {"humidity",      -1.0f, -0.5f,  0.8f,  false,   false},
+    {"pressure",       0.1f,  0.0f, -1.0f,  false,   false},
+    {"water_level",    0.0f,  0.3f,  0.6f,  false,   false},
+    {"co2",           -0.5f,  0.0f,  0.0f,  false,   false},
+    {"pm25",          -0.3f, -0.5f, -0.6f,  false,   false},
+    {"pm10",          -0.3f, -0.5f, -0.6f,  false,   false},
+    {"soil_moisture", -0.2f, -0.5f,  0.6f,  false,   false},
+    {"light",          1.0f,  0.5f, -0.5f,  true,    false},
+    {"uv",             1.0f,  1.0f, -0.6f,  true,    false},
+    {"wind_speed",     0.4f,  0.2f,  1.0f,  false,   false},
+    {"rainfall",       0.0f,  0.0f,  1.0f,  false,   true},
+    {"battery",        0.0f,  0.0f,  0.0f,  false,   false},
+    {"rssi",           0.0f,  0.0f, -0.2f,  false,   false},
+};
+
+const ChannelShape DEFAULT_SHAPE = {"", 1.0f, 0.0f, 0.0f, false, false};
+
+const ChannelShape& shapeFor(const char* type) {
+    for (const auto& shape : CHANNEL_SHAPES) {
+        if (std::strcmp(shape.type, type) == 0) {
+            return shape;
+        }
+    }
+    return DEFAULT_SHAPE;
+}
+
+struct ProfileKey {
+    const char* name;
+    float SignalProfile::*field;
+    bool positive;          // Must be > 0 (time constants)
+};
+
+const ProfileKey PROFILE_KEYS[] = {
+    {"seasonal",       &SignalProfile::seasonal,     false},
+    {"front",          &SignalProfile::front,        false},
+    {"front_hours",    &SignalProfile::frontHours,   true},
+    {"noise_seconds",  &SignalProfile::noiseSeconds, true},
+    {"drift_per_day",  &SignalProfile::driftPerDay,  false},
+    {"spikes_per_day", &SignalProfile::spikesPerDay, false},
+    {"gaps_per_day",   &SignalProfile::gapsPerDay,   false},
+    {"gap_seconds",    &SignalProfile::gapSeconds,   true},
+    {"stuck_per_day",  &SignalProfile::stuckPerDay,  false},
+    {"stuck_seconds",  &SignalProfile::stuckSeconds, true},
+};
+
+bool applyPreset(const std::string& preset, SignalProfile& profile) {
+    SignalProfile defaults;
+    if (preset == "basic") {
+        profile = defaults;
+    } else if (preset == "weather" || preset == "faulty") {
+        profile = defaults;
+        profile.correlated = true;
+        profile.seasonal = 0.5f;
+        profile.front = 0.6f;
+        if (preset == "faulty") {
+            profile.driftPerDay = 0.5f;
+            profile.spikesPerDay = 2.0f;
+            profile.gapsPerDay = 4.0f;
+            profile.stuckPerDay = 1.0f;
+        }
+    } else {
+        return false;
+    }
+    profile.preset = preset;
+    return true;
+}
+
+// Probability of at least one event of a Poisson process within dt
+inline float eventProbability(float perDay, float dtSeconds) {
+    return perDay > 0.0f ? 1.0f - std::exp(-perDay * dtSeconds / SECONDS_PER_DAY) : 0.0f;
+}
+
+// Exponentially distributed duration with the given mean
+inline uint64_t randomDuration(float meanSeconds, float unit) {
+    return static_cast<uint64_t>(-std::log(1.0f - unit) * meanSeconds) + 1;
+}
+
+/**
+ * Day/annual cycles, weather front, AR(1) noise, drift and faults
+ */
+class CorrelatedSignalModel : public ISignalModel {
+public:
+    CorrelatedSignalModel(const SensorTypeInfo& info,
+                          const std::shared_ptr<SignalEnvironment>& environment)
+        : info_(info)
+        , shape_(shapeFor(info.type))
+        , profile_(environment->getProfile())
+        , environment_(environment)
+        , noiseKey_(0)
+        , driftKey_(0)
+        , faultKey_(0)
+        , counter_(0)
+        , lastTimestamp_(0)
+        , noise_(0.0f)
+        , drift_(0.0f)
+        , lastValue_(info.baseValue)
+        , gapUntil_(0)
+        , stuckUntil_(0)
+    {
+        uint64_t state = environment->channelSeed(info.type);
+        noiseKey_ = static_cast<uint32_t>(signal::splitmix64(state));
+        driftKey_ = static_cast<uint32_t>(signal::splitmix64(state));
+        faultKey_ = static_cast<uint32_t>(signal::splitmix64(state));
+    }
+
+    void generate(const uint64_t* timestamps, float* out, size_t count) override {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = sample(timestamps[i]);
+        }
+    }
+
+    std::string describe() const override {
+        return profile_.preset;
+    }
+
+private:
+    const SensorTypeInfo& info_;
+    const ChannelShape& shape_;
+    SignalProfile profile_;
+    std::shared_ptr<SignalEnvironment> environment_;
+
+    uint32_t noiseKey_;
+    uint32_t driftKey_;
+    uint32_t faultKey_;
+    uint32_t counter_;
+
+    uint64_t lastTimestamp_;    // 0 = no sample yet
+    float noise_;               // AR(1) state, unit variance
+    float drift_;               // Random-walk offset in type units
+    float lastValue_;           // Repeated while stuck
+    uint64_t gapUntil_;
+    uint64_t stuckUntil_;
+
+    float sample(uint64_t timestamp) {
+        uint32_t n = counter_++;
+        float dt = lastTimestamp_ == 0 || timestamp <= lastTimestamp_
+            ? 0.0f
+            : static_cast<float>(timestamp - lastTimestamp_);
+        bool first = lastTimestamp_ == 0;
+        if (timestamp > lastTimestamp_) {
+            lastTimestamp_ = timestamp;
+        }
+
+        // Sensor noise: AR(1) with correlation time noiseSeconds
+        float g = signal::gaussianNoise(noiseKey_, n);
+        if (first) {
+            noise_ = g;
+        } else {
+            float a = std::exp(-dt / profile_.noiseSeconds);
+            noise_ = a * noise_ + std::sqrt(1.0f - a * a) * g;
+        }
+
+        if (profile_.driftPerDay > 0.0f) {
+            drift_ += profile_.driftPerDay * info_.noise * std::sqrt(dt / SECONDS_PER_DAY) *
+                      signal::gaussianNoise(driftKey_, n);
+        }
+
+        // Faults: dropout first (nothing is read), then a stuck reading
+        if (timestamp < gapUntil_) {
+            return NAN;
+        }
+        if (faultDraw(n, DRAW_GAP) < eventProbability(profile_.gapsPerDay, dt)) {
+            gapUntil_ = timestamp + randomDuration(profile_.gapSeconds, faultDraw(n, DRAW_GAP_LENGTH));
+            return NAN;
+        }
+        if (timestamp < stuckUntil_) {
+            return lastValue_;
+        }
+        if (faultDraw(n, DRAW_STUCK) < eventProbability(profile_.stuckPerDay, dt)) {
+            stuckUntil_ = timestamp + randomDuration(profile_.stuckSeconds, faultDraw(n, DRAW_STUCK_LENGTH));
+            return lastValue_;
+        }
+
+        float front = environment_->front(timestamp);
+        float signal;
+        float wetness = 1.0f;   // Scales the sensor errors of intermittent channels
+        if (shape_.intermittent) {
+            float activity = front > 1.0f ? front - 1.0f : 0.0f;
+            signal = 2.0f * info_.amplitude * profile_.front * shape_.front * activity;
+            wetness = activity < 0.25f ? activity * 4.0f : 1.0f;
+        } else {
+            signal = info_.amplitude * profile_.front * shape_.front * front;
+        }
+
+        // Std. dev. of the basic model's uniform noise
+        float error = drift_ + info_.noise * (1.0f / 1.7320508f) * noise_;
+
+        if (faultDraw(n, DRAW_SPIKE) < eventProbability(profile_.spikesPerDay, dt)) {
+            // Size draw in [0, 1): lower half negative, upper half positive
+            float size = 2.0f * faultDraw(n, DRAW_SPIKE_SIZE) - 1.0f;
+            float magnitude = SPIKE_MIN_NOISE_FACTOR * info_.noise * (1.0f + (size < 0.0f ? -size : size));
+            error += size < 0.0f ? -magnitude : magnitude;
+        }
+
+        float value = info_.baseValue + cycles(timestamp) + signal + wetness * error;
+        value = value < info_.minValue ? info_.minValue : value;
+        value = value > info_.maxValue ? info_.maxValue : value;
+        lastValue_ = value;
+        return value;
+    }
+
+    float faultDraw(uint32_t sample, FaultDraw draw) const {
+        return signal::uniformUnit(faultKey_, sample * FAULT_DRAWS + draw);
+    }
+
+    float cycles(uint64_t timestamp) const {
+        float dayTurns = static_cast<float>(timestamp % 86400) / SECONDS_PER_DAY;
+        float day;
+        if (shape_.daylight) {
+            float sun = signal::fastSinTurns(dayTurns - DAYLIGHT_PHASE_TURNS);
+            day = 2.0f * (sun > 0.0f ? sun : 0.0f) - 1.0f;
+        } else {
+            day = signal::fastSinTurns(dayTurns - DAY_CYCLE_PHASE_TURNS);
+        }
+
+        float yearTurns = static_cast<float>(std::fmod(static_cast<double>(timestamp) / SECONDS_PER_DAY,
+                                                       DAYS_PER_YEAR)) / DAYS_PER_YEAR;
+        float season = signal::fastSinTurns(yearTurns - SEASON_PHASE_TURNS);
+
+        return info_.amplitude * (shape_.day * day + profile_.seasonal * shape_.season * season);
+    }
+};
+
+} // anonymous namespace
+
+SignalProfile::SignalProfile()
+    : preset("basic")
+    , correlated(false)
+    , seasonal(0.0f)
+    , front(0.0f)
+    , frontHours(36.0f)
+    , noiseSeconds(300.0f)
+    , driftPerDay(0.0f)
+    , spikesPerDay(0.0f)
+    , gapsPerDay(0.0f)
+    , gapSeconds(600.0f)
+    , stuckPerDay(0.0f)
+    , stuckSeconds(1800.0f)
+    , trace()
+{
+}
+
+bool SignalProfile::parse(const std::string& spec, SignalProfile& profile, std::string& error) {
+    profile = SignalProfile();
+    if (spec.empty()) {
+        return true;
+    }
+
+    size_t start = 0;
+    bool first = true;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) {
+            end = spec.size();
+        }
+        std::string item = spec.substr(start, end - start);
+        start = end + 1;
+
+        if (first) {
+            first = false;
+            if (!applyPreset(item, profile)) {
+                error = "Unknown signal preset '" + item + "' (basic, weather, faulty)";
+                return false;
+            }
+            continue;
+        }
+
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) {
+            error = "Expected key=value, got '" + item + "'";
+            return false;
+        }
+        std::string key = item.substr(0, equals);
+        std::string value = item.substr(equals + 1);
+
+        if (key == "trace") {
+            profile.trace = value;
+            continue;
+        }
+
+        const ProfileKey* match = nullptr;
+        for (const auto& candidate : PROFILE_KEYS) {
+            if (key == candidate.name) {
+                match = &candidate;
+                break;
+            }
+        }
+        if (!match) {
+            error = "Unknown signal parameter '" + key + "'";
+            return false;
+        }
+
+        char* parsedEnd = nullptr;
+        float number = std::strtof(value.c_str(), &parsedEnd);
+        if (value.empty() || *parsedEnd != '\0' || !std::isfinite(number) || number < 0.0f ||
+            (match->positive && number == 0.0f)) {
+            error = "Invalid value for " + key + ": '" + value + "'";
+            return false;
+        }
+        profile.*(match->field) = number;
+    }
+
+    return true;
+}
+
+SignalEnvironment::SignalEnvironment(const SignalProfile& profile, uint64_t seed)
+    : profile_(profile)
+    , seed_(seed)
+    , frontKey_(0)
+{
+    uint64_t state = seed ^ signal::hashString("front");
+    frontKey_ = static_cast<uint32_t>(signal::splitmix64(state));
+}
+
+uint64_t SignalEnvironment::nodeSeed(const std::string& serialNumber) {
+    std::string fixed = hal::get_env(config::ENV_SIM_SEED);
+    if (!fixed.empty()) {
+        return std::strtoull(fixed.c_str(), nullptr, 10) ^ signal::hashString(serialNumber);
+    }
+
+    static std::atomic<uint64_t> nodes(0);
+    uint64_t state = hal::timestamp() ^ (static_cast<uint64_t>(hal::micros()) << 24) ^
+                     (++nodes * 0x9E3779B97F4A7C15ULL) ^ signal::hashString(serialNumber);
+    return signal::splitmix64(state);
+}
+
+const SignalProfile& SignalEnvironment::getProfile() const {
+    return profile_;
+}
+
+uint64_t SignalEnvironment::getSeed() const {
+    return seed_;
+}
+
+uint64_t SignalEnvironment::channelSeed(const std::string& typeCode) const {
+    uint64_t state = seed_ ^ signal::hashString(typeCode);
+    return signal::splitmix64(state);
+}
+
+float SignalEnvironment::front(uint64_t timestamp) const {
+    // Knot k sits at k * front_hours; its value is draw k of the front stream
+    double position = static_cast<double>(timestamp) / (profile_.frontHours * 3600.0);
+    double knot = std::floor(position);
+    uint32_t index = static_cast<uint32_t>(static_cast<uint64_t>(knot));
+    float u = static_cast<float>(position - knot);
+
+    // Smoothstep blend, rescaled to keep unit variance between the knots
+    float w = u * u * (3.0f - 2.0f * u);
+    float blend = (1.0f - w) * signal::gaussianNoise(frontKey_, index) +
+                  w * signal::gaussianNoise(frontKey_, index + 1);
+    return blend / std::sqrt((1.0f - w) * (1.0f - w) + w * w);
+}
+
+std::unique_ptr<ISignalModel> createSignalModel(const SensorTypeInfo& info,
+                                                const std::shared_ptr<SignalEnvironment>& environment) {
+    const SignalProfile& profile = environment->getProfile();
+
+    if (!profile.trace.empty()) {
+        std::shared_ptr<const SignalTrace> trace = SignalTrace::load(profile.trace);
+        int column = trace ? trace->column(info.type) : -1;
+        if (column >= 0) {
+            return std::unique_ptr<ISignalModel>(new TraceReplayModel(trace, column));
+        }
+    }
+
+    if (!profile.correlated) {
+        return nullptr;
+    }
+    return std::unique_ptr<ISignalModel>(new CorrelatedSignalModel(info, environment));
+}
+
+} // namespace sensor
@@ -0,0 +1,131 @@
+#ifndef SIGNAL_MODEL_H
+#define SIGNAL_MODEL_H
+
+#include "sensor_interface.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace sensor {
+
+/**
+ * Interface for pluggable value generators of a SimulatedSensor
+ */
+class ISignalModel {
+public:
+    virtual ~ISignalModel() = default;
+
+    /**
+     * Generate values for increasing timestamps
+     * Models keep state (AR processes, active faults) between calls.
+     * @param timestamps Unix timestamps in seconds
+     * @param out Receives one value per timestamp, NAN = dropout
+     * @param count Number of samples
+     */
+    virtual void generate(const uint64_t* timestamps, float* out, size_t count) = 0;
+
+    /**
+     * Short description for logs (e.g., "weather", "trace:station.csv")
+     */
+    virtual std::string describe() const = 0;
+};
+
+/**
+ * Signal model parameters of one simulated node
+ *
+ * Written as "preset[,key=value...]", e.g. "faulty,gaps_per_day=10".
+ * Presets:
+ * - basic:   24h sine plus uniform noise per sensor (SimulatedSensor default)
+ * - weather: day and annual cycles, a shared weather-front process that
+ *            moves all channels of a node together, AR(1) sensor noise
+ * - faulty:  weather plus calibration drift, spikes, dropouts and stuck values
+ *
+ * Amplitudes are relative to the SensorTypeInfo amplitude (seasonal, front)
+ * or noise (drift) of each sensor type.
+ */
+struct SignalProfile {
+    std::string preset;
+    bool correlated;            // false = basic model
+    float seasonal;             // Annual cycle amplitude
+    float front;                // Weather-front standard deviation
+    float frontHours;           // Correlation time of the front process
+    float noiseSeconds;         // Correlation time of the AR(1) sensor noise
+    float driftPerDay;          // Random-walk drift, std. deviation per sqrt(day)
+    float spikesPerDay;         // Single-sample outliers
+    float gapsPerDay;           // Dropouts (read() returns NAN)
+    float gapSeconds;           // Mean dropout duration
+    float stuckPerDay;          // Sensor repeats its last value
+    float stuckSeconds;         // Mean stuck duration
+    std::string trace;          // CSV trace replayed for the types it contains
+
+    SignalProfile();
+
+    /**
+     * Parse a profile specification
+     * @param spec "preset[,key=value...]" (empty = basic)
+     * @param profile Receives the parameters
+     * @param error Receives a description if the spec is invalid
+     * @return true if valid
+     */
+    static bool parse(const std::string& spec, SignalProfile& profile, std::string& error);
+};
+
+/**
+ * SignalEnvironment - State shared by all simulated sensors of one node
+ *
+ * Holds the node's profile and seed and the weather-front process. Every
+ * channel reads the same front value for the same timestamp, which is what
+ * correlates them: a front lowers pressure and raises humidity and wind at
+ * the same time.
+ *
+ * The front is a pure function of time (unit-variance Gaussian knots every
+ * front_hours, drawn from a counter-based stream and blended smoothly), so
+ * channels agree however their reads are batched or ordered. Immutable
+ * after construction.
+ */
+class SignalEnvironment {
+public:
+    /**
+     * @param profile Signal parameters of this node
+     * @param seed Node seed (see nodeSeed())
+     */
+    SignalEnvironment(const SignalProfile& profile, uint64_t seed);
+
+    /**
+     * Seed for a node: SIM_SEED combined with the serial number when set
+     * (reproducible fleets), otherwise random
+     */
+    static uint64_t nodeSeed(const std::string& serialNumber);
+
+    const SignalProfile& getProfile() const;
+    uint64_t getSeed() const;
+
+    /**
+     * Seed of one sensor channel of this node
+     */
+    uint64_t channelSeed(const std::string& typeCode) const;
+
+    /**
+     * Weather-front factor at a timestamp (unit variance)
+     */
+    float front(uint64_t timestamp) const;
+
+private:
+    SignalProfile profile_;
+    uint64_t seed_;
+    uint32_t frontKey_;
+};
+
+/**
+ * Create the model for one sensor channel of a node
+ * @param info Sensor type
+ * @param environment Node environment (kept alive by the model)
+ * @return Model, or nullptr for the basic profile
+ */
+std::unique_ptr<ISignalModel> createSignalModel(const SensorTypeInfo& info,
+                                                const std::shared_ptr<SignalEnvironment>& environment);
+
+} // namespace sensor
+
+#endif // SIGNAL_MODEL_H
@@ -0,0 +1,128 @@
+#ifndef SIMULATED_SENSOR_H
+#define SIMULATED_SENSOR_H
+
+#include "sensor_interface.h"
+#include "signal_model.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+
+namespace sensor {
+
+/**
+ * SimulatedSensor - Generates realistic sensor values for testing
+ *
+ * Features:
+ * - Day/night cycle simulation (24h sine wave)
+ * - Random noise for realistic variation
+ * - Value clamping to valid range
+ * - Supports all standard sensor types
+ * - Batch generation for bulk datasets (readBatch)
+ *
+ * Noise comes from a per-sensor counter-based stream (no std::rand, no
+ * shared state between threads). The seed defaults to SIM_SEED combined
+ * with the type code when that variable is set, otherwise to a random value.
+ *
+ * setModel() replaces the built-in day cycle with an ISignalModel
+ * (correlated channels, faults, trace replay; see signal_model.h).
+ */
+class SimulatedSensor : public ISensor {
+public:
+    /**
+     * Create a simulated sensor
+     * @param typeCode Sensor type code (e.g., "temperature")
+     * @throws std::invalid_argument if type is unknown
+     */
+    explicit SimulatedSensor(const std::string& typeCode);
+
+    /**
+     * Create a simulated sensor with custom parameters
+     * @param typeCode Sensor type code
+     * @param baseValue Center value for simulation
+     * @param amplitude Variation range (±)
+     * @param noiseRange Random noise range (±)
+     */
+    SimulatedSensor(const std::string& typeCode,
+                    float baseValue,
+                    float amplitude,
+                    float noiseRange);
+
+    ~SimulatedSensor() override = default;
+
+    // ISensor interface implementation
+    std::string getType() const override;
+    std::string getUnit() const override;
+    float getMinValue() const override;
+    float getMaxValue() const override;
+    bool begin() override;
+    float read() override;
+    bool isReady() const override;
+    std::string getName() const override;
+
+    /**
+     * Generate values for many points in time at once
+     * Same model as read(); the noise stream continues across calls, so a
+     * seeded sensor yields the same dataset however it is split into batches.
+     * Works without begin() (offline dataset generation).
+     * @param timestamps Unix timestamps in seconds
+     * @param out Receives one value per timestamp
+     * @param count Number of samples
+     */
+    void readBatch(const uint64_t* timestamps, float* out, size_t count);
+
+    /**
+     * readBatch() for vectors (out is resized to timestamps.size())
+     */
+    void readBatch(const std::vector<uint64_t>& timestamps, std::vector<float>& out);
+
+    /**
+     * Seed the noise stream and restart it (reproducible datasets)
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * Get the current seed
+     */
+    uint64_t getSeed() const;
+
+    /**
+     * Generate values with a signal model instead of the built-in one
+     * @param model Model, or nullptr for the built-in day cycle
+     */
+    void setModel(std::unique_ptr<ISignalModel> model);
+
+    /**
+     * Set the time offset for simulation (useful for testing)
+     * @param offsetSeconds Offset in seconds
+     */
+    void setTimeOffset(int32_t offsetSeconds);
+
+private:
+    std::string typeCode_;
+    const SensorTypeInfo* typeInfo_;
+
+    float baseValue_;
+    float amplitude_;
+    float noiseRange_;
+
+    bool initialized_;
+    int32_t timeOffset_;
+
+    uint64_t seed_;
+    uint32_t noiseKey_;         // Derived from seed_
+    uint32_t sampleCounter_;    // Position in the noise stream
+
+    std::unique_ptr<ISignalModel> model_;
+
+    /**
+     * Seed used when none is set explicitly
+     */
+    static uint64_t defaultSeed(const std::string& typeCode);
+};
+
+} // namespace sensor
+
+#endif // SIMULATED_SENSOR_H
@@ -0,0 +1,174 @@
+#include "trace_replay.h"
+#include "hal/hal.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace sensor {
+
+namespace {
+
+std::vector<std::string> splitCsv(const std::string& line) {
+    std::vector<std::string> cells;
+    std::stringstream stream(line);
+    std::string cell;
+    while (std::getline(stream, cell, ',')) {
+        cells.push_back(cell);
+    }
+    // "a,b," ends with an empty cell
+    if (!line.empty() && line.back() == ',') {
+        cells.push_back("");
+    }
+    return cells;
+}
+
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const SignalTrace> SignalTrace::load(const std::string& path) {
+    // Fleet nodes share one copy per file; unused traces are released
+    static std::mutex cacheMutex;
+    static std::map<std::string, std::weak_ptr<const SignalTrace>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::shared_ptr<const SignalTrace> cached = cache[path].lock();
+    if (cached) {
+        return cached;
+    }
+
+    std::ifstream file(path);
+    if (!file) {
+        hal::log_error("SignalTrace: Cannot open " + path);
+        return nullptr;
+    }
+
+    std::shared_ptr<SignalTrace> trace(new SignalTrace());
+    trace->path_ = path;
+    std::string error;
+    if (!trace->parse(file, error)) {
+        hal::log_error("SignalTrace: " + path + ": " + error);
+        return nullptr;
+    }
+
+    hal::log_info("SignalTrace: Loaded " + std::to_string(trace->getRowCount()) + " rows from " + path);
+    cache[path] = trace;
+    return trace;
+}
+
+bool SignalTrace::parse(std::istream& input, std::string& error) {
+    std::string line;
+    if (!std::getline(input, line)) {
+        error = "empty file";
+        return false;
+    }
+
+    std::vector<std::string> header = splitCsv(line);
+    if (header.size() < 2 || trim(header[0]) != "timestamp") {
+        error = "header must be timestamp,<type>,...";
+        return false;
+    }
+    for (size_t i = 1; i < header.size(); ++i) {
+        columns_.push_back(trim(header[i]));
+    }
+
+    size_t lineNumber = 1;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (trim(line).empty()) {
+            continue;
+        }
+
+        std::vector<std::string> cells = splitCsv(line);
+        char* end = nullptr;
+        std::string timeCell = trim(cells[0]);
+        uint64_t timestamp = std::strtoull(timeCell.c_str(), &end, 10);
+        if (timeCell.empty() || *end != '\0') {
+            error = "line " + std::to_string(lineNumber) + ": invalid timestamp";
+            return false;
+        }
+        if (!timestamps_.empty() && timestamp <= timestamps_.back()) {
+            error = "line " + std::to_string(lineNumber) + ": timestamps must increase";
+            return false;
+        }
+        timestamps_.push_back(timestamp);
+
+        for (size_t column = 0; column < columns_.size(); ++column) {
+            std::string cell = column + 1 < cells.size() ? trim(cells[column + 1]) : "";
+            float value = NAN;
+            if (!cell.empty()) {
+                value = std::strtof(cell.c_str(), &end);
+                if (*end != '\0') {
+                    error = "line " + std::to_string(lineNumber) + ": invalid value '" + cell + "'";
+                    return false;
+                }
+            }
+            values_.push_back(value);
+        }
+    }
+
+    if (timestamps_.empty()) {
+        error = "no data rows";
+        return false;
+    }
+
+    // One mean step past the last row before the trace starts over
+    uint64_t span = timestamps_.back() - timestamps_.front();
+    uint64_t step = timestamps_.size() > 1 ? span / (timestamps_.size() - 1) : 1;
+    period_ = span + std::max<uint64_t>(step, 1);
+    return true;
+}
+
+int SignalTrace::column(const std::string& typeCode) const {
+    auto it = std::find(columns_.begin(), columns_.end(), typeCode);
+    return it == columns_.end() ? -1 : static_cast<int>(it - columns_.begin());
+}
+
+float SignalTrace::valueAt(int column, uint64_t timestamp) const {
+    uint64_t first = timestamps_.front();
+    uint64_t offset = timestamp >= first
+        ? (timestamp - first) % period_
+        : (period_ - (first - timestamp) % period_) % period_;
+
+    // Last row at or before the position
+    auto row = std::upper_bound(timestamps_.begin(), timestamps_.end(), first + offset) - 1;
+    size_t index = static_cast<size_t>(row - timestamps_.begin());
+    return values_[index * columns_.size() + static_cast<size_t>(column)];
+}
+
+const std::string& SignalTrace::getPath() const {
+    return path_;
+}
+
+size_t SignalTrace::getRowCount() const {
+    return timestamps_.size();
+}
+
+TraceReplayModel::TraceReplayModel(std::shared_ptr<const SignalTrace> trace, int column)
+    : trace_(std::move(trace))
+    , column_(column)
+{
+}
+
+void TraceReplayModel::generate(const uint64_t* timestamps, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = trace_->valueAt(column_, timestamps[i]);
+    }
+}
+
+std::string TraceReplayModel::describe() const {
+    return "trace:" + trace_->getPath();
+}
+
+} // namespace sensor
@@ -0,0 +1,76 @@
+#ifndef TRACE_REPLAY_H
+#define TRACE_REPLAY_H
+
+#include "signal_model.h"
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sensor {
+
+/**
+ * SignalTrace - Recorded sensor data loaded from a CSV file
+ *
+ * Format: a header "timestamp,<type>,<type>..." followed by one row per
+ * sample with increasing Unix timestamps (seconds). Empty cells or "nan"
+ * are dropouts.
+ *
+ *   timestamp,temperature,humidity
+ *   1733150400,4.2,81.0
+ *   1733150460,4.1,
+ */
+class SignalTrace {
+public:
+    /**
+     * Load a trace (cached: all nodes replaying one file share it)
+     * @return Trace, or nullptr if the file is missing or invalid
+     */
+    static std::shared_ptr<const SignalTrace> load(const std::string& path);
+
+    /**
+     * Column index of a sensor type, -1 if the trace has no such column
+     */
+    int column(const std::string& typeCode) const;
+
+    /**
+     * Value of a column at a point in time
+     * The trace is looped; a trace covering whole days keeps its time of day.
+     * Between rows the last row's value holds.
+     */
+    float valueAt(int column, uint64_t timestamp) const;
+
+    const std::string& getPath() const;
+    size_t getRowCount() const;
+
+private:
+    std::string path_;
+    std::vector<std::string> columns_;
+    std::vector<uint64_t> timestamps_;
+    std::vector<float> values_;         // Row-major, columns_.size() per row
+    uint64_t period_;                   // Loop length in seconds
+
+    SignalTrace() : period_(0) {}
+
+    bool parse(std::istream& input, std::string& error);
+};
+
+/**
+ * Replays one column of a SignalTrace
+ */
+class TraceReplayModel : public ISignalModel {
+public:
+    TraceReplayModel(std::shared_ptr<const SignalTrace> trace, int column);
+
+    void generate(const uint64_t* timestamps, float* out, size_t count) override;
+    std::string describe() const override;
+
+private:
+    std::shared_ptr<const SignalTrace> trace_;
+    int column_;
+};
+
+} // namespace sensor
+
+#endif // TRACE_REPLAY_H
@@ -0,0 +1,293 @@
+/**
+ * myIoTGrid.Sensor - ADS1115 Continuous Scanner Implementation
+ *
+ * Continuous-conversion round-robin over the enabled ADS1115 channels.
+ */
+
+#include "ads1115_scanner.h"
+
+#ifdef PLATFORM_ESP32
+
+#include "i2c_bus_manager.h"
+
+namespace {
+
+const uint16_t CHANNEL_MUX[ADS1115_CHANNEL_COUNT] = {
+    ADS1X15_REG_CONFIG_MUX_SINGLE_0,
+    ADS1X15_REG_CONFIG_MUX_SINGLE_1,
+    ADS1X15_REG_CONFIG_MUX_SINGLE_2,
+    ADS1X15_REG_CONFIG_MUX_SINGLE_3
+};
+
+struct DataRate {
+    uint16_t sps;
+    uint16_t reg;
+};
+
+const DataRate DATA_RATES[] = {
+    {8, RATE_ADS1115_8SPS},
+    {16, RATE_ADS1115_16SPS},
+    {32, RATE_ADS1115_32SPS},
+    {64, RATE_ADS1115_64SPS},
+    {128, RATE_ADS1115_128SPS},
+    {250, RATE_ADS1115_250SPS},
+    {475, RATE_ADS1115_475SPS},
+    {860, RATE_ADS1115_860SPS}
+};
+const size_t DATA_RATE_COUNT = sizeof(DATA_RATES) / sizeof(DATA_RATES[0]);
+
+uint16_t dataRateRegister(uint16_t sps) {
+    for (size_t i = 0; i < DATA_RATE_COUNT; i++) {
+        if (DATA_RATES[i].sps == sps) return DATA_RATES[i].reg;
+    }
+    return RATE_ADS1115_128SPS;
+}
+
+} // namespace
+
+ADS1115Scanner::ADS1115Scanner(Adafruit_ADS1115* ads, int busId, int alertPin)
+    : _ads(ads)
+    , _busId(busId)
+    , _alertPin(alertPin)
+    , _task(nullptr)
+    , _stopRequested(false)
+    , _windowCount(0)
+    , _timeoutCount(0)
+{
+    portMUX_INITIALIZE(&_mux);
+    for (int i = 0; i < ADS1115_CHANNEL_COUNT; i++) {
+        _channels[i] = { false, GAIN_ONE, config::ADS1115_DEFAULT_DATA_RATE_SPS };
+        _values[i] = { false, 0.0f, 0, 0, 0 };
+    }
+}
+
+ADS1115Scanner::~ADS1115Scanner() {
+    stop();
+}
+
+void ADS1115Scanner::configureChannel(int channel, adsGain_t gain, uint16_t dataRateSps) {
+    if (channel < 0 || channel >= ADS1115_CHANNEL_COUNT) return;
+
+    taskENTER_CRITICAL(&_mux);
+    Channel& ch = _channels[channel];
+    if (ch.enabled && (ch.gain != gain || ch.dataRateSps != dataRateSps)) {
+        // Old window was measured with different settings
+        _values[channel].valid = false;
+    }
+    ch.enabled = true;
+    ch.gain = gain;
+    ch.dataRateSps = dataRateSps;
+    taskEXIT_CRITICAL(&_mux);
+
+    Serial.printf("[ADS1115] Bus %d Ch%d: gain=0x%04X, %u SPS\n",
+                  _busId, channel, (unsigned)gain, (unsigned)dataRateSps);
+}
+
+void ADS1115Scanner::retainChannels(uint8_t channelMask) {
+    taskENTER_CRITICAL(&_mux);
+    for (int i = 0; i < ADS1115_CHANNEL_COUNT; i++) {
+        if (!(channelMask & (1 << i))) {
+            _channels[i].enabled = false;
+            _values[i].valid = false;
+        }
+    }
+    taskEXIT_CRITICAL(&_mux);
+}
+
+bool ADS1115Scanner::start() {
+    if (_task) return true;
+    if (nextChannel(-1) < 0) return false;
+
+    _stopRequested = false;
+    if (xTaskCreate(taskEntry, "ads1115_scan", config::ADS1115_SCAN_TASK_STACK_SIZE,
+                    this, 2, &_task) != pdPASS) {
+        _task = nullptr;
+        Serial.println("[ADS1115] ERROR: Failed to start scan task");
+        return false;
+    }
+
+    if (_alertPin >= 0) {
+        pinMode(_alertPin, INPUT_PULLUP);
+        attachInterruptArg(digitalPinToInterrupt(_alertPin), onAlert, this, FALLING);
+    }
+
+    Serial.printf("[ADS1115] Continuous scan started on bus %d (%s)\n",
+                  _busId, _alertPin >= 0 ? "ALERT/RDY interrupt" : "timed");
+    return true;
+}
+
+void ADS1115Scanner::stop() {
+    if (!_task) return;
+
+    if (_alertPin >= 0) {
+        detachInterrupt(digitalPinToInterrupt(_alertPin));
+    }
+    _stopRequested = true;
+    xTaskNotifyGive(_task);
+    while (_task) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+
+    // A single-shot read puts the device back into power-down mode
+    I2CBusLock busLock(_busId);
+    if (busLock.locked()) {
+        _ads->readADC_SingleEnded(0);
+    }
+}
+
+bool ADS1115Scanner::isChannelEnabled(int channel) const {
+    if (channel < 0 || channel >= ADS1115_CHANNEL_COUNT) return false;
+    taskENTER_CRITICAL(&_mux);
+    bool enabled = _channels[channel].enabled;
+    taskEXIT_CRITICAL(&_mux);
+    return enabled;
+}
+
+bool ADS1115Scanner::getChannel(int channel, ADS1115ChannelValue& out) const {
+    if (channel < 0 || channel >= ADS1115_CHANNEL_COUNT) return false;
+    taskENTER_CRITICAL(&_mux);
+    out = _values[channel];
+    taskEXIT_CRITICAL(&_mux);
+    return out.valid;
+}
+
+adsGain_t ADS1115Scanner::gainFromConfig(double gain) {
+    if (gain <= 0.0) return GAIN_ONE;
+    if (gain < 0.8) return GAIN_TWOTHIRDS;
+    if (gain < 1.5) return GAIN_ONE;
+    if (gain < 3.0) return GAIN_TWO;
+    if (gain < 6.0) return GAIN_FOUR;
+    if (gain < 12.0) return GAIN_EIGHT;
+    return GAIN_SIXTEEN;
+}
+
+uint16_t ADS1115Scanner::dataRateFromConfig(int sps) {
+    if (sps <= 0) return config::ADS1115_DEFAULT_DATA_RATE_SPS;
+    for (size_t i = 0; i < DATA_RATE_COUNT; i++) {
+        if (DATA_RATES[i].sps >= sps) return DATA_RATES[i].sps;
+    }
+    return DATA_RATES[DATA_RATE_COUNT - 1].sps;
+}
+
+// ============================================================================
+// Scan Task
+// ============================================================================
+
+void ADS1115Scanner::taskEntry(void* param) {
+    ADS1115Scanner* self = static_cast<ADS1115Scanner*>(param);
+    self->run();
+    self->_task = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void IRAM_ATTR ADS1115Scanner::onAlert(void* arg) {
+    ADS1115Scanner* self = static_cast<ADS1115Scanner*>(arg);
+    BaseType_t woken = pdFALSE;
+    if (self->_task) {
+        vTaskNotifyGiveFromISR(self->_task, &woken);
+    }
+    if (woken) portYIELD_FROM_ISR();
+}
+
+void ADS1115Scanner::run() {
+    int current = -1;
+    Channel active = { false, GAIN_ONE, 0 };
+
+    while (!_stopRequested) {
+        int channel = nextChannel(current);
+        if (channel < 0) break;
+
+        taskENTER_CRITICAL(&_mux);
+        Channel settings = _channels[channel];
+        taskEXIT_CRITICAL(&_mux);
+
+        // Only re-program the device when something changed; a single
+        // enabled channel stays in continuous mode without restarts
+        int discard = 0;
+        if (channel != current || settings.gain != active.gain ||
+            settings.dataRateSps != active.dataRateSps) {
+            if (!selectChannel(channel, settings)) {
+                vTaskDelay(pdMS_TO_TICKS(100));
+                continue;
+            }
+            current = channel;
+            active = settings;
+            discard = 1;  // First result may straddle the MUX/PGA switch
+        }
+
+        int32_t sum = 0;
+        uint16_t count = 0;
+        while (count < config::ADS1115_OVERSAMPLE && !_stopRequested) {
+            if (!waitForConversion(settings.dataRateSps)) {
+                _timeoutCount++;
+            }
+            int16_t raw;
+            if (!readConversion(raw)) break;
+            if (discard > 0) {
+                discard--;
+                continue;
+            }
+            sum += raw;
+            count++;
+        }
+        if (count == 0) continue;
+
+        int16_t mean = (int16_t)(sum / count);
+        float voltage = _ads->computeVolts(mean);
+
+        taskENTER_CRITICAL(&_mux);
+        // Drop the window if the channel was reconfigured or disabled meanwhile
+        if (_channels[channel].enabled &&
+            _channels[channel].gain == settings.gain &&
+            _channels[channel].dataRateSps == settings.dataRateSps) {
+            _values[channel] = { true, voltage, mean, count, millis() };
+        }
+        taskEXIT_CRITICAL(&_mux);
+        _windowCount++;
+    }
+}
+
+int ADS1115Scanner::nextChannel(int current) const {
+    taskENTER_CRITICAL(&_mux);
+    int next = -1;
+    for (int i = 1; i <= ADS1115_CHANNEL_COUNT; i++) {
+        int candidate = (current + i + ADS1115_CHANNEL_COUNT) % ADS1115_CHANNEL_COUNT;
+        if (_channels[candidate].enabled) {
+            next = candidate;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&_mux);
+    return next;
+}
+
+bool ADS1115Scanner::selectChannel(int channel, const Channel& settings) {
+    I2CBusLock busLock(_busId);
+    if (!busLock.locked()) return false;
+
+    _ads->setGain(settings.gain);
+    _ads->setDataRate(dataRateRegister(settings.dataRateSps));
+    // Also programs the threshold registers for ALERT/RDY conversion-ready output
+    _ads->startADCReading(CHANNEL_MUX[channel], true);
+
+    ulTaskNotifyTake(pdTRUE, 0);  // Drop edges from the previous channel
+    return true;
+}
+
+bool ADS1115Scanner::waitForConversion(uint16_t dataRateSps) {
+    uint32_t periodMs = (1000 + dataRateSps - 1) / dataRateSps;
+    if (_alertPin < 0) {
+        vTaskDelay(pdMS_TO_TICKS(periodMs) + 1);
+        return true;
+    }
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(periodMs * 2) + 2) > 0;
+}
+
+bool ADS1115Scanner::readConversion(int16_t& raw) {
+    I2CBusLock busLock(_busId);
+    if (!busLock.locked()) return false;
+    raw = _ads->getLastConversionResults();
+    return true;
+}
+
+#endif // PLATFORM_ESP32
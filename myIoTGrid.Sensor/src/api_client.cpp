@@ -4,12 +4,16 @@
 
 #include "api_client.h"
 #include "config.h"
+#include "instrumentation.h"
+#include "memory_telemetry.h"
+#include "session_trace.h"
 #include <ArduinoJson.h>
 #include <vector>
 #ifdef PLATFORM_NATIVE
 #include "ArduinoJsonString.h"
-#include <curl/curl.h>
+#include "http_transport.h"
 #include <cstdlib>
+#include <cstring>
 #endif
 
 #ifdef PLATFORM_ESP32
@@ -46,14 +50,95 @@ quk=
 #endif
 
 #ifdef PLATFORM_NATIVE
-// Callback for libcurl to write response data
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    size_t totalSize = size * nmemb;
-    userp->append((char*)contents, totalSize);
-    return totalSize;
+// Runs a request on the shared native HTTP transport (pooled connections, HTTP/2)
+static void performNative(hal::native::HttpRequest&& request, ApiResponse& result) {
+    // Allow self-signed certificates (for development)
+    const char* insecure = std::getenv("HUB_INSECURE");
+    request.insecure = insecure && strcmp(insecure, "true") == 0;
+
+    hal::native::HttpResult response = hal::native::HttpTransport::instance().perform(std::move(request));
+
+    if (response.success) {
+        result.statusCode = response.statusCode;
+        result.body = String(response.body.c_str());
+        result.etag = String(response.etag.c_str());
+        result.success = (response.statusCode >= 200 && response.statusCode < 300);
+    } else {
+        result.error = String(response.errorMessage.c_str());
+        result.success = false;
+        result.statusCode = 0;
+        Serial.printf("[API] CURL error: %s\n", result.error.c_str());
+    }
 }
 #endif
 
+namespace {
+
+// In-place configuration diff: write a field only when it differs, so unchanged
+// Strings keep their buffers and the caller learns whether anything changed
+void updateField(String& field, JsonVariantConst value, bool& changed) {
+    const char* text = value | "";
+    if (field != text) {
+        field = text;
+        changed = true;
+    }
+}
+
+template <typename T>
+void updateField(T& field, T value, bool& changed) {
+    if (field != value) {
+        field = value;
+        changed = true;
+    }
+}
+
+// Debug level as sent by the Hub: enum name ("Production", "Normal", "Debug") or int (0, 1, 2)
+int parseDebugLevel(JsonVariantConst levelVar, int fallback) {
+    if (levelVar.is<const char*>()) {
+        String levelStr = levelVar.as<String>();
+        if (levelStr == "Production" || levelStr == "production") {
+            return 0;
+        } else if (levelStr == "Normal" || levelStr == "normal") {
+            return 1;
+        } else if (levelStr == "Debug" || levelStr == "debug") {
+            return 2;
+        }
+        return fallback;
+    }
+    return levelVar | fallback;
+}
+
+// Session trace (see session_trace.h): during replay requests are answered from the trace
+bool replayRequest(const char* method, const String& path, ApiResponse& result) {
+    TraceExchange exchange;
+    if (!SessionTrace::getInstance().replayExchange(method, path, exchange)) {
+        return false;
+    }
+    result.statusCode = exchange.statusCode;
+    result.success = exchange.success;
+    result.body = exchange.body;
+    result.etag = exchange.etag;
+    result.error = exchange.error;
+    return true;
+}
+
+void recordRequest(const char* method, const String& path, unsigned long latencyMs, const ApiResponse& result) {
+    SessionTrace& trace = SessionTrace::getInstance();
+    if (!trace.isRecording()) {
+        return;
+    }
+    TraceExchange exchange;
+    exchange.statusCode = result.statusCode;
+    exchange.success = result.success;
+    exchange.body = result.body;
+    exchange.etag = result.etag;
+    exchange.error = result.error;
+    exchange.latencyMs = latencyMs;
+    trace.recordExchange(method, path, exchange);
+}
+
+} // namespace
+
 ApiClient::ApiClient()
     : _timeout(config::HTTP_TIMEOUT_MS)  // Use config value (30s for HTTPS/TLS)
     , _configured(false) {
@@ -65,6 +150,10 @@ void ApiClient::configure(const String& baseUrl, const String& nodeId, const Str
     _apiKey = apiKey;
     _configured = true;
 
+    // New identity: the next fetches must return full bodies
+    _configEtag = "";
+    _debugEtag = "";
+
     Serial.printf("[API] Configured: URL=%s, NodeID=%s\n", baseUrl.c_str(), nodeId.c_str());
 }
 
@@ -162,10 +251,16 @@ bool ApiClient::validateApiKey() {
     }
 }
 
-HeartbeatResponse ApiClient::sendHeartbeat(const String& firmwareVersion, int batteryLevel) {
+HeartbeatResponse ApiClient::sendHeartbeat(const String& firmwareVersion, int batteryLevel,
+                                           const String& memoryJson) {
     HeartbeatResponse result;
     result.success = false;
     result.nextHeartbeatSeconds = 60;
+    result.unixTimestamp = 0;
+    result.configChanged = true;
+    result.hasDebugConfig = false;
+    result.debugLevel = 1;
+    result.enableRemoteLogging = false;
 
     if (!_configured) {
         Serial.println("[API] Not configured");
@@ -180,6 +275,9 @@ HeartbeatResponse ApiClient::sendHeartbeat(const String& firmwareVersion, int ba
     if (batteryLevel >= 0) {
         doc["batteryLevel"] = batteryLevel;
     }
+    if (memoryJson.length() > 0) {
+        doc["memory"] = serialized(memoryJson);
+    }
 
     String body;
     serializeJson(doc, body);
@@ -194,6 +292,15 @@ HeartbeatResponse ApiClient::sendHeartbeat(const String& firmwareVersion, int ba
             result.success = respDoc["success"] | false;
             result.serverTime = respDoc["serverTime"] | 0;
             result.nextHeartbeatSeconds = respDoc["nextHeartbeatSeconds"] | 60;
+
+            // Control-plane state (missing on older Hubs: callers fall back to separate fetches)
+            result.unixTimestamp = respDoc["unixTimestamp"] | 0L;
+            const char* configVersion = respDoc["configurationVersion"] | "";
+            result.configChanged = !isConfigurationCurrent(configVersion);
+            JsonVariantConst levelVar = respDoc["debugLevel"];
+            result.hasDebugConfig = !levelVar.isNull();
+            result.debugLevel = parseDebugLevel(levelVar, 1);
+            result.enableRemoteLogging = respDoc["enableRemoteLogging"] | false;
         }
 
         Serial.printf("[API] Heartbeat sent, next in %d seconds\n", result.nextHeartbeatSeconds);
@@ -224,7 +331,11 @@ bool ApiClient::sendReading(const String& sensorType, double value, const String
     }
 
     String body;
-    serializeJson(doc, body);
+    {
+        TIMED_SCOPE("json.serialize");
+        MEMORY_TAG("json.serialize");
+        serializeJson(doc, body);
+    }
 
     ApiResponse response = httpPost("/api/readings", body);
 
@@ -259,7 +370,9 @@ bool ApiClient::sendHardwareStatus(const String& serialNumber,
                                     const String& hardwareType,
                                     const String& detectedDevicesJson,
                                     const String& storageJson,
-                                    const String& busStatusJson) {
+                                    const String& busStatusJson,
+                                    const String& timingJson,
+                                    const String& stallsJson) {
     if (_baseUrl.length() == 0) {
         Serial.println("[API] Base URL not set for hardware status report");
         return false;
@@ -273,6 +386,12 @@ bool ApiClient::sendHardwareStatus(const String& serialNumber,
     body += "\"detectedDevices\":" + detectedDevicesJson + ",";
     body += "\"storage\":" + storageJson + ",";
     body += "\"busStatus\":" + busStatusJson;
+    if (timingJson.length() > 0) {
+        body += ",\"timing\":" + timingJson;
+    }
+    if (stallsJson.length() > 0) {
+        body += ",\"stalls\":" + stallsJson;
+    }
     body += "}";
 
     Serial.println("[API] Sending hardware status report...");
@@ -289,101 +408,127 @@ bool ApiClient::sendHardwareStatus(const String& serialNumber,
     }
 }
 
-NodeConfigurationResponse ApiClient::fetchConfiguration(const String& serialNumber) {
-    NodeConfigurationResponse result;
-    result.success = false;
-    result.defaultIntervalSeconds = 60;
-
+ConfigFetchResult ApiClient::fetchConfiguration(const String& serialNumber, NodeConfigurationResponse& config) {
     if (_baseUrl.length() == 0) {
         Serial.println("[API] Base URL not set for configuration fetch");
-        result.error = "Base URL not configured";
-        return result;
+        config.error = "Base URL not configured";
+        return ConfigFetchResult::FAILED;
     }
 
     String path = "/api/nodes/" + serialNumber + "/configuration";
-    Serial.printf("[API] Fetching configuration for: %s\n", serialNumber.c_str());
+    ApiResponse response = httpGet(path, _configEtag.c_str());
 
-    ApiResponse response = httpGet(path);
+    if (response.statusCode == 304) {
+        return ConfigFetchResult::NOT_MODIFIED;
+    }
 
     if (response.success && response.statusCode == 200) {
         JsonDocument respDoc;
         DeserializationError error = deserializeJson(respDoc, response.body);
 
         if (!error) {
-            result.success = true;
-            result.nodeId = respDoc["nodeId"].as<String>();
-            result.serialNumber = respDoc["serialNumber"].as<String>();
-            result.name = respDoc["name"].as<String>();
-            result.isSimulation = respDoc["isSimulation"] | false;
-            result.defaultIntervalSeconds = respDoc["defaultIntervalSeconds"] | 60;
+            bool changed = !config.success;
+            config.success = true;
+            config.error = "";
+            updateField(config.nodeId, respDoc["nodeId"], changed);
+            updateField(config.serialNumber, respDoc["serialNumber"], changed);
+            updateField(config.name, respDoc["name"], changed);
+            updateField(config.isSimulation, respDoc["isSimulation"] | false, changed);
+            updateField(config.defaultIntervalSeconds, respDoc["defaultIntervalSeconds"] | 60, changed);
 
             // Sprint OS-01: Parse storageMode from API
             // Default: LOCAL_AUTOSYNC (3) - store locally and sync when possible
-            result.storageMode = respDoc["storageMode"] | 3;
+            updateField(config.storageMode, respDoc["storageMode"] | 3, changed);
 
-            // Parse sensors array
+            // Diff sensors by position; only new sensors are allocated
             JsonArray sensorsArray = respDoc["sensors"].as<JsonArray>();
+            size_t sensorCount = 0;
             for (JsonObject sensorObj : sensorsArray) {
-                SensorAssignmentConfig sensor;
-                sensor.endpointId = sensorObj["endpointId"] | 0;
-                sensor.sensorCode = sensorObj["sensorCode"].as<String>();
-                sensor.sensorName = sensorObj["sensorName"].as<String>();
-                sensor.icon = sensorObj["icon"].as<String>();
-                sensor.color = sensorObj["color"].as<String>();
-                sensor.isActive = sensorObj["isActive"] | true;
-                sensor.intervalSeconds = sensorObj["intervalSeconds"] | 60;
-                sensor.i2cAddress = sensorObj["i2CAddress"].as<String>();
-                sensor.sdaPin = sensorObj["sdaPin"] | -1;
-                sensor.sclPin = sensorObj["sclPin"] | -1;
-                sensor.oneWirePin = sensorObj["oneWirePin"] | -1;
-                sensor.analogPin = sensorObj["analogPin"] | -1;
-                sensor.digitalPin = sensorObj["digitalPin"] | -1;
-                sensor.triggerPin = sensorObj["triggerPin"] | -1;
-                sensor.echoPin = sensorObj["echoPin"] | -1;
-                sensor.baudRate = sensorObj["baudRate"] | -1;
-                sensor.offsetCorrection = sensorObj["offsetCorrection"] | 0.0;
-                sensor.gainCorrection = sensorObj["gainCorrection"] | 1.0;
-
-                // Parse capabilities array
+                if (sensorCount == config.sensors.size()) {
+                    config.sensors.emplace_back();
+                    changed = true;
+                }
+                SensorAssignmentConfig& sensor = config.sensors[sensorCount++];
+                updateField(sensor.endpointId, sensorObj["endpointId"] | 0, changed);
+                updateField(sensor.sensorCode, sensorObj["sensorCode"], changed);
+                updateField(sensor.sensorName, sensorObj["sensorName"], changed);
+                updateField(sensor.icon, sensorObj["icon"], changed);
+                updateField(sensor.color, sensorObj["color"], changed);
+                updateField(sensor.isActive, sensorObj["isActive"] | true, changed);
+                updateField(sensor.intervalSeconds, sensorObj["intervalSeconds"] | 60, changed);
+                updateField(sensor.i2cAddress, sensorObj["i2CAddress"], changed);
+                updateField(sensor.sdaPin, sensorObj["sdaPin"] | -1, changed);
+                updateField(sensor.sclPin, sensorObj["sclPin"] | -1, changed);
+                updateField(sensor.oneWirePin, sensorObj["oneWirePin"] | -1, changed);
+                updateField(sensor.analogPin, sensorObj["analogPin"] | -1, changed);
+                updateField(sensor.digitalPin, sensorObj["digitalPin"] | -1, changed);
+                updateField(sensor.triggerPin, sensorObj["triggerPin"] | -1, changed);
+                updateField(sensor.echoPin, sensorObj["echoPin"] | -1, changed);
+                updateField(sensor.baudRate, sensorObj["baudRate"] | -1, changed);
+                updateField(sensor.offsetCorrection, sensorObj["offsetCorrection"] | 0.0, changed);
+                updateField(sensor.gainCorrection, sensorObj["gainCorrection"] | 1.0, changed);
+
                 JsonArray capsArray = sensorObj["capabilities"].as<JsonArray>();
+                size_t capCount = 0;
                 for (JsonObject capObj : capsArray) {
-                    SensorCapabilityConfig cap;
-                    cap.measurementType = capObj["measurementType"].as<String>();
-                    cap.displayName = capObj["displayName"].as<String>();
-                    cap.unit = capObj["unit"].as<String>();
-                    sensor.capabilities.push_back(cap);
+                    if (capCount == sensor.capabilities.size()) {
+                        sensor.capabilities.emplace_back();
+                        changed = true;
+                    }
+                    SensorCapabilityConfig& cap = sensor.capabilities[capCount++];
+                    updateField(cap.measurementType, capObj["measurementType"], changed);
+                    updateField(cap.displayName, capObj["displayName"], changed);
+                    updateField(cap.unit, capObj["unit"], changed);
+                    updateField(cap.adcChannel, capObj["adcChannel"] | -1, changed);
+                    updateField(cap.adcGain, capObj["adcGain"] | 0.0, changed);
+                    updateField(cap.adcDataRate, capObj["adcDataRate"] | 0, changed);
+                }
+                if (capCount < sensor.capabilities.size()) {
+                    sensor.capabilities.erase(sensor.capabilities.begin() + capCount, sensor.capabilities.end());
+                    changed = true;
                 }
+            }
+            if (sensorCount < config.sensors.size()) {
+                config.sensors.erase(config.sensors.begin() + sensorCount, config.sensors.end());
+                changed = true;
+            }
 
-                result.sensors.push_back(sensor);
+            // Applied: later polls are conditional on this version
+            _configEtag = response.etag;
+
+            if (!changed) {
+                Serial.println("[API] Configuration unchanged");
+                return ConfigFetchResult::UNCHANGED;
             }
 
             // Sprint OS-01: Log storage mode
             const char* storageModeNames[] = {"RemoteOnly", "LocalAndRemote", "LocalOnly", "LocalAutoSync"};
-            const char* storageModeName = (result.storageMode >= 0 && result.storageMode <= 3)
-                                          ? storageModeNames[result.storageMode] : "Unknown";
+            const char* storageModeName = (config.storageMode >= 0 && config.storageMode <= 3)
+                                          ? storageModeNames[config.storageMode] : "Unknown";
             Serial.printf("[API] Configuration loaded: %d sensors, StorageMode=%s (%d)\n",
-                          (int)result.sensors.size(), storageModeName, result.storageMode);
+                          (int)config.sensors.size(), storageModeName, config.storageMode);
 
-            for (const auto& s : result.sensors) {
+            for (const auto& s : config.sensors) {
                 Serial.printf("[API]   - %s (%s): Endpoint %d, Interval %ds\n",
                               s.sensorName.c_str(), s.sensorCode.c_str(),
                               s.endpointId, s.intervalSeconds);
             }
-        } else {
-            result.error = "Failed to parse configuration response";
-            Serial.printf("[API] JSON parse error: %s\n", error.c_str());
+            return ConfigFetchResult::UPDATED;
         }
+
+        config.error = "Failed to parse configuration response";
+        Serial.printf("[API] JSON parse error: %s\n", error.c_str());
     } else if (response.statusCode == 404) {
         // Node not found or no configuration - this is OK, node might not be configured yet
-        result.error = "No configuration found";
+        config.error = "No configuration found";
         Serial.println("[API] No configuration found for this node (not configured yet)");
     } else {
-        result.error = response.error.length() > 0 ? response.error : "Failed to fetch configuration";
+        config.error = response.error.length() > 0 ? response.error : "Failed to fetch configuration";
         Serial.printf("[API] Configuration fetch failed: %d - %s\n",
-                      response.statusCode, result.error.c_str());
+                      response.statusCode, config.error.c_str());
     }
 
-    return result;
+    return ConfigFetchResult::FAILED;
 }
 
 DebugConfigurationResponse ApiClient::fetchDebugConfiguration(const String& serialNumber) {
@@ -391,6 +536,7 @@ DebugConfigurationResponse ApiClient::fetchDebugConfiguration(const String& seri
     result.success = false;
     result.debugLevel = 1;  // Default: Normal
     result.enableRemoteLogging = false;
+    result.notModified = false;
 
     if (_baseUrl.length() == 0) {
         Serial.println("[API] Base URL not set for debug config fetch");
@@ -399,9 +545,13 @@ DebugConfigurationResponse ApiClient::fetchDebugConfiguration(const String& seri
     }
 
     String path = "/api/nodes/" + serialNumber + "/debug";
-    Serial.printf("[API] Fetching debug configuration for: %s\n", serialNumber.c_str());
+    ApiResponse response = httpGet(path, _debugEtag.c_str());
 
-    ApiResponse response = httpGet(path);
+    if (response.statusCode == 304) {
+        result.success = true;
+        result.notModified = true;
+        return result;
+    }
 
     if (response.success && response.statusCode == 200) {
         JsonDocument respDoc;
@@ -411,23 +561,11 @@ DebugConfigurationResponse ApiClient::fetchDebugConfiguration(const String& seri
             result.success = true;
             result.nodeId = respDoc["nodeId"].as<String>();
 
-            // Parse debugLevel - can be string ("Production", "Normal", "Debug") or int (0, 1, 2)
-            JsonVariant levelVar = respDoc["debugLevel"];
-            if (levelVar.is<const char*>()) {
-                String levelStr = levelVar.as<String>();
-                if (levelStr == "Production" || levelStr == "production") {
-                    result.debugLevel = 0;
-                } else if (levelStr == "Normal" || levelStr == "normal") {
-                    result.debugLevel = 1;
-                } else if (levelStr == "Debug" || levelStr == "debug") {
-                    result.debugLevel = 2;
-                }
-            } else {
-                result.debugLevel = levelVar | 1;
-            }
+            result.debugLevel = parseDebugLevel(respDoc["debugLevel"], 1);
 
             result.enableRemoteLogging = respDoc["enableRemoteLogging"] | false;
             result.lastDebugChange = respDoc["lastDebugChange"].as<String>();
+            _debugEtag = response.etag;
 
             const char* levelNames[] = {"Production", "Normal", "Debug"};
             const char* levelName = (result.debugLevel >= 0 && result.debugLevel <= 2)
@@ -496,8 +634,18 @@ String ApiClient::buildUrl(const String& path) const {
     return url;
 }
 
-ApiResponse ApiClient::httpGet(const String& path) {
+ApiResponse ApiClient::httpGet(const String& path, const char* ifNoneMatch) {
     ApiResponse result;
+    // Non-null ifNoneMatch: caller tracks the ETag; non-empty: send it as condition
+    bool tracksEtag = ifNoneMatch != nullptr;
+    bool conditional = tracksEtag && ifNoneMatch[0] != '\0';
+
+    if (replayRequest("GET", path, result)) {
+        return result;
+    }
+    unsigned long traceStart = millis();
+    TIMED_SCOPE("http.request");
+    MEMORY_TAG("http.request");
 
 #ifdef PLATFORM_ESP32
     String url = buildUrl(path);
@@ -518,6 +666,13 @@ ApiResponse ApiClient::httpGet(const String& path) {
     http.setTimeout(_timeout);
     http.addHeader("Authorization", "Bearer " + _apiKey);
     http.addHeader("Content-Type", "application/json");
+    if (tracksEtag) {
+        static const char* etagHeader[] = {"ETag"};
+        http.collectHeaders(etagHeader, 1);
+    }
+    if (conditional) {
+        http.addHeader("If-None-Match", ifNoneMatch);
+    }
 
     Serial.printf("[API] GET request (timeout: %d ms)...\n", _timeout);
     unsigned long requestStart = millis();
@@ -527,8 +682,12 @@ ApiResponse ApiClient::httpGet(const String& path) {
     Serial.printf("[API] Response: HTTP %d (%lu ms)\n", httpCode, requestTime);
     result.statusCode = httpCode;
 
-    if (httpCode > 0) {
+    if (httpCode == 304) {
+        // Not modified: no body to read
+        result.etag = http.header("ETag");
+    } else if (httpCode > 0) {
         result.body = http.getString();
+        result.etag = http.header("ETag");
         result.success = (httpCode >= 200 && httpCode < 300);
         if (!result.success) {
             Serial.printf("[API] Server error: %s\n", result.body.c_str());
@@ -557,63 +716,45 @@ ApiResponse ApiClient::httpGet(const String& path) {
 
     http.end();
 #elif defined(PLATFORM_NATIVE)
-    // Native implementation using libcurl
+    // Native implementation on the shared libcurl transport
     String url = buildUrl(path);
     Serial.printf("[API] GET %s\n", url.c_str());
 
-    CURL* curl = curl_easy_init();
-    if (curl) {
-        std::string responseBody;
-        struct curl_slist* headers = NULL;
-
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-        if (_apiKey.length() > 0) {
-            String authHeader = "Authorization: Bearer " + _apiKey;
-            headers = curl_slist_append(headers, authHeader.c_str());
-        }
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, _timeout);
-
-        // Allow self-signed certificates (for development)
-        const char* insecure = std::getenv("HUB_INSECURE");
-        if (insecure && strcmp(insecure, "true") == 0) {
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
-
-        CURLcode res = curl_easy_perform(curl);
-
-        if (res == CURLE_OK) {
-            long httpCode;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-            result.statusCode = (int)httpCode;
-            result.body = String(responseBody.c_str());
-            result.success = (httpCode >= 200 && httpCode < 300);
-        } else {
-            result.error = String(curl_easy_strerror(res));
-            result.success = false;
-            result.statusCode = 0;
-            Serial.printf("[API] CURL error: %s\n", result.error.c_str());
-        }
+    hal::native::HttpRequest request;
+    request.method = "GET";
+    request.url = url.c_str();
+    request.timeoutMs = _timeout;
+    request.headers.push_back("Content-Type: application/json");
+    if (_apiKey.length() > 0) {
+        request.headers.push_back(std::string("Authorization: Bearer ") + _apiKey.c_str());
+    }
+    if (conditional) {
+        request.headers.push_back(std::string("If-None-Match: ") + ifNoneMatch);
+    }
 
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-    } else {
-        result.error = "Failed to initialize CURL";
-        result.success = false;
+    performNative(std::move(request), result);
+    if (!tracksEtag) {
+        result.etag = "";
     }
 #endif
 
+    if (!result.success && result.statusCode != 304) {
+        Instrumentation::getInstance().count("http.errors");
+    }
+    recordRequest("GET", path, millis() - traceStart, result);
     return result;
 }
 
 ApiResponse ApiClient::httpPost(const String& path, const String& body) {
     ApiResponse result;
 
+    if (replayRequest("POST", path, result)) {
+        return result;
+    }
+    unsigned long traceStart = millis();
+    TIMED_SCOPE("http.request");
+    MEMORY_TAG("http.request");
+
 #ifdef PLATFORM_ESP32
     String url = buildUrl(path);
     Serial.printf("[API] POST %s: %s\n", url.c_str(), body.c_str());
@@ -673,57 +814,26 @@ ApiResponse ApiClient::httpPost(const String& path, const String& body) {
 
     http.end();
 #elif defined(PLATFORM_NATIVE)
-    // Native implementation using libcurl
+    // Native implementation on the shared libcurl transport
     String url = buildUrl(path);
     Serial.printf("[API] POST %s: %s\n", url.c_str(), body.c_str());
 
-    CURL* curl = curl_easy_init();
-    if (curl) {
-        std::string responseBody;
-        struct curl_slist* headers = NULL;
-
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-        if (_apiKey.length() > 0) {
-            String authHeader = "Authorization: Bearer " + _apiKey;
-            headers = curl_slist_append(headers, authHeader.c_str());
-        }
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, _timeout);
-
-        // Allow self-signed certificates (for development)
-        const char* insecure = std::getenv("HUB_INSECURE");
-        if (insecure && strcmp(insecure, "true") == 0) {
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
-
-        CURLcode res = curl_easy_perform(curl);
-
-        if (res == CURLE_OK) {
-            long httpCode;
-            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-            result.statusCode = (int)httpCode;
-            result.body = String(responseBody.c_str());
-            result.success = (httpCode >= 200 && httpCode < 300);
-        } else {
-            result.error = String(curl_easy_strerror(res));
-            result.success = false;
-            result.statusCode = 0;
-            Serial.printf("[API] CURL error: %s\n", result.error.c_str());
-        }
-
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-    } else {
-        result.error = "Failed to initialize CURL";
-        result.success = false;
+    hal::native::HttpRequest request;
+    request.method = "POST";
+    request.url = url.c_str();
+    request.body = body.c_str();
+    request.timeoutMs = _timeout;
+    request.headers.push_back("Content-Type: application/json");
+    if (_apiKey.length() > 0) {
+        request.headers.push_back(std::string("Authorization: Bearer ") + _apiKey.c_str());
     }
+
+    performNative(std::move(request), result);
 #endif
 
+    if (!result.success) {
+        Instrumentation::getInstance().count("http.errors");
+    }
+    recordRequest("POST", path, millis() - traceStart, result);
     return result;
 }
@@ -3,9 +3,12 @@
  * Combines:
  * 1. Beacon Mode: Broadcasts sensor data via advertising
  * 2. GATT Services: For bidirectional config exchange
+ * 3. History: Store-and-forward bulk read of missed readings
  */
 
 #include "ble_beacon_mode.h"
+#include "ble_sensor_payload.h"
+#include <math.h>
 
 #ifdef PLATFORM_ESP32
 #include <esp_mac.h>
@@ -36,9 +39,11 @@ public:
         // Reset authentication on disconnect
         _parent->resetAuthentication();
         Serial.println("[BLE-Hybrid] Authentication reset");
+        // Abort a running history read
+        _parent->_historyWindow = 0;
         // Restart advertising
         if (_parent->_advertising) {
-            NimBLEDevice::startAdvertising();
+            _parent->startRadio();
         }
     }
 
@@ -122,6 +127,23 @@ private:
     BleBeaconMode* _parent;
 };
 
+/**
+ * History characteristic callbacks - Hub writes READ/STOP requests here
+ * Public like sensor data, no authentication required
+ */
+class BleBeaconMode::HistoryWriteCallbacks : public NimBLECharacteristicCallbacks {
+public:
+    HistoryWriteCallbacks(BleBeaconMode* parent) : _parent(parent) {}
+
+    void onWrite(NimBLECharacteristic* pCharacteristic, NimBLEConnInfo& connInfo) override {
+        NimBLEAttValue value = pCharacteristic->getValue();
+        _parent->handleHistoryRequest(value.data(), value.size(), connInfo.getConnHandle(), connInfo.getMTU());
+    }
+
+private:
+    BleBeaconMode* _parent;
+};
+
 /**
  * Security callbacks for bonding/pairing
  * NimBLE 2.x API - only these methods are available for server:
@@ -181,7 +203,7 @@ public:
         Serial.printf("[BLE-Security] Client disconnected, reason: %d\n", reason);
         // Restart advertising
         if (_parent->_advertising) {
-            NimBLEDevice::startAdvertising();
+            _parent->startRadio();
         }
     }
 
@@ -194,7 +216,26 @@ private:
 BleBeaconMode::BleBeaconMode()
     : _initialized(false)
     , _advertising(false)
+    , _flags(0)
+    , _batteryMv(3300)
     , _configCallback(nullptr)
+    , _channelCount(0)
+    , _gpsLatitude(0)
+    , _gpsLongitude(0)
+    , _gpsAltitude(0)
+    , _gpsSatellites(0)
+    , _gpsFields(0)
+    , _frameCount(0)
+    , _frameIndex(0)
+    , _cycle(0)
+    , _keyCycle(0)
+    , _cyclesSinceKey(0)
+    , _rotationIntervalMs(config::ble_beacon::FRAME_ROTATION_MS)
+    , _lastRotationMs(0)
+    , _historyCursor(0)
+    , _historyWindow(0)
+    , _historyConnHandle(0)
+    , _historyMtu(config::ble_sensor::BLE_DEFAULT_ATT_MTU)
 #ifdef PLATFORM_ESP32
     , _pAdvertising(nullptr)
     , _pServer(nullptr)
@@ -202,10 +243,11 @@ BleBeaconMode::BleBeaconMode()
     , _pConfigWriteChar(nullptr)
     , _pConfigReadChar(nullptr)
     , _pSensorDataChar(nullptr)
+    , _pHistoryChar(nullptr)
 #endif
 {
-    memset(&_sensorData, 0, sizeof(_sensorData));
     memset(_nodeIdHash, 0, sizeof(_nodeIdHash));
+    memset(_frameLengths, 0, sizeof(_frameLengths));
 }
 
 BleBeaconMode::~BleBeaconMode() {
@@ -219,6 +261,11 @@ BleBeaconMode::~BleBeaconMode() {
 }
 
 bool BleBeaconMode::init(const String& nodeId) {
+    // History ring lives only while beacon mode runs (freed in stop())
+    if (!_history.allocate()) {
+        Serial.println("[BLE-Hybrid] No memory for the reading history - history disabled");
+    }
+
 #ifdef PLATFORM_ESP32
     _nodeId = nodeId;
     g_beaconInstance = this;
@@ -245,7 +292,7 @@ bool BleBeaconMode::init(const String& nodeId) {
     // Initialize NimBLE
     NimBLEDevice::init(_deviceName.c_str());
     NimBLEDevice::setPower(9);  // Max power
-    NimBLEDevice::setMTU(256);  // Larger MTU for config data
+    NimBLEDevice::setMTU(config::ble_beacon::HISTORY_MTU);  // Max MTU for config data and history batches
 
     // NOTE: BLE-Level Security (Bonding) causes connection timeouts with BlueZ
     // Workaround: Use application-level authentication instead
@@ -254,16 +301,13 @@ bool BleBeaconMode::init(const String& nodeId) {
     Serial.println("[BLE-Security] Using application-level authentication (no BLE bonding)");
     Serial.println("[BLE-Security] Hub must authenticate via CONFIG_WRITE before config changes");
 
-    // Initialize sensor data structure
-    _sensorData.companyId = MYIOTGRID_COMPANY_ID;
-    _sensorData.deviceType = MYIOTGRID_DEVICE_TYPE;
-    _sensorData.version = BEACON_PROTOCOL_VERSION;
-    memcpy(_sensorData.nodeIdHash, _nodeIdHash, 4);
-    _sensorData.temperature = 0;
-    _sensorData.humidity = 0;
-    _sensorData.pressure = 0;
-    _sensorData.battery = 3300;
-    _sensorData.flags = 0;
+    // Start with an empty key cycle (header + battery only)
+    _channelCount = 0;
+    _gpsFields = 0;
+    _flags = 0;
+    _batteryMv = 3300;
+    _cyclesSinceKey = 0;
+    buildFrames();
 
     // Setup GATT server and services
     setupGattServices();
@@ -309,7 +353,7 @@ void BleBeaconMode::setupSecurity() {
     Serial.printf("[BLE-Security] Existing bonded devices: %d\n", bondedCount);
 
     if (bondedCount > 0) {
-        _sensorData.flags |= FLAG_BONDED;
+        _flags |= FLAG_BONDED;
         Serial.println("[BLE-Security] Bonded addresses:");
         for (int i = 0; i < bondedCount; i++) {
             NimBLEAddress addr = NimBLEDevice::getBondedAddress(i);
@@ -367,6 +411,13 @@ void BleBeaconMode::setupGattServices() {
         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY
     );
 
+    // History characteristic - Hub requests a cursor range, batches come as notifications
+    _pHistoryChar = _pConfigService->createCharacteristic(
+        HISTORY_CHAR_UUID,
+        NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR | NIMBLE_PROPERTY::NOTIFY
+    );
+    _pHistoryChar->setCallbacks(new HistoryWriteCallbacks(this));
+
     // Start the service
     _pConfigService->start();
 
@@ -375,18 +426,31 @@ void BleBeaconMode::setupGattServices() {
     Serial.printf("[BLE-Hybrid] - Config Write: %s\n", CONFIG_WRITE_CHAR_UUID);
     Serial.printf("[BLE-Hybrid] - Config Read: %s\n", CONFIG_READ_CHAR_UUID);
     Serial.printf("[BLE-Hybrid] - Sensor Data: %s\n", SENSOR_DATA_CHAR_UUID);
+    Serial.printf("[BLE-Hybrid] - History: %s\n", HISTORY_CHAR_UUID);
 }
 
 void BleBeaconMode::updateSensorDataCharacteristic() {
     if (!_pSensorDataChar) return;
 
-    // Build sensor data JSON
+    // Build sensor data JSON: t/h/p short keys as before, other channels by type name
     String sensorJson = "{";
-    sensorJson += "\"t\":" + String(_sensorData.temperature / 100.0, 2) + ",";
-    sensorJson += "\"h\":" + String(_sensorData.humidity / 100.0, 1) + ",";
-    sensorJson += "\"p\":" + String((_sensorData.pressure + 50000) / 100.0, 1) + ",";
-    sensorJson += "\"b\":" + String(_sensorData.battery) + ",";
-    sensorJson += "\"f\":" + String(_sensorData.flags);
+    for (size_t i = 0; i < _channelCount; i++) {
+        const Channel& channel = _channels[i];
+        if (!channel.hasValue) continue;
+        const ble_payload::TypeInfo* info = ble_payload::typeById(channel.typeId);
+        if (!info) continue;
+
+        const char* key = info->type;
+        if (channel.typeId == 1) key = "t";
+        else if (channel.typeId == 2) key = "h";
+        else if (channel.typeId == 3) key = "p";
+
+        double scale = 1.0;
+        for (uint8_t d = 0; d < info->decimals; d++) scale *= 10.0;
+        sensorJson += "\"" + String(key) + "\":" + String(channel.value / scale, (unsigned int)info->decimals) + ",";
+    }
+    sensorJson += "\"b\":" + String(_batteryMv) + ",";
+    sensorJson += "\"f\":" + String(_flags);
     sensorJson += "}";
 
     _pSensorDataChar->setValue(sensorJson.c_str());
@@ -396,6 +460,58 @@ void BleBeaconMode::updateSensorDataCharacteristic() {
         _pSensorDataChar->notify();
     }
 }
+
+void BleBeaconMode::handleHistoryRequest(const uint8_t* data, size_t len, uint16_t connHandle, uint16_t mtu) {
+    if (len < 1) return;
+
+    if (data[0] == ble_history::OP_STOP) {
+        _historyWindow = 0;
+        Serial.println("[BLE-History] Read stopped by Hub");
+        return;
+    }
+    if (data[0] != ble_history::OP_READ || len < ble_history::REQUEST_SIZE) {
+        Serial.printf("[BLE-History] Invalid request: 0x%02X, len=%d\n", data[0], len);
+        return;
+    }
+
+    // Picked up by loop(); the window is written last so loop() sees a complete request
+    _historyWindow = 0;
+    _historyCursor = (uint32_t)data[1] | ((uint32_t)data[2] << 8) |
+                     ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+    _historyConnHandle = connHandle;
+    _historyMtu = mtu;
+    _historyWindow = data[5] ? data[5] : config::ble_beacon::HISTORY_DEFAULT_WINDOW;
+}
+
+void BleBeaconMode::streamHistory() {
+    if (_historyWindow == 0 || !_pHistoryChar) return;
+
+    // Batch fills the notification payload (MTU - 3 byte ATT header)
+    size_t capacity = _historyMtu > config::ble_sensor::BLE_DEFAULT_ATT_MTU
+                    ? _historyMtu - 3 : config::ble_sensor::BLE_DEFAULT_ATT_MTU - 3;
+    if (capacity > sizeof(_historyBatch)) capacity = sizeof(_historyBatch);
+
+    uint32_t nowSeconds = millis() / 1000;
+    for (uint8_t i = 0; i < config::ble_beacon::HISTORY_BATCHES_PER_LOOP && _historyWindow > 0; i++) {
+        uint32_t cursor = _historyCursor;
+        size_t length = _history.encodeBatch(cursor, nowSeconds, _historyBatch, capacity);
+        if (length == 0) {
+            _historyWindow = 0;
+            return;
+        }
+
+        // Host out of buffers: retry the same batch next pass
+        if (!_pHistoryChar->notify(_historyBatch, length, _historyConnHandle)) return;
+
+        _historyCursor = cursor;
+        if (_historyBatch[1] & ble_history::BATCH_LAST) {
+            Serial.printf("[BLE-History] Read complete at sequence %u\n", cursor);
+            _historyWindow = 0;
+        } else {
+            _historyWindow--;
+        }
+    }
+}
 #endif
 
 void BleBeaconMode::computeNodeIdHash(const String& nodeId) {
@@ -413,61 +529,197 @@ void BleBeaconMode::computeNodeIdHash(const String& nodeId) {
                   _nodeIdHash[0], _nodeIdHash[1], _nodeIdHash[2], _nodeIdHash[3]);
 }
 
-void BleBeaconMode::updateSensorData(float temperature, float humidity, float pressure, uint16_t batteryMv) {
-#ifdef PLATFORM_ESP32
-    if (!_initialized) return;
+bool BleBeaconMode::setReading(const String& type, float value, const String& unit) {
+    if (isnan(value)) return false;
+
+    // GPS fixes travel in their own frame
+    if (type == "latitude") { _gpsLatitude = value; _gpsFields |= 0x01; return true; }
+    if (type == "longitude") { _gpsLongitude = value; _gpsFields |= 0x02; return true; }
+    if (type == "altitude") { _gpsAltitude = value; return true; }
+    if (type == "satellites") { _gpsSatellites = value < 0 ? 0 : (value > 255 ? 255 : (uint8_t)value); return true; }
+
+    const ble_payload::TypeInfo* info = ble_payload::findType(type.c_str(), unit.c_str());
+    if (!info) return false;
+
+    double scaled = value;
+    for (uint8_t d = 0; d < info->decimals; d++) scaled *= 10.0;
+    scaled = round(scaled);
+    int32_t scaledValue = scaled >= 2147483647.0 ? INT32_MAX
+                        : scaled <= -2147483648.0 ? INT32_MIN : (int32_t)scaled;
+
+    for (size_t i = 0; i < _channelCount; i++) {
+        if (_channels[i].typeId == info->id) {
+            _channels[i].value = scaledValue;
+            _channels[i].hasValue = true;
+            _channels[i].updated = true;
+            return true;
+        }
+    }
 
-    // Convert to packed format
-    _sensorData.temperature = (int16_t)(temperature * 100);  // 21.50°C -> 2150
-    _sensorData.humidity = (uint16_t)(humidity * 100);       // 65.00% -> 6500
-    // Pressure input is in hPa, convert to Pa then offset for uint16_t storage
-    // 1010.81 hPa * 100 = 101081 Pa, 101081 - 50000 = 51081
-    _sensorData.pressure = (uint16_t)(pressure * 100 - 50000);
-    _sensorData.battery = batteryMv;
+    if (_channelCount >= config::ble_beacon::MAX_CHANNELS) return false;
+    Channel& channel = _channels[_channelCount++];
+    channel.typeId = info->id;
+    channel.value = scaledValue;
+    channel.keyValue = 0;
+    channel.hasKey = false;
+    channel.hasValue = true;
+    channel.updated = true;
+    return true;
+}
 
-    Serial.printf("[BLE-Hybrid] Updating: T=%.2f°C, H=%.1f%%, P=%.0f hPa, Bat=%dmV\n",
-                  temperature, humidity, pressure, batteryMv);
+void BleBeaconMode::publishReadings(uint16_t batteryMv) {
+    _batteryMv = batteryMv;
+    _cycle = (_cycle + 1) & 0x0F;
 
-    // Update advertising data (beacon)
-    updateAdvertisingData();
+    // New channels have no key value to diff against
+    for (size_t i = 0; i < _channelCount; i++) {
+        if (_channels[i].hasValue && !_channels[i].hasKey) {
+            _cyclesSinceKey = 0;
+            break;
+        }
+    }
+
+    buildFrames();
+    _cyclesSinceKey = (_cyclesSinceKey + 1) % config::ble_beacon::KEYFRAME_INTERVAL;
+
+    // Keep this poll's readings for Hubs that miss the advertisements
+    uint32_t seconds = millis() / 1000;
+    for (size_t i = 0; i < _channelCount; i++) {
+        if (!_channels[i].updated) continue;
+        _history.push(seconds, _channels[i].typeId, _channels[i].value);
+        _channels[i].updated = false;
+    }
+
+    Serial.printf("[BLE-Hybrid] Cycle %d: %d channels in %d frame(s), bat=%dmV, history=%d\n",
+                  _cycle, _channelCount, _frameCount, batteryMv, _history.size());
+
+#ifdef PLATFORM_ESP32
+    if (!_initialized) return;
 
     // Update GATT characteristic
     updateSensorDataCharacteristic();
 
-    // Restart advertising with new data
+    // Restart rotation at the first frame of the new cycle
+    _frameIndex = 0;
+    _lastRotationMs = millis();
+    updateAdvertisingData();
     if (_advertising) {
-        _pAdvertising->stop();
-        _pAdvertising->start();
-        Serial.println("[BLE-Hybrid] Advertising restarted with new data");
+        stopRadio();
+        startRadio();
     }
-#else
-    Serial.printf("[BLE-Hybrid] SIM: T=%.2f, H=%.1f, P=%.0f\n", temperature, humidity, pressure);
 #endif
 }
 
+size_t BleBeaconMode::beginFrame(uint8_t type) {
+    if (_frameCount >= config::ble_beacon::MAX_FRAMES) return 0;
+
+    uint8_t* frame = _frames[_frameCount];
+    frame[0] = (uint8_t)(MYIOTGRID_COMPANY_ID & 0xFF);
+    frame[1] = (uint8_t)(MYIOTGRID_COMPANY_ID >> 8);
+    frame[2] = MYIOTGRID_DEVICE_TYPE;
+    frame[3] = BEACON_PROTOCOL_VERSION;
+    memcpy(frame + 4, _nodeIdHash, 4);
+    frame[8] = (uint8_t)((type << 4) | (_cycle & 0x0F));
+
+    size_t length = BEACON_FRAME_HEADER_SIZE;
+    if (type == BEACON_FRAME_KEY) {
+        frame[length++] = _flags;
+        frame[length++] = (uint8_t)(_batteryMv & 0xFF);
+        frame[length++] = (uint8_t)(_batteryMv >> 8);
+    } else if (type == BEACON_FRAME_DELTA) {
+        frame[length++] = _flags;
+        frame[length++] = _keyCycle & 0x0F;
+    }
+    _frameLengths[_frameCount++] = (uint8_t)length;
+    return length;
+}
+
+void BleBeaconMode::buildFrames() {
+    _frameCount = 0;
+    _frameIndex = 0;
+
+    bool key = _cyclesSinceKey == 0;
+    uint8_t type = key ? BEACON_FRAME_KEY : BEACON_FRAME_DELTA;
+    if (key) {
+        _keyCycle = _cycle;
+    }
+
+    size_t length = beginFrame(type);
+    for (size_t i = 0; i < _channelCount && length > 0; i++) {
+        Channel& channel = _channels[i];
+        if (!channel.hasValue) continue;
+        if (!key && channel.value == channel.keyValue) continue;  // Scanner keeps the key value
+
+        int32_t value = key ? channel.value : (int32_t)((uint32_t)channel.value - (uint32_t)channel.keyValue);
+        if (key) {
+            channel.keyValue = channel.value;
+            channel.hasKey = true;
+        }
+
+        // u8 channel + zigzag varint (at most 5 bytes)
+        uint8_t encoded[6];
+        size_t encodedLength = 0;
+        encoded[encodedLength++] = channel.typeId;
+        uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+        while (zigzag >= 0x80) {
+            encoded[encodedLength++] = (uint8_t)(zigzag | 0x80);
+            zigzag >>= 7;
+        }
+        encoded[encodedLength++] = (uint8_t)zigzag;
+
+        if (length + encodedLength > BEACON_FRAME_CAPACITY) {
+            length = beginFrame(type);
+            if (length == 0) {
+                Serial.printf("[BLE-Hybrid] %d channels exceed %d frames, rest not broadcast\n",
+                              _channelCount - i, config::ble_beacon::MAX_FRAMES);
+                break;
+            }
+        }
+        memcpy(_frames[_frameCount - 1] + length, encoded, encodedLength);
+        length += encodedLength;
+        _frameLengths[_frameCount - 1] = (uint8_t)length;
+    }
+
+    // GPS frame once a position is known
+    if ((_gpsFields & 0x03) == 0x03) {
+        size_t gpsLength = beginFrame(BEACON_FRAME_GPS);
+        if (gpsLength > 0) {
+            uint8_t* p = _frames[_frameCount - 1] + gpsLength;
+            int32_t lat = (int32_t)round(_gpsLatitude * 1e7);
+            int32_t lon = (int32_t)round(_gpsLongitude * 1e7);
+            double alt = round(_gpsAltitude);
+            int16_t altM = alt > 32767 ? 32767 : (alt < -32768 ? -32768 : (int16_t)alt);
+            for (int b = 0; b < 4; b++) p[b] = (uint8_t)((uint32_t)lat >> (8 * b));
+            for (int b = 0; b < 4; b++) p[4 + b] = (uint8_t)((uint32_t)lon >> (8 * b));
+            p[8] = (uint8_t)((uint16_t)altM & 0xFF);
+            p[9] = (uint8_t)((uint16_t)altM >> 8);
+            p[10] = _gpsSatellites;
+            _frameLengths[_frameCount - 1] = (uint8_t)(gpsLength + 11);
+        }
+    }
+}
+
 void BleBeaconMode::updateAdvertisingData() {
 #ifdef PLATFORM_ESP32
-    // Simplified manufacturer data format (max 31 bytes in advertising packet!)
-    // Format: [temp:2][humidity:2][pressure:2][battery:2] = 8 bytes
-    // Company ID 0xFFFF is included automatically by NimBLE
-    std::vector<uint8_t> mfgData;
-
-    // Add sensor data (8 bytes) - company ID is added by NimBLE
-    mfgData.push_back(_sensorData.temperature & 0xFF);
-    mfgData.push_back((_sensorData.temperature >> 8) & 0xFF);
-    mfgData.push_back(_sensorData.humidity & 0xFF);
-    mfgData.push_back((_sensorData.humidity >> 8) & 0xFF);
-    mfgData.push_back(_sensorData.pressure & 0xFF);
-    mfgData.push_back((_sensorData.pressure >> 8) & 0xFF);
-    mfgData.push_back(_sensorData.battery & 0xFF);
-    mfgData.push_back((_sensorData.battery >> 8) & 0xFF);
-
-    Serial.printf("[BLE-Hybrid] Manufacturer data: %d bytes\n", mfgData.size());
-
-    // Advertising data: flags + manufacturer data
+    if (_frameCount == 0 || !_pAdvertising) return;
+    const uint8_t* frame = _frames[_frameIndex];
+    size_t length = _frameLengths[_frameIndex];
+
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    // Extended advertising: one connectable PDU carries flags, name and the frame
+    NimBLEExtAdvertisement advData(BLE_HCI_LE_PHY_1M, BLE_HCI_LE_PHY_1M);
+    advData.setConnectable(true);
+    advData.setFlags(BLE_HS_ADV_F_DISC_GEN | BLE_HS_ADV_F_BREDR_UNSUP);
+    advData.setName(_deviceName.c_str());
+    advData.setManufacturerData(frame, length);
+    advData.setMinInterval(160);  // 100ms
+    advData.setMaxInterval(320);  // 200ms
+    _pAdvertising->setInstanceData(0, advData);
+#else
+    // Advertising data: flags + manufacturer data (frame starts with the company ID)
     NimBLEAdvertisementData advData;
     advData.setFlags(BLE_HS_ADV_F_DISC_GEN | BLE_HS_ADV_F_BREDR_UNSUP);
-    advData.setManufacturerData(mfgData);
+    advData.setManufacturerData(frame, length);
     _pAdvertising->setAdvertisementData(advData);
 
     // Scan response: device name + service UUID (for GATT discovery)
@@ -480,6 +732,29 @@ void BleBeaconMode::updateAdvertisingData() {
     _pAdvertising->setMinInterval(160);  // 100ms
     _pAdvertising->setMaxInterval(320);  // 200ms
 #endif
+#endif
+}
+
+void BleBeaconMode::startRadio() {
+#ifdef PLATFORM_ESP32
+    if (!_pAdvertising) return;
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    _pAdvertising->start(0);
+#else
+    _pAdvertising->start();
+#endif
+#endif
+}
+
+void BleBeaconMode::stopRadio() {
+#ifdef PLATFORM_ESP32
+    if (!_pAdvertising) return;
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    _pAdvertising->stop(0);
+#else
+    _pAdvertising->stop();
+#endif
+#endif
 }
 
 void BleBeaconMode::startAdvertising() {
@@ -494,8 +769,10 @@ void BleBeaconMode::startAdvertising() {
         return;
     }
 
+    _frameIndex = 0;
+    _lastRotationMs = millis();
     updateAdvertisingData();
-    _pAdvertising->start();
+    startRadio();
     _advertising = true;
 
     Serial.println("[BLE-Hybrid] =====================================");
@@ -513,7 +790,7 @@ void BleBeaconMode::startAdvertising() {
 void BleBeaconMode::stop() {
 #ifdef PLATFORM_ESP32
     if (_pAdvertising && _advertising) {
-        _pAdvertising->stop();
+        stopRadio();
     }
     // Disconnect all clients
     if (_pServer) {
@@ -521,6 +798,8 @@ void BleBeaconMode::stop() {
     }
 #endif
     _advertising = false;
+    _historyWindow = 0;
+    _history.deallocate();
     Serial.println("[BLE-Hybrid] Stopped");
 }
 
@@ -534,17 +813,17 @@ bool BleBeaconMode::isConnected() const {
 
 void BleBeaconMode::setErrorFlag(bool error) {
     if (error) {
-        _sensorData.flags |= FLAG_ERROR;
+        _flags |= FLAG_ERROR;
     } else {
-        _sensorData.flags &= ~FLAG_ERROR;
+        _flags &= ~FLAG_ERROR;
     }
 }
 
 void BleBeaconMode::setLowBatteryFlag(bool lowBattery) {
     if (lowBattery) {
-        _sensorData.flags |= FLAG_LOW_BATTERY;
+        _flags |= FLAG_LOW_BATTERY;
     } else {
-        _sensorData.flags &= ~FLAG_LOW_BATTERY;
+        _flags &= ~FLAG_LOW_BATTERY;
     }
 }
 
@@ -571,8 +850,19 @@ void BleBeaconMode::sendResponse(uint8_t responseCode, const uint8_t* data, size
 
 void BleBeaconMode::loop() {
 #ifdef PLATFORM_ESP32
-    // NimBLE handles events in background tasks
-    // This can be used for periodic tasks if needed
+    // NimBLE handles events in background tasks; stream history and rotate the cycle's frames here
+    streamHistory();
+
+    if (!_advertising || _frameCount < 2) return;
+
+    unsigned long now = millis();
+    if (now - _lastRotationMs < _rotationIntervalMs) return;
+    _lastRotationMs = now;
+
+    _frameIndex = (_frameIndex + 1) % _frameCount;
+    updateAdvertisingData();
+    stopRadio();
+    startRadio();
 #endif
 }
 
@@ -601,7 +891,7 @@ void BleBeaconMode::deleteBonds() {
         Serial.printf("[BLE-Security] Deleting bond: %s\n", addr.toString().c_str());
         NimBLEDevice::deleteBond(addr);
     }
-    _sensorData.flags &= ~FLAG_BONDED;
+    _flags &= ~FLAG_BONDED;
     Serial.println("[BLE-Security] All bonds deleted");
 #endif
 }
@@ -609,9 +899,9 @@ void BleBeaconMode::deleteBonds() {
 void BleBeaconMode::updateBondedFlag() {
 #ifdef PLATFORM_ESP32
     if (NimBLEDevice::getNumBonds() > 0) {
-        _sensorData.flags |= FLAG_BONDED;
+        _flags |= FLAG_BONDED;
     } else {
-        _sensorData.flags &= ~FLAG_BONDED;
+        _flags &= ~FLAG_BONDED;
     }
 #endif
 }
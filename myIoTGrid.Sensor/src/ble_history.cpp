@@ -0,0 +1,83 @@
+/**
+ * myIoTGrid.Sensor - BLE Reading History Implementation
+ */
+
+#include "ble_history.h"
+#include <new>
+#include <string.h>
+
+namespace ble_history {
+
+namespace {
+
+inline void put32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+} // namespace
+
+Ring::~Ring() {
+    deallocate();
+}
+
+bool Ring::allocate() {
+    if (_samples) return true;
+    _samples = new (std::nothrow) uint8_t[capacity() * SAMPLE_SIZE];
+    return _samples != nullptr;
+}
+
+void Ring::deallocate() {
+    delete[] _samples;
+    _samples = nullptr;
+    _head = 0;
+    _count = 0;
+}
+
+void Ring::push(uint32_t seconds, uint8_t typeId, int32_t value) {
+    if (!_samples) return;
+
+    uint8_t* sample = _samples + _head * SAMPLE_SIZE;
+    sample[0] = typeId;
+    put32(sample + 1, seconds);
+    put32(sample + 5, (uint32_t)value);
+
+    _head = (_head + 1) % capacity();
+    if (_count < capacity()) _count++;
+    _nextSequence++;
+}
+
+size_t Ring::encodeBatch(uint32_t& cursor, uint32_t nowSeconds, uint8_t* out, size_t outCapacity) const {
+    if (outCapacity < BATCH_HEADER_SIZE) return 0;
+
+    // Overwritten or from before a reboot: restart at the oldest sample
+    uint32_t first = firstSequence();
+    if (cursor - first > (uint32_t)_count) {
+        cursor = first;
+    }
+
+    size_t available = (size_t)(_nextSequence - cursor);
+    size_t fit = (outCapacity - BATCH_HEADER_SIZE) / SAMPLE_SIZE;
+    size_t n = available < fit ? available : fit;
+
+    out[0] = VERSION;
+    out[1] = n == available ? BATCH_LAST : 0;
+    put32(out + 2, cursor);
+    put32(out + 6, nowSeconds);
+
+    // Oldest sample sits _count slots behind the head
+    size_t slot = (_head + capacity() - _count + (size_t)(cursor - first)) % capacity();
+    uint8_t* p = out + BATCH_HEADER_SIZE;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(p, _samples + slot * SAMPLE_SIZE, SAMPLE_SIZE);
+        p += SAMPLE_SIZE;
+        slot = (slot + 1) % capacity();
+    }
+
+    cursor += (uint32_t)n;
+    return BATCH_HEADER_SIZE + n * SAMPLE_SIZE;
+}
+
+} // namespace ble_history
@@ -0,0 +1,171 @@
+/**
+ * myIoTGrid.Sensor - Binary BLE Sensor Payload Implementation
+ */
+
+#include "ble_sensor_payload.h"
+#include <math.h>
+#include <string.h>
+
+namespace ble_payload {
+
+namespace {
+
+// Ids are part of the wire format: append new types, never renumber
+const TypeInfo TYPES[] = {
+    {1,  "temperature",   "°C",  2},
+    {2,  "humidity",      "%",   2},
+    {3,  "pressure",      "hPa", 2},
+    {4,  "light",         "lux", 1},
+    {5,  "co2",           "ppm", 0},
+    {6,  "uv",            "UVI", 2},
+    {7,  "water_level",   "cm",  1},
+    {8,  "distance",      "cm",  1},
+    {9,  "voltage",       "V",   3},
+    {10, "battery",       "%",   0},
+    {11, "soil_moisture", "%",   1},
+    {12, "gas_resistance", "kOhm", 2},
+};
+
+const size_t TYPE_COUNT = sizeof(TYPES) / sizeof(TYPES[0]);
+const size_t MAX_NAME_LENGTH = 32;
+
+inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+inline void put32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * round(value * scale), saturated to int32
+ */
+int32_t scaleToInt(double value, double scale) {
+    double scaled = round(value * scale);
+    if (scaled >= 2147483647.0) return INT32_MAX;
+    if (scaled <= -2147483648.0) return INT32_MIN;
+    return (int32_t)scaled;
+}
+
+double pow10i(uint8_t decimals) {
+    double scale = 1.0;
+    for (uint8_t i = 0; i < decimals; i++) scale *= 10.0;
+    return scale;
+}
+
+size_t boundedLength(const char* s) {
+    size_t length = s ? strlen(s) : 0;
+    return length < MAX_NAME_LENGTH ? length : MAX_NAME_LENGTH;
+}
+
+} // namespace
+
+const TypeInfo* findType(const char* type, const char* unit) {
+    if (!type || !unit) return nullptr;
+    for (size_t i = 0; i < TYPE_COUNT; i++) {
+        if (strcmp(TYPES[i].type, type) == 0 && strcmp(TYPES[i].unit, unit) == 0) {
+            return &TYPES[i];
+        }
+    }
+    return nullptr;
+}
+
+const TypeInfo* typeById(uint8_t id) {
+    for (size_t i = 0; i < TYPE_COUNT; i++) {
+        if (TYPES[i].id == id) return &TYPES[i];
+    }
+    return nullptr;
+}
+
+size_t encodeSchema(uint8_t* out, size_t capacity) {
+    if (capacity < 2) return 0;
+    size_t length = 0;
+    out[length++] = VERSION;
+    out[length++] = (uint8_t)TYPE_COUNT;
+
+    for (size_t i = 0; i < TYPE_COUNT; i++) {
+        const TypeInfo& info = TYPES[i];
+        size_t typeLength = strlen(info.type);
+        size_t unitLength = strlen(info.unit);
+        if (capacity - length < 4 + typeLength + unitLength) return 0;
+
+        out[length++] = info.id;
+        out[length++] = info.decimals;
+        out[length++] = (uint8_t)typeLength;
+        memcpy(out + length, info.type, typeLength);
+        length += typeLength;
+        out[length++] = (uint8_t)unitLength;
+        memcpy(out + length, info.unit, unitLength);
+        length += unitLength;
+    }
+    return length;
+}
+
+uint8_t* Writer::reserve(uint8_t tag, size_t valueLength) {
+    if (_overflow || valueLength > 255 || _capacity - _length < 2 + valueLength) {
+        _overflow = true;
+        return nullptr;
+    }
+    uint8_t* record = _buffer + _length;
+    record[0] = tag;
+    record[1] = (uint8_t)valueLength;
+    _length += 2 + valueLength;
+    return record + 2;
+}
+
+void Writer::addTimestamp(uint32_t millis) {
+    uint8_t* p = reserve(TAG_TIMESTAMP, 4);
+    if (p) put32(p, millis);
+}
+
+void Writer::addReading(const char* type, float value, const char* unit) {
+    if (isnan(value)) return;  // Failed read, nothing to scale
+
+    const TypeInfo* info = findType(type, unit);
+    if (info) {
+        int32_t scaled = scaleToInt(value, pow10i(info->decimals));
+        bool fits16 = scaled >= INT16_MIN && scaled <= INT16_MAX;
+        uint8_t* p = reserve(TAG_READING, fits16 ? 3 : 5);
+        if (!p) return;
+        p[0] = info->id;
+        if (fits16) {
+            put16(p + 1, (uint16_t)(int16_t)scaled);
+        } else {
+            put32(p + 1, (uint32_t)scaled);
+        }
+        return;
+    }
+
+    // Unknown type: carry name and unit inline with a fixed 2 decimal scale
+    const uint8_t decimals = 2;
+    size_t typeLength = boundedLength(type);
+    size_t unitLength = boundedLength(unit);
+    uint8_t* p = reserve(TAG_NAMED, 6 + typeLength + unitLength);
+    if (!p) return;
+    p[0] = decimals;
+    put32(p + 1, (uint32_t)scaleToInt(value, pow10i(decimals)));
+    p[5] = (uint8_t)typeLength;
+    memcpy(p + 6, type, typeLength);
+    memcpy(p + 6 + typeLength, unit, unitLength);
+}
+
+void Writer::addGps(double latitude, double longitude, double altitude,
+                    float speed, float course, int satellites) {
+    uint8_t* p = reserve(TAG_GPS, 17);
+    if (!p) return;
+    put32(p, (uint32_t)scaleToInt(latitude, 1e7));
+    put32(p + 4, (uint32_t)scaleToInt(longitude, 1e7));
+    put32(p + 8, (uint32_t)scaleToInt(altitude, 100.0));
+
+    int32_t speedScaled = scaleToInt(speed, 100.0);
+    int32_t courseScaled = scaleToInt(course, 100.0);
+    put16(p + 12, (uint16_t)(speedScaled < 0 ? 0 : (speedScaled > 0xFFFF ? 0xFFFF : speedScaled)));
+    put16(p + 14, (uint16_t)(courseScaled < 0 ? 0 : (courseScaled > 0xFFFF ? 0xFFFF : courseScaled)));
+    p[16] = (uint8_t)(satellites < 0 ? 0 : (satellites > 255 ? 255 : satellites));
+}
+
+} // namespace ble_payload
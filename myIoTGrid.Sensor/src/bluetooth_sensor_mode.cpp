@@ -6,12 +6,15 @@
  */
 
 #include "bluetooth_sensor_mode.h"
+#include "ble_sensor_payload.h"
 #include <ArduinoJson.h>
 
 #ifdef PLATFORM_ESP32
 #include <WiFi.h>
 #include <esp_mac.h>
 #include <esp_bt.h>
+#elif defined(PLATFORM_NATIVE)
+#include "ArduinoJsonString.h"
 #endif
 
 BluetoothSensorMode::BluetoothSensorMode()
@@ -21,11 +24,15 @@ BluetoothSensorMode::BluetoothSensorMode()
     , _lastTransmitSuccess(false)
     , _connectionCount(0)
     , _transmissionCount(0)
+    , _mtu(config::ble_sensor::BLE_DEFAULT_ATT_MTU)
+    , _messageSequence(0)
+    , _lastPayloadSize(0)
 #ifdef PLATFORM_ESP32
     , _server(nullptr)
     , _service(nullptr)
     , _sensorDataChar(nullptr)
     , _deviceInfoChar(nullptr)
+    , _schemaChar(nullptr)
     , _advertising(nullptr)
 #endif
 {
@@ -96,6 +103,16 @@ bool BluetoothSensorMode::init(const String& nodeId) {
     String deviceInfo = buildDeviceInfoJson();
     _deviceInfoChar->setValue(deviceInfo.c_str());
 
+    // Create Schema Characteristic (READ)
+    // Maps payload type ids to type name, unit and decimal scale; centrals read it once
+    _schemaChar = _service->createCharacteristic(
+        config::ble_sensor::CHAR_SCHEMA_UUID,
+        NIMBLE_PROPERTY::READ
+    );
+    uint8_t schema[config::ble_sensor::BLE_PAYLOAD_SCHEMA_MAX_SIZE];
+    size_t schemaLength = ble_payload::encodeSchema(schema, sizeof(schema));
+    _schemaChar->setValue(schema, schemaLength);
+
     // Start service
     _service->start();
 
@@ -201,15 +218,25 @@ bool BluetoothSensorMode::sendSensorData(const std::vector<BleSensorReading>& re
         return false;
     }
 
-    // Build JSON payload
-    String jsonPayload = buildSensorDataJson(readings, gps);
+    size_t length = encodeSensorData(readings, gps);
+    if (length == 0) {
+        Serial.printf("[BLE-Sensor] %d readings exceed payload buffer (%d bytes)\n",
+                      readings.size(), sizeof(_payload));
+        _lastTransmitSuccess = false;
+        return false;
+    }
 
-    Serial.printf("[BLE-Sensor] Sending %d readings (%d bytes)\n",
-                  readings.size(), jsonPayload.length());
+    Serial.printf("[BLE-Sensor] Sending %d readings (%d bytes, MTU %d)\n",
+                  readings.size(), length, _mtu);
 
-    // Send via notification
-    _sensorDataChar->setValue(jsonPayload.c_str());
-    _sensorDataChar->notify();
+    if (!notifyFragments(length)) {
+        Serial.println("[BLE-Sensor] Notification failed - host out of buffers");
+        _lastTransmitSuccess = false;
+        if (_onTransmitComplete) {
+            _onTransmitComplete(false);
+        }
+        return false;
+    }
 
     _transmissionCount++;
     _lastTransmitSuccess = true;
@@ -222,7 +249,9 @@ bool BluetoothSensorMode::sendSensorData(const std::vector<BleSensorReading>& re
     return true;
 #else
     // Native simulation
-    Serial.printf("[BLE-Sensor] Simulating send of %d readings\n", readings.size());
+    size_t length = encodeSensorData(readings, gps);
+    Serial.printf("[BLE-Sensor] Simulating send of %d readings (%d bytes)\n",
+                  readings.size(), length);
     _transmissionCount++;
     _lastTransmitSuccess = true;
     if (_onTransmitComplete) {
@@ -232,37 +261,68 @@ bool BluetoothSensorMode::sendSensorData(const std::vector<BleSensorReading>& re
 #endif
 }
 
-String BluetoothSensorMode::buildSensorDataJson(const std::vector<BleSensorReading>& readings,
-                                                  const BleGpsData* gps) {
-    JsonDocument doc;
-
-    // Node identification
-    doc["nodeId"] = _nodeId;
-    doc["timestamp"] = millis();  // Will be converted to UTC by BluetoothHub
+size_t BluetoothSensorMode::encodeSensorData(const std::vector<BleSensorReading>& readings,
+                                             const BleGpsData* gps) {
+    // Node identification is in the device info characteristic, read once per connection
+    ble_payload::Writer writer(_payload, sizeof(_payload));
+    writer.addTimestamp(millis());  // Will be converted to UTC by BluetoothHub
 
-    // Sensor readings array
-    JsonArray sensorsArray = doc["sensors"].to<JsonArray>();
     for (const auto& reading : readings) {
-        JsonObject sensor = sensorsArray.add<JsonObject>();
-        sensor["type"] = reading.sensorType;
-        sensor["value"] = reading.value;
-        sensor["unit"] = reading.unit;
+        writer.addReading(reading.sensorType.c_str(), reading.value, reading.unit.c_str());
     }
 
-    // GPS data (if available)
     if (gps && gps->valid) {
-        JsonObject gpsObj = doc["gps"].to<JsonObject>();
-        gpsObj["latitude"] = gps->latitude;
-        gpsObj["longitude"] = gps->longitude;
-        gpsObj["altitude"] = gps->altitude;
-        gpsObj["speed"] = gps->speed;
-        gpsObj["course"] = gps->course;
-        gpsObj["satellites"] = gps->satellites;
+        writer.addGps(gps->latitude, gps->longitude, gps->altitude,
+                      gps->speed, gps->course, gps->satellites);
     }
 
-    String output;
-    serializeJson(doc, output);
-    return output;
+    _lastPayloadSize = writer.overflowed() ? 0 : writer.length();
+    return _lastPayloadSize;
+}
+
+bool BluetoothSensorMode::notifyFragments(size_t length) {
+#ifdef PLATFORM_ESP32
+    // ATT notification value is MTU - 3 (opcode + handle)
+    uint16_t mtu = _mtu < config::ble_sensor::BLE_DEFAULT_ATT_MTU
+        ? config::ble_sensor::BLE_DEFAULT_ATT_MTU : _mtu;
+    size_t fragmentSize = mtu - 3;
+    if (fragmentSize > config::ble_sensor::BLE_NOTIFY_MAX_SIZE) {
+        fragmentSize = config::ble_sensor::BLE_NOTIFY_MAX_SIZE;
+    }
+    size_t chunkSize = fragmentSize - ble_payload::FRAGMENT_HEADER_SIZE;
+
+    size_t fragmentCount = (length + chunkSize - 1) / chunkSize;
+    if (fragmentCount > ble_payload::MAX_FRAGMENTS) {
+        return false;
+    }
+
+    uint8_t sequence = _messageSequence++;
+    uint8_t fragment[config::ble_sensor::BLE_NOTIFY_MAX_SIZE];
+
+    for (size_t index = 0; index < fragmentCount; index++) {
+        size_t offset = index * chunkSize;
+        size_t chunk = length - offset < chunkSize ? length - offset : chunkSize;
+
+        fragment[0] = ble_payload::VERSION;
+        fragment[1] = sequence;
+        fragment[2] = (uint8_t)index | (index + 1 == fragmentCount ? ble_payload::FRAGMENT_LAST : 0);
+        memcpy(fragment + ble_payload::FRAGMENT_HEADER_SIZE, _payload + offset, chunk);
+
+        // Back-to-back notifications can exhaust the host's mbufs; give it a moment
+        bool sent = false;
+        for (int attempt = 0; attempt <= config::ble_sensor::BLE_NOTIFY_RETRY_COUNT && !sent; attempt++) {
+            if (attempt > 0) delay(10);
+            sent = _sensorDataChar->notify(fragment, ble_payload::FRAGMENT_HEADER_SIZE + chunk);
+        }
+        if (!sent) {
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)length;
+    return true;
+#endif
 }
 
 String BluetoothSensorMode::buildDeviceInfoJson() {
@@ -273,6 +333,7 @@ String BluetoothSensorMode::buildDeviceInfoJson() {
     doc["firmwareVersion"] = FIRMWARE_VERSION;
     doc["hardwareType"] = HARDWARE_TYPE;
     doc["protocol"] = "bluetooth";
+    doc["payloadVersion"] = ble_payload::VERSION;
 
     String output;
     serializeJson(doc, output);
@@ -291,6 +352,7 @@ void BluetoothSensorMode::ServerCallbacks::onConnect(NimBLEServer* server, NimBL
     Serial.printf("[BLE-Sensor] MTU: %d\n", connInfo.getMTU());
     Serial.println("========================================");
 
+    _parent->_mtu = connInfo.getMTU();
     _parent->_connected = true;
     _parent->_advertising_active = false;
     _parent->_connectionCount++;
@@ -307,6 +369,7 @@ void BluetoothSensorMode::ServerCallbacks::onDisconnect(NimBLEServer* server, Ni
     Serial.printf("[BLE-Sensor] Disconnect reason: 0x%02X\n", reason);
     Serial.println("========================================");
     _parent->_connected = false;
+    _parent->_mtu = config::ble_sensor::BLE_DEFAULT_ATT_MTU;
 
     if (_parent->_onDisconnected) {
         _parent->_onDisconnected();
@@ -316,4 +379,9 @@ void BluetoothSensorMode::ServerCallbacks::onDisconnect(NimBLEServer* server, Ni
     Serial.println("[BLE-Sensor] Restarting advertising...");
     _parent->startAdvertising();
 }
+
+void BluetoothSensorMode::ServerCallbacks::onMTUChange(uint16_t MTU, NimBLEConnInfo& connInfo) {
+    Serial.printf("[BLE-Sensor] MTU changed: %d\n", MTU);
+    _parent->_mtu = MTU;
+}
 #endif
@@ -50,6 +50,10 @@ bool ConfigManager::saveConfig(const StoredConfig& config) {
     String savedPw = preferences.getString(KEY_WIFI_PASS, "");
     Serial.printf("[Config] Password saved: %d chars (verify: %d chars)\n",
                   config.wifiPassword.length(), savedPw.length());
+#else
+    // The host network needs no WiFi credentials: any saved config is complete
+    _simulated = config;
+    _simulated.isValid = true;
 #endif
 
     Serial.printf("[Config] Saved configuration: NodeID=%s, SSID=%s, TargetMode=%s\n",
@@ -123,8 +127,13 @@ StoredConfig ConfigManager::loadConfig() {
         Serial.println("[Config] No stored configuration found");
     }
 #else
-    Serial.println("[Config] Simulated load - no config");
-    config.isValid = false;
+    config = _simulated;
+    if (config.isValid) {
+        Serial.printf("[Config] Simulated load: NodeID=%s, HubURL=%s\n",
+                      config.nodeId.c_str(), config.hubApiUrl.c_str());
+    } else {
+        Serial.println("[Config] Simulated load - no config");
+    }
 #endif
 
     return config;
@@ -134,7 +143,7 @@ bool ConfigManager::hasConfig() {
 #ifdef PLATFORM_ESP32
     return _initialized && preferences.getBool(KEY_CONFIGURED, false);
 #else
-    return false;
+    return _initialized && _simulated.isValid;
 #endif
 }
 
@@ -145,6 +154,8 @@ bool ConfigManager::clearConfig() {
 
 #ifdef PLATFORM_ESP32
     preferences.clear();
+#else
+    _simulated = StoredConfig();
 #endif
 
     Serial.println("[Config] Configuration cleared");
@@ -0,0 +1,322 @@
+/**
+ * myIoTGrid.Sensor - Control Channel Implementation
+ */
+
+#include "control_channel.h"
+#include "config.h"
+#include "debug_manager.h"
+#include "memory_telemetry.h"
+#include "session_trace.h"
+#include <ArduinoJson.h>
+
+#ifdef PLATFORM_ESP32
+#include <HTTPClient.h>
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+#elif defined(PLATFORM_NATIVE)
+#include "ArduinoJsonString.h"
+#include "http_transport.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#endif
+
+namespace {
+
+// Request timeout: the Hub's wait plus headroom for the answer
+const uint32_t POLL_TIMEOUT_MS = (config::CONTROL_PUSH_WAIT_SECONDS + 10) * 1000UL;
+
+#ifdef PLATFORM_ESP32
+/**
+ * True if the internal heap holds a TLS session for the long-poll and
+ * another one for ApiClient
+ */
+bool hasTlsHeadroom() {
+    HeapStats internal;
+    if (!MemoryTelemetry::getInstance().read(HeapCapability::INTERNAL, internal)) {
+        return true;
+    }
+    return internal.freeBytes >= 2 * config::CONTROL_PUSH_TLS_SESSION_BYTES &&
+           internal.largestFreeBlock >= config::CONTROL_PUSH_TLS_MIN_BLOCK_BYTES;
+}
+#endif
+
+} // namespace
+
+ControlChannel::ControlChannel()
+    : _hasState(false)
+#ifdef PLATFORM_ESP32
+    , _mutex(nullptr)
+    , _worker(nullptr)
+    , _enabled(false)
+    , _active(false)
+#elif defined(PLATFORM_NATIVE)
+    , _enabled(false)
+    , _active(false)
+    , _shutdown(false)
+#else
+    , _enabled(false)
+    , _active(false)
+#endif
+{
+    _state.debugLevel = 1;
+    _state.enableRemoteLogging = false;
+}
+
+ControlChannel::~ControlChannel() {
+#ifdef PLATFORM_NATIVE
+    _shutdown = true;
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+#endif
+}
+
+void ControlChannel::begin(const String& baseUrl, const String& serialNumber) {
+    // Session traces cover the main loop only: config changes then arrive by
+    // heartbeat-driven polling, which records and replays deterministically
+    if (SessionTrace::getInstance().isActive()) {
+        return;
+    }
+
+    String url = baseUrl;
+    if (url.endsWith("/")) {
+        url.remove(url.length() - 1);
+    }
+    url += "/api/nodes/" + serialNumber + "/control?wait=" + String(config::CONTROL_PUSH_WAIT_SECONDS);
+
+#ifdef PLATFORM_ESP32
+    if (!_mutex) {
+        _mutex = xSemaphoreCreateMutex();
+    }
+#endif
+
+    lock();
+    if (_url != url) {
+        _url = url;
+        _etag = "";  // New target: first answer is the full state
+    }
+    unlock();
+    _enabled = true;
+
+#ifdef PLATFORM_ESP32
+    if (!_worker &&
+        xTaskCreate(workerTask, "control_push", config::CONTROL_PUSH_TASK_STACK_SIZE,
+                    this, 1, &_worker) != pdPASS) {
+        _worker = nullptr;
+        _enabled = false;
+        Serial.println("[Control] Push task not started - staying on polling");
+        return;
+    }
+#elif defined(PLATFORM_NATIVE)
+    if (!_worker.joinable()) {
+        _worker = std::thread(&ControlChannel::run, this);
+    }
+#endif
+
+    Serial.printf("[Control] Push channel: %s\n", url.c_str());
+}
+
+void ControlChannel::stop() {
+    _enabled = false;
+    _active = false;
+}
+
+bool ControlChannel::takeState(ControlState& state) {
+    lock();
+    bool hasState = _hasState;
+    if (hasState) {
+        state = _state;
+        _hasState = false;
+    }
+    unlock();
+    return hasState;
+}
+
+void ControlChannel::run() {
+    bool lowMemory = false;
+
+    for (;;) {
+#ifdef PLATFORM_NATIVE
+        if (_shutdown) {
+            return;
+        }
+#endif
+#ifdef PLATFORM_ESP32
+        if (!_enabled || WiFi.status() != WL_CONNECTED) {
+#else
+        if (!_enabled) {
+#endif
+            _active = false;
+            sleepMs(1000);
+            continue;
+        }
+
+        lock();
+        String url = _url;
+        String ifNoneMatch = _etag;
+        unlock();
+
+        String etag;
+        String body;
+        PollResult result = poll(url, ifNoneMatch, etag, body);
+
+        if (result == PollResult::LOW_MEMORY) {
+            if (!lowMemory) {
+                Serial.println("[Control] Heap too low for a second TLS session - polling until it recovers");
+                lowMemory = true;
+            }
+            _active = false;
+            sleepMs(config::CONTROL_PUSH_RETRY_DELAY_MS);
+            continue;
+        }
+        lowMemory = false;
+
+        if (result == PollResult::CHANGED) {
+            JsonDocument doc;
+            if (deserializeJson(doc, body)) {
+                Serial.println("[Control] Invalid state from Hub");
+                _active = false;
+                sleepMs(config::CONTROL_PUSH_RETRY_DELAY_MS);
+                continue;
+            }
+
+            ControlState state;
+            state.configurationVersion = doc["configurationVersion"] | "";
+            state.debugLevel = static_cast<int>(DebugManager::parseLevel(doc["debugLevel"].as<String>()));
+            state.enableRemoteLogging = doc["enableRemoteLogging"] | false;
+
+            lock();
+            if (_url == url) {
+                _state = state;
+                _hasState = true;
+                _etag = etag;
+            }
+            unlock();
+            _active = true;
+        } else if (result == PollResult::NOT_MODIFIED) {
+            _active = true;
+        } else if (result == PollResult::NOT_SUPPORTED) {
+            Serial.println("[Control] Hub has no control endpoint - staying on polling");
+            stop();
+        } else {
+            _active = false;
+            sleepMs(config::CONTROL_PUSH_RETRY_DELAY_MS);
+        }
+    }
+}
+
+ControlChannel::PollResult ControlChannel::poll(const String& url, const String& ifNoneMatch,
+                                                String& etag, String& body) {
+#ifdef PLATFORM_ESP32
+    HTTPClient http;
+    WiFiClient plainClient;
+    WiFiClientSecure secureClient;
+
+    if (url.startsWith("https://")) {
+        if (!hasTlsHeadroom()) {
+            return PollResult::LOW_MEMORY;
+        }
+        secureClient.setInsecure();  // Same policy as ApiClient
+        http.begin(secureClient, url);
+    } else {
+        http.begin(plainClient, url);
+    }
+
+    http.setTimeout(POLL_TIMEOUT_MS);
+    static const char* etagHeader[] = {"ETag"};
+    http.collectHeaders(etagHeader, 1);
+    if (ifNoneMatch.length() > 0) {
+        http.addHeader("If-None-Match", ifNoneMatch);
+    }
+
+    int httpCode = http.GET();
+    PollResult result = PollResult::FAILED;
+    if (httpCode == 200) {
+        body = http.getString();
+        etag = http.header("ETag");
+        result = PollResult::CHANGED;
+    } else if (httpCode == 304) {
+        result = PollResult::NOT_MODIFIED;
+    } else if (httpCode == 404) {
+        result = PollResult::NOT_SUPPORTED;
+    }
+    http.end();
+    return result;
+
+#elif defined(PLATFORM_NATIVE)
+    // Long-poll as one more transfer on the shared transport
+    hal::native::HttpRequest request;
+    request.method = "GET";
+    request.url = url.c_str();
+    request.timeoutMs = POLL_TIMEOUT_MS;
+    if (ifNoneMatch.length() > 0) {
+        request.headers.push_back(std::string("If-None-Match: ") + ifNoneMatch.c_str());
+    }
+
+    // Allow self-signed certificates (for development)
+    const char* insecure = std::getenv("HUB_INSECURE");
+    request.insecure = insecure && strcmp(insecure, "true") == 0;
+
+    hal::native::HttpResult response = hal::native::HttpTransport::instance().perform(std::move(request));
+
+    PollResult result = PollResult::FAILED;
+    if (response.success) {
+        if (response.statusCode == 200) {
+            body = String(response.body.c_str());
+            etag = String(response.etag.c_str());
+            result = PollResult::CHANGED;
+        } else if (response.statusCode == 304) {
+            result = PollResult::NOT_MODIFIED;
+        } else if (response.statusCode == 404) {
+            result = PollResult::NOT_SUPPORTED;
+        }
+    }
+    return result;
+
+#else
+    (void)url;
+    (void)ifNoneMatch;
+    (void)etag;
+    (void)body;
+    return PollResult::NOT_SUPPORTED;
+#endif
+}
+
+void ControlChannel::lock() {
+#ifdef PLATFORM_ESP32
+    if (_mutex) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+    }
+#elif defined(PLATFORM_NATIVE)
+    _mutex.lock();
+#endif
+}
+
+void ControlChannel::unlock() {
+#ifdef PLATFORM_ESP32
+    if (_mutex) {
+        xSemaphoreGive(_mutex);
+    }
+#elif defined(PLATFORM_NATIVE)
+    _mutex.unlock();
+#endif
+}
+
+void ControlChannel::sleepMs(uint32_t ms) {
+#ifdef PLATFORM_ESP32
+    vTaskDelay(pdMS_TO_TICKS(ms));
+#elif defined(PLATFORM_NATIVE)
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#else
+    (void)ms;
+#endif
+}
+
+#ifdef PLATFORM_ESP32
+void ControlChannel::workerTask(void* param) {
+    static_cast<ControlChannel*>(param)->run();
+}
+#endif
@@ -8,7 +8,8 @@
 
 #include "debug_log_uploader.h"
 #include "serial_capture.h"
-#include <ArduinoJson.h>
+#include "lz4_block.h"
+#include <string.h>
 
 #ifdef PLATFORM_ESP32
 #include <HTTPClient.h>
@@ -20,6 +21,26 @@
 extern const char* rootCACertificate;  // Defined in api_client.cpp
 #endif
 
+namespace {
+
+const char CHUNK_MAGIC[4] = { 'M', 'L', 'G', '1' };
+const size_t CHUNK_HEADER_SIZE = 28;
+const uint8_t CHUNK_FLAG_LZ4 = 0x01;
+
+inline void putLE16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+inline void putLE32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+} // namespace
+
 // Singleton instance
 DebugLogUploader& DebugLogUploader::getInstance() {
     static DebugLogUploader instance;
@@ -30,7 +51,19 @@ DebugLogUploader::DebugLogUploader()
     : _enabled(false)
     , _initialized(false)
     , _lastUploadTime(0)
-    , _currentRetry(0) {
+    , _currentRetry(0)
+    , _rawChunk(nullptr)
+    , _pendingChunk(nullptr)
+    , _hashTable(nullptr)
+    , _pendingLength(0)
+    , _pendingLines(0)
+    , _sequence(0)
+#ifdef PLATFORM_ESP32
+    , _client(nullptr)
+    , _http(nullptr)
+    , _clientIsSecure(false)
+#endif
+{
 }
 
 void DebugLogUploader::begin(const String& baseUrl, const String& serialNumber) {
@@ -40,6 +73,13 @@ void DebugLogUploader::begin(const String& baseUrl, const String& serialNumber)
     _enabled = true;
     _lastUploadTime = millis();
 
+    // Chunk buffers are allocated once and never resized
+    if (!_rawChunk) {
+        _rawChunk = new uint8_t[config::DEBUG_UPLOAD_CHUNK_SIZE];
+        _pendingChunk = new uint8_t[CHUNK_HEADER_SIZE + config::DEBUG_UPLOAD_CHUNK_SIZE];
+        _hashTable = new uint16_t[1u << config::DEBUG_UPLOAD_HASH_BITS];
+    }
+
     // Initialize SerialCapture for remote serial monitor
     SerialCapture::getInstance().begin();
     SerialCapture::getInstance().setEnabled(true);
@@ -67,7 +107,7 @@ void DebugLogUploader::loop() {
     if (elapsed >= _config.uploadIntervalMs) {
         SerialCapture& capture = SerialCapture::getInstance();
 
-        if (capture.hasData()) {
+        if (_pendingLength > 0 || capture.hasData()) {
             uploadSerialLines();
         }
 
@@ -84,7 +124,7 @@ bool DebugLogUploader::uploadNow() {
     }
 
     SerialCapture& capture = SerialCapture::getInstance();
-    if (!capture.hasData()) {
+    if (_pendingLength == 0 && !capture.hasData()) {
         return true;  // Nothing to upload
     }
 
@@ -94,81 +134,132 @@ bool DebugLogUploader::uploadNow() {
 #endif
 }
 
-bool DebugLogUploader::uploadSerialLines() {
-#ifdef PLATFORM_ESP32
-    HTTPClient http;
+bool DebugLogUploader::encodeChunk() {
+    SerialCapture& capture = SerialCapture::getInstance();
+    _lineSlices.resize(_config.batchSize);
+    size_t count = capture.peekLines(_lineSlices.data(), _lineSlices.size());
+
+    // Copy length-prefixed lines straight from the ring slices
+    size_t rawLength = 0;
+    size_t lines = 0;
+    for (; lines < count; lines++) {
+        const SerialCaptureLine& line = _lineSlices[lines];
+        if (rawLength + 2 + line.length > config::DEBUG_UPLOAD_CHUNK_SIZE) break;
+        putLE16(_rawChunk + rawLength, (uint16_t)line.length);
+        memcpy(_rawChunk + rawLength + 2, line.data, line.length);
+        rawLength += 2 + line.length;
+    }
+    capture.consumeLines(lines);
+
+    if (lines == 0) return false;
+
+    // Keep the compressed form only if it is actually smaller
+    uint8_t* payload = _pendingChunk + CHUNK_HEADER_SIZE;
+    size_t payloadLength = lz4CompressBlock(_rawChunk, rawLength, payload, rawLength - 1,
+                                            _hashTable, config::DEBUG_UPLOAD_HASH_BITS);
+    uint8_t flags = CHUNK_FLAG_LZ4;
+    if (payloadLength == 0) {
+        memcpy(payload, _rawChunk, rawLength);
+        payloadLength = rawLength;
+        flags = 0;
+    }
 
-    String url = _baseUrl + "/api/node-debug/serial-output";
-    bool isHttps = url.startsWith("https://");
+    uint8_t* header = _pendingChunk;
+    memcpy(header, CHUNK_MAGIC, 4);
+    putLE32(header + 4, _sequence);
+    putLE32(header + 8, (uint32_t)millis());
+    putLE32(header + 12, capture.getDroppedLines());
+    putLE16(header + 16, (uint16_t)lines);
+    header[18] = flags;
+    header[19] = 0;
+    putLE32(header + 20, (uint32_t)rawLength);
+    putLE32(header + 24, (uint32_t)payloadLength);
+
+    _pendingLength = CHUNK_HEADER_SIZE + payloadLength;
+    _pendingLines = lines;
+    _stats.rawBytes += rawLength;
+    return true;
+}
 
-    // Handle HTTPS vs HTTP connections
-    if (isHttps) {
-        WiFiClientSecure secureClient;
-        secureClient.setInsecure();  // Skip certificate validation
-        http.begin(secureClient, url);
+void DebugLogUploader::completeChunk(bool delivered) {
+    if (delivered) {
+        _stats.entriesUploaded += _pendingLines;
+        _stats.chunksSent++;
+        _stats.sentBytes += _pendingLength;
+        _stats.lastUploadTime = millis();
     } else {
-        WiFiClient plainClient;
-        http.begin(plainClient, url);
+        _stats.entriesDropped += _pendingLines;
+        _stats.chunksDropped++;
     }
+    _pendingLength = 0;
+    _pendingLines = 0;
+    _sequence++;
+    _currentRetry = 0;
+}
 
-    http.setTimeout(10000);
-    http.addHeader("Content-Type", "application/json");
+bool DebugLogUploader::uploadSerialLines() {
+    if (!_rawChunk) return false;
 
-    if (_apiKey.length() > 0) {
-        http.addHeader("Authorization", "Bearer " + _apiKey);
+    // A pending chunk is resent unchanged (same sequence) before new lines are packed
+    if (_pendingLength == 0 && !encodeChunk()) {
+        return true;
     }
 
-    // Get captured serial lines
-    std::vector<String> lines = SerialCapture::getInstance().getAndClearLines();
+#ifdef PLATFORM_ESP32
+    String url = _baseUrl + "/api/node-debug/by-serial/" + _serialNumber + "/serial-chunk";
+    bool isHttps = url.startsWith("https://");
 
-    if (lines.empty()) {
-        http.end();
-        return true;
+    if (_client && _clientIsSecure != isHttps) {
+        _http->end();
+        delete _client;
+        _client = nullptr;
     }
-
-    // Build payload with raw lines
-    JsonDocument doc;
-    doc["serialNumber"] = _serialNumber;
-    doc["timestamp"] = millis();
-
-    JsonArray linesArray = doc["lines"].to<JsonArray>();
-    int count = 0;
-    for (const auto& line : lines) {
-        if (count >= _config.batchSize) break;
-        linesArray.add(line);
-        count++;
+    if (!_client) {
+        if (isHttps) {
+            WiFiClientSecure* secureClient = new WiFiClientSecure();
+            secureClient->setInsecure();  // Skip certificate validation
+            _client = secureClient;
+        } else {
+            _client = new WiFiClient();
+        }
+        _clientIsSecure = isHttps;
+    }
+    if (!_http) {
+        _http = new HTTPClient();
+        _http->setReuse(true);  // Keep-alive: no new TLS handshake per interval
     }
 
-    String payload;
-    serializeJson(doc, payload);
+    HTTPClient& http = *_http;
+    http.begin(*_client, url);
+    http.setTimeout(10000);
+    http.addHeader("Content-Type", "application/octet-stream");
+
+    if (_apiKey.length() > 0) {
+        http.addHeader("Authorization", "Bearer " + _apiKey);
+    }
 
     _stats.uploadAttempts++;
 
-    int httpCode = http.POST(payload);
+    int httpCode = http.POST(_pendingChunk, _pendingLength);
     bool success = (httpCode >= 200 && httpCode < 300);
 
     if (success) {
-        _stats.entriesUploaded += count;
-        _stats.lastUploadTime = millis();
-        _currentRetry = 0;
+        completeChunk(true);
     } else {
         _stats.uploadFailures++;
         _currentRetry++;
 
-        // On failure, lines are lost (they were already cleared from capture)
-        // This is acceptable for a serial monitor - we prioritize not blocking
-        _stats.entriesDropped += count;
-
+        // Give up after maxRetries; the skipped sequence shows up as a gap on the Hub
         if (_currentRetry >= _config.maxRetries) {
-            _currentRetry = 0;
+            completeChunk(false);
         }
     }
 
-    http.end();
+    http.end();  // Connection stays open for reuse
     return success;
 #else
-    // Native simulation
-    SerialCapture::getInstance().getAndClearLines();
+    // Native simulation: chunk is encoded but not sent
+    completeChunk(true);
     return true;
 #endif
 }
@@ -184,6 +275,9 @@ String DebugLogUploader::buildUploadPayload() {
 }
 
 void DebugLogUploader::clearQueue() {
-    SerialCapture::getInstance().getAndClearLines();
+    SerialCapture::getInstance().clear();
+    _pendingLength = 0;
+    _pendingLines = 0;
+    _currentRetry = 0;
     Serial.println("[RemoteSerial] Buffer cleared");
 }
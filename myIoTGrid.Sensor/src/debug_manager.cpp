@@ -4,6 +4,7 @@
  */
 
 #include "debug_manager.h"
+#include <string.h>
 
 #ifdef PLATFORM_ESP32
 #include <Preferences.h>
@@ -21,7 +22,16 @@ DebugManager::DebugManager()
     , _enabledCategories(0xFF)  // All categories enabled by default
     , _logCount(0)
     , _errorCount(0)
-    , _totalLoggingTimeUs(0) {
+    , _totalLoggingTimeUs(0)
+    , _formattingTimeUs(0)
+    , _deferredHead(0)
+    , _deferredCount(0)
+    , _deferredDropped(0)
+    , _deferredDropsReported(0) {
+#ifdef PLATFORM_ESP32
+    portMUX_INITIALIZE(&_deferredMux);
+    _outputMutex = xSemaphoreCreateRecursiveMutex();
+#endif
 }
 
 void DebugManager::begin() {
@@ -82,24 +92,9 @@ bool DebugManager::shouldLog(LogCategory category) const {
         return false;
     }
 
-    // Level-based filtering
-    switch (_level) {
-        case DebugLevel::PRODUCTION:
-            // Only errors in production
-            return false;
-
-        case DebugLevel::NORMAL:
-            // System, Network, API, Error, and Storage (important subsystems)
-            return category == LogCategory::SYSTEM ||
-                   category == LogCategory::NETWORK ||
-                   category == LogCategory::API ||
-                   category == LogCategory::STORAGE;
-
-        case DebugLevel::DEBUG:
-            // Everything
-            return true;
-    }
-    return false;
+    // Level-based filtering: PRODUCTION = errors only, NORMAL = System, Network,
+    // API and Storage (important subsystems), DEBUG = everything
+    return static_cast<uint8_t>(_level) >= static_cast<uint8_t>(categoryMinLevel(category));
 }
 
 bool DebugManager::shouldLog(DebugLevel minLevel) const {
@@ -187,7 +182,7 @@ void DebugManager::logError(const char* format, ...) {
     va_start(args, format);
     logInternal(LogCategory::ERROR, DebugLevel::PRODUCTION, format, args);
     va_end(args);
-    _errorCount++;
+    _errorCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 void DebugManager::logDebug(LogCategory category, const char* format, ...) {
@@ -202,29 +197,206 @@ void DebugManager::logInternal(LogCategory category, DebugLevel minLevel, const
     unsigned long startTime = micros();
 
     // Format the message
+    lockOutput();
     vsnprintf(_logBuffer, LOG_BUFFER_SIZE, format, args);
+    emit(category, minLevel, millis(), _logBuffer);
+    unlockOutput();
 
-    // Get category prefix
-    const char* prefix = categoryToString(category);
+    // Track overhead
+    _totalLoggingTimeUs.fetch_add(micros() - startTime, std::memory_order_relaxed);
+}
 
+void DebugManager::emit(LogCategory category, DebugLevel minLevel, unsigned long timestamp, const char* message) {
     // Print to Serial
-    Serial.printf("[%s] %s\n", prefix, _logBuffer);
+    Serial.printf("[%s] %s\n", categoryToString(category), message);
 
     // Increment log count
-    _logCount++;
+    _logCount.fetch_add(1, std::memory_order_relaxed);
 
     // Create log entry and notify callbacks (for SD logger, Hub upload)
     if (_remoteLoggingEnabled && !_callbacks.empty()) {
         LogEntry entry;
-        entry.timestamp = millis();
+        entry.timestamp = timestamp;
         entry.level = minLevel;
         entry.category = category;
-        entry.message = String(_logBuffer);
+        entry.message = String(message);
         notifyCallbacks(entry);
     }
+}
 
-    // Track overhead
-    _totalLoggingTimeUs += (micros() - startTime);
+// ============================================================================
+// Deferred Logging
+// ============================================================================
+
+uint8_t DebugManager::copyDeferredString(DeferredLogRecord& record, const char* str) {
+    if (!str) str = "(null)";
+
+    // Always leave room for an empty string at the end of the area
+    size_t offset = record.stringLength;
+    size_t room = config::DEBUG_DEFERRED_LOG_STRING_BYTES - offset;
+    if (room <= 1) return (uint8_t)(config::DEBUG_DEFERRED_LOG_STRING_BYTES - 1);
+
+    size_t length = strnlen(str, room - 1);
+    memcpy(record.strings + offset, str, length);
+    record.strings[offset + length] = '\0';
+    record.stringLength = (uint8_t)(offset + length + 1);
+    return (uint8_t)offset;
+}
+
+void DebugManager::pushDeferred(const DeferredLogRecord& record) {
+#ifdef PLATFORM_ESP32
+    taskENTER_CRITICAL(&_deferredMux);
+#endif
+    if (_deferredCount < config::DEBUG_DEFERRED_LOG_SLOTS) {
+        size_t slot = (_deferredHead + _deferredCount) % config::DEBUG_DEFERRED_LOG_SLOTS;
+        _deferred[slot] = record;
+        _deferredCount++;
+    } else {
+        // Newest record is dropped; the hot path never waits for formatting
+        _deferredDropped++;
+    }
+#ifdef PLATFORM_ESP32
+    taskEXIT_CRITICAL(&_deferredMux);
+#endif
+}
+
+size_t DebugManager::processDeferred(size_t maxRecords) {
+    if (maxRecords == 0) maxRecords = config::DEBUG_DEFERRED_LOG_SLOTS;
+
+    size_t processed = 0;
+    DeferredLogRecord record;
+
+    while (processed < maxRecords) {
+#ifdef PLATFORM_ESP32
+        taskENTER_CRITICAL(&_deferredMux);
+#endif
+        bool available = _deferredCount > 0;
+        if (available) {
+            record = _deferred[_deferredHead];
+            _deferredHead = (_deferredHead + 1) % config::DEBUG_DEFERRED_LOG_SLOTS;
+            _deferredCount--;
+        }
+#ifdef PLATFORM_ESP32
+        taskEXIT_CRITICAL(&_deferredMux);
+#endif
+        if (!available) break;
+
+        unsigned long startTime = micros();
+        lockOutput();
+        formatDeferred(record, _logBuffer, LOG_BUFFER_SIZE);
+        emit(record.category, categoryMinLevel(record.category), record.timestamp, _logBuffer);
+        unlockOutput();
+        _formattingTimeUs += (micros() - startTime);
+        processed++;
+    }
+
+    if (_deferredDropped != _deferredDropsReported) {
+        Serial.printf("[Debug] %u deferred log records dropped\n",
+                      (unsigned)(_deferredDropped - _deferredDropsReported));
+        _deferredDropsReported = _deferredDropped;
+    }
+    return processed;
+}
+
+size_t DebugManager::formatDeferred(const DeferredLogRecord& record, char* out, size_t size) {
+    if (size == 0) return 0;
+
+    size_t pos = 0;
+    uint8_t argIndex = 0;
+    const char* p = record.format;
+    char spec[20];
+
+    while (*p && pos + 1 < size) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Keep flags/width/precision, drop the length modifier (arguments are widened)
+        const char* specStart = p;
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && specLength < sizeof(spec) - 4) {
+            spec[specLength++] = *p++;
+        }
+        while (*p && strchr("hlLzjt", *p)) p++;
+        char conversion = *p;
+        if (!conversion) break;
+        p++;
+
+        if (argIndex >= record.argCount || !strchr("diuxXocfFeEgGaAsp", conversion)) {
+            // Unsupported specifier or missing argument: copy it verbatim
+            size_t length = (size_t)(p - specStart);
+            if (length > size - 1 - pos) length = size - 1 - pos;
+            memcpy(out + pos, specStart, length);
+            pos += length;
+            continue;
+        }
+
+        uint8_t type = record.argTypes[argIndex];
+        const DeferredLogRecord::Arg& arg = record.args[argIndex];
+        argIndex++;
+
+        int64_t asSigned = type == DeferredLogRecord::ARG_DOUBLE ? (int64_t)arg.d :
+                           type == DeferredLogRecord::ARG_UINT ? (int64_t)arg.u : arg.i;
+        int written = 0;
+        switch (conversion) {
+            case 'd':
+            case 'i':
+                memcpy(spec + specLength, "lld", 4);
+                written = snprintf(out + pos, size - pos, spec, (long long)asSigned);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o': {
+                // Negative 32-bit values print like the original 32-bit argument
+                uint64_t asUnsigned = type == DeferredLogRecord::ARG_UINT ? arg.u :
+                                      (asSigned < 0 && asSigned >= INT32_MIN) ? (uint32_t)asSigned :
+                                      (uint64_t)asSigned;
+                spec[specLength] = 'l';
+                spec[specLength + 1] = 'l';
+                spec[specLength + 2] = conversion;
+                spec[specLength + 3] = '\0';
+                written = snprintf(out + pos, size - pos, spec, (unsigned long long)asUnsigned);
+                break;
+            }
+            case 'c':
+                memcpy(spec + specLength, "c", 2);
+                written = snprintf(out + pos, size - pos, spec, (int)asSigned);
+                break;
+            case 's':
+                memcpy(spec + specLength, "s", 2);
+                written = snprintf(out + pos, size - pos, spec,
+                                   type == DeferredLogRecord::ARG_STRING ? record.strings + arg.str : "?");
+                break;
+            case 'p':
+                memcpy(spec + specLength, "p", 2);
+                written = snprintf(out + pos, size - pos, spec,
+                                   type == DeferredLogRecord::ARG_POINTER ? arg.p : nullptr);
+                break;
+            default: {
+                double value = type == DeferredLogRecord::ARG_DOUBLE ? arg.d :
+                               type == DeferredLogRecord::ARG_UINT ? (double)arg.u : (double)arg.i;
+                spec[specLength] = conversion;
+                spec[specLength + 1] = '\0';
+                written = snprintf(out + pos, size - pos, spec, value);
+                break;
+            }
+        }
+
+        if (written > 0) {
+            pos += ((size_t)written < size - pos) ? (size_t)written : size - 1 - pos;
+        }
+    }
+
+    out[pos] = '\0';
+    return pos;
 }
 
 void DebugManager::onLog(LogCallback callback) {
@@ -251,6 +423,26 @@ const char* DebugManager::categoryToString(LogCategory category) {
     }
 }
 
+void DebugManager::lockOutput() {
+#ifdef PLATFORM_ESP32
+    if (_outputMutex) {
+        xSemaphoreTakeRecursive(_outputMutex, portMAX_DELAY);
+    }
+#elif defined(PLATFORM_NATIVE)
+    _outputMutex.lock();
+#endif
+}
+
+void DebugManager::unlockOutput() {
+#ifdef PLATFORM_ESP32
+    if (_outputMutex) {
+        xSemaphoreGiveRecursive(_outputMutex);
+    }
+#elif defined(PLATFORM_NATIVE)
+    _outputMutex.unlock();
+#endif
+}
+
 void DebugManager::resetStatistics() {
     _logCount = 0;
     _errorCount = 0;
@@ -258,6 +450,7 @@ void DebugManager::resetStatistics() {
 
 void DebugManager::resetOverheadMeasurement() {
     _totalLoggingTimeUs = 0;
+    _formattingTimeUs = 0;
 }
 
 void DebugManager::saveToNVS() {
@@ -1,4 +1,5 @@
 #include "discovery_client.h"
+#include "session_trace.h"
 #include <ArduinoJson.h>
 
 #ifdef PLATFORM_NATIVE
@@ -54,6 +55,20 @@ String DiscoveryClient::buildRequestJson(const String& serial,
     return json;
 }
 
+String DiscoveryClient::buildResponseJson(const DiscoveryResponse& response) {
+    JsonDocument doc;
+    doc["messageType"] = HUB_MSG_TYPE;
+    doc["hubId"] = response.hubId.c_str();
+    doc["hubName"] = response.hubName.c_str();
+    doc["apiUrl"] = response.apiUrl.c_str();
+    doc["apiVersion"] = response.apiVersion.c_str();
+    doc["protocolVersion"] = response.protocolVersion.c_str();
+
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
 DiscoveryResponse DiscoveryClient::parseResponse(const String& json) {
     DiscoveryResponse response;
     response.success = false;
@@ -99,18 +114,43 @@ DiscoveryResponse DiscoveryClient::discover(const String& serial,
         return response;
     }
 
+    // Session replay answers with the recorded Hub response
+    SessionTrace& trace = SessionTrace::getInstance();
+    TraceExchange exchange;
+    if (trace.replayExchange("UDP", "discover", exchange)) {
+        if (exchange.success) {
+            return parseResponse(exchange.body);
+        }
+        DiscoveryResponse response;
+        response.success = false;
+        response.errorMessage = exchange.error;
+        _lastError = response.errorMessage;
+        return response;
+    }
+
     String requestJson = buildRequestJson(serial, firmwareVersion, hardwareType);
+    unsigned long requestStart = millis();
 
+    DiscoveryResponse response;
 #ifdef PLATFORM_NATIVE
-    return discoverNative(requestJson);
+    response = discoverNative(requestJson);
 #elif defined(PLATFORM_ESP32)
-    return discoverESP32(requestJson);
+    response = discoverESP32(requestJson);
 #else
-    DiscoveryResponse response;
     response.success = false;
     response.errorMessage = "No discovery implementation for this platform";
-    return response;
 #endif
+
+    if (trace.isRecording()) {
+        exchange.success = response.success;
+        exchange.error = response.errorMessage;
+        exchange.latencyMs = millis() - requestStart;
+        if (response.success) {
+            exchange.body = buildResponseJson(response);
+        }
+        trace.recordExchange("UDP", "discover", exchange);
+    }
+    return response;
 }
 
 // ============================================================================
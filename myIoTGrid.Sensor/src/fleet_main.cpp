@@ -0,0 +1,93 @@
+/**
+ * myIoTGrid.Sensor - Fleet Simulator Entry Point
+ * Runs N virtual nodes in one native process (pio run -e native_fleet)
+ *
+ * Environment:
+ *   FLEET_NODES, FLEET_THREADS, FLEET_RAMP_UP_SECONDS, FLEET_DURATION_SECONDS,
+ *   FLEET_REPORT_SECONDS, FLEET_ID, LOG_LEVEL (0-3, default 1),
+ *   FLEET_SIM_MODELS (e.g. "weather;faulty,gaps_per_day=20"), SIM_SEED
+ *   plus the regular HUB_HOST / HUB_PORT / HUB_PROTOCOL / DATA_DIR
+ */
+
+#if defined(PLATFORM_NATIVE) && defined(FLEET_SIMULATOR)
+
+#include "fleet_simulator.h"
+#include "hal/hal.h"
+#include "config.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+fleet::FleetSimulator* activeFleet = nullptr;
+
+void handleSignal(int) {
+    if (activeFleet) {
+        activeFleet->stop();
+    }
+}
+
+unsigned long envNumber(const char* name, unsigned long defaultValue) {
+    std::string value = hal::get_env(name);
+    return value.empty() ? defaultValue : std::strtoul(value.c_str(), nullptr, 10);
+}
+
+// "spec;spec;..." -> profiles; prints the error and returns false if one is invalid
+bool parseSignalProfiles(const char* variable, const std::string& specs,
+                         std::vector<sensor::SignalProfile>& profiles) {
+    size_t start = 0;
+    while (start < specs.size()) {
+        size_t end = specs.find(';', start);
+        if (end == std::string::npos) {
+            end = specs.size();
+        }
+
+        sensor::SignalProfile profile;
+        std::string error;
+        if (!sensor::SignalProfile::parse(specs.substr(start, end - start), profile, error)) {
+            std::fprintf(stderr, "[Fleet] Invalid %s: %s\n", variable, error.c_str());
+            return false;
+        }
+        profiles.push_back(profile);
+        start = end + 1;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main() {
+    // Per-node INFO lines from thousands of nodes drown the report
+    hal::log_set_level(static_cast<int>(envNumber(config::ENV_LOG_LEVEL, 1)));
+
+    fleet::FleetOptions options;
+    options.nodeCount = envNumber(config::ENV_FLEET_NODES, options.nodeCount);
+    options.threadCount = envNumber(config::ENV_FLEET_THREADS, options.threadCount);
+    options.rampUpSeconds = envNumber(config::ENV_FLEET_RAMP_UP_SECONDS, options.rampUpSeconds);
+    options.durationSeconds = envNumber(config::ENV_FLEET_DURATION_SECONDS, options.durationSeconds);
+    options.reportSeconds = envNumber(config::ENV_FLEET_REPORT_SECONDS, options.reportSeconds);
+    options.fleetId = hal::get_env(config::ENV_FLEET_ID, options.fleetId);
+    if (!parseSignalProfiles(config::ENV_FLEET_SIM_MODELS, hal::get_env(config::ENV_FLEET_SIM_MODELS),
+                             options.signalProfiles)) {
+        return 1;
+    }
+    // Nodes fall back to SIM_MODEL and refuse to start with an invalid one
+    std::vector<sensor::SignalProfile> simModel;
+    if (options.signalProfiles.empty() &&
+        !parseSignalProfiles(config::ENV_SIM_MODEL, hal::get_env(config::ENV_SIM_MODEL), simModel)) {
+        return 1;
+    }
+
+    fleet::FleetSimulator simulator(options);
+    activeFleet = &simulator;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    simulator.run();
+
+    activeFleet = nullptr;
+    return 0;
+}
+
+#endif // PLATFORM_NATIVE && FLEET_SIMULATOR
@@ -350,19 +350,11 @@ std::vector<DetectedDevice> HardwareScanner::scanUART(int rxPin, int txPin, int
 
     Serial.printf("[UART] Scanning RX=%d, TX=%d at %d baud...\n", rxPin, txPin, baudRate);
 
-    // Use UARTManager to allocate UART dynamically
-    UARTManager& uartMgr = UARTManager::getInstance();
-    int uartNum = uartMgr.allocate(rxPin, txPin, baudRate, "GPS_SCAN", false);  // Arduino API
-
-    if (uartNum < 0) {
-        Serial.println("[UART] Failed to allocate UART for GPS scan!");
-        return devices;
-    }
-
-    HardwareSerial* gpsSerial = uartMgr.getSerial(uartNum);
+    // Temporary lease, or a tap if the pins are already leased
+    UARTProbe probe(UARTOwner::GPS_SCAN, rxPin, txPin, baudRate);
+    UARTRxBuffer* gpsSerial = probe.rx();
     if (!gpsSerial) {
-        Serial.println("[UART] Failed to get serial for GPS scan!");
-        uartMgr.release(uartNum);
+        Serial.println("[UART] Failed to get UART for GPS scan!");
         return devices;
     }
 
@@ -395,9 +387,6 @@ std::vector<DetectedDevice> HardwareScanner::scanUART(int rxPin, int txPin, int
         delay(10);
     }
 
-    // Release UART allocation after scan
-    uartMgr.releaseByOwner("GPS_SCAN");
-
     if (foundNMEA) {
         DetectedDevice device;
         device.bus = "UART";
@@ -430,34 +419,23 @@ std::vector<DetectedDevice> HardwareScanner::scanSR04M2(int rxPin, int txPin, in
     Serial.printf("[SR04M-2] Scanning UART for SR04M-2 on RX=%d, TX=%s (%d baud, RX-only=%s)...\n",
                   rxPin, txPin < 0 ? "none" : String(txPin).c_str(), actualBaudRate, rxOnlyMode ? "yes" : "no");
 
-    // Use UARTManager to allocate UART dynamically
-    UARTManager& uartMgr = UARTManager::getInstance();
-    int uartNum = uartMgr.allocate(rxPin, txPin, actualBaudRate, "SR04M2_SCAN", false);  // Arduino API
-
-    if (uartNum < 0) {
-        Serial.println("[SR04M-2] Failed to allocate UART for SR04M-2 scan!");
-        return devices;
-    }
-
-    HardwareSerial* sr04Serial = uartMgr.getSerial(uartNum);
+    // Temporary lease, or a tap if the pins are already leased
+    UARTProbe probe(UARTOwner::SR04M2_SCAN, rxPin, txPin, actualBaudRate);
+    UARTRxBuffer* sr04Serial = probe.rx();
     if (!sr04Serial) {
-        Serial.println("[SR04M-2] Failed to get serial for SR04M-2 scan!");
-        uartMgr.release(uartNum);
+        Serial.println("[SR04M-2] Failed to get UART for SR04M-2 scan!");
         return devices;
     }
 
     delay(100);  // Allow serial to stabilize
 
     // Clear any pending data
-    while (sr04Serial->available()) {
-        sr04Serial->read();
-    }
+    sr04Serial->clear();
 
-    // Only send trigger command if TX is connected
+    // Only send trigger command if TX is connected (and we own the port)
     // SR04M-2 in auto-mode sends data continuously without trigger
-    if (!rxOnlyMode) {
-        sr04Serial->write(0x55);
-        sr04Serial->flush();
+    if (!rxOnlyMode && probe.lease()) {
+        probe.lease()->write(0x55);
     }
 
     // Wait for response and search for 0xFF 0xFE header (up to 500ms timeout)
@@ -481,7 +459,6 @@ std::vector<DetectedDevice> HardwareScanner::scanSR04M2(int rxPin, int txPin, in
 
     if (!foundHeader) {
         Serial.printf("[SR04M-2] No valid header found on RX=%d, TX=%s\n", rxPin, txPin < 0 ? "none" : String(txPin).c_str());
-        uartMgr.releaseByOwner("SR04M2_SCAN");
         return devices;
     }
 
@@ -491,7 +468,6 @@ std::vector<DetectedDevice> HardwareScanner::scanSR04M2(int rxPin, int txPin, in
     while (sr04Serial->available() < 4) {
         if (millis() - startTime > 200) {
             Serial.printf("[SR04M-2] Incomplete data after 0xFF on RX=%d, TX=%s\n", rxPin, txPin < 0 ? "none" : String(txPin).c_str());
-            uartMgr.releaseByOwner("SR04M2_SCAN");
             return devices;
         }
         delay(1);
@@ -503,9 +479,6 @@ std::vector<DetectedDevice> HardwareScanner::scanSR04M2(int rxPin, int txPin, in
     uint8_t lowByte = sr04Serial->read();
     uint8_t checksum = sr04Serial->read();
 
-    // Release UART allocation after scan
-    uartMgr.releaseByOwner("SR04M2_SCAN");
-
     // Verify second header byte
     if (secondHeader != 0xFE) {
         Serial.printf("[SR04M-2] Invalid second header: expected 0xFE, got 0x%02X\n", secondHeader);
@@ -540,7 +513,7 @@ std::vector<DetectedDevice> HardwareScanner::scanSR04M2(int rxPin, int txPin, in
     return devices;
 }
 
-void HardwareScanner::debugGPS(int rxPin, int txPin, int durationSeconds) {
+void HardwareScanner::debugGPS(int rxPin, int txPin, int durationSeconds, GPSDebugIdleCallback onIdle) {
     Serial.println("\n╔════════════════════════════════════════════════════════════╗");
     Serial.println("║               GPS DIAGNOSTICS (NEO-6M)                     ║");
     Serial.println("╠════════════════════════════════════════════════════════════╣");
@@ -556,21 +529,16 @@ void HardwareScanner::debugGPS(int rxPin, int txPin, int durationSeconds) {
     Serial.println("║ Waiting for NMEA data...                                   ║");
     Serial.println("╚════════════════════════════════════════════════════════════╝\n");
 
-    // Use UARTManager to allocate UART dynamically
-    UARTManager& uartMgr = UARTManager::getInstance();
-    int uartNum = uartMgr.allocate(rxPin, txPin, 9600, "GPS_DEBUG", false);  // Arduino API
-
-    if (uartNum < 0) {
-        Serial.println("[GPS DEBUG] Failed to allocate UART!");
-        return;
-    }
-
-    HardwareSerial* gpsSerial = uartMgr.getSerial(uartNum);
+    // Tap the GPS lease if one is running (it keeps receiving), else lease the pins
+    UARTProbe probe(UARTOwner::GPS_DEBUG, rxPin, txPin, 9600);
+    UARTRxBuffer* gpsSerial = probe.rx();
     if (!gpsSerial) {
-        Serial.println("[GPS DEBUG] Failed to get serial!");
-        uartMgr.release(uartNum);
+        Serial.println("[GPS DEBUG] Failed to get UART!");
         return;
     }
+    if (probe.isTap()) {
+        Serial.println("[GPS DEBUG] Mirroring active GPS UART (tap)");
+    }
     delay(100);
 
     unsigned long startTime = millis();
@@ -662,10 +630,11 @@ void HardwareScanner::debugGPS(int rxPin, int txPin, int durationSeconds) {
                 elapsed, bytesReceived, nmeaCount, satellitesInView);
             lastStatusPrint = millis();
         }
-    }
 
-    // Release UART allocation
-    uartMgr.releaseByOwner("GPS_DEBUG");
+        // Let the port owner keep draining its own lease while we mirror it
+        if (onIdle) onIdle();
+        delay(10);
+    }
 
     // Final summary
     Serial.println("\n════════════════════════════════════════════════════════════");
@@ -997,7 +966,7 @@ std::vector<DetectedDevice> HardwareScanner::scanUART(int rxPin, int txPin, int
     return std::vector<DetectedDevice>();
 }
 
-void HardwareScanner::debugGPS(int rxPin, int txPin, int durationSeconds) {
+void HardwareScanner::debugGPS(int rxPin, int txPin, int durationSeconds, GPSDebugIdleCallback onIdle) {
     Serial.println("[GPS DEBUG] Not available on native platform");
 }
 
@@ -4,6 +4,7 @@
 
 #include <Arduino.h>
 #include <vector>
+#include <functional>
 #include "config.h"
 #include "api_client.h"  // For SensorAssignmentConfig
 
@@ -52,6 +53,9 @@ struct ValidationSummary {
     bool allFound() const { return missingCount == 0; }
 };
 
+// Called between reads during GPS diagnostics (e.g. to keep the GPS parser fed)
+using GPSDebugIdleCallback = std::function<void()>;
+
 class HardwareScanner {
 public:
     HardwareScanner();
@@ -73,7 +77,9 @@ public:
     ValidationSummary validateConfiguration(const std::vector<SensorAssignmentConfig>& configs);
 
     // GPS Diagnostics - outputs raw NMEA data, satellite info, and troubleshooting tips
-    void debugGPS(int rxPin = 16, int txPin = 17, int durationSeconds = 30);
+    // Taps the GPS UART if it is already leased instead of taking it over
+    void debugGPS(int rxPin = 16, int txPin = 17, int durationSeconds = 30,
+                  GPSDebugIdleCallback onIdle = nullptr);
 
     // Print scan results to Serial
     void printResults(const std::vector<DetectedDevice>& devices);
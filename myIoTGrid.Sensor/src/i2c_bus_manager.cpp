@@ -0,0 +1,251 @@
+/**
+ * myIoTGrid.Sensor - I2C Bus Manager Implementation
+ *
+ * Pin-pair keyed I2C bus registry with per-controller transaction workers.
+ */
+
+#include "i2c_bus_manager.h"
+
+#ifdef PLATFORM_ESP32
+
+#include <algorithm>
+#include <vector>
+
+I2CBusManager& I2CBusManager::getInstance() {
+    static I2CBusManager instance;
+    return instance;
+}
+
+I2CBusManager::I2CBusManager()
+    : _repinCount(0)
+{
+    for (int i = 0; i < config::I2C_MAX_BUSES; i++) {
+        _buses[i].busId = -1;
+        _buses[i].sdaPin = -1;
+        _buses[i].sclPin = -1;
+        _buses[i].frequency = 0;
+        _buses[i].controller = -1;
+        _buses[i].shared = false;
+        _buses[i].wire = nullptr;
+    }
+    for (int c = 0; c < I2C_CONTROLLER_COUNT; c++) {
+        _controllerMutex[c] = xSemaphoreCreateMutex();
+        _controllerQueue[c] = nullptr;
+        _controllerTask[c] = nullptr;
+        _controllerOwner[c] = -1;
+        _controllerPinnedBus[c] = -1;
+    }
+}
+
+TwoWire* I2CBusManager::controllerWire(int controller) {
+    return (controller == 0) ? &Wire : &Wire1;
+}
+
+int I2CBusManager::acquire(int sdaPin, int sclPin, int requiredController) {
+    if (sdaPin < 0) sdaPin = config::I2C_DEFAULT_SDA_PIN;
+    if (sclPin < 0) sclPin = config::I2C_DEFAULT_SCL_PIN;
+
+    int existing = getBusForPins(sdaPin, sclPin);
+    if (existing >= 0) {
+        if (requiredController >= 0 && _buses[existing].controller != requiredController) {
+            Serial.printf("[I2CBus] WARNING: Bus %d (SDA=%d, SCL=%d) is on controller %d, driver needs %d\n",
+                          existing, sdaPin, sclPin, _buses[existing].controller, requiredController);
+        }
+        return existing;
+    }
+
+    int slot = -1;
+    for (int i = 0; i < config::I2C_MAX_BUSES; i++) {
+        if (_buses[i].busId < 0) { slot = i; break; }
+    }
+    if (slot < 0) {
+        Serial.println("[I2CBus] ERROR: Bus registry full!");
+        return -1;
+    }
+
+    // Prefer a free controller, otherwise share one (controller 1 unless pinned)
+    int controller = -1;
+    bool shared = false;
+    if (requiredController >= 0) {
+        controller = requiredController;
+        shared = (_controllerOwner[controller] >= 0);
+    } else {
+        for (int c = 0; c < I2C_CONTROLLER_COUNT; c++) {
+            if (_controllerOwner[c] < 0) { controller = c; break; }
+        }
+        if (controller < 0) {
+            controller = I2C_CONTROLLER_COUNT - 1;
+            shared = true;
+        }
+    }
+
+    I2CBus& bus = _buses[slot];
+    bus.busId = slot;
+    bus.sdaPin = sdaPin;
+    bus.sclPin = sclPin;
+    bus.frequency = config::I2C_DEFAULT_FREQUENCY_HZ;
+    bus.controller = controller;
+    bus.shared = shared;
+    bus.wire = controllerWire(controller);
+
+    if (!shared) {
+        _controllerOwner[controller] = slot;
+    }
+
+    Serial.printf("[I2CBus] Registered bus %d: SDA=%d, SCL=%d on controller %d%s\n",
+                  slot, sdaPin, sclPin, controller, shared ? " (shared)" : "");
+
+    xSemaphoreTake(_controllerMutex[controller], portMAX_DELAY);
+    if (_controllerPinnedBus[controller] < 0) {
+        applyPins(bus);
+    }
+    xSemaphoreGive(_controllerMutex[controller]);
+
+    startWorker(controller);
+    return slot;
+}
+
+int I2CBusManager::getBusForPins(int sdaPin, int sclPin) const {
+    for (int i = 0; i < config::I2C_MAX_BUSES; i++) {
+        if (_buses[i].busId >= 0 && _buses[i].sdaPin == sdaPin && _buses[i].sclPin == sclPin) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const I2CBus* I2CBusManager::getBus(int busId) const {
+    if (busId < 0 || busId >= config::I2C_MAX_BUSES || _buses[busId].busId < 0) return nullptr;
+    return &_buses[busId];
+}
+
+TwoWire* I2CBusManager::getWire(int busId) const {
+    const I2CBus* bus = getBus(busId);
+    return bus ? bus->wire : nullptr;
+}
+
+bool I2CBusManager::lock(int busId, uint32_t timeoutMs) {
+    const I2CBus* bus = getBus(busId);
+    if (!bus) return false;
+
+    int controller = bus->controller;
+    if (xSemaphoreTake(_controllerMutex[controller], pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+        Serial.printf("[I2CBus] Lock timeout on bus %d\n", busId);
+        return false;
+    }
+    if (_controllerPinnedBus[controller] != busId) {
+        applyPins(*bus);
+    }
+    return true;
+}
+
+void I2CBusManager::unlock(int busId) {
+    const I2CBus* bus = getBus(busId);
+    if (!bus) return;
+    xSemaphoreGive(_controllerMutex[bus->controller]);
+}
+
+void I2CBusManager::applyPins(const I2CBus& bus) {
+    int controller = bus.controller;
+    if (_controllerPinnedBus[controller] >= 0) {
+        bus.wire->end();
+        _repinCount++;
+    }
+    bus.wire->begin(bus.sdaPin, bus.sclPin, bus.frequency);
+    _controllerPinnedBus[controller] = bus.busId;
+}
+
+// ============================================================================
+// Transaction Queue
+// ============================================================================
+
+void I2CBusManager::startWorker(int controller) {
+    if (_controllerTask[controller]) return;
+
+    _controllerQueue[controller] = xQueueCreate(2, sizeof(Batch));
+    char name[12];
+    snprintf(name, sizeof(name), "i2c_bus%d", controller);
+    xTaskCreate(workerTask, name, config::I2C_BUS_TASK_STACK_SIZE,
+                _controllerQueue[controller], 2, &_controllerTask[controller]);
+}
+
+void I2CBusManager::workerTask(void* param) {
+    QueueHandle_t queue = static_cast<QueueHandle_t>(param);
+    Batch batch;
+    for (;;) {
+        if (xQueueReceive(queue, &batch, portMAX_DELAY) == pdTRUE) {
+            runJobs(batch.jobs, batch.count);
+            xTaskNotifyGive(batch.notify);
+        }
+    }
+}
+
+void I2CBusManager::runJobs(const I2CJob* jobs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        jobs[i].fn(jobs[i].ctx);
+    }
+}
+
+void I2CBusManager::runBatch(const I2CJob* jobs, size_t count) {
+    if (count == 0) return;
+
+    // Partition by controller; stable sort keeps per-bus submission order and
+    // groups each shared bus so its controller is re-pinned at most once
+    std::vector<I2CJob> perController[I2C_CONTROLLER_COUNT];
+    std::vector<I2CJob> inlineJobs;
+    for (size_t i = 0; i < count; i++) {
+        const I2CBus* bus = getBus(jobs[i].busId);
+        if (bus) {
+            perController[bus->controller].push_back(jobs[i]);
+        } else {
+            inlineJobs.push_back(jobs[i]);
+        }
+    }
+
+    int pending = 0;
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (int c = 0; c < I2C_CONTROLLER_COUNT; c++) {
+        std::vector<I2CJob>& group = perController[c];
+        if (group.empty()) continue;
+        std::stable_sort(group.begin(), group.end(),
+                         [](const I2CJob& a, const I2CJob& b) { return a.busId < b.busId; });
+
+        Batch batch = { group.data(), group.size(), self };
+        if (_controllerQueue[c] && xQueueSend(_controllerQueue[c], &batch, portMAX_DELAY) == pdTRUE) {
+            pending++;
+        } else {
+            runJobs(group.data(), group.size());
+        }
+    }
+
+    // Non-I2C jobs (1-Wire, UART, GPIO) overlap with the bus workers
+    runJobs(inlineJobs.data(), inlineJobs.size());
+
+    while (pending > 0) {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+        pending--;
+    }
+}
+
+int I2CBusManager::getBusCount() const {
+    int count = 0;
+    for (int i = 0; i < config::I2C_MAX_BUSES; i++) {
+        if (_buses[i].busId >= 0) count++;
+    }
+    return count;
+}
+
+void I2CBusManager::printBuses() {
+    Serial.println("[I2CBus] Current bus registry:");
+    for (int i = 0; i < config::I2C_MAX_BUSES; i++) {
+        const I2CBus& bus = _buses[i];
+        if (bus.busId < 0) continue;
+        Serial.printf("  Bus %d: SDA=%d, SCL=%d, %lu Hz, controller %d%s%s\n",
+                      bus.busId, bus.sdaPin, bus.sclPin, (unsigned long)bus.frequency,
+                      bus.controller, bus.shared ? " (shared)" : "",
+                      _controllerPinnedBus[bus.controller] == bus.busId ? " [active]" : "");
+    }
+    Serial.printf("  Shared-bus re-pins: %lu\n", (unsigned long)_repinCount);
+}
+
+#endif // PLATFORM_ESP32
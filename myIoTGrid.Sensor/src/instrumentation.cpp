@@ -0,0 +1,244 @@
+/**
+ * myIoTGrid.Sensor - Hot-Path Instrumentation Implementation
+ */
+
+#include "instrumentation.h"
+#include <string.h>
+
+// Sensor reads record from the I2C bus tasks; formatting never runs under the lock
+#ifdef PLATFORM_ESP32
+#define INSTRUMENT_LOCK()   taskENTER_CRITICAL(&_mux)
+#define INSTRUMENT_UNLOCK() taskEXIT_CRITICAL(&_mux)
+#else
+#define INSTRUMENT_LOCK()
+#define INSTRUMENT_UNLOCK()
+#endif
+
+namespace {
+
+// Copy "<prefix><name>" into a fixed name field (truncated)
+void copyName(char* out, const char* prefix, const char* name) {
+    snprintf(out, config::INSTRUMENT_NAME_LENGTH, "%s%s", prefix, name);
+}
+
+bool nameEquals(const char* stored, const char* prefix, const char* name) {
+    size_t prefixLength = strlen(prefix);
+    if (strncmp(stored, prefix, prefixLength) != 0) return false;
+    return strncmp(stored + prefixLength, name,
+                   config::INSTRUMENT_NAME_LENGTH - 1 - prefixLength) == 0;
+}
+
+} // namespace
+
+// ============================================================================
+// TimingHistogram
+// ============================================================================
+
+void TimingHistogram::reset() {
+    memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    totalUs = 0;
+    maxUs = 0;
+}
+
+size_t TimingHistogram::bucketFor(uint32_t durationUs) {
+    if (durationUs == 0) return 0;
+    size_t bucket = 32 - __builtin_clz(durationUs);
+    return bucket < config::INSTRUMENT_HISTOGRAM_BUCKETS ? bucket : config::INSTRUMENT_HISTOGRAM_BUCKETS - 1;
+}
+
+void TimingHistogram::add(uint32_t durationUs) {
+    buckets[bucketFor(durationUs)]++;
+    count++;
+    totalUs += durationUs;
+    if (durationUs > maxUs) maxUs = durationUs;
+}
+
+uint32_t TimingHistogram::percentileUs(float quantile) const {
+    if (count == 0) return 0;
+
+    uint32_t rank = (uint32_t)(quantile * count);
+    if (rank >= count) rank = count - 1;
+
+    uint32_t seen = 0;
+    for (size_t i = 0; i < config::INSTRUMENT_HISTOGRAM_BUCKETS - 1; i++) {
+        seen += buckets[i];
+        if (seen > rank) {
+            uint32_t upper = i == 0 ? 0 : (uint32_t)((1ULL << i) - 1);
+            return upper < maxUs ? upper : maxUs;
+        }
+    }
+    return maxUs;  // Open-ended last bucket
+}
+
+// ============================================================================
+// Instrumentation
+// ============================================================================
+
+Instrumentation& Instrumentation::getInstance() {
+    static Instrumentation instance;
+    return instance;
+}
+
+Instrumentation::Instrumentation()
+    : _stageCount(0)
+    , _counterCount(0)
+    , _windowStartMs(millis()) {
+#ifdef PLATFORM_ESP32
+    portMUX_INITIALIZE(&_mux);
+#endif
+}
+
+int Instrumentation::findOrAddStage(const char* prefix, const char* name) {
+    for (size_t i = 0; i < _stageCount; i++) {
+        if (nameEquals(_stages[i].name, prefix, name)) return (int)i;
+    }
+    if (_stageCount >= config::INSTRUMENT_MAX_STAGES) return -1;
+
+    Stage& stage = _stages[_stageCount];
+    copyName(stage.name, prefix, name);
+    stage.histogram.reset();
+    return (int)_stageCount++;
+}
+
+int Instrumentation::stageId(const char* name) {
+    INSTRUMENT_LOCK();
+    int id = findOrAddStage("", name);
+    INSTRUMENT_UNLOCK();
+    return id;
+}
+
+int Instrumentation::stageId(const char* prefix, const char* name) {
+    INSTRUMENT_LOCK();
+    int id = findOrAddStage(prefix, name);
+    INSTRUMENT_UNLOCK();
+    return id;
+}
+
+const char* Instrumentation::stageName(int stageId) const {
+    // Names never change once registered
+    if (stageId < 0 || (size_t)stageId >= _stageCount) return "";
+    return _stages[stageId].name;
+}
+
+void Instrumentation::record(int stageId, uint32_t durationUs) {
+    if (stageId < 0) return;
+
+    INSTRUMENT_LOCK();
+    if ((size_t)stageId < _stageCount) {
+        _stages[stageId].histogram.add(durationUs);
+    }
+    INSTRUMENT_UNLOCK();
+}
+
+void Instrumentation::count(const char* name, uint32_t amount) {
+    INSTRUMENT_LOCK();
+    size_t i = 0;
+    while (i < _counterCount && !nameEquals(_counters[i].name, "", name)) i++;
+    if (i == _counterCount && _counterCount < config::INSTRUMENT_MAX_COUNTERS) {
+        copyName(_counters[i].name, "", name);
+        _counters[i].value = 0;
+        _counterCount++;
+    }
+    if (i < _counterCount) {
+        _counters[i].value += amount;
+    }
+    INSTRUMENT_UNLOCK();
+}
+
+void Instrumentation::reset() {
+    // Stage ids cached by TIMED_SCOPE stay valid: only the samples are cleared
+    INSTRUMENT_LOCK();
+    for (size_t i = 0; i < _stageCount; i++) {
+        _stages[i].histogram.reset();
+    }
+    for (size_t i = 0; i < _counterCount; i++) {
+        _counters[i].value = 0;
+    }
+    _windowStartMs = millis();
+    INSTRUMENT_UNLOCK();
+}
+
+bool Instrumentation::copyStage(size_t index, Stage& out) const {
+    INSTRUMENT_LOCK();
+    bool valid = index < _stageCount;
+    if (valid) {
+        out = _stages[index];
+    }
+    INSTRUMENT_UNLOCK();
+    return valid;
+}
+
+size_t Instrumentation::copyCounters(Counter* out) const {
+    INSTRUMENT_LOCK();
+    size_t counterCount = _counterCount;
+    memcpy(out, _counters, sizeof(Counter) * counterCount);
+    INSTRUMENT_UNLOCK();
+    return counterCount;
+}
+
+String Instrumentation::toJson() const {
+    String json = "{\"windowMs\":" + String(getWindowMs()) + ",\"stages\":[";
+
+    Stage stage;
+    bool first = true;
+    for (size_t i = 0; copyStage(i, stage); i++) {
+        const TimingHistogram& h = stage.histogram;
+        if (h.count == 0) continue;
+
+        if (!first) json += ",";
+        first = false;
+
+        json += "{\"name\":\"" + String(stage.name) + "\"";
+        json += ",\"count\":" + String(h.count);
+        char total[24];
+        snprintf(total, sizeof(total), "%llu", (unsigned long long)h.totalUs);
+        json += ",\"totalUs\":" + String(total);
+        json += ",\"maxUs\":" + String(h.maxUs);
+        json += ",\"p50Us\":" + String(h.percentileUs(0.50f));
+        json += ",\"p90Us\":" + String(h.percentileUs(0.90f));
+        json += ",\"p99Us\":" + String(h.percentileUs(0.99f));
+
+        size_t used = config::INSTRUMENT_HISTOGRAM_BUCKETS;
+        while (used > 0 && h.buckets[used - 1] == 0) used--;
+        json += ",\"buckets\":[";
+        for (size_t b = 0; b < used; b++) {
+            if (b > 0) json += ",";
+            json += String(h.buckets[b]);
+        }
+        json += "]}";
+    }
+
+    json += "],\"counters\":{";
+    Counter counters[config::INSTRUMENT_MAX_COUNTERS];
+    size_t counterCount = copyCounters(counters);
+    for (size_t i = 0; i < counterCount; i++) {
+        if (i > 0) json += ",";
+        json += "\"" + String(counters[i].name) + "\":" + String(counters[i].value);
+    }
+    json += "}}";
+    return json;
+}
+
+void Instrumentation::printReport() const {
+    Serial.printf("[Timing] Window: %.1f s\n", getWindowMs() / 1000.0);
+    Serial.printf("[Timing]   %-23s %8s %10s %9s %9s %9s %9s %10s\n",
+                  "stage", "count", "mean us", "p50 us", "p90 us", "p99 us", "max us", "total ms");
+
+    Stage stage;
+    for (size_t i = 0; copyStage(i, stage); i++) {
+        const TimingHistogram& h = stage.histogram;
+        if (h.count == 0) continue;
+        Serial.printf("[Timing]   %-23s %8lu %10.1f %9lu %9lu %9lu %9lu %10.1f\n",
+                      stage.name, (unsigned long)h.count, (double)h.totalUs / h.count,
+                      (unsigned long)h.percentileUs(0.50f), (unsigned long)h.percentileUs(0.90f),
+                      (unsigned long)h.percentileUs(0.99f), (unsigned long)h.maxUs,
+                      h.totalUs / 1000.0);
+    }
+
+    Counter counters[config::INSTRUMENT_MAX_COUNTERS];
+    size_t counterCount = copyCounters(counters);
+    for (size_t i = 0; i < counterCount; i++) {
+        Serial.printf("[Timing]   counter %-15s %lu\n", counters[i].name, (unsigned long)counters[i].value);
+    }
+}
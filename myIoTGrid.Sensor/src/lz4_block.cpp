@@ -0,0 +1,121 @@
+/**
+ * myIoTGrid.Sensor - LZ4 Block Compressor Implementation
+ */
+
+#include "lz4_block.h"
+#include <string.h>
+
+namespace {
+
+const size_t MIN_MATCH = 4;
+const size_t LAST_LITERALS = 5;   // Block format: last 5 bytes are always literals
+const size_t MF_LIMIT = 12;       // Block format: no match starts in the last 12 bytes
+const size_t MAX_INPUT = 65535;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hashOf(uint32_t sequence, uint8_t hashBits) {
+    return (sequence * 2654435761U) >> (32 - hashBits);
+}
+
+/**
+ * Write the 255-continuation bytes of a length that did not fit its nibble
+ */
+inline bool writeLengthTail(uint8_t*& op, const uint8_t* opEnd, size_t length) {
+    while (length >= 255) {
+        if (op >= opEnd) return false;
+        *op++ = 255;
+        length -= 255;
+    }
+    if (op >= opEnd) return false;
+    *op++ = (uint8_t)length;
+    return true;
+}
+
+/**
+ * Emit token + literals (+ offset and match length unless matchLength is 0)
+ */
+bool writeSequence(uint8_t*& op, const uint8_t* opEnd,
+                   const uint8_t* literals, size_t literalLength,
+                   uint16_t offset, size_t matchLength) {
+    if (op >= opEnd) return false;
+    uint8_t* token = op++;
+
+    size_t matchCode = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+    *token = (uint8_t)(((literalLength < 15 ? literalLength : 15) << 4) |
+                       (matchCode < 15 ? matchCode : 15));
+
+    if (literalLength >= 15 && !writeLengthTail(op, opEnd, literalLength - 15)) return false;
+    if ((size_t)(opEnd - op) < literalLength) return false;
+    memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    if (matchLength == 0) return true;  // Last sequence
+
+    if (opEnd - op < 2) return false;
+    *op++ = (uint8_t)(offset & 0xFF);
+    *op++ = (uint8_t)(offset >> 8);
+    if (matchCode >= 15 && !writeLengthTail(op, opEnd, matchCode - 15)) return false;
+    return true;
+}
+
+} // namespace
+
+size_t lz4CompressBlock(const uint8_t* src, size_t srcLength,
+                        uint8_t* dst, size_t dstCapacity,
+                        uint16_t* hashTable, uint8_t hashBits) {
+    if (srcLength > MAX_INPUT || hashBits < 8 || hashBits > 16) return 0;
+
+    uint8_t* op = dst;
+    const uint8_t* opEnd = dst + dstCapacity;
+    size_t anchor = 0;
+
+    if (srcLength > MF_LIMIT) {
+        memset(hashTable, 0, sizeof(uint16_t) << hashBits);
+
+        const size_t matchStartLimit = srcLength - MF_LIMIT;
+        const size_t matchEndLimit = srcLength - LAST_LITERALS;
+        size_t ip = 1;
+
+        while (ip < matchStartLimit) {
+            uint32_t sequence = read32(src + ip);
+            uint32_t h = hashOf(sequence, hashBits);
+            size_t ref = hashTable[h];
+            hashTable[h] = (uint16_t)ip;
+
+            if (ref >= ip || read32(src + ref) != sequence) {
+                ip++;
+                continue;
+            }
+
+            // Extend backwards over pending literals, then forwards
+            while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+                ip--;
+                ref--;
+            }
+            size_t matchLength = MIN_MATCH;
+            while (ip + matchLength < matchEndLimit &&
+                   src[ip + matchLength] == src[ref + matchLength]) {
+                matchLength++;
+            }
+
+            if (!writeSequence(op, opEnd, src + anchor, ip - anchor,
+                               (uint16_t)(ip - ref), matchLength)) {
+                return 0;
+            }
+
+            ip += matchLength;
+            anchor = ip;
+            if (ip - 2 < matchStartLimit) {
+                hashTable[hashOf(read32(src + ip - 2), hashBits)] = (uint16_t)(ip - 2);
+            }
+        }
+    }
+
+    if (!writeSequence(op, opEnd, src + anchor, srcLength - anchor, 0, 0)) return 0;
+    return (size_t)(op - dst);
+}
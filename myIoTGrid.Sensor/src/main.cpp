@@ -22,7 +22,12 @@
 #include "config_manager.h"
 #include "wifi_manager.h"
 #include "api_client.h"
+#include "control_channel.h"
 #include "discovery_client.h"
+#include "session_trace.h"
+#include "instrumentation.h"
+#include "stall_monitor.h"
+#include "memory_telemetry.h"
 #include "hardware_scanner.h"
 
 #include "sensor_reader.h"
@@ -51,6 +56,8 @@
 #include <WiFi.h>
 #include <Wire.h>
 #include <esp_task_wdt.h>
+#else
+#include "hal/hal.h"
 #endif
 
 // ============================================================================
@@ -61,6 +68,7 @@ StateMachine stateMachine;
 ConfigManager configManager;
 WiFiManager wifiManager;
 ApiClient apiClient;
+ControlChannel controlChannel;
 DiscoveryClient discoveryClient;
 HardwareScanner hardwareScanner;
 SensorReader sensorReader;
@@ -114,17 +122,16 @@ static bool hardwareDetected = false;
 // Configuration
 // ============================================================================
 
-static const unsigned long HEARTBEAT_INTERVAL_MS = 60000;   // 1 minute
+static const unsigned long CONTROL_SYNC_INTERVAL_MS = 60000; // 1 minute: heartbeat + config/debug/time in one round-trip
 static const unsigned long SENSOR_INTERVAL_MS = 60000;      // 1 minute
 static const unsigned long WIFI_CHECK_INTERVAL_MS = 5000;   // 5 seconds
-static const unsigned long CONFIG_CHECK_INTERVAL_MS = 60000; // 60 seconds
-static const unsigned long DEBUG_CONFIG_CHECK_INTERVAL_MS = 60000; // 60 seconds for debug config sync (same as sensor config)
+static const unsigned long HARDWARE_STATUS_INTERVAL_MS = 900000; // 15 minutes: refreshes timing and stalls on the Hub
+static const long TIME_RESYNC_THRESHOLD_S = 2;              // Correct the clock from heartbeats beyond this drift
 
-static unsigned long lastHeartbeat = 0;
+static unsigned long lastControlSync = 0;
 static unsigned long lastSensorReading = 0;
 static unsigned long lastWiFiCheck = 0;
-static unsigned long lastConfigCheck = 0;
-static unsigned long lastDebugConfigCheck = 0;
+static unsigned long lastHardwareStatusReport = 0;
 
 // Per-sensor timing for GCD-based polling
 static std::map<int, unsigned long> sensorLastReading;  // endpointId -> last reading time
@@ -134,7 +141,7 @@ static int calculatedPollIntervalSeconds = 60;  // GCD of all sensor intervals
 static NodeConfigurationResponse currentConfig;
 static bool configLoaded = false;
 static String currentSerial;
-static unsigned long lastValidatedConfigTimestamp = 0;  // Track when we last validated hardware
+static int sensorInitFailures = -1;  // Sensors that failed the last init phase (-1 = not run yet)
 
 // ============================================================================
 // URL Helper Functions
@@ -801,6 +808,28 @@ void onReProvisioningConfigReceived(const BLEConfig& config) {
 // WiFi Callbacks
 // ============================================================================
 
+#ifdef PLATFORM_ESP32
+/**
+ * Set system time from a Hub Unix timestamp (Europe/Berlin local time)
+ */
+void setTimeFromHub(long unixTimestamp) {
+    struct timeval tv;
+    tv.tv_sec = unixTimestamp;
+    tv.tv_usec = 0;
+    settimeofday(&tv, nullptr);
+
+    // Set timezone to Europe/Berlin (CET/CEST)
+    setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
+    tzset();
+
+    time_t now = time(nullptr);
+    struct tm* timeinfo = localtime(&now);
+    Serial.printf("[Time] Synced from Hub: %04d-%02d-%02d %02d:%02d:%02d (Europe/Berlin)\n",
+                  timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday,
+                  timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec);
+}
+#endif
+
 /**
  * Sync time from Hub API only (no NTP fallback)
  * Hub provides /api/time endpoint for local time sync without internet
@@ -816,21 +845,7 @@ void syncTime() {
     TimeResponse timeResp = apiClient.fetchTime();
 
     if (timeResp.success && timeResp.unixTimestamp > 1000000000) {
-        // Set system time from Hub
-        struct timeval tv;
-        tv.tv_sec = timeResp.unixTimestamp;
-        tv.tv_usec = 0;
-        settimeofday(&tv, nullptr);
-
-        // Set timezone to Europe/Berlin (CET/CEST)
-        setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
-        tzset();
-
-        time_t now = time(nullptr);
-        struct tm* timeinfo = localtime(&now);
-        Serial.printf("[Time] Synced from Hub: %04d-%02d-%02d %02d:%02d:%02d (Europe/Berlin)\n",
-                      timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday,
-                      timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec);
+        setTimeFromHub(timeResp.unixTimestamp);
     } else {
         Serial.printf("[Time] Hub time sync failed: %s\n", timeResp.error.c_str());
     }
@@ -862,25 +877,6 @@ void onWiFiFailed(const String& reason) {
 // Operational Functions
 // ============================================================================
 
-void sendHeartbeat() {
-    if (!apiClient.isConfigured()) {
-        return;
-    }
-
-    // Check WiFi connection
-    if (!wifiManager.isConnected()) {
-        return;
-    }
-
-    HeartbeatResponse response = apiClient.sendHeartbeat(FIRMWARE_VERSION);
-    if (response.success) {
-        Serial.printf("[Main] Heartbeat OK, next in %d seconds\n",
-                      response.nextHeartbeatSeconds);
-    } else {
-        Serial.println("[Main] Heartbeat failed!");
-    }
-}
-
 /**
  * Fetch or refresh sensor configuration from Hub
  */
@@ -894,70 +890,119 @@ void fetchSensorConfiguration() {
         return;
     }
 
-    Serial.println("[Main] Fetching sensor configuration from Hub...");
+    // Conditional fetch: unchanged configuration costs a 304 and no parsing
+    ConfigFetchResult result = apiClient.fetchConfiguration(currentSerial, currentConfig);
 
-    NodeConfigurationResponse response = apiClient.fetchConfiguration(currentSerial);
+    if (result == ConfigFetchResult::FAILED) {
+        Serial.printf("[Main] Config fetch: %s\n", currentConfig.error.c_str());
+        // Don't clear configLoaded - keep using last known config
+        return;
+    }
 
-    if (response.success) {
-        currentConfig = response;
-        configLoaded = true;
-
-        // Calculate GCD-based poll interval for all active sensors
-        calculatedPollIntervalSeconds = calculatePollIntervalGCD();
-
-        // Log sensor intervals for debugging
-        Serial.printf("[Main] Configuration updated: %d sensors\n", (int)currentConfig.sensors.size());
-        Serial.printf("[Main] Poll interval: %ds (GCD of sensor intervals)\n", calculatedPollIntervalSeconds);
-        for (const auto& sensor : currentConfig.sensors) {
-            if (sensor.isActive) {
-                Serial.printf("[Main]   - %s (Endpoint %d): every %ds\n",
-                              sensor.sensorName.c_str(), sensor.endpointId, sensor.intervalSeconds);
+    configLoaded = true;
+
+    if (result != ConfigFetchResult::UPDATED) {
+        // Same configuration: only retry sensors that failed to initialize
+        if (sensorInitFailures != 0 && currentConfig.sensors.size() > 0) {
+            sensorInitFailures = sensorReader.initializeSensors(currentConfig.sensors);
+            if (sensorInitFailures > 0) {
+                Serial.printf("[Main] WARNING: %d sensor(s) failed to initialize - will retry\n",
+                              sensorInitFailures);
             }
         }
+        return;
+    }
 
-        // Validate hardware configuration when sensors are configured
-        if (currentConfig.sensors.size() > 0) {
-            if (currentConfig.configurationTimestamp != lastValidatedConfigTimestamp) {
-                Serial.println("[Main] Configuration changed - validating hardware...");
-                ValidationSummary validationResult = hardwareScanner.validateConfiguration(currentConfig.sensors);
+    // Calculate GCD-based poll interval for all active sensors
+    calculatedPollIntervalSeconds = calculatePollIntervalGCD();
 
-                if (!validationResult.allFound()) {
-                    Serial.println("\n[Main] WARNING: Hardware validation found missing sensors!");
-                    Serial.println("[Main] Some configured sensors may not work correctly.");
-                    Serial.println("[Main] Please check your hardware connections.\n");
-                } else {
-                    Serial.println("[Main] Hardware validation successful - all sensors detected!");
-                }
+    // Log sensor intervals for debugging
+    Serial.printf("[Main] Configuration updated: %d sensors\n", (int)currentConfig.sensors.size());
+    Serial.printf("[Main] Poll interval: %ds (GCD of sensor intervals)\n", calculatedPollIntervalSeconds);
+    for (const auto& sensor : currentConfig.sensors) {
+        if (sensor.isActive) {
+            Serial.printf("[Main]   - %s (Endpoint %d): every %ds\n",
+                          sensor.sensorName.c_str(), sensor.endpointId, sensor.intervalSeconds);
+        }
+    }
 
-                // Remember this timestamp so we don't re-validate until config changes
-                lastValidatedConfigTimestamp = currentConfig.configurationTimestamp;
-            }
+    // Validate hardware configuration when sensors are configured
+    if (currentConfig.sensors.size() > 0) {
+        Serial.println("[Main] Configuration changed - validating hardware...");
+        ValidationSummary validationResult = hardwareScanner.validateConfiguration(currentConfig.sensors);
+
+        if (!validationResult.allFound()) {
+            Serial.println("\n[Main] WARNING: Hardware validation found missing sensors!");
+            Serial.println("[Main] Some configured sensors may not work correctly.");
+            Serial.println("[Main] Please check your hardware connections.\n");
+        } else {
+            Serial.println("[Main] Hardware validation successful - all sensors detected!");
         }
+    }
+
+    // Init phase: set up every sensor driver now so the reading loop never
+    // allocates or initializes. Failed sensors are retried on each config check.
+    // Runs for an empty list too: it releases the drivers of removed sensors.
+    sensorInitFailures = sensorReader.initializeSensors(currentConfig.sensors);
+    if (sensorInitFailures > 0) {
+        Serial.printf("[Main] WARNING: %d sensor(s) failed to initialize - will retry\n",
+                      sensorInitFailures);
+    }
 
-        // Sprint OS-01: Apply storageMode from API to storageConfigManager
+    // Sprint OS-01: Apply storageMode from API to storageConfigManager
 #ifdef PLATFORM_ESP32
-        if (offlineStorageEnabled) {
-            StorageMode apiMode = static_cast<StorageMode>(response.storageMode);
-            StorageMode currentMode = storageConfigManager.getMode();
-
-            if (apiMode != currentMode) {
-                Serial.printf("[Main] Storage Mode changed: %s -> %s (from Hub API)\n",
-                              StorageConfig::getModeString(currentMode),
-                              StorageConfig::getModeString(apiMode));
-                storageConfigManager.setMode(apiMode);
-                storageConfigManager.save(sdManager);
-            }
+    if (offlineStorageEnabled) {
+        StorageMode apiMode = static_cast<StorageMode>(currentConfig.storageMode);
+        StorageMode currentMode = storageConfigManager.getMode();
+
+        if (apiMode != currentMode) {
+            Serial.printf("[Main] Storage Mode changed: %s -> %s (from Hub API)\n",
+                          StorageConfig::getModeString(currentMode),
+                          StorageConfig::getModeString(apiMode));
+            storageConfigManager.setMode(apiMode);
+            storageConfigManager.save(sdManager);
         }
+    }
 #endif
+}
+
+/**
+ * Apply debug level and remote logging settings from Hub (Sprint 8)
+ */
+void applyDebugSettings(const String& nodeId, int debugLevel, bool enableRemoteLogging) {
+    // Apply debug level to DebugManager
+    DebugLevel newLevel = static_cast<DebugLevel>(debugLevel);
+    DebugLevel currentLevel = DebugManager::getInstance().getLevel();
+
+    if (newLevel != currentLevel) {
+        DebugManager::getInstance().setLevel(newLevel);
+        Serial.printf("[Main] Debug level changed: %d -> %d (from Hub sync)\n",
+                      static_cast<int>(currentLevel), static_cast<int>(newLevel));
+    }
+
+    // Apply remote logging setting
+    DebugManager::getInstance().setRemoteLogging(enableRemoteLogging);
+
+    // Enable/disable debug log uploader
+    bool uploaderWasEnabled = DebugLogUploader::getInstance().isEnabled();
+    if (enableRemoteLogging) {
+        if (!uploaderWasEnabled) {
+            // Initialize SerialCapture and uploader on first enable
+            DebugLogUploader::getInstance().begin(apiClient.getBaseUrl(), nodeId);
+            Serial.println("[Main] Remote logging ENABLED (from Hub sync)");
+        }
+        DebugLogUploader::getInstance().setEnabled(true);
     } else {
-        Serial.printf("[Main] Config fetch: %s\n", response.error.c_str());
-        // Don't clear configLoaded - keep using last known config
+        DebugLogUploader::getInstance().setEnabled(false);
+        if (uploaderWasEnabled) {
+            Serial.println("[Main] Remote logging DISABLED (from Hub sync)");
+        }
     }
 }
 
 /**
- * Periodically check and apply debug configuration from Hub (Sprint 8)
- * Called in handleOperationalState to sync debug level and remote logging settings
+ * Fetch and apply debug configuration from Hub (Sprint 8)
+ * Fallback for syncControlPlane() when the heartbeat carries no debug settings
  */
 void checkDebugConfiguration() {
     if (!apiClient.isConfigured()) {
@@ -970,36 +1015,97 @@ void checkDebugConfiguration() {
     }
 
     DebugConfigurationResponse debugConfig = apiClient.fetchDebugConfiguration(nodeId);
+    if (debugConfig.notModified) {
+        return;  // Settings already applied
+    }
     if (debugConfig.success) {
-        // Apply debug level to DebugManager
-        DebugLevel newLevel = static_cast<DebugLevel>(debugConfig.debugLevel);
-        DebugLevel currentLevel = DebugManager::getInstance().getLevel();
+        applyDebugSettings(nodeId, debugConfig.debugLevel, debugConfig.enableRemoteLogging);
+    }
+}
 
-        if (newLevel != currentLevel) {
-            DebugManager::getInstance().setLevel(newLevel);
-            Serial.printf("[Main] Debug level changed: %d -> %d (from Hub sync)\n",
-                          static_cast<int>(currentLevel), static_cast<int>(newLevel));
+/**
+ * Apply a control state pushed by the Hub (configuration version, debug settings)
+ */
+void applyControlState(const ControlState& state) {
+    if (!apiClient.isConfigurationCurrent(state.configurationVersion.c_str())) {
+        Serial.println("[Main] Configuration change pushed by Hub");
+        fetchSensorConfiguration();
+    }
+
+    applyDebugSettings(apiClient.getNodeId(), state.debugLevel, state.enableRemoteLogging);
+}
+
+/**
+ * Control-plane sync: one heartbeat round-trip per interval
+ * The heartbeat response carries the configuration version, debug settings and
+ * server time. Configuration is only fetched when its version changed; Hubs that
+ * don't send these fields get the separate (conditional) fetches instead.
+ */
+void syncControlPlane() {
+    if (!apiClient.isConfigured()) {
+        return;
+    }
+
+    // Check WiFi connection
+    if (!wifiManager.isConnected()) {
+        return;
+    }
+
+    // While the control channel is up, changes are pushed and polling is not needed
+    bool pushActive = controlChannel.isActive();
+
+    HeartbeatResponse response = apiClient.sendHeartbeat(FIRMWARE_VERSION, -1,
+                                                         MemoryTelemetry::getInstance().toJson());
+    if (!response.success) {
+        Serial.println("[Main] Heartbeat failed!");
+        if (!pushActive) {
+            fetchSensorConfiguration();
+            checkDebugConfiguration();
         }
+        return;
+    }
 
-        // Apply remote logging setting
-        DebugManager::getInstance().setRemoteLogging(debugConfig.enableRemoteLogging);
+    Serial.printf("[Main] Heartbeat OK, next in %d seconds\n",
+                  response.nextHeartbeatSeconds);
 
-        // Enable/disable debug log uploader
-        bool uploaderWasEnabled = DebugLogUploader::getInstance().isEnabled();
-        if (debugConfig.enableRemoteLogging) {
-            if (!uploaderWasEnabled) {
-                // Initialize SerialCapture and uploader on first enable
-                DebugLogUploader::getInstance().begin(apiClient.getBaseUrl(), nodeId);
-                Serial.println("[Main] Remote logging ENABLED (from Hub sync)");
-            }
-            DebugLogUploader::getInstance().setEnabled(true);
-        } else {
-            DebugLogUploader::getInstance().setEnabled(false);
-            if (uploaderWasEnabled) {
-                Serial.println("[Main] Remote logging DISABLED (from Hub sync)");
-            }
+    // Backstop for a missed push: only costs a request when the version differs
+    if (response.configChanged) {
+        fetchSensorConfiguration();
+    }
+
+    if (response.hasDebugConfig) {
+        applyDebugSettings(apiClient.getNodeId(), response.debugLevel, response.enableRemoteLogging);
+    } else if (!pushActive) {
+        checkDebugConfiguration();
+    }
+
+#ifdef PLATFORM_ESP32
+    if (response.unixTimestamp > 1000000000) {
+        long drift = response.unixTimestamp - (long)time(nullptr);
+        if (drift > TIME_RESYNC_THRESHOLD_S || drift < -TIME_RESYNC_THRESHOLD_S) {
+            setTimeFromHub(response.unixTimestamp);
         }
     }
+#endif
+}
+
+/**
+ * Convert a hardware reading to a value, logging failures
+ * @param sensorCode Sensor code/measurement type
+ * @param reading Result from SensorReader
+ * @return Sensor value, or -999.99 on error
+ */
+double sensorValueFromReading(const String& sensorCode, const SensorReading& reading) {
+    if (reading.success) {
+        return reading.value;
+    }
+
+    // Hardware reading failed - log error
+    Serial.printf("[HW] Hardware read failed for %s: %s\n",
+                  sensorCode.c_str(), reading.error.c_str());
+    Serial.println("[HW] Check sensor wiring and configuration in Hub");
+
+    return -999.99;  // Error indicator value
 }
 
 /**
@@ -1012,18 +1118,7 @@ void checkDebugConfiguration() {
 double readSensorValueWithConfig(const String& sensorCode, const String& unit, const SensorAssignmentConfig* sensorConfig) {
     if (sensorConfig != nullptr) {
         // Use the sensor configuration to read hardware
-        SensorReading reading = sensorReader.readValue(sensorCode, *sensorConfig);
-
-        if (reading.success) {
-            return reading.value;
-        }
-
-        // Hardware reading failed - log error
-        Serial.printf("[HW] Hardware read failed for %s: %s\n",
-                      sensorCode.c_str(), reading.error.c_str());
-        Serial.println("[HW] Check sensor wiring and configuration in Hub");
-
-        return -999.99;  // Error indicator value
+        return sensorValueFromReading(sensorCode, sensorReader.readValue(sensorCode, *sensorConfig));
     }
 
     // No sensor config provided - can't read hardware
@@ -1087,10 +1182,12 @@ void readAndSendDueSensors(unsigned long now) {
         return;
     }
 
-    Serial.printf("[Main] Polling tick: %d of %d sensors due\n",
-                  dueCount, (int)currentConfig.sensors.size());
+    DBG_SENSOR("Polling tick: %d of %d sensors due",
+               dueCount, (int)currentConfig.sensors.size());
 
-    // Read only sensors that are due
+    // Collect sensors that are due (drivers were set up in fetchSensorConfiguration)
+    std::vector<const SensorAssignmentConfig*> dueSensors;
+    std::vector<SensorBatchRequest> batch;
     for (const auto& sensor : currentConfig.sensors) {
         if (!sensor.isActive) {
             continue;  // Skip inactive sensors silently
@@ -1103,19 +1200,37 @@ void readAndSendDueSensors(unsigned long now) {
         // Mark sensor as read at current time
         markSensorRead(sensor.endpointId, now);
 
-        // Ensure sensor is initialized with Hub configuration
-        sensorReader.initializeSensor(sensor);
+        dueSensors.push_back(&sensor);
+        if (sensor.capabilities.size() > 0) {
+            for (const auto& cap : sensor.capabilities) {
+                batch.push_back(SensorBatchRequest(&sensor, cap.measurementType));
+            }
+        } else {
+            batch.push_back(SensorBatchRequest(&sensor, sensor.sensorCode));
+        }
+    }
+
+    // Read everything in one batch: one transaction queue per I2C bus,
+    // both I2C controllers are read concurrently
+    {
+        TIMED_SCOPE("sensor.batch");
+        sensorReader.readBatch(batch);
+    }
+    size_t batchIndex = 0;
+
+    for (const SensorAssignmentConfig* sensorPtr : dueSensors) {
+        const SensorAssignmentConfig& sensor = *sensorPtr;
 
         // If sensor has capabilities, send one reading per capability
         if (sensor.capabilities.size() > 0) {
             for (const auto& cap : sensor.capabilities) {
-                // Read value from hardware sensor
-                double value = readSensorValueWithConfig(cap.measurementType, cap.unit, &sensor);
+                // Value read from hardware sensor in the batch above
+                double value = sensorValueFromReading(cap.measurementType, batch[batchIndex++].result);
 
                 // Check for error indicator
                 if (value <= -999.0) {
-                    Serial.printf("[Main] Skipping %s/%s - hardware read error\n",
-                                  sensor.sensorName.c_str(), cap.measurementType.c_str());
+                    DBG_ERROR("Skipping %s/%s - hardware read error",
+                              sensor.sensorName.c_str(), cap.measurementType.c_str());
                     continue;
                 }
 
@@ -1142,30 +1257,29 @@ void readAndSendDueSensors(unsigned long now) {
 
                 // Log result
                 if (sentToHub && storedLocally) {
-                    Serial.printf("[Main] Sent+Stored %s/%s: %.2f %s (Endpoint %d) [LOCAL_AND_REMOTE]\n",
-                                  sensor.sensorName.c_str(), cap.displayName.c_str(),
-                                  value, cap.unit.c_str(), sensor.endpointId);
+                    DBG_SENSOR("Sent+Stored %s/%s: %.2f %s (Endpoint %d) [LOCAL_AND_REMOTE]",
+                               sensor.sensorName.c_str(), cap.displayName.c_str(),
+                               value, cap.unit.c_str(), sensor.endpointId);
                 } else if (sentToHub) {
-                    Serial.printf("[Main] Sent %s/%s: %.2f %s (Endpoint %d) [REMOTE]\n",
-                                  sensor.sensorName.c_str(), cap.displayName.c_str(),
-                                  value, cap.unit.c_str(), sensor.endpointId);
+                    DBG_SENSOR("Sent %s/%s: %.2f %s (Endpoint %d) [REMOTE]",
+                               sensor.sensorName.c_str(), cap.displayName.c_str(),
+                               value, cap.unit.c_str(), sensor.endpointId);
                 } else if (storedLocally) {
-                    Serial.printf("[Main] Stored %s/%s: %.2f %s (Endpoint %d) [LOCAL]\n",
-                                  sensor.sensorName.c_str(), cap.displayName.c_str(),
-                                  value, cap.unit.c_str(), sensor.endpointId);
+                    DBG_SENSOR("Stored %s/%s: %.2f %s (Endpoint %d) [LOCAL]",
+                               sensor.sensorName.c_str(), cap.displayName.c_str(),
+                               value, cap.unit.c_str(), sensor.endpointId);
                 } else {
-                    Serial.printf("[Main] Failed to send/store %s/%s reading\n",
-                                  sensor.sensorName.c_str(), cap.measurementType.c_str());
+                    DBG_ERROR("Failed to send/store %s/%s reading",
+                              sensor.sensorName.c_str(), cap.measurementType.c_str());
                 }
             }
         } else {
             // Fallback: Send single reading with sensor code as measurement type
-            double value = readSensorValueWithConfig(sensor.sensorCode, "", &sensor);
+            double value = sensorValueFromReading(sensor.sensorCode, batch[batchIndex++].result);
 
             // Check for error indicator
             if (value <= -999.0) {
-                Serial.printf("[Main] Skipping %s - hardware read error\n",
-                              sensor.sensorName.c_str());
+                DBG_ERROR("Skipping %s - hardware read error", sensor.sensorName.c_str());
                 continue;
             }
 
@@ -1191,16 +1305,16 @@ void readAndSendDueSensors(unsigned long now) {
 #endif
 
             if (sentToHub && storedLocally) {
-                Serial.printf("[Main] Sent+Stored %s: %.2f (Endpoint %d) [LOCAL_AND_REMOTE]\n",
-                              sensor.sensorName.c_str(), value, sensor.endpointId);
+                DBG_SENSOR("Sent+Stored %s: %.2f (Endpoint %d) [LOCAL_AND_REMOTE]",
+                           sensor.sensorName.c_str(), value, sensor.endpointId);
             } else if (sentToHub) {
-                Serial.printf("[Main] Sent %s: %.2f (Endpoint %d) [REMOTE]\n",
-                              sensor.sensorName.c_str(), value, sensor.endpointId);
+                DBG_SENSOR("Sent %s: %.2f (Endpoint %d) [REMOTE]",
+                           sensor.sensorName.c_str(), value, sensor.endpointId);
             } else if (storedLocally) {
-                Serial.printf("[Main] Stored %s: %.2f (Endpoint %d) [LOCAL]\n",
-                              sensor.sensorName.c_str(), value, sensor.endpointId);
+                DBG_SENSOR("Stored %s: %.2f (Endpoint %d) [LOCAL]",
+                           sensor.sensorName.c_str(), value, sensor.endpointId);
             } else {
-                Serial.printf("[Main] Failed to send/store %s reading\n", sensor.sensorName.c_str());
+                DBG_ERROR("Failed to send/store %s reading", sensor.sensorName.c_str());
             }
         }
     }
@@ -1345,9 +1459,12 @@ void sendHardwareStatusReport() {
         HARDWARE_TYPE,
         devicesJson,
         storageJson,
-        busStatusJson
+        busStatusJson,
+        Instrumentation::getInstance().toJson(),
+        StallMonitor::getInstance().toJson()
     );
 
+    lastHardwareStatusReport = millis();
     if (success) {
         Serial.println("[Main] Hardware status report sent successfully");
     } else {
@@ -1368,6 +1485,7 @@ bool registerWithHub() {
 
     // Store serial for later configuration fetches
     currentSerial = serial;
+    SessionTrace::getInstance().setDeviceSerial(serial);
 
     // No capabilities sent - Hub assigns sensors to nodes
     std::vector<String> emptyCapabilities;
@@ -1451,6 +1569,9 @@ bool registerWithHub() {
             Serial.println("[Main] Debug config fetch failed - using default settings");
         }
 
+        // Config and debug changes are pushed from now on (long-poll in the background)
+        controlChannel.begin(apiClient.getBaseUrl(), currentSerial);
+
         return true;
     } else {
         Serial.printf("[Main] Registration failed: %s\n", response.error.c_str());
@@ -1487,13 +1608,8 @@ bool attemptHubDiscovery() {
     // Configure discovery client
     int discoveryPort = config::DISCOVERY_PORT;
 
-    // Generate serial from full 6-byte WiFi MAC address
-    uint8_t mac[6];
-    WiFi.macAddress(mac);
-    char serialBuf[24];
-    snprintf(serialBuf, sizeof(serialBuf), "ESP32-%02X%02X%02X%02X%02X%02X",
-             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-    String serial = String(serialBuf);
+    // Serial from the full 6-byte WiFi MAC address (fixed simulator serial on native)
+    String serial = configManager.getSerial();
 
     discoveryClient.configure(discoveryPort, config::DISCOVERY_TIMEOUT_MS);
 
@@ -1609,6 +1725,12 @@ void handleUnconfiguredState() {
 
         apiClient.configure(apiUrl, serial, "");
 
+        // handleConfiguredState() connects with the stored config
+        StoredConfig storedConfig;
+        storedConfig.hubApiUrl = apiUrl;
+        storedConfig.nodeId = serial;
+        configManager.saveConfig(storedConfig);
+
         // Transition to configured state
         stateMachine.processEvent(StateEvent::CONFIG_FOUND);
         return;
@@ -1828,22 +1950,16 @@ void handleOperationalState() {
         }
     }
 
-    // Check for configuration updates periodically
-    if (now - lastConfigCheck >= CONFIG_CHECK_INTERVAL_MS) {
-        lastConfigCheck = now;
-        fetchSensorConfiguration();
-    }
-
-    // Check for debug configuration updates periodically (Sprint 8)
-    if (now - lastDebugConfigCheck >= DEBUG_CONFIG_CHECK_INTERVAL_MS) {
-        lastDebugConfigCheck = now;
-        checkDebugConfiguration();
+    // Changes pushed over the control channel apply right away
+    ControlState pushedState;
+    if (controlChannel.takeState(pushedState)) {
+        applyControlState(pushedState);
     }
 
-    // Send heartbeat periodically
-    if (now - lastHeartbeat >= HEARTBEAT_INTERVAL_MS) {
-        lastHeartbeat = now;
-        sendHeartbeat();
+    // Heartbeat + configuration/debug/time sync in one round-trip
+    if (now - lastControlSync >= CONTROL_SYNC_INTERVAL_MS) {
+        lastControlSync = now;
+        syncControlPlane();
     }
 
     // Read and send sensor data using GCD-based polling
@@ -1857,6 +1973,11 @@ void handleOperationalState() {
         lastSensorReading = now;
         readAndSendDueSensors(now);
     }
+
+    // Periodic report so the Hub sees current timing histograms and stalls
+    if (now - lastHardwareStatusReport >= HARDWARE_STATUS_INTERVAL_MS) {
+        sendHardwareStatusReport();
+    }
 }
 
 void handleErrorState() {
@@ -2047,15 +2168,14 @@ void handleBleSensorModeState() {
 
             // Read initial sensor values and start advertising
             std::vector<SensorReader::SimpleSensorReading> initialReadings = sensorReader.readDueSensors(now);
-            float temp = 0, humidity = 0, pressure = 0;
             for (const auto& r : initialReadings) {
-                if (r.type == "temperature") temp = r.value;
-                else if (r.type == "humidity") humidity = r.value;
-                else if (r.type == "pressure") pressure = r.value;
+                if (!bleBeaconMode.setReading(r.type, r.value, r.unit)) {
+                    Serial.printf("[Main] Beacon has no channel for %s (%s)\n", r.type.c_str(), r.unit.c_str());
+                }
             }
 
             // Update beacon with initial values and start
-            bleBeaconMode.updateSensorData(temp, humidity, pressure, 3300);
+            bleBeaconMode.publishReadings(3300);
             bleBeaconMode.startAdvertising();
 
             Serial.println("[Main] BLE Beacon advertising started!");
@@ -2081,22 +2201,22 @@ void handleBleSensorModeState() {
         // Read sensors that are due
         std::vector<SensorReader::SimpleSensorReading> dueReadings = sensorReader.readDueSensors(now);
 
-        // Extract values for beacon update
-        float temp = 0, humidity = 0, pressure = 0;
+        // Every detected capability gets a beacon channel
         for (const auto& r : dueReadings) {
-            if (r.type == "temperature") temp = r.value;
-            else if (r.type == "humidity") humidity = r.value;
-            else if (r.type == "pressure") pressure = r.value;
+            bleBeaconMode.setReading(r.type, r.value, r.unit);
         }
 
-        // Update beacon advertising data with new values
+        // Start a new frame cycle with the new values
         if (!dueReadings.empty()) {
-            bleBeaconMode.updateSensorData(temp, humidity, pressure, 3300);
-            Serial.printf("[Main] Beacon updated: T=%.1f°C H=%.1f%% P=%.0fhPa\n",
-                          temp, humidity, pressure);
+            bleBeaconMode.publishReadings(3300);
+            Serial.printf("[Main] Beacon updated: %d readings in %d frame(s)\n",
+                          dueReadings.size(), bleBeaconMode.getFrameCount());
         }
     }
 
+    // Rotate beacon frames
+    bleBeaconMode.loop();
+
     // Update LED pattern
     ledController.update();
 
@@ -2107,12 +2227,65 @@ void handleBleSensorModeState() {
 #endif
 }
 
+// ============================================================================
+// Serial Console Commands
+// ============================================================================
+
+/**
+ * Newline-terminated commands on the serial console
+ *   timing        Print the hot-path timing histograms (see instrumentation.h)
+ *   timing reset  Start a new measurement window
+ *   stalls        Print the longest loop() stalls (see stall_monitor.h)
+ *   stalls reset  Forget the recorded stalls
+ *   memory        Print heap per capability and the trend (see memory_telemetry.h)
+ */
+static void handleSerialCommand(const char* command) {
+    if (strcmp(command, "timing") == 0) {
+        Instrumentation::getInstance().printReport();
+    } else if (strcmp(command, "timing reset") == 0) {
+        Instrumentation::getInstance().reset();
+        Serial.println("[Timing] Reset");
+    } else if (strcmp(command, "stalls") == 0) {
+        StallMonitor::getInstance().printReport();
+    } else if (strcmp(command, "stalls reset") == 0) {
+        StallMonitor::getInstance().reset();
+        Serial.println("[Stall] Reset");
+    } else if (strcmp(command, "memory") == 0) {
+        MemoryTelemetry::getInstance().printReport();
+    } else {
+        Serial.printf("[Main] Unknown command: %s (commands: timing, stalls [reset], memory)\n", command);
+    }
+}
+
+static void pollSerialCommands() {
+    static char line[config::INSTRUMENT_SERIAL_LINE_LENGTH];
+    static size_t length = 0;
+
+    while (Serial.available() > 0) {
+        int c = Serial.read();
+        if (c < 0) break;
+
+        if (c == '\r' || c == '\n') {
+            if (length > 0) {
+                line[length] = '\0';
+                length = 0;
+                handleSerialCommand(line);
+            }
+        } else if (length < sizeof(line) - 1) {
+            line[length++] = (char)c;
+        }
+    }
+}
+
 // ============================================================================
 // Arduino Setup & Loop
 // ============================================================================
 
 void setup() {
     Serial.begin(115200);
+
+    // Session record/replay (native env vars or ESP32 -DSESSION_TRACE); before the first delay
+    SessionTrace::getInstance().begin();
     delay(1000);
 
 #ifdef PLATFORM_ESP32
@@ -2326,14 +2499,26 @@ void setup() {
 
     Serial.printf("[Main] Initial state: %s\n",
                   StateMachine::getStateName(stateMachine.getState()));
+
+    // Watch loop() for blocking calls from here on
+    StallMonitor::getInstance().begin();
+    MemoryTelemetry::getInstance().begin();
 }
 
 void loop() {
+#if INSTRUMENTATION
+    unsigned long loopStartUs = micros();
+#endif
+    StallMonitor::getInstance().beginIteration();
+
 #ifdef PLATFORM_ESP32
     // Feed watchdog - if we don't reach here within 90s, ESP32 resets
     esp_task_wdt_reset();
 #endif
 
+    pollSerialCommands();
+    MemoryTelemetry::getInstance().loop();
+
     NodeState currentState = stateMachine.getState();
 
 #ifdef PLATFORM_ESP32
@@ -2393,6 +2578,9 @@ void loop() {
     // ============================================================================
     // Sprint 8: Update Remote Debug System Components
     // ============================================================================
+    // Format deferred log records (before the SD logger and uploader consume them)
+    DebugManager::getInstance().processDeferred();
+
 #ifdef PLATFORM_ESP32
     // Process SD logger queue
     if (offlineStorageEnabled) {
@@ -2430,6 +2618,13 @@ void loop() {
     }
 #endif
 
+#if INSTRUMENTATION
+    // Iteration time without the idle delay
+    static const int loopStage = Instrumentation::getInstance().stageId("loop");
+    Instrumentation::getInstance().record(loopStage, (uint32_t)(micros() - loopStartUs));
+#endif
+    StallMonitor::getInstance().endIteration();
+
     // Small delay to prevent busy-looping
     delay(10);
 }
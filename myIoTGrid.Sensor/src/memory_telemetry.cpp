@@ -0,0 +1,313 @@
+/**
+ * myIoTGrid.Sensor - Memory Telemetry Implementation
+ */
+
+#include "memory_telemetry.h"
+#include <string.h>
+
+#ifdef PLATFORM_ESP32
+#include <esp_heap_caps.h>
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 2, 0)
+#define MEMORY_FAILED_ALLOC_HOOK 1
+#endif
+#elif MEMORY_TAGGING && defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#ifdef PLATFORM_ESP32
+#define MEMORY_LOCK()   taskENTER_CRITICAL(&_mux)
+#define MEMORY_UNLOCK() taskEXIT_CRITICAL(&_mux)
+#else
+#define MEMORY_LOCK()
+#define MEMORY_UNLOCK()
+#endif
+
+namespace {
+
+#ifdef PLATFORM_ESP32
+uint32_t capabilityFlags(HeapCapability capability) {
+    switch (capability) {
+        case HeapCapability::BYTE_ADDRESSABLE: return MALLOC_CAP_8BIT;
+        case HeapCapability::INTERNAL:         return MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+        case HeapCapability::DMA:              return MALLOC_CAP_DMA;
+        case HeapCapability::SPIRAM:           return MALLOC_CAP_SPIRAM;
+        default:                               return 0;
+    }
+}
+#endif
+
+} // namespace
+
+uint8_t HeapStats::fragmentationPercent() const {
+    if (freeBytes == 0) return 0;
+    return (uint8_t)(100 - (uint64_t)largestFreeBlock * 100 / freeBytes);
+}
+
+MemoryTelemetry& MemoryTelemetry::getInstance() {
+    static MemoryTelemetry instance;
+    return instance;
+}
+
+MemoryTelemetry::MemoryTelemetry()
+    : _trendHead(0)
+    , _trendCount(0)
+    , _lastSampleMs(0)
+    , _started(false)
+    , _failedAllocs(0)
+    , _lastFailedBytes(0)
+    , _lastFailedCaps(0)
+#if MEMORY_TAGGING
+    , _tagCount(0)
+#endif
+{
+#if MEMORY_TAGGING && defined(PLATFORM_ESP32)
+    portMUX_INITIALIZE(&_mux);
+#endif
+}
+
+void MemoryTelemetry::begin() {
+    if (_started) return;
+    _started = true;
+
+#ifdef MEMORY_FAILED_ALLOC_HOOK
+    heap_caps_register_failed_alloc_callback(onAllocFailed);
+#endif
+
+    sample();
+
+    HeapStats internal;
+    if (read(HeapCapability::INTERNAL, internal)) {
+        Serial.printf("[Memory] Internal heap: %lu free, largest block %lu (%u%% fragmented)\n",
+                      (unsigned long)internal.freeBytes, (unsigned long)internal.largestFreeBlock,
+                      internal.fragmentationPercent());
+    }
+}
+
+void MemoryTelemetry::loop() {
+    if (millis() - _lastSampleMs >= config::MEMORY_SAMPLE_INTERVAL_MS) {
+        sample();
+    }
+}
+
+void MemoryTelemetry::sample() {
+    _lastSampleMs = millis();
+
+    HeapStats internal;
+    if (!read(HeapCapability::INTERNAL, internal)) return;
+
+    HeapSample& slot = _trend[_trendHead];
+    slot.uptimeMs = _lastSampleMs;
+    slot.freeBytes = internal.freeBytes;
+    slot.largestFreeBlock = internal.largestFreeBlock;
+    slot.minFreeBytes = internal.minFreeBytes;
+
+    _trendHead = (_trendHead + 1) % config::MEMORY_TREND_SAMPLES;
+    if (_trendCount < config::MEMORY_TREND_SAMPLES) _trendCount++;
+}
+
+bool MemoryTelemetry::read(HeapCapability capability, HeapStats& out) const {
+#ifdef PLATFORM_ESP32
+    uint32_t caps = capabilityFlags(capability);
+    if (caps == 0) return false;
+
+    out.totalBytes = heap_caps_get_total_size(caps);
+    if (out.totalBytes == 0) return false;  // e.g., no PSRAM fitted
+    out.freeBytes = heap_caps_get_free_size(caps);
+    out.largestFreeBlock = heap_caps_get_largest_free_block(caps);
+    out.minFreeBytes = heap_caps_get_minimum_free_size(caps);
+    return true;
+#else
+    (void)capability;
+    (void)out;
+    return false;
+#endif
+}
+
+const char* MemoryTelemetry::getCapabilityName(HeapCapability capability) {
+    switch (capability) {
+        case HeapCapability::BYTE_ADDRESSABLE: return "8bit";
+        case HeapCapability::INTERNAL:         return "internal";
+        case HeapCapability::DMA:              return "dma";
+        case HeapCapability::SPIRAM:           return "spiram";
+        default:                               return "unknown";
+    }
+}
+
+// Runs in the failing allocation's task; counters only
+void MemoryTelemetry::onAllocFailed(size_t size, uint32_t caps, const char* functionName) {
+    (void)functionName;
+    MemoryTelemetry& self = getInstance();
+    self._failedAllocs.fetch_add(1, std::memory_order_relaxed);
+    self._lastFailedBytes.store((uint32_t)size, std::memory_order_relaxed);
+    self._lastFailedCaps.store(caps, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Allocation Sites (MEMORY_TAGGING)
+// ============================================================================
+
+#if MEMORY_TAGGING
+int32_t MemoryTelemetry::heapUsedBytes() {
+#ifdef PLATFORM_ESP32
+    return (int32_t)(heap_caps_get_total_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_8BIT));
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return (int32_t)mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+int MemoryTelemetry::tagId(const char* name) {
+    MEMORY_LOCK();
+    size_t i = 0;
+    while (i < _tagCount && strncmp(_tags[i].name, name, sizeof(_tags[i].name) - 1) != 0) i++;
+    if (i == _tagCount && _tagCount < config::MEMORY_MAX_TAGS) {
+        Tag& tag = _tags[_tagCount++];
+        snprintf(tag.name, sizeof(tag.name), "%s", name);
+        tag.calls = 0;
+        tag.netBytes = 0;
+        tag.maxBytes = 0;
+    }
+    int id = i < _tagCount ? (int)i : -1;
+    MEMORY_UNLOCK();
+    return id;
+}
+
+void MemoryTelemetry::recordTag(int tagId, int32_t retainedBytes) {
+    if (tagId < 0) return;
+
+    MEMORY_LOCK();
+    if ((size_t)tagId < _tagCount) {
+        Tag& tag = _tags[tagId];
+        tag.calls++;
+        tag.netBytes += retainedBytes;
+        if (retainedBytes > tag.maxBytes) tag.maxBytes = retainedBytes;
+    }
+    MEMORY_UNLOCK();
+}
+
+size_t MemoryTelemetry::copyTags(Tag* out) const {
+    MEMORY_LOCK();
+    size_t tagCount = _tagCount;
+    memcpy(out, _tags, sizeof(Tag) * tagCount);
+    MEMORY_UNLOCK();
+    return tagCount;
+}
+#endif
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+String MemoryTelemetry::toJson() const {
+    String json = "{\"uptimeMs\":" + String(millis());
+
+    json += ",\"capabilities\":[";
+    bool first = true;
+    for (uint8_t i = 0; i < (uint8_t)HeapCapability::COUNT; i++) {
+        HeapCapability capability = (HeapCapability)i;
+        HeapStats stats;
+        if (!read(capability, stats)) continue;
+
+        if (!first) json += ",";
+        first = false;
+        json += "{\"name\":\"" + String(getCapabilityName(capability)) + "\"";
+        json += ",\"total\":" + String(stats.totalBytes);
+        json += ",\"free\":" + String(stats.freeBytes);
+        json += ",\"largestFree\":" + String(stats.largestFreeBlock);
+        json += ",\"minFree\":" + String(stats.minFreeBytes);
+        json += ",\"fragmentation\":" + String(stats.fragmentationPercent()) + "}";
+    }
+    json += "]";
+
+    // Oldest first, one array per field
+    size_t oldest = (_trendHead + config::MEMORY_TREND_SAMPLES - _trendCount) % config::MEMORY_TREND_SAMPLES;
+    String freeBytes, largestFree, minFree;
+    for (size_t n = 0; n < _trendCount; n++) {
+        const HeapSample& sample = _trend[(oldest + n) % config::MEMORY_TREND_SAMPLES];
+        if (n > 0) {
+            freeBytes += ",";
+            largestFree += ",";
+            minFree += ",";
+        }
+        freeBytes += String(sample.freeBytes);
+        largestFree += String(sample.largestFreeBlock);
+        minFree += String(sample.minFreeBytes);
+    }
+    json += ",\"trend\":{\"intervalMs\":" + String(config::MEMORY_SAMPLE_INTERVAL_MS);
+    json += ",\"free\":[" + freeBytes + "]";
+    json += ",\"largestFree\":[" + largestFree + "]";
+    json += ",\"minFree\":[" + minFree + "]}";
+
+    json += ",\"failedAllocs\":" + String(getFailedAllocCount());
+    json += ",\"lastFailedBytes\":" + String(_lastFailedBytes.load(std::memory_order_relaxed));
+    json += ",\"lastFailedCaps\":" + String(_lastFailedCaps.load(std::memory_order_relaxed));
+
+#if MEMORY_TAGGING
+    Tag tags[config::MEMORY_MAX_TAGS];
+    size_t tagCount = copyTags(tags);
+    json += ",\"tags\":[";
+    for (size_t i = 0; i < tagCount; i++) {
+        if (i > 0) json += ",";
+        json += "{\"name\":\"" + String(tags[i].name) + "\"";
+        json += ",\"calls\":" + String(tags[i].calls);
+        json += ",\"netBytes\":" + String(tags[i].netBytes);
+        json += ",\"maxBytes\":" + String(tags[i].maxBytes) + "}";
+    }
+    json += "]";
+#endif
+
+    json += "}";
+    return json;
+}
+
+void MemoryTelemetry::printReport() const {
+    bool any = false;
+    for (uint8_t i = 0; i < (uint8_t)HeapCapability::COUNT; i++) {
+        HeapCapability capability = (HeapCapability)i;
+        HeapStats stats;
+        if (!read(capability, stats)) continue;
+        if (!any) {
+            Serial.printf("[Memory]   %-9s %9s %9s %9s %9s %6s\n",
+                          "heap", "total", "free", "largest", "min free", "frag");
+            any = true;
+        }
+        Serial.printf("[Memory]   %-9s %9lu %9lu %9lu %9lu %5u%%\n", getCapabilityName(capability),
+                      (unsigned long)stats.totalBytes, (unsigned long)stats.freeBytes,
+                      (unsigned long)stats.largestFreeBlock, (unsigned long)stats.minFreeBytes,
+                      stats.fragmentationPercent());
+    }
+    if (!any) {
+        Serial.println("[Memory]   (no heap capabilities on this platform)");
+    }
+
+    if (_trendCount > 0) {
+        Serial.printf("[Memory] Internal heap trend (every %lu s, oldest first):\n",
+                      (unsigned long)(config::MEMORY_SAMPLE_INTERVAL_MS / 1000));
+        size_t oldest = (_trendHead + config::MEMORY_TREND_SAMPLES - _trendCount) % config::MEMORY_TREND_SAMPLES;
+        for (size_t n = 0; n < _trendCount; n++) {
+            const HeapSample& sample = _trend[(oldest + n) % config::MEMORY_TREND_SAMPLES];
+            Serial.printf("[Memory]   %8lu s  free %7lu  largest %7lu  min %7lu\n", sample.uptimeMs / 1000,
+                          (unsigned long)sample.freeBytes, (unsigned long)sample.largestFreeBlock,
+                          (unsigned long)sample.minFreeBytes);
+        }
+    }
+
+    Serial.printf("[Memory] Failed allocations: %lu", (unsigned long)getFailedAllocCount());
+    if (getFailedAllocCount() > 0) {
+        Serial.printf(" (last %lu bytes, caps 0x%lx)",
+                      (unsigned long)_lastFailedBytes.load(std::memory_order_relaxed),
+                      (unsigned long)_lastFailedCaps.load(std::memory_order_relaxed));
+    }
+    Serial.println();
+
+#if MEMORY_TAGGING
+    Tag tags[config::MEMORY_MAX_TAGS];
+    size_t tagCount = copyTags(tags);
+    for (size_t i = 0; i < tagCount; i++) {
+        Serial.printf("[Memory]   tag %-15s %8lu calls  net %8ld bytes  max %7ld bytes\n", tags[i].name,
+                      (unsigned long)tags[i].calls, (long)tags[i].netBytes, (long)tags[i].maxBytes);
+    }
+#endif
+}
@@ -0,0 +1,116 @@
+/**
+ * myIoTGrid.Sensor - Native Entry Point
+ *
+ * Runs the firmware's setup()/loop() as a Linux process (env:native), with
+ * simulated sensors and the libcurl/BSD socket network stack.
+ *
+ * Session replay (SESSION_REPLAY=<trace>): the loop runs on virtual time
+ * until the recorded session is used up, then prints a profile of the main
+ * loop per state and the hot-path timing histograms (instrumentation.h).
+ * The process exits with 2 if the firmware diverged from the recording
+ * (calls without a recorded counterpart). A recording with
+ * SESSION_RECORD_SECONDS ends the same way after that long.
+ *
+ * The serial console reads stdin: type "timing" for the histograms.
+ *
+ *   SESSION_RECORD=session.trace .pio/build/native/program
+ *   SESSION_REPLAY=session.trace .pio/build/native/program
+ *
+ * test/replay_smoke.sh records a session against a stub Hub, replays it
+ * and compares the traces.
+ */
+
+#if defined(PLATFORM_NATIVE) && !defined(FLEET_SIMULATOR)
+
+#include <Arduino.h>
+#include "instrumentation.h"
+#include "session_trace.h"
+#include "state_machine.h"
+#include "virtual_clock.h"
+#include <chrono>
+#include <map>
+
+// Firmware entry points and state machine (main.cpp)
+void setup();
+void loop();
+extern StateMachine stateMachine;
+
+namespace {
+
+struct LoopStats {
+    unsigned long iterations;
+    uint64_t totalMicros;
+    uint64_t maxMicros;
+
+    LoopStats() : iterations(0), totalMicros(0), maxMicros(0) {}
+};
+
+uint64_t wallMicrosSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void printProfile(const SessionTrace& trace, const std::map<NodeState, LoopStats>& loops,
+                  uint64_t setupMicros, uint64_t wallMicros, uint64_t deviceMicros) {
+    double wallSeconds = wallMicros / 1e6;
+    double deviceSeconds = deviceMicros / 1e6;
+
+    Serial.println();
+    Serial.println("[Replay] ========================================");
+    Serial.printf("[Replay] Session: %.1f s device time in %.2f s (%.0fx)\n",
+                  deviceSeconds, wallSeconds, wallSeconds > 0 ? deviceSeconds / wallSeconds : 0.0);
+    if (trace.isReplaying()) {
+        Serial.printf("[Replay] Events: %u/%u replayed, %u misses, max drift %lu ms\n",
+                      (unsigned)trace.getReplayedCount(), (unsigned)trace.getEventCount(),
+                      (unsigned)trace.getMissCount(), trace.getMaxDriftMs());
+    } else {
+        Serial.printf("[Replay] Events: %u recorded\n", (unsigned)trace.getEventCount());
+    }
+    Serial.printf("[Replay] setup(): %.3f ms\n", setupMicros / 1000.0);
+    Serial.println("[Replay] loop() by state (wall time):");
+    for (const auto& entry : loops) {
+        const LoopStats& stats = entry.second;
+        Serial.printf("[Replay]   %-16s %8lu calls  mean %8.1f us  max %8llu us  total %8.3f s\n",
+                      StateMachine::getStateName(entry.first), stats.iterations,
+                      static_cast<double>(stats.totalMicros) / stats.iterations,
+                      static_cast<unsigned long long>(stats.maxMicros), stats.totalMicros / 1e6);
+    }
+    Serial.println("[Replay] ========================================");
+}
+
+} // namespace
+
+int main() {
+    SessionTrace& trace = SessionTrace::getInstance();
+    if (!trace.begin()) {
+        return 1;
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+    uint64_t deviceStart = hal::native::Clock::micros();
+
+    setup();
+    uint64_t setupMicros = wallMicrosSince(wallStart);
+
+    std::map<NodeState, LoopStats> loops;
+    while (!trace.isFinished()) {
+        NodeState state = stateMachine.getState();
+        auto loopStart = std::chrono::steady_clock::now();
+        loop();
+        uint64_t micros = wallMicrosSince(loopStart);
+
+        LoopStats& stats = loops[state];
+        stats.iterations++;
+        stats.totalMicros += micros;
+        if (micros > stats.maxMicros) {
+            stats.maxMicros = micros;
+        }
+    }
+
+    printProfile(trace, loops, setupMicros, wallMicrosSince(wallStart),
+                 hal::native::Clock::micros() - deviceStart);
+    Instrumentation::getInstance().printReport();
+    return trace.getMissCount() == 0 ? 0 : 2;
+}
+
+#endif // PLATFORM_NATIVE && !FLEET_SIMULATOR
@@ -4,7 +4,49 @@
  */
 
 #include "sd_logger.h"
-#include <ArduinoJson.h>
+#include <string.h>
+
+namespace {
+
+bool appendRaw(char* out, size_t& pos, size_t capacity, const char* text) {
+    size_t length = strlen(text);
+    if (pos + length > capacity) return false;
+    memcpy(out + pos, text, length);
+    pos += length;
+    return true;
+}
+
+// JSON string content, escaped like ArduinoJson does
+bool appendEscaped(char* out, size_t& pos, size_t capacity, const char* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        char c = data[i];
+        char escaped[7];
+        const char* text = nullptr;
+        switch (c) {
+            case '"':  text = "\\\""; break;
+            case '\\': text = "\\\\"; break;
+            case '\b': text = "\\b"; break;
+            case '\f': text = "\\f"; break;
+            case '\n': text = "\\n"; break;
+            case '\r': text = "\\r"; break;
+            case '\t': text = "\\t"; break;
+            default:
+                if ((uint8_t)c < 0x20) {
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", (uint8_t)c);
+                    text = escaped;
+                }
+        }
+        if (text) {
+            if (!appendRaw(out, pos, capacity, text)) return false;
+        } else {
+            if (pos + 1 > capacity) return false;
+            out[pos++] = c;
+        }
+    }
+    return true;
+}
+
+} // namespace
 
 // Singleton instance
 SDLogger& SDLogger::getInstance() {
@@ -16,19 +58,27 @@ SDLogger::SDLogger()
     : _sdAvailable(false)
     , _currentFileNumber(1)
     , _currentFileSize(0)
+    , _recordHead(0)
+    , _recordCount(0)
+    , _recordCapacity(config::SD_LOG_POOL_SLOTS)
+    , _writeLength(0)
+    , _writeLines(0)
     , _lastFlushTime(0) {
 #ifdef PLATFORM_ESP32
-    _logQueue = nullptr;
+    portMUX_INITIALIZE(&_recordMux);
     _fileMutex = nullptr;
+    _writerTask = nullptr;
 #endif
 }
 
 SDLogger::~SDLogger() {
-    closeCurrentFile();
 #ifdef PLATFORM_ESP32
-    if (_logQueue) {
-        vQueueDelete(_logQueue);
+    if (_writerTask) {
+        vTaskDelete(_writerTask);
     }
+#endif
+    closeCurrentFile();
+#ifdef PLATFORM_ESP32
     if (_fileMutex) {
         vSemaphoreDelete(_fileMutex);
     }
@@ -39,14 +89,14 @@ bool SDLogger::begin(int csPin) {
 #ifdef PLATFORM_ESP32
     Serial.printf("[SDLogger] Initializing SD card on CS pin %d...\n", csPin);
 
-    // Create mutex and queue
+    // Create mutex (records live in a fixed ring, no queue needed)
     _fileMutex = xSemaphoreCreateMutex();
-    _logQueue = xQueueCreate(_config.maxQueueSize, sizeof(LogEntry*));
-
-    if (!_fileMutex || !_logQueue) {
-        Serial.println("[SDLogger] Failed to create mutex/queue");
+    if (!_fileMutex) {
+        Serial.println("[SDLogger] Failed to create mutex");
         return false;
     }
+    _recordCapacity = (_config.maxQueueSize > 0 && (size_t)_config.maxQueueSize < config::SD_LOG_POOL_SLOTS)
+                      ? (size_t)_config.maxQueueSize : config::SD_LOG_POOL_SLOTS;
 
     // Initialize SD card
     if (!SD.begin(csPin)) {
@@ -89,6 +139,14 @@ bool SDLogger::begin(int csPin) {
     _sdAvailable = true;
     _lastFlushTime = millis();
 
+    // Low-priority writer; without it loop() writes from the main task
+    if (!_writerTask &&
+        xTaskCreate(writerTask, "sd_logger", config::SD_LOG_TASK_STACK_SIZE,
+                    this, 1, &_writerTask) != pdPASS) {
+        _writerTask = nullptr;
+        Serial.println("[SDLogger] Writer task not started - writing from main loop");
+    }
+
     // Register with DebugManager
     DebugManager::getInstance().onLog([this](const LogEntry& entry) {
         this->log(entry);
@@ -113,15 +171,39 @@ void SDLogger::log(const LogEntry& entry) {
     if (!isEnabled()) return;
 
 #ifdef PLATFORM_ESP32
-    // Create a copy of the entry for the queue
-    LogEntry* entryCopy = new LogEntry(entry);
+    bool wakeWriter = false;
+
+    taskENTER_CRITICAL(&_recordMux);
+    if (_recordCount < _recordCapacity) {
+        Record& record = _records[(_recordHead + _recordCount) % _recordCapacity];
+        record.timestamp = entry.timestamp;
+        record.level = entry.level;
+        record.category = entry.category;
+
+        // Message first, stack trace gets what is left
+        size_t messageLength = entry.message.length();
+        if (messageLength > sizeof(record.text)) messageLength = sizeof(record.text);
+        memcpy(record.text, entry.message.c_str(), messageLength);
+        size_t stackLength = entry.stackTrace.length();
+        if (stackLength > sizeof(record.text) - messageLength) {
+            stackLength = sizeof(record.text) - messageLength;
+        }
+        memcpy(record.text + messageLength, entry.stackTrace.c_str(), stackLength);
+        record.messageLength = (uint16_t)messageLength;
+        record.stackLength = (uint16_t)stackLength;
 
-    // Try to add to queue (non-blocking)
-    if (xQueueSend(_logQueue, &entryCopy, 0) != pdTRUE) {
-        // Queue full, drop the entry
-        delete entryCopy;
+        _recordCount++;
+        if (_recordCount > _stats.maxQueued) _stats.maxQueued = _recordCount;
+        wakeWriter = _recordCount == config::SD_LOG_BATCH_THRESHOLD;
+    } else {
+        // Ring full: drop the entry, never block the caller
         _stats.entriesDropped++;
     }
+    taskEXIT_CRITICAL(&_recordMux);
+
+    if (wakeWriter && _writerTask) {
+        xTaskNotifyGive(_writerTask);
+    }
 #endif
 }
 
@@ -129,82 +211,151 @@ void SDLogger::loop() {
     if (!isEnabled()) return;
 
 #ifdef PLATFORM_ESP32
-    // Process queue
-    LogEntry* entry;
-    int processedCount = 0;
-    const int maxPerLoop = 10;  // Process max 10 entries per loop
-
-    while (processedCount < maxPerLoop && xQueueReceive(_logQueue, &entry, 0) == pdTRUE) {
-        writeEntry(*entry);
-        delete entry;
-        processedCount++;
-    }
+    if (_writerTask) return;  // Writer task batches on its own
 
-    // Periodic flush
-    if (millis() - _lastFlushTime >= _config.flushIntervalMs) {
-        flush();
+    if (_recordCount >= config::SD_LOG_BATCH_THRESHOLD ||
+        millis() - _lastFlushTime >= _config.flushIntervalMs) {
+        writePending();
     }
 #endif
 }
 
 void SDLogger::flush() {
 #ifdef PLATFORM_ESP32
-    if (!_sdAvailable || !_currentFile) return;
+    if (!_sdAvailable) return;
 
-    if (xSemaphoreTake(_fileMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        _currentFile.flush();
-        _lastFlushTime = millis();
-        _stats.lastFlushTime = _lastFlushTime;
-        xSemaphoreGive(_fileMutex);
+    if (_writerTask) {
+        xTaskNotifyGive(_writerTask);
+    } else {
+        writePending();
     }
 #endif
 }
 
-void SDLogger::writeEntry(const LogEntry& entry) {
+void SDLogger::writerTask(void* param) {
 #ifdef PLATFORM_ESP32
-    if (xSemaphoreTake(_fileMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    // Open file if not open
-    if (!_currentFile) {
-        openCurrentFile();
+    SDLogger* self = static_cast<SDLogger*>(param);
+    for (;;) {
+        // Woken by a full batch, flush(), or the flush interval
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(self->_config.flushIntervalMs));
+        if (self->isEnabled()) {
+            self->writePending();
+        }
     }
+#else
+    (void)param;
+#endif
+}
 
-    if (_currentFile) {
-        String line = formatEntry(entry);
-        size_t written = _currentFile.println(line);
+size_t SDLogger::writePending() {
+    size_t written = 0;
 
-        if (written > 0) {
-            _currentFileSize += written + 1;  // +1 for newline
-            _stats.bytesWritten += written + 1;
-            _stats.entriesWritten++;
+#ifdef PLATFORM_ESP32
+    Record record;
+    unsigned long now = millis();
+    unsigned long oldestLatency = 0;
+
+    for (;;) {
+        taskENTER_CRITICAL(&_recordMux);
+        bool available = _recordCount > 0;
+        if (available) {
+            record = _records[_recordHead];
+            _recordHead = (_recordHead + 1) % _recordCapacity;
+            _recordCount--;
+        }
+        taskEXIT_CRITICAL(&_recordMux);
+        if (!available) break;
 
-            // Check if rotation needed
-            rotateFileIfNeeded();
+        if (!formatRecord(record)) {
+            writeBuffer();
+            formatRecord(record);
         }
+
+        unsigned long latency = now - record.timestamp;
+        if (latency > oldestLatency) oldestLatency = latency;
+        written++;
     }
+    writeBuffer();
 
-    xSemaphoreGive(_fileMutex);
+    if (xSemaphoreTake(_fileMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        if (_currentFile) {
+            _currentFile.flush();
+        }
+        _lastFlushTime = millis();
+        _stats.lastFlushTime = _lastFlushTime;
+        if (written > 0) {
+            _stats.batchesWritten++;
+            _stats.lastLatencyMs = oldestLatency;
+            if (oldestLatency > _stats.maxLatencyMs) _stats.maxLatencyMs = oldestLatency;
+        }
+        xSemaphoreGive(_fileMutex);
+    }
 #endif
+
+    return written;
 }
 
-String SDLogger::formatEntry(const LogEntry& entry) const {
+bool SDLogger::formatRecord(const Record& record) {
     // JSON-Lines format for easy parsing
-    JsonDocument doc;
+    const size_t capacity = sizeof(_writeBuffer);
+    size_t pos = _writeLength;
+    char number[16];
+    snprintf(number, sizeof(number), "%lu", record.timestamp);
+
+    bool fits = appendRaw(_writeBuffer, pos, capacity, "{\"ts\":") &&
+                appendRaw(_writeBuffer, pos, capacity, number) &&
+                appendRaw(_writeBuffer, pos, capacity, ",\"lvl\":\"") &&
+                appendRaw(_writeBuffer, pos, capacity, DebugManager::levelToString(record.level)) &&
+                appendRaw(_writeBuffer, pos, capacity, "\",\"cat\":\"") &&
+                appendRaw(_writeBuffer, pos, capacity, DebugManager::categoryToString(record.category)) &&
+                appendRaw(_writeBuffer, pos, capacity, "\",\"msg\":\"") &&
+                appendEscaped(_writeBuffer, pos, capacity, record.text, record.messageLength) &&
+                appendRaw(_writeBuffer, pos, capacity, "\"");
+
+    if (fits && record.stackLength > 0) {
+        fits = appendRaw(_writeBuffer, pos, capacity, ",\"stack\":\"") &&
+               appendEscaped(_writeBuffer, pos, capacity,
+                             record.text + record.messageLength, record.stackLength) &&
+               appendRaw(_writeBuffer, pos, capacity, "\"");
+    }
+    fits = fits && appendRaw(_writeBuffer, pos, capacity, "}\n");
+
+    if (!fits) return false;
+    _writeLength = pos;
+    _writeLines++;
+    return true;
+}
+
+void SDLogger::writeBuffer() {
+#ifdef PLATFORM_ESP32
+    if (_writeLength == 0) return;
+
+    if (xSemaphoreTake(_fileMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        // Open file if not open
+        if (!_currentFile) {
+            openCurrentFile();
+        }
 
-    doc["ts"] = entry.timestamp;
-    doc["lvl"] = DebugManager::levelToString(entry.level);
-    doc["cat"] = DebugManager::categoryToString(entry.category);
-    doc["msg"] = entry.message;
+        if (_currentFile) {
+            size_t written = _currentFile.write((const uint8_t*)_writeBuffer, _writeLength);
+            if (written > 0) {
+                _currentFileSize += written;
+                _stats.bytesWritten += written;
+                _stats.entriesWritten += _writeLines;
+
+                // Check if rotation needed
+                rotateFileIfNeeded();
+            }
+        }
 
-    if (entry.stackTrace.length() > 0) {
-        doc["stack"] = entry.stackTrace;
+        xSemaphoreGive(_fileMutex);
+    } else {
+        _stats.entriesDropped += _writeLines;
     }
+#endif
 
-    String output;
-    serializeJson(doc, output);
-    return output;
+    _writeLength = 0;
+    _writeLines = 0;
 }
 
 void SDLogger::rotateFileIfNeeded() {
@@ -8,62 +8,49 @@
 #include "hardware_scanner.h"
 #include "uart_manager.h"
 #include "debug_manager.h"
+#include "instrumentation.h"
+#include "session_trace.h"
+#include <climits>
+
+#ifdef PLATFORM_NATIVE
+#include "simulated_sensor.h"
+#include <cmath>
+#endif
 
 // Default I2C pins for ESP32
-#define DEFAULT_SDA_PIN 21
-#define DEFAULT_SCL_PIN 22
+#define DEFAULT_SDA_PIN config::I2C_DEFAULT_SDA_PIN
+#define DEFAULT_SCL_PIN config::I2C_DEFAULT_SCL_PIN
 
 SensorReader::SensorReader()
     : _initialized(false)
 #ifdef PLATFORM_ESP32
-    , _bme280_0x76(nullptr), _bme280_0x77(nullptr)
-    , _bme280_0x76_ready(false), _bme280_0x77_ready(false)
-    , _bme680_0x76(nullptr), _bme680_0x77(nullptr)
-    , _bme680_0x76_ready(false), _bme680_0x77_ready(false)
-    , _sht31_0x44(nullptr), _sht31_0x45(nullptr)
-    , _sht31_0x44_ready(false), _sht31_0x45_ready(false)
     , _oneWire(nullptr), _ds18b20(nullptr)
     , _ds18b20_ready(false), _ds18b20_pin(-1)
-    , _bh1750_0x23(nullptr), _bh1750_0x5C(nullptr)
-    , _bh1750_0x23_ready(false), _bh1750_0x5C_ready(false)
-    , _tsl2561_0x29(nullptr), _tsl2561_0x39(nullptr), _tsl2561_0x49(nullptr)
-    , _tsl2561_0x29_ready(false), _tsl2561_0x39_ready(false), _tsl2561_0x49_ready(false)
     , _scd30(nullptr), _scd30_ready(false)
     , _scd4x(nullptr), _scd4x_ready(false)
-    , _ccs811_0x5A(nullptr), _ccs811_0x5B(nullptr)
-    , _ccs811_0x5A_ready(false), _ccs811_0x5B_ready(false)
     , _sgp30(nullptr), _sgp30_ready(false)
     , _vl53l0x(nullptr), _vl53l0x_ready(false)
-    , _ads1115_0x48(nullptr), _ads1115_0x49(nullptr)
-    , _ads1115_0x48_ready(false), _ads1115_0x49_ready(false)
     , _dht22(nullptr), _dht22_ready(false), _dht22_pin(-1)
     , _ultrasonic_trigger_pin(-1), _ultrasonic_echo_pin(-1), _ultrasonic_ready(false)
-    , _gps(nullptr), _gpsSerial(nullptr), _gps_ready(false), _gps_rx_pin(-1), _gps_tx_pin(-1), _gps_debug_ran(false)
+    , _gps(nullptr), _gpsLease(nullptr), _gps_ready(false), _gps_rx_pin(-1), _gps_tx_pin(-1), _gps_debug_ran(false)
     , _gps_latitude(0.0), _gps_longitude(0.0), _gps_altitude(0.0), _gps_speed(0.0)
     , _gps_satellites(0), _gps_fix_type(0), _gps_hdop(99.99)
     , _gps_location_valid(false), _gps_altitude_valid(false), _gps_speed_valid(false)
     , _gps_last_update(0), _gps_last_valid_fix(0)
-    , _sr04m2Serial(nullptr), _sr04m2_ready(false), _sr04m2_rx_pin(-1), _sr04m2_tx_pin(-1)
-    , _currentSdaPin(-1), _currentSclPin(-1)
+    , _sr04m2Lease(nullptr), _sr04m2_ready(false), _sr04m2_rx_pin(-1), _sr04m2_tx_pin(-1)
+    , _activeBus(-1), _activeWire(&Wire), _bleBus(-1), _stateMutex(nullptr)
 #endif
 {
 }
 
 SensorReader::~SensorReader() {
 #ifdef PLATFORM_ESP32
-    delete _bme280_0x76; delete _bme280_0x77;
-    delete _bme680_0x76; delete _bme680_0x77;
-    delete _sht31_0x44; delete _sht31_0x45;
+    // Pooled I2C drivers are destroyed by their pools
     delete _ds18b20; delete _oneWire;
-    delete _bh1750_0x23; delete _bh1750_0x5C;
-    delete _tsl2561_0x29; delete _tsl2561_0x39; delete _tsl2561_0x49;
     delete _scd30; delete _scd4x;
-    delete _ccs811_0x5A; delete _ccs811_0x5B;
     delete _sgp30; delete _vl53l0x;
-    delete _ads1115_0x48; delete _ads1115_0x49;
     delete _dht22;
     delete _gps;
-    delete _sr04m2Serial;
 #endif
 }
 
@@ -71,6 +58,9 @@ void SensorReader::init() {
     if (_initialized) return;
     Serial.println("[SensorReader] Initializing...");
 #ifdef PLATFORM_ESP32
+    if (!_stateMutex) {
+        _stateMutex = xSemaphoreCreateMutex();
+    }
     initI2C(DEFAULT_SDA_PIN, DEFAULT_SCL_PIN);
 #endif
     _initialized = true;
@@ -79,16 +69,81 @@ void SensorReader::init() {
 
 #ifdef PLATFORM_ESP32
 
-void SensorReader::initI2C(int sdaPin, int sclPin) {
+int SensorReader::initI2C(int sdaPin, int sclPin, int requiredController) {
     if (sdaPin < 0) sdaPin = DEFAULT_SDA_PIN;
     if (sclPin < 0) sclPin = DEFAULT_SCL_PIN;
-    if (_currentSdaPin == sdaPin && _currentSclPin == sclPin) return;
 
-    Serial.printf("[SensorReader] Initializing I2C on SDA=%d, SCL=%d\n", sdaPin, sclPin);
-    Wire.end();
-    Wire.begin(sdaPin, sclPin);
-    _currentSdaPin = sdaPin;
-    _currentSclPin = sclPin;
+    // Each pin pair is registered once; switching between buses only swaps
+    // the TwoWire instance new drivers bind to, the hardware stays configured
+    I2CBusManager& busMgr = I2CBusManager::getInstance();
+    int busId = busMgr.acquire(sdaPin, sclPin, requiredController);
+    if (busId < 0) {
+        Serial.printf("[SensorReader] No I2C bus available for SDA=%d, SCL=%d\n", sdaPin, sclPin);
+        return -1;
+    }
+    _activeBus = busId;
+    _activeWire = busMgr.getWire(busId);
+    return busId;
+}
+
+bool SensorReader::isI2CSensor(const String& code) {
+    return !(code.indexOf("DS18B20") >= 0 || code.indexOf("DALLAS") >= 0 ||
+             code.indexOf("DHT") >= 0 || code.indexOf("AM2302") >= 0 ||
+             code.indexOf("SR04") >= 0 || code.indexOf("ULTRASONIC") >= 0 ||
+             code.indexOf("NEO-6M") >= 0 || code.indexOf("NEO6M") >= 0 ||
+             code.indexOf("GPS") >= 0 || code.indexOf("UBLOX") >= 0);
+}
+
+int SensorReader::getBusForConfig(const SensorAssignmentConfig& config) {
+    String sensorCode = config.sensorCode;
+    sensorCode.toUpperCase();
+    if (!isI2CSensor(sensorCode)) return -1;
+    return i2cBusFor(config);
+}
+
+int SensorReader::i2cBusFor(const SensorAssignmentConfig& config) const {
+    int sdaPin = (config.sdaPin > 0) ? config.sdaPin : DEFAULT_SDA_PIN;
+    int sclPin = (config.sclPin > 0) ? config.sclPin : DEFAULT_SCL_PIN;
+    return I2CBusManager::getInstance().getBusForPins(sdaPin, sclPin);
+}
+
+uint8_t SensorReader::defaultI2CAddress(const String& code) {
+    if (code.indexOf("BME280") >= 0 || code.indexOf("BMP280") >= 0) return 0x76;
+    if (code.indexOf("BME680") >= 0) return 0x76;
+    if (code.indexOf("SHT31") >= 0 || code.indexOf("SHT3X") >= 0) return 0x44;
+    if (code.indexOf("BH1750") >= 0 || code.indexOf("GY302") >= 0 || code.indexOf("GY-302") >= 0) return 0x23;
+    if (code.indexOf("TSL2561") >= 0 || code.indexOf("TSL2591") >= 0) return 0x39;
+    if (code.indexOf("CCS811") >= 0) return 0x5A;
+    if (isADCSensor(code)) return 0x48;
+    return 0;
+}
+
+void SensorReader::releaseUnusedDrivers(const std::vector<SensorAssignmentConfig>& sensors) {
+    auto inUse = [&](int busId, uint8_t address) {
+        for (const auto& sensor : sensors) {
+            if (!sensor.isActive) continue;
+            String code = sensor.sensorCode;
+            code.toUpperCase();
+            if (!isI2CSensor(code)) continue;
+            uint8_t sensorAddress = parseI2CAddress(sensor.i2cAddress);
+            if (sensorAddress == 0) sensorAddress = defaultI2CAddress(code);
+            if (sensorAddress == address && i2cBusFor(sensor) == busId) return true;
+        }
+        return false;
+    };
+
+    // Scanners first: they read through the ADS1115 drivers
+    size_t released = _adsScannerPool.releaseUnused(inUse);
+    released += _ads1115Pool.releaseUnused(inUse);
+    released += _bme280Pool.releaseUnused(inUse);
+    released += _bme680Pool.releaseUnused(inUse);
+    released += _sht31Pool.releaseUnused(inUse);
+    released += _bh1750Pool.releaseUnused(inUse);
+    released += _tsl2561Pool.releaseUnused(inUse);
+    released += _ccs811Pool.releaseUnused(inUse);
+    if (released > 0) {
+        Serial.printf("[SensorReader] Released %u unused sensor drivers\n", (unsigned)released);
+    }
 }
 
 uint8_t SensorReader::parseI2CAddress(const String& addressStr) {
@@ -106,18 +161,17 @@ uint8_t SensorReader::parseI2CAddress(const String& addressStr) {
 
 bool SensorReader::initBME280(uint8_t address) {
     Serial.printf("[SensorReader] Initializing BME280 at 0x%02X...\n", address);
-    Adafruit_BME280** bmePtr = (address == 0x76) ? &_bme280_0x76 : &_bme280_0x77;
-    bool* readyPtr = (address == 0x76) ? &_bme280_0x76_ready : &_bme280_0x77_ready;
-
     if (address != 0x76 && address != 0x77) {
         Serial.printf("[SensorReader] Invalid BME280 address: 0x%02X\n", address);
         return false;
     }
-    if (*readyPtr) return true;
-    if (!*bmePtr) *bmePtr = new Adafruit_BME280();
+    auto* slot = reserveSlot(_bme280Pool, "BME280", address);
+    if (!slot) return false;
+    if (slot->ready) return true;
+    Adafruit_BME280* bme = _bme280Pool.construct(slot);
 
-    if ((*bmePtr)->begin(address, &Wire)) {
-        *readyPtr = true;
+    if (bme->begin(address, _activeWire)) {
+        slot->ready = true;
         Serial.printf("[SensorReader] BME280 at 0x%02X initialized\n", address);
         return true;
     }
@@ -125,10 +179,8 @@ bool SensorReader::initBME280(uint8_t address) {
     return false;
 }
 
-Adafruit_BME280* SensorReader::getBME280(uint8_t address) {
-    if (address == 0x76 && _bme280_0x76_ready) return _bme280_0x76;
-    if (address == 0x77 && _bme280_0x77_ready) return _bme280_0x77;
-    return nullptr;
+Adafruit_BME280* SensorReader::getBME280(int busId, uint8_t address) {
+    return _bme280Pool.find(busId, address);
 }
 
 // ============================================================================
@@ -137,30 +189,27 @@ Adafruit_BME280* SensorReader::getBME280(uint8_t address) {
 
 bool SensorReader::initBME680(uint8_t address) {
     Serial.printf("[SensorReader] Initializing BME680 at 0x%02X...\n", address);
-    Adafruit_BME680** bmePtr = (address == 0x76) ? &_bme680_0x76 : &_bme680_0x77;
-    bool* readyPtr = (address == 0x76) ? &_bme680_0x76_ready : &_bme680_0x77_ready;
-
     if (address != 0x76 && address != 0x77) return false;
-    if (*readyPtr) return true;
-    if (!*bmePtr) *bmePtr = new Adafruit_BME680();
-
-    if ((*bmePtr)->begin(address)) {
-        (*bmePtr)->setTemperatureOversampling(BME680_OS_8X);
-        (*bmePtr)->setHumidityOversampling(BME680_OS_2X);
-        (*bmePtr)->setPressureOversampling(BME680_OS_4X);
-        (*bmePtr)->setIIRFilterSize(BME680_FILTER_SIZE_3);
-        (*bmePtr)->setGasHeater(320, 150);
-        *readyPtr = true;
+    auto* slot = reserveSlot(_bme680Pool, "BME680", address);
+    if (!slot) return false;
+    if (slot->ready) return true;
+    Adafruit_BME680* bme = _bme680Pool.construct(slot, _activeWire);
+
+    if (bme->begin(address)) {
+        bme->setTemperatureOversampling(BME680_OS_8X);
+        bme->setHumidityOversampling(BME680_OS_2X);
+        bme->setPressureOversampling(BME680_OS_4X);
+        bme->setIIRFilterSize(BME680_FILTER_SIZE_3);
+        bme->setGasHeater(320, 150);
+        slot->ready = true;
         Serial.printf("[SensorReader] BME680 at 0x%02X initialized\n", address);
         return true;
     }
     return false;
 }
 
-Adafruit_BME680* SensorReader::getBME680(uint8_t address) {
-    if (address == 0x76 && _bme680_0x76_ready) return _bme680_0x76;
-    if (address == 0x77 && _bme680_0x77_ready) return _bme680_0x77;
-    return nullptr;
+Adafruit_BME680* SensorReader::getBME680(int busId, uint8_t address) {
+    return _bme680Pool.find(busId, address);
 }
 
 // ============================================================================
@@ -169,26 +218,28 @@ Adafruit_BME680* SensorReader::getBME680(uint8_t address) {
 
 bool SensorReader::initSHT31(uint8_t address) {
     Serial.printf("[SensorReader] Initializing SHT31 at 0x%02X...\n", address);
-    ClosedCube_SHT31D** shtPtr = (address == 0x44) ? &_sht31_0x44 : &_sht31_0x45;
-    bool* readyPtr = (address == 0x44) ? &_sht31_0x44_ready : &_sht31_0x45_ready;
-
     if (address != 0x44 && address != 0x45) return false;
-    if (*readyPtr) return true;
-    if (!*shtPtr) *shtPtr = new ClosedCube_SHT31D();
+    auto* slot = reserveSlot(_sht31Pool, "SHT31", address);
+    if (!slot) return false;
+    if (slot->ready) return true;
 
-    SHT31D_ErrorCode error = (*shtPtr)->begin(address);
+    // ClosedCube_SHT31D always talks to the global Wire (controller 0)
+    if (_activeWire != &Wire) {
+        Serial.printf("[SensorReader] SHT31 at 0x%02X needs an I2C bus on controller 0\n", address);
+        return false;
+    }
+    ClosedCube_SHT31D* sht = _sht31Pool.construct(slot);
+    SHT31D_ErrorCode error = sht->begin(address);
     if (error == SHT3XD_NO_ERROR) {
-        *readyPtr = true;
+        slot->ready = true;
         Serial.printf("[SensorReader] SHT31 at 0x%02X initialized\n", address);
         return true;
     }
     return false;
 }
 
-ClosedCube_SHT31D* SensorReader::getSHT31(uint8_t address) {
-    if (address == 0x44 && _sht31_0x44_ready) return _sht31_0x44;
-    if (address == 0x45 && _sht31_0x45_ready) return _sht31_0x45;
-    return nullptr;
+ClosedCube_SHT31D* SensorReader::getSHT31(int busId, uint8_t address) {
+    return _sht31Pool.find(busId, address);
 }
 
 // ============================================================================
@@ -238,18 +289,17 @@ bool SensorReader::initDS18B20(int pin) {
 
 bool SensorReader::initBH1750(uint8_t address) {
     Serial.printf("[SensorReader] Initializing BH1750 at 0x%02X...\n", address);
-    BH1750** bhPtr = (address == 0x23) ? &_bh1750_0x23 : &_bh1750_0x5C;
-    bool* readyPtr = (address == 0x23) ? &_bh1750_0x23_ready : &_bh1750_0x5C_ready;
-
     if (address != 0x23 && address != 0x5C) {
         Serial.printf("[SensorReader] Invalid BH1750 address: 0x%02X\n", address);
         return false;
     }
-    if (*readyPtr) return true;
-    if (!*bhPtr) *bhPtr = new BH1750(address);
+    auto* slot = reserveSlot(_bh1750Pool, "BH1750", address);
+    if (!slot) return false;
+    if (slot->ready) return true;
+    BH1750* bh = _bh1750Pool.construct(slot, address);
 
-    if ((*bhPtr)->begin(BH1750::CONTINUOUS_HIGH_RES_MODE)) {
-        *readyPtr = true;
+    if (bh->begin(BH1750::CONTINUOUS_HIGH_RES_MODE, address, _activeWire)) {
+        slot->ready = true;
         Serial.printf("[SensorReader] BH1750 (GY-302) at 0x%02X initialized\n", address);
         return true;
     }
@@ -257,10 +307,8 @@ bool SensorReader::initBH1750(uint8_t address) {
     return false;
 }
 
-BH1750* SensorReader::getBH1750(uint8_t address) {
-    if (address == 0x23 && _bh1750_0x23_ready) return _bh1750_0x23;
-    if (address == 0x5C && _bh1750_0x5C_ready) return _bh1750_0x5C;
-    return nullptr;
+BH1750* SensorReader::getBH1750(int busId, uint8_t address) {
+    return _bh1750Pool.find(busId, address);
 }
 
 // ============================================================================
@@ -269,32 +317,24 @@ BH1750* SensorReader::getBH1750(uint8_t address) {
 
 bool SensorReader::initTSL2561(uint8_t address) {
     Serial.printf("[SensorReader] Initializing TSL2561 at 0x%02X...\n", address);
-    Adafruit_TSL2561_Unified** tslPtr = nullptr;
-    bool* readyPtr = nullptr;
-
-    if (address == 0x29) { tslPtr = &_tsl2561_0x29; readyPtr = &_tsl2561_0x29_ready; }
-    else if (address == 0x39) { tslPtr = &_tsl2561_0x39; readyPtr = &_tsl2561_0x39_ready; }
-    else if (address == 0x49) { tslPtr = &_tsl2561_0x49; readyPtr = &_tsl2561_0x49_ready; }
-    else return false;
-
-    if (*readyPtr) return true;
-    if (!*tslPtr) *tslPtr = new Adafruit_TSL2561_Unified(address, 12345);
-
-    if ((*tslPtr)->begin()) {
-        (*tslPtr)->enableAutoRange(true);
-        (*tslPtr)->setIntegrationTime(TSL2561_INTEGRATIONTIME_101MS);
-        *readyPtr = true;
+    if (address != 0x29 && address != 0x39 && address != 0x49) return false;
+    auto* slot = reserveSlot(_tsl2561Pool, "TSL2561", address);
+    if (!slot) return false;
+    if (slot->ready) return true;
+    Adafruit_TSL2561_Unified* tsl = _tsl2561Pool.construct(slot, address, 12345);
+
+    if (tsl->begin(_activeWire)) {
+        tsl->enableAutoRange(true);
+        tsl->setIntegrationTime(TSL2561_INTEGRATIONTIME_101MS);
+        slot->ready = true;
         Serial.printf("[SensorReader] TSL2561 at 0x%02X initialized\n", address);
         return true;
     }
     return false;
 }
 
-Adafruit_TSL2561_Unified* SensorReader::getTSL2561(uint8_t address) {
-    if (address == 0x29 && _tsl2561_0x29_ready) return _tsl2561_0x29;
-    if (address == 0x39 && _tsl2561_0x39_ready) return _tsl2561_0x39;
-    if (address == 0x49 && _tsl2561_0x49_ready) return _tsl2561_0x49;
-    return nullptr;
+Adafruit_TSL2561_Unified* SensorReader::getTSL2561(int busId, uint8_t address) {
+    return _tsl2561Pool.find(busId, address);
 }
 
 // ============================================================================
@@ -306,7 +346,7 @@ bool SensorReader::initSCD30() {
     if (_scd30_ready) return true;
     if (!_scd30) _scd30 = new SCD30();
 
-    if (_scd30->begin()) {
+    if (_scd30->begin(*_activeWire)) {
         _scd30->setMeasurementInterval(2);
         _scd30_ready = true;
         Serial.println("[SensorReader] SCD30 initialized");
@@ -324,7 +364,7 @@ bool SensorReader::initSCD4x() {
     if (_scd4x_ready) return true;
     if (!_scd4x) _scd4x = new SensirionI2CScd4x();
 
-    _scd4x->begin(Wire);
+    _scd4x->begin(*_activeWire);
     uint16_t error = _scd4x->stopPeriodicMeasurement();
     if (error == 0) {
         error = _scd4x->startPeriodicMeasurement();
@@ -343,27 +383,24 @@ bool SensorReader::initSCD4x() {
 
 bool SensorReader::initCCS811(uint8_t address) {
     Serial.printf("[SensorReader] Initializing CCS811 at 0x%02X...\n", address);
-    Adafruit_CCS811** ccsPtr = (address == 0x5A) ? &_ccs811_0x5A : &_ccs811_0x5B;
-    bool* readyPtr = (address == 0x5A) ? &_ccs811_0x5A_ready : &_ccs811_0x5B_ready;
-
     if (address != 0x5A && address != 0x5B) return false;
-    if (*readyPtr) return true;
-    if (!*ccsPtr) *ccsPtr = new Adafruit_CCS811();
+    auto* slot = reserveSlot(_ccs811Pool, "CCS811", address);
+    if (!slot) return false;
+    if (slot->ready) return true;
+    Adafruit_CCS811* ccs = _ccs811Pool.construct(slot);
 
-    if ((*ccsPtr)->begin(address)) {
+    if (ccs->begin(address, _activeWire)) {
         // Wait for sensor to be ready
-        while (!(*ccsPtr)->available());
-        *readyPtr = true;
+        while (!ccs->available());
+        slot->ready = true;
         Serial.printf("[SensorReader] CCS811 at 0x%02X initialized\n", address);
         return true;
     }
     return false;
 }
 
-Adafruit_CCS811* SensorReader::getCCS811(uint8_t address) {
-    if (address == 0x5A && _ccs811_0x5A_ready) return _ccs811_0x5A;
-    if (address == 0x5B && _ccs811_0x5B_ready) return _ccs811_0x5B;
-    return nullptr;
+Adafruit_CCS811* SensorReader::getCCS811(int busId, uint8_t address) {
+    return _ccs811Pool.find(busId, address);
 }
 
 // ============================================================================
@@ -375,7 +412,7 @@ bool SensorReader::initSGP30() {
     if (_sgp30_ready) return true;
     if (!_sgp30) _sgp30 = new Adafruit_SGP30();
 
-    if (_sgp30->begin()) {
+    if (_sgp30->begin(_activeWire)) {
         _sgp30_ready = true;
         Serial.println("[SensorReader] SGP30 initialized");
         return true;
@@ -392,6 +429,7 @@ bool SensorReader::initVL53L0X() {
     if (_vl53l0x_ready) return true;
     if (!_vl53l0x) _vl53l0x = new VL53L0X();
 
+    _vl53l0x->setBus(_activeWire);
     _vl53l0x->setTimeout(500);
     if (_vl53l0x->init()) {
         _vl53l0x->startContinuous();
@@ -406,28 +444,57 @@ bool SensorReader::initVL53L0X() {
 // ADS1115 ADC Implementation
 // ============================================================================
 
-bool SensorReader::initADS1115(uint8_t address) {
+bool SensorReader::initADS1115(uint8_t address, const SensorAssignmentConfig& config) {
     Serial.printf("[SensorReader] Initializing ADS1115 at 0x%02X...\n", address);
-    Adafruit_ADS1115** adsPtr = (address == 0x48) ? &_ads1115_0x48 : &_ads1115_0x49;
-    bool* readyPtr = (address == 0x48) ? &_ads1115_0x48_ready : &_ads1115_0x49_ready;
-
     if (address != 0x48 && address != 0x49) return false;
-    if (*readyPtr) return true;
-    if (!*adsPtr) *adsPtr = new Adafruit_ADS1115();
-
-    if ((*adsPtr)->begin(address)) {
-        (*adsPtr)->setGain(GAIN_ONE);  // +/- 4.096V
-        *readyPtr = true;
+    auto* slot = reserveSlot(_ads1115Pool, "ADS1115", address);
+    if (!slot) return false;
+    if (!slot->ready) {
+        Adafruit_ADS1115* ads = _ads1115Pool.construct(slot);
+        if (!ads->begin(address, _activeWire)) return false;
+        ads->setGain(GAIN_ONE);  // +/- 4.096V
+        slot->ready = true;
         Serial.printf("[SensorReader] ADS1115 at 0x%02X initialized\n", address);
-        return true;
     }
-    return false;
+
+    // Continuous scan of the configured channels (ALERT/RDY on digitalPin)
+    auto* scanSlot = reserveSlot(_adsScannerPool, "ADS1115 scanner", address);
+    if (!scanSlot) return true;  // Falls back to single-shot reads
+    ADS1115Scanner* scanner = _adsScannerPool.construct(scanSlot, slot->driver, _activeBus,
+                                                        config.digitalPin > 0 ? config.digitalPin : -1);
+    uint8_t channelMask = 0;
+    if (config.capabilities.empty()) {
+        scanner->configureChannel(0, GAIN_ONE, config::ADS1115_DEFAULT_DATA_RATE_SPS);
+        channelMask = 1;
+    }
+    for (size_t i = 0; i < config.capabilities.size(); i++) {
+        const SensorCapabilityConfig& cap = config.capabilities[i];
+        int channel = adcChannelFor(config, i);
+        scanner->configureChannel(channel,
+                                  ADS1115Scanner::gainFromConfig(cap.adcGain),
+                                  ADS1115Scanner::dataRateFromConfig(cap.adcDataRate));
+        channelMask |= (uint8_t)(1 << channel);
+    }
+    // A reused scanner still scans the channels of the previous configuration
+    scanner->retainChannels(channelMask);
+    scanSlot->ready = scanner->start();
+    return true;
+}
+
+Adafruit_ADS1115* SensorReader::getADS1115(int busId, uint8_t address) {
+    return _ads1115Pool.find(busId, address);
 }
 
-Adafruit_ADS1115* SensorReader::getADS1115(uint8_t address) {
-    if (address == 0x48 && _ads1115_0x48_ready) return _ads1115_0x48;
-    if (address == 0x49 && _ads1115_0x49_ready) return _ads1115_0x49;
-    return nullptr;
+bool SensorReader::isADCSensor(const String& upperSensorCode) {
+    return upperSensorCode.indexOf("ADS1115") >= 0 || upperSensorCode.indexOf("ADS1015") >= 0;
+}
+
+int SensorReader::adcChannelFor(const SensorAssignmentConfig& config, size_t capabilityIndex) {
+    if (capabilityIndex < config.capabilities.size()) {
+        int channel = config.capabilities[capabilityIndex].adcChannel;
+        if (channel >= 0 && channel < ADS1115_CHANNEL_COUNT) return channel;
+    }
+    return capabilityIndex < ADS1115_CHANNEL_COUNT ? (int)capabilityIndex : 0;
 }
 
 // ============================================================================
@@ -490,25 +557,17 @@ bool SensorReader::initGPS(int rxPin, int txPin) {
 
     if (!_gps) _gps = new TinyGPSPlus();
 
-    // Use UARTManager to allocate UART dynamically based on pins
-    UARTManager& uartMgr = UARTManager::getInstance();
-    int uartNum = uartMgr.allocate(rxPin, txPin, 9600, "GPS", false);  // Use Arduino API
-
-    if (uartNum < 0) {
-        Serial.println("[SensorReader] Failed to allocate UART for GPS!");
-        return false;
-    }
-
-    _gpsSerial = uartMgr.getSerial(uartNum);
-    if (!_gpsSerial) {
-        Serial.println("[SensorReader] Failed to get GPS serial!");
+    // Lease a UART for the pins (buffered by the UART pump from here on)
+    _gpsLease = UARTManager::getInstance().acquire(UARTOwner::GPS, rxPin, txPin, 9600);
+    if (!_gpsLease) {
+        Serial.println("[SensorReader] Failed to lease UART for GPS!");
         return false;
     }
 
     _gps_rx_pin = rxPin;
     _gps_tx_pin = txPin;
     _gps_ready = true;
-    Serial.printf("[SensorReader] GPS initialized on UART%d\n", uartNum);
+    Serial.printf("[SensorReader] GPS initialized on UART%d\n", _gpsLease->getUartNum());
     return true;
 }
 
@@ -536,30 +595,25 @@ bool SensorReader::initSR04M2(int rxPin, int txPin, int baudRate) {
     Serial.printf("[SensorReader] Initializing SR04M-2 (UART) RX=%d, TX=%s at %d baud...\n",
                   rxPin, txPin < 0 ? "none" : String(txPin).c_str(), actualBaudRate);
 
-    // Use UARTManager to allocate UART dynamically based on pins
+    // Lease a UART for the pins; an existing lease only changes baud rate in place
     UARTManager& uartMgr = UARTManager::getInstance();
-    int uartNum = uartMgr.allocate(rxPin, txPin, actualBaudRate, "SR04M2", true);  // Use ESP-IDF API
-
-    if (uartNum < 0) {
-        Serial.println("[SensorReader] Failed to allocate UART for SR04M-2!");
+    _sr04m2Lease = uartMgr.acquire(UARTOwner::SR04M2, rxPin, txPin, actualBaudRate);
+    if (!_sr04m2Lease) {
+        Serial.println("[SensorReader] Failed to lease UART for SR04M-2!");
         return false;
     }
 
     // Try inverted RX if we're getting garbage data (0x00, 0xC0 instead of 0xFF, 0xFE)
     // Some sensors have inverted UART output
-    if (sr04m2_try_inverted) {
-        uart_port_t uart_port = (uartNum == 1) ? UART_NUM_1 : UART_NUM_2;
-        esp_err_t err = uart_set_line_inverse(uart_port, UART_SIGNAL_RXD_INV);
-        if (err == ESP_OK) {
-            Serial.println("[SR04M-2] RX signal INVERTED enabled");
-        }
+    if (sr04m2_try_inverted && uartMgr.setRxInverted(_sr04m2Lease, true)) {
+        Serial.println("[SR04M-2] RX signal INVERTED enabled");
     }
 
     _sr04m2_rx_pin = rxPin;
     _sr04m2_tx_pin = txPin;
     _sr04m2_ready = true;
     Serial.printf("[SensorReader] SR04M-2 initialized on UART%d at %d baud (RX-only: %s, inverted: %s)\n",
-                  uartNum, actualBaudRate, txPin < 0 ? "yes" : "no", sr04m2_try_inverted ? "yes" : "no");
+                  _sr04m2Lease->getUartNum(), actualBaudRate, txPin < 0 ? "yes" : "no", sr04m2_try_inverted ? "yes" : "no");
     return true;
 }
 
@@ -573,27 +627,68 @@ bool SensorReader::initSR04M2(int rxPin, int txPin, int baudRate) {
 
 bool SensorReader::initializeSensor(const SensorAssignmentConfig& config) {
 #ifdef PLATFORM_ESP32
+    lockState();
+    bool success = initSensor(config);
+    unlockState();
+    return success;
+#else
+    // Native reads replayed or simulated values, any sensor is present
+    (void)config;
+    return true;
+#endif
+}
+
+#ifdef PLATFORM_ESP32
+void SensorReader::lockState() {
+    if (_stateMutex) {
+        xSemaphoreTake(_stateMutex, portMAX_DELAY);
+    }
+}
+
+void SensorReader::unlockState() {
+    if (_stateMutex) {
+        xSemaphoreGive(_stateMutex);
+    }
+}
+
+bool SensorReader::initSensor(const SensorAssignmentConfig& config) {
     String sensorCode = config.sensorCode;
     sensorCode.toUpperCase();
 
-    int sdaPin = (config.sdaPin > 0) ? config.sdaPin : DEFAULT_SDA_PIN;
-    int sclPin = (config.sclPin > 0) ? config.sclPin : DEFAULT_SCL_PIN;
-    initI2C(sdaPin, sclPin);
-
     uint8_t i2cAddr = parseI2CAddress(config.i2cAddress);
+    if (i2cAddr == 0) i2cAddr = defaultI2CAddress(sensorCode);
     Serial.printf("[SensorReader] Initializing: %s at 0x%02X\n", sensorCode.c_str(), i2cAddr);
+    _lastInitError = "";
+
+    // I2C sensors: select (or register) the bus and hold it while drivers probe
+    int busId = -1;
+    if (isI2CSensor(sensorCode)) {
+        int sdaPin = (config.sdaPin > 0) ? config.sdaPin : DEFAULT_SDA_PIN;
+        int sclPin = (config.sclPin > 0) ? config.sclPin : DEFAULT_SCL_PIN;
+        bool wireOnly = sensorCode.indexOf("SHT31") >= 0 || sensorCode.indexOf("SHT3X") >= 0;
+        busId = initI2C(sdaPin, sclPin, wireOnly ? 0 : -1);
+        if (busId < 0) {
+            _lastInitError = "No I2C bus available";
+            return false;
+        }
+    }
+    I2CBusLock busLock(busId);
+    if (busId >= 0 && !busLock.locked()) {
+        _lastInitError = "I2C bus busy";
+        return false;
+    }
 
     // BME280
     if (sensorCode.indexOf("BME280") >= 0 || sensorCode.indexOf("BMP280") >= 0) {
-        return initBME280(i2cAddr == 0 ? 0x76 : i2cAddr);
+        return initBME280(i2cAddr);
     }
     // BME680
     if (sensorCode.indexOf("BME680") >= 0) {
-        return initBME680(i2cAddr == 0 ? 0x76 : i2cAddr);
+        return initBME680(i2cAddr);
     }
     // SHT31
     if (sensorCode.indexOf("SHT31") >= 0 || sensorCode.indexOf("SHT3X") >= 0) {
-        return initSHT31(i2cAddr == 0 ? 0x44 : i2cAddr);
+        return initSHT31(i2cAddr);
     }
     // DS18B20
     if (sensorCode.indexOf("DS18B20") >= 0 || sensorCode.indexOf("DALLAS") >= 0) {
@@ -602,11 +697,11 @@ bool SensorReader::initializeSensor(const SensorAssignmentConfig& config) {
     // BH1750 / GY-302
     if (sensorCode.indexOf("BH1750") >= 0 || sensorCode.indexOf("GY302") >= 0 ||
         sensorCode.indexOf("GY-302") >= 0) {
-        return initBH1750(i2cAddr == 0 ? 0x23 : i2cAddr);
+        return initBH1750(i2cAddr);
     }
     // TSL2561
     if (sensorCode.indexOf("TSL2561") >= 0 || sensorCode.indexOf("TSL2591") >= 0) {
-        return initTSL2561(i2cAddr == 0 ? 0x39 : i2cAddr);
+        return initTSL2561(i2cAddr);
     }
     // SCD30
     if (sensorCode.indexOf("SCD30") >= 0) {
@@ -619,7 +714,7 @@ bool SensorReader::initializeSensor(const SensorAssignmentConfig& config) {
     }
     // CCS811
     if (sensorCode.indexOf("CCS811") >= 0) {
-        return initCCS811(i2cAddr == 0 ? 0x5A : i2cAddr);
+        return initCCS811(i2cAddr);
     }
     // SGP30
     if (sensorCode.indexOf("SGP30") >= 0) {
@@ -630,8 +725,8 @@ bool SensorReader::initializeSensor(const SensorAssignmentConfig& config) {
         return initVL53L0X();
     }
     // ADS1115
-    if (sensorCode.indexOf("ADS1115") >= 0 || sensorCode.indexOf("ADS1015") >= 0) {
-        return initADS1115(i2cAddr == 0 ? 0x48 : i2cAddr);
+    if (isADCSensor(sensorCode)) {
+        return initADS1115(i2cAddr, config);
     }
     // DHT22
     if (sensorCode.indexOf("DHT22") >= 0 || sensorCode.indexOf("DHT") >= 0 ||
@@ -663,10 +758,45 @@ bool SensorReader::initializeSensor(const SensorAssignmentConfig& config) {
     }
 
     Serial.printf("[SensorReader] Unknown sensor: %s\n", sensorCode.c_str());
+    _lastInitError = "Unknown sensor";
     return false;
+}
+#endif
+
+int SensorReader::initializeSensors(const std::vector<SensorAssignmentConfig>& sensors,
+                                    std::vector<SensorInitResult>* results) {
+    int failures = 0;
+    Serial.printf("[SensorReader] Init phase: %d configured sensors\n", (int)sensors.size());
+
+#ifdef PLATFORM_ESP32
+    lockState();
+    releaseUnusedDrivers(sensors);
+#endif
+    for (const auto& sensor : sensors) {
+        if (!sensor.isActive) continue;
+
+        SensorInitResult result;
+        result.endpointId = sensor.endpointId;
+        result.sensorCode = sensor.sensorCode;
+#ifdef PLATFORM_ESP32
+        result.success = initSensor(sensor);
 #else
-    return false;
+        result.success = initializeSensor(sensor);
+#endif
+        if (!result.success) {
+            result.error = _lastInitError.length() > 0 ? _lastInitError : String("Sensor not detected");
+            failures++;
+            Serial.printf("[SensorReader] Init FAILED: %s (Endpoint %d): %s\n",
+                          sensor.sensorCode.c_str(), sensor.endpointId, result.error.c_str());
+        }
+        if (results) results->push_back(result);
+    }
+#ifdef PLATFORM_ESP32
+    unlockState();
 #endif
+
+    Serial.printf("[SensorReader] Init phase complete: %d failed\n", failures);
+    return failures;
 }
 
 // ============================================================================
@@ -677,6 +807,24 @@ SensorReading SensorReader::readValue(const String& measurementType, const Senso
     String type = measurementType;
     type.toLowerCase();
 
+#ifdef PLATFORM_ESP32
+    // Hold the sensor's bus for the whole read (re-pins shared buses at most once)
+    int busId = getBusForConfig(config);
+    I2CBusLock busLock(busId);
+    if (busId >= 0 && !busLock.locked()) return SensorReading("I2C bus busy");
+
+    // ADC inputs: every capability is a channel, whatever it measures
+    String upperCode = config.sensorCode;
+    upperCode.toUpperCase();
+    if (isADCSensor(upperCode)) {
+        for (size_t i = 0; i < config.capabilities.size(); i++) {
+            if (config.capabilities[i].measurementType == measurementType) {
+                return readAnalog(config, adcChannelFor(config, i));
+            }
+        }
+    }
+#endif
+
     if (type.indexOf("temp") >= 0 && type.indexOf("water") < 0) return readTemperature(config);
     if (type.indexOf("water_temp") >= 0) return readTemperature(config);  // DS18B20 water temp
     if (type.indexOf("humid") >= 0 || type.indexOf("hum") >= 0) return readHumidity(config);
@@ -700,6 +848,106 @@ SensorReading SensorReader::readValue(const String& measurementType, const Senso
     return SensorReading("Unknown measurement type: " + measurementType);
 }
 
+// ============================================================================
+// Batched Reading (per-bus transaction queue)
+// ============================================================================
+
+namespace {
+// Timing stage per driver ("sensor.<code>"): the read including the wait for the bus
+int sensorStage(const SensorBatchRequest& request) {
+#if INSTRUMENTATION
+    return Instrumentation::getInstance().stageId("sensor.", request.config->sensorCode.c_str());
+#else
+    (void)request;
+    return -1;
+#endif
+}
+
+void countSensorError(const SensorBatchRequest& request) {
+    if (!request.result.success) {
+        Instrumentation::getInstance().count("sensor.errors");
+    }
+}
+
+#ifdef PLATFORM_ESP32
+struct BatchJobContext {
+    SensorReader* reader;
+    SensorBatchRequest* request;
+};
+
+void runBatchJob(void* ctx) {
+    BatchJobContext* job = static_cast<BatchJobContext*>(ctx);
+    {
+        ScopedTimer timer(sensorStage(*job->request));
+        job->request->result = job->reader->readValue(job->request->measurementType, *job->request->config);
+    }
+    countSensorError(*job->request);
+}
+#endif
+} // namespace
+
+void SensorReader::readBatch(std::vector<SensorBatchRequest>& requests) {
+#ifdef PLATFORM_ESP32
+    std::vector<BatchJobContext> contexts(requests.size());
+    std::vector<I2CJob> jobs(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        contexts[i] = { this, &requests[i] };
+        jobs[i] = { getBusForConfig(*requests[i].config), runBatchJob, &contexts[i] };
+    }
+
+    lockState();
+    I2CBusManager::getInstance().runBatch(jobs.data(), jobs.size());
+    unlockState();
+#else
+    // No sensor hardware on native: replayed values, else simulated stand-ins
+    SessionTrace& replay = SessionTrace::getInstance();
+    for (auto& request : requests) {
+        SensorReading& result = request.result;
+        int endpointId = request.config->endpointId;
+        {
+            ScopedTimer timer(sensorStage(request));
+            if (!replay.replaySensor(endpointId, request.measurementType,
+                                     result.success, result.value, result.error)) {
+                result = readSimulated(endpointId, request.measurementType);
+            }
+        }
+        countSensorError(request);
+    }
+#endif
+
+    SessionTrace& trace = SessionTrace::getInstance();
+    if (trace.isRecording()) {
+        for (const auto& request : requests) {
+            trace.recordSensor(request.config->endpointId, request.measurementType,
+                               request.result.success, request.result.value, request.result.error);
+        }
+    }
+}
+
+#ifdef PLATFORM_NATIVE
+SensorReading SensorReader::readSimulated(int endpointId, const String& measurementType) {
+    String key = String(endpointId) + "/" + measurementType;
+    auto it = _simulated.find(key);
+    if (it == _simulated.end()) {
+        std::unique_ptr<sensor::SimulatedSensor> simulated;
+        if (sensor::SensorTypes::getInfo(measurementType.c_str())) {
+            simulated.reset(new sensor::SimulatedSensor(measurementType.c_str()));
+            simulated->begin();
+        }
+        it = _simulated.emplace(key, std::move(simulated)).first;
+    }
+
+    if (!it->second) {
+        return SensorReading("Hardware not available on native");
+    }
+    float value = it->second->read();
+    if (std::isnan(value)) {
+        return SensorReading("Simulated dropout");
+    }
+    return SensorReading(static_cast<double>(value));
+}
+#endif
+
 // ============================================================================
 // Temperature Reading
 // ============================================================================
@@ -713,11 +961,10 @@ SensorReading SensorReader::readTemperature(const SensorAssignmentConfig& config
     // BME280
     if (sensorCode.indexOf("BME280") >= 0 || sensorCode.indexOf("BMP280") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x76;
-        Adafruit_BME280* bme = getBME280(i2cAddr);
-        if (!bme && initBME280(i2cAddr)) bme = getBME280(i2cAddr);
+        Adafruit_BME280* bme = getBME280(i2cBusFor(config), i2cAddr);
         if (bme) {
             float temp = bme->readTemperature();
-            Serial.printf("[SensorReader] BME280 Temp: %.2f°C\n", temp);
+            DBG_SENSOR("BME280 Temp: %.2f°C", temp);
             return SensorReading(temp);
         }
         return SensorReading("BME280 not available");
@@ -726,10 +973,9 @@ SensorReading SensorReader::readTemperature(const SensorAssignmentConfig& config
     // BME680
     if (sensorCode.indexOf("BME680") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x76;
-        Adafruit_BME680* bme = getBME680(i2cAddr);
-        if (!bme && initBME680(i2cAddr)) bme = getBME680(i2cAddr);
+        Adafruit_BME680* bme = getBME680(i2cBusFor(config), i2cAddr);
         if (bme && bme->performReading()) {
-            Serial.printf("[SensorReader] BME680 Temp: %.2f°C\n", bme->temperature);
+            DBG_SENSOR("BME680 Temp: %.2f°C", bme->temperature);
             return SensorReading(bme->temperature);
         }
         return SensorReading("BME680 not available");
@@ -738,12 +984,11 @@ SensorReading SensorReader::readTemperature(const SensorAssignmentConfig& config
     // SHT31
     if (sensorCode.indexOf("SHT31") >= 0 || sensorCode.indexOf("SHT3X") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x44;
-        ClosedCube_SHT31D* sht = getSHT31(i2cAddr);
-        if (!sht && initSHT31(i2cAddr)) sht = getSHT31(i2cAddr);
+        ClosedCube_SHT31D* sht = getSHT31(i2cBusFor(config), i2cAddr);
         if (sht) {
             SHT31D result = sht->readTempAndHumidity(SHT3XD_REPEATABILITY_HIGH, SHT3XD_MODE_CLOCK_STRETCH, 50);
             if (result.error == SHT3XD_NO_ERROR) {
-                Serial.printf("[SensorReader] SHT31 Temp: %.2f°C\n", result.t);
+                DBG_SENSOR("SHT31 Temp: %.2f°C", result.t);
                 return SensorReading(result.t);
             }
         }
@@ -753,7 +998,7 @@ SensorReading SensorReader::readTemperature(const SensorAssignmentConfig& config
     // DS18B20
     if (sensorCode.indexOf("DS18B20") >= 0 || sensorCode.indexOf("DALLAS") >= 0) {
         int pin = config.oneWirePin > 0 ? config.oneWirePin : 4;
-        if (!_ds18b20_ready && !initDS18B20(pin)) return SensorReading("DS18B20 not available");
+        if (!_ds18b20_ready) return SensorReading("DS18B20 not initialized");
         if (_ds18b20) {
             // Set resolution to 12-bit for accurate readings (default)
             _ds18b20->setResolution(12);
@@ -778,7 +1023,7 @@ SensorReading SensorReader::readTemperature(const SensorAssignmentConfig& config
             }
 
             if (temp != DEVICE_DISCONNECTED_C && temp != 85.0) {
-                Serial.printf("[SensorReader] DS18B20 Temp: %.2f°C\n", temp);
+                DBG_SENSOR("DS18B20 Temp: %.2f°C", temp);
                 return SensorReading(temp);
             } else if (temp == 85.0) {
                 Serial.println("[SensorReader] DS18B20: Still 85°C after retry - check wiring/power");
@@ -790,10 +1035,10 @@ SensorReading SensorReader::readTemperature(const SensorAssignmentConfig& config
 
     // SCD30 (also has temperature)
     if (sensorCode.indexOf("SCD30") >= 0) {
-        if (!_scd30_ready && !initSCD30()) return SensorReading("SCD30 not available");
+        if (!_scd30_ready) return SensorReading("SCD30 not initialized");
         if (_scd30 && _scd30->dataAvailable()) {
             float temp = _scd30->getTemperature();
-            Serial.printf("[SensorReader] SCD30 Temp: %.2f°C\n", temp);
+            DBG_SENSOR("SCD30 Temp: %.2f°C", temp);
             return SensorReading(temp);
         }
         return SensorReading("SCD30 data not ready");
@@ -803,11 +1048,11 @@ SensorReading SensorReader::readTemperature(const SensorAssignmentConfig& config
     if (sensorCode.indexOf("DHT22") >= 0 || sensorCode.indexOf("DHT") >= 0 ||
         sensorCode.indexOf("AM2302") >= 0) {
         int pin = config.digitalPin > 0 ? config.digitalPin : 4;
-        if (!_dht22_ready && !initDHT22(pin)) return SensorReading("DHT22 not available");
+        if (!_dht22_ready) return SensorReading("DHT22 not initialized");
         if (_dht22) {
             float temp = _dht22->readTemperature();
             if (!isnan(temp)) {
-                Serial.printf("[SensorReader] DHT22 Temp: %.2f°C\n", temp);
+                DBG_SENSOR("DHT22 Temp: %.2f°C", temp);
                 return SensorReading(temp);
             }
         }
@@ -833,11 +1078,10 @@ SensorReading SensorReader::readHumidity(const SensorAssignmentConfig& config) {
     // BME280
     if (sensorCode.indexOf("BME280") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x76;
-        Adafruit_BME280* bme = getBME280(i2cAddr);
-        if (!bme && initBME280(i2cAddr)) bme = getBME280(i2cAddr);
+        Adafruit_BME280* bme = getBME280(i2cBusFor(config), i2cAddr);
         if (bme) {
             float hum = bme->readHumidity();
-            Serial.printf("[SensorReader] BME280 Humidity: %.2f%%\n", hum);
+            DBG_SENSOR("BME280 Humidity: %.2f%%", hum);
             return SensorReading(hum);
         }
         return SensorReading("BME280 not available");
@@ -846,10 +1090,9 @@ SensorReading SensorReader::readHumidity(const SensorAssignmentConfig& config) {
     // BME680
     if (sensorCode.indexOf("BME680") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x76;
-        Adafruit_BME680* bme = getBME680(i2cAddr);
-        if (!bme && initBME680(i2cAddr)) bme = getBME680(i2cAddr);
+        Adafruit_BME680* bme = getBME680(i2cBusFor(config), i2cAddr);
         if (bme && bme->performReading()) {
-            Serial.printf("[SensorReader] BME680 Humidity: %.2f%%\n", bme->humidity);
+            DBG_SENSOR("BME680 Humidity: %.2f%%", bme->humidity);
             return SensorReading(bme->humidity);
         }
         return SensorReading("BME680 not available");
@@ -858,12 +1101,11 @@ SensorReading SensorReader::readHumidity(const SensorAssignmentConfig& config) {
     // SHT31
     if (sensorCode.indexOf("SHT31") >= 0 || sensorCode.indexOf("SHT3X") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x44;
-        ClosedCube_SHT31D* sht = getSHT31(i2cAddr);
-        if (!sht && initSHT31(i2cAddr)) sht = getSHT31(i2cAddr);
+        ClosedCube_SHT31D* sht = getSHT31(i2cBusFor(config), i2cAddr);
         if (sht) {
             SHT31D result = sht->readTempAndHumidity(SHT3XD_REPEATABILITY_HIGH, SHT3XD_MODE_CLOCK_STRETCH, 50);
             if (result.error == SHT3XD_NO_ERROR) {
-                Serial.printf("[SensorReader] SHT31 Humidity: %.2f%%\n", result.rh);
+                DBG_SENSOR("SHT31 Humidity: %.2f%%", result.rh);
                 return SensorReading(result.rh);
             }
         }
@@ -872,10 +1114,10 @@ SensorReading SensorReader::readHumidity(const SensorAssignmentConfig& config) {
 
     // SCD30
     if (sensorCode.indexOf("SCD30") >= 0) {
-        if (!_scd30_ready && !initSCD30()) return SensorReading("SCD30 not available");
+        if (!_scd30_ready) return SensorReading("SCD30 not initialized");
         if (_scd30 && _scd30->dataAvailable()) {
             float hum = _scd30->getHumidity();
-            Serial.printf("[SensorReader] SCD30 Humidity: %.2f%%\n", hum);
+            DBG_SENSOR("SCD30 Humidity: %.2f%%", hum);
             return SensorReading(hum);
         }
         return SensorReading("SCD30 data not ready");
@@ -885,11 +1127,11 @@ SensorReading SensorReader::readHumidity(const SensorAssignmentConfig& config) {
     if (sensorCode.indexOf("DHT22") >= 0 || sensorCode.indexOf("DHT") >= 0 ||
         sensorCode.indexOf("AM2302") >= 0) {
         int pin = config.digitalPin > 0 ? config.digitalPin : 4;
-        if (!_dht22_ready && !initDHT22(pin)) return SensorReading("DHT22 not available");
+        if (!_dht22_ready) return SensorReading("DHT22 not initialized");
         if (_dht22) {
             float hum = _dht22->readHumidity();
             if (!isnan(hum)) {
-                Serial.printf("[SensorReader] DHT22 Humidity: %.2f%%\n", hum);
+                DBG_SENSOR("DHT22 Humidity: %.2f%%", hum);
                 return SensorReading(hum);
             }
         }
@@ -915,11 +1157,10 @@ SensorReading SensorReader::readPressure(const SensorAssignmentConfig& config) {
     // BME280/BMP280
     if (sensorCode.indexOf("BME280") >= 0 || sensorCode.indexOf("BMP280") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x76;
-        Adafruit_BME280* bme = getBME280(i2cAddr);
-        if (!bme && initBME280(i2cAddr)) bme = getBME280(i2cAddr);
+        Adafruit_BME280* bme = getBME280(i2cBusFor(config), i2cAddr);
         if (bme) {
             float pressure = bme->readPressure() / 100.0F;
-            Serial.printf("[SensorReader] BME280 Pressure: %.2f hPa\n", pressure);
+            DBG_SENSOR("BME280 Pressure: %.2f hPa", pressure);
             return SensorReading(pressure);
         }
         return SensorReading("BME280 not available");
@@ -928,11 +1169,10 @@ SensorReading SensorReader::readPressure(const SensorAssignmentConfig& config) {
     // BME680
     if (sensorCode.indexOf("BME680") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x76;
-        Adafruit_BME680* bme = getBME680(i2cAddr);
-        if (!bme && initBME680(i2cAddr)) bme = getBME680(i2cAddr);
+        Adafruit_BME680* bme = getBME680(i2cBusFor(config), i2cAddr);
         if (bme && bme->performReading()) {
             float pressure = bme->pressure / 100.0F;
-            Serial.printf("[SensorReader] BME680 Pressure: %.2f hPa\n", pressure);
+            DBG_SENSOR("BME680 Pressure: %.2f hPa", pressure);
             return SensorReading(pressure);
         }
         return SensorReading("BME680 not available");
@@ -956,11 +1196,10 @@ SensorReading SensorReader::readGasResistance(const SensorAssignmentConfig& conf
 
     if (sensorCode.indexOf("BME680") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x76;
-        Adafruit_BME680* bme = getBME680(i2cAddr);
-        if (!bme && initBME680(i2cAddr)) bme = getBME680(i2cAddr);
+        Adafruit_BME680* bme = getBME680(i2cBusFor(config), i2cAddr);
         if (bme && bme->performReading()) {
             float gasRes = bme->gas_resistance / 1000.0F;
-            Serial.printf("[SensorReader] BME680 Gas: %.2f kOhms\n", gasRes);
+            DBG_SENSOR("BME680 Gas: %.2f kOhms", gasRes);
             return SensorReading(gasRes);
         }
         return SensorReading("BME680 not available");
@@ -986,12 +1225,11 @@ SensorReading SensorReader::readLight(const SensorAssignmentConfig& config) {
     if (sensorCode.indexOf("BH1750") >= 0 || sensorCode.indexOf("GY302") >= 0 ||
         sensorCode.indexOf("GY-302") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x23;
-        BH1750* bh = getBH1750(i2cAddr);
-        if (!bh && initBH1750(i2cAddr)) bh = getBH1750(i2cAddr);
+        BH1750* bh = getBH1750(i2cBusFor(config), i2cAddr);
         if (bh) {
             float lux = bh->readLightLevel();
             if (lux >= 0) {
-                Serial.printf("[SensorReader] BH1750 Light: %.2f lux\n", lux);
+                DBG_SENSOR("BH1750 Light: %.2f lux", lux);
                 return SensorReading(lux);
             }
         }
@@ -1001,13 +1239,12 @@ SensorReading SensorReader::readLight(const SensorAssignmentConfig& config) {
     // TSL2561
     if (sensorCode.indexOf("TSL2561") >= 0 || sensorCode.indexOf("TSL2591") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x39;
-        Adafruit_TSL2561_Unified* tsl = getTSL2561(i2cAddr);
-        if (!tsl && initTSL2561(i2cAddr)) tsl = getTSL2561(i2cAddr);
+        Adafruit_TSL2561_Unified* tsl = getTSL2561(i2cBusFor(config), i2cAddr);
         if (tsl) {
             sensors_event_t event;
             tsl->getEvent(&event);
             if (event.light > 0) {
-                Serial.printf("[SensorReader] TSL2561 Light: %.2f lux\n", event.light);
+                DBG_SENSOR("TSL2561 Light: %.2f lux", event.light);
                 return SensorReading(event.light);
             }
         }
@@ -1032,10 +1269,10 @@ SensorReading SensorReader::readCO2(const SensorAssignmentConfig& config) {
 
     // SCD30
     if (sensorCode.indexOf("SCD30") >= 0) {
-        if (!_scd30_ready && !initSCD30()) return SensorReading("SCD30 not available");
+        if (!_scd30_ready) return SensorReading("SCD30 not initialized");
         if (_scd30 && _scd30->dataAvailable()) {
             float co2 = _scd30->getCO2();
-            Serial.printf("[SensorReader] SCD30 CO2: %.0f ppm\n", co2);
+            DBG_SENSOR("SCD30 CO2: %.0f ppm", co2);
             return SensorReading(co2);
         }
         return SensorReading("SCD30 data not ready");
@@ -1044,7 +1281,7 @@ SensorReading SensorReader::readCO2(const SensorAssignmentConfig& config) {
     // SCD40/SCD41
     if (sensorCode.indexOf("SCD40") >= 0 || sensorCode.indexOf("SCD41") >= 0 ||
         sensorCode.indexOf("SCD4X") >= 0) {
-        if (!_scd4x_ready && !initSCD4x()) return SensorReading("SCD4x not available");
+        if (!_scd4x_ready) return SensorReading("SCD4x not initialized");
         if (_scd4x) {
             uint16_t co2;
             float temperature, humidity;
@@ -1053,7 +1290,7 @@ SensorReading SensorReader::readCO2(const SensorAssignmentConfig& config) {
             if (ready) {
                 uint16_t error = _scd4x->readMeasurement(co2, temperature, humidity);
                 if (error == 0) {
-                    Serial.printf("[SensorReader] SCD4x CO2: %d ppm\n", co2);
+                    DBG_SENSOR("SCD4x CO2: %d ppm", co2);
                     return SensorReading((double)co2);
                 }
             }
@@ -1064,11 +1301,10 @@ SensorReading SensorReader::readCO2(const SensorAssignmentConfig& config) {
     // CCS811
     if (sensorCode.indexOf("CCS811") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x5A;
-        Adafruit_CCS811* ccs = getCCS811(i2cAddr);
-        if (!ccs && initCCS811(i2cAddr)) ccs = getCCS811(i2cAddr);
+        Adafruit_CCS811* ccs = getCCS811(i2cBusFor(config), i2cAddr);
         if (ccs && ccs->available() && !ccs->readData()) {
             uint16_t co2 = ccs->geteCO2();
-            Serial.printf("[SensorReader] CCS811 CO2: %d ppm\n", co2);
+            DBG_SENSOR("CCS811 CO2: %d ppm", co2);
             return SensorReading((double)co2);
         }
         return SensorReading("CCS811 not available");
@@ -1076,10 +1312,10 @@ SensorReading SensorReader::readCO2(const SensorAssignmentConfig& config) {
 
     // SGP30
     if (sensorCode.indexOf("SGP30") >= 0) {
-        if (!_sgp30_ready && !initSGP30()) return SensorReading("SGP30 not available");
+        if (!_sgp30_ready) return SensorReading("SGP30 not initialized");
         if (_sgp30 && _sgp30->IAQmeasure()) {
             uint16_t co2 = _sgp30->eCO2;
-            Serial.printf("[SensorReader] SGP30 CO2: %d ppm\n", co2);
+            DBG_SENSOR("SGP30 CO2: %d ppm", co2);
             return SensorReading((double)co2);
         }
         return SensorReading("SGP30 reading failed");
@@ -1104,11 +1340,10 @@ SensorReading SensorReader::readTVOC(const SensorAssignmentConfig& config) {
     // CCS811
     if (sensorCode.indexOf("CCS811") >= 0) {
         if (i2cAddr == 0) i2cAddr = 0x5A;
-        Adafruit_CCS811* ccs = getCCS811(i2cAddr);
-        if (!ccs && initCCS811(i2cAddr)) ccs = getCCS811(i2cAddr);
+        Adafruit_CCS811* ccs = getCCS811(i2cBusFor(config), i2cAddr);
         if (ccs && ccs->available() && !ccs->readData()) {
             uint16_t tvoc = ccs->getTVOC();
-            Serial.printf("[SensorReader] CCS811 TVOC: %d ppb\n", tvoc);
+            DBG_SENSOR("CCS811 TVOC: %d ppb", tvoc);
             return SensorReading((double)tvoc);
         }
         return SensorReading("CCS811 not available");
@@ -1116,10 +1351,10 @@ SensorReading SensorReader::readTVOC(const SensorAssignmentConfig& config) {
 
     // SGP30
     if (sensorCode.indexOf("SGP30") >= 0) {
-        if (!_sgp30_ready && !initSGP30()) return SensorReading("SGP30 not available");
+        if (!_sgp30_ready) return SensorReading("SGP30 not initialized");
         if (_sgp30 && _sgp30->IAQmeasure()) {
             uint16_t tvoc = _sgp30->TVOC;
-            Serial.printf("[SensorReader] SGP30 TVOC: %d ppb\n", tvoc);
+            DBG_SENSOR("SGP30 TVOC: %d ppb", tvoc);
             return SensorReading((double)tvoc);
         }
         return SensorReading("SGP30 reading failed");
@@ -1141,11 +1376,11 @@ SensorReading SensorReader::readDistance(const SensorAssignmentConfig& config) {
     sensorCode.toUpperCase();
 
     if (sensorCode.indexOf("VL53L0X") >= 0 || sensorCode.indexOf("VL53L1X") >= 0) {
-        if (!_vl53l0x_ready && !initVL53L0X()) return SensorReading("VL53L0X not available");
+        if (!_vl53l0x_ready) return SensorReading("VL53L0X not initialized");
         if (_vl53l0x) {
             uint16_t distance = _vl53l0x->readRangeContinuousMillimeters();
             if (!_vl53l0x->timeoutOccurred()) {
-                Serial.printf("[SensorReader] VL53L0X Distance: %d mm\n", distance);
+                DBG_SENSOR("VL53L0X Distance: %d mm", distance);
                 return SensorReading((double)distance);
             }
         }
@@ -1173,14 +1408,33 @@ SensorReading SensorReader::readAnalog(const SensorAssignmentConfig& config, int
     sensorCode.toUpperCase();
     uint8_t i2cAddr = parseI2CAddress(config.i2cAddress);
 
-    if (sensorCode.indexOf("ADS1115") >= 0 || sensorCode.indexOf("ADS1015") >= 0) {
+    if (isADCSensor(sensorCode)) {
         if (i2cAddr == 0) i2cAddr = 0x48;
-        Adafruit_ADS1115* ads = getADS1115(i2cAddr);
-        if (!ads && initADS1115(i2cAddr)) ads = getADS1115(i2cAddr);
+        int busId = i2cBusFor(config);
+
+        // Continuous scan: return the last averaged window, no bus traffic
+        ADS1115Scanner* scanner = _adsScannerPool.find(busId, i2cAddr);
+        if (scanner) {
+            if (!scanner->isChannelEnabled(channel)) {
+                return SensorReading("ADS1115 channel " + String(channel) + " not scanned");
+            }
+            ADS1115ChannelValue sample;
+            if (!scanner->getChannel(channel, sample)) {
+                return SensorReading("ADS1115 channel " + String(channel) + " has no sample yet");
+            }
+            if (millis() - sample.timestamp > config::ADS1115_MAX_SAMPLE_AGE_MS) {
+                return SensorReading("ADS1115 channel " + String(channel) + " sample is stale");
+            }
+            DBG_SENSOR("ADS1115 Ch%d: %.4f V (raw: %d, avg of %u)",
+                       channel, sample.voltage, sample.raw, (unsigned)sample.samples);
+            return SensorReading(sample.voltage);
+        }
+
+        Adafruit_ADS1115* ads = getADS1115(busId, i2cAddr);
         if (ads) {
             int16_t adc = ads->readADC_SingleEnded(channel);
             float voltage = ads->computeVolts(adc);
-            Serial.printf("[SensorReader] ADS1115 Ch%d: %.4f V (raw: %d)\n", channel, voltage, adc);
+            DBG_SENSOR("ADS1115 Ch%d: %.4f V (raw: %d)", channel, voltage, adc);
             return SensorReading(voltage);
         }
         return SensorReading("ADS1115 not available");
@@ -1190,7 +1444,7 @@ SensorReading SensorReader::readAnalog(const SensorAssignmentConfig& config, int
     if (config.analogPin > 0) {
         int rawValue = analogRead(config.analogPin);
         float voltage = (rawValue / 4095.0) * 3.3;
-        Serial.printf("[SensorReader] ESP32 ADC Pin %d: %.2f V\n", config.analogPin, voltage);
+        DBG_SENSOR("ESP32 ADC Pin %d: %.2f V", config.analogPin, voltage);
         return SensorReading(voltage);
     }
 
@@ -1228,25 +1482,16 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
         int txPin = config.digitalPin > 0 ? config.digitalPin : -1; // ESP TX -> not used for auto-mode
 
         int baudRate = config.baudRate > 0 ? config.baudRate : 115200;  // Default to 115200 if not configured
-        Serial.printf("[SR04M-2] UART mode - RX=GPIO%d, TX=%s, Baud=%d (from config: %d)\n",
-                      rxPin, txPin < 0 ? "none" : String(txPin).c_str(), baudRate, config.baudRate);
+        DBG_SENSOR("SR04M-2: UART mode - RX=GPIO%d, TX=%s, Baud=%d (from config: %d)",
+                   rxPin, txPin < 0 ? "none" : String(txPin).c_str(), baudRate, config.baudRate);
 
-        // Always reinitialize to apply current baud rate
-        _sr04m2_ready = false;
+        // Re-acquire to apply the configured baud rate (in place, lease is kept)
         if (!initSR04M2(rxPin, txPin, baudRate)) {
             return SensorReading("SR04M-2 not available");
         }
 
-        // Get UART port from UARTManager (dynamically allocated)
-        UARTManager& uartMgr = UARTManager::getInstance();
-        int uartNum_int = uartMgr.getUartForOwner("SR04M2");
-        if (uartNum_int < 0) {
-            return SensorReading("SR04M-2 UART not allocated");
-        }
-        const uart_port_t uart_num = (uartNum_int == 1) ? UART_NUM_1 : UART_NUM_2;
-
         // Clear RX buffer first
-        uart_flush_input(uart_num);
+        _sr04m2Lease->flushInput();
         delay(10);
 
         // Wait for frame (sensor sends every ~100ms in auto-mode)
@@ -1257,19 +1502,15 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
         bool frameFound = false;
         int frameStartIdx = -1;
 
-        Serial.println("[SR04M-2] Waiting for frame (0xFF 0xFE header)...");
+        DBG_SENSOR("SR04M-2: Waiting for frame (0xFF 0xFE header)...");
 
         // Read up to 500ms or until we find a valid frame
         while (millis() - startTime < 500 && bufferPos < 30 && !frameFound) {
-            size_t buffered;
-            uart_get_buffered_data_len(uart_num, &buffered);
-
-            if (buffered > 0) {
+            if (_sr04m2Lease->available() > 0) {
                 uint8_t byte;
-                int len = uart_read_bytes(uart_num, &byte, 1, pdMS_TO_TICKS(10));
-                if (len > 0) {
+                if (_sr04m2Lease->read(&byte, 1) > 0) {
                     buffer[bufferPos++] = byte;
-                    Serial.printf("[SR04M-2] Byte %d: 0x%02X\n", bufferPos, byte);
+                    DBG_SENSOR("SR04M-2: Byte %d: 0x%02X", bufferPos, byte);
 
                     // Look for frame header 0xFF 0xFE
                     if (bufferPos >= 2) {
@@ -1279,7 +1520,7 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
                                 // Check if we have all 5 bytes of the frame
                                 if (bufferPos >= frameStartIdx + 5) {
                                     frameFound = true;
-                                    Serial.printf("[SR04M-2] Frame found at position %d!\n", frameStartIdx);
+                                    DBG_SENSOR("SR04M-2: Frame found at position %d!", frameStartIdx);
                                 }
                                 break;
                             }
@@ -1311,8 +1552,8 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
         uint8_t lowByte = buffer[frameStartIdx + 3];
         uint8_t checksum = buffer[frameStartIdx + 4];
 
-        Serial.printf("[SR04M-2] Frame: [0x%02X 0x%02X] H=0x%02X L=0x%02X CS=0x%02X\n",
-                      header1, header2, highByte, lowByte, checksum);
+        DBG_SENSOR("SR04M-2: Frame: [0x%02X 0x%02X] H=0x%02X L=0x%02X CS=0x%02X",
+                   header1, header2, highByte, lowByte, checksum);
 
         // Validate checksum: (DIST_HIGH + DIST_LOW) & 0xFF
         uint8_t calculatedChecksum = (highByte + lowByte) & 0xFF;
@@ -1332,7 +1573,7 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
             return SensorReading("SR04M-2 out of range");
         }
 
-        Serial.printf("[SR04M-2] SUCCESS! Distance: %u mm (%.2f cm)\n", distance_mm, distance_cm);
+        DBG_SENSOR("SR04M-2: SUCCESS! Distance: %u mm (%.2f cm)", distance_mm, distance_cm);
         return SensorReading(distance_cm);
     }
 
@@ -1346,15 +1587,15 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
         int trig = config.triggerPin > 0 ? config.triggerPin : 23;  // Default TRIG pin
         int echo = config.echoPin > 0 ? config.echoPin : 22;        // Default ECHO pin (needs voltage divider!)
 
-        Serial.printf("[Ultrasonic-GPIO] Mode 0 (HC-SR04 style) - TRIG=GPIO%d, ECHO=GPIO%d\n", trig, echo);
+        DBG_SENSOR("Ultrasonic-GPIO: Mode 0 (HC-SR04 style) - TRIG=GPIO%d, ECHO=GPIO%d", trig, echo);
 
-        if (!_ultrasonic_ready && !initUltrasonic(trig, echo)) {
-            return SensorReading("Ultrasonic not available");
+        if (!_ultrasonic_ready) {
+            return SensorReading("Ultrasonic not initialized");
         }
 
         // Check ECHO pin state before trigger
         int echoStateBefore = digitalRead(_ultrasonic_echo_pin);
-        Serial.printf("[Ultrasonic-GPIO] ECHO pin state before trigger: %s\n", echoStateBefore ? "HIGH" : "LOW");
+        DBG_SENSOR("Ultrasonic-GPIO: ECHO pin state before trigger: %s", echoStateBefore ? "HIGH" : "LOW");
 
         // Send pulse
         digitalWrite(_ultrasonic_trigger_pin, LOW);
@@ -1363,7 +1604,7 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
         delayMicroseconds(10);
         digitalWrite(_ultrasonic_trigger_pin, LOW);
 
-        Serial.println("[Ultrasonic-GPIO] Trigger pulse sent (10µs HIGH)");
+        DBG_SENSOR("Ultrasonic-GPIO: Trigger pulse sent (10µs HIGH)");
 
         // Measure echo time (timeout after 50ms = ~8.5m range - extended for debugging)
         long duration = pulseIn(_ultrasonic_echo_pin, HIGH, 50000);
@@ -1384,7 +1625,7 @@ SensorReading SensorReader::readWaterLevel(const SensorAssignmentConfig& config)
         // Distance = (duration / 2) * 0.0343
         float distance_cm = (duration / 2.0) * 0.0343;
 
-        Serial.printf("[Ultrasonic-GPIO] SUCCESS! Duration: %ld µs, Distance: %.2f cm\n", duration, distance_cm);
+        DBG_SENSOR("Ultrasonic-GPIO: SUCCESS! Duration: %ld µs, Distance: %.2f cm", duration, distance_cm);
         return SensorReading(distance_cm);
     }
 
@@ -1409,8 +1650,8 @@ SensorReading SensorReader::readLatitude(const SensorAssignmentConfig& config) {
         int rxPin = config.analogPin > 0 ? config.analogPin : 16;
         int txPin = config.digitalPin > 0 ? config.digitalPin : 17;
 
-        if (!_gps_ready && !initGPS(rxPin, txPin)) {
-            return SensorReading("GPS not available");
+        if (!_gps_ready) {
+            return SensorReading("GPS not initialized");
         }
 
         // Update GPS data from buffer (non-blocking, uses cached values)
@@ -1418,8 +1659,8 @@ SensorReading SensorReader::readLatitude(const SensorAssignmentConfig& config) {
 
         // Return cached latitude if we have a valid fix
         if (_gps_location_valid) {
-            Serial.printf("[SensorReader] GPS Latitude: %.6f° (Satellites: %d, HDOP: %.1f)\n",
-                         _gps_latitude, _gps_satellites, _gps_hdop);
+            DBG_GPS("GPS Latitude: %.6f° (Satellites: %d, HDOP: %.1f)",
+                   _gps_latitude, _gps_satellites, _gps_hdop);
             return SensorReading(_gps_latitude);
         }
 
@@ -1428,24 +1669,15 @@ SensorReading SensorReader::readLatitude(const SensorAssignmentConfig& config) {
             Serial.println("\n[SensorReader] GPS no fix detected - running diagnostics automatically...\n");
             _gps_debug_ran = true;
 
-            // Release GPS UART allocation via UARTManager to avoid conflict with debugGPS
-            UARTManager& uartMgr = UARTManager::getInstance();
-            uartMgr.releaseByOwner("GPS");
-            _gpsSerial = nullptr;
-            _gps_ready = false;
-
-            // Run GPS debug diagnostics (15 seconds)
+            // Run GPS debug diagnostics (15 seconds) on a tap of the GPS lease;
+            // the parser keeps consuming the lease so no NMEA data is lost
             HardwareScanner scanner;
-            scanner.debugGPS(rxPin, txPin, 15);
-
-            // Re-initialize GPS after debug (UARTManager will allocate fresh)
-            Serial.println("\n[SensorReader] Re-initializing GPS after diagnostics...");
-            initGPS(rxPin, txPin);
+            scanner.debugGPS(rxPin, txPin, 15, [this]() { updateGPS(); });
         } else if (!_gps_debug_ran) {
             _gps_debug_ran = true;  // Skip diagnostics in PRODUCTION/NORMAL mode
         }
 
-        Serial.printf("[SensorReader] GPS no fix (Satellites: %d, waiting for fix...)\n", _gps_satellites);
+        DBG_GPS("GPS no fix (Satellites: %d, waiting for fix...)", _gps_satellites);
         return SensorReading("GPS no fix");
     }
 
@@ -1467,11 +1699,8 @@ SensorReading SensorReader::readLongitude(const SensorAssignmentConfig& config)
     if (sensorCode.indexOf("NEO-6M") >= 0 || sensorCode.indexOf("NEO6M") >= 0 ||
         sensorCode.indexOf("GPS") >= 0 || sensorCode.indexOf("UBLOX") >= 0) {
 
-        int rxPin = config.analogPin > 0 ? config.analogPin : 16;
-        int txPin = config.digitalPin > 0 ? config.digitalPin : 17;
-
-        if (!_gps_ready && !initGPS(rxPin, txPin)) {
-            return SensorReading("GPS not available");
+        if (!_gps_ready) {
+            return SensorReading("GPS not initialized");
         }
 
         // Update GPS data from buffer (non-blocking, uses cached values)
@@ -1479,7 +1708,7 @@ SensorReading SensorReader::readLongitude(const SensorAssignmentConfig& config)
 
         // Return cached longitude if we have a valid fix
         if (_gps_location_valid) {
-            Serial.printf("[SensorReader] GPS Longitude: %.6f°\n", _gps_longitude);
+            DBG_GPS("GPS Longitude: %.6f°", _gps_longitude);
             return SensorReading(_gps_longitude);
         }
         return SensorReading("GPS no fix");
@@ -1503,11 +1732,8 @@ SensorReading SensorReader::readAltitude(const SensorAssignmentConfig& config) {
     if (sensorCode.indexOf("NEO-6M") >= 0 || sensorCode.indexOf("NEO6M") >= 0 ||
         sensorCode.indexOf("GPS") >= 0 || sensorCode.indexOf("UBLOX") >= 0) {
 
-        int rxPin = config.analogPin > 0 ? config.analogPin : 16;
-        int txPin = config.digitalPin > 0 ? config.digitalPin : 17;
-
-        if (!_gps_ready && !initGPS(rxPin, txPin)) {
-            return SensorReading("GPS not available");
+        if (!_gps_ready) {
+            return SensorReading("GPS not initialized");
         }
 
         // Update GPS data from buffer (non-blocking, uses cached values)
@@ -1515,7 +1741,7 @@ SensorReading SensorReader::readAltitude(const SensorAssignmentConfig& config) {
 
         // Return cached altitude if valid
         if (_gps_altitude_valid) {
-            Serial.printf("[SensorReader] GPS Altitude: %.2f m\n", _gps_altitude);
+            DBG_GPS("GPS Altitude: %.2f m", _gps_altitude);
             return SensorReading(_gps_altitude);
         }
         return SensorReading("GPS altitude not available");
@@ -1539,11 +1765,8 @@ SensorReading SensorReader::readSpeed(const SensorAssignmentConfig& config) {
     if (sensorCode.indexOf("NEO-6M") >= 0 || sensorCode.indexOf("NEO6M") >= 0 ||
         sensorCode.indexOf("GPS") >= 0 || sensorCode.indexOf("UBLOX") >= 0) {
 
-        int rxPin = config.analogPin > 0 ? config.analogPin : 16;
-        int txPin = config.digitalPin > 0 ? config.digitalPin : 17;
-
-        if (!_gps_ready && !initGPS(rxPin, txPin)) {
-            return SensorReading("GPS not available");
+        if (!_gps_ready) {
+            return SensorReading("GPS not initialized");
         }
 
         // Update GPS data from buffer (non-blocking, uses cached values)
@@ -1551,7 +1774,7 @@ SensorReading SensorReader::readSpeed(const SensorAssignmentConfig& config) {
 
         // Return cached speed if valid (works even at standstill with good fix)
         if (_gps_speed_valid || _gps_location_valid) {
-            Serial.printf("[SensorReader] GPS Speed: %.2f km/h\n", _gps_speed);
+            DBG_GPS("GPS Speed: %.2f km/h", _gps_speed);
             return SensorReading(_gps_speed);
         }
         return SensorReading("GPS speed not available");
@@ -1575,18 +1798,15 @@ SensorReading SensorReader::readGpsSatellites(const SensorAssignmentConfig& conf
     if (sensorCode.indexOf("NEO-6M") >= 0 || sensorCode.indexOf("NEO6M") >= 0 ||
         sensorCode.indexOf("GPS") >= 0 || sensorCode.indexOf("UBLOX") >= 0) {
 
-        int rxPin = config.analogPin > 0 ? config.analogPin : 16;
-        int txPin = config.digitalPin > 0 ? config.digitalPin : 17;
-
-        if (!_gps_ready && !initGPS(rxPin, txPin)) {
-            return SensorReading("GPS not available");
+        if (!_gps_ready) {
+            return SensorReading("GPS not initialized");
         }
 
         // Update GPS data from buffer (non-blocking, uses cached values)
         updateGPS();
 
         // Return cached satellite count (always available, even during cold start)
-        Serial.printf("[SensorReader] GPS Satellites: %d\n", _gps_satellites);
+        DBG_GPS("GPS Satellites: %d", _gps_satellites);
         return SensorReading((double)_gps_satellites);
     }
 
@@ -1609,19 +1829,16 @@ SensorReading SensorReader::readGpsFix(const SensorAssignmentConfig& config) {
     if (sensorCode.indexOf("NEO-6M") >= 0 || sensorCode.indexOf("NEO6M") >= 0 ||
         sensorCode.indexOf("GPS") >= 0 || sensorCode.indexOf("UBLOX") >= 0) {
 
-        int rxPin = config.analogPin > 0 ? config.analogPin : 16;
-        int txPin = config.digitalPin > 0 ? config.digitalPin : 17;
-
-        if (!_gps_ready && !initGPS(rxPin, txPin)) {
-            return SensorReading("GPS not available");
+        if (!_gps_ready) {
+            return SensorReading("GPS not initialized");
         }
 
         // Update GPS data from buffer (non-blocking, uses cached values)
         updateGPS();
 
         // Return cached fix type (updated by updateGPS based on satellites and HDOP)
-        Serial.printf("[SensorReader] GPS Fix Type: %d (Satellites: %d, HDOP: %.1f)\n",
-                     _gps_fix_type, _gps_satellites, _gps_hdop);
+        DBG_GPS("GPS Fix Type: %d (Satellites: %d, HDOP: %.1f)",
+               _gps_fix_type, _gps_satellites, _gps_hdop);
         return SensorReading((double)_gps_fix_type);
     }
 
@@ -1645,18 +1862,15 @@ SensorReading SensorReader::readGpsHdop(const SensorAssignmentConfig& config) {
     if (sensorCode.indexOf("NEO-6M") >= 0 || sensorCode.indexOf("NEO6M") >= 0 ||
         sensorCode.indexOf("GPS") >= 0 || sensorCode.indexOf("UBLOX") >= 0) {
 
-        int rxPin = config.analogPin > 0 ? config.analogPin : 16;
-        int txPin = config.digitalPin > 0 ? config.digitalPin : 17;
-
-        if (!_gps_ready && !initGPS(rxPin, txPin)) {
-            return SensorReading("GPS not available");
+        if (!_gps_ready) {
+            return SensorReading("GPS not initialized");
         }
 
         // Update GPS data from buffer (non-blocking, uses cached values)
         updateGPS();
 
         // Return cached HDOP
-        Serial.printf("[SensorReader] GPS HDOP: %.2f\n", _gps_hdop);
+        DBG_GPS("GPS HDOP: %.2f", _gps_hdop);
         return SensorReading(_gps_hdop);
     }
 
@@ -1672,7 +1886,7 @@ SensorReading SensorReader::readGpsHdop(const SensorAssignmentConfig& config) {
 
 void SensorReader::updateGPS() {
 #ifdef PLATFORM_ESP32
-    if (!_gps_ready || !_gpsSerial || !_gps) {
+    if (!_gps_ready || !_gpsLease || !_gps) {
         return;
     }
 
@@ -1681,8 +1895,8 @@ void SensorReader::updateGPS() {
     unsigned long startTime = millis();
     int bytesRead = 0;
 
-    while (_gpsSerial->available() > 0 && (millis() - startTime) < 50) {
-        char c = _gpsSerial->read();
+    while (_gpsLease->available() > 0 && (millis() - startTime) < 50) {
+        char c = _gpsLease->read();
         _gps->encode(c);
         bytesRead++;
     }
@@ -1824,11 +2038,13 @@ int SensorReader::initializeDetectedSensors() {
     const int INTERVAL_CO2 = 60;
 
     // Initialize I2C bus with default pins
-    initI2C(21, 22);
+    int busId = initI2C(DEFAULT_SDA_PIN, DEFAULT_SCL_PIN);
+    I2CBusLock busLock(busId);
+    _bleBus = busId;
 
     // Scan I2C bus for common sensors
-    Wire.beginTransmission(0x76);
-    if (Wire.endTransmission() == 0) {
+    _activeWire->beginTransmission(0x76);
+    if (_activeWire->endTransmission() == 0) {
         // Device at 0x76 - could be BME280 or BME680
         if (initBME280(0x76)) {
             Serial.println("[SensorReader] BME280 initialized at 0x76");
@@ -1839,8 +2055,8 @@ int SensorReader::initializeDetectedSensors() {
         }
     }
 
-    Wire.beginTransmission(0x77);
-    if (Wire.endTransmission() == 0) {
+    _activeWire->beginTransmission(0x77);
+    if (_activeWire->endTransmission() == 0) {
         if (initBME280(0x77)) {
             Serial.println("[SensorReader] BME280 initialized at 0x77");
             _bleSensors.push_back(BleSensorInfo("temperature", "BME280@0x77", "°C", INTERVAL_TEMPERATURE));
@@ -1850,8 +2066,8 @@ int SensorReader::initializeDetectedSensors() {
         }
     }
 
-    Wire.beginTransmission(0x23);
-    if (Wire.endTransmission() == 0) {
+    _activeWire->beginTransmission(0x23);
+    if (_activeWire->endTransmission() == 0) {
         if (initBH1750(0x23)) {
             Serial.println("[SensorReader] BH1750 initialized at 0x23");
             _bleSensors.push_back(BleSensorInfo("light", "BH1750@0x23", "lux", INTERVAL_LIGHT));
@@ -1859,8 +2075,8 @@ int SensorReader::initializeDetectedSensors() {
         }
     }
 
-    Wire.beginTransmission(0x5C);
-    if (Wire.endTransmission() == 0) {
+    _activeWire->beginTransmission(0x5C);
+    if (_activeWire->endTransmission() == 0) {
         if (initBH1750(0x5C)) {
             Serial.println("[SensorReader] BH1750 initialized at 0x5C");
             _bleSensors.push_back(BleSensorInfo("light", "BH1750@0x5C", "lux", INTERVAL_LIGHT));
@@ -1868,8 +2084,8 @@ int SensorReader::initializeDetectedSensors() {
         }
     }
 
-    Wire.beginTransmission(0x44);
-    if (Wire.endTransmission() == 0) {
+    _activeWire->beginTransmission(0x44);
+    if (_activeWire->endTransmission() == 0) {
         if (initSHT31(0x44)) {
             Serial.println("[SensorReader] SHT31 initialized at 0x44");
             _bleSensors.push_back(BleSensorInfo("temperature", "SHT31@0x44", "°C", INTERVAL_TEMPERATURE));
@@ -1878,8 +2094,8 @@ int SensorReader::initializeDetectedSensors() {
         }
     }
 
-    Wire.beginTransmission(0x61);
-    if (Wire.endTransmission() == 0) {
+    _activeWire->beginTransmission(0x61);
+    if (_activeWire->endTransmission() == 0) {
         if (initSCD30()) {
             Serial.println("[SensorReader] SCD30 initialized");
             _bleSensors.push_back(BleSensorInfo("co2", "SCD30", "ppm", INTERVAL_CO2));
@@ -1889,8 +2105,8 @@ int SensorReader::initializeDetectedSensors() {
         }
     }
 
-    Wire.beginTransmission(0x62);
-    if (Wire.endTransmission() == 0) {
+    _activeWire->beginTransmission(0x62);
+    if (_activeWire->endTransmission() == 0) {
         if (initSCD4x()) {
             Serial.println("[SensorReader] SCD4x initialized");
             _bleSensors.push_back(BleSensorInfo("co2", "SCD4x", "ppm", INTERVAL_CO2));
@@ -1916,11 +2132,19 @@ std::vector<SensorReader::SimpleSensorReading> SensorReader::readAllDetectedSens
     std::vector<SimpleSensorReading> readings;
 
 #ifdef PLATFORM_ESP32
+    // Drivers set up by initializeDetectedSensors() on the default bus
+    Adafruit_BME280* bme280_0x76 = getBME280(_bleBus, 0x76);
+    Adafruit_BME280* bme280_0x77 = getBME280(_bleBus, 0x77);
+    Adafruit_BME680* bme680_0x76 = getBME680(_bleBus, 0x76);
+    ClosedCube_SHT31D* sht31_0x44 = getSHT31(_bleBus, 0x44);
+    BH1750* bh1750_0x23 = getBH1750(_bleBus, 0x23);
+    BH1750* bh1750_0x5C = getBH1750(_bleBus, 0x5C);
+
     // Read from BME280 at 0x76
-    if (_bme280_0x76_ready && _bme280_0x76) {
-        float temp = _bme280_0x76->readTemperature();
-        float hum = _bme280_0x76->readHumidity();
-        float pressure = _bme280_0x76->readPressure() / 100.0F;
+    if (bme280_0x76) {
+        float temp = bme280_0x76->readTemperature();
+        float hum = bme280_0x76->readHumidity();
+        float pressure = bme280_0x76->readPressure() / 100.0F;
 
         if (!isnan(temp) && temp > -40 && temp < 85) {
             readings.push_back(SimpleSensorReading("temperature", temp, "°C"));
@@ -1934,10 +2158,10 @@ std::vector<SensorReader::SimpleSensorReading> SensorReader::readAllDetectedSens
     }
 
     // Read from BME280 at 0x77
-    if (_bme280_0x77_ready && _bme280_0x77) {
-        float temp = _bme280_0x77->readTemperature();
-        float hum = _bme280_0x77->readHumidity();
-        float pressure = _bme280_0x77->readPressure() / 100.0F;
+    if (bme280_0x77) {
+        float temp = bme280_0x77->readTemperature();
+        float hum = bme280_0x77->readHumidity();
+        float pressure = bme280_0x77->readPressure() / 100.0F;
 
         if (!isnan(temp) && temp > -40 && temp < 85) {
             readings.push_back(SimpleSensorReading("temperature", temp, "°C"));
@@ -1951,18 +2175,18 @@ std::vector<SensorReader::SimpleSensorReading> SensorReader::readAllDetectedSens
     }
 
     // Read from BME680 at 0x76
-    if (_bme680_0x76_ready && _bme680_0x76) {
-        if (_bme680_0x76->performReading()) {
-            readings.push_back(SimpleSensorReading("temperature", _bme680_0x76->temperature, "°C"));
-            readings.push_back(SimpleSensorReading("humidity", _bme680_0x76->humidity, "%"));
-            readings.push_back(SimpleSensorReading("pressure", _bme680_0x76->pressure / 100.0F, "hPa"));
-            readings.push_back(SimpleSensorReading("gas_resistance", _bme680_0x76->gas_resistance / 1000.0F, "kOhm"));
+    if (bme680_0x76) {
+        if (bme680_0x76->performReading()) {
+            readings.push_back(SimpleSensorReading("temperature", bme680_0x76->temperature, "°C"));
+            readings.push_back(SimpleSensorReading("humidity", bme680_0x76->humidity, "%"));
+            readings.push_back(SimpleSensorReading("pressure", bme680_0x76->pressure / 100.0F, "hPa"));
+            readings.push_back(SimpleSensorReading("gas_resistance", bme680_0x76->gas_resistance / 1000.0F, "kOhm"));
         }
     }
 
     // Read from SHT31 at 0x44
-    if (_sht31_0x44_ready && _sht31_0x44) {
-        SHT31D result = _sht31_0x44->readTempAndHumidity(SHT3XD_REPEATABILITY_HIGH, SHT3XD_MODE_POLLING, 50);
+    if (sht31_0x44) {
+        SHT31D result = sht31_0x44->readTempAndHumidity(SHT3XD_REPEATABILITY_HIGH, SHT3XD_MODE_POLLING, 50);
         if (result.error == SHT3XD_NO_ERROR) {
             readings.push_back(SimpleSensorReading("temperature", result.t, "°C"));
             readings.push_back(SimpleSensorReading("humidity", result.rh, "%"));
@@ -1970,16 +2194,16 @@ std::vector<SensorReader::SimpleSensorReading> SensorReader::readAllDetectedSens
     }
 
     // Read from BH1750 at 0x23
-    if (_bh1750_0x23_ready && _bh1750_0x23) {
-        float lux = _bh1750_0x23->readLightLevel();
+    if (bh1750_0x23) {
+        float lux = bh1750_0x23->readLightLevel();
         if (lux >= 0) {
             readings.push_back(SimpleSensorReading("light", lux, "lux"));
         }
     }
 
     // Read from BH1750 at 0x5C
-    if (_bh1750_0x5C_ready && _bh1750_0x5C) {
-        float lux = _bh1750_0x5C->readLightLevel();
+    if (bh1750_0x5C) {
+        float lux = bh1750_0x5C->readLightLevel();
         if (lux >= 0) {
             readings.push_back(SimpleSensorReading("light", lux, "lux"));
         }
@@ -2026,7 +2250,7 @@ std::vector<SensorReader::SimpleSensorReading> SensorReader::readAllDetectedSens
         }
     }
 
-    Serial.printf("[SensorReader] Read %d sensor values for BLE mode\n", readings.size());
+    DBG_SENSOR("Read %d sensor values for BLE mode", readings.size());
 #endif
 
     return readings;
@@ -2101,69 +2325,75 @@ SensorReader::SimpleSensorReading SensorReader::readBleSensor(size_t sensorIndex
     BleSensorInfo& sensor = _bleSensors[sensorIndex];
 
 #ifdef PLATFORM_ESP32
+    Adafruit_BME280* bme280_0x76 = getBME280(_bleBus, 0x76);
+    Adafruit_BME280* bme280_0x77 = getBME280(_bleBus, 0x77);
+    ClosedCube_SHT31D* sht31_0x44 = getSHT31(_bleBus, 0x44);
+    BH1750* bh1750_0x23 = getBH1750(_bleBus, 0x23);
+    BH1750* bh1750_0x5C = getBH1750(_bleBus, 0x5C);
+
     // Read based on sensor hardware and type
     const String& hw = sensor.sensorHardware;
     const String& type = sensor.type;
 
     // BME280 at 0x76
-    if (hw == "BME280@0x76" && _bme280_0x76_ready && _bme280_0x76) {
+    if (hw == "BME280@0x76" && bme280_0x76) {
         if (type == "temperature") {
-            float val = _bme280_0x76->readTemperature();
+            float val = bme280_0x76->readTemperature();
             if (!isnan(val) && val > -40 && val < 85) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         } else if (type == "humidity") {
-            float val = _bme280_0x76->readHumidity();
+            float val = bme280_0x76->readHumidity();
             if (!isnan(val) && val >= 0 && val <= 100) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         } else if (type == "pressure") {
-            float val = _bme280_0x76->readPressure() / 100.0F;
+            float val = bme280_0x76->readPressure() / 100.0F;
             if (!isnan(val) && val > 300 && val < 1200) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         }
     }
     // BME280 at 0x77
-    else if (hw == "BME280@0x77" && _bme280_0x77_ready && _bme280_0x77) {
+    else if (hw == "BME280@0x77" && bme280_0x77) {
         if (type == "temperature") {
-            float val = _bme280_0x77->readTemperature();
+            float val = bme280_0x77->readTemperature();
             if (!isnan(val) && val > -40 && val < 85) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         } else if (type == "humidity") {
-            float val = _bme280_0x77->readHumidity();
+            float val = bme280_0x77->readHumidity();
             if (!isnan(val) && val >= 0 && val <= 100) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         } else if (type == "pressure") {
-            float val = _bme280_0x77->readPressure() / 100.0F;
+            float val = bme280_0x77->readPressure() / 100.0F;
             if (!isnan(val) && val > 300 && val < 1200) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         }
     }
     // BH1750 at 0x23
-    else if (hw == "BH1750@0x23" && _bh1750_0x23_ready && _bh1750_0x23) {
+    else if (hw == "BH1750@0x23" && bh1750_0x23) {
         if (type == "light") {
-            float val = _bh1750_0x23->readLightLevel();
+            float val = bh1750_0x23->readLightLevel();
             if (val >= 0) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         }
     }
     // BH1750 at 0x5C
-    else if (hw == "BH1750@0x5C" && _bh1750_0x5C_ready && _bh1750_0x5C) {
+    else if (hw == "BH1750@0x5C" && bh1750_0x5C) {
         if (type == "light") {
-            float val = _bh1750_0x5C->readLightLevel();
+            float val = bh1750_0x5C->readLightLevel();
             if (val >= 0) {
                 result = SimpleSensorReading(type, val, sensor.unit);
             }
         }
     }
     // SHT31 at 0x44
-    else if (hw == "SHT31@0x44" && _sht31_0x44_ready && _sht31_0x44) {
-        SHT31D result31 = _sht31_0x44->readTempAndHumidity(SHT3XD_REPEATABILITY_HIGH,
+    else if (hw == "SHT31@0x44" && sht31_0x44) {
+        SHT31D result31 = sht31_0x44->readTempAndHumidity(SHT3XD_REPEATABILITY_HIGH,
                                                            SHT3XD_MODE_CLOCK_STRETCH,
                                                            50);
         if (result31.error == SHT3XD_NO_ERROR) {
@@ -2227,8 +2457,8 @@ std::vector<SensorReader::SimpleSensorReading> SensorReader::readDueSensors(unsi
             SimpleSensorReading reading = readBleSensor(i, nowMs);
             if (reading.valid) {
                 readings.push_back(reading);
-                Serial.printf("[SensorReader] Due sensor read: %s = %.2f %s\n",
-                              reading.type.c_str(), reading.value, reading.unit.c_str());
+                DBG_SENSOR("Due sensor read: %s = %.2f %s",
+                           reading.type.c_str(), reading.value, reading.unit.c_str());
             }
         }
     }
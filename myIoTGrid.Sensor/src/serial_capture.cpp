@@ -7,6 +7,7 @@
  */
 
 #include "serial_capture.h"
+#include <string.h>
 
 #ifdef PLATFORM_ESP32
 extern "C" {
@@ -20,6 +21,15 @@ static void serial_capture_putc_hook(char c);
 static bool _hookInstalled = false;
 #endif
 
+// The putc hook can run in any task (or ISR) context
+#ifdef PLATFORM_ESP32
+#define CAPTURE_LOCK()   portENTER_CRITICAL_SAFE(&_mux)
+#define CAPTURE_UNLOCK() portEXIT_CRITICAL_SAFE(&_mux)
+#else
+#define CAPTURE_LOCK()
+#define CAPTURE_UNLOCK()
+#endif
+
 // Global instance
 SerialCapture& RemoteSerial = SerialCapture::getInstance();
 
@@ -31,14 +41,29 @@ SerialCapture& SerialCapture::getInstance() {
 SerialCapture::SerialCapture()
     : _enabled(false)
     , _initialized(false)
-    , _maxBufferSize(8192)
-    , _lastCharTime(0) {
+    , _ring(nullptr)
+    , _capacity(0)
+    , _writePos(0)
+    , _firstLine(0)
+    , _lineCount(0)
+    , _pinnedLines(0)
+    , _stagingLength(0)
+    , _lastCharTime(0)
+    , _droppedBytes(0)
+    , _droppedLines(0) {
+    _staging[0] = '\0';
+#ifdef PLATFORM_ESP32
+    portMUX_INITIALIZE(&_mux);
+#endif
 }
 
 void SerialCapture::begin(size_t bufferSize) {
-    _maxBufferSize = bufferSize;
+    // The ring is allocated once and never resized
+    if (!_ring) {
+        _ring = new char[bufferSize];
+        _capacity = bufferSize;
+    }
     _initialized = true;
-    _lineBuffer.reserve(256);
 
 #ifdef PLATFORM_ESP32
     // Install low-level putc hook to capture ALL Serial output
@@ -66,65 +91,90 @@ static void serial_capture_putc_hook(char c) {
 void SerialCapture::captureChar(char c) {
     if (!_enabled || !_initialized) return;
 
+    CAPTURE_LOCK();
     _lastCharTime = millis();
 
     if (c == '\n') {
         // Line complete - check filter and store if matches
-        if (_lineBuffer.length() > 0) {
-            // Trim trailing \r if present
-            if (_lineBuffer.endsWith("\r")) {
-                _lineBuffer.remove(_lineBuffer.length() - 1);
-            }
-
-            // Only capture lines that match our filter criteria
-            if (shouldCaptureLine(_lineBuffer)) {
-                _completedLines.push_back(_lineBuffer);
-
-                // Prevent memory overflow
-                if (_completedLines.size() > 500) {
-                    _completedLines.erase(_completedLines.begin());
-                }
-            }
-            _lineBuffer = "";
-        }
+        commitStagedLine();
     } else if (c != '\r') {
         // Add character to current line (ignore \r)
-        if (_lineBuffer.length() < 1024) {
-            _lineBuffer += c;
+        if (_stagingLength < config::SERIAL_CAPTURE_MAX_LINE_LENGTH) {
+            _staging[_stagingLength++] = c;
+        }
+    }
+    CAPTURE_UNLOCK();
+}
+
+void SerialCapture::commitStagedLine() {
+    size_t length = _stagingLength;
+    _staging[length] = '\0';
+    _stagingLength = 0;
+
+    // Only capture lines that match our filter criteria
+    if (length == 0 || !shouldCaptureLine(_staging)) return;
+
+    // Line index full: overwrite the oldest entry unless it is being read
+    if (_lineCount == config::SERIAL_CAPTURE_MAX_LINES) {
+        if (_pinnedLines > 0) {
+            _droppedBytes += length;
+            _droppedLines++;
+            return;
+        }
+        dropOldestLine();
+    }
+
+    // Keep every line contiguous: skip the ring tail if the line would wrap
+    uint32_t pos = _writePos;
+    size_t offset = pos % _capacity;
+    if (offset + length > _capacity) {
+        pos += _capacity - offset;
+        offset = 0;
+    }
+
+    // Overwrite oldest lines that overlap the new one (pinned lines win)
+    while (_lineCount > 0 && (pos + length) - _lines[_firstLine].start > _capacity) {
+        if (_pinnedLines > 0) {
+            _droppedBytes += length;
+            _droppedLines++;
+            return;
         }
+        dropOldestLine();
     }
+
+    memcpy(_ring + offset, _staging, length);
+    LineRecord& record = _lines[(_firstLine + _lineCount) % config::SERIAL_CAPTURE_MAX_LINES];
+    record.start = pos;
+    record.length = (uint16_t)length;
+    _lineCount++;
+    _writePos = pos + length;
+}
+
+void SerialCapture::dropOldestLine() {
+    _droppedBytes += _lines[_firstLine].length;
+    _droppedLines++;
+    _firstLine = (_firstLine + 1) % config::SERIAL_CAPTURE_MAX_LINES;
+    _lineCount--;
 }
 
-bool SerialCapture::shouldCaptureLine(const String& line) const {
+bool SerialCapture::shouldCaptureLine(const char* line) const {
     // Capture [HW] hardware check messages - but NOT sensor readings that end with [HW]
     // Hardware check lines START with [HW], sensor readings END with [REMOTE] [HW]
-    if (line.startsWith("[HW]")) return true;
-
-    // Capture error messages (case insensitive patterns)
-    if (line.indexOf("Error") >= 0) return true;
-    if (line.indexOf("ERROR") >= 0) return true;
-    if (line.indexOf("error") >= 0) return true;
-    if (line.indexOf("Failed") >= 0) return true;
-    if (line.indexOf("FAILED") >= 0) return true;
-    if (line.indexOf("failed") >= 0) return true;
-    if (line.indexOf("FAIL") >= 0) return true;
-
-    // Capture warnings
-    if (line.indexOf("Warning") >= 0) return true;
-    if (line.indexOf("WARNING") >= 0) return true;
-    if (line.indexOf("WARN") >= 0) return true;
-
-    // Capture critical messages
-    if (line.indexOf("CRITICAL") >= 0) return true;
-    if (line.indexOf("Critical") >= 0) return true;
-
-    // Capture exception/crash info
-    if (line.indexOf("Exception") >= 0) return true;
-    if (line.indexOf("Panic") >= 0) return true;
-    if (line.indexOf("PANIC") >= 0) return true;
-    if (line.indexOf("Backtrace") >= 0) return true;
-    if (line.indexOf("Stack") >= 0) return true;
-    if (line.indexOf("Guru Meditation") >= 0) return true;
+    if (strncmp(line, "[HW]", 4) == 0) return true;
+
+    static const char* const PATTERNS[] = {
+        // Error messages (case variants)
+        "Error", "ERROR", "error", "Failed", "FAILED", "failed", "FAIL",
+        // Warnings
+        "Warning", "WARNING", "WARN",
+        // Critical messages
+        "CRITICAL", "Critical",
+        // Exception/crash info
+        "Exception", "Panic", "PANIC", "Backtrace", "Stack", "Guru Meditation"
+    };
+    for (const char* pattern : PATTERNS) {
+        if (strstr(line, pattern)) return true;
+    }
 
     // Not a match - don't capture
     return false;
@@ -143,32 +193,40 @@ size_t SerialCapture::write(const uint8_t* buffer, size_t size) {
     return size;
 }
 
-std::vector<String> SerialCapture::getAndClearLines() {
-    std::vector<String> result = std::move(_completedLines);
-    _completedLines.clear();
+size_t SerialCapture::peekLines(SerialCaptureLine* out, size_t maxLines) {
+    if (!_initialized) return 0;
 
+    CAPTURE_LOCK();
     // If there's a partial line that's been sitting for a while, include it
-    if (_lineBuffer.length() > 0 && (millis() - _lastCharTime) > 500) {
-        result.push_back(_lineBuffer);
-        _lineBuffer = "";
+    if (_stagingLength > 0 && (millis() - _lastCharTime) > 500) {
+        commitStagedLine();
     }
 
-    return result;
-}
-
-String SerialCapture::getAndClearBuffer() {
-    String result;
-
-    for (const auto& line : _completedLines) {
-        result += line + "\n";
+    size_t count = (_lineCount < maxLines) ? _lineCount : maxLines;
+    for (size_t i = 0; i < count; i++) {
+        const LineRecord& record = _lines[(_firstLine + i) % config::SERIAL_CAPTURE_MAX_LINES];
+        out[i].data = _ring + (record.start % _capacity);
+        out[i].length = record.length;
     }
-    _completedLines.clear();
+    _pinnedLines = count;
+    CAPTURE_UNLOCK();
+    return count;
+}
 
-    // Include partial line if old enough
-    if (_lineBuffer.length() > 0 && (millis() - _lastCharTime) > 500) {
-        result += _lineBuffer + "\n";
-        _lineBuffer = "";
-    }
+void SerialCapture::consumeLines(size_t count) {
+    CAPTURE_LOCK();
+    if (count > _lineCount) count = _lineCount;
+    _firstLine = (_firstLine + count) % config::SERIAL_CAPTURE_MAX_LINES;
+    _lineCount -= count;
+    _pinnedLines = 0;
+    CAPTURE_UNLOCK();
+}
 
-    return result;
+void SerialCapture::clear() {
+    CAPTURE_LOCK();
+    _firstLine = 0;
+    _lineCount = 0;
+    _pinnedLines = 0;
+    _stagingLength = 0;
+    CAPTURE_UNLOCK();
 }
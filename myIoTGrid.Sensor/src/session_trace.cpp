@@ -0,0 +1,419 @@
+/**
+ * myIoTGrid.Sensor - Session Trace Implementation
+ */
+
+#include "session_trace.h"
+#include "config.h"
+#include <ctime>
+
+#ifdef PLATFORM_NATIVE
+#include "virtual_clock.h"
+#include <cstdlib>
+#endif
+
+namespace {
+
+constexpr int TRACE_VERSION = 1;
+constexpr const char* TRACE_PREFIX = "#T\t";
+constexpr unsigned long MIN_VALID_UNIX_TIME = 1600000000UL;  // Earlier = clock not set yet
+
+// Tabs and line breaks inside a field would split the event
+String escape(const String& text) {
+    String out;
+    out.reserve(text.length());
+    for (size_t i = 0; i < text.length(); i++) {
+        char c = text[i];
+        switch (c) {
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\\': out += "\\\\"; break;
+            default: out += c; break;
+        }
+    }
+    return out;
+}
+
+#ifdef PLATFORM_NATIVE
+std::string unescape(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            out += text[i];
+            continue;
+        }
+        char c = text[++i];
+        out += c == 't' ? '\t' : c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+    }
+    return out;
+}
+
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+        if (tab == std::string::npos) {
+            return fields;
+        }
+        start = tab + 1;
+    }
+}
+
+bool parseUnsigned(const std::string& text, unsigned long& value) {
+    char* end = nullptr;
+    value = std::strtoul(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0';
+}
+
+// Targets contain the serial (/api/nodes/{serial}/...), which differs between
+// the recording and the replaying device
+std::string mapSerial(const std::string& target, const String& serial) {
+    if (serial.length() == 0) {
+        return target;
+    }
+    static const std::string placeholder = "{serial}";
+    std::string mapped = target;
+    std::string find = serial.c_str();
+    for (size_t pos = mapped.find(find); pos != std::string::npos; pos = mapped.find(find, pos + placeholder.size())) {
+        mapped.replace(pos, find.size(), placeholder);
+    }
+    return mapped;
+}
+
+std::string exchangeKey(const std::string& method, const std::string& target) {
+    return "N " + method + " " + target;
+}
+
+std::string sensorKey(const std::string& endpointId, const std::string& type) {
+    return "S " + endpointId + " " + type;
+}
+#endif
+
+} // namespace
+
+SessionTrace& SessionTrace::getInstance() {
+    static SessionTrace instance;
+    return instance;
+}
+
+SessionTrace::SessionTrace()
+    : _mode(Mode::OFF)
+    , _started(false)
+    , _ready(true)
+    , _recording(false)
+    , _startMs(0)
+    , _recordLimitMs(0)
+    , _eventCount(0)
+    , _replayedCount(0)
+    , _missCount(0)
+    , _maxDriftMs(0)
+    , _lastEventMs(0) {
+}
+
+bool SessionTrace::begin() {
+    if (_started) {
+        return _ready;
+    }
+    _started = true;
+
+#ifdef PLATFORM_NATIVE
+    const char* replayPath = std::getenv(config::ENV_SESSION_REPLAY);
+    const char* recordPath = std::getenv(config::ENV_SESSION_RECORD);
+
+    const char* recordSeconds = std::getenv(config::ENV_SESSION_RECORD_SECONDS);
+
+    if (replayPath && replayPath[0] != '\0') {
+        _ready = load(replayPath);
+        if (!_ready) {
+            return false;
+        }
+        _mode = Mode::REPLAY;
+        Serial.printf("[Trace] Replaying %s: %u events over %lu s (virtual time)\n",
+                      replayPath, (unsigned)_eventCount, _lastEventMs / 1000);
+    }
+
+    if (recordPath && recordPath[0] != '\0') {
+        _file.open(recordPath, std::ios::out | std::ios::trunc);
+        if (!_file) {
+            Serial.printf("[Trace] Cannot write %s\n", recordPath);
+            _ready = false;
+            return false;
+        }
+        if (_mode == Mode::OFF) {
+            _mode = Mode::RECORD;
+            if (recordSeconds) {
+                _recordLimitMs = std::strtoul(recordSeconds, nullptr, 10) * 1000UL;
+            }
+        }
+        _recording = true;
+        Serial.printf("[Trace] Recording session to %s\n", recordPath);
+    }
+#elif defined(SESSION_TRACE)
+    _mode = Mode::RECORD;
+    _recording = true;
+    Serial.println("[Trace] Recording session to Serial (#T lines)");
+#endif
+
+    _startMs = millis();
+    if (_recording) {
+        unsigned long now = static_cast<unsigned long>(time(nullptr));
+        writeLine("V\t" + String(TRACE_VERSION) + "\t" + String(now >= MIN_VALID_UNIX_TIME ? now : 0UL));
+    }
+    return true;
+}
+
+void SessionTrace::setDeviceSerial(const String& serial) {
+    if (_deviceSerial == serial) {
+        return;
+    }
+    _deviceSerial = serial;
+    if (_recording) {
+        writeLine("D\t" + String(elapsedMs()) + "\t" + escape(serial));
+    }
+}
+
+void SessionTrace::recordExchange(const char* method, const String& target, const TraceExchange& exchange) {
+    if (!_recording) {
+        return;
+    }
+
+    // Events are stamped with the time the call was made
+    unsigned long now = elapsedMs();
+    unsigned long at = now > exchange.latencyMs ? now - exchange.latencyMs : 0;
+
+    String line = "N\t" + String(at) + "\t" + method + "\t" + escape(target);
+    line += "\t" + String(exchange.latencyMs) + "\t" + String(exchange.statusCode);
+    line += exchange.success ? "\t1\t" : "\t0\t";
+    line += escape(exchange.etag) + "\t" + escape(exchange.body) + "\t" + escape(exchange.error);
+    writeLine(line);
+    countRecorded();
+}
+
+void SessionTrace::recordSensor(int endpointId, const String& type, bool success, double value, const String& error) {
+    if (!_recording) {
+        return;
+    }
+
+    String line = "S\t" + String(elapsedMs()) + "\t" + String(endpointId) + "\t" + escape(type);
+    if (success) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.17g", value);
+        line += "\t1\t";
+        line += buffer;
+    } else {
+        line += "\t0\t" + escape(error);
+    }
+    writeLine(line);
+    countRecorded();
+}
+
+bool SessionTrace::replayExchange(const char* method, const String& target, TraceExchange& exchange) {
+#ifdef PLATFORM_NATIVE
+    if (_mode != Mode::REPLAY) {
+        return false;
+    }
+
+    exchange = TraceExchange();
+    auto it = _queues.find(exchangeKey(method, mapSerial(target.c_str(), _deviceSerial)));
+    if (it == _queues.end() || it->second.empty()) {
+        _missCount++;
+        exchange.error = "Not in session trace";
+        Serial.printf("[Trace] Miss: %s %s\n", method, target.c_str());
+        recordExchange(method, target, exchange);
+        return true;
+    }
+
+    Event& event = it->second.front();
+    noteReplayed(event.atMs);
+    hal::native::Clock::advanceMicros(static_cast<uint64_t>(event.exchange.latencyMs) * 1000);
+    exchange = event.exchange;
+    it->second.pop_front();
+    recordExchange(method, target, exchange);
+    return true;
+#else
+    (void)method;
+    (void)target;
+    (void)exchange;
+    return false;
+#endif
+}
+
+bool SessionTrace::replaySensor(int endpointId, const String& type, bool& success, double& value, String& error) {
+#ifdef PLATFORM_NATIVE
+    if (_mode != Mode::REPLAY) {
+        return false;
+    }
+
+    auto it = _queues.find(sensorKey(std::to_string(endpointId), type.c_str()));
+    if (it == _queues.end() || it->second.empty()) {
+        _missCount++;
+        Serial.printf("[Trace] Miss: sensor %d/%s\n", endpointId, type.c_str());
+        return false;
+    }
+
+    Event& event = it->second.front();
+    noteReplayed(event.atMs);
+    success = event.exchange.success;
+    value = event.value;
+    error = event.exchange.error;
+    it->second.pop_front();
+    return true;
+#else
+    (void)endpointId;
+    (void)type;
+    (void)success;
+    (void)value;
+    (void)error;
+    return false;
+#endif
+}
+
+bool SessionTrace::isFinished() {
+    if (_mode == Mode::RECORD) {
+        return _recordLimitMs > 0 && elapsedMs() >= _recordLimitMs;
+    }
+    if (_mode != Mode::REPLAY) {
+        return false;
+    }
+    return _replayedCount >= _eventCount ||
+           elapsedMs() > _lastEventMs + config::SESSION_REPLAY_END_GRACE_MS;
+}
+
+unsigned long SessionTrace::elapsedMs() const {
+    return millis() - _startMs;
+}
+
+void SessionTrace::writeLine(const String& line) {
+#ifdef PLATFORM_NATIVE
+    _file << TRACE_PREFIX << line.c_str() << '\n';
+    _file.flush();
+#else
+    // One write, so other output cannot end up inside the event
+    Serial.println(String(TRACE_PREFIX) + line);
+#endif
+}
+
+void SessionTrace::countRecorded() {
+    // While replaying, the event count is the size of the replayed trace
+    if (_mode == Mode::RECORD) {
+        _eventCount++;
+    }
+}
+
+void SessionTrace::noteReplayed(unsigned long recordedMs) {
+    _replayedCount++;
+    unsigned long now = elapsedMs();
+    unsigned long drift = now > recordedMs ? now - recordedMs : recordedMs - now;
+    if (drift > _maxDriftMs) {
+        _maxDriftMs = drift;
+    }
+}
+
+#ifdef PLATFORM_NATIVE
+
+bool SessionTrace::load(const char* path) {
+    std::ifstream file(path);
+    if (!file) {
+        Serial.printf("[Trace] Cannot open %s\n", path);
+        return false;
+    }
+
+    bool hasHeader = false;
+    unsigned long unixStart = 0;
+    String recordedSerial;
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(file, line)) {
+        lineNumber++;
+        // Serial monitor logs may add timestamps in front and CRLF line ends
+        size_t start = line.find(TRACE_PREFIX);
+        if (start == std::string::npos) {
+            continue;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        std::vector<std::string> fields = splitFields(line.substr(start + 3));
+        bool valid;
+        if (fields[0] == "V") {
+            unsigned long version = 0;
+            valid = fields.size() == 3 && parseUnsigned(fields[1], version) &&
+                    static_cast<int>(version) == TRACE_VERSION && parseUnsigned(fields[2], unixStart);
+            hasHeader = hasHeader || valid;
+        } else if (fields[0] == "D") {
+            valid = fields.size() == 3;
+            if (valid) {
+                recordedSerial = unescape(fields[2]).c_str();
+            }
+        } else {
+            valid = parseEvent(fields, recordedSerial);
+        }
+
+        if (!valid) {
+            Serial.printf("[Trace] %s:%u: invalid event\n", path, (unsigned)lineNumber);
+            return false;
+        }
+    }
+
+    if (!hasHeader) {
+        Serial.printf("[Trace] %s: no trace header (#T V line)\n", path);
+        return false;
+    }
+
+    // Recorded sessions start at their recorded wall-clock time
+    hal::native::Clock::useVirtualTime(unixStart);
+    return true;
+}
+
+bool SessionTrace::parseEvent(const std::vector<std::string>& fields, const String& recordedSerial) {
+    Event event;
+    std::string key;
+    unsigned long flag = 0;
+
+    if (fields[0] == "S" && fields.size() == 6) {
+        long endpointId = std::strtol(fields[2].c_str(), nullptr, 10);
+        if (!parseUnsigned(fields[1], event.atMs) || !parseUnsigned(fields[4], flag)) {
+            return false;
+        }
+        event.exchange.success = flag != 0;
+        if (event.exchange.success) {
+            char* end = nullptr;
+            event.value = std::strtod(fields[5].c_str(), &end);
+            if (fields[5].empty() || *end != '\0') {
+                return false;
+            }
+        } else {
+            event.exchange.error = unescape(fields[5]).c_str();
+        }
+        key = sensorKey(std::to_string(endpointId), unescape(fields[3]));
+    } else if (fields[0] == "N" && fields.size() == 10) {
+        if (!parseUnsigned(fields[1], event.atMs) || !parseUnsigned(fields[4], event.exchange.latencyMs) ||
+            !parseUnsigned(fields[6], flag)) {
+            return false;
+        }
+        // ESP32 HTTPClient reports transport errors as negative codes
+        long statusCode = std::strtol(fields[5].c_str(), nullptr, 10);
+        event.exchange.statusCode = static_cast<int>(statusCode);
+        event.exchange.success = flag != 0;
+        event.exchange.etag = unescape(fields[7]).c_str();
+        event.exchange.body = unescape(fields[8]).c_str();
+        event.exchange.error = unescape(fields[9]).c_str();
+        key = exchangeKey(fields[2], mapSerial(unescape(fields[3]), recordedSerial));
+    } else {
+        return false;
+    }
+
+    if (event.atMs > _lastEventMs) {
+        _lastEventMs = event.atMs;
+    }
+    _queues[key].push_back(std::move(event));
+    _eventCount++;
+    return true;
+}
+
+#endif // PLATFORM_NATIVE
@@ -0,0 +1,348 @@
+/**
+ * myIoTGrid.Sensor - Loop Stall Profiler Implementation
+ */
+
+#include "stall_monitor.h"
+#include "instrumentation.h"
+#include <string.h>
+
+#if defined(PLATFORM_ESP32) && defined(__XTENSA__) && __has_include(<freertos/task_snapshot.h>)
+#include <freertos/task_snapshot.h>
+#include <freertos/xtensa_context.h>
+#include <esp_debug_helpers.h>
+#include <soc/soc_memory_layout.h>
+#define STALL_BACKTRACE_SUPPORTED 1
+#endif
+
+#ifdef PLATFORM_ESP32
+#define STALL_LOCK()   taskENTER_CRITICAL(&_mux)
+#define STALL_UNLOCK() taskEXIT_CRITICAL(&_mux)
+#else
+#define STALL_LOCK()   _mutex.lock()
+#define STALL_UNLOCK() _mutex.unlock()
+#endif
+
+#ifdef STALL_BACKTRACE_SUPPORTED
+namespace {
+// Return address to the address of the call (same as the panic handler prints)
+uint32_t callAddress(uint32_t pc) {
+    if (pc & 0x80000000) {
+        pc = (pc & 0x3fffffff) | 0x40000000;  // Strip the register window size bits
+    }
+    return pc - 3;
+}
+} // namespace
+#endif
+
+StallMonitor& StallMonitor::getInstance() {
+    static StallMonitor instance;
+    return instance;
+}
+
+StallMonitor::StallMonitor()
+    : _iteration(0)
+    , _iterationStartMs(0)
+    , _inIteration(false)
+    , _stageDepth(0)
+    , _openValid(false)
+    , _worstCount(0)
+    , _stallCount(0)
+    , _started(false)
+    , _active(false)
+#ifdef PLATFORM_ESP32
+    , _loopTask(nullptr)
+    , _monitorTask(nullptr)
+#endif
+{
+    for (size_t i = 0; i < config::STALL_STAGE_DEPTH; i++) {
+        _stageStack[i].store(-1, std::memory_order_relaxed);
+    }
+#ifdef PLATFORM_ESP32
+    portMUX_INITIALIZE(&_mux);
+#endif
+}
+
+void StallMonitor::begin() {
+    if (_started) return;
+    _started = true;
+
+#ifdef PLATFORM_ESP32
+    _loopTask = xTaskGetCurrentTaskHandle();
+    // Pinned to the loop task's core: while the monitor runs, loop() is stopped
+    if (xTaskCreatePinnedToCore(monitorTask, "stall_monitor", config::STALL_MONITOR_TASK_STACK_SIZE,
+                                this, config::STALL_MONITOR_TASK_PRIORITY, &_monitorTask,
+                                xPortGetCoreID()) != pdPASS) {
+        Serial.println("[Stall] Failed to start monitor task");
+        return;
+    }
+#else
+    if (hal::native::Clock::isVirtual()) {
+        Serial.println("[Stall] Monitor off during session replay");
+        return;
+    }
+    _loopThread = std::this_thread::get_id();
+    std::thread(&StallMonitor::monitorThread, this).detach();
+#endif
+
+    _active = true;
+    Serial.printf("[Stall] Monitor started (threshold %lu ms)\n", (unsigned long)config::STALL_THRESHOLD_MS);
+}
+
+bool StallMonitor::onLoopTask() const {
+#ifdef PLATFORM_ESP32
+    return _loopTask != nullptr && xTaskGetCurrentTaskHandle() == _loopTask;
+#else
+    return std::this_thread::get_id() == _loopThread;
+#endif
+}
+
+// ============================================================================
+// Progress Markers (loop task)
+// ============================================================================
+
+void StallMonitor::beginIteration() {
+    if (!_active) return;
+
+    _iterationStartMs.store(millis(), std::memory_order_relaxed);
+    _iteration.fetch_add(1, std::memory_order_relaxed);
+    _inIteration.store(true, std::memory_order_release);
+}
+
+void StallMonitor::endIteration() {
+    if (!_active) return;
+
+    unsigned long durationMs = millis() - _iterationStartMs.load(std::memory_order_relaxed);
+    _inIteration.store(false, std::memory_order_release);
+
+    LoopStall stall;
+    bool stalled = false;
+    STALL_LOCK();
+    if (_openValid) {
+        stall = _open;
+        _openValid = false;
+        stalled = true;
+    } else if (durationMs >= config::STALL_THRESHOLD_MS) {
+        // Ended between two samples: duration only
+        stall.iteration = _iteration.load(std::memory_order_relaxed);
+        stall.startMs = _iterationStartMs.load(std::memory_order_relaxed);
+        stalled = true;
+    }
+    if (stalled) {
+        stall.durationMs = durationMs;
+        keepWorst(stall);
+        _stallCount++;
+    }
+    STALL_UNLOCK();
+
+    if (stalled) {
+        Serial.printf("[Stall] loop() blocked %lu ms in %s\n", durationMs, stageName(stall).c_str());
+    }
+}
+
+bool StallMonitor::enterStage(int stageId) {
+    if (stageId < 0 || !_active || !onLoopTask()) return false;
+
+    int depth = _stageDepth.load(std::memory_order_relaxed);
+    if (depth < (int)config::STALL_STAGE_DEPTH) {
+        _stageStack[depth].store(stageId, std::memory_order_relaxed);
+    }
+    _stageDepth.store(depth + 1, std::memory_order_release);
+    return true;
+}
+
+void StallMonitor::exitStage(bool entered) {
+    if (!entered) return;
+    _stageDepth.store(_stageDepth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+}
+
+// ============================================================================
+// Monitor
+// ============================================================================
+
+#ifdef PLATFORM_ESP32
+void StallMonitor::monitorTask(void* param) {
+    StallMonitor* self = static_cast<StallMonitor*>(param);
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(config::STALL_SAMPLE_INTERVAL_MS));
+        self->sample();
+    }
+}
+#else
+void StallMonitor::monitorThread() {
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(config::STALL_SAMPLE_INTERVAL_MS));
+        sample();
+    }
+}
+#endif
+
+void StallMonitor::sample() {
+    if (!_inIteration.load(std::memory_order_acquire)) return;
+
+    uint32_t iteration = _iteration.load(std::memory_order_relaxed);
+    unsigned long startMs = _iterationStartMs.load(std::memory_order_relaxed);
+    if (millis() - startMs < config::STALL_THRESHOLD_MS) return;
+
+    STALL_LOCK();
+    bool captured = _openValid && _open.iteration == iteration;
+    STALL_UNLOCK();
+    if (captured) return;
+
+    // First sample past the threshold: where is loop() now?
+    LoopStall stall;
+    stall.iteration = iteration;
+    stall.startMs = startMs;
+    int depth = _stageDepth.load(std::memory_order_acquire);
+    if (depth > (int)config::STALL_STAGE_DEPTH) depth = config::STALL_STAGE_DEPTH;
+    for (int i = 0; i < depth; i++) {
+        stall.stages[i] = _stageStack[i].load(std::memory_order_relaxed);
+    }
+    stall.stageCount = depth > 0 ? depth : 0;
+    captureBacktrace(stall);
+
+    STALL_LOCK();
+    if (_inIteration.load(std::memory_order_relaxed) &&
+        _iteration.load(std::memory_order_relaxed) == iteration) {
+        _open = stall;
+        _openValid = true;
+    }
+    STALL_UNLOCK();
+}
+
+void StallMonitor::captureBacktrace(LoopStall& stall) {
+    stall.backtraceDepth = 0;
+#ifdef STALL_BACKTRACE_SUPPORTED
+    // The loop task is stopped (same core, lower priority): its saved frame is current
+    TaskSnapshot_t snapshot;
+    vTaskGetSnapshot(_loopTask, &snapshot);
+
+    esp_backtrace_frame_t frame = {};
+    const XtExcFrame* interrupted = reinterpret_cast<const XtExcFrame*>(snapshot.pxTopOfStack);
+    if (interrupted->exit == 0) {
+        // Solicited frame: the task blocked or yielded
+        const XtSolFrame* solicited = reinterpret_cast<const XtSolFrame*>(snapshot.pxTopOfStack);
+        frame.pc = solicited->pc;
+        frame.sp = solicited->a1;
+        frame.next_pc = solicited->a0;
+    } else {
+        // Preempted by an interrupt
+        frame.pc = interrupted->pc;
+        frame.sp = interrupted->a1;
+        frame.next_pc = interrupted->a0;
+    }
+
+    stall.backtrace[stall.backtraceDepth++] = callAddress(frame.pc);
+    while (stall.backtraceDepth < config::STALL_BACKTRACE_DEPTH && frame.next_pc != 0) {
+        if (!esp_backtrace_get_next_frame(&frame) || !esp_stack_ptr_is_sane(frame.sp) ||
+            !esp_ptr_executable(reinterpret_cast<void*>(callAddress(frame.pc)))) {
+            break;
+        }
+        stall.backtrace[stall.backtraceDepth++] = callAddress(frame.pc);
+    }
+#endif
+}
+
+// ============================================================================
+// Worst Stalls
+// ============================================================================
+
+void StallMonitor::keepWorst(const LoopStall& stall) {
+    if (_worstCount < config::STALL_WORST_COUNT) {
+        _worst[_worstCount++] = stall;
+        return;
+    }
+
+    size_t shortest = 0;
+    for (size_t i = 1; i < _worstCount; i++) {
+        if (_worst[i].durationMs < _worst[shortest].durationMs) shortest = i;
+    }
+    if (stall.durationMs > _worst[shortest].durationMs) {
+        _worst[shortest] = stall;
+    }
+}
+
+size_t StallMonitor::copyWorst(LoopStall* out) const {
+    STALL_LOCK();
+    size_t count = _worstCount;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = _worst[i];
+    }
+    STALL_UNLOCK();
+
+    // Longest first (insertion sort, a handful of entries)
+    for (size_t i = 1; i < count; i++) {
+        LoopStall stall = out[i];
+        size_t j = i;
+        while (j > 0 && out[j - 1].durationMs < stall.durationMs) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = stall;
+    }
+    return count;
+}
+
+void StallMonitor::reset() {
+    STALL_LOCK();
+    _worstCount = 0;
+    _stallCount = 0;
+    STALL_UNLOCK();
+}
+
+String StallMonitor::stageName(const LoopStall& stall) const {
+    if (stall.stageCount == 0) return "loop";
+
+    Instrumentation& instrumentation = Instrumentation::getInstance();
+    String name;
+    for (uint8_t i = 0; i < stall.stageCount; i++) {
+        if (i > 0) name += " > ";
+        name += instrumentation.stageName(stall.stages[i]);
+    }
+    return name;
+}
+
+String StallMonitor::toJson() const {
+    LoopStall worst[config::STALL_WORST_COUNT];
+    size_t count = copyWorst(worst);
+
+    String json = "{\"thresholdMs\":" + String(config::STALL_THRESHOLD_MS);
+    json += ",\"stallCount\":" + String(_stallCount);
+    json += ",\"worst\":[";
+    for (size_t i = 0; i < count; i++) {
+        const LoopStall& stall = worst[i];
+        if (i > 0) json += ",";
+        json += "{\"durationMs\":" + String(stall.durationMs);
+        json += ",\"startMs\":" + String(stall.startMs);
+        json += ",\"stage\":\"" + stageName(stall) + "\"";
+        json += ",\"backtrace\":[";
+        for (uint8_t b = 0; b < stall.backtraceDepth; b++) {
+            char address[12];
+            snprintf(address, sizeof(address), "0x%08lx", (unsigned long)stall.backtrace[b]);
+            if (b > 0) json += ",";
+            json += "\"" + String(address) + "\"";
+        }
+        json += "]}";
+    }
+    json += "]}";
+    return json;
+}
+
+void StallMonitor::printReport() const {
+    LoopStall worst[config::STALL_WORST_COUNT];
+    size_t count = copyWorst(worst);
+
+    Serial.printf("[Stall] %lu stalls over %lu ms%s\n", (unsigned long)_stallCount,
+                  (unsigned long)config::STALL_THRESHOLD_MS, _active ? "" : " (monitor off)");
+    for (size_t i = 0; i < count; i++) {
+        const LoopStall& stall = worst[i];
+        Serial.printf("[Stall]   %6lu ms at %lu s in %s\n", stall.durationMs,
+                      stall.startMs / 1000, stageName(stall).c_str());
+        if (stall.backtraceDepth > 0) {
+            Serial.print("[Stall]     Backtrace:");
+            for (uint8_t b = 0; b < stall.backtraceDepth; b++) {
+                Serial.printf(" 0x%08lx", (unsigned long)stall.backtrace[b]);
+            }
+            Serial.println();
+        }
+    }
+}
@@ -3,6 +3,7 @@
  */
 
 #include "reading_storage.h"
+#include "instrumentation.h"
 #include <ArduinoJson.h>
 #ifdef PLATFORM_NATIVE
 #include "ArduinoJsonString.h"
@@ -59,7 +60,12 @@ bool ReadingStorage::storeReading(const StoredReading& reading) {
 
     // Append reading to file
     String line = reading.toCsv() + "\n";
-    if (!_sdManager->appendFile(filename.c_str(), line)) {
+    bool appended;
+    {
+        TIMED_SCOPE("sd.append");
+        appended = _sdManager->appendFile(filename.c_str(), line);
+    }
+    if (!appended) {
         Serial.printf("[ReadingStorage] Failed to write to %s\n", filename.c_str());
         return false;
     }
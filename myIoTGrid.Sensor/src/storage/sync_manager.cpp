@@ -3,6 +3,7 @@
  */
 
 #include "sync_manager.h"
+#include "instrumentation.h"
 #include "api_client.h"
 #include "wifi_manager.h"
 
@@ -192,7 +193,10 @@ SyncResult SyncManager::performSync() {
     Serial.printf("[SyncManager] Syncing %d readings...\n", pendingReadings.size());
 
     // Send batch
-    result = sendBatch(pendingReadings);
+    {
+        TIMED_SCOPE("sync.batch");
+        result = sendBatch(pendingReadings);
+    }
 
     // Reset force flag
     _forceSyncAll = false;
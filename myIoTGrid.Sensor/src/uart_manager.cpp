@@ -1,136 +1,236 @@
 /**
  * myIoTGrid.Sensor - UART Manager Implementation
  *
- * Dynamic UART port allocation for ESP32.
+ * Lease-based UART routing for ESP32.
  */
 
 #include "uart_manager.h"
 
 #ifdef PLATFORM_ESP32
 
+#include <new>
+
+static uart_port_t uartPort(int uartNum) {
+    return (uartNum == 1) ? UART_NUM_1 : UART_NUM_2;
+}
+
+const char* uartOwnerName(UARTOwner owner) {
+    switch (owner) {
+        case UARTOwner::GPS:         return "GPS";
+        case UARTOwner::SR04M2:      return "SR04M2";
+        case UARTOwner::GPS_SCAN:    return "GPS_SCAN";
+        case UARTOwner::SR04M2_SCAN: return "SR04M2_SCAN";
+        case UARTOwner::GPS_DEBUG:   return "GPS_DEBUG";
+        default:                     return "NONE";
+    }
+}
+
+// ============================================================================
+// RX Ring Buffer
+// ============================================================================
+
+UARTRxBuffer::UARTRxBuffer()
+    : _buffer(nullptr)
+    , _capacity(0)
+    , _head(0)
+    , _count(0)
+    , _overruns(0)
+{
+    portMUX_INITIALIZE(&_mux);
+}
+
+UARTRxBuffer::~UARTRxBuffer() {
+    deallocate();
+}
+
+bool UARTRxBuffer::allocate(size_t capacity) {
+    if (_buffer && _capacity == capacity) {
+        return true;
+    }
+    deallocate();
+    _buffer = new (std::nothrow) uint8_t[capacity];
+    if (!_buffer) return false;
+    _capacity = capacity;
+    return true;
+}
+
+void UARTRxBuffer::deallocate() {
+    taskENTER_CRITICAL(&_mux);
+    uint8_t* buffer = _buffer;
+    _buffer = nullptr;
+    _capacity = 0;
+    _head = 0;
+    _count = 0;
+    _overruns = 0;
+    taskEXIT_CRITICAL(&_mux);
+    delete[] buffer;
+}
+
+void UARTRxBuffer::push(const uint8_t* data, size_t len) {
+    taskENTER_CRITICAL(&_mux);
+    if (_buffer) {
+        for (size_t i = 0; i < len; i++) {
+            if (_count == _capacity) {
+                // Overwrite oldest: stale bytes are worth less than fresh frames
+                _head = (_head + 1) % _capacity;
+                _count--;
+                _overruns++;
+            }
+            _buffer[(_head + _count) % _capacity] = data[i];
+            _count++;
+        }
+    }
+    taskEXIT_CRITICAL(&_mux);
+}
+
+size_t UARTRxBuffer::available() const {
+    taskENTER_CRITICAL(&_mux);
+    size_t count = _count;
+    taskEXIT_CRITICAL(&_mux);
+    return count;
+}
+
+int UARTRxBuffer::read() {
+    uint8_t byte;
+    return read(&byte, 1) == 1 ? byte : -1;
+}
+
+size_t UARTRxBuffer::read(uint8_t* buffer, size_t len) {
+    taskENTER_CRITICAL(&_mux);
+    size_t n = (len < _count) ? len : _count;
+    for (size_t i = 0; i < n; i++) {
+        buffer[i] = _buffer[_head];
+        _head = (_head + 1) % _capacity;
+    }
+    _count -= n;
+    taskEXIT_CRITICAL(&_mux);
+    return n;
+}
+
+void UARTRxBuffer::clear() {
+    taskENTER_CRITICAL(&_mux);
+    _head = 0;
+    _count = 0;
+    taskEXIT_CRITICAL(&_mux);
+}
+
+// ============================================================================
+// Lease / Tap
+// ============================================================================
+
+UARTLease::UARTLease()
+    : _owner(UARTOwner::NONE)
+    , _uartNum(-1)
+    , _rxPin(-1)
+    , _txPin(-1)
+    , _baudRate(0)
+    , _rxInverted(false)
+{
+}
+
+size_t UARTLease::write(const uint8_t* data, size_t len) {
+    if (_uartNum < 0 || _txPin < 0) return 0;
+    int written = uart_write_bytes(uartPort(_uartNum), (const char*)data, len);
+    return written > 0 ? (size_t)written : 0;
+}
+
+void UARTLease::flushInput() {
+    if (_uartNum < 0) return;
+    uart_flush_input(uartPort(_uartNum));
+    clear();
+}
+
+UARTTap::UARTTap()
+    : _uartNum(-1)
+{
+}
+
+// ============================================================================
+// Manager
+// ============================================================================
+
 UARTManager& UARTManager::getInstance() {
     static UARTManager instance;
     return instance;
 }
 
 UARTManager::UARTManager()
-    : _serial1(nullptr)
-    , _serial2(nullptr)
+    : _mutex(xSemaphoreCreateMutex())
+    , _pumpTask(nullptr)
 {
-    // Initialize allocation slots
-    for (int i = 0; i < 2; i++) {
-        _allocations[i].uartNum = -1;
-        _allocations[i].rxPin = -1;
-        _allocations[i].txPin = -1;
-        _allocations[i].baudRate = 0;
-        _allocations[i].owner = "";
-        _allocations[i].serial = nullptr;
-        _allocations[i].useEspIdf = false;
-    }
 }
 
 UARTManager::~UARTManager() {
     releaseAll();
-    delete _serial1;
-    delete _serial2;
-}
-
-int UARTManager::allocate(int rxPin, int txPin, int baudRate, const String& owner, bool useEspIdf) {
-    Serial.printf("[UARTManager] Allocate request: owner=%s, RX=%d, TX=%d, baud=%d, ESP-IDF=%s\n",
-                  owner.c_str(), rxPin, txPin, baudRate, useEspIdf ? "yes" : "no");
-
-    // Check if these pins are already allocated
-    int existingUart = getUartForPins(rxPin, txPin);
-    if (existingUart > 0) {
-        int idx = existingUart - 1;
-        // If same owner or compatible config, return existing allocation
-        if (_allocations[idx].owner == owner ||
-            (_allocations[idx].rxPin == rxPin &&
-             (_allocations[idx].txPin == txPin || txPin < 0))) {
-            Serial.printf("[UARTManager] Reusing existing UART%d for %s\n", existingUart, owner.c_str());
-
-            // Update baud rate if different (requires reinit)
-            if (_allocations[idx].baudRate != baudRate) {
-                Serial.printf("[UARTManager] Baud rate changed %d -> %d, reinitializing\n",
-                              _allocations[idx].baudRate, baudRate);
-                endUart(existingUart);
-                _allocations[idx].baudRate = baudRate;
-                if (useEspIdf) {
-                    initEspIdf(existingUart, rxPin, txPin, baudRate);
-                } else {
-                    initArduino(existingUart, rxPin, txPin, baudRate);
-                }
+}
+
+UARTLease* UARTManager::acquire(UARTOwner owner, int rxPin, int txPin, int baudRate) {
+    Serial.printf("[UARTManager] Lease request: owner=%s, RX=%d, TX=%d, baud=%d\n",
+                  uartOwnerName(owner), rxPin, txPin, baudRate);
+
+    // Existing lease of this owner: reconfigure in place if the pins match
+    UARTLease* lease = getLease(owner);
+    if (lease) {
+        if (lease->_rxPin == rxPin && lease->_txPin == txPin) {
+            if (lease->_baudRate != baudRate) {
+                setBaudRate(lease, baudRate);
             }
-            return existingUart;
-        } else {
-            Serial.printf("[UARTManager] ERROR: Pins already in use by %s!\n",
-                          _allocations[idx].owner.c_str());
-            return -1;
+            return lease;
         }
+        Serial.printf("[UARTManager] %s moves to new pins, releasing UART%d\n",
+                      uartOwnerName(owner), lease->_uartNum);
+        release(owner);
+    }
+
+    // Pins leased by someone else: never steal, diagnostics use a tap
+    UARTLease* holder = getLeaseForPin(rxPin);
+    if (holder) {
+        Serial.printf("[UARTManager] ERROR: RX pin %d is leased by %s (use a tap)\n",
+                      rxPin, uartOwnerName(holder->_owner));
+        return nullptr;
     }
 
-    // Find first available UART
     int uartNum = getFirstAvailable();
     if (uartNum < 0) {
         Serial.println("[UARTManager] ERROR: No UART available!");
-        return -1;
+        return nullptr;
     }
 
-    // Allocate
-    int idx = uartNum - 1;
-    _allocations[idx].uartNum = uartNum;
-    _allocations[idx].rxPin = rxPin;
-    _allocations[idx].txPin = txPin;
-    _allocations[idx].baudRate = baudRate;
-    _allocations[idx].owner = owner;
-    _allocations[idx].useEspIdf = useEspIdf;
-
-    // Initialize UART
-    bool success;
-    if (useEspIdf) {
-        success = initEspIdf(uartNum, rxPin, txPin, baudRate);
-    } else {
-        success = initArduino(uartNum, rxPin, txPin, baudRate);
-    }
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    lease = &_leases[uartNum - 1];
+    lease->_owner = owner;
+    lease->_uartNum = uartNum;
+    lease->_rxPin = rxPin;
+    lease->_txPin = txPin;
+    lease->_baudRate = baudRate;
+    lease->_rxInverted = false;
 
+    bool success = lease->allocate(config::UART_LEASE_RX_BUFFER_SIZE) && initDriver(*lease);
     if (!success) {
         Serial.printf("[UARTManager] ERROR: Failed to initialize UART%d!\n", uartNum);
-        _allocations[idx].uartNum = -1;
-        _allocations[idx].owner = "";
-        return -1;
+        releaseLease(*lease);
+        xSemaphoreGive(_mutex);
+        return nullptr;
     }
+    xSemaphoreGive(_mutex);
 
-    Serial.printf("[UARTManager] Allocated UART%d for %s (RX=%d, TX=%d, %d baud)\n",
-                  uartNum, owner.c_str(), rxPin, txPin, baudRate);
-    return uartNum;
-}
-
-bool UARTManager::initArduino(int uartNum, int rxPin, int txPin, int baudRate) {
-    HardwareSerial** serialPtr = (uartNum == 1) ? &_serial1 : &_serial2;
-
-    // Create HardwareSerial instance if needed
-    if (!*serialPtr) {
-        *serialPtr = new HardwareSerial(uartNum);
+    if (!_pumpTask) {
+        xTaskCreate(pumpTask, "uart_pump", config::UART_PUMP_TASK_STACK_SIZE, this, 3, &_pumpTask);
     }
 
-    // Configure pins and start
-    int actualTxPin = (txPin < 0) ? -1 : txPin;  // -1 for RX-only mode
-    (*serialPtr)->begin(baudRate, SERIAL_8N1, rxPin, actualTxPin);
-
-    _allocations[uartNum - 1].serial = *serialPtr;
-
-    Serial.printf("[UARTManager] Arduino Serial%d initialized\n", uartNum);
-    return true;
+    Serial.printf("[UARTManager] Leased UART%d to %s (RX=%d, TX=%d, %d baud)\n",
+                  uartNum, uartOwnerName(owner), rxPin, txPin, baudRate);
+    return lease;
 }
 
-bool UARTManager::initEspIdf(int uartNum, int rxPin, int txPin, int baudRate) {
-    uart_port_t uart_port = (uartNum == 1) ? UART_NUM_1 : UART_NUM_2;
+bool UARTManager::initDriver(UARTLease& lease) {
+    uart_port_t uart_port = uartPort(lease._uartNum);
 
     // Delete existing driver if any
     uart_driver_delete(uart_port);
 
     uart_config_t uart_config = {
-        .baud_rate = baudRate,
+        .baud_rate = lease._baudRate,
         .data_bits = UART_DATA_8_BITS,
         .parity = UART_PARITY_DISABLE,
         .stop_bits = UART_STOP_BITS_1,
@@ -146,113 +246,133 @@ bool UARTManager::initEspIdf(int uartNum, int rxPin, int txPin, int baudRate) {
     }
 
     // Set pins: TX (ESP->Sensor), RX (Sensor->ESP)
-    int actualTxPin = (txPin < 0) ? UART_PIN_NO_CHANGE : txPin;
-    err = uart_set_pin(uart_port, actualTxPin, rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    int actualTxPin = (lease._txPin < 0) ? UART_PIN_NO_CHANGE : lease._txPin;
+    err = uart_set_pin(uart_port, actualTxPin, lease._rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
     if (err != ESP_OK) {
         Serial.printf("[UARTManager] uart_set_pin failed: %d\n", err);
         return false;
     }
 
-    // Install UART driver with RX buffer
-    err = uart_driver_install(uart_port, 256, 0, 0, NULL, 0);
+    // TX buffer 0 = writes block until the FIFO accepts them
+    err = uart_driver_install(uart_port, config::UART_DRIVER_RX_BUFFER_SIZE, 0, 0, NULL, 0);
     if (err != ESP_OK) {
         Serial.printf("[UARTManager] uart_driver_install failed: %d\n", err);
         return false;
     }
 
-    _allocations[uartNum - 1].serial = nullptr;  // ESP-IDF doesn't use HardwareSerial
-
-    Serial.printf("[UARTManager] ESP-IDF UART%d initialized\n", uartNum);
+    Serial.printf("[UARTManager] UART%d driver installed\n", lease._uartNum);
     return true;
 }
 
-void UARTManager::endUart(int uartNum) {
-    if (uartNum < 1 || uartNum > 2) return;
-
-    int idx = uartNum - 1;
-
-    if (_allocations[idx].useEspIdf) {
-        uart_port_t uart_port = (uartNum == 1) ? UART_NUM_1 : UART_NUM_2;
-        uart_driver_delete(uart_port);
-    } else {
-        HardwareSerial* serial = _allocations[idx].serial;
-        if (serial) {
-            serial->end();
+UARTLease* UARTManager::getLease(UARTOwner owner) {
+    for (int i = 0; i < UART_LEASE_COUNT; i++) {
+        if (_leases[i]._uartNum > 0 && _leases[i]._owner == owner) {
+            return &_leases[i];
         }
     }
-
-    Serial.printf("[UARTManager] UART%d ended\n", uartNum);
+    return nullptr;
 }
 
-HardwareSerial* UARTManager::getSerial(int uartNum) {
-    if (uartNum < 1 || uartNum > 2) return nullptr;
-    int idx = uartNum - 1;
-
-    if (_allocations[idx].uartNum < 0) return nullptr;
-    if (_allocations[idx].useEspIdf) return nullptr;
-
-    return _allocations[idx].serial;
-}
-
-int UARTManager::getUartForOwner(const String& owner) {
-    for (int i = 0; i < 2; i++) {
-        if (_allocations[i].uartNum > 0 && _allocations[i].owner == owner) {
-            return _allocations[i].uartNum;
+UARTLease* UARTManager::getLeaseForPin(int rxPin) {
+    for (int i = 0; i < UART_LEASE_COUNT; i++) {
+        if (_leases[i]._uartNum > 0 && _leases[i]._rxPin == rxPin) {
+            return &_leases[i];
         }
     }
-    return -1;
+    return nullptr;
 }
 
-int UARTManager::getUartForPins(int rxPin, int txPin) {
-    for (int i = 0; i < 2; i++) {
-        if (_allocations[i].uartNum > 0) {
-            bool rxMatch = (_allocations[i].rxPin == rxPin);
-            bool txMatch = (txPin < 0) || (_allocations[i].txPin == txPin) || (_allocations[i].txPin < 0);
-            if (rxMatch && txMatch) {
-                return _allocations[i].uartNum;
-            }
-        }
+bool UARTManager::setBaudRate(UARTLease* lease, int baudRate) {
+    if (!lease || lease->_uartNum < 0) return false;
+    if (uart_set_baudrate(uartPort(lease->_uartNum), baudRate) != ESP_OK) {
+        Serial.printf("[UARTManager] uart_set_baudrate failed on UART%d\n", lease->_uartNum);
+        return false;
     }
-    return -1;
+    Serial.printf("[UARTManager] UART%d (%s) baud rate %d -> %d (in place)\n",
+                  lease->_uartNum, uartOwnerName(lease->_owner), lease->_baudRate, baudRate);
+    lease->_baudRate = baudRate;
+    return true;
 }
 
-void UARTManager::release(int uartNum) {
-    if (uartNum < 1 || uartNum > 2) return;
+bool UARTManager::setRxInverted(UARTLease* lease, bool inverted) {
+    if (!lease || lease->_uartNum < 0) return false;
+    if (lease->_rxInverted == inverted) return true;
+    uint32_t mask = inverted ? UART_SIGNAL_RXD_INV : UART_SIGNAL_INV_DISABLE;
+    if (uart_set_line_inverse(uartPort(lease->_uartNum), mask) != ESP_OK) {
+        return false;
+    }
+    lease->_rxInverted = inverted;
+    return true;
+}
 
-    int idx = uartNum - 1;
-    if (_allocations[idx].uartNum < 0) return;
+void UARTManager::release(UARTOwner owner) {
+    UARTLease* lease = getLease(owner);
+    if (!lease) return;
 
     Serial.printf("[UARTManager] Releasing UART%d (was: %s)\n",
-                  uartNum, _allocations[idx].owner.c_str());
+                  lease->_uartNum, uartOwnerName(owner));
 
-    endUart(uartNum);
-
-    _allocations[idx].uartNum = -1;
-    _allocations[idx].rxPin = -1;
-    _allocations[idx].txPin = -1;
-    _allocations[idx].baudRate = 0;
-    _allocations[idx].owner = "";
-    _allocations[idx].serial = nullptr;
-    _allocations[idx].useEspIdf = false;
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    releaseLease(*lease);
+    xSemaphoreGive(_mutex);
 }
 
-void UARTManager::releaseByOwner(const String& owner) {
-    int uartNum = getUartForOwner(owner);
-    if (uartNum > 0) {
-        release(uartNum);
+void UARTManager::releaseLease(UARTLease& lease) {
+    if (lease._uartNum > 0) {
+        uart_driver_delete(uartPort(lease._uartNum));
+        for (int i = 0; i < config::UART_MAX_TAPS; i++) {
+            if (_taps[i]._uartNum == lease._uartNum) {
+                _taps[i]._uartNum = -1;
+                _taps[i].deallocate();
+            }
+        }
     }
+    lease.deallocate();
+    lease._owner = UARTOwner::NONE;
+    lease._uartNum = -1;
+    lease._rxPin = -1;
+    lease._txPin = -1;
+    lease._baudRate = 0;
+    lease._rxInverted = false;
 }
 
-void UARTManager::releaseByPins(int rxPin, int txPin) {
-    int uartNum = getUartForPins(rxPin, txPin);
-    if (uartNum > 0) {
-        release(uartNum);
+UARTTap* UARTManager::openTap(int rxPin) {
+    UARTLease* lease = getLeaseForPin(rxPin);
+    if (!lease) return nullptr;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    UARTTap* tap = nullptr;
+    for (int i = 0; i < config::UART_MAX_TAPS; i++) {
+        if (_taps[i]._uartNum < 0) {
+            if (_taps[i].allocate(config::UART_TAP_BUFFER_SIZE)) {
+                _taps[i]._uartNum = lease->_uartNum;
+                tap = &_taps[i];
+            }
+            break;
+        }
+    }
+    xSemaphoreGive(_mutex);
+
+    if (tap) {
+        Serial.printf("[UARTManager] Tap opened on UART%d (%s)\n",
+                      lease->_uartNum, uartOwnerName(lease->_owner));
+    } else {
+        Serial.println("[UARTManager] ERROR: No tap available!");
     }
+    return tap;
+}
+
+void UARTManager::closeTap(UARTTap* tap) {
+    if (!tap) return;
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    tap->_uartNum = -1;
+    tap->deallocate();
+    xSemaphoreGive(_mutex);
 }
 
 bool UARTManager::isAvailable(int uartNum) {
-    if (uartNum < 1 || uartNum > 2) return false;
-    return _allocations[uartNum - 1].uartNum < 0;
+    if (uartNum < 1 || uartNum > UART_LEASE_COUNT) return false;
+    return _leases[uartNum - 1]._uartNum < 0;
 }
 
 int UARTManager::getFirstAvailable() {
@@ -262,29 +382,105 @@ int UARTManager::getFirstAvailable() {
     return -1;
 }
 
+// ============================================================================
+// RX Pump
+// ============================================================================
+
+void UARTManager::pumpTask(void* param) {
+    UARTManager* self = static_cast<UARTManager*>(param);
+    for (;;) {
+        self->pump();
+        vTaskDelay(pdMS_TO_TICKS(config::UART_PUMP_INTERVAL_MS));
+    }
+}
+
+void UARTManager::pump() {
+    uint8_t chunk[64];
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    for (int i = 0; i < UART_LEASE_COUNT; i++) {
+        UARTLease& lease = _leases[i];
+        if (lease._uartNum < 0) continue;
+
+        uart_port_t uart_port = uartPort(lease._uartNum);
+        int len;
+        while ((len = uart_read_bytes(uart_port, chunk, sizeof(chunk), 0)) > 0) {
+            lease.push(chunk, len);
+            for (int t = 0; t < config::UART_MAX_TAPS; t++) {
+                if (_taps[t]._uartNum == lease._uartNum) {
+                    _taps[t].push(chunk, len);
+                }
+            }
+        }
+    }
+    xSemaphoreGive(_mutex);
+}
+
 void UARTManager::printAllocations() {
-    Serial.println("\n[UARTManager] Current allocations:");
+    Serial.println("\n[UARTManager] Current leases:");
     Serial.println("----------------------------------------");
-    for (int i = 0; i < 2; i++) {
+    for (int i = 0; i < UART_LEASE_COUNT; i++) {
         int uartNum = i + 1;
-        if (_allocations[i].uartNum > 0) {
-            Serial.printf("  UART%d: %s (RX=%d, TX=%d, %d baud, %s)\n",
+        const UARTLease& lease = _leases[i];
+        if (lease._uartNum > 0) {
+            Serial.printf("  UART%d: %s (RX=%d, TX=%d, %d baud, %u buffered, %lu overruns)\n",
                           uartNum,
-                          _allocations[i].owner.c_str(),
-                          _allocations[i].rxPin,
-                          _allocations[i].txPin,
-                          _allocations[i].baudRate,
-                          _allocations[i].useEspIdf ? "ESP-IDF" : "Arduino");
+                          uartOwnerName(lease._owner),
+                          lease._rxPin,
+                          lease._txPin,
+                          lease._baudRate,
+                          (unsigned)lease.available(),
+                          (unsigned long)lease.getOverrunCount());
         } else {
             Serial.printf("  UART%d: available\n", uartNum);
         }
     }
+    for (int i = 0; i < config::UART_MAX_TAPS; i++) {
+        if (_taps[i]._uartNum > 0) {
+            Serial.printf("  Tap %d: mirroring UART%d\n", i, _taps[i]._uartNum);
+        }
+    }
     Serial.println("----------------------------------------\n");
 }
 
 void UARTManager::releaseAll() {
-    release(1);
-    release(2);
+    for (int i = 0; i < UART_LEASE_COUNT; i++) {
+        if (_leases[i]._uartNum > 0) {
+            release(_leases[i]._owner);
+        }
+    }
+}
+
+// ============================================================================
+// Probe
+// ============================================================================
+
+UARTProbe::UARTProbe(UARTOwner owner, int rxPin, int txPin, int baudRate)
+    : _owner(owner)
+    , _lease(nullptr)
+    , _tap(nullptr)
+{
+    UARTManager& uartMgr = UARTManager::getInstance();
+    UARTLease* holder = uartMgr.getLeaseForPin(rxPin);
+    if (holder && holder->getOwner() != owner) {
+        _tap = uartMgr.openTap(rxPin);
+    } else {
+        _lease = uartMgr.acquire(owner, rxPin, txPin, baudRate);
+    }
+}
+
+UARTProbe::~UARTProbe() {
+    UARTManager& uartMgr = UARTManager::getInstance();
+    if (_tap) {
+        uartMgr.closeTap(_tap);
+    } else if (_lease) {
+        uartMgr.release(_owner);
+    }
+}
+
+UARTRxBuffer* UARTProbe::rx() const {
+    if (_tap) return _tap;
+    return _lease;
 }
 
 #endif // PLATFORM_ESP32
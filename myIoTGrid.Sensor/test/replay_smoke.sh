@@ -0,0 +1,148 @@
+#!/bin/bash
+# =============================================================================
+# myIoTGrid.Sensor - Session Record/Replay Smoke Test
+# =============================================================================
+# Runs the native firmware (src/main.cpp) against a stub Hub while recording
+# the session, replays the recording without the Hub and compares the
+# traces: the replay must answer every call from the recording (exit code 0)
+# and see the same events in the same order.
+#
+# Usage: test/replay_smoke.sh [record seconds, default 75: one heartbeat]
+#        PROGRAM=<native binary> skips `pio run -e native`
+#        KEEP=1 keeps the traces and logs (path in the output)
+# =============================================================================
+
+set -e
+
+cd "$(dirname "$0")/.."
+
+RECORD_SECONDS="${1:-75}"
+if [ -z "$PROGRAM" ]; then
+    pio run -e native
+    PROGRAM=.pio/build/native/program
+fi
+PROGRAM="$(cd "$(dirname "$PROGRAM")" && pwd)/$(basename "$PROGRAM")"
+
+WORK="$(mktemp -d)"
+HUB_PID=""
+cleanup() {
+    if [ -n "$HUB_PID" ]; then
+        kill "$HUB_PID" 2>/dev/null || true
+    fi
+    [ -n "$KEEP" ] || rm -rf "$WORK"
+}
+trap cleanup EXIT
+
+fail() {
+    echo "[Smoke] FAILED: $1"
+    echo "[Smoke] Logs:"
+    tail -n 40 "$WORK"/*.log
+    exit 1
+}
+
+# Stub Hub: registration, one simulated BME280, heartbeat and readings
+cat > "$WORK/hub.py" <<'EOF'
+import http.server, json, sys, time
+
+SENSORS = [{
+    "endpointId": 1, "sensorCode": "BME280", "sensorName": "Climate", "isActive": True,
+    "intervalSeconds": 5,
+    "capabilities": [{"measurementType": "temperature", "unit": "°C"},
+                     {"measurementType": "humidity", "unit": "%"}]
+}]
+
+class Hub(http.server.BaseHTTPRequestHandler):
+    def reply(self, status, body, etag=None):
+        data = json.dumps(body).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        if etag:
+            self.send_header("ETag", etag)
+        self.end_headers()
+        self.wfile.write(data)
+
+    def do_GET(self):
+        path = self.path.split("?")[0]
+        serial = path.split("/")[3] if path.count("/") >= 4 else ""
+        if path.endswith("/configuration"):
+            self.reply(200, {"nodeId": serial, "serialNumber": serial, "name": "Smoke Node",
+                             "isSimulation": True, "defaultIntervalSeconds": 5, "storageMode": 0,
+                             "sensors": SENSORS}, etag='"1"')
+        elif path.endswith("/debug"):
+            self.reply(200, {"nodeId": serial, "debugLevel": "NORMAL", "enableRemoteLogging": False})
+        elif path == "/api/time":
+            self.reply(200, {"unixTimestamp": int(time.time())})
+        else:
+            self.reply(404, {})
+
+    def do_POST(self):
+        body = json.loads(self.rfile.read(int(self.headers.get("Content-Length") or 0)) or b"{}")
+        if self.path == "/api/Nodes/register":
+            serial = body.get("serialNumber", "")
+            self.reply(200, {"nodeId": serial, "serialNumber": serial, "name": "Smoke Node",
+                             "intervalSeconds": 5, "isNewNode": True})
+        elif self.path == "/api/nodes/heartbeat":
+            self.reply(200, {"success": True, "serverTime": int(time.time()), "nextHeartbeatSeconds": 60,
+                             "unixTimestamp": int(time.time()), "configurationVersion": '"1"'})
+        elif self.path == "/api/readings":
+            self.reply(201, {})
+        elif self.path.startswith("/api/readings/") or self.path.startswith("/api/node-debug/"):
+            self.reply(200, {})
+        else:
+            self.reply(404, {})
+
+    def log_message(self, format, *args):
+        sys.stderr.write("[Hub] " + (format % args) + "\n")
+
+server = http.server.ThreadingHTTPServer(("127.0.0.1", 0), Hub)
+print(server.server_address[1], flush=True)
+server.serve_forever()
+EOF
+
+python3 "$WORK/hub.py" > "$WORK/hub.port" 2> "$WORK/hub.log" &
+HUB_PID=$!
+for _ in $(seq 50); do
+    [ -s "$WORK/hub.port" ] && break
+    sleep 0.1
+done
+[ -s "$WORK/hub.port" ] || fail "stub Hub did not start"
+
+run_node() {
+    (cd "$WORK" && env DATA_DIR="$WORK" SIM_SEED=1 DISCOVERY_ENABLED=false \
+        HUB_HOST=127.0.0.1 HUB_PORT="$(cat "$WORK/hub.port")" HUB_PROTOCOL=http \
+        "$@" "$PROGRAM" < /dev/null)
+}
+
+[ -n "$KEEP" ] && echo "[Smoke] Work directory: $WORK"
+echo "[Smoke] Recording ${RECORD_SECONDS} s against the stub Hub..."
+run_node SESSION_RECORD="$WORK/recorded.trace" SESSION_RECORD_SECONDS="$RECORD_SECONDS" \
+    > "$WORK/record.log" 2>&1 || fail "recording exited with $?"
+
+# The replay must not need the Hub
+kill "$HUB_PID"
+wait "$HUB_PID" 2>/dev/null || true
+HUB_PID=""
+
+echo "[Smoke] Replaying..."
+status=0
+run_node SESSION_REPLAY="$WORK/recorded.trace" SESSION_RECORD="$WORK/replayed.trace" \
+    > "$WORK/replay.log" 2>&1 || status=$?
+[ "$status" -eq 0 ] || fail "replay exited with $status (2 = diverged from the recording)"
+
+# Events without their time column
+events() {
+    grep -P '^#T\t[SN]\t' "$1" | cut -f 1,2,4-
+}
+events "$WORK/recorded.trace" > "$WORK/recorded.events"
+events "$WORK/replayed.trace" > "$WORK/replayed.events"
+
+grep -q -P '^#T\tS\t' "$WORK/recorded.events" || fail "no sensor reads recorded"
+grep -q -P '^#T\tN\tPOST\t/api/readings' "$WORK/recorded.events" || fail "no readings sent"
+diff -u "$WORK/recorded.events" "$WORK/replayed.events" > "$WORK/events.diff" || {
+    cat "$WORK/events.diff"
+    fail "replayed session differs from the recording"
+}
+
+grep '^\[Replay\] \(Session\|Events\)' "$WORK/replay.log"
+echo "[Smoke] PASSED: $(wc -l < "$WORK/recorded.events") events replayed identically"
@@ -0,0 +1,79 @@
+/**
+ * myIoTGrid.Sensor - Signal model tests (pio test -e native)
+ */
+
+#include <unity.h>
+#include "signal_model.h"
+#include <vector>
+
+using namespace sensor;
+
+namespace {
+
+const uint64_t START = 1760000000ULL;
+const size_t SAMPLES = 7 * 24 * 60;     // One week at 1-minute samples
+
+std::shared_ptr<SignalEnvironment> weatherEnvironment() {
+    SignalProfile profile;
+    std::string error;
+    SignalProfile::parse("weather", profile, error);
+    return std::make_shared<SignalEnvironment>(profile, 42);
+}
+
+std::vector<uint64_t> timestamps() {
+    std::vector<uint64_t> result(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        result[i] = START + i * 60;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_front_is_a_function_of_time() {
+    auto environment = weatherEnvironment();
+    std::vector<uint64_t> times = timestamps();
+
+    std::vector<float> forward(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        forward[i] = environment->front(times[i]);
+    }
+    for (size_t i = SAMPLES; i-- > 0;) {
+        TEST_ASSERT_EQUAL_FLOAT(forward[i], environment->front(times[i]));
+    }
+}
+
+void test_channels_read_in_separate_batches_match_interleaved_reads() {
+    std::vector<uint64_t> times = timestamps();
+
+    // One batch per channel: humidity starts after temperature has finished
+    auto batched = weatherEnvironment();
+    auto temperature = createSignalModel(*SensorTypes::getInfo("temperature"), batched);
+    auto humidity = createSignalModel(*SensorTypes::getInfo("humidity"), batched);
+    std::vector<float> batchTemperature(SAMPLES);
+    std::vector<float> batchHumidity(SAMPLES);
+    temperature->generate(times.data(), batchTemperature.data(), SAMPLES);
+    humidity->generate(times.data(), batchHumidity.data(), SAMPLES);
+
+    // Same node, channels read alternately one sample at a time
+    auto interleaved = weatherEnvironment();
+    temperature = createSignalModel(*SensorTypes::getInfo("temperature"), interleaved);
+    humidity = createSignalModel(*SensorTypes::getInfo("humidity"), interleaved);
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        float value;
+        temperature->generate(&times[i], &value, 1);
+        TEST_ASSERT_EQUAL_FLOAT(batchTemperature[i], value);
+        humidity->generate(&times[i], &value, 1);
+        TEST_ASSERT_EQUAL_FLOAT(batchHumidity[i], value);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_front_is_a_function_of_time);
+    RUN_TEST(test_channels_read_in_separate_batches_match_interleaved_reads);
+    return UNITY_END();
+}
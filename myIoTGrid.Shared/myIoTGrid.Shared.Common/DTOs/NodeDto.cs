@@ -154,20 +154,38 @@ public record RegenerateApiKeyDto(
 /// DTO for node heartbeat request.
 /// Sent periodically by node to Hub via REST API.
 /// </summary>
+/// <param name="Memory">Heap telemetry (firmware with memory telemetry only)</param>
 public record NodeHeartbeatDto(
     string NodeId,
     string? FirmwareVersion = null,
-    int? BatteryLevel = null
+    int? BatteryLevel = null,
+    MemoryReportDto? Memory = null
 );
 
 /// <summary>
 /// DTO for node heartbeat response.
-/// Returned by Hub to node.
+/// Returned by Hub to node. Also carries the control-plane state (configuration version,
+/// debug settings, server time) so a node needs only one round-trip per sync interval.
 /// </summary>
+/// <param name="ConfigurationVersion">ETag of the current sensor configuration; the node fetches it only when this differs</param>
 public record NodeHeartbeatResponseDto(
     bool Success,
     DateTime ServerTime,
-    int? NextHeartbeatSeconds = null
+    int? NextHeartbeatSeconds = null,
+    long? UnixTimestamp = null,
+    string? ConfigurationVersion = null,
+    DebugLevelDto? DebugLevel = null,
+    bool? EnableRemoteLogging = null
+);
+
+/// <summary>
+/// Control state of a node, delivered by the long-poll control endpoint.
+/// </summary>
+/// <param name="ConfigurationVersion">ETag of the current sensor configuration</param>
+public record NodeControlStateDto(
+    string ConfigurationVersion,
+    DebugLevelDto DebugLevel,
+    bool EnableRemoteLogging
 );
 
 /// <summary>
@@ -212,11 +230,16 @@ public record SensorAssignmentConfigDto(
 /// <summary>
 /// Sensor capability configuration for the firmware.
 /// Tells the sensor which measurement types to capture and their units.
+/// ADC inputs (ADS1115) also get the channel, gain and data rate; the
+/// firmware uses its defaults for values left null.
 /// </summary>
 public record SensorCapabilityConfigDto(
     string MeasurementType,
     string DisplayName,
-    string Unit
+    string Unit,
+    int? AdcChannel = null,
+    double? AdcGain = null,
+    int? AdcDataRate = null
 );
 
 // === GPS Status DTOs ===
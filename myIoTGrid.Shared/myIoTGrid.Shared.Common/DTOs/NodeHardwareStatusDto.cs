@@ -13,7 +13,10 @@ public record NodeHardwareStatusDto(
     HardwareSummaryDto Summary,
     List<DetectedDeviceDto> DetectedDevices,
     StorageStatusDto Storage,
-    BusStatusDto BusStatus
+    BusStatusDto BusStatus,
+    TimingReportDto? Timing = null,
+    StallReportDto? Stalls = null,
+    MemoryReportDto? Memory = null      // From the latest heartbeat
 );
 
 /// <summary>
@@ -69,6 +72,94 @@ public record BusStatusDto(
     bool GpsDetected
 );
 
+/// <summary>
+/// DTO for firmware hot-path timing (per-stage latency histograms).
+/// </summary>
+public record TimingReportDto(
+    long WindowMs,                      // Measurement window (since boot or "timing reset")
+    List<TimingStageDto> Stages,
+    Dictionary<string, long> Counters   // e.g., "http.errors", "sensor.errors"
+);
+
+/// <summary>
+/// DTO for one timed stage. Buckets are log2: [0] below 1 us, [i] 2^(i-1) to 2^i us.
+/// </summary>
+public record TimingStageDto(
+    string Name,              // "loop", "sensor.BME280", "json.serialize", "http.request", "sd.append", "sync.batch"
+    long Count,
+    long TotalUs,
+    long MaxUs,
+    long P50Us,
+    long P90Us,
+    long P99Us,
+    List<long> Buckets
+);
+
+/// <summary>
+/// DTO for firmware loop stalls (main loop iterations over the threshold).
+/// </summary>
+public record StallReportDto(
+    int ThresholdMs,
+    long StallCount,                    // Since boot or "stalls reset"
+    List<LoopStallDto> Worst            // Longest first
+);
+
+/// <summary>
+/// DTO for one loop stall.
+/// </summary>
+public record LoopStallDto(
+    long DurationMs,
+    long StartMs,             // Node uptime at the start of the iteration
+    string Stage,             // Active stages, e.g., "sensor.batch > sensor.DS18B20"
+    List<string> Backtrace    // Return addresses ("0x400d1234"), empty if unavailable
+);
+
+/// <summary>
+/// DTO for firmware memory telemetry (sent with every heartbeat).
+/// Fragmentation shows as a largest free block far below the free heap.
+/// </summary>
+public record MemoryReportDto(
+    long UptimeMs,
+    List<HeapCapabilityDto> Capabilities,
+    HeapTrendDto Trend,
+    long FailedAllocs,                  // Since boot
+    long LastFailedBytes,
+    long LastFailedCaps,                // MALLOC_CAP_* flags of the last failed allocation
+    List<MemoryTagDto>? Tags = null     // Debug builds (MEMORY_TAGGING) only
+);
+
+/// <summary>
+/// DTO for one heap capability: "8bit", "internal", "dma", "spiram".
+/// </summary>
+public record HeapCapabilityDto(
+    string Name,
+    long Total,
+    long Free,
+    long LargestFree,         // Largest allocatable block
+    long MinFree,             // Low-water mark since boot
+    int Fragmentation         // 100 - LargestFree * 100 / Free (%)
+);
+
+/// <summary>
+/// DTO for the internal heap trend, oldest sample first.
+/// </summary>
+public record HeapTrendDto(
+    long IntervalMs,
+    List<long> Free,
+    List<long> LargestFree,
+    List<long> MinFree
+);
+
+/// <summary>
+/// DTO for the heap kept by one tagged allocation site.
+/// </summary>
+public record MemoryTagDto(
+    string Name,              // e.g., "http.request", "json.serialize"
+    long Calls,
+    long NetBytes,            // Heap kept over all calls
+    long MaxBytes             // Largest single call
+);
+
 /// <summary>
 /// DTO for reporting hardware status from firmware.
 /// </summary>
@@ -78,5 +169,7 @@ public record ReportHardwareStatusDto(
     string HardwareType,
     List<DetectedDeviceDto> DetectedDevices,
     StorageStatusDto Storage,
-    BusStatusDto BusStatus
+    BusStatusDto BusStatus,
+    TimingReportDto? Timing = null,
+    StallReportDto? Stalls = null
 );
@@ -82,7 +82,10 @@ public record SensorCapabilityDto(
     uint? MatterClusterId,
     string? MatterClusterName,
     int SortOrder,
-    bool IsActive
+    bool IsActive,
+    int? AdcChannel = null,
+    double? AdcGain = null,
+    int? AdcDataRate = null
 );
 
 /// <summary>
@@ -147,7 +150,10 @@ public record CreateSensorCapabilityDto(
     double Accuracy = 0.5,
     uint? MatterClusterId = null,
     string? MatterClusterName = null,
-    int SortOrder = 0
+    int SortOrder = 0,
+    int? AdcChannel = null,
+    double? AdcGain = null,
+    int? AdcDataRate = null
 );
 
 /// <summary>
@@ -217,7 +223,10 @@ public record UpdateSensorCapabilityDto(
     uint? MatterClusterId = null,
     string? MatterClusterName = null,
     int? SortOrder = null,
-    bool? IsActive = null
+    bool? IsActive = null,
+    int? AdcChannel = null,
+    double? AdcGain = null,
+    int? AdcDataRate = null
 );
 
 /// <summary>
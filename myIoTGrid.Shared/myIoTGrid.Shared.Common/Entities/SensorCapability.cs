@@ -48,6 +48,17 @@ public class SensorCapability : IEntity
     /// <summary>Is this capability active?</summary>
     public bool IsActive { get; set; } = true;
 
+    // === ADC Input (ADS1115) ===
+
+    /// <summary>ADC input channel 0-3 (null = capability index)</summary>
+    public int? AdcChannel { get; set; }
+
+    /// <summary>ADC programmable gain amplifier (e.g. 1 = +/-4.096V, 16 = +/-0.256V; null = 1)</summary>
+    public double? AdcGain { get; set; }
+
+    /// <summary>ADC data rate in samples per second (null = firmware default)</summary>
+    public int? AdcDataRate { get; set; }
+
     // === Navigation Properties ===
 
     /// <summary>Parent sensor</summary>
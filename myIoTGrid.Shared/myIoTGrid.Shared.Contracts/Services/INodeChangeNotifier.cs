@@ -0,0 +1,19 @@
+namespace myIoTGrid.Shared.Contracts.Services;
+
+/// <summary>
+/// In-process signal for changes to a node's control state (sensor configuration, debug settings).
+/// Wakes sensors waiting on the long-poll control endpoint.
+/// </summary>
+public interface INodeChangeNotifier
+{
+    /// <summary>
+    /// Returns a task that completes on the next change of the node.
+    /// Take it before reading the current state so no change is missed.
+    /// </summary>
+    Task WhenChanged(Guid nodeId);
+
+    /// <summary>
+    /// Signals a change of the node to all current waiters.
+    /// </summary>
+    void NotifyChanged(Guid nodeId);
+}